@@ -0,0 +1,34 @@
+@echo off
+@rem Starts the servers and logs in 10000 headless bots on this host as a login storm
+@rem (config: login_test/server/kbengine.xml, edit loginBatch/enable and loginQueue/maxPending there to compare).
+@rem When every bot is in the world the bots log "HeadlessStats::update: all 10000 bots are in world after ..."
+@rem with the p50/p99 time-to-world.
+set curpath=%~dp0
+
+cd ..
+set KBE_ROOT=%cd%
+set KBE_RES_PATH=%KBE_ROOT%/kbe/res/;%curpath%/;%curpath%/scripts/;%curpath%/login_test/;%curpath%/res/
+set KBE_BIN_PATH=%KBE_ROOT%/kbe/bin/server/
+
+if defined uid (echo UID = %uid%)
+
+cd %curpath%
+call "kill_server.bat"
+
+echo KBE_ROOT = %KBE_ROOT%
+echo KBE_RES_PATH = %KBE_RES_PATH%
+echo KBE_BIN_PATH = %KBE_BIN_PATH%
+
+start "" "%KBE_BIN_PATH%/machine.exe" --cid=1000 --gus=1
+start "" "%KBE_BIN_PATH%/logger.exe" --cid=2000 --gus=2
+start "" "%KBE_BIN_PATH%/interfaces.exe" --cid=3000 --gus=3
+start "" "%KBE_BIN_PATH%/dbmgr.exe" --cid=4000 --gus=4
+start "" "%KBE_BIN_PATH%/baseappmgr.exe" --cid=5000 --gus=5
+start "" "%KBE_BIN_PATH%/cellappmgr.exe" --cid=6000 --gus=6
+start "" "%KBE_BIN_PATH%/baseapp.exe" --cid=7001 --gus=7
+start "" "%KBE_BIN_PATH%/cellapp.exe" --cid=8001 --gus=8
+start "" "%KBE_BIN_PATH%/loginapp.exe" --cid=9000 --gus=9
+
+@rem give the servers time to come up before the bots log in
+timeout /t 15 /nobreak > nul
+start "" "%KBE_BIN_PATH%/bots.exe" --cid=10000 --gus=10
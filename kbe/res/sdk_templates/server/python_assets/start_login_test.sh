@@ -0,0 +1,58 @@
+#!/bin/sh
+
+# Starts the servers and logs in 10000 headless bots on this host as a login storm
+# (config: login_test/server/kbengine.xml). When every bot is in the world the bots log
+# "HeadlessStats::update: all 10000 bots are in world after ..." with the p50/p99 time-to-world.
+# The first run creates the accounts; run it again to measure logins of existing accounts.
+#
+# usage: start_login_test.sh [loginBatch(true|false, default true)] [loginQueue maxPending(0 = unlimited, default 500)]
+
+currPath=$(pwd)
+keyStr="/kbengine/"
+
+bcontain=`echo $currPath|grep $keyStr|wc -l`
+
+
+if [ $bcontain = 0 ]
+then
+	export KBE_ROOT="$(cd ../; pwd)"
+else
+	export KBE_ROOT="$(pwd | awk -F "/kbengine/" '{print $1}')/kbengine"
+fi
+
+loginBatch=${1:-true}
+maxPending=${2:-500}
+
+# the overlay with the requested settings goes into a temporary res directory in front of {assets}/res
+runPath=$(mktemp -d)
+mkdir -p "$runPath/server"
+sed -e "/<loginBatch>/,/<\/loginBatch>/s|<enable>.*</enable>|<enable> $loginBatch </enable>|" \
+	-e "s|<maxPending>.*</maxPending>|<maxPending> $maxPending </maxPending>|" \
+	login_test/server/kbengine.xml > "$runPath/server/kbengine.xml"
+
+export KBE_RES_PATH="$KBE_ROOT/kbe/res/:$(pwd):$runPath:$(pwd)/res:$(pwd)/scripts/"
+export KBE_BIN_PATH="$KBE_ROOT/kbe/bin/server/"
+
+echo KBE_ROOT = \"${KBE_ROOT}\"
+echo KBE_RES_PATH = \"${KBE_RES_PATH}\"
+echo KBE_BIN_PATH = \"${KBE_BIN_PATH}\"
+echo loginBatch = ${loginBatch}, maxPending = ${maxPending}
+
+# every bot keeps a socket open
+ulimit -n 65535 2>/dev/null
+
+sh ./kill_server.sh
+
+"$KBE_BIN_PATH/machine" --cid=2129652375332859700 --gus=1&
+"$KBE_BIN_PATH/logger" --cid=1129653375331859700 --gus=2&
+"$KBE_BIN_PATH/interfaces" --cid=1129652375332859700 --gus=3&
+"$KBE_BIN_PATH/dbmgr" --cid=3129652375332859700 --gus=4&
+"$KBE_BIN_PATH/baseappmgr" --cid=4129652375332859700 --gus=5&
+"$KBE_BIN_PATH/cellappmgr" --cid=5129652375332859700 --gus=6&
+"$KBE_BIN_PATH/baseapp" --cid=6129652375332859700 --gus=7&
+"$KBE_BIN_PATH/cellapp" --cid=7129652375332859700 --gus=8&
+"$KBE_BIN_PATH/loginapp" --cid=8129652375332859700 --gus=9&
+
+# give the servers time to come up before the bots log in
+sleep 15
+"$KBE_BIN_PATH/bots" --cid=9129652375332859700 --gus=10&
@@ -0,0 +1,38 @@
+@echo off
+@rem Starts one baseapp, several cellapps and headless bots on this host to test space
+@rem partitioning (config: partition_test/server/kbengine.xml).
+@rem usage: start_partition_test.bat [cellapps(1-9, default 3)]
+set curpath=%~dp0
+
+set numCellapps=%1
+if "%numCellapps%"=="" set numCellapps=3
+
+cd ..
+set KBE_ROOT=%cd%
+set KBE_RES_PATH=%KBE_ROOT%/kbe/res/;%curpath%/;%curpath%/scripts/;%curpath%/partition_test/;%curpath%/res/
+set KBE_BIN_PATH=%KBE_ROOT%/kbe/bin/server/
+
+if defined uid (echo UID = %uid%)
+
+cd %curpath%
+call "kill_server.bat"
+
+echo KBE_ROOT = %KBE_ROOT%
+echo KBE_RES_PATH = %KBE_RES_PATH%
+echo KBE_BIN_PATH = %KBE_BIN_PATH%
+
+start "" "%KBE_BIN_PATH%/machine.exe" --cid=1000 --gus=1
+start "" "%KBE_BIN_PATH%/logger.exe" --cid=2000 --gus=2
+start "" "%KBE_BIN_PATH%/interfaces.exe" --cid=3000 --gus=3
+start "" "%KBE_BIN_PATH%/dbmgr.exe" --cid=4000 --gus=4
+start "" "%KBE_BIN_PATH%/baseappmgr.exe" --cid=5000 --gus=5
+start "" "%KBE_BIN_PATH%/cellappmgr.exe" --cid=6000 --gus=6
+start "" "%KBE_BIN_PATH%/baseapp.exe" --cid=7001 --gus=7
+
+for /L %%i in (1,1,%numCellapps%) do start "" "%KBE_BIN_PATH%/cellapp.exe" --cid=800%%i --gus=1%%i --hide=1
+
+start "" "%KBE_BIN_PATH%/loginapp.exe" --cid=9000 --gus=20
+
+@rem give the servers time to come up before the bots log in
+timeout /t 15 /nobreak > nul
+start "" "%KBE_BIN_PATH%/bots.exe" --cid=10000 --gus=21
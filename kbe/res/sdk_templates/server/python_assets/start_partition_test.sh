@@ -0,0 +1,56 @@
+#!/bin/sh
+
+# Starts one baseapp, several cellapps and headless bots on this host to test space partitioning
+# (config: partition_test/server/kbengine.xml).
+#
+# usage: start_partition_test.sh [cellapps(1-9, default 3)]
+
+currPath=$(pwd)
+keyStr="/kbengine/"
+
+bcontain=`echo $currPath|grep $keyStr|wc -l`
+
+
+if [ $bcontain = 0 ]
+then
+	export KBE_ROOT="$(cd ../; pwd)"
+else
+	export KBE_ROOT="$(pwd | awk -F "/kbengine/" '{print $1}')/kbengine"
+fi
+
+numCellapps=${1:-3}
+if [ $numCellapps -lt 1 ] || [ $numCellapps -gt 9 ]
+then
+	echo "cellapps must be 1-9"
+	exit 1
+fi
+
+export KBE_RES_PATH="$KBE_ROOT/kbe/res/:$(pwd):$(pwd)/partition_test:$(pwd)/res:$(pwd)/scripts/"
+export KBE_BIN_PATH="$KBE_ROOT/kbe/bin/server/"
+
+echo KBE_ROOT = \"${KBE_ROOT}\"
+echo KBE_RES_PATH = \"${KBE_RES_PATH}\"
+echo KBE_BIN_PATH = \"${KBE_BIN_PATH}\"
+
+sh ./kill_server.sh
+
+"$KBE_BIN_PATH/machine" --cid=2129652375332859700 --gus=1&
+"$KBE_BIN_PATH/logger" --cid=1129653375331859700 --gus=2&
+"$KBE_BIN_PATH/interfaces" --cid=1129652375332859700 --gus=3&
+"$KBE_BIN_PATH/dbmgr" --cid=3129652375332859700 --gus=4&
+"$KBE_BIN_PATH/baseappmgr" --cid=4129652375332859700 --gus=5&
+"$KBE_BIN_PATH/cellappmgr" --cid=5129652375332859700 --gus=6&
+"$KBE_BIN_PATH/baseapp" --cid=6129652375332859700 --gus=7&
+
+i=1
+while [ $i -le $numCellapps ]
+do
+	"$KBE_BIN_PATH/cellapp" --cid=712965237533285970$i --gus=$((7 + i))&
+	i=$((i + 1))
+done
+
+"$KBE_BIN_PATH/loginapp" --cid=8129652375332859700 --gus=17&
+
+# give the servers time to come up before the bots log in
+sleep 15
+"$KBE_BIN_PATH/bots" --cid=9129652375332859700 --gus=18&
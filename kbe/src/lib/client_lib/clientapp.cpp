@@ -49,7 +49,7 @@ dispatcher_(dispatcher),
 networkInterface_(ninterface),
 pTCPPacketSender_(NULL),
 pTCPPacketReceiver_(NULL),
-pBlowfishFilter_(NULL),
+encryptionKey_(),
 threadPool_(),
 entryScript_(),
 state_(C_STATE_INIT)
@@ -70,7 +70,6 @@ state_(C_STATE_INIT)
 ClientApp::~ClientApp()
 {
 	EntityCallAbstract::resetCallHooks();
-	SAFE_RELEASE(pBlowfishFilter_);
 }
 
 //-------------------------------------------------------------------------------------		
@@ -91,7 +90,6 @@ void ClientApp::reset(void)
 
 	SAFE_RELEASE(pTCPPacketSender_);
 	SAFE_RELEASE(pTCPPacketReceiver_);
-	SAFE_RELEASE(pBlowfishFilter_);
 
 	ClientObjectBase::reset();
 }
@@ -401,10 +399,10 @@ void ClientApp::handleGameTick()
 					(*pBundle) << KBEVersion::versionString();
 					(*pBundle) << KBEVersion::scriptVersionString();
 
-					if(Network::g_channelExternalEncryptType == 1)
+					if(Network::g_channelExternalEncryptType > 0)
 					{
-						pBlowfishFilter_ = new Network::BlowfishFilter();
-						(*pBundle).appendBlob(pBlowfishFilter_->key());
+						encryptionKey_ = Network::makeEncryptionKey(Network::g_channelExternalEncryptType);
+						(*pBundle).appendBlob(encryptionKey_);
 						pServerChannel_->pFilter(NULL);
 					}
 					else
@@ -651,10 +649,10 @@ bool ClientApp::login(std::string accountName, std::string passwd, std::string d
 		(*pBundle) << KBEVersion::versionString();
 		(*pBundle) << KBEVersion::scriptVersionString();
 
-		if(Network::g_channelExternalEncryptType == 1)
+		if(Network::g_channelExternalEncryptType > 0)
 		{
-			pBlowfishFilter_ = new Network::BlowfishFilter();
-			(*pBundle).appendBlob(pBlowfishFilter_->key());
+			encryptionKey_ = Network::makeEncryptionKey(Network::g_channelExternalEncryptType);
+			(*pBundle).appendBlob(encryptionKey_);
 		}
 		else
 		{
@@ -673,12 +671,12 @@ bool ClientApp::login(std::string accountName, std::string passwd, std::string d
 //-------------------------------------------------------------------------------------	
 void ClientApp::onHelloCB_(Network::Channel* pChannel, const std::string& verInfo, 
 		const std::string& scriptVerInfo, const std::string& protocolMD5, const std::string& entityDefMD5, 
-		COMPONENT_TYPE componentType)
+		COMPONENT_TYPE componentType, int8 encryptType)
 {
-	if(Network::g_channelExternalEncryptType == 1)
+	if(encryptType > 0 && encryptionKey_.size() > 0)
 	{
-		pServerChannel_->pFilter(pBlowfishFilter_);
-		pBlowfishFilter_ = NULL;
+		pServerChannel_->pFilter(Network::createEncryptionFilter(encryptType, encryptionKey_));
+		encryptionKey_ = "";
 	}
 
 	if(componentType == LOGINAPP_TYPE)
@@ -126,7 +126,7 @@ public:
 
 	virtual void onHelloCB_(Network::Channel* pChannel, const std::string& verInfo,
 		const std::string& scriptVerInfo, const std::string& protocolMD5, 
-		const std::string& entityDefMD5, COMPONENT_TYPE componentType);
+		const std::string& entityDefMD5, COMPONENT_TYPE componentType, int8 encryptType);
 
 	/** ӿ
 		ͷ˵İ汾ƥ
@@ -245,7 +245,7 @@ protected:
 	
 	Network::TCPPacketSender*								pTCPPacketSender_;
 	Network::TCPPacketReceiver*								pTCPPacketReceiver_;
-	Network::BlowfishFilter*								pBlowfishFilter_;
+	std::string											encryptionKey_;
 
 	// ̳߳
 	thread::ThreadPool										threadPool_;
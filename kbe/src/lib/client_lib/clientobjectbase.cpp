@@ -542,7 +542,7 @@ void ClientObjectBase::fireEvent(const EventData* pEventData)
 //-------------------------------------------------------------------------------------	
 void ClientObjectBase::onHelloCB_(Network::Channel* pChannel, const std::string& verInfo, 
 		const std::string& scriptVerInfo, const std::string& protocolMD5, const std::string& entityDefMD5, 
-		COMPONENT_TYPE componentType)
+		COMPONENT_TYPE componentType, int8 encryptType)
 {
 }
 
@@ -564,10 +564,15 @@ void ClientObjectBase::onHelloCB(Network::Channel* pChannel, MemoryStream& s)
 	COMPONENT_TYPE ctype;
 	s >> ctype;
 
+	// ɵķ˲᷵Э̵ļͣ ʱֻBlowfish
+	int8 encryptType = 1;
+	if (s.length() > 0)
+		s >> encryptType;
+
 	INFO_MSG(fmt::format("ClientObjectBase::onHelloCB: verInfo={}, scriptVerInfo={}, protocolMD5={}, entityDefMD5={}, addr:{}\n",
 		verInfo, scriptVerInfo, protocolMD5, entityDefMD5, pChannel->c_str()));
 
-	onHelloCB_(pChannel, verInfo, scriptVerInfo, protocolMD5, entityDefMD5, ctype);
+	onHelloCB_(pChannel, verInfo, scriptVerInfo, protocolMD5, entityDefMD5, ctype, encryptType);
 }
 
 //-------------------------------------------------------------------------------------	
@@ -135,7 +135,7 @@ public:
 	*/
 	virtual void onHelloCB_(Network::Channel* pChannel, const std::string& verInfo,
 		const std::string& scriptVerInfo, const std::string& protocolMD5, 
-		const std::string& entityDefMD5, COMPONENT_TYPE componentType);
+		const std::string& entityDefMD5, COMPONENT_TYPE componentType, int8 encryptType);
 
 	virtual void onHelloCB(Network::Channel* pChannel, MemoryStream& s);
 
@@ -317,7 +317,7 @@ public:
 	virtual void onUpdateData_xyz_p(Network::Channel* pChannel, MemoryStream& s);
 	virtual void onUpdateData_xyz_r(Network::Channel* pChannel, MemoryStream& s);
 	
-	void _updateVolatileData(ENTITY_ID entityID, float x, float y, float z, float roll, 
+	virtual void _updateVolatileData(ENTITY_ID entityID, float x, float y, float z, float roll, 
 		float pitch, float yaw, int8 isOnGround, bool isOptimized);
 
 	/** 
@@ -93,20 +93,23 @@ int KBEBlowfish::encrypt( const unsigned char * src, unsigned char * dest,
 			length, (int)(BLOCK_SIZE)));
 	}
 
-	uint64 * pPrevBlock = NULL;
+	// õһģ ȱ srcdestͬʱҲԭؼ
+	uint64 prevBlock = 0;
 	for (int i=0; i < length; i += BLOCK_SIZE)
 	{
-		if (pPrevBlock)
+		uint64 block = *(uint64*)(src + i);
+
+		if (i > 0)
 		{
-			*(uint64*)(dest + i) = *(uint64*)(src + i) ^ (*pPrevBlock);
+			*(uint64*)(dest + i) = block ^ prevBlock;
 		}
 		else
 		{
-			*(uint64*)(dest + i) = *(uint64*)(src + i);
+			*(uint64*)(dest + i) = block;
 		}
 
 		BF_ecb_encrypt(dest + i, dest + i, this->pBlowFishKey(), BF_ENCRYPT);
-		pPrevBlock = (uint64*)(src + i);
+		prevBlock = block;
 	}
 
 	return length;
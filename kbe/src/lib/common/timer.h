@@ -100,11 +100,40 @@ protected:
 class TimersBase
 {
 public:
-	virtual void onCancel() = 0;
+	virtual void onCancel(TimeBase* pTime) = 0;
+};
+
+/**
+	ʱӿڣ (TimersT)ֲʱ(TimingWheelT)ʵӿڣ
+	EventDispatcherʹ߿԰Ҫѡһ
+*/
+template<class TIME_STAMP>
+class TimersBaseT : public TimersBase
+{
+public:
+	typedef TIME_STAMP TimeStamp;
+
+	virtual ~TimersBaseT() {}
+
+	virtual uint32 size() const = 0;
+	virtual bool empty() const = 0;
+
+	virtual int	process(TimeStamp now) = 0;
+	virtual bool legal( TimerHandle handle ) const = 0;
+	virtual TIME_STAMP nextExp( TimeStamp now ) const = 0;
+	virtual void clear( bool shouldCallCancel = true ) = 0;
+
+	virtual bool getTimerInfo( TimerHandle handle, 
+					TimeStamp& time, 
+					TimeStamp&	interval,
+					void *&	pUser ) const = 0;
+
+	virtual TimerHandle	add(TimeStamp startTime, TimeStamp interval,
+						TimerHandler* pHandler, void * pUser) = 0;
 };
 
 template<class TIME_STAMP>
-class TimersT : public TimersBase
+class TimersT : public TimersBaseT<TIME_STAMP>
 {
 public:
 	typedef TIME_STAMP TimeStamp;
@@ -134,7 +163,7 @@ private:
 	Container container_;
 
 	void purgeCancelledTimes();
-	void onCancel();
+	void onCancel(TimeBase* pTime);
 
 	class Time : public TimeBase
 	{
@@ -221,6 +250,7 @@ private:
 
 typedef TimersT<uint32> Timers;
 typedef TimersT<uint64> Timers64;
+typedef TimersBaseT<uint64> TimersBase64;
 }
 
 #include "timer.inl"
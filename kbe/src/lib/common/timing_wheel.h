@@ -0,0 +1,166 @@
+// Copyright 2008-2018 Yolo Technologies, Inc. All Rights Reserved. https://www.comblockengine.com
+#ifndef KBE_TIMING_WHEEL_H
+#define KBE_TIMING_WHEEL_H
+
+#include "common/timer.h"
+
+namespace KBEngine
+{
+
+/**
+	ֲʱ֣ ȡʱO(1)
+	ʱ䰴resolutionΪ(tick) һÿһtick ֮ÿһӦһתһȦ
+	ʱ䳬һ㷶ΧĶʱȷһ㣬 תʱ¼λá
+	ʱֻ䵽ʱڸ񱻴ʱ ˲ǰ Ӻһresolution
+	TimeڵڲĽڵз䣬 ȡĽڵ㵽һprocessʱŻգ
+	TimersTһ ȡTimerHandle֮ǰȻ԰ȫʡ
+*/
+template<class TIME_STAMP>
+class TimingWheelT : public TimersBaseT<TIME_STAMP>
+{
+public:
+	typedef TIME_STAMP TimeStamp;
+
+	TimingWheelT(TimeStamp resolution, TimeStamp now);
+	virtual ~TimingWheelT();
+
+	inline uint32 size() const	{ return numTimes_; }
+	inline bool empty() const	{ return numTimes_ == 0; }
+
+	int	process(TimeStamp now);
+	bool legal( TimerHandle handle ) const;
+	TIME_STAMP nextExp( TimeStamp now ) const;
+	void clear( bool shouldCallCancel = true );
+
+	bool getTimerInfo( TimerHandle handle,
+					TimeStamp& time,
+					TimeStamp&	interval,
+					void *&	pUser ) const;
+
+	TimerHandle	add(TimeStamp startTime, TimeStamp interval,
+						TimerHandler* pHandler, void * pUser);
+
+	TimeStamp resolution() const { return resolution_; }
+
+private:
+	enum
+	{
+		ROOT_BITS = 8,
+		LEVEL_BITS = 6,
+		NUM_LEVELS = 4,
+		ROOT_SIZE = 1 << ROOT_BITS,
+		LEVEL_SIZE = 1 << LEVEL_BITS,
+		ROOT_MASK = ROOT_SIZE - 1,
+		LEVEL_MASK = LEVEL_SIZE - 1,
+		NUM_SLOTS = ROOT_SIZE + (NUM_LEVELS - 1) * LEVEL_SIZE,
+
+		// ڵÿηĽڵ
+		TIMES_PER_BLOCK = 1024
+	};
+
+	/**
+		˫ѭڵ㣬 ÿһڱڵ
+	*/
+	class ListNode
+	{
+	public:
+		ListNode() : pPrev_(this), pNext_(this) {}
+
+		bool isLinked() const { return pNext_ != this; }
+
+		void unlink()
+		{
+			pPrev_->pNext_ = pNext_;
+			pNext_->pPrev_ = pPrev_;
+			pPrev_ = pNext_ = this;
+		}
+
+		void pushBack(ListNode* pNode)
+		{
+			pNode->pPrev_ = pPrev_;
+			pNode->pNext_ = this;
+			pPrev_->pNext_ = pNode;
+			pPrev_ = pNode;
+		}
+
+		// нڵתƵһ
+		void moveTo(ListNode& list)
+		{
+			if (!isLinked())
+				return;
+
+			list.pNext_ = pNext_;
+			list.pPrev_ = pPrev_;
+			pNext_->pPrev_ = &list;
+			pPrev_->pNext_ = &list;
+			pPrev_ = pNext_ = this;
+		}
+
+		ListNode* pNext() const { return pNext_; }
+
+	private:
+		ListNode* pPrev_;
+		ListNode* pNext_;
+	};
+
+	class Time : public TimeBase, public ListNode
+	{
+	public:
+		Time( TimersBase & owner, TimeStamp startTime, TimeStamp interval,
+			TimerHandler * pHandler, void * pUser );
+
+		TIME_STAMP time() const			{ return time_; }
+		TIME_STAMP interval() const		{ return interval_; }
+
+		void triggerTimer();
+
+	private:
+		TimeStamp			time_;
+		TimeStamp			interval_;
+
+		Time( const Time & );
+		Time & operator=( const Time & );
+	};
+
+	static Time* toTime(ListNode* pNode) { return static_cast<Time*>(pNode); }
+
+	uint64 toTick(TimeStamp time) const;
+	void addToWheel(Time* pTime);
+	void cascade(int level, int index);
+
+	Time* allocTime(TimeStamp startTime, TimeStamp interval,
+		TimerHandler* pHandler, void * pUser);
+	void reclaimTime(Time* pTime);
+	void reclaimCancelledTimes();
+
+	void onCancel(TimeBase* pTime);
+
+	TimeStamp		resolution_;
+
+	// һҪtick
+	uint64			currTick_;
+
+	ListNode		slots_[NUM_SLOTS];
+
+	// ȡδյĽڵ
+	ListNode		cancelledTimes_;
+
+	// ǰtickڴĽڵ
+	ListNode		processingTimes_;
+	Time *			pProcessingNode_;
+
+	uint32			numTimes_;
+
+	std::vector<Time*> freeTimes_;
+	std::vector<void*> blocks_;
+
+	TimingWheelT( const TimingWheelT & );
+	TimingWheelT & operator=( const TimingWheelT & );
+};
+
+typedef TimingWheelT<uint64> TimingWheel64;
+}
+
+#include "timing_wheel.inl"
+
+#endif // KBE_TIMING_WHEEL_H
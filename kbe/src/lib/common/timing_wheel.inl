@@ -0,0 +1,343 @@
+// Copyright 2008-2018 Yolo Technologies, Inc. All Rights Reserved. https://www.comblockengine.com
+
+#include <new>
+
+namespace KBEngine {
+
+template<class TIME_STAMP>
+TimingWheelT<TIME_STAMP>::TimingWheelT(TimeStamp resolution, TimeStamp now):
+	resolution_( resolution > 0 ? resolution : 1 ),
+	currTick_( 0 ),
+	cancelledTimes_(),
+	processingTimes_(),
+	pProcessingNode_( NULL ),
+	numTimes_( 0 ),
+	freeTimes_(),
+	blocks_()
+{
+	currTick_ = uint64(now) / resolution_;
+}
+
+template<class TIME_STAMP>
+TimingWheelT<TIME_STAMP>::~TimingWheelT()
+{
+	this->clear();
+
+	for (size_t i = 0; i < blocks_.size(); ++i)
+	{
+		::operator delete( blocks_[i] );
+	}
+
+	blocks_.clear();
+	freeTimes_.clear();
+}
+
+template <class TIME_STAMP>
+uint64 TimingWheelT< TIME_STAMP >::toTick(TimeStamp time) const
+{
+	// ȡ ֤ʱǰ
+	return (uint64(time) + resolution_ - 1) / resolution_;
+}
+
+template <class TIME_STAMP>
+typename TimingWheelT< TIME_STAMP >::Time * TimingWheelT< TIME_STAMP >::allocTime(
+	TimeStamp startTime, TimeStamp interval, TimerHandler * pHandler, void * pUser)
+{
+	if (freeTimes_.empty())
+	{
+		void * pBlock = ::operator new( sizeof(Time) * TIMES_PER_BLOCK );
+		blocks_.push_back( pBlock );
+
+		for (int i = TIMES_PER_BLOCK - 1; i >= 0; --i)
+		{
+			freeTimes_.push_back( reinterpret_cast< Time * >(
+				static_cast< char * >( pBlock ) + sizeof(Time) * i ) );
+		}
+	}
+
+	Time * pTime = freeTimes_.back();
+	freeTimes_.pop_back();
+
+	return new (pTime) Time( *this, startTime, interval, pHandler, pUser );
+}
+
+template <class TIME_STAMP>
+void TimingWheelT< TIME_STAMP >::reclaimTime(Time * pTime)
+{
+	pTime->~Time();
+	freeTimes_.push_back( pTime );
+}
+
+template <class TIME_STAMP>
+void TimingWheelT< TIME_STAMP >::reclaimCancelledTimes()
+{
+	while (cancelledTimes_.isLinked())
+	{
+		Time * pTime = toTime( cancelledTimes_.pNext() );
+		pTime->unlink();
+		reclaimTime( pTime );
+	}
+}
+
+template <class TIME_STAMP>
+TimerHandle TimingWheelT< TIME_STAMP >::add( TimeStamp startTime,
+		TimeStamp interval, TimerHandler * pHandler, void * pUser )
+{
+	Time * pTime = allocTime( startTime, interval, pHandler, pUser );
+	this->addToWheel( pTime );
+	++numTimes_;
+	return TimerHandle( pTime );
+}
+
+template <class TIME_STAMP>
+void TimingWheelT< TIME_STAMP >::addToWheel(Time * pTime)
+{
+	uint64 expires = toTick( pTime->time() );
+
+	// ѾڵĶʱһtick
+	if (expires < currTick_)
+	{
+		expires = currTick_;
+	}
+
+	uint64 idx = expires - currTick_;
+
+	if (idx < ROOT_SIZE)
+	{
+		slots_[expires & ROOT_MASK].pushBack( pTime );
+		return;
+	}
+
+	// ʱַΧĶʱŵһԶĸӣ תʱᰴʵĵʱ·
+	const uint64 maxIdx = (uint64(1) << (ROOT_BITS + (NUM_LEVELS - 1) * LEVEL_BITS)) - 1;
+	if (idx > maxIdx)
+	{
+		idx = maxIdx;
+		expires = currTick_ + maxIdx;
+	}
+
+	int level = 1;
+	while (idx >= (uint64(1) << (ROOT_BITS + level * LEVEL_BITS)))
+	{
+		++level;
+	}
+
+	int shift = ROOT_BITS + (level - 1) * LEVEL_BITS;
+	slots_[ROOT_SIZE + (level - 1) * LEVEL_SIZE + ((expires >> shift) & LEVEL_MASK)].pushBack( pTime );
+}
+
+template <class TIME_STAMP>
+void TimingWheelT< TIME_STAMP >::cascade(int level, int index)
+{
+	ListNode times;
+	slots_[ROOT_SIZE + (level - 1) * LEVEL_SIZE + index].moveTo( times );
+
+	while (times.isLinked())
+	{
+		Time * pTime = toTime( times.pNext() );
+		pTime->unlink();
+		this->addToWheel( pTime );
+	}
+}
+
+template <class TIME_STAMP>
+void TimingWheelT< TIME_STAMP >::onCancel(TimeBase * pTimeBase)
+{
+	Time * pTime = static_cast< Time * >( pTimeBase );
+
+	KBE_ASSERT( numTimes_ > 0 );
+	--numTimes_;
+
+	// ڴĽڵ㲻κУ process
+	if (pTime != pProcessingNode_)
+	{
+		pTime->unlink();
+		cancelledTimes_.pushBack( pTime );
+	}
+}
+
+template <class TIME_STAMP>
+void TimingWheelT< TIME_STAMP >::clear(bool shouldCallCancel)
+{
+	for (int i = 0; i <= NUM_SLOTS; ++i)
+	{
+		ListNode & slot = (i < NUM_SLOTS) ? slots_[i] : processingTimes_;
+
+		while (slot.isLinked())
+		{
+			Time * pTime = toTime( slot.pNext() );
+
+			if (shouldCallCancel)
+			{
+				pTime->cancel();
+			}
+			else
+			{
+				pTime->unlink();
+				cancelledTimes_.pushBack( pTime );
+			}
+		}
+	}
+
+	// ڶʱصеclearʱ ڴĽڵ㲻κУ TimersTһ
+	// processڻصغ·ʱ֣ Ҫ
+	numTimes_ = (pProcessingNode_ != NULL && !pProcessingNode_->isCancelled()) ? 1 : 0;
+	this->reclaimCancelledTimes();
+}
+
+template <class TIME_STAMP>
+int TimingWheelT< TIME_STAMP >::process(TimeStamp now)
+{
+	int numFired = 0;
+	uint64 nowTick = uint64(now) / resolution_;
+
+	while (currTick_ <= nowTick)
+	{
+		// ûжʱʱֱתtick
+		if (numTimes_ == 0)
+		{
+			currTick_ = nowTick + 1;
+			break;
+		}
+
+		int index = int(currTick_ & ROOT_MASK);
+
+		// һתһȦ һӦӵĶʱɢ²
+		if (index == 0)
+		{
+			for (int level = 1; level < NUM_LEVELS; ++level)
+			{
+				int levelIndex = int((currTick_ >> (ROOT_BITS + (level - 1) * LEVEL_BITS)) & LEVEL_MASK);
+				this->cascade( level, levelIndex );
+
+				if (levelIndex != 0)
+					break;
+			}
+		}
+
+		slots_[index].moveTo( processingTimes_ );
+		++currTick_;
+
+		while (processingTimes_.isLinked())
+		{
+			Time * pTime = pProcessingNode_ = toTime( processingTimes_.pNext() );
+			pTime->unlink();
+
+			++numFired;
+			pTime->triggerTimer();
+
+			if (!pTime->isCancelled())
+			{
+				this->addToWheel( pTime );
+			}
+			else
+			{
+				cancelledTimes_.pushBack( pTime );
+			}
+		}
+
+		pProcessingNode_ = NULL;
+	}
+
+	this->reclaimCancelledTimes();
+	return numFired;
+}
+
+template <class TIME_STAMP>
+bool TimingWheelT< TIME_STAMP >::legal(TimerHandle handle) const
+{
+	Time * pTime = static_cast< Time* >( handle.time() );
+
+	if (pTime == NULL)
+	{
+		return false;
+	}
+
+	if (pTime == pProcessingNode_)
+	{
+		return true;
+	}
+
+	return !pTime->isCancelled() && pTime->isLinked();
+}
+
+template <class TIME_STAMP>
+TIME_STAMP TimingWheelT< TIME_STAMP >::nextExp(TimeStamp now) const
+{
+	if (numTimes_ == 0)
+	{
+		return 0;
+	}
+
+	// ֻҵһ㵽һηɢϲ֮ǰĲ֣ ϲĶʱʱ䵽
+	uint64 tick = currTick_;
+	if ((tick & ROOT_MASK) != 0)
+	{
+		while (!slots_[tick & ROOT_MASK].isLinked() && ((++tick) & ROOT_MASK) != 0)
+		{
+		}
+	}
+
+	uint64 expTime = tick * resolution_;
+	if (expTime <= uint64(now))
+	{
+		return 0;
+	}
+
+	return TimeStamp(expTime - uint64(now));
+}
+
+template <class TIME_STAMP>
+bool TimingWheelT< TIME_STAMP >::getTimerInfo( TimerHandle handle,
+					TimeStamp &			time,
+					TimeStamp &			interval,
+					void * &			pUser ) const
+{
+	Time * pTime = static_cast< Time * >( handle.time() );
+
+	if (!pTime->isCancelled())
+	{
+		time = pTime->time();
+		interval = pTime->interval();
+		pUser = pTime->getUserData();
+
+		return true;
+	}
+
+	return false;
+}
+
+template <class TIME_STAMP>
+TimingWheelT< TIME_STAMP >::Time::Time( TimersBase & owner,
+		TimeStamp startTime, TimeStamp interval,
+		TimerHandler * _pHandler, void * _pUser ) :
+	TimeBase(owner, _pHandler, _pUser),
+	ListNode(),
+	time_(startTime),
+	interval_(interval)
+{
+}
+
+template <class TIME_STAMP>
+void TimingWheelT< TIME_STAMP >::Time::triggerTimer()
+{
+	if (!this->isCancelled())
+	{
+		state_ = TIME_EXECUTING;
+
+		pHandler_->handleTimeout( TimerHandle( this ), pUserData_ );
+
+		if ((interval_ == 0) && !this->isCancelled())
+		{
+			this->cancel();
+		}
+	}
+
+	if (!this->isCancelled())
+	{
+		time_ += interval_;
+		state_ = TIME_PENDING;
+	}
+}
+
+}
@@ -61,6 +61,18 @@ DBID EntityTable::writeTable(DBInterface* pdbi, DBID dbid, int8 shouldAutoLoad,
 	return dbid;
 }
 
+//-------------------------------------------------------------------------------------
+uint32 EntityTable::writeTables(DBInterface* pdbi, ENTITY_WRITE_INFOS& infos, ScriptDefModule* pModule)
+{
+	ENTITY_WRITE_INFOS::iterator iter = infos.begin();
+	for(; iter != infos.end(); ++iter)
+	{
+		iter->dbid = writeTable(pdbi, iter->dbid, iter->shouldAutoLoad, iter->s, pModule);
+	}
+
+	return 0;
+}
+
 //-------------------------------------------------------------------------------------
 bool EntityTable::removeEntity(DBInterface* pdbi, DBID dbid, ScriptDefModule* pModule)
 {
@@ -301,6 +313,15 @@ DBID EntityTables::writeEntity(DBInterface* pdbi, DBID dbid, int8 shouldAutoLoad
 	return pTable->writeTable(pdbi, dbid, shouldAutoLoad, s, pModule);
 }
 
+//-------------------------------------------------------------------------------------
+uint32 EntityTables::writeEntities(DBInterface* pdbi, ENTITY_WRITE_INFOS& infos, ScriptDefModule* pModule)
+{
+	EntityTable* pTable = this->findTable(pModule->getName());
+	KBE_ASSERT(pTable != NULL);
+
+	return pTable->writeTables(pdbi, infos, pModule);
+}
+
 //-------------------------------------------------------------------------------------
 bool EntityTables::removeEntity(DBInterface* pdbi, DBID dbid, ScriptDefModule* pModule)
 {
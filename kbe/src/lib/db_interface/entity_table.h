@@ -43,6 +43,18 @@ class MemoryStream;
 #define TABLE_ARRAY_ITEM_VALUES_CONST_STR		"values"
 #define TABLE_AUTOLOAD_CONST_STR				"autoLoad"
 
+/*
+	дʱÿʵдϢ дʧʱdbidΪ0
+*/
+struct EntityWriteInfo
+{
+	DBID dbid;
+	int8 shouldAutoLoad;
+	MemoryStream* s;
+};
+
+typedef std::vector<EntityWriteInfo> ENTITY_WRITE_INFOS;
+
 /**
 	db
 */
@@ -229,6 +241,12 @@ public:
 	*/
 	virtual DBID writeTable(DBInterface* pdbi, DBID dbid, int8 shouldAutoLoad, MemoryStream* s, ScriptDefModule* pModule);
 
+	/**
+		± ֻѾݿеʵ壬 غϲִе
+		ĬwriteTable
+	*/
+	virtual uint32 writeTables(DBInterface* pdbi, ENTITY_WRITE_INFOS& infos, ScriptDefModule* pModule);
+
 	/**
 		ݿɾentity
 	*/
@@ -329,6 +347,11 @@ public:
 	*/
 	DBID writeEntity(DBInterface* pdbi, DBID dbid, int8 shouldAutoLoad, MemoryStream* s, ScriptDefModule* pModule);
 
+	/**
+		дͬһentityݿ⣬ غϲִе
+	*/
+	uint32 writeEntities(DBInterface* pdbi, ENTITY_WRITE_INFOS& infos, ScriptDefModule* pModule);
+
 	/**
 		ݿɾentity
 	*/
@@ -71,6 +71,16 @@ public:
 
 	virtual bool queryEntity(DBInterface * pdbi, DBID dbid, EntityLog& entitylog, ENTITY_SCRIPT_UID entityType) = 0;
 
+	/**
+		һβѯentity߼¼ ֻߵentityentitylogs
+		falseʾֻ֧߲ѯʧܣ ҪʹqueryEntity
+	*/
+	virtual bool queryEntities(DBInterface * pdbi, const std::vector<DBID>& dbids, 
+		std::map<DBID, EntityLog>& entitylogs, ENTITY_SCRIPT_UID entityType)
+	{
+		return false;
+	}
+
 	virtual bool eraseEntityLog(DBInterface * pdbi, DBID dbid, ENTITY_SCRIPT_UID entityType) = 0;
 	virtual bool eraseBaseappEntityLog(DBInterface * pdbi, COMPONENT_ID componentID) = 0;
 
@@ -134,6 +144,17 @@ public:
 	}
 
 	virtual bool queryAccount(DBInterface * pdbi, const std::string& name, ACCOUNT_INFOS& info) = 0;
+
+	/**
+		һβѯ˺(˺email) ҵ˺ԴΪkeyinfos
+		falseʾֻ֧߲ѯʧܣ ҪʹqueryAccount
+	*/
+	virtual bool queryAccounts(DBInterface * pdbi, const std::vector<std::string>& names, 
+		std::map<std::string, ACCOUNT_INFOS>& infos)
+	{
+		return false;
+	}
+
 	virtual bool logAccount(DBInterface * pdbi, ACCOUNT_INFOS& info) = 0;
 	virtual bool setFlagsDeadline(DBInterface * pdbi, const std::string& name, uint32 flags, uint64 deadline) = 0;
 	virtual bool updateCount(DBInterface * pdbi, const std::string& name, DBID dbid) = 0;
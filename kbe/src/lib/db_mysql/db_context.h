@@ -33,6 +33,8 @@ namespace mysql {
 	parentTableName
 
 	tableNameǰ
+
+	isKeep浵δıԪأ ֻռӱа˳ӦĿ κд
  */
 class DBContext
 {
@@ -45,17 +47,24 @@ public:
 		DB_ITEM_DATA()
 		{
 			sqlkey = NULL;
+			isRaw = false;
+			isBinary = false;
 		}
 
 		char sqlval[MAX_BUF];
 		const char* sqlkey;
 		std::string extraDatas;
+
+		// extraDatasΪδתַ(isBinaryΪtrueʱΪ) ʽд
+		bool isRaw;
+		bool isBinary;
 	};
 
 	typedef std::vector< std::pair< std::string/*tableName*/, KBEShared_ptr< DBContext > > > DB_RW_CONTEXTS;
 	typedef std::vector< KBEShared_ptr<DB_ITEM_DATA>  > DB_ITEM_DATAS;
 
-	DBContext()
+	DBContext():
+	isKeep(false)
 	{
 	}
 
@@ -74,6 +83,7 @@ public:
 	DB_RW_CONTEXTS optable;
 	
 	bool isEmpty;
+	bool isKeep;
 	
 	std::map<DBID, std::vector<DBID> > dbids;
 	std::map<DBID, std::pair< std::vector<std::string>::size_type, std::vector<std::string> > > results;
@@ -13,6 +13,12 @@ namespace KBEngine {
 
 static KBEngine::thread::ThreadMutex _g_logMutex;
 static KBEUnordered_map< std::string, uint32 > g_querystatistics;
+static uint64 g_numQuerys = 0;
+static uint64 g_numPreparedExecutes = 0;
+static uint64 g_numStatementPrepares = 0;
+static uint64 g_numStatementEvictions = 0;
+static uint64 g_numEntityLoads = 0;
+static uint64 g_numEntityLoadRoundTrips = 0;
 static bool _g_installedWatcher = false;
 static bool _g_debug = false;
 
@@ -34,6 +40,8 @@ static void querystatistics(const char* strCommand, uint32 size)
 
 	_g_logMutex.lockMutex();
 
+	++g_numQuerys;
+
 	KBEUnordered_map< std::string, uint32 >::iterator iter = g_querystatistics.find(op);
 	if(iter == g_querystatistics.end())
 	{
@@ -105,6 +113,88 @@ static uint32 watcher_grant(const std::string&)
 	return watcher_query("GRANT");
 }
 
+static uint64 watcher_total()
+{
+	KBEngine::thread::ThreadGuard tg(&_g_logMutex); 
+	return g_numQuerys;
+}
+
+static uint64 watcher_preparedExecutes()
+{
+	KBEngine::thread::ThreadGuard tg(&_g_logMutex); 
+	return g_numPreparedExecutes;
+}
+
+static uint64 watcher_statementPrepares()
+{
+	KBEngine::thread::ThreadGuard tg(&_g_logMutex); 
+	return g_numStatementPrepares;
+}
+
+static uint64 watcher_statementEvictions()
+{
+	KBEngine::thread::ThreadGuard tg(&_g_logMutex); 
+	return g_numStatementEvictions;
+}
+
+static uint64 watcher_entityLoads()
+{
+	KBEngine::thread::ThreadGuard tg(&_g_logMutex); 
+	return g_numEntityLoads;
+}
+
+static uint64 watcher_entityLoadRoundTrips()
+{
+	KBEngine::thread::ThreadGuard tg(&_g_logMutex); 
+	return g_numEntityLoadRoundTrips;
+}
+
+static float watcher_roundTripsPerEntityLoad()
+{
+	KBEngine::thread::ThreadGuard tg(&_g_logMutex); 
+	if (g_numEntityLoads == 0)
+		return 0.f;
+
+	return (float)g_numEntityLoadRoundTrips / g_numEntityLoads;
+}
+
+static uint64 watcher_entityLoadsPerSecond()
+{
+	static uint64 lastStamp = timestamp();
+	static uint64 lastLoads = watcher_entityLoads();
+
+	uint64 now = timestamp();
+	uint64 elapsed = now - lastStamp;
+	if (elapsed == 0)
+		return 0;
+
+	uint64 loads = watcher_entityLoads();
+	uint64 delta = loads - lastLoads;
+	lastStamp = now;
+	lastLoads = loads;
+
+	return (uint64)(delta * stampsPerSecondD() / elapsed);
+}
+
+static uint64 watcher_querysPerSecond()
+{
+	// βѯ֮ƽֵ ѹʱڲѯɵõÿִе
+	static uint64 lastStamp = timestamp();
+	static uint64 lastQuerys = watcher_total();
+
+	uint64 now = timestamp();
+	uint64 elapsed = now - lastStamp;
+	if (elapsed == 0)
+		return 0;
+
+	uint64 querys = watcher_total();
+	uint64 delta = querys - lastQuerys;
+	lastStamp = now;
+	lastQuerys = querys;
+
+	return (uint64)(delta * stampsPerSecondD() / elapsed);
+}
+
 static void initializeWatcher()
 {
 	if(_g_installedWatcher)
@@ -122,6 +212,15 @@ static void initializeWatcher()
 	WATCH_OBJECT("db_querys/show", &KBEngine::watcher_show);
 	WATCH_OBJECT("db_querys/alter", &KBEngine::watcher_alter);
 	WATCH_OBJECT("db_querys/grant", &KBEngine::watcher_grant);
+	WATCH_OBJECT("db_querys/total", &KBEngine::watcher_total);
+	WATCH_OBJECT("db_querys/querysPerSecond", &KBEngine::watcher_querysPerSecond);
+	WATCH_OBJECT("db_querys/prepared/executes", &KBEngine::watcher_preparedExecutes);
+	WATCH_OBJECT("db_querys/prepared/prepares", &KBEngine::watcher_statementPrepares);
+	WATCH_OBJECT("db_querys/prepared/evictions", &KBEngine::watcher_statementEvictions);
+	WATCH_OBJECT("db_querys/entityLoads/total", &KBEngine::watcher_entityLoads);
+	WATCH_OBJECT("db_querys/entityLoads/perSecond", &KBEngine::watcher_entityLoadsPerSecond);
+	WATCH_OBJECT("db_querys/entityLoads/roundTrips", &KBEngine::watcher_entityLoadRoundTrips);
+	WATCH_OBJECT("db_querys/entityLoads/roundTripsPerLoad", &KBEngine::watcher_roundTripsPerEntityLoad);
 }
 
 size_t DBInterfaceMysql::sql_max_allowed_packet_ = 0;
@@ -133,14 +232,29 @@ hasLostConnection_(false),
 inTransaction_(false),
 lock_(NULL, false),
 characterSet_(characterSet),
-collation_(collation)
+collation_(collation),
+preparedStatements_(),
+preparedStatementMap_(),
+preparedStatementCacheSize_(0),
+batchEntityLoad_(false),
+lastQueryPrepared_(false),
+stmtInsertID_(0),
+stmtAffectedRows_(0)
 {
 	lock_.pdbi(this);
+
+	DBInterfaceInfo* pDBInfo = g_kbeSrvConfig.dbInterface(name);
+	if (pDBInfo)
+	{
+		preparedStatementCacheSize_ = pDBInfo->db_preparedStatementCacheSize;
+		batchEntityLoad_ = pDBInfo->db_batchEntityLoad;
+	}
 }
 
 //-------------------------------------------------------------------------------------
 DBInterfaceMysql::~DBInterfaceMysql()
 {
+	clearPreparedStatements();
 }
 
 //-------------------------------------------------------------------------------------
@@ -184,9 +298,12 @@ bool DBInterfaceMysql::attach(const char* databaseName)
 
 		int ntry = 0;
 
+		// ϲȡʵʱһаѯ
+		unsigned long clientFlags = batchEntityLoad_ ? CLIENT_MULTI_STATEMENTS : 0;
+
 __RECONNECT:
 		if(mysql_real_connect(mysql(), db_ip_, db_username_, 
-    		db_password_, db_name_, db_port_, NULL, 0)) // CLIENT_MULTI_STATEMENTS  
+    		db_password_, db_name_, db_port_, NULL, clientFlags))
 		{
 			if(mysql_select_db(mysql(), db_name_) != 0)
 			{
@@ -215,7 +332,7 @@ __RECONNECT:
 				}
 
 				if (mysql_real_connect(mysql(), db_ip_, db_username_,
-					db_password_, NULL, db_port_, NULL, 0)) // CLIENT_MULTI_STATEMENTS  
+					db_password_, NULL, db_port_, NULL, clientFlags))
 				{
 					this->createDatabaseIfNotExist();
 					if (mysql_select_db(mysql(), db_name_) != 0)
@@ -406,6 +523,8 @@ bool DBInterfaceMysql::reattach()
 //-------------------------------------------------------------------------------------
 bool DBInterfaceMysql::detach()
 {
+	clearPreparedStatements();
+
 	if(mysql())
 	{
 		::mysql_close(mysql());
@@ -465,6 +584,7 @@ bool DBInterfaceMysql::query(const char* cmd, uint32 size, bool printlog, Memory
 	querystatistics(cmd, size);
 
 	lastquery_.assign(cmd, size);
+	lastQueryPrepared_ = false;
 
 	if(_g_debug)
 	{
@@ -499,6 +619,207 @@ bool DBInterfaceMysql::query(const char* cmd, uint32 size, bool printlog, Memory
     return result == NULL || write_query_result(result);
 }
 
+//-------------------------------------------------------------------------------------
+void DBInterfaceMysql::clearPreparedStatements()
+{
+	PREPARED_STATEMENTS::iterator iter = preparedStatements_.begin();
+	for(; iter != preparedStatements_.end(); ++iter)
+		delete (*iter);
+
+	preparedStatements_.clear();
+	preparedStatementMap_.clear();
+}
+
+//-------------------------------------------------------------------------------------
+mysql::PreparedStatement* DBInterfaceMysql::findPreparedStatement(const std::string& sql)
+{
+	KBEUnordered_map<std::string, PREPARED_STATEMENTS::iterator>::iterator iter = preparedStatementMap_.find(sql);
+	if(iter != preparedStatementMap_.end())
+	{
+		// Ƶʹõλ
+		preparedStatements_.splice(preparedStatements_.begin(), preparedStatements_, iter->second);
+		return preparedStatements_.front();
+	}
+
+	mysql::PreparedStatement* pStatement = new mysql::PreparedStatement(sql);
+	if(!pStatement->prepare(pMysql_))
+	{
+		// ޷Ԥ(ӶϿ)ıִв
+		WARNING_MSG(fmt::format("DBInterfaceMysql::findPreparedStatement: prepare error({}:{})!\nsql:({})\n", 
+			pStatement->errnum(), pStatement->error(), sql));
+
+		delete pStatement;
+		return NULL;
+	}
+
+	uint32 numEvictions = 0;
+
+	while(preparedStatements_.size() >= preparedStatementCacheSize_)
+	{
+		mysql::PreparedStatement* pOldStatement = preparedStatements_.back();
+		preparedStatementMap_.erase(pOldStatement->sql());
+		preparedStatements_.pop_back();
+		delete pOldStatement;
+		++numEvictions;
+	}
+
+	preparedStatements_.push_front(pStatement);
+	preparedStatementMap_[sql] = preparedStatements_.begin();
+
+	_g_logMutex.lockMutex();
+	++g_numStatementPrepares;
+	g_numStatementEvictions += numEvictions;
+	_g_logMutex.unlockMutex();
+
+	return pStatement;
+}
+
+//-------------------------------------------------------------------------------------
+bool DBInterfaceMysql::execute(const std::string& sql, const mysql::SQL_PARAMS& params, bool printlog, mysql::SQL_ROWS* pRows)
+{
+	mysql::PreparedStatement* pStatement = NULL;
+
+	if(pMysql_ != NULL && preparedStatementCacheSize_ > 0)
+		pStatement = findPreparedStatement(sql);
+
+	if(pStatement == NULL)
+	{
+		std::string sqlstr;
+		expandSql(sql, params, sqlstr);
+		return queryRows(sqlstr, printlog, pRows);
+	}
+
+	querystatistics(sql.c_str(), (uint32)sql.size());
+
+	_g_logMutex.lockMutex();
+	++g_numPreparedExecutes;
+	_g_logMutex.unlockMutex();
+
+	lastquery_ = sql;
+	lastQueryPrepared_ = true;
+
+	if(_g_debug)
+	{
+		DEBUG_MSG(fmt::format("DBInterfaceMysql::execute({:p}): {}\n", (void*)this, lastquery_));
+	}
+
+	if(!pStatement->execute(params, pRows))
+	{
+		if(printlog)
+		{
+			ERROR_MSG(fmt::format("DBInterfaceMysql::execute: error({}:{})!\nsql:({})\n", 
+				pStatement->errnum(), pStatement->error(), lastquery_)); 
+		}
+
+		DBException e(NULL);
+		e.setError(pStatement->error(), pStatement->errnum());
+
+		if (e.isLostConnection())
+			this->hasLostConnection(true);
+
+		// 䲻ٸã ´ʹʱԤ
+		preparedStatementMap_.erase(sql);
+		preparedStatements_.remove(pStatement);
+		delete pStatement;
+
+		this->throwError(&e);
+		return false;
+	}
+
+	stmtInsertID_ = pStatement->insertID();
+	stmtAffectedRows_ = pStatement->affectedRows();
+
+	if(printlog)
+	{
+		INFO_MSG("DBInterfaceMysql::execute: successfully!\n"); 
+	}
+
+	return true;
+}
+
+//-------------------------------------------------------------------------------------
+bool DBInterfaceMysql::queryRows(const std::string& sql, bool printlog, mysql::SQL_ROWS* pRows)
+{
+	if(!query(sql.c_str(), (uint32)sql.size(), printlog))
+		return false;
+
+	if(pRows == NULL)
+		return true;
+
+	MYSQL_RES * pResult = mysql_store_result(pMysql_);
+	if(pResult)
+	{
+		uint32 nfields = (uint32)mysql_num_fields(pResult);
+
+		MYSQL_ROW arow;
+		while((arow = mysql_fetch_row(pResult)) != NULL)
+		{
+			unsigned long *lengths = mysql_fetch_lengths(pResult);
+
+			pRows->push_back(mysql::SQL_ROW());
+			mysql::SQL_ROW& row = pRows->back();
+			row.resize(nfields);
+
+			for (uint32 i = 0; i < nfields; ++i)
+			{
+				if (arow[i] != NULL)
+					row[i].assign(arow[i], lengths[i]);
+			}
+		}
+
+		mysql_free_result(pResult);
+	}
+
+	return true;
+}
+
+//-------------------------------------------------------------------------------------
+void DBInterfaceMysql::expandSql(const std::string& sql, const mysql::SQL_PARAMS& params, std::string& out)
+{
+	out.reserve(sql.size() + params.size() * 16);
+
+	std::vector<char> tbuf;
+	mysql::SQL_PARAMS::const_iterator paramIter = params.begin();
+
+	for(std::string::size_type i = 0; i < sql.size(); ++i)
+	{
+		// ֻвʹ? ಿֶǱֵֶ
+		if(sql[i] != '?' || paramIter == params.end())
+		{
+			out += sql[i];
+			continue;
+		}
+
+		const mysql::SqlParam& param = (*paramIter++);
+
+		switch(param.type)
+		{
+		case mysql::SqlParam::TYPE_INT64:
+			out += fmt::format("{}", param.i64);
+			break;
+		case mysql::SqlParam::TYPE_UINT64:
+			out += fmt::format("{}", (uint64)param.i64);
+			break;
+		case mysql::SqlParam::TYPE_STRING:
+		case mysql::SqlParam::TYPE_BLOB:
+			tbuf.resize(param.length * 2 + 1);
+
+			if(pMysql_)
+				mysql_real_escape_string(pMysql_, &tbuf[0], param.data, param.length);
+			else
+				mysql_escape_string(&tbuf[0], param.data, param.length);
+
+			out += "\"";
+			out += &tbuf[0];
+			out += "\"";
+			break;
+		default:
+			out.append(param.data, param.length);
+			break;
+		};
+	}
+}
+
 //-------------------------------------------------------------------------------------
 bool DBInterfaceMysql::write_query_result(MemoryStream * result)
 {
@@ -541,6 +862,7 @@ bool DBInterfaceMysql::write_query_result(MemoryStream * result)
 		catch (MemoryStreamWriteOverflow & e)
 		{
 			mysql_free_result(pResult);
+			freeMoreResults();
 			result->wpos(wpos);
 
 			DBException e1(NULL);
@@ -569,9 +891,46 @@ bool DBInterfaceMysql::write_query_result(MemoryStream * result)
 		(*result) << lastInsertID;
 	}
 
+	// űִеԭʼܰ䣬 ֻصһ
+	freeMoreResults();
 	return true;
 }
 
+//-------------------------------------------------------------------------------------
+void DBInterfaceMysql::freeMoreResults()
+{
+	if(pMysql_ == NULL)
+		return;
+
+	while(mysql_more_results(pMysql_) && mysql_next_result(pMysql_) == 0)
+	{
+		MYSQL_RES * pResult = mysql_store_result(pMysql_);
+		if(pResult)
+			mysql_free_result(pResult);
+	}
+}
+
+//-------------------------------------------------------------------------------------
+void DBInterfaceMysql::onEntityLoaded(uint32 numRoundTrips)
+{
+	_g_logMutex.lockMutex();
+	++g_numEntityLoads;
+	g_numEntityLoadRoundTrips += numRoundTrips;
+	_g_logMutex.unlockMutex();
+}
+
+//-------------------------------------------------------------------------------------
+uint64 DBInterfaceMysql::numEntityLoads()
+{
+	return watcher_entityLoads();
+}
+
+//-------------------------------------------------------------------------------------
+uint64 DBInterfaceMysql::numEntityLoadRoundTrips()
+{
+	return watcher_entityLoadRoundTrips();
+}
+
 //-------------------------------------------------------------------------------------
 bool DBInterfaceMysql::getTableNames(std::vector<std::string>& tableNames, const char * pattern)
 {
@@ -5,6 +5,7 @@
 
 #include "common.h"
 #include "db_transaction.h"
+#include "prepared_statement.h"
 #include "common/common.h"
 #include "common/singleton.h"
 #include "common/memorystream.h"
@@ -91,8 +92,51 @@ public:
 
 	virtual bool query(const char* strCommand, uint32 size, bool printlog = true, MemoryStream * result = NULL);
 
+	/**
+		ִд䣬 ?ռλ pRowsΪNULLʱȡѯ
+		Ԥ仺ʱԶЭ󶨲 ʡȥת 򽫲תִı
+	*/
+	bool execute(const std::string& sql, const mysql::SQL_PARAMS& params, bool printlog = true, mysql::SQL_ROWS* pRows = NULL);
+
+	/**
+		ת
+	*/
+	void expandSql(const std::string& sql, const mysql::SQL_PARAMS& params, std::string& out);
+
+	/**
+		رջеԤ䣬 Ͽǰ
+	*/
+	void clearPreparedStatements();
+
+	/**
+		Ԥ仺ޣ 0ΪʹԤ䣬 ޸ʱرѻ
+	*/
+	uint32 preparedStatementCacheSize() const { return preparedStatementCacheSize_; }
+	void preparedStatementCacheSize(uint32 size) { clearPreparedStatements(); preparedStatementCacheSize_ = size; }
+
 	bool write_query_result(MemoryStream * result);
 
+	/**
+		δȡĽ ϵһʧ
+	*/
+	void freeMoreResults();
+
+	/**
+		ȡʵʱǷбĲѯϲΪһ
+	*/
+	bool batchEntityLoad() const { return batchEntityLoad_; }
+
+	/**
+		ͳһʵȡ numRoundTripsΪݿ
+	*/
+	static void onEntityLoaded(uint32 numRoundTrips);
+
+	/**
+		ۼƵʵȡ
+	*/
+	static uint64 numEntityLoads();
+	static uint64 numEntityLoadRoundTrips();
+
 	/**
 		ȡݿеı
 	*/
@@ -112,9 +156,9 @@ public:
 
 	void throwError(DBException* pDBException);
 
-	my_ulonglong insertID()		{ return mysql_insert_id( pMysql_ ); }
+	my_ulonglong insertID()		{ return lastQueryPrepared_ ? stmtInsertID_ : mysql_insert_id( pMysql_ ); }
 
-	my_ulonglong affectedRows()	{ return mysql_affected_rows( pMysql_ ); }
+	my_ulonglong affectedRows()	{ return lastQueryPrepared_ ? stmtAffectedRows_ : mysql_affected_rows( pMysql_ ); }
 
 	const char* info()			{ return mysql_info( pMysql_ ); }
 
@@ -182,6 +226,11 @@ public:
 	*/
 	virtual const char* getAutoIncrementInit();
 
+protected:
+	mysql::PreparedStatement* findPreparedStatement(const std::string& sql);
+
+	bool queryRows(const std::string& sql, bool printlog, mysql::SQL_ROWS* pRows);
+
 protected:
 	MYSQL* pMysql_;
 
@@ -194,6 +243,18 @@ protected:
 	std::string characterSet_;
 	std::string collation_;
 
+	// Ԥ仺棬 ʹ ʱرδʹõ
+	typedef std::list<mysql::PreparedStatement*> PREPARED_STATEMENTS;
+	PREPARED_STATEMENTS preparedStatements_;
+	KBEUnordered_map<std::string, PREPARED_STATEMENTS::iterator> preparedStatementMap_;
+	uint32 preparedStatementCacheSize_;
+
+	bool batchEntityLoad_;
+
+	bool lastQueryPrepared_;
+	my_ulonglong stmtInsertID_;
+	my_ulonglong stmtAffectedRows_;
+
 	static size_t sql_max_allowed_packet_;
 };
 
@@ -5,6 +5,7 @@
 #include "read_entity_helper.h"
 #include "write_entity_helper.h"
 #include "remove_entity_helper.h"
+#include "db_transaction.h"
 #include "entitydef/scriptdef_module.h"
 #include "entitydef/property.h"
 #include "entitydef/entitydef.h"
@@ -768,15 +769,8 @@ void EntityTableMysql::entityShouldAutoLoad(DBInterface* pdbi, DBID dbid, bool s
 }
 
 //-------------------------------------------------------------------------------------
-DBID EntityTableMysql::writeTable(DBInterface* pdbi, DBID dbid, int8 shouldAutoLoad, MemoryStream* s, ScriptDefModule* pModule)
+bool EntityTableMysql::getWriteSqlItems(DBInterface* pdbi, MemoryStream* s, mysql::DBContext& context)
 {
-	mysql::DBContext context;
-	context.parentTableName = "";
-	context.parentTableDBID = 0;
-	context.dbid = dbid;
-	context.tableName = pModule->getName();
-	context.isEmpty = false;
-
 	while(s->length() > 0)
 	{
 		ENTITY_PROPERTY_UID pid;
@@ -787,12 +781,31 @@ DBID EntityTableMysql::writeTable(DBInterface* pdbi, DBID dbid, int8 shouldAutoL
 		if(pTableItem == NULL)
 		{
 			ERROR_MSG(fmt::format("EntityTable::writeTable: not found item[{}].\n", child_pid));
-			return dbid;
+			return false;
 		}
 		
-		static_cast<EntityTableItemMysqlBase*>(pTableItem)->getWriteSqlItem(pdbi, s, context);
+		if(pid == ENTITY_PERSISTENT_ARRAY_DELTA && pTableItem->type() == TABLE_ITEM_TYPE_FIXEDARRAY)
+			static_cast<EntityTableItemMysql_ARRAY*>(pTableItem)->getWriteSqlItemDelta(pdbi, s, context);
+		else
+			static_cast<EntityTableItemMysqlBase*>(pTableItem)->getWriteSqlItem(pdbi, s, context);
 	};
 
+	return true;
+}
+
+//-------------------------------------------------------------------------------------
+DBID EntityTableMysql::writeTable(DBInterface* pdbi, DBID dbid, int8 shouldAutoLoad, MemoryStream* s, ScriptDefModule* pModule)
+{
+	mysql::DBContext context;
+	context.parentTableName = "";
+	context.parentTableDBID = 0;
+	context.dbid = dbid;
+	context.tableName = pModule->getName();
+	context.isEmpty = false;
+
+	if(!getWriteSqlItems(pdbi, s, context))
+		return dbid;
+
 	if(!WriteEntityHelper::writeDB(context.dbid > 0 ? TABLE_OP_UPDATE : TABLE_OP_INSERT, 
 		pdbi, context))
 		return 0;
@@ -810,6 +823,129 @@ DBID EntityTableMysql::writeTable(DBInterface* pdbi, DBID dbid, int8 shouldAutoL
 	return dbid;
 }
 
+//-------------------------------------------------------------------------------------
+uint32 EntityTableMysql::writeTables(DBInterface* pdbi, ENTITY_WRITE_INFOS& infos, ScriptDefModule* pModule)
+{
+	if(infos.size() == 1)
+	{
+		infos[0].dbid = writeTable(pdbi, infos[0].dbid, infos[0].shouldAutoLoad, infos[0].s, pModule);
+		return 1;
+	}
+
+	std::vector<size_t> rposs;
+	rposs.reserve(infos.size());
+
+	ENTITY_WRITE_INFOS::iterator iter = infos.begin();
+	for(; iter != infos.end(); ++iter)
+		rposs.push_back(iter->s->rpos());
+
+	uint32 numStatements = 0;
+	bool success = false;
+
+	{
+		mysql::DBTransaction transaction(pdbi);
+		success = writeTablesBatch(pdbi, infos, pModule, numStatements);
+
+		if(success)
+			transaction.commit();
+	}
+
+	if(success)
+		return numStatements;
+
+	// ϲдʧ(Ѿع) д룬 һʵĴӰͬεʵ
+	WARNING_MSG(fmt::format("EntityTableMysql::writeTables: {} batch({}) failed, write one by one.\n", 
+		pModule->getName(), infos.size()));
+
+	for(size_t i = 0; i < infos.size(); ++i)
+	{
+		infos[i].s->rpos(rposs[i]);
+		infos[i].dbid = writeTable(pdbi, infos[i].dbid, infos[i].shouldAutoLoad, infos[i].s, pModule);
+	}
+
+	return 0;
+}
+
+//-------------------------------------------------------------------------------------
+bool EntityTableMysql::writeTablesBatch(DBInterface* pdbi, ENTITY_WRITE_INFOS& infos, 
+	ScriptDefModule* pModule, uint32& numStatements)
+{
+	std::vector< KBEShared_ptr<mysql::DBContext> > contexts;
+
+	// ֶͬĿϲΪһ䣬 浵ʱÿʵдֶοܲͬ
+	typedef std::map< std::string, std::vector<mysql::DBContext*> > ROW_GROUPS;
+	ROW_GROUPS groups;
+
+	ENTITY_WRITE_INFOS::iterator iter = infos.begin();
+	for(; iter != infos.end(); ++iter)
+	{
+		KBE_ASSERT(iter->dbid > 0);
+
+		mysql::DBContext* pContext = new mysql::DBContext();
+		contexts.push_back(KBEShared_ptr<mysql::DBContext>(pContext));
+
+		pContext->parentTableName = "";
+		pContext->parentTableDBID = 0;
+		pContext->dbid = iter->dbid;
+		pContext->tableName = pModule->getName();
+		pContext->isEmpty = false;
+
+		if(!getWriteSqlItems(pdbi, iter->s, *pContext))
+			return false;
+
+		if(pContext->items.size() == 0)
+			continue;
+
+		std::string columns;
+		mysql::DBContext::DB_ITEM_DATAS::iterator itemIter = pContext->items.begin();
+		for(; itemIter != pContext->items.end(); ++itemIter)
+		{
+			columns += (*itemIter)->sqlkey;
+			columns += ",";
+		}
+
+		groups[columns].push_back(pContext);
+	}
+
+	// һĳȲmax_allowed_packetһ
+	size_t maxStatementSize = DBInterfaceMysql::sql_max_allowed_packet() > 0 ? 
+		DBInterfaceMysql::sql_max_allowed_packet() / 2 : 1024 * 1024;
+
+	ROW_GROUPS::iterator groupIter = groups.begin();
+	for(; groupIter != groups.end(); ++groupIter)
+	{
+		std::vector<mysql::DBContext*>& rows = groupIter->second;
+		size_t start = 0;
+
+		while(start < rows.size())
+		{
+			SqlStatementBatchUpdate sqlcmd(pdbi, pModule->getName(), rows, start, maxStatementSize);
+			if(!sqlcmd.query())
+				return false;
+
+			++numStatements;
+			start = sqlcmd.end();
+		}
+	}
+
+	// Ѿд룬 ʵӱ
+	std::vector< KBEShared_ptr<mysql::DBContext> >::iterator ctxIter = contexts.begin();
+	for(; ctxIter != contexts.end(); ++ctxIter)
+	{
+		if(!WriteEntityHelper::writeDB(TABLE_OP_UPDATE, pdbi, *(*ctxIter), false))
+			return false;
+	}
+
+	// ʵǷԶ
+	for(iter = infos.begin(); iter != infos.end(); ++iter)
+	{
+		if(iter->shouldAutoLoad > -1)
+			entityShouldAutoLoad(pdbi, iter->dbid, iter->shouldAutoLoad > 0);
+	}
+
+	return true;
+}
+
 //-------------------------------------------------------------------------------------
 bool EntityTableMysql::removeEntity(DBInterface* pdbi, DBID dbid, ScriptDefModule* pModule)
 {
@@ -1337,6 +1473,41 @@ void EntityTableItemMysql_ARRAY::getWriteSqlItem(DBInterface* pdbi, MemoryStream
 	}
 }
 
+//-------------------------------------------------------------------------------------
+void EntityTableItemMysql_ARRAY::getWriteSqlItemDelta(DBInterface* pdbi, MemoryStream* s, mysql::DBContext& context)
+{
+	ArraySize size = 0;
+	(*s) >> size;
+
+	if(pChildTable_)
+	{
+		if(size > 0)
+		{
+			for(ArraySize i=0; i<size; ++i)
+			{
+				uint8 changed = 0;
+				(*s) >> changed;
+
+				if(changed > 0)
+				{
+					static_cast<EntityTableMysql*>(pChildTable_)->getWriteSqlItem(pdbi, s, context);
+					continue;
+				}
+
+				size_t numOptables = context.optable.size();
+				static_cast<EntityTableMysql*>(pChildTable_)->getWriteSqlItem(pdbi, NULL, context);
+
+				if(context.optable.size() > numOptables)
+					context.optable.back().second->isKeep = true;
+			}
+		}
+		else
+		{
+			static_cast<EntityTableMysql*>(pChildTable_)->getWriteSqlItem(pdbi, NULL, context);
+		}
+	}
+}
+
 //-------------------------------------------------------------------------------------
 void EntityTableItemMysql_ARRAY::getReadSqlItem(mysql::DBContext& context)
 {
@@ -1856,18 +2027,10 @@ void EntityTableItemMysql_STRING::getWriteSqlItem(DBInterface* pdbi,
 	std::string val;
 	(*s) >> val;
 
-	pSotvs->extraDatas = "\"";
-
-	char* tbuf = new char[val.size() * 2 + 1];
-	memset(tbuf, 0, val.size() * 2 + 1);
-
-	mysql_real_escape_string(static_cast<DBInterfaceMysql*>(pdbi)->mysql(), 
-		tbuf, val.c_str(), val.size());
-
-	pSotvs->extraDatas += tbuf;
-	pSotvs->extraDatas += "\"";
-
-	SAFE_RELEASE_ARRAY(tbuf);
+	// δתԭʼݣ ִʱԤֱӰ󶨣 ıʱת
+	pSotvs->extraDatas.swap(val);
+	pSotvs->isRaw = true;
+	pSotvs->isBinary = false;
 
 	memset(pSotvs->sqlval, 0, sizeof(pSotvs->sqlval));
 	pSotvs->sqlkey = db_item_name();
@@ -1928,16 +2091,9 @@ void EntityTableItemMysql_UNICODE::getWriteSqlItem(DBInterface* pdbi, MemoryStre
 	std::string val;
 	s->readBlob(val);
 
-	char* tbuf = new char[val.size() * 2 + 1];
-	memset(tbuf, 0, val.size() * 2 + 1);
-
-	mysql_real_escape_string(static_cast<DBInterfaceMysql*>(pdbi)->mysql(), 
-		tbuf, val.c_str(), val.size());
-	
-	pSotvs->extraDatas = "\"";
-	pSotvs->extraDatas += tbuf;
-	pSotvs->extraDatas += "\"";
-	SAFE_RELEASE_ARRAY(tbuf);
+	pSotvs->extraDatas.swap(val);
+	pSotvs->isRaw = true;
+	pSotvs->isBinary = false;
 
 	memset(pSotvs->sqlval, 0, sizeof(pSotvs->sqlval));
 	pSotvs->sqlkey = db_item_name();
@@ -1980,16 +2136,9 @@ void EntityTableItemMysql_BLOB::getWriteSqlItem(DBInterface* pdbi, MemoryStream*
 	std::string val;
 	s->readBlob(val);
 
-	char* tbuf = new char[val.size() * 2 + 1];
-	memset(tbuf, 0, val.size() * 2 + 1);
-
-	mysql_real_escape_string(static_cast<DBInterfaceMysql*>(pdbi)->mysql(), 
-		tbuf, val.data(), val.size());
-
-	pSotvs->extraDatas = "\"";
-	pSotvs->extraDatas += tbuf;
-	pSotvs->extraDatas += "\"";
-	SAFE_RELEASE_ARRAY(tbuf);
+	pSotvs->extraDatas.swap(val);
+	pSotvs->isRaw = true;
+	pSotvs->isBinary = true;
 
 	memset(pSotvs->sqlval, 0, sizeof(pSotvs->sqlval));
 	pSotvs->sqlkey = db_item_name();
@@ -2032,16 +2181,9 @@ void EntityTableItemMysql_PYTHON::getWriteSqlItem(DBInterface* pdbi, MemoryStrea
 	std::string val;
 	s->readBlob(val);
 
-	char* tbuf = new char[val.size() * 2 + 1];
-	memset(tbuf, 0, val.size() * 2 + 1);
-
-	mysql_real_escape_string(static_cast<DBInterfaceMysql*>(pdbi)->mysql(), 
-		tbuf, val.c_str(), val.size());
-
-	pSotvs->extraDatas = "\"";
-	pSotvs->extraDatas += tbuf;
-	pSotvs->extraDatas += "\"";
-	SAFE_RELEASE_ARRAY(tbuf);
+	pSotvs->extraDatas.swap(val);
+	pSotvs->isRaw = true;
+	pSotvs->isBinary = true;
 
 	memset(pSotvs->sqlval, 0, sizeof(pSotvs->sqlval));
 	pSotvs->sqlkey = db_item_name();
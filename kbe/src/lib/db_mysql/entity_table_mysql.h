@@ -425,6 +425,11 @@ public:
 	virtual void getWriteSqlItem(DBInterface* pdbi, MemoryStream* s, mysql::DBContext& context);
 	virtual void getReadSqlItem(mysql::DBContext& context);
 
+	/**
+		浵д(ENTITY_PERSISTENT_ARRAY_DELTA) δıԪرӱжӦĿ
+	*/
+	void getWriteSqlItemDelta(DBInterface* pdbi, MemoryStream* s, mysql::DBContext& context);
+
 	virtual void init_db_item_name(const char* exstrFlag = "");
 
 protected:
@@ -555,6 +560,12 @@ public:
 
 	DBID writeTable(DBInterface* pdbi, DBID dbid, int8 shouldAutoLoad, MemoryStream* s, ScriptDefModule* pModule);
 
+	/**
+		± һнĸºϲΪinsert ... on duplicate key update
+		ϲдʧʱعд
+	*/
+	virtual uint32 writeTables(DBInterface* pdbi, ENTITY_WRITE_INFOS& infos, ScriptDefModule* pModule);
+
 	/**
 		ݿɾentity
 	*/
@@ -590,7 +601,13 @@ public:
 	void init_db_item_name();
 
 protected:
-	
+	/**
+		Ӵ浵жȡҪдֶΣ Ҳֶʱfalse
+	*/
+	bool getWriteSqlItems(DBInterface* pdbi, MemoryStream* s, mysql::DBContext& context);
+
+	bool writeTablesBatch(DBInterface* pdbi, ENTITY_WRITE_INFOS& infos, 
+		ScriptDefModule* pModule, uint32& numStatements);
 };
 
 
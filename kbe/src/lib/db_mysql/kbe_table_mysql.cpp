@@ -144,45 +144,20 @@ bool KBEEntityLogTableMysql::syncToDB(DBInterface* pdbi)
 bool KBEEntityLogTableMysql::logEntity(DBInterface * pdbi, const char* ip, uint32 port, DBID dbid,
 					COMPONENT_ID componentID, ENTITY_ID entityID, ENTITY_SCRIPT_UID entityType)
 {
-	std::string sqlstr = "insert into " KBE_TABLE_PERFIX "_entitylog (entityDBID, entityType, entityID, ip, port, componentID, serverGroupID) values(";
+	static const std::string sqlstr = "insert into " KBE_TABLE_PERFIX "_entitylog (entityDBID, entityType, entityID, ip, port, componentID, serverGroupID) values(?,?,?,?,?,?,?)";
 
-	char* tbuf = new char[MAX_BUF * 3];
-
-	kbe_snprintf(tbuf, MAX_BUF, "%" PRDBID, dbid);
-	sqlstr += tbuf;
-	sqlstr += ",";
-	
-	kbe_snprintf(tbuf, MAX_BUF, "%u", entityType);
-	sqlstr += tbuf;
-	sqlstr += ",";
-
-	kbe_snprintf(tbuf, MAX_BUF, "%d", entityID);
-	sqlstr += tbuf;
-	sqlstr += ",\"";
-
-	mysql_real_escape_string(static_cast<DBInterfaceMysql*>(pdbi)->mysql(), 
-		tbuf, ip, strlen(ip));
-
-	sqlstr += tbuf;
-	sqlstr += "\",";
-
-	kbe_snprintf(tbuf, MAX_BUF, "%u", port);
-	sqlstr += tbuf;
-	sqlstr += ",";
-	
-	kbe_snprintf(tbuf, MAX_BUF, "%" PRDBID, componentID);
-	sqlstr += tbuf;
-	sqlstr += ",";
-
-	kbe_snprintf(tbuf, MAX_BUF, "%" PRDBID, (uint64)getUserUID());
-	sqlstr += tbuf;
-	sqlstr += ")";
-
-	SAFE_RELEASE_ARRAY(tbuf);
+	mysql::SQL_PARAMS params;
+	params.push_back(mysql::SqlParam((uint64)dbid));
+	params.push_back(mysql::SqlParam((int64)entityType));
+	params.push_back(mysql::SqlParam((int64)entityID));
+	params.push_back(mysql::SqlParam(mysql::SqlParam::TYPE_STRING, ip, (unsigned long)strlen(ip)));
+	params.push_back(mysql::SqlParam((int64)port));
+	params.push_back(mysql::SqlParam((uint64)componentID));
+	params.push_back(mysql::SqlParam((uint64)getUserUID()));
 
 	try
 	{
-		if(!pdbi->query(sqlstr.c_str(), sqlstr.size(), false))
+		if(!static_cast<DBInterfaceMysql*>(pdbi)->execute(sqlstr, params, false))
 		{
 			// 1062 int err = pdbi->getlasterror(); 
 			return false;
@@ -206,18 +181,14 @@ bool KBEEntityLogTableMysql::logEntity(DBInterface * pdbi, const char* ip, uint3
 //-------------------------------------------------------------------------------------
 bool KBEEntityLogTableMysql::queryEntity(DBInterface * pdbi, DBID dbid, EntityLog& entitylog, ENTITY_SCRIPT_UID entityType)
 {
-	std::string sqlstr = "select entityID, ip, port, componentID, serverGroupID from " KBE_TABLE_PERFIX "_entitylog where entityDBID=";
+	static const std::string sqlstr = "select entityID, ip, port, componentID, serverGroupID from " KBE_TABLE_PERFIX "_entitylog where entityDBID=? and entityType=? LIMIT 1";
 
-	char tbuf[MAX_BUF];
-	kbe_snprintf(tbuf, MAX_BUF, "%" PRDBID, dbid);
-	sqlstr += tbuf;
-	
-	sqlstr += " and entityType=";
-	kbe_snprintf(tbuf, MAX_BUF, "%u", entityType);
-	sqlstr += tbuf;
-	sqlstr += " LIMIT 1";
+	mysql::SQL_PARAMS params;
+	params.push_back(mysql::SqlParam((uint64)dbid));
+	params.push_back(mysql::SqlParam((int64)entityType));
 
-	if(!pdbi->query(sqlstr.c_str(), sqlstr.size(), false))
+	mysql::SQL_ROWS rows;
+	if(!static_cast<DBInterfaceMysql*>(pdbi)->execute(sqlstr, params, false, &rows))
 	{
 		return true;
 	}
@@ -229,40 +200,84 @@ bool KBEEntityLogTableMysql::queryEntity(DBInterface * pdbi, DBID dbid, EntityLo
 	entitylog.ip[0] = '\0';
 	entitylog.port = 0;
 
-	MYSQL_RES * pResult = mysql_store_result(static_cast<DBInterfaceMysql*>(pdbi)->mysql());
-	if(pResult)
+	if(rows.size() > 0)
 	{
-		MYSQL_ROW arow = mysql_fetch_row(pResult);
-		if(arow != NULL)
-		{
-			StringConv::str2value(entitylog.entityID, arow[0]);
-			kbe_snprintf(entitylog.ip, MAX_IP, "%s", arow[1]);
-			StringConv::str2value(entitylog.port, arow[2]);
-			StringConv::str2value(entitylog.componentID, arow[3]);
-			StringConv::str2value(entitylog.serverGroupID, arow[4]);
-		}
-
-		mysql_free_result(pResult);
+		mysql::SQL_ROW& row = rows[0];
+		StringConv::str2value(entitylog.entityID, row[0].c_str());
+		kbe_snprintf(entitylog.ip, MAX_IP, "%s", row[1].c_str());
+		StringConv::str2value(entitylog.port, row[2].c_str());
+		StringConv::str2value(entitylog.componentID, row[3].c_str());
+		StringConv::str2value(entitylog.serverGroupID, row[4].c_str());
 	}
 
 	return entitylog.componentID > 0;
 }
 
 //-------------------------------------------------------------------------------------
-bool KBEEntityLogTableMysql::eraseEntityLog(DBInterface * pdbi, DBID dbid, ENTITY_SCRIPT_UID entityType)
+bool KBEEntityLogTableMysql::queryEntities(DBInterface * pdbi, const std::vector<DBID>& dbids, 
+	std::map<DBID, EntityLog>& entitylogs, ENTITY_SCRIPT_UID entityType)
 {
-	std::string sqlstr = "delete from " KBE_TABLE_PERFIX "_entitylog where entityDBID=";
+	if(dbids.size() == 0)
+		return true;
 
-	char tbuf[MAX_BUF];
+	// ʹı䣬 ÿͬinбӦýԤ仺
+	std::string sqlstr = fmt::format("select entityDBID, entityID, ip, port, componentID, serverGroupID from " 
+		KBE_TABLE_PERFIX "_entitylog where entityType={} and entityDBID in (", entityType);
 
-	kbe_snprintf(tbuf, MAX_BUF, "%" PRDBID, dbid);
-	sqlstr += tbuf;
+	std::vector<DBID>::const_iterator iter = dbids.begin();
+	for(; iter != dbids.end(); ++iter)
+	{
+		if(iter != dbids.begin())
+			sqlstr += ",";
 
-	sqlstr += " and entityType=";
-	kbe_snprintf(tbuf, MAX_BUF, "%u", entityType);
-	sqlstr += tbuf;
+		sqlstr += fmt::format("{}", (*iter));
+	}
+
+	sqlstr += ")";
 
 	if(!pdbi->query(sqlstr.c_str(), sqlstr.size(), false))
+		return false;
+
+	MYSQL_RES * pResult = mysql_store_result(static_cast<DBInterfaceMysql*>(pdbi)->mysql());
+	if(pResult == NULL)
+		return false;
+
+	MYSQL_ROW arow;
+	while((arow = mysql_fetch_row(pResult)) != NULL)
+	{
+		EntityLog entitylog;
+		entitylog.dbid = 0;
+		entitylog.entityID = 0;
+		entitylog.ip[0] = '\0';
+		entitylog.port = 0;
+		entitylog.componentID = 0;
+		entitylog.serverGroupID = 0;
+
+		StringConv::str2value(entitylog.dbid, arow[0]);
+		StringConv::str2value(entitylog.entityID, arow[1]);
+		kbe_snprintf(entitylog.ip, MAX_IP, "%s", arow[2] ? arow[2] : "");
+		StringConv::str2value(entitylog.port, arow[3]);
+		StringConv::str2value(entitylog.componentID, arow[4]);
+		StringConv::str2value(entitylog.serverGroupID, arow[5]);
+
+		if(entitylog.componentID > 0)
+			entitylogs[entitylog.dbid] = entitylog;
+	}
+
+	mysql_free_result(pResult);
+	return true;
+}
+
+//-------------------------------------------------------------------------------------
+bool KBEEntityLogTableMysql::eraseEntityLog(DBInterface * pdbi, DBID dbid, ENTITY_SCRIPT_UID entityType)
+{
+	static const std::string sqlstr = "delete from " KBE_TABLE_PERFIX "_entitylog where entityDBID=? and entityType=?";
+
+	mysql::SQL_PARAMS params;
+	params.push_back(mysql::SqlParam((uint64)dbid));
+	params.push_back(mysql::SqlParam((int64)entityType));
+
+	if(!static_cast<DBInterfaceMysql*>(pdbi)->execute(sqlstr, params, false))
 	{
 		return false;
 	}
@@ -628,46 +643,119 @@ bool KBEAccountTableMysql::setFlagsDeadline(DBInterface * pdbi, const std::strin
 //-------------------------------------------------------------------------------------
 bool KBEAccountTableMysql::queryAccount(DBInterface * pdbi, const std::string& name, ACCOUNT_INFOS& info)
 {
-	std::string sqlstr = "select entityDBID, password, flags, deadline, bindata from " KBE_TABLE_PERFIX "_accountinfos where accountName=\"";
+	static const std::string sqlstr = "select entityDBID, password, flags, deadline, bindata from " KBE_TABLE_PERFIX "_accountinfos where accountName=? or email=? LIMIT 1";
 
-	char* tbuf = new char[name.size() * 2 + 1];
-
-	mysql_real_escape_string(static_cast<DBInterfaceMysql*>(pdbi)->mysql(), 
-		tbuf, name.c_str(), name.size());
-
-	sqlstr += tbuf;
-	sqlstr += "\" or email=\"";
-	sqlstr += tbuf;
-	sqlstr += "\" LIMIT 1";
-	SAFE_RELEASE_ARRAY(tbuf);
+	mysql::SQL_PARAMS params;
+	params.push_back(mysql::SqlParam(name));
+	params.push_back(mysql::SqlParam(name));
 
 	// ѯʧ򷵻شڣ ܲĴ
-	if(!pdbi->query(sqlstr.c_str(), sqlstr.size(), false))
+	mysql::SQL_ROWS rows;
+	if(!static_cast<DBInterfaceMysql*>(pdbi)->execute(sqlstr, params, false, &rows))
 		return true;
 
 	info.dbid = 0;
+	if(rows.size() > 0)
+	{
+		mysql::SQL_ROW& row = rows[0];
+
+		KBEngine::StringConv::str2value(info.dbid, row[0].c_str());
+		info.name = name;
+		info.password = row[1];
+
+		KBEngine::StringConv::str2value(info.flags, row[2].c_str());
+		KBEngine::StringConv::str2value(info.deadline, row[3].c_str());
+
+		info.datas.swap(row[4]);
+	}
+
+	return info.dbid > 0;
+}
+
+//-------------------------------------------------------------------------------------
+bool KBEAccountTableMysql::queryAccounts(DBInterface * pdbi, const std::vector<std::string>& names, 
+	std::map<std::string, ACCOUNT_INFOS>& infos)
+{
+	if(names.size() == 0)
+		return true;
+
+	std::string inlist;
+
+	std::vector<std::string>::const_iterator iter = names.begin();
+	for(; iter != names.end(); ++iter)
+	{
+		char* tbuf = new char[(*iter).size() * 2 + 1];
+
+		mysql_real_escape_string(static_cast<DBInterfaceMysql*>(pdbi)->mysql(), 
+			tbuf, (*iter).c_str(), (*iter).size());
+
+		if(inlist.size() > 0)
+			inlist += ",";
+
+		inlist += "\"";
+		inlist += tbuf;
+		inlist += "\"";
+		SAFE_RELEASE_ARRAY(tbuf);
+	}
+
+	// ʹı䣬 ÿͬinбӦýԤ仺
+	std::string sqlstr = "select accountName, email, entityDBID, password, flags, deadline, bindata from " 
+		KBE_TABLE_PERFIX "_accountinfos where accountName in (";
+
+	sqlstr += inlist;
+	sqlstr += ") or email in (";
+	sqlstr += inlist;
+	sqlstr += ")";
+
+	if(!pdbi->query(sqlstr.c_str(), sqlstr.size(), false))
+		return false;
+
 	MYSQL_RES * pResult = mysql_store_result(static_cast<DBInterfaceMysql*>(pdbi)->mysql());
-	if(pResult)
+	if(pResult == NULL)
+		return false;
+
+	// һֿܼĳ˺ŵaccountNameһ˺ŵemail ȰaccountNameƥ
+	std::map<std::string, ACCOUNT_INFOS> emailInfos;
+
+	MYSQL_ROW arow;
+	while((arow = mysql_fetch_row(pResult)) != NULL)
 	{
-		MYSQL_ROW arow = mysql_fetch_row(pResult);
-		if(arow != NULL)
-		{
-			unsigned long *lengths = mysql_fetch_lengths(pResult);
+		unsigned long *lengths = mysql_fetch_lengths(pResult);
 
-			KBEngine::StringConv::str2value(info.dbid, arow[0]);
-			info.name = name;
-			info.password = arow[1];
+		ACCOUNT_INFOS info;
+		info.name = arow[0] ? arow[0] : "";
+		info.email = arow[1] ? arow[1] : "";
+		KBEngine::StringConv::str2value(info.dbid, arow[2]);
+		info.password = arow[3] ? arow[3] : "";
+		KBEngine::StringConv::str2value(info.flags, arow[4]);
+		KBEngine::StringConv::str2value(info.deadline, arow[5]);
 
-			KBEngine::StringConv::str2value(info.flags, arow[2]);
-			KBEngine::StringConv::str2value(info.deadline, arow[3]);
+		if(arow[6])
+			info.datas.assign(arow[6], lengths[6]);
 
-			info.datas.assign(arow[4], lengths[4]);
-		}
+		if(info.dbid <= 0)
+			continue;
 
-		mysql_free_result(pResult);
+		infos[info.name] = info;
+
+		if(info.email.size() > 0)
+			emailInfos[info.email] = info;
 	}
 
-	return info.dbid > 0;
+	mysql_free_result(pResult);
+
+	std::map<std::string, ACCOUNT_INFOS>::iterator eiter = emailInfos.begin();
+	for(; eiter != emailInfos.end(); ++eiter)
+	{
+		if(infos.find(eiter->first) != infos.end())
+			continue;
+
+		ACCOUNT_INFOS& info = infos[eiter->first];
+		info = eiter->second;
+		info.name = eiter->first;
+	}
+
+	return true;
 }
 
 //-------------------------------------------------------------------------------------
@@ -714,9 +802,14 @@ bool KBEAccountTableMysql::queryAccountAllInfos(DBInterface * pdbi, const std::s
 //-------------------------------------------------------------------------------------
 bool KBEAccountTableMysql::updateCount(DBInterface * pdbi, const std::string& name, DBID dbid)
 {
+	static const std::string sqlstr = "update " KBE_TABLE_PERFIX "_accountinfos set lasttime=?, numlogin=numlogin+1 where entityDBID=?";
+
+	mysql::SQL_PARAMS params;
+	params.push_back(mysql::SqlParam((uint64)time(NULL)));
+	params.push_back(mysql::SqlParam((uint64)dbid));
+
 	// ѯʧ򷵻شڣ ܲĴ
-	if(!pdbi->query(fmt::format("update " KBE_TABLE_PERFIX "_accountinfos set lasttime={}, numlogin=numlogin+1 where entityDBID={}",
-		time(NULL), dbid), false))
+	if(!static_cast<DBInterfaceMysql*>(pdbi)->execute(sqlstr, params, false))
 		return false;
 
 	return true;
@@ -751,62 +844,23 @@ bool KBEAccountTableMysql::updatePassword(DBInterface * pdbi, const std::string&
 //-------------------------------------------------------------------------------------
 bool KBEAccountTableMysql::logAccount(DBInterface * pdbi, ACCOUNT_INFOS& info)
 {
-	std::string sqlstr = "insert into " KBE_TABLE_PERFIX "_accountinfos (accountName, password, bindata, email, entityDBID, flags, deadline, regtime, lasttime) values(";
-
-	char* tbuf = new char[MAX_BUF > info.datas.size() ? MAX_BUF * 3 : info.datas.size() * 3];
-
-	mysql_real_escape_string(static_cast<DBInterfaceMysql*>(pdbi)->mysql(), 
-		tbuf, info.name.c_str(), info.name.size());
-
-	sqlstr += "\"";
-	sqlstr += tbuf;
-	sqlstr += "\",";
-
-	mysql_real_escape_string(static_cast<DBInterfaceMysql*>(pdbi)->mysql(), 
-		tbuf, info.password.c_str(), info.password.size());
+	static const std::string sqlstr = "insert into " KBE_TABLE_PERFIX "_accountinfos (accountName, password, bindata, email, entityDBID, flags, deadline, regtime, lasttime) values(?,md5(?),?,?,?,?,?,?,?)";
 
-	sqlstr += "md5(\"";
-	sqlstr += tbuf;
-	sqlstr += "\"),";
-
-	mysql_real_escape_string(static_cast<DBInterfaceMysql*>(pdbi)->mysql(), 
-		tbuf, info.datas.data(), info.datas.size());
+	uint64 now = (uint64)time(NULL);
 
-	sqlstr += "\"";
-	sqlstr += tbuf;
-	sqlstr += "\",";
-
-	mysql_real_escape_string(static_cast<DBInterfaceMysql*>(pdbi)->mysql(), 
-		tbuf, info.email.c_str(), info.email.size());
-
-	sqlstr += "\"";
-	sqlstr += tbuf;
-	sqlstr += "\",";
-
-	kbe_snprintf(tbuf, MAX_BUF, "%" PRDBID, info.dbid);
-	sqlstr += tbuf;
-	sqlstr += ",";
-
-	kbe_snprintf(tbuf, MAX_BUF, "%u", info.flags);
-	sqlstr += tbuf;
-	sqlstr += ",";
-	
-	kbe_snprintf(tbuf, MAX_BUF, "%" PRIu64, info.deadline);
-	sqlstr += tbuf;
-	sqlstr += ",";
-	
-	kbe_snprintf(tbuf, MAX_BUF, "%" PRTime, time(NULL));
-	sqlstr += tbuf;
-	sqlstr += ",";
-
-	kbe_snprintf(tbuf, MAX_BUF, "%" PRTime, time(NULL));
-	sqlstr += tbuf;
-	sqlstr += ")";
-
-	SAFE_RELEASE_ARRAY(tbuf);
+	mysql::SQL_PARAMS params;
+	params.push_back(mysql::SqlParam(info.name));
+	params.push_back(mysql::SqlParam(info.password));
+	params.push_back(mysql::SqlParam(info.datas, mysql::SqlParam::TYPE_BLOB));
+	params.push_back(mysql::SqlParam(info.email));
+	params.push_back(mysql::SqlParam((uint64)info.dbid));
+	params.push_back(mysql::SqlParam((uint64)info.flags));
+	params.push_back(mysql::SqlParam((uint64)info.deadline));
+	params.push_back(mysql::SqlParam(now));
+	params.push_back(mysql::SqlParam(now));
 
 	// ѯʧ򷵻شڣ ܲĴ
-	if(!pdbi->query(sqlstr.c_str(), sqlstr.size(), false))
+	if(!static_cast<DBInterfaceMysql*>(pdbi)->execute(sqlstr, params, false))
 	{
 		ERROR_MSG(fmt::format("KBEAccountTableMysql::logAccount({}): sql({}) is failed({})!\n", 
 				info.name, sqlstr, pdbi->getstrerror()));
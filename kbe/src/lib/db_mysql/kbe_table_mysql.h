@@ -31,6 +31,8 @@ public:
 						COMPONENT_ID componentID, ENTITY_ID entityID, ENTITY_SCRIPT_UID entityType);
 
 	virtual bool queryEntity(DBInterface * pdbi, DBID dbid, EntityLog& entitylog, ENTITY_SCRIPT_UID entityType);
+	virtual bool queryEntities(DBInterface * pdbi, const std::vector<DBID>& dbids, 
+		std::map<DBID, EntityLog>& entitylogs, ENTITY_SCRIPT_UID entityType);
 
 	virtual bool eraseEntityLog(DBInterface * pdbi, DBID dbid, ENTITY_SCRIPT_UID entityType);
 	virtual bool eraseBaseappEntityLog(DBInterface * pdbi, COMPONENT_ID componentID);
@@ -81,6 +83,8 @@ public:
 	virtual bool syncIndexToDB(DBInterface* pdbi){ return true; }
 
 	bool queryAccount(DBInterface * pdbi, const std::string& name, ACCOUNT_INFOS& info);
+	virtual bool queryAccounts(DBInterface * pdbi, const std::vector<std::string>& names, 
+		std::map<std::string, ACCOUNT_INFOS>& infos);
 	bool queryAccountAllInfos(DBInterface * pdbi, const std::string& name, ACCOUNT_INFOS& info);
 	bool logAccount(DBInterface * pdbi, ACCOUNT_INFOS& info);
 	bool setFlagsDeadline(DBInterface * pdbi, const std::string& name, uint32 flags, uint64 deadline);
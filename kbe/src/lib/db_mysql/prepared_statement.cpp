@@ -0,0 +1,194 @@
+// Copyright 2008-2018 Yolo Technologies, Inc. All Rights Reserved. https://www.comblockengine.com
+
+#include "prepared_statement.h"
+#include "helper/debug_helper.h"
+
+namespace KBEngine {
+namespace mysql {
+
+//-------------------------------------------------------------------------------------
+PreparedStatement::PreparedStatement(const std::string& sql):
+sql_(sql),
+pStmt_(NULL),
+paramCount_(0),
+binds_(),
+lengths_()
+{
+}
+
+//-------------------------------------------------------------------------------------
+PreparedStatement::~PreparedStatement()
+{
+	close();
+}
+
+//-------------------------------------------------------------------------------------
+bool PreparedStatement::prepare(MYSQL* pMysql)
+{
+	close();
+
+	pStmt_ = mysql_stmt_init(pMysql);
+	if(pStmt_ == NULL)
+		return false;
+
+	if(mysql_stmt_prepare(pStmt_, sql_.data(), (unsigned long)sql_.size()) != 0)
+		return false;
+
+	// ȡʱÿеʵ󳤶ȷ仺
+	my_bool updateMaxLength = 1;
+	mysql_stmt_attr_set(pStmt_, STMT_ATTR_UPDATE_MAX_LENGTH, &updateMaxLength);
+
+	paramCount_ = mysql_stmt_param_count(pStmt_);
+	binds_.resize(paramCount_);
+	lengths_.resize(paramCount_);
+	return true;
+}
+
+//-------------------------------------------------------------------------------------
+void PreparedStatement::close()
+{
+	if(pStmt_)
+	{
+		mysql_stmt_close(pStmt_);
+		pStmt_ = NULL;
+	}
+}
+
+//-------------------------------------------------------------------------------------
+unsigned int PreparedStatement::errnum()
+{
+	return pStmt_ ? mysql_stmt_errno(pStmt_) : 0;
+}
+
+//-------------------------------------------------------------------------------------
+const char* PreparedStatement::error()
+{
+	return pStmt_ ? mysql_stmt_error(pStmt_) : "statement is not prepared";
+}
+
+//-------------------------------------------------------------------------------------
+my_ulonglong PreparedStatement::insertID()
+{
+	return mysql_stmt_insert_id(pStmt_);
+}
+
+//-------------------------------------------------------------------------------------
+my_ulonglong PreparedStatement::affectedRows()
+{
+	return mysql_stmt_affected_rows(pStmt_);
+}
+
+//-------------------------------------------------------------------------------------
+bool PreparedStatement::execute(const SQL_PARAMS& params, SQL_ROWS* pRows)
+{
+	KBE_ASSERT(pStmt_ != NULL && params.size() == paramCount_);
+
+	if(paramCount_ > 0)
+	{
+		memset(&binds_[0], 0, sizeof(MYSQL_BIND) * paramCount_);
+
+		for(unsigned long i = 0; i < paramCount_; ++i)
+		{
+			const SqlParam& param = params[i];
+			MYSQL_BIND& bind = binds_[i];
+
+			switch(param.type)
+			{
+			case SqlParam::TYPE_INT64:
+			case SqlParam::TYPE_UINT64:
+				bind.buffer_type = MYSQL_TYPE_LONGLONG;
+				bind.buffer = (void*)&param.i64;
+				bind.is_unsigned = (param.type == SqlParam::TYPE_UINT64);
+				break;
+			default:
+				// ֵıɷ˰ֶת
+				bind.buffer_type = (param.type == SqlParam::TYPE_BLOB) ? MYSQL_TYPE_BLOB : MYSQL_TYPE_STRING;
+				bind.buffer = (void*)param.data;
+				bind.buffer_length = param.length;
+				lengths_[i] = param.length;
+				bind.length = &lengths_[i];
+				break;
+			};
+		}
+
+		if(mysql_stmt_bind_param(pStmt_, &binds_[0]) != 0)
+			return false;
+	}
+
+	if(mysql_stmt_execute(pStmt_) != 0)
+		return false;
+
+	MYSQL_RES* pMeta = mysql_stmt_result_metadata(pStmt_);
+	if(pMeta == NULL)
+		return true;
+
+	bool ret = true;
+
+	if(pRows)
+		ret = fetchRows(pMeta, pRows);
+
+	mysql_stmt_free_result(pStmt_);
+	mysql_free_result(pMeta);
+	return ret;
+}
+
+//-------------------------------------------------------------------------------------
+bool PreparedStatement::fetchRows(MYSQL_RES* pMeta, SQL_ROWS* pRows)
+{
+	if(mysql_stmt_store_result(pStmt_) != 0)
+		return false;
+
+	unsigned int numFields = mysql_num_fields(pMeta);
+	if(numFields == 0)
+		return true;
+
+	MYSQL_FIELD* pFields = mysql_fetch_fields(pMeta);
+
+	std::vector<MYSQL_BIND> binds(numFields);
+	std::vector<unsigned long> lengths(numFields);
+	std::vector<my_bool> isNulls(numFields);
+	std::vector< std::vector<char> > buffers(numFields);
+
+	memset(&binds[0], 0, sizeof(MYSQL_BIND) * numFields);
+
+	for(unsigned int i = 0; i < numFields; ++i)
+	{
+		// ֶζַʽ ıЭĽһ
+		buffers[i].resize((size_t)pFields[i].max_length + 1);
+
+		binds[i].buffer_type = MYSQL_TYPE_STRING;
+		binds[i].buffer = &buffers[i][0];
+		binds[i].buffer_length = (unsigned long)buffers[i].size();
+		binds[i].length = &lengths[i];
+		binds[i].is_null = &isNulls[i];
+	}
+
+	if(mysql_stmt_bind_result(pStmt_, &binds[0]) != 0)
+		return false;
+
+	while(true)
+	{
+		int ret = mysql_stmt_fetch(pStmt_);
+		if(ret == MYSQL_NO_DATA)
+			break;
+
+		if(ret == 1)
+			return false;
+
+		pRows->push_back(SQL_ROW());
+		SQL_ROW& row = pRows->back();
+		row.resize(numFields);
+
+		for(unsigned int i = 0; i < numFields; ++i)
+		{
+			if(!isNulls[i])
+				row[i].assign(&buffers[i][0], std::min<size_t>(lengths[i], buffers[i].size()));
+		}
+	}
+
+	return true;
+}
+
+//-------------------------------------------------------------------------------------
+}
+}
@@ -0,0 +1,109 @@
+// Copyright 2008-2018 Yolo Technologies, Inc. All Rights Reserved. https://www.comblockengine.com
+
+#ifndef KBE_MYSQL_PREPARED_STATEMENT_H
+#define KBE_MYSQL_PREPARED_STATEMENT_H
+
+#include "common/common.h"
+#include "mysql/mysql.h"
+
+namespace KBEngine {
+namespace mysql {
+
+/**
+	 ?ռλ
+	ԤֱԶЭԭʼݣ ıַҪת岢
+*/
+struct SqlParam
+{
+	enum TYPE
+	{
+		TYPE_LITERAL = 0,		// Ѿʽõֵı ıԭ
+		TYPE_STRING = 1,		// ַ
+		TYPE_BLOB = 2,			// 
+		TYPE_INT64 = 3,
+		TYPE_UINT64 = 4
+	};
+
+	SqlParam(TYPE t, const char* d, unsigned long len):
+	type(t),
+	data(d),
+	length(len),
+	i64(0)
+	{
+	}
+
+	SqlParam(const std::string& s, TYPE t = TYPE_STRING):
+	type(t),
+	data(s.data()),
+	length((unsigned long)s.size()),
+	i64(0)
+	{
+	}
+
+	explicit SqlParam(int64 v):
+	type(TYPE_INT64),
+	data(NULL),
+	length(0),
+	i64(v)
+	{
+	}
+
+	explicit SqlParam(uint64 v):
+	type(TYPE_UINT64),
+	data(NULL),
+	length(0),
+	i64((int64)v)
+	{
+	}
+
+	TYPE type;
+	const char* data;
+	unsigned long length;
+	int64 i64;
+};
+
+typedef std::vector<SqlParam> SQL_PARAMS;
+typedef std::vector<std::string> SQL_ROW;
+typedef std::vector<SQL_ROW> SQL_ROWS;
+
+/**
+	Ԥ䣬 DBInterfaceMysql仺棬 ֻӵ߳ʹ
+*/
+class PreparedStatement
+{
+public:
+	PreparedStatement(const std::string& sql);
+	~PreparedStatement();
+
+	bool prepare(MYSQL* pMysql);
+	void close();
+
+	/**
+		󶨲ִУ pRowsΪNULLʱȡн(ÿоתΪַ NULLΪմ)
+		ʧʱfalse errnum()error()
+	*/
+	bool execute(const SQL_PARAMS& params, SQL_ROWS* pRows);
+
+	const std::string& sql() const { return sql_; }
+
+	unsigned int errnum();
+	const char* error();
+
+	my_ulonglong insertID();
+	my_ulonglong affectedRows();
+
+protected:
+	bool fetchRows(MYSQL_RES* pMeta, SQL_ROWS* pRows);
+
+	std::string sql_;
+	MYSQL_STMT* pStmt_;
+	unsigned long paramCount_;
+
+	std::vector<MYSQL_BIND> binds_;
+	std::vector<unsigned long> lengths_;
+};
+
+}
+}
+
+#endif // KBE_MYSQL_PREPARED_STATEMENT_H
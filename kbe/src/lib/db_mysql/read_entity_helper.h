@@ -33,12 +33,153 @@ public:
 		ӱвѯ
 	*/
 	static bool queryDB(DBInterface* pdbi, mysql::DBContext& context)
+	{
+		uint32 numRoundTrips = 0;
+		bool ret = false;
+
+		// ӿ˶ʱӱĲѯϲΪһ ѯ
+		if(static_cast<DBInterfaceMysql*>(pdbi)->batchEntityLoad())
+		{
+			numRoundTrips = 1;
+			ret = queryDBBatched(pdbi, context);
+		}
+		else
+		{
+			ret = queryTableDB(pdbi, context, numRoundTrips);
+		}
+
+		DBInterfaceMysql::onEntityLoaded(numRoundTrips);
+		return ret;
+	}
+
+	/**
+		ӱĲѯϲΪһͣ ˳ȡÿ
+		¼ͨӲѯɸѡڸʵļ¼ ȡеѯȫͬ
+	*/
+	static bool queryDBBatched(DBInterface* pdbi, mysql::DBContext& context)
+	{
+		DBInterfaceMysql* pdbiMysql = static_cast<DBInterfaceMysql*>(pdbi);
+
+		char strdbid[MAX_BUF];
+		kbe_snprintf(strdbid, MAX_BUF, "%" PRDBID, context.dbid);
+
+		SqlStatementQuery sqlcmd(pdbi, context.tableName, std::string("id=") + strdbid, false,
+			context.dbid, context.items);
+
+		std::string sqlstr = sqlcmd.sql();
+
+		std::string childCondition = TABLE_PARENTID_CONST_STR "=";
+		childCondition += strdbid;
+
+		mysql::DBContext::DB_RW_CONTEXTS::iterator iter1 = context.optable.begin();
+		for(; iter1 != context.optable.end(); ++iter1)
+		{
+			makeChildQuerySql(pdbi, *iter1->second.get(), childCondition, sqlstr);
+		}
+
+		if(!pdbiMysql->query(sqlstr.c_str(), sqlstr.size(), false))
+		{
+			ERROR_MSG(fmt::format("ReadEntityHelper::queryDBBatched: {}\n\tsql:{}\n", 
+				pdbi->getstrerror(), sqlstr));
+
+			return false;
+		}
+
+		MYSQL_RES * pResult = mysql_store_result(pdbiMysql->mysql());
+		if(pResult)
+		{
+			readResult(pResult, context);
+			mysql_free_result(pResult);
+		}
+
+		iter1 = context.optable.begin();
+		for(; iter1 != context.optable.end(); ++iter1)
+		{
+			if(!readChildResults(pdbi, *iter1->second.get()))
+			{
+				pdbiMysql->freeMoreResults();
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	/**
+		ӱԼ¼Ĳѯ䣬 conditionΪɸѡӱ¼
+	*/
+	static void makeChildQuerySql(DBInterface* pdbi, mysql::DBContext& context, const std::string& condition, 
+		std::string& sqlstr)
+	{
+		SqlStatementQuery sqlcmd(pdbi, context.tableName, condition, true, context.dbid, context.items);
+
+		sqlstr += ";";
+		sqlstr += sqlcmd.sql();
+
+		if(context.optable.size() == 0)
+			return;
+
+		// ¼ĸ¼Ǳļ¼
+		std::string childCondition = TABLE_PARENTID_CONST_STR " in(select id from " ENTITY_TABLE_PERFIX "_";
+		childCondition += context.tableName;
+		childCondition += " where ";
+		childCondition += condition;
+		childCondition += ")";
+
+		mysql::DBContext::DB_RW_CONTEXTS::iterator iter1 = context.optable.begin();
+		for(; iter1 != context.optable.end(); ++iter1)
+		{
+			makeChildQuerySql(pdbi, *iter1->second.get(), childCondition, sqlstr);
+		}
+	}
+
+	/**
+		makeChildQuerySql˳ȡӱԼ¼Ľ
+	*/
+	static bool readChildResults(DBInterface* pdbi, mysql::DBContext& context)
+	{
+		DBInterfaceMysql* pdbiMysql = static_cast<DBInterfaceMysql*>(pdbi);
+
+		int status = mysql_next_result(pdbiMysql->mysql());
+		if(status != 0)
+		{
+			ERROR_MSG(fmt::format("ReadEntityHelper::readChildResults: table({}) {}\n", 
+				context.tableName, status > 0 ? pdbi->getstrerror() : "missing result"));
+
+			if(status > 0)
+				pdbiMysql->throwError(NULL);
+
+			return false;
+		}
+
+		MYSQL_RES * pResult = mysql_store_result(pdbiMysql->mysql());
+		if(pResult)
+		{
+			readChildResult(pResult, context, NULL);
+			mysql_free_result(pResult);
+		}
+
+		mysql::DBContext::DB_RW_CONTEXTS::iterator iter1 = context.optable.begin();
+		for(; iter1 != context.optable.end(); ++iter1)
+		{
+			if(!readChildResults(pdbi, *iter1->second.get()))
+				return false;
+		}
+
+		return true;
+	}
+
+	/**
+		ѯ ÿӱһ
+	*/
+	static bool queryTableDB(DBInterface* pdbi, mysql::DBContext& context, uint32& numRoundTrips)
 	{
 		// ĳdbidһűϵ
 		SqlStatement* pSqlcmd = new SqlStatementQuery(pdbi, context.tableName, 
 			context.dbids[context.dbid], 
 			context.dbid, context.items);
 
+		++numRoundTrips;
 		bool ret = pSqlcmd->query();
 		context.dbid = pSqlcmd->dbid();
 		delete pSqlcmd;
@@ -51,66 +192,7 @@ public:
 
 		if(pResult)
 		{
-			MYSQL_ROW arow;
-
-			while((arow = mysql_fetch_row(pResult)) != NULL)
-			{
-				uint32 nfields = (uint32)mysql_num_fields(pResult);
-				if(nfields <= 0)
-					continue;
-
-				unsigned long *lengths = mysql_fetch_lengths(pResult);
-
-				// ѯ֤˲ѯÿ¼dbid
-				std::stringstream sval;
-				sval << arow[0];
-
-				DBID item_dbid;
-				sval >> item_dbid;
-
-				// dbid¼бУǰӱȥӱÿһdbidصļ¼
-				std::vector<DBID>& itemDBIDs = context.dbids[context.dbid];
-				int fidx = -100;
-
-				// ǰitemdbidСڸñһ¼dbidСôҪitemDBIDsָλòdbidԱ֤С˳
-				if (itemDBIDs.size() > 0 && itemDBIDs[itemDBIDs.size() - 1] > item_dbid)
-				{
-					for (fidx = itemDBIDs.size() - 1; fidx > 0; --fidx)
-					{
-						if (itemDBIDs[fidx] < item_dbid)
-							break;
-					}
-
-					itemDBIDs.insert(itemDBIDs.begin() + fidx, item_dbid);
-				}
-				else
-				{
-					itemDBIDs.push_back(item_dbid);
-				}
-
-				// ¼dbid⻹ݣ䵽
-				if(nfields > 1)
-				{
-					std::vector<std::string>& itemResults = context.results[item_dbid].second;
-					context.results[item_dbid].first = 0;
-
-					KBE_ASSERT(nfields == context.items.size() + 1);
-
-					for (uint32 i = 1; i < nfields; ++i)
-					{
-						KBEShared_ptr<mysql::DBContext::DB_ITEM_DATA> pSotvs = context.items[i - 1];
-						std::string data;
-						data.assign(arow[i], lengths[i]);
-
-						// dbidʱǲ뷽ʽôҲҪ뵽Ӧλ
-						if (fidx != -100)
-							itemResults.insert(itemResults.begin() + fidx++, data);
-						else
-							itemResults.push_back(data);
-					}
-				}
-			}
-
+			readResult(pResult, context);
 			mysql_free_result(pResult);
 		}
 		
@@ -128,7 +210,7 @@ public:
 		for(; iter1 != context.optable.end(); ++iter1)
 		{
 			mysql::DBContext& wbox = *iter1->second.get();
-			if(!queryChildDB(pdbi, wbox, dbids))
+			if(!queryChildDB(pdbi, wbox, dbids, numRoundTrips))
 				return false;
 		}
 
@@ -139,13 +221,15 @@ public:
 	/**
 		ӱвѯ
 	*/
-	static bool queryChildDB(DBInterface* pdbi, mysql::DBContext& context, std::vector<DBID>& parentTableDBIDs)
+	static bool queryChildDB(DBInterface* pdbi, mysql::DBContext& context, std::vector<DBID>& parentTableDBIDs, 
+		uint32& numRoundTrips)
 	{
 		// ĳdbidһűϵ
 		SqlStatement* pSqlcmd = new SqlStatementQuery(pdbi, context.tableName, 
 			parentTableDBIDs, 
 			context.dbid, context.items);
 
+		++numRoundTrips;
 		bool ret = pSqlcmd->query();
 		context.dbid = pSqlcmd->dbid();
 		delete pSqlcmd;
@@ -160,95 +244,172 @@ public:
 
 		if(pResult)
 		{
-			MYSQL_ROW arow;
+			readChildResult(pResult, context, &t_parentTableDBIDs);
+			mysql_free_result(pResult);
+		}
 
-			while((arow = mysql_fetch_row(pResult)) != NULL)
-			{
-				uint32 nfields = (uint32)mysql_num_fields(pResult);
-				if(nfields <= 0)
-					continue;
+		// ûѯ
+		if(t_parentTableDBIDs.size() == 0)
+			return true;
+
+		// ǰӱҪѯӱ
+		// ÿһdbidҪӱϵ
+		// ӱһβѯеdbidsȻ䵽
+		mysql::DBContext::DB_RW_CONTEXTS::iterator iter1 = context.optable.begin();
+		for(; iter1 != context.optable.end(); ++iter1)
+		{
+			mysql::DBContext& wbox = *iter1->second.get();
 
-				unsigned long *lengths = mysql_fetch_lengths(pResult);
+			if(!queryChildDB(pdbi, wbox, t_parentTableDBIDs, numRoundTrips))
+				return false;
+		}
 
-				// ѯ֤˲ѯÿ¼dbid
-				std::stringstream sval;
-				sval << arow[0];
+		return ret;
+	}
 
-				DBID item_dbid;
-				sval >> item_dbid;
+	/**
+		Ĳѯд
+	*/
+	static void readResult(MYSQL_RES * pResult, mysql::DBContext& context)
+	{
+		MYSQL_ROW arow;
+
+		while((arow = mysql_fetch_row(pResult)) != NULL)
+		{
+			uint32 nfields = (uint32)mysql_num_fields(pResult);
+			if(nfields <= 0)
+				continue;
 
-				sval.clear();
-				sval << arow[1];
+			unsigned long *lengths = mysql_fetch_lengths(pResult);
 
-				DBID parentID;
-				sval >> parentID;
+			// ѯ֤˲ѯÿ¼dbid
+			std::stringstream sval;
+			sval << arow[0];
 
-				// dbid¼бУǰӱȥӱÿһdbidصļ¼
-				std::vector<DBID>& itemDBIDs = context.dbids[parentID];
-				int fidx = -100;
+			DBID item_dbid;
+			sval >> item_dbid;
 
-				// ǰitemdbidСڸñһ¼dbidСôҪitemDBIDsָλòdbidԱ֤С˳
-				if (itemDBIDs.size() > 0 && itemDBIDs[itemDBIDs.size() - 1] > item_dbid)
+			// dbid¼бУǰӱȥӱÿһdbidصļ¼
+			std::vector<DBID>& itemDBIDs = context.dbids[context.dbid];
+			int fidx = -100;
+
+			// ǰitemdbidСڸñһ¼dbidСôҪitemDBIDsָλòdbidԱ֤С˳
+			if (itemDBIDs.size() > 0 && itemDBIDs[itemDBIDs.size() - 1] > item_dbid)
+			{
+				for (fidx = itemDBIDs.size() - 1; fidx > 0; --fidx)
 				{
-					for (fidx = itemDBIDs.size() - 1; fidx > 0; --fidx)
-					{
-						if (itemDBIDs[fidx] < item_dbid)
-							break;
-					}
-
-					itemDBIDs.insert(itemDBIDs.begin() + fidx, item_dbid);
-					t_parentTableDBIDs.insert(t_parentTableDBIDs.begin() + t_parentTableDBIDs.size() - (itemDBIDs.size() - fidx - 1), item_dbid);
+					if (itemDBIDs[fidx] < item_dbid)
+						break;
 				}
-				else
+
+				itemDBIDs.insert(itemDBIDs.begin() + fidx, item_dbid);
+			}
+			else
+			{
+				itemDBIDs.push_back(item_dbid);
+			}
+
+			// ¼dbid⻹ݣ䵽
+			if(nfields > 1)
+			{
+				std::vector<std::string>& itemResults = context.results[item_dbid].second;
+				context.results[item_dbid].first = 0;
+
+				KBE_ASSERT(nfields == context.items.size() + 1);
+
+				for (uint32 i = 1; i < nfields; ++i)
 				{
-					itemDBIDs.push_back(item_dbid);
-					t_parentTableDBIDs.push_back(item_dbid);
+					KBEShared_ptr<mysql::DBContext::DB_ITEM_DATA> pSotvs = context.items[i - 1];
+					std::string data;
+					data.assign(arow[i], lengths[i]);
+
+					// dbidʱǲ뷽ʽôҲҪ뵽Ӧλ
+					if (fidx != -100)
+						itemResults.insert(itemResults.begin() + fidx++, data);
+					else
+						itemResults.push_back(data);
 				}
+			}
+		}
+	}
 
-				// ¼dbid⻹ݣ䵽
-				const uint32 const_fields = 2; // id, parentID
-				if(nfields > const_fields)
+	/**
+		ӱĲѯдģ pParentTableDBIDsΪNULLʱ˳¼ѯdbid ڼѯ¼
+	*/
+	static void readChildResult(MYSQL_RES * pResult, mysql::DBContext& context, std::vector<DBID>* pParentTableDBIDs)
+	{
+		MYSQL_ROW arow;
+
+		while((arow = mysql_fetch_row(pResult)) != NULL)
+		{
+			uint32 nfields = (uint32)mysql_num_fields(pResult);
+			if(nfields <= 0)
+				continue;
+
+			unsigned long *lengths = mysql_fetch_lengths(pResult);
+
+			// ѯ֤˲ѯÿ¼dbid
+			std::stringstream sval;
+			sval << arow[0];
+
+			DBID item_dbid;
+			sval >> item_dbid;
+
+			sval.clear();
+			sval << arow[1];
+
+			DBID parentID;
+			sval >> parentID;
+
+			// dbid¼бУǰӱȥӱÿһdbidصļ¼
+			std::vector<DBID>& itemDBIDs = context.dbids[parentID];
+			int fidx = -100;
+
+			// ǰitemdbidСڸñһ¼dbidСôҪitemDBIDsָλòdbidԱ֤С˳
+			if (itemDBIDs.size() > 0 && itemDBIDs[itemDBIDs.size() - 1] > item_dbid)
+			{
+				for (fidx = itemDBIDs.size() - 1; fidx > 0; --fidx)
 				{
-					std::vector<std::string>& itemResults = context.results[item_dbid].second;
-					context.results[item_dbid].first = 0;
-
-					KBE_ASSERT(nfields == context.items.size() + const_fields);
-
-					for (uint32 i = const_fields; i < nfields; ++i)
-					{
-						KBEShared_ptr<mysql::DBContext::DB_ITEM_DATA> pSotvs = context.items[i - const_fields];
-						std::string data;
-						data.assign(arow[i], lengths[i]);
-
-						// ǰitemdbidڸñм¼dbidСôҪitemDBIDsָλòdbidԱ֤С˳
-						if (fidx != -100)
-							itemResults.insert(itemResults.begin() + fidx++, data);
-						else
-							itemResults.push_back(data);
-					}
+					if (itemDBIDs[fidx] < item_dbid)
+						break;
 				}
+
+				itemDBIDs.insert(itemDBIDs.begin() + fidx, item_dbid);
+
+				if(pParentTableDBIDs)
+					pParentTableDBIDs->insert(pParentTableDBIDs->begin() + pParentTableDBIDs->size() - (itemDBIDs.size() - fidx - 1), item_dbid);
 			}
+			else
+			{
+				itemDBIDs.push_back(item_dbid);
 
-			mysql_free_result(pResult);
-		}
+				if(pParentTableDBIDs)
+					pParentTableDBIDs->push_back(item_dbid);
+			}
 
-		// ûѯ
-		if(t_parentTableDBIDs.size() == 0)
-			return true;
+			// ¼dbid⻹ݣ䵽
+			const uint32 const_fields = 2; // id, parentID
+			if(nfields > const_fields)
+			{
+				std::vector<std::string>& itemResults = context.results[item_dbid].second;
+				context.results[item_dbid].first = 0;
 
-		// ǰӱҪѯӱ
-		// ÿһdbidҪӱϵ
-		// ӱһβѯеdbidsȻ䵽
-		mysql::DBContext::DB_RW_CONTEXTS::iterator iter1 = context.optable.begin();
-		for(; iter1 != context.optable.end(); ++iter1)
-		{
-			mysql::DBContext& wbox = *iter1->second.get();
+				KBE_ASSERT(nfields == context.items.size() + const_fields);
 
-			if(!queryChildDB(pdbi, wbox, t_parentTableDBIDs))
-				return false;
+				for (uint32 i = const_fields; i < nfields; ++i)
+				{
+					KBEShared_ptr<mysql::DBContext::DB_ITEM_DATA> pSotvs = context.items[i - const_fields];
+					std::string data;
+					data.assign(arow[i], lengths[i]);
+
+					// ǰitemdbidڸñм¼dbidСôҪitemDBIDsָλòdbidԱ֤С˳
+					if (fidx != -100)
+						itemResults.insert(itemResults.begin() + fidx++, data);
+					else
+						itemResults.push_back(data);
+				}
+			}
 		}
-
-		return ret;
 	}
 
 protected:
@@ -23,6 +23,8 @@ public:
 		mysql::DBContext::DB_ITEM_DATAS& tableItemDatas) :
 	  tableItemDatas_(tableItemDatas),
 	  sqlstr_(),
+	  params_(),
+	  prepared_(true),
 	  tableName_(tableName),
 	  dbid_(dbid),
 	  parentDBID_(parentDBID),
@@ -42,7 +44,24 @@ public:
 		if(sqlstr_ == "")
 			return true;
 
-		bool ret = static_cast<DBInterfaceMysql*>(pdbi != NULL ? pdbi : pdbi_)->query(sqlstr_.c_str(), sqlstr_.size(), false);
+		DBInterfaceMysql* pdbiMysql = static_cast<DBInterfaceMysql*>(pdbi != NULL ? pdbi : pdbi_);
+		bool ret = false;
+
+		// ״̶ ʹûԤִ
+		if(params_.size() == 0)
+		{
+			ret = pdbiMysql->query(sqlstr_.c_str(), sqlstr_.size(), false);
+		}
+		else if(prepared_)
+		{
+			ret = pdbiMysql->execute(sqlstr_, params_, false);
+		}
+		else
+		{
+			std::string sqlstr;
+			pdbiMysql->expandSql(sqlstr_, params_, sqlstr);
+			ret = pdbiMysql->query(sqlstr.c_str(), sqlstr.size(), false);
+		}
 
 		if(!ret)
 		{
@@ -58,8 +77,37 @@ public:
 	DBID dbid() const{ return dbid_; }
 
 protected:
+	/**
+		?ռλдֶεֵ
+	*/
+	void addItemParam(std::string& sqlstr, const mysql::DBContext::DB_ITEM_DATA& item)
+	{
+		sqlstr += "?";
+
+		if(item.isRaw)
+		{
+			params_.push_back(mysql::SqlParam(item.isBinary ? mysql::SqlParam::TYPE_BLOB : mysql::SqlParam::TYPE_STRING, 
+				item.extraDatas.data(), (unsigned long)item.extraDatas.size()));
+		}
+		else
+		{
+			params_.push_back(mysql::SqlParam(mysql::SqlParam::TYPE_LITERAL, item.sqlval, (unsigned long)strlen(item.sqlval)));
+		}
+	}
+
+	void addDBIDParam(std::string& sqlstr, DBID dbid)
+	{
+		sqlstr += "?";
+		params_.push_back(mysql::SqlParam((uint64)dbid));
+	}
+
 	mysql::DBContext::DB_ITEM_DATAS& tableItemDatas_;
 	std::string sqlstr_;
+
+	// sqlstr_?ռλĲ prepared_ΪfalseʱתΪıִ
+	mysql::SQL_PARAMS params_;
+	bool prepared_;
+
 	std::string tableName_;
 	DBID dbid_;
 	DBID parentDBID_;
@@ -84,9 +132,7 @@ public:
 			sqlstr_ += TABLE_PARENTID_CONST_STR;
 			sqlstr_ += ",";
 			
-			char strdbid[MAX_BUF];
-			kbe_snprintf(strdbid, MAX_BUF, "%" PRDBID, parentDBID);
-			sqlstr1_ += strdbid;
+			addDBIDParam(sqlstr1_, parentDBID);
 			sqlstr1_ += ",";
 		}
 
@@ -101,10 +147,7 @@ public:
 			else
 			{
 				sqlstr_ += pSotvs->sqlkey;
-				if(pSotvs->extraDatas.size() > 0)
-					sqlstr1_ += pSotvs->extraDatas;
-				else
-					sqlstr1_ += pSotvs->sqlval;
+				addItemParam(sqlstr1_, *pSotvs);
 
 				sqlstr_ += ",";
 				sqlstr1_ += ",";
@@ -173,12 +216,7 @@ public:
 			
 			sqlstr_ += pSotvs->sqlkey;
 			sqlstr_ += "=";
-				
-			if(pSotvs->extraDatas.size() > 0)
-				sqlstr_ += pSotvs->extraDatas;
-			else
-				sqlstr_ += pSotvs->sqlval;
-
+			addItemParam(sqlstr_, *pSotvs);
 			sqlstr_ += ",";
 		}
 
@@ -186,10 +224,7 @@ public:
 			sqlstr_.erase(sqlstr_.size() - 1);
 
 		sqlstr_ += " where id=";
-		
-		char strdbid[MAX_BUF];
-		kbe_snprintf(strdbid, MAX_BUF, "%" PRDBID, dbid);
-		sqlstr_ += strdbid;
+		addDBIDParam(sqlstr_, dbid);
 	}
 
 	virtual ~SqlStatementUpdate()
@@ -199,6 +234,91 @@ public:
 protected:
 };
 
+class SqlStatementBatchUpdate : public SqlStatement
+{
+public:
+	/**
+		contexts[start]ʼֶͬĶĿϲΪһ䣬 䳤ȳmaxSizeʣµĿһ
+		end()Ϊһʼλ
+	*/
+	SqlStatementBatchUpdate(DBInterface* pdbi, std::string tableName, 
+		std::vector<mysql::DBContext*>& contexts, size_t start, size_t maxSize) :
+	  SqlStatement(pdbi, tableName, 0, 0, contexts[start]->items),
+	  end_(start)
+	{
+		// 䳤ȱ仯 ΪԤ
+		prepared_ = false;
+
+		// insert into tbl_Avatar (id,sm_level,sm_exp) values(1,2,3),(4,5,6) on duplicate key update sm_level=values(sm_level),sm_exp=values(sm_exp)
+		sqlstr_ = "insert into " ENTITY_TABLE_PERFIX "_";
+		sqlstr_ += tableName;
+		sqlstr_ += " (" TABLE_ID_CONST_STR;
+
+		std::string sqlstr1 = " on duplicate key update ";
+
+		mysql::DBContext::DB_ITEM_DATAS::iterator tableValIter = tableItemDatas_.begin();
+		for(; tableValIter != tableItemDatas_.end(); ++tableValIter)
+		{
+			KBEShared_ptr<mysql::DBContext::DB_ITEM_DATA> pSotvs = (*tableValIter);
+
+			sqlstr_ += ",";
+			sqlstr_ += pSotvs->sqlkey;
+
+			sqlstr1 += pSotvs->sqlkey;
+			sqlstr1 += "=values(";
+			sqlstr1 += pSotvs->sqlkey;
+			sqlstr1 += "),";
+		}
+
+		sqlstr1.erase(sqlstr1.size() - 1);
+		sqlstr_ += ") values";
+
+		char strdbid[MAX_BUF];
+
+		// ֵַԲ棬 תĳȹС
+		size_t paramSize = 0;
+
+		for(; end_ < contexts.size(); ++end_)
+		{
+			// дһĿ
+			if(end_ > start)
+			{
+				if(sqlstr_.size() + paramSize >= maxSize)
+					break;
+
+				sqlstr_ += ",";
+			}
+
+			kbe_snprintf(strdbid, MAX_BUF, "%" PRDBID, contexts[end_]->dbid);
+			sqlstr_ += "(";
+			sqlstr_ += strdbid;
+
+			tableValIter = contexts[end_]->items.begin();
+			for(; tableValIter != contexts[end_]->items.end(); ++tableValIter)
+			{
+				KBEShared_ptr<mysql::DBContext::DB_ITEM_DATA> pSotvs = (*tableValIter);
+
+				sqlstr_ += ",";
+				addItemParam(sqlstr_, *pSotvs);
+				paramSize += pSotvs->isRaw ? pSotvs->extraDatas.size() * 2 + 2 : 0;
+			}
+
+			sqlstr_ += ")";
+		}
+
+		sqlstr_ += sqlstr1;
+	}
+
+	virtual ~SqlStatementBatchUpdate()
+	{
+	}
+
+	size_t end() const{ return end_; }
+
+protected:
+	size_t end_;
+};
+
 class SqlStatementQuery : public SqlStatement
 {
 public:
@@ -247,6 +367,38 @@ public:
 			}
 		}
 
+		addQueryItems(tableItemDatas);
+	}
+
+	/**
+		ѯ ںϲȡʵʱӲѯɸѡ¼ļ¼
+		select id,parentID,xxx from tbl_Avatar_items where parentID in(select id from tbl_Avatar_values where parentID=123);
+	*/
+	SqlStatementQuery(DBInterface* pdbi, std::string tableName, const std::string& condition, bool isChildTable,
+		DBID dbid, mysql::DBContext::DB_ITEM_DATAS& tableItemDatas) :
+	  SqlStatement(pdbi, tableName, 0, dbid, tableItemDatas),
+	  sqlstr1_()
+	{
+		sqlstr_ = "select id,";
+
+		if(isChildTable)
+			sqlstr_ += TABLE_PARENTID_CONST_STR",";
+
+		sqlstr1_ += " from " ENTITY_TABLE_PERFIX "_";
+		sqlstr1_ += tableName;
+		sqlstr1_ += " where ";
+		sqlstr1_ += condition;
+
+		addQueryItems(tableItemDatas);
+	}
+
+	virtual ~SqlStatementQuery()
+	{
+	}
+
+protected:
+	void addQueryItems(mysql::DBContext::DB_ITEM_DATAS& tableItemDatas)
+	{
 		mysql::DBContext::DB_ITEM_DATAS::iterator tableValIter = tableItemDatas.begin();
 		for(; tableValIter != tableItemDatas.end(); ++tableValIter)
 		{
@@ -262,11 +414,6 @@ public:
 		sqlstr_ += sqlstr1_;
 	}
 
-	virtual ~SqlStatementQuery()
-	{
-	}
-
-protected:
 	std::string sqlstr1_;
 };
 
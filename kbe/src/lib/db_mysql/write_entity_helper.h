@@ -56,12 +56,13 @@ public:
 
 	/**
 		ݸµ
+		writeSelfΪfalseʱдcontextֶ(Ѿɺϲд) ֻӱ
 	*/
-	static bool writeDB(DB_TABLE_OP optype, DBInterface* pdbi, mysql::DBContext& context)
+	static bool writeDB(DB_TABLE_OP optype, DBInterface* pdbi, mysql::DBContext& context, bool writeSelf = true)
 	{
 		bool ret = true;
 
-		if(!context.isEmpty)
+		if(!context.isEmpty && writeSelf)
 		{
 			SqlStatement* pSqlcmd = createSql(pdbi, optype, context.tableName, 
 				context.parentTableDBID, 
@@ -201,7 +202,7 @@ public:
 				{
 					mysql::DBContext& wbox = *iter1->second.get();
 					
-					if(wbox.isEmpty)
+					if(wbox.isEmpty && !wbox.isKeep)
 						continue;
 
 					// 󶨱ϵ
@@ -224,6 +225,21 @@ public:
 						}
 					}
 
+					// δıԪرеĿ ݿûжӦĿ˵baseapp¼Ĳһ£
+					// ʧbaseappһд
+					if(wbox.isKeep)
+					{
+						if(wbox.dbid <= 0)
+						{
+							ERROR_MSG(fmt::format("WriteEntityHelper::writeDB: {} not found the kept item(parentID={}).\n",
+								wbox.tableName, context.dbid));
+
+							ret = false;
+						}
+
+						continue;
+					}
+
 					// ӱ
 					writeDB(optype, pdbi, wbox);
 				}
@@ -17,7 +17,9 @@ DBInterfaceRedis::DBInterfaceRedis(const char* name) :
 DBInterface(name),
 pRedisContext_(NULL),
 hasLostConnection_(false),
-inTransaction_(false)
+inTransaction_(false),
+inPipeline_(false),
+numPipelineCommands_(0)
 {
 }
 
@@ -210,6 +212,9 @@ bool DBInterfaceRedis::reattach()
 //-------------------------------------------------------------------------------------
 bool DBInterfaceRedis::detach()
 {
+	// ͻһͷţ δȡĹܵظҲͲ
+	resetPipeline();
+
 	if(pRedisContext_)
 	{
 		redisFree(pRedisContext_);
@@ -235,10 +240,21 @@ bool DBInterfaceRedis::getTableItemNames(const char* tableName, std::vector<std:
 bool DBInterfaceRedis::query(const std::string& cmd, redisReply** pRedisReply, bool printlog)
 {
 	KBE_ASSERT(pRedisContext_);
+
+	if(inPipeline_)
+	{
+		// ظdrainPipelineͳһȡ
+		*pRedisReply = NULL;
+		lastquery_ = cmd;
+		RedisWatcher::querystatistics(lastquery_.c_str(), (uint32)lastquery_.size());
+		return appendPipeline(redisAppendCommand(pRedisContext_, cmd.c_str()), printlog);
+	}
+
 	*pRedisReply = (redisReply*)redisCommand(pRedisContext_, cmd.c_str());  
 	
 	lastquery_ = cmd;
 	RedisWatcher::querystatistics(lastquery_.c_str(), (uint32)lastquery_.size());
+	RedisWatcher::roundtrip(1);
 	
 	if (pRedisContext_->err) 
 	{
@@ -269,10 +285,19 @@ bool DBInterfaceRedis::query(const std::string& cmd, redisReply** pRedisReply, b
 bool DBInterfaceRedis::query(const char* cmd, uint32 size, bool printlog, MemoryStream * result)
 {
 	KBE_ASSERT(pRedisContext_);
+
+	if(inPipeline_)
+	{
+		lastquery_ = cmd;
+		RedisWatcher::querystatistics(lastquery_.c_str(), (uint32)lastquery_.size());
+		return appendPipeline(redisAppendCommand(pRedisContext_, cmd), printlog);
+	}
+
 	redisReply* pRedisReply = (redisReply*)redisCommand(pRedisContext_, cmd);
 	
 	lastquery_ = cmd;
 	RedisWatcher::querystatistics(lastquery_.c_str(), (uint32)lastquery_.size());
+	RedisWatcher::roundtrip(1);
 	write_query_result(pRedisReply, result);
 	
 	if (pRedisContext_->err) 
@@ -307,7 +332,14 @@ bool DBInterfaceRedis::query(bool printlog, const char* format, ...)
     va_start(ap, format);
 
 	KBE_ASSERT(pRedisContext_);
-	redisReply* pRedisReply = (redisReply*)redisvCommand(pRedisContext_, format, ap);
+
+	redisReply* pRedisReply = NULL;
+	int appendRet = REDIS_OK;
+
+	if(inPipeline_)
+		appendRet = redisvAppendCommand(pRedisContext_, format, ap);
+	else
+		pRedisReply = (redisReply*)redisvCommand(pRedisContext_, format, ap);
 	
 	char buffer[1024];
 	int cnt	= vsnprintf(buffer, sizeof(buffer) - 1, format, ap);
@@ -318,6 +350,14 @@ bool DBInterfaceRedis::query(bool printlog, const char* format, ...)
 		RedisWatcher::querystatistics(lastquery_.c_str(), (uint32)lastquery_.size());
 	}
 	
+	if(inPipeline_)
+	{
+		va_end(ap);
+		return appendPipeline(appendRet, printlog);
+	}
+
+	RedisWatcher::roundtrip(1);
+
 	if (pRedisContext_->err) 
 	{
 		if(printlog)
@@ -399,6 +439,91 @@ bool DBInterfaceRedis::getQueryReply(redisReply **pRedisReply)
 	return redisGetReply(pRedisContext_, (void**)pRedisReply) == REDIS_OK;
 }
 
+//-------------------------------------------------------------------------------------
+void DBInterfaceRedis::beginPipeline()
+{
+	KBE_ASSERT(pRedisContext_ && !inPipeline_);
+	inPipeline_ = true;
+	numPipelineCommands_ = 0;
+}
+
+//-------------------------------------------------------------------------------------
+void DBInterfaceRedis::resetPipeline()
+{
+	inPipeline_ = false;
+	numPipelineCommands_ = 0;
+}
+
+//-------------------------------------------------------------------------------------
+bool DBInterfaceRedis::appendPipeline(int ret, bool printlog)
+{
+	if (ret == REDIS_ERR) 
+	{	
+		if(printlog)
+		{
+			ERROR_MSG(fmt::format("DBInterfaceRedis::appendPipeline: cmd={}, errno={}, error={}\n",
+				lastquery_, pRedisContext_->err, pRedisContext_->errstr));
+		}
+
+		this->throwError(NULL);
+		return false;
+	}
+
+	++numPipelineCommands_;
+	return true;
+}
+
+//-------------------------------------------------------------------------------------
+bool DBInterfaceRedis::drainPipeline(redisReply** pLastReply, bool printlog)
+{
+	KBE_ASSERT(pRedisContext_ && inPipeline_);
+
+	uint32 numCommands = numPipelineCommands_;
+	resetPipeline();
+
+	if(pLastReply)
+		*pLastReply = NULL;
+
+	if(numCommands == 0)
+		return true;
+
+	RedisWatcher::roundtrip(numCommands);
+
+	// һredisGetReplyὫͻеһд
+	// ֮ĻظѾͬһȡУ ٲ
+	for(uint32 i = 0; i < numCommands; ++i)
+	{
+		redisReply* pRedisReply = NULL;
+
+		if(redisGetReply(pRedisContext_, (void**)&pRedisReply) != REDIS_OK)
+		{
+			if(printlog)
+			{
+				ERROR_MSG(fmt::format("DBInterfaceRedis::drainPipeline: cmds={}, reply={}/{}, errno={}, error={}\n",
+					lastquery_, i, numCommands, pRedisContext_->err, pRedisContext_->errstr));
+			}
+
+			if(pRedisReply)
+				freeReplyObject(pRedisReply);
+
+			this->throwError(NULL);
+			return false;
+		}
+
+		if(pLastReply && i == numCommands - 1)
+			*pLastReply = pRedisReply;
+		else if(pRedisReply)
+			freeReplyObject(pRedisReply);
+	}
+
+	if(printlog)
+	{
+		INFO_MSG(fmt::format("DBInterfaceRedis::drainPipeline: {} commands successfully!\n", numCommands)); 
+	}
+
+	return true;
+}
+
 //-------------------------------------------------------------------------------------
 void DBInterfaceRedis::write_query_result(redisReply* pRedisReply, MemoryStream * result)
 {
@@ -542,6 +667,9 @@ bool DBInterfaceRedis::unlock()
 //-------------------------------------------------------------------------------------
 void DBInterfaceRedis::throwError(DBException* pDBException)
 {
+	// 󻺳ʣظ޷Ӧ ǰܵ
+	resetPipeline();
+
 	if (pDBException)
 	{
 		throw *pDBException;
@@ -94,6 +94,16 @@ public:
 	bool queryAppend(bool printlog, const char* format, ...);
 	bool getQueryReply(redisReply **pRedisReply);
 	
+	/**
+		ܵģʽ queryֻд뷢ͻȴظ
+		drainPipelineһԷȫȡлظ һֻһ
+		pLastReplyΪNULLʱһĻظ(EXEC) ɵͷ
+	*/
+	void beginPipeline();
+	bool drainPipeline(redisReply** pLastReply = NULL, bool printlog = true);
+	bool inPipeline() const				{ return inPipeline_; }
+	uint32 numPipelineCommands() const	{ return numPipelineCommands_; }
+
 	void write_query_result(redisReply* pRedisReply, MemoryStream * result);
 	void write_query_result_element(redisReply* pRedisReply, MemoryStream * result);
 		
@@ -140,10 +150,16 @@ public:
 	*/
 	virtual bool processException(std::exception & e);
 	
+protected:
+	bool appendPipeline(int ret, bool printlog);
+	void resetPipeline();
+
 protected:
 	redisContext* pRedisContext_;
 	bool hasLostConnection_;
 	bool inTransaction_;	
+	bool inPipeline_;
+	uint32 numPipelineCommands_;
 };
 
 
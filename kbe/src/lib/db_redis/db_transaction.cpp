@@ -42,6 +42,10 @@ void DBTransaction::start()
 {
 	committed_ = false;
 
+	// MULTIеֻдܵ commitʱͬEXECһη
+	// ֻһ ÿȴһQUEUEDظ
+	static_cast<DBInterfaceRedis*>(pdbi_)->beginPipeline();
+
 	try
 	{
 		pdbi_->query(SQL_START_TRANSACTION, false);
@@ -65,6 +69,9 @@ void DBTransaction::rollback()
 			"Rolling back\n" );
 
 	pdbi_->query(SQL_ROLLBACK, false);	
+
+	if(static_cast<DBInterfaceRedis*>(pdbi_)->inPipeline())
+		static_cast<DBInterfaceRedis*>(pdbi_)->drainPipeline(NULL, false);
 }
 
 //-------------------------------------------------------------------------------------
@@ -78,6 +85,9 @@ void DBTransaction::end()
 					"Rolling back\n" );
 
 			pdbi_->query(SQL_ROLLBACK, false);
+
+			if(static_cast<DBInterfaceRedis*>(pdbi_)->inPipeline())
+				static_cast<DBInterfaceRedis*>(pdbi_)->drainPipeline(NULL, false);
 		}
 		catch (DBException & e)
 		{
@@ -105,6 +115,10 @@ void DBTransaction::commit()
 	uint64 startTime = timestamp();
 	static_cast<DBInterfaceRedis*>(pdbi_)->query(SQL_COMMIT, &pRedisReply_, false);
 
+	// EXECĻظɵ
+	if(static_cast<DBInterfaceRedis*>(pdbi_)->inPipeline())
+		static_cast<DBInterfaceRedis*>(pdbi_)->drainPipeline(&pRedisReply_, false);
+
 	uint64 duration = timestamp() - startTime;
 	if(duration > stampsPerSecond() * 0.2f)
 	{
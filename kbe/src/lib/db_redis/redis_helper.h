@@ -87,13 +87,19 @@ public:
 					redisReply* r0 = pRedisReply->element[1];
 					KBE_ASSERT(r0->type == REDIS_REPLY_ARRAY);
 					
+					// ҳkeyɾһη ֻһ
+					pdbi->beginPipeline();
+
 					for(size_t j = 0; j < r0->elements; ++j) 
 					{
 						redisReply* r1 = r0->element[j];
 						KBE_ASSERT(r1->type == REDIS_REPLY_STRING);
-							
-						pdbi->query(fmt::format("del {}", r1->str), &pRedisReply, printlog);
+
+						std::string cmd = fmt::format("del {}", r1->str);
+						pdbi->query(cmd.c_str(), (uint32)cmd.size(), printlog);
 					}
+
+					pdbi->drainPipeline(NULL, printlog);
 				}
 				
 				freeReplyObject(pRedisReply); 
@@ -133,13 +139,19 @@ public:
 					redisReply* r0 = pRedisReply->element[1];
 					KBE_ASSERT(r0->type == REDIS_REPLY_ARRAY);
 					
+					// ҳkeyɾһη ֻһ
+					pdbi->beginPipeline();
+
 					for(size_t j = 0; j < r0->elements; ++j) 
 					{
 						redisReply* r1 = r0->element[j];
 						KBE_ASSERT(r1->type == REDIS_REPLY_STRING);
 
-						pdbi->query(fmt::format("hdel {} {}", r1->str, itemName), &pRedisReply, printlog);
+						std::string cmd = fmt::format("hdel {} {}", r1->str, itemName);
+						pdbi->query(cmd.c_str(), (uint32)cmd.size(), printlog);
 					}
+
+					pdbi->drainPipeline(NULL, printlog);
 				}
 				
 				freeReplyObject(pRedisReply); 
@@ -16,6 +16,9 @@ static KBEngine::thread::ThreadMutex _g_logMutex;
 static KBEUnordered_map< std::string, uint32 > g_querystatistics;
 static bool _g_installedWatcher = false;
 static bool _g_debug = false;
+static uint32 _g_roundTrips = 0;
+static uint32 _g_roundTripCommands = 0;
+static uint32 _g_pipelinedCommands = 0;
 
 //-------------------------------------------------------------------------------------
 static uint32 watcher_query(std::string cmd)
@@ -754,6 +757,29 @@ static uint32 watcher_TIME()
 	return watcher_query("TIME");
 }
 
+// 
+static uint32 watcher_roundTrips()
+{
+	KBEngine::thread::ThreadGuard tg(&_g_logMutex);
+	return _g_roundTrips;
+}
+
+static uint32 watcher_pipelinedCommands()
+{
+	KBEngine::thread::ThreadGuard tg(&_g_logMutex);
+	return _g_pipelinedCommands;
+}
+
+static float watcher_commandsPerRoundTrip()
+{
+	KBEngine::thread::ThreadGuard tg(&_g_logMutex);
+
+	if(_g_roundTrips == 0)
+		return 0.f;
+
+	return float(_g_roundTripCommands) / float(_g_roundTrips);
+}
+
 //-------------------------------------------------------------------------------------
 void RedisWatcher::initializeWatcher()
 {
@@ -926,6 +952,11 @@ void RedisWatcher::initializeWatcher()
 	WATCH_OBJECT("db_querys/SLOWLOG", &KBEngine::watcher_SLOWLOG);
 	WATCH_OBJECT("db_querys/SYNC", &KBEngine::watcher_SYNC);
 	WATCH_OBJECT("db_querys/TIME", &KBEngine::watcher_TIME);				
+
+	//  commandsPerRoundTripԽ˵ܵϲԽ
+	WATCH_OBJECT("db_querys/roundTrips", &KBEngine::watcher_roundTrips);
+	WATCH_OBJECT("db_querys/pipelinedCommands", &KBEngine::watcher_pipelinedCommands);
+	WATCH_OBJECT("db_querys/commandsPerRoundTrip", &KBEngine::watcher_commandsPerRoundTrip);
 }
 
 //-------------------------------------------------------------------------------------
@@ -960,6 +991,18 @@ void RedisWatcher::querystatistics(const char* strCommand, uint32 size)
 	_g_logMutex.unlockMutex();
 }
 
+//-------------------------------------------------------------------------------------
+void RedisWatcher::roundtrip(uint32 numCommands)
+{
+	KBEngine::thread::ThreadGuard tg(&_g_logMutex);
+
+	++_g_roundTrips;
+	_g_roundTripCommands += numCommands;
+
+	if(numCommands > 1)
+		_g_pipelinedCommands += numCommands;
+}
+
 //-------------------------------------------------------------------------------------
 
 }
@@ -11,6 +11,7 @@ class RedisWatcher
 {
 public:
 	static void querystatistics(const char* strCommand, uint32 size);
+	static void roundtrip(uint32 numCommands);
 	static void initializeWatcher();
 };
 
@@ -111,6 +111,10 @@ enum ENTITY_BASE_PROPERTY_UTYPE
 	ENTITY_BASE_PROPERTY_UTYPE_SPACEID						= 3,
 };
 
+// 浵ÿͷıǣ 0ʾ
+// ENTITY_PERSISTENT_ARRAY_DELTAʾд飬 鳤֮ÿԪǰһuint8ǣ 0Ϊδı() 1ΪѸı
+#define ENTITY_PERSISTENT_ARRAY_DELTA		1
+
 // entityһЩϵͳĿɱԽбԱ紫ʱб
 enum ENTITY_BASE_PROPERTY_ALIASID
 {
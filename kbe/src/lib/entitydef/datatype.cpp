@@ -1613,7 +1613,9 @@ PyObject* EntityCallType::createFromStream(MemoryStream* mstream)
 
 //-------------------------------------------------------------------------------------
 FixedArrayType::FixedArrayType(DATATYPE_UID did):
-DataType(did)
+DataType(did),
+dataType_(NULL),
+itemType_(DATA_TYPE_UNKONWN)
 {
 }
 
@@ -1712,6 +1714,8 @@ bool FixedArrayType::initialize(XML* xml, TiXmlNode* node, const std::string& pa
 		return false;
 	}
 
+	itemType_ = dataType_->type();
+
 	DATATYPE_UID uid = dataType_->id();
 	EntityDef::md5().append((void*)&uid, sizeof(DATATYPE_UID));
 	EntityDef::md5().append((void*)strType.c_str(), (int)strType.size());
@@ -1777,6 +1781,8 @@ bool FixedArrayType::initialize(script::entitydef::DefContext* pDefContext, cons
 		return false;
 	}
 
+	itemType_ = dataType_->type();
+
 	strType += pDefContext->returnType;
 	DATATYPE_UID uid = dataType_->id();
 	EntityDef::md5().append((void*)&uid, sizeof(DATATYPE_UID));
@@ -1834,18 +1840,25 @@ void FixedArrayType::addToStream(MemoryStream* mstream, PyObject* pyValue)
 }
 
 //-------------------------------------------------------------------------------------
-void FixedArrayType::addToStreamEx(MemoryStream* mstream, PyObject* pyValue, bool onlyPersistents)
+void FixedArrayType::addToStreamEx(MemoryStream* mstream, PyObject* pyValue, bool onlyPersistents, 
+	std::vector<uint32>* pElementOffsets)
 {
 	ArraySize size = (ArraySize)PySequence_Size(pyValue);
 	(*mstream) << size;
 
+	if(pElementOffsets)
+		pElementOffsets->reserve(size);
+
 	for(ArraySize i=0; i<size; ++i)
 	{
 		PyObject* pyVal = PySequence_GetItem(pyValue, i);
 
-		if(dataType_->type() == DATA_TYPE_FIXEDDICT)
+		if(pElementOffsets)
+			pElementOffsets->push_back((uint32)mstream->wpos());
+
+		if(itemType_ == DATA_TYPE_FIXEDDICT)
 			((FixedDictType*)dataType_)->addToStreamEx(mstream, pyVal, onlyPersistents);
-		else if(dataType_->type() == DATA_TYPE_FIXEDARRAY)
+		else if(itemType_ == DATA_TYPE_FIXEDARRAY)
 			((FixedArrayType*)dataType_)->addToStreamEx(mstream, pyVal, onlyPersistents);
 		else
 			dataType_->addToStream(mstream, pyVal);
@@ -1854,6 +1867,36 @@ void FixedArrayType::addToStreamEx(MemoryStream* mstream, PyObject* pyValue, boo
 	}
 }
 
+//-------------------------------------------------------------------------------------
+bool FixedArrayType::addToStreamChecked(MemoryStream* mstream, PyObject* pyValue, bool onlyPersistents)
+{
+	if(pyValue == NULL || !PySequence_Check(pyValue))
+	{
+		OUT_TYPE_ERROR("ARRAY");
+		return false;
+	}
+
+	size_t wpos = mstream->wpos();
+
+	ArraySize size = (ArraySize)PySequence_Size(pyValue);
+	(*mstream) << size;
+
+	for(ArraySize i=0; i<size; ++i)
+	{
+		PyObject* pyVal = PySequence_GetItem(pyValue, i);
+		bool ok = FixedDictType::addItemToStreamChecked(mstream, dataType_, itemType_, pyVal, onlyPersistents);
+		Py_XDECREF(pyVal);
+
+		if(!ok)
+		{
+			mstream->wpos((int)wpos);
+			return false;
+		}
+	}
+
+	return true;
+}
+
 //-------------------------------------------------------------------------------------
 PyObject* FixedArrayType::createFromStream(MemoryStream* mstream)
 {
@@ -1883,14 +1926,7 @@ PyObject* FixedArrayType::createFromStreamEx(MemoryStream* mstream, bool onlyPer
 				break;
 			}
 
-			PyObject* pyVal = NULL;
-			
-			if(dataType_->type() == DATA_TYPE_FIXEDDICT)
-				pyVal = ((FixedDictType*)dataType_)->createFromStreamEx(mstream, onlyPersistents);
-			else if(dataType_->type() == DATA_TYPE_FIXEDARRAY)
-				pyVal = ((FixedArrayType*)dataType_)->createFromStreamEx(mstream, onlyPersistents);
-			else
-				pyVal = dataType_->createFromStream(mstream);
+			PyObject* pyVal = FixedDictType::createItemFromStream(mstream, dataType_, itemType_, onlyPersistents);
 	
 			if(pyVal)
 			{
@@ -1924,6 +1960,14 @@ moduleName_()
 //-------------------------------------------------------------------------------------
 FixedDictType::~FixedDictType()
 {
+	SERIALIZE_PLAN::iterator stepIter = serializePlan_.begin();
+	for(; stepIter != serializePlan_.end(); ++stepIter)
+	{
+		Py_XDECREF(stepIter->pyKeyName);
+	}
+
+	serializePlan_.clear();
+
 	FIXEDDICT_KEYTYPE_MAP::iterator iter = keyTypes_.begin();
 	for(; iter != keyTypes_.end(); ++iter)
 	{
@@ -2193,7 +2237,7 @@ bool FixedDictType::initialize(XML* xml, TiXmlNode* node, std::string& parentNam
 		return false;
 	}
 
-	return true;
+	return compileSerializePlan();
 }
 
 //-------------------------------------------------------------------------------------
@@ -2326,6 +2370,38 @@ bool FixedDictType::initialize(script::entitydef::DefContext* pDefContext, const
 		return false;
 	}
 
+	return compileSerializePlan();
+}
+
+//-------------------------------------------------------------------------------------
+bool FixedDictType::compileSerializePlan()
+{
+	KBE_ASSERT(serializePlan_.size() == 0);
+	serializePlan_.reserve(keyTypes_.size());
+
+	FIXEDDICT_KEYTYPE_MAP::iterator iter = keyTypes_.begin();
+	for(; iter != keyTypes_.end(); ++iter)
+	{
+		SerializeStep step;
+		step.pyKeyName = PyUnicode_InternFromString(iter->first.c_str());
+
+		if(step.pyKeyName == NULL)
+		{
+			SCRIPT_ERROR_CHECK();
+
+			ERROR_MSG(fmt::format("FixedDictType::compileSerializePlan: FIXED_DICT({}) intern key[{}] error!\n",
+				this->aliasName(), iter->first));
+
+			return false;
+		}
+
+		step.keyName = iter->first.c_str();
+		step.dataType = iter->second->dataType;
+		step.type = step.dataType->type();
+		step.persistent = iter->second->persistent;
+		serializePlan_.push_back(step);
+	}
+
 	return true;
 }
 
@@ -2538,10 +2614,10 @@ bool FixedDictType::isSameType(PyObject* pyValue)
 		return false;
 	}
 
-	FIXEDDICT_KEYTYPE_MAP::iterator iter = keyTypes_.begin();
-	for(; iter != keyTypes_.end(); ++iter)
+	SERIALIZE_PLAN::const_iterator iter = serializePlan_.begin();
+	for(; iter != serializePlan_.end(); ++iter)
 	{
-		PyObject* pyObject = PyDict_GetItemString(pyValue, const_cast<char*>(iter->first.c_str()));
+		PyObject* pyObject = PyDict_GetItem(pyValue, iter->pyKeyName);
 		if(pyObject == NULL)
 		{
 			PyErr_Format(PyExc_TypeError,
@@ -2551,12 +2627,12 @@ bool FixedDictType::isSameType(PyObject* pyValue)
 			PyErr_PrintEx(0);
 			return false;
 		}
-		else if (!iter->second->dataType->isSameType(pyObject))
+		else if (!iter->dataType->isSameType(pyObject))
 		{
 			PyErr_Format(PyExc_TypeError,
 				"set FIXED_DICT(%s) error! at key: %s(%s), allKeyNames=[%s].",
 				this->aliasName(),
-				iter->first.c_str(),
+				iter->keyName,
 				pyObject->ob_type->tp_name,
 				debugInfos().c_str());
 
@@ -2604,59 +2680,32 @@ void FixedDictType::addToStreamEx(MemoryStream* mstream, PyObject* pyValue, bool
 		pydict = static_cast<FixedDict*>(pyValue)->getDictObject();
 	}
 	
-	FIXEDDICT_KEYTYPE_MAP::iterator iter = keyTypes_.begin();
-	for(; iter != keyTypes_.end(); ++iter)
+	SERIALIZE_PLAN::const_iterator iter = serializePlan_.begin();
+	for(; iter != serializePlan_.end(); ++iter)
 	{
 		if(onlyPersistents)
 		{
-			if(!iter->second->persistent)
+			if(!iter->persistent)
 				continue;
 		}
 
-		PyObject* pyObject = 
-			PyDict_GetItemString(pydict, const_cast<char*>(iter->first.c_str()));
+		PyObject* pyObject = PyDict_GetItem(pydict, iter->pyKeyName);
 		
 		if(pyObject == NULL)
 		{
 			ERROR_MSG(fmt::format("FixedDictType::addToStreamEx: {} not found key[{}]. keyNames[{}]\n",
-				this->aliasName_, iter->first, this->debugInfos()));
+				this->aliasName_, iter->keyName, this->debugInfos()));
 
 			// KBE_ASSERT(pyObject != NULL);
-			PyObject* pobj = iter->second->dataType->parseDefaultStr("");
-
-			if(iter->second->dataType->type() == DATA_TYPE_FIXEDDICT)
-				((FixedDictType*)iter->second->dataType)->addToStreamEx(mstream, pobj, onlyPersistents);
-			else if(iter->second->dataType->type() == DATA_TYPE_FIXEDARRAY)
-				((FixedArrayType*)iter->second->dataType)->addToStreamEx(mstream, pobj, onlyPersistents);
-			else
-				iter->second->dataType->addToStream(mstream, pobj);
-
-			Py_DECREF(pobj);
+			writeDefaultItem(mstream, *iter, onlyPersistents);
 			continue;
 		}
 		
-		if(!iter->second->dataType->isSameType(pyObject))
+		// дһɣ ͲƥʱдĲֱˣ дĬֵ
+		if(!addItemToStreamChecked(mstream, iter->dataType, iter->type, pyObject, onlyPersistents))
 		{
-			// KBE_ASSERT(pyObject != NULL);
-			PyObject* pobj = iter->second->dataType->parseDefaultStr("");
-
-			if(iter->second->dataType->type() == DATA_TYPE_FIXEDDICT)
-				((FixedDictType*)iter->second->dataType)->addToStreamEx(mstream, pobj, onlyPersistents);
-			else if(iter->second->dataType->type() == DATA_TYPE_FIXEDARRAY)
-				((FixedArrayType*)iter->second->dataType)->addToStreamEx(mstream, pobj, onlyPersistents);
-			else
-				iter->second->dataType->addToStream(mstream, pobj);
-
-			Py_DECREF(pobj);
-			continue;
+			writeDefaultItem(mstream, *iter, onlyPersistents);
 		}
-
-		if(iter->second->dataType->type() == DATA_TYPE_FIXEDDICT)
-			((FixedDictType*)iter->second->dataType)->addToStreamEx(mstream, pyObject, onlyPersistents);
-		else if(iter->second->dataType->type() == DATA_TYPE_FIXEDARRAY)
-			((FixedArrayType*)iter->second->dataType)->addToStreamEx(mstream, pyObject, onlyPersistents);
-		else
-			iter->second->dataType->addToStream(mstream, pyObject);
 	}
 
 	if(hasImpl())
@@ -2665,6 +2714,139 @@ void FixedDictType::addToStreamEx(MemoryStream* mstream, PyObject* pyValue, bool
 	}
 }
 
+//-------------------------------------------------------------------------------------
+bool FixedDictType::addToStreamChecked(MemoryStream* mstream, PyObject* pyValue, bool onlyPersistents)
+{
+	if(pyValue == NULL)
+	{
+		OUT_TYPE_ERROR("DICT");
+		return false;
+	}
+
+	// ûʵֵҪűжϣ ޷дϲ
+	if(hasImpl())
+	{
+		if(!isSameType(pyValue))
+			return false;
+
+		addToStreamEx(mstream, pyValue, onlyPersistents);
+		return true;
+	}
+
+	if(PyObject_TypeCheck(pyValue, FixedDict::getScriptType()))
+	{
+		if(static_cast<FixedDict*>(pyValue)->getDataType()->id() != this->id())
+			return false;
+
+		// FixedDictÿһڸֵʱѾ
+		addToStreamEx(mstream, pyValue, onlyPersistents);
+		return true;
+	}
+
+	if(!PyDict_Check(pyValue))
+	{
+		OUT_TYPE_ERROR("DICT");
+		return false;
+	}
+
+	Py_ssize_t dictSize = PyDict_Size(pyValue);
+	if(dictSize != (Py_ssize_t)serializePlan_.size())
+	{
+		PyErr_Format(PyExc_TypeError, 
+			"FIXED_DICT(%s) key does not match! giveKeySize=%d, dictKeySize=%d, dictKeyNames=[%s], notFoundKeys=[%s].", 
+			this->aliasName(), dictSize, serializePlan_.size(), 
+			debugInfos().c_str(), getNotFoundKeys(pyValue).c_str());
+
+		PyErr_PrintEx(0);
+		return false;
+	}
+
+	size_t wpos = mstream->wpos();
+
+	SERIALIZE_PLAN::const_iterator iter = serializePlan_.begin();
+	for(; iter != serializePlan_.end(); ++iter)
+	{
+		PyObject* pyObject = PyDict_GetItem(pyValue, iter->pyKeyName);
+		if(pyObject == NULL)
+		{
+			PyErr_Format(PyExc_TypeError,
+				"set FIXED_DICT(%s) error! keys[%s] not found, allKeyNames=[%s].",
+				this->aliasName(), getNotFoundKeys(pyValue).c_str(), debugInfos().c_str());
+
+			PyErr_PrintEx(0);
+			mstream->wpos((int)wpos);
+			return false;
+		}
+
+		bool ok = false;
+
+		// дҲҪ飬 isSameTypeһ
+		if(onlyPersistents && !iter->persistent)
+			ok = iter->dataType->isSameType(pyObject);
+		else
+			ok = addItemToStreamChecked(mstream, iter->dataType, iter->type, pyObject, onlyPersistents);
+
+		if(!ok)
+		{
+			PyErr_Format(PyExc_TypeError,
+				"set FIXED_DICT(%s) error! at key: %s(%s), allKeyNames=[%s].",
+				this->aliasName(),
+				iter->keyName,
+				pyObject->ob_type->tp_name,
+				debugInfos().c_str());
+
+			PyErr_PrintEx(0);
+			mstream->wpos((int)wpos);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+//-------------------------------------------------------------------------------------
+bool FixedDictType::addItemToStreamChecked(MemoryStream* mstream, DataType* dataType, DATATYPE type, 
+	PyObject* pyValue, bool onlyPersistents)
+{
+	if(type == DATA_TYPE_FIXEDDICT)
+		return ((FixedDictType*)dataType)->addToStreamChecked(mstream, pyValue, onlyPersistents);
+	else if(type == DATA_TYPE_FIXEDARRAY)
+		return ((FixedArrayType*)dataType)->addToStreamChecked(mstream, pyValue, onlyPersistents);
+
+	if(!dataType->isSameType(pyValue))
+		return false;
+
+	dataType->addToStream(mstream, pyValue);
+	return true;
+}
+
+//-------------------------------------------------------------------------------------
+PyObject* FixedDictType::createItemFromStream(MemoryStream* mstream, DataType* dataType, DATATYPE type, 
+	bool onlyPersistents)
+{
+	if(type == DATA_TYPE_FIXEDDICT)
+		return ((FixedDictType*)dataType)->createFromStreamEx(mstream, onlyPersistents);
+	else if(type == DATA_TYPE_FIXEDARRAY)
+		return ((FixedArrayType*)dataType)->createFromStreamEx(mstream, onlyPersistents);
+
+	return dataType->createFromStream(mstream);
+}
+
+//-------------------------------------------------------------------------------------
+void FixedDictType::writeDefaultItem(MemoryStream* mstream, const SerializeStep& step, bool onlyPersistents)
+{
+	PyObject* pobj = step.dataType->parseDefaultStr("");
+
+	if(step.type == DATA_TYPE_FIXEDDICT)
+		((FixedDictType*)step.dataType)->addToStreamEx(mstream, pobj, onlyPersistents);
+	else if(step.type == DATA_TYPE_FIXEDARRAY)
+		((FixedArrayType*)step.dataType)->addToStreamEx(mstream, pobj, onlyPersistents);
+	else
+		step.dataType->addToStream(mstream, pobj);
+
+	Py_DECREF(pobj);
+}
+
 //-------------------------------------------------------------------------------------
 PyObject* FixedDictType::createFromStream(MemoryStream* mstream)
 {
@@ -647,7 +647,17 @@ public:
 	bool isSameItemType(PyObject* pyValue);
 
 	void addToStream(MemoryStream* mstream, PyObject* pyValue);
-	void addToStreamEx(MemoryStream* mstream, PyObject* pyValue, bool onlyPersistents);
+	/**
+		pElementOffsetsΪNULLʱ¼ÿԪеʼλã 浵ʹ
+	*/
+	void addToStreamEx(MemoryStream* mstream, PyObject* pyValue, bool onlyPersistents, 
+		std::vector<uint32>* pElementOffsets = NULL);
+
+	/**
+		ͼдϲһαɣ 
+		ƥʱ˵дǰλòfalse
+	*/
+	bool addToStreamChecked(MemoryStream* mstream, PyObject* pyValue, bool onlyPersistents);
 
 	PyObject* createFromStream(MemoryStream* mstream);
 	PyObject* createFromStreamEx(MemoryStream* mstream, bool onlyPersistents);
@@ -671,6 +681,7 @@ public:
 
 protected:
 	DataType*			dataType_;		// 
+	DATATYPE			itemType_;		// dataType_->type() initializeʱ
 };
 
 class FixedDictType : public DataType
@@ -690,6 +701,21 @@ public:
 	typedef KBEShared_ptr< DictItemDataType > DictItemDataTypePtr;
 	typedef std::vector< std::pair< std::string, DictItemDataTypePtr > > FIXEDDICT_KEYTYPE_MAP;
 
+	/*
+		лƻеһ ÿkeyһ initializeɹkeyTypes_һ
+		pyKeyNameΪפpythonַ ֵʱʱkey
+	*/
+	struct SerializeStep
+	{
+		PyObject* pyKeyName;
+		const char* keyName;
+		DataType* dataType;
+		DATATYPE type;
+		bool persistent;
+	};
+
+	typedef std::vector< SerializeStep > SERIALIZE_PLAN;
+
 public:	
 	FixedDictType(DATATYPE_UID did = 0);
 	virtual ~FixedDictType();
@@ -699,6 +725,11 @@ public:
 	*/	
 	FIXEDDICT_KEYTYPE_MAP& getKeyTypes(void){ return keyTypes_; }
 
+	/** 
+		ñõлƻ ˳keyTypes_һ
+	*/
+	const SERIALIZE_PLAN& getSerializePlan(void) const{ return serializePlan_; }
+
 	const char* getName(void) const{ return "FIXED_DICT";}
 
 	bool isSameType(PyObject* pyValue);
@@ -707,6 +738,21 @@ public:
 	void addToStream(MemoryStream* mstream, PyObject* pyValue);
 	void addToStreamEx(MemoryStream* mstream, PyObject* pyValue, bool onlyPersistents);
 
+	/**
+		ͼдϲһαɣ 
+		ƥʱ˵дǰλòfalse
+	*/
+	bool addToStreamChecked(MemoryStream* mstream, PyObject* pyValue, bool onlyPersistents);
+
+	/**
+		д򴴽һֵ/Ԫأ ̶ֵ߸ԵEx汾
+	*/
+	static bool addItemToStreamChecked(MemoryStream* mstream, DataType* dataType, DATATYPE type, 
+		PyObject* pyValue, bool onlyPersistents);
+
+	static PyObject* createItemFromStream(MemoryStream* mstream, DataType* dataType, DATATYPE type, 
+		bool onlyPersistents);
+
 	PyObject* createFromStream(MemoryStream* mstream);
 	PyObject* createFromStreamEx(MemoryStream* mstream, bool onlyPersistents);
 
@@ -755,9 +801,16 @@ public:
 	std::string getNotFoundKeys(PyObject* dict);
 
 protected:
+	bool compileSerializePlan();
+
+	void writeDefaultItem(MemoryStream* mstream, const SerializeStep& step, bool onlyPersistents);
+
 	// ̶ֵĸkey
 	FIXEDDICT_KEYTYPE_MAP			keyTypes_;				
 
+	// keyTypes_лƻ
+	SERIALIZE_PLAN					serializePlan_;
+
 	// ʵֽűģ
 	PyObject*						implObj_;				
 
@@ -266,6 +266,7 @@ namespace KBEngine{
 #define ENTITY_FLAGS_TELEPORT_START					0x00000004
 #define ENTITY_FLAGS_TELEPORT_STOP					0x00000008
 #define ENTITY_FLAGS_DESTROY_AFTER_GETCELL			0x00000010
+#define ENTITY_FLAGS_OFFLOADING						0x00000020
 
 #define ENTITY_HEADER(CLASS)																				\
 public:																										\
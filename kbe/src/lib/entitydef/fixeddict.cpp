@@ -127,12 +127,12 @@ _StartCreateFixedDict:
 	{
 		pyVal = PyDict_New();
 
-		FixedDictType::FIXEDDICT_KEYTYPE_MAP& keyTypes = _dataType->getKeyTypes();
-		FixedDictType::FIXEDDICT_KEYTYPE_MAP::iterator iter = keyTypes.begin();
-		for (; iter != keyTypes.end(); ++iter)
+		const FixedDictType::SERIALIZE_PLAN& plan = _dataType->getSerializePlan();
+		FixedDictType::SERIALIZE_PLAN::const_iterator iter = plan.begin();
+		for (; iter != plan.end(); ++iter)
 		{
-			PyObject* item = iter->second->dataType->parseDefaultStr("");
-			PyDict_SetItemString(pyVal, iter->first.c_str(), item);
+			PyObject* item = iter->dataType->parseDefaultStr("");
+			PyDict_SetItem(pyVal, iter->pyKeyName, item);
 			Py_DECREF(item);
 		}
 	}
@@ -153,37 +153,32 @@ void FixedDict::initialize(PyObject* pyDictInitData)
 //-------------------------------------------------------------------------------------
 void FixedDict::initialize(MemoryStream* streamInitData, bool isPersistentsStream)
 {
-	FixedDictType::FIXEDDICT_KEYTYPE_MAP& keyTypes = _dataType->getKeyTypes();
-	FixedDictType::FIXEDDICT_KEYTYPE_MAP::const_iterator iter = keyTypes.begin();
+	const FixedDictType::SERIALIZE_PLAN& plan = _dataType->getSerializePlan();
+	FixedDictType::SERIALIZE_PLAN::const_iterator iter = plan.begin();
 
-	for(; iter != keyTypes.end(); ++iter)
+	for(; iter != plan.end(); ++iter)
 	{
-		if(isPersistentsStream && !iter->second->persistent)
+		if(isPersistentsStream && !iter->persistent)
 		{
-			PyObject* val1 = iter->second->dataType->parseDefaultStr("");
-			PyDict_SetItemString(pyDict_, iter->first.c_str(), val1);
+			PyObject* val1 = iter->dataType->parseDefaultStr("");
+			PyDict_SetItem(pyDict_, iter->pyKeyName, val1);
 			
 			// PyDict_SetItemҪ
 			Py_DECREF(val1);
 		}
 		else
 		{
-			PyObject* val1 = NULL;
-			if(iter->second->dataType->type() == DATA_TYPE_FIXEDDICT)
-				val1 = ((FixedDictType*)iter->second->dataType)->createFromStreamEx(streamInitData, isPersistentsStream);
-			else if(iter->second->dataType->type() == DATA_TYPE_FIXEDARRAY)
-				val1 = ((FixedArrayType*)iter->second->dataType)->createFromStreamEx(streamInitData, isPersistentsStream);
-			else
-				val1 = iter->second->dataType->createFromStream(streamInitData);
+			PyObject* val1 = FixedDictType::createItemFromStream(streamInitData, 
+				iter->dataType, iter->type, isPersistentsStream);
 
 			if (!val1)
 			{
-				ERROR_MSG(fmt::format("FixedDict::initialize: key({}) createFromStream error, use default value! type={}\n", iter->first, this->getDataType()->aliasName()));
-				val1 = iter->second->dataType->parseDefaultStr("");
+				ERROR_MSG(fmt::format("FixedDict::initialize: key({}) createFromStream error, use default value! type={}\n", iter->keyName, this->getDataType()->aliasName()));
+				val1 = iter->dataType->parseDefaultStr("");
 				KBE_ASSERT(val1);
 			}
 
-			PyDict_SetItemString(pyDict_, iter->first.c_str(), val1);
+			PyDict_SetItem(pyDict_, iter->pyKeyName, val1);
 			
 			// PyDict_SetItemҪ
 			Py_DECREF(val1);
@@ -362,18 +357,18 @@ PyObject* FixedDict::mp_subscript(PyObject* self, PyObject* key)
 //-------------------------------------------------------------------------------------
 PyObject* FixedDict::update(PyObject* args)
 {
-	FixedDictType::FIXEDDICT_KEYTYPE_MAP& keyTypes = _dataType->getKeyTypes();
-	FixedDictType::FIXEDDICT_KEYTYPE_MAP::const_iterator iter = keyTypes.begin();
+	const FixedDictType::SERIALIZE_PLAN& plan = _dataType->getSerializePlan();
+	FixedDictType::SERIALIZE_PLAN::const_iterator iter = plan.begin();
 
-	for(; iter != keyTypes.end(); ++iter)
+	for(; iter != plan.end(); ++iter)
 	{
-		PyObject* val = PyDict_GetItemString(args, iter->first.c_str());
+		PyObject* val = PyDict_GetItem(args, iter->pyKeyName);
 		if(val)
 		{
 			PyObject* val1 = 
-				static_cast<FixedDictType*>(getDataType())->createNewItemFromObj(iter->first.c_str(), val);
+				static_cast<FixedDictType*>(getDataType())->createNewItemFromObj(iter->keyName, val);
 
-			PyDict_SetItemString(pyDict_, iter->first.c_str(), val1);
+			PyDict_SetItem(pyDict_, iter->pyKeyName, val1);
 			
 			// PyDict_SetItemҪ
 			Py_DECREF(val1);
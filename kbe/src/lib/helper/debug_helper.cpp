@@ -229,6 +229,28 @@ private:
 
 DebugHelperSyncHandler* g_pDebugHelperSyncHandler = NULL;
 
+//-------------------------------------------------------------------------------------
+/*
+	߳˳ʱĻλΪ syncȡպɾ
+*/
+struct LogRecordRingHolder
+{
+	LogRecordRingHolder():
+	pRing(NULL)
+	{
+	}
+
+	~LogRecordRingHolder()
+	{
+		if (pRing)
+			pRing->orphan();
+	}
+
+	LogRecordRing* pRing;
+};
+
+static thread_local LogRecordRingHolder t_logRecordRingHolder;
+
 //-------------------------------------------------------------------------------------
 DebugHelper::DebugHelper() :
 _logfile(NULL),
@@ -245,13 +267,16 @@ scriptMsgType_(log4cxx::ScriptLevel::SCRIPT_INT),
 noSyncLog_(false),
 canLogFile_(true),
 loseLoggerTime_(timestamp()),
+enabledLogTypes_(KBELOG_TYPES),
 
 #if KBE_PLATFORM == PLATFORM_WIN32
 mainThreadID_(GetCurrentThreadId()),
 #else
 mainThreadID_(pthread_self()),
 #endif
-memoryStreamPool_("DebugHelperMemoryStream")
+memoryStreamPool_("DebugHelperMemoryStream"),
+logRecordRings_(),
+sentLogFormats_(0)
 {
 	g_pDebugHelperSyncHandler = new DebugHelperSyncHandler();
 	loseLoggerTime_ = timestamp();
@@ -295,6 +320,8 @@ void DebugHelper::changeLogger(const std::string& name)
 #ifndef NO_USE_LOG4CXX
 	g_logger = log4cxx::Logger::getLogger(name);
 #endif
+
+	updateEnabledLogTypes();
 }
 
 //-------------------------------------------------------------------------------------
@@ -352,6 +379,20 @@ bool DebugHelper::canLog(int level)
 #endif
 }
 
+//-------------------------------------------------------------------------------------
+void DebugHelper::updateEnabledLogTypes()
+{
+	uint32 enabledLogTypes = 0;
+
+	for (uint32 logType = KBELOG_PRINT; logType <= KBELOG_SCRIPT_NORMAL; logType <<= 1)
+	{
+		if (canLog(logType))
+			enabledLogTypes |= logType;
+	}
+
+	enabledLogTypes_ = enabledLogTypes;
+}
+
 //-------------------------------------------------------------------------------------
 void DebugHelper::lockthread()
 {
@@ -410,6 +451,8 @@ void DebugHelper::initialize(COMPONENT_TYPE componentType)
 	LOG4CXX_INFO(g_logger, "\n");
 #endif
 
+	DebugHelper::getSingleton().updateEnabledLogTypes();
+
 	ALERT_LOG_TO("", false);
 }
 
@@ -482,9 +525,25 @@ void DebugHelper::clearBufferedLog(bool destroy)
 		memoryStreamPool_.reclaimObject(childThreadBufferedLogPackets_);
 	}
 
+	// ֻɾ߳˳Ļ壬 ߳Կд
+	std::vector<LogRecordRing*>::iterator iter = logRecordRings_.begin();
+	while (iter != logRecordRings_.end())
+	{
+		if (destroy && (*iter)->orphaned())
+		{
+			delete (*iter);
+			iter = logRecordRings_.erase(iter);
+		}
+		else
+		{
+			++iter;
+		}
+	}
+
 	Network::g_trace_packet = v;
 
 	hasBufferedLogPackets_ = 0;
+	sentLogFormats_ = 0;
 	noSyncLog_ = true;
 	canLogFile_ = true;
 
@@ -492,11 +551,106 @@ void DebugHelper::clearBufferedLog(bool destroy)
 		g_pDebugHelperSyncHandler->cancel();
 }
 
+//-------------------------------------------------------------------------------------
+LogRecordRing* DebugHelper::threadLogRecordRing()
+{
+	if (t_logRecordRingHolder.pRing == NULL)
+	{
+		LogRecordRing* pRing = new LogRecordRing(LOG_RECORD_RING_SIZE);
+
+		KBEngine::thread::ThreadGuard tg(&this->logMutex);
+		logRecordRings_.push_back(pRing);
+		t_logRecordRingHolder.pRing = pRing;
+	}
+
+	return t_logRecordRingHolder.pRing;
+}
+
+//-------------------------------------------------------------------------------------
+void DebugHelper::collectLogRecords()
+{
+	int8 v = Network::g_trace_packet;
+	Network::g_trace_packet = 0;
+
+	uint32 numDropped = 0;
+	MemoryStream* pMemoryStream = memoryStreamPool_.createObject(OBJECTPOOL_POINT);
+
+	std::vector<LogRecordRing*>::iterator iter = logRecordRings_.begin();
+	while (iter != logRecordRings_.end())
+	{
+		LogRecordRing* pRing = (*iter);
+
+		// ȶȡݣ ߳˳ǰд¼Ҳܱȡ
+		bool orphaned = pRing->orphaned();
+		numDropped += pRing->takeNumDropped();
+
+		while (pRing->drain(*pMemoryStream, LOG_RECORD_MAX_MESSAGE) > 0)
+		{
+			Network::Bundle* pBundle = Network::Bundle::createPoolObject(OBJECTPOOL_POINT);
+
+			pBundle->newMessage(LoggerInterface::writeLogRecords);
+
+			(*pBundle) << getUserUID();
+			(*pBundle) << g_componentType;
+			(*pBundle) << g_componentID;
+			(*pBundle) << g_componentGlobalOrder;
+			(*pBundle) << g_componentGroupOrder;
+
+			// ¼Ѿȡ֮Ŷȡʽ ¼õĸʽһ
+			uint32 numFormats = LogFormats::size();
+			(*pBundle) << (numFormats - sentLogFormats_);
+
+			for (uint32 formatID = sentLogFormats_ + 1; formatID <= numFormats; ++formatID)
+			{
+				(*pBundle) << formatID;
+				(*pBundle) << std::string(LogFormats::format(formatID));
+			}
+
+			sentLogFormats_ = numFormats;
+
+			pBundle->appendBlob(pMemoryStream->data() + pMemoryStream->rpos(), (ArraySize)pMemoryStream->length());
+			pMemoryStream->clear(false);
+
+			bufferedLogPackets_.push(pBundle);
+			++hasBufferedLogPackets_;
+		}
+
+		if (orphaned)
+		{
+			delete pRing;
+			iter = logRecordRings_.erase(iter);
+		}
+		else
+		{
+			++iter;
+		}
+	}
+
+	memoryStreamPool_.reclaimObject(pMemoryStream);
+	Network::g_trace_packet = v;
+
+	if (numDropped > 0)
+	{
+		std::string s = fmt::format("DebugHelper::collectLogRecords: {} log records dropped, ring buffer({} bytes) is full!\n",
+			numDropped, LOG_RECORD_RING_SIZE);
+
+#ifdef NO_USE_LOG4CXX
+#else
+		KBE_LOG4CXX_WARN(g_logger, s);
+#endif
+
+		onMessage(KBELOG_WARNING, s.c_str(), (uint32)s.size());
+	}
+}
+
 //-------------------------------------------------------------------------------------
 void DebugHelper::sync()
 {
 	lockthread();
 
+	if (logRecordRings_.size() > 0)
+		collectLogRecords();
+
 	if(hasBufferedLogPackets_ == 0)
 	{
 		unlockthread();
@@ -743,6 +897,10 @@ void DebugHelper::onMessage(uint32 logType, const char * str, uint32 length)
 //-------------------------------------------------------------------------------------
 void DebugHelper::registerLogger(Network::MessageID msgID, Network::Address* pAddr)
 {
+	// µloggerûб̵ĸʽ Ҫ·
+	if (loggerAddr_ != *pAddr)
+		sentLogFormats_ = 0;
+
 	loggerAddr_ = *pAddr;
 	ALERT_LOG_TO("logger_", true);
 }
@@ -767,6 +925,12 @@ void DebugHelper::printBufferedLogs()
 {
 	lockthread();
 
+	if (logRecordRings_.size() > 0)
+		collectLogRecords();
+
+	// ĸʽĵˣ logger´Ҫ»ȡ
+	sentLogFormats_ = 0;
+
 	if(hasBufferedLogPackets_ == 0)
 	{
 		unlockthread();
@@ -828,6 +992,14 @@ void DebugHelper::printBufferedLogs()
 		if (msglen == 65535)
 			(*pBundle) >> msglen1;
 
+		if (msgID == LoggerInterface::writeLogRecords.msgID)
+		{
+			printLogRecords(*pBundle);
+			--hasBufferedLogPackets_;
+			Network::Bundle::ObjPool().reclaimObject(pBundle);
+			continue;
+		}
+
 		(*pBundle) >> uid;
 		(*pBundle) >> logtype;
 		(*pBundle) >> componentType;
@@ -838,74 +1010,7 @@ void DebugHelper::printBufferedLogs()
 		(*pBundle) >> kbetime;
 		(*pBundle).readBlob(str);
 
-		time_t tt = static_cast<time_t>(t);	
-	    tm* aTm = localtime(&tt);
-	    //       YYYY   year
-	    //       MM     month (2 digits 01-12)
-	    //       DD     day (2 digits 01-31)
-	    //       HH     hour (2 digits 00-23)
-	    //       MM     minutes (2 digits 00-59)
-	    //       SS     seconds (2 digits 00-59)
-
-		if(aTm == NULL)
-		{
-			Network::Bundle::ObjPool().reclaimObject(pBundle);
-			continue;
-		}
-	
-		char timebuf[MAX_BUF];
-	    kbe_snprintf(timebuf, MAX_BUF, " [%-4d-%02d-%02d %02d:%02d:%02d %03d] ", aTm->tm_year+1900, aTm->tm_mon+1, 
-			aTm->tm_mday, aTm->tm_hour, aTm->tm_min, aTm->tm_sec, kbetime);
-
-		std::string logstr = fmt::format("==>{}", timebuf);
-		logstr += str;
-		
-#ifdef NO_USE_LOG4CXX
-#else
-		switch (logtype)
-		{
-		case KBELOG_PRINT:
-			KBE_LOG4CXX_INFO(g_logger, logstr);
-			break;
-		case KBELOG_ERROR:
-			KBE_LOG4CXX_ERROR(g_logger, logstr);
-			break;
-		case KBELOG_WARNING:
-			KBE_LOG4CXX_WARN(g_logger, logstr);
-			break;
-		case KBELOG_DEBUG:
-			KBE_LOG4CXX_DEBUG(g_logger, logstr);
-			break;
-		case KBELOG_INFO:
-			KBE_LOG4CXX_INFO(g_logger, logstr);
-			break;
-		case KBELOG_CRITICAL:
-			KBE_LOG4CXX_FATAL(g_logger, logstr);
-			break;
-		case KBELOG_SCRIPT_INFO:
-			setScriptMsgType(log4cxx::ScriptLevel::SCRIPT_INFO);
-			KBE_LOG4CXX_LOG(g_logger,  log4cxx::ScriptLevel::toLevel(scriptMsgType_), logstr);
-			break;
-		case KBELOG_SCRIPT_ERROR:
-			setScriptMsgType(log4cxx::ScriptLevel::SCRIPT_ERR);
-			KBE_LOG4CXX_LOG(g_logger,  log4cxx::ScriptLevel::toLevel(scriptMsgType_), logstr);
-			break;
-		case KBELOG_SCRIPT_DEBUG:
-			setScriptMsgType(log4cxx::ScriptLevel::SCRIPT_DBG);
-			KBE_LOG4CXX_LOG(g_logger,  log4cxx::ScriptLevel::toLevel(scriptMsgType_), logstr);
-			break;
-		case KBELOG_SCRIPT_WARNING:
-			setScriptMsgType(log4cxx::ScriptLevel::SCRIPT_WAR);
-			KBE_LOG4CXX_LOG(g_logger,  log4cxx::ScriptLevel::toLevel(scriptMsgType_), logstr);
-			break;
-		case KBELOG_SCRIPT_NORMAL:
-			setScriptMsgType(log4cxx::ScriptLevel::SCRIPT_INFO);
-			KBE_LOG4CXX_LOG(g_logger,  log4cxx::ScriptLevel::toLevel(scriptMsgType_), logstr);
-			break;
-		default:
-			break;
-		};
-#endif
+		printBufferedLog(logtype, t, kbetime, str);
 
 		--hasBufferedLogPackets_;
 		Network::Bundle::ObjPool().reclaimObject(pBundle);
@@ -914,6 +1019,142 @@ void DebugHelper::printBufferedLogs()
 	unlockthread();
 }
 
+//-------------------------------------------------------------------------------------
+void DebugHelper::printLogRecords(Network::Bundle& bundle)
+{
+	int32 uid;
+	COMPONENT_TYPE componentType;
+	COMPONENT_ID componentID;
+	COMPONENT_ORDER componentGlobalOrder;
+	COMPONENT_ORDER componentGroupOrder;
+	uint32 numFormats;
+
+	bundle >> uid;
+	bundle >> componentType;
+	bundle >> componentID;
+	bundle >> componentGlobalOrder;
+	bundle >> componentGroupOrder;
+	bundle >> numFormats;
+
+	// ̵ĸʽڱأ Ϣĸʽ
+	for (uint32 i = 0; i < numFormats; ++i)
+	{
+		uint32 formatID;
+		std::string format;
+		bundle >> formatID;
+		bundle >> format;
+	}
+
+	std::string records;
+	bundle.readBlob(records);
+
+	MemoryStream s;
+	s.append(records.data(), records.size());
+
+	LogRecordReader reader(s);
+	while (reader.next())
+	{
+		printBufferedLog(reader.logType(), reader.time(), reader.ms(), 
+			reader.format(LogFormats::format(reader.formatID())));
+	}
+}
+
+//-------------------------------------------------------------------------------------
+void DebugHelper::printBufferedLog(uint32 logtype, int64 t, uint32 kbetime, const std::string& str)
+{
+	time_t tt = static_cast<time_t>(t);	
+    tm* aTm = localtime(&tt);
+    //       YYYY   year
+    //       MM     month (2 digits 01-12)
+    //       DD     day (2 digits 01-31)
+    //       HH     hour (2 digits 00-23)
+    //       MM     minutes (2 digits 00-59)
+    //       SS     seconds (2 digits 00-59)
+
+	if(aTm == NULL)
+		return;
+
+	char timebuf[MAX_BUF];
+    kbe_snprintf(timebuf, MAX_BUF, " [%-4d-%02d-%02d %02d:%02d:%02d %03d] ", aTm->tm_year+1900, aTm->tm_mon+1, 
+		aTm->tm_mday, aTm->tm_hour, aTm->tm_min, aTm->tm_sec, kbetime);
+
+	std::string logstr = fmt::format("==>{}", timebuf);
+	logstr += str;
+	
+#ifdef NO_USE_LOG4CXX
+#else
+	switch (logtype)
+	{
+	case KBELOG_PRINT:
+		KBE_LOG4CXX_INFO(g_logger, logstr);
+		break;
+	case KBELOG_ERROR:
+		KBE_LOG4CXX_ERROR(g_logger, logstr);
+		break;
+	case KBELOG_WARNING:
+		KBE_LOG4CXX_WARN(g_logger, logstr);
+		break;
+	case KBELOG_DEBUG:
+		KBE_LOG4CXX_DEBUG(g_logger, logstr);
+		break;
+	case KBELOG_INFO:
+		KBE_LOG4CXX_INFO(g_logger, logstr);
+		break;
+	case KBELOG_CRITICAL:
+		KBE_LOG4CXX_FATAL(g_logger, logstr);
+		break;
+	case KBELOG_SCRIPT_INFO:
+		setScriptMsgType(log4cxx::ScriptLevel::SCRIPT_INFO);
+		KBE_LOG4CXX_LOG(g_logger,  log4cxx::ScriptLevel::toLevel(scriptMsgType_), logstr);
+		break;
+	case KBELOG_SCRIPT_ERROR:
+		setScriptMsgType(log4cxx::ScriptLevel::SCRIPT_ERR);
+		KBE_LOG4CXX_LOG(g_logger,  log4cxx::ScriptLevel::toLevel(scriptMsgType_), logstr);
+		break;
+	case KBELOG_SCRIPT_DEBUG:
+		setScriptMsgType(log4cxx::ScriptLevel::SCRIPT_DBG);
+		KBE_LOG4CXX_LOG(g_logger,  log4cxx::ScriptLevel::toLevel(scriptMsgType_), logstr);
+		break;
+	case KBELOG_SCRIPT_WARNING:
+		setScriptMsgType(log4cxx::ScriptLevel::SCRIPT_WAR);
+		KBE_LOG4CXX_LOG(g_logger,  log4cxx::ScriptLevel::toLevel(scriptMsgType_), logstr);
+		break;
+	case KBELOG_SCRIPT_NORMAL:
+		setScriptMsgType(log4cxx::ScriptLevel::SCRIPT_INFO);
+		KBE_LOG4CXX_LOG(g_logger,  log4cxx::ScriptLevel::toLevel(scriptMsgType_), logstr);
+		break;
+	default:
+		break;
+	};
+#endif
+}
+
+//-------------------------------------------------------------------------------------
+void DebugHelper::text_msg(uint32 logType, const std::string& s)
+{
+	switch (logType)
+	{
+	case KBELOG_ERROR:
+		error_msg(s);
+		break;
+	case KBELOG_WARNING:
+		warning_msg(s);
+		break;
+	case KBELOG_DEBUG:
+		debug_msg(s);
+		break;
+	case KBELOG_INFO:
+		info_msg(s);
+		break;
+	case KBELOG_CRITICAL:
+		critical_msg(s);
+		break;
+	default:
+		print_msg(s);
+		break;
+	};
+}
+
 //-------------------------------------------------------------------------------------
 void DebugHelper::print_msg(const std::string& s)
 {
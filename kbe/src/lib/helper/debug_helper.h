@@ -12,6 +12,7 @@
 #include "thread/threadmutex.h"
 #include "network/common.h"
 #include "network/address.h"
+#include "helper/log_record.h"
 
 namespace KBEngine{
 
@@ -139,6 +140,33 @@ public:
 	void script_error_msg(const std::string& s);
 	void backtrace_msg();
 
+	// ־ͷɵĽӿ
+	void text_msg(uint32 logType, const std::string& s);
+
+	/**
+		־ ֻѸʽIDԭʼд뱾̵߳λ壬 synclogger 
+		ʽƳٵloggerнС δlogger(дļ)ʱ˻صͨĸʽ
+	*/
+	template<typename... Args>
+	void record_msg(uint32 logType, uint32 formatID, const char* format, const Args&... args)
+	{
+		if (!canSendLogRecords())
+		{
+			text_msg(logType, fmt::format(format, args...));
+			return;
+		}
+
+		LogRecordRing* pRing = threadLogRecordRing();
+		LogRecordWriter writer(pRing->scratch(), LOG_RECORD_MAX_SIZE);
+		writer.begin(formatID, logType, (uint8)sizeof...(args));
+		writer.args(args...);
+		pRing->push(writer);
+	}
+
+	bool canSendLogRecords() const { return !canLogFile_ && !noSyncLog_; }
+
+	LogRecordRing* threadLogRecordRing();
+
 	void onMessage(uint32 logType, const char * str, uint32 length);
 
 	void registerLogger(Network::MessageID msgID, Network::Address* pAddr);
@@ -173,7 +201,20 @@ public:
 
 	bool canLog(int level);
 
+	/**
+		ĳ־ǰǷᱻ ־ڸʽ֮ǰ˼飬
+		˵־ٲκθʽ뿽Ŀ
+	*/
+	bool isLogTypeEnabled(uint32 logType) const { return (enabledLogTypes_ & logType) > 0; }
+	void updateEnabledLogTypes();
+
 private:
+	// ̻߳λеļ¼ΪwriteLogRecordsϢ ǰlogMutex
+	void collectLogRecords();
+
+	void printLogRecords(Network::Bundle& bundle);
+	void printBufferedLog(uint32 logtype, int64 t, uint32 kbetime, const std::string& str);
+
 	FILE* _logfile;
 	std::string _currFile, _currFuncName;
 	uint32 _currLine;
@@ -195,6 +236,9 @@ private:
 
 	uint64 loseLoggerTime_;
 
+	// canLogĻ棬 ־ֻڳʼлloggerʱı
+	uint32 enabledLogTypes_;
+
 	// ¼߳IDжǷ߳־
 	// ߳־ʱ־л浽߳ʱͬlogger
 #if KBE_PLATFORM == PLATFORM_WIN32
@@ -205,6 +249,12 @@ private:
 
 	ObjectPool<MemoryStream> memoryStreamPool_;
 	std::queue< MemoryStream* > childThreadBufferedLogPackets_;
+
+	// ÿ־߳һλ
+	std::vector< LogRecordRing* > logRecordRings_;
+
+	// ѾwriteLogRecordsloggerĸʽ ֻ֮עĸʽ
+	uint32 sentLogFormats_;
 };
 
 /*---------------------------------------------------------------------------------
@@ -215,13 +265,33 @@ private:
 
 #define PRINT_MSG(m)					DebugHelper::getSingleton().print_msg((m))									// κϢ
 #define ERROR_MSG(m)					DebugHelper::getSingleton().error_msg((m))									// һ
-#define DEBUG_MSG(m)					DebugHelper::getSingleton().debug_msg((m))									// һdebugϢ
-#define INFO_MSG(m)						DebugHelper::getSingleton().info_msg((m))									// һinfoϢ
-#define WARNING_MSG(m)					DebugHelper::getSingleton().warning_msg((m))								// һϢ
+#define DEBUG_MSG(m)					(DebugHelper::getSingleton().isLogTypeEnabled(KBELOG_DEBUG) ? \
+										DebugHelper::getSingleton().debug_msg((m)) : (void)0)						// һdebugϢ
+#define INFO_MSG(m)						(DebugHelper::getSingleton().isLogTypeEnabled(KBELOG_INFO) ? \
+										DebugHelper::getSingleton().info_msg((m)) : (void)0)						// һinfoϢ
+#define WARNING_MSG(m)					(DebugHelper::getSingleton().isLogTypeEnabled(KBELOG_WARNING) ? \
+										DebugHelper::getSingleton().warning_msg((m)) : (void)0)					// һϢ
 #define CRITICAL_MSG(m)					DebugHelper::getSingleton().setFile(__FUNCTION__, \
 										__FILE__, __LINE__); \
 										DebugHelper::getSingleton().critical_msg((m))
 
+/*---------------------------------------------------------------------------------
+	־ӿڣ ʽַ Ϊ㡢boolcharַָ
+	: DEBUG_FMT("Entity::onDestroy: {}({})\n", name, id);
+---------------------------------------------------------------------------------*/
+#define KBE_LOG_RECORD(LOGTYPE, FORMAT, ...)																\
+	do {																									\
+		if (DebugHelper::getSingleton().isLogTypeEnabled(LOGTYPE))											\
+		{																									\
+			static const uint32 kbeLogFormatID = LogFormats::registerFormat(FORMAT);						\
+			DebugHelper::getSingleton().record_msg(LOGTYPE, kbeLogFormatID, FORMAT, ##__VA_ARGS__);		\
+		}																									\
+	} while (0)
+
+#define DEBUG_FMT(format, ...)			KBE_LOG_RECORD(KBELOG_DEBUG, format, ##__VA_ARGS__)
+#define INFO_FMT(format, ...)			KBE_LOG_RECORD(KBELOG_INFO, format, ##__VA_ARGS__)
+#define WARNING_FMT(format, ...)		KBE_LOG_RECORD(KBELOG_WARNING, format, ##__VA_ARGS__)
+
 /*---------------------------------------------------------------------------------
 	Ժ
 ---------------------------------------------------------------------------------*/
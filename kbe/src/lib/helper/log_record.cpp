@@ -0,0 +1,400 @@
+// Copyright 2008-2018 Yolo Technologies, Inc. All Rights Reserved. https://www.comblockengine.com
+
+
+#include "log_record.h"
+#include "common/memorystream.h"
+#include "thread/threadguard.h"
+
+namespace KBEngine{
+
+//-------------------------------------------------------------------------------------
+static thread::ThreadMutex& logFormatsMutex()
+{
+	static thread::ThreadMutex mutex;
+	return mutex;
+}
+
+//-------------------------------------------------------------------------------------
+static std::vector<const char*>& logFormats()
+{
+	static std::vector<const char*> formats;
+	return formats;
+}
+
+//-------------------------------------------------------------------------------------
+uint32 LogFormats::registerFormat(const char* format)
+{
+	thread::ThreadGuard tg(&logFormatsMutex());
+	logFormats().push_back(format);
+	return (uint32)logFormats().size();
+}
+
+//-------------------------------------------------------------------------------------
+uint32 LogFormats::size()
+{
+	thread::ThreadGuard tg(&logFormatsMutex());
+	return (uint32)logFormats().size();
+}
+
+//-------------------------------------------------------------------------------------
+const char* LogFormats::format(uint32 formatID)
+{
+	thread::ThreadGuard tg(&logFormatsMutex());
+
+	if (formatID == 0 || formatID > logFormats().size())
+		return NULL;
+
+	return logFormats()[formatID - 1];
+}
+
+//-------------------------------------------------------------------------------------
+LogRecordWriter::LogRecordWriter(uint8* buffer, uint32 capacity):
+buffer_(buffer),
+capacity_(capacity),
+size_(0),
+overflowed_(false)
+{
+}
+
+//-------------------------------------------------------------------------------------
+void LogRecordWriter::begin(uint32 formatID, uint32 logType, uint8 argc)
+{
+	size_ = 0;
+	overflowed_ = argc > LOG_RECORD_MAX_ARGS;
+
+	uint64 t = getTimeMs();
+	write<uint32>(formatID);
+	write<uint32>(logType);
+	write<int64>((int64)(t / 1000));
+	write<uint32>((uint32)(t % 1000));
+	write<uint8>(argc);
+}
+
+//-------------------------------------------------------------------------------------
+void LogRecordWriter::put(const void* src, uint32 n)
+{
+	if (overflowed_ || size_ + n > capacity_)
+	{
+		overflowed_ = true;
+		return;
+	}
+
+	memcpy(buffer_ + size_, src, n);
+	size_ += n;
+}
+
+//-------------------------------------------------------------------------------------
+void LogRecordWriter::tag(uint8 argType)
+{
+	write<uint8>(argType);
+}
+
+//-------------------------------------------------------------------------------------
+void LogRecordWriter::putString(const char* str, uint32 n)
+{
+	tag(LOG_RECORD_ARG_STRING);
+
+	// ʣռ䲻ʱضַ ֤¼Ȼ
+	uint32 used = size_ + sizeof(ArraySize);
+	if (used >= capacity_)
+	{
+		overflowed_ = true;
+		return;
+	}
+
+	if (n > capacity_ - used)
+		n = capacity_ - used;
+
+	write<ArraySize>(n);
+	put(str, n);
+}
+
+//-------------------------------------------------------------------------------------
+void LogRecordWriter::arg(bool value)
+{
+	tag(LOG_RECORD_ARG_BOOL);
+	write<uint8>(value ? 1 : 0);
+}
+
+//-------------------------------------------------------------------------------------
+void LogRecordWriter::arg(char value)
+{
+	tag(LOG_RECORD_ARG_CHAR);
+	write<int8>((int8)value);
+}
+
+//-------------------------------------------------------------------------------------
+void LogRecordWriter::arg(double value)
+{
+	tag(LOG_RECORD_ARG_DOUBLE);
+	write<double>(value);
+}
+
+//-------------------------------------------------------------------------------------
+void LogRecordWriter::arg(const char* value)
+{
+	if (value == NULL)
+		value = "(null)";
+
+	putString(value, (uint32)strlen(value));
+}
+
+//-------------------------------------------------------------------------------------
+void LogRecordWriter::arg(const std::string& value)
+{
+	putString(value.data(), (uint32)value.size());
+}
+
+//-------------------------------------------------------------------------------------
+void LogRecordWriter::arg(const void* value)
+{
+	tag(LOG_RECORD_ARG_POINTER);
+	write<uint64>((uint64)(uintptr_t)value);
+}
+
+//-------------------------------------------------------------------------------------
+LogRecordRing::LogRecordRing(uint32 capacity):
+buffer_(NULL),
+capacity_(capacity),
+head_(0),
+tail_(0),
+numDropped_(0),
+orphaned_(false)
+{
+	KBE_ASSERT(capacity_ > 0 && (capacity_ & (capacity_ - 1)) == 0);
+	buffer_ = new uint8[capacity_];
+}
+
+//-------------------------------------------------------------------------------------
+LogRecordRing::~LogRecordRing()
+{
+	SAFE_RELEASE_ARRAY(buffer_);
+}
+
+//-------------------------------------------------------------------------------------
+bool LogRecordRing::push(const LogRecordWriter& writer)
+{
+	uint32 size = writer.size();
+	uint32 total = sizeof(uint32) + size;
+
+	uint32 head = head_.load(std::memory_order_relaxed);
+	uint32 tail = tail_.load(std::memory_order_acquire);
+
+	if (writer.overflowed() || capacity_ - (head - tail) < total)
+	{
+		numDropped_.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	uint32 sizeField = size;
+	EndianConvert(sizeField);
+
+	const uint8* src[2] = { (const uint8*)&sizeField, writer.data() };
+	uint32 lens[2] = { sizeof(uint32), size };
+
+	uint32 pos = head;
+	for (int i = 0; i < 2; ++i)
+	{
+		uint32 idx = pos & (capacity_ - 1);
+		uint32 first = std::min(lens[i], capacity_ - idx);
+		memcpy(buffer_ + idx, src[i], first);
+		memcpy(buffer_, src[i] + first, lens[i] - first);
+		pos += lens[i];
+	}
+
+	head_.store(head + total, std::memory_order_release);
+	return true;
+}
+
+//-------------------------------------------------------------------------------------
+void LogRecordRing::copyOut(uint32 pos, uint8* dest, uint32 n) const
+{
+	uint32 idx = pos & (capacity_ - 1);
+	uint32 first = std::min(n, capacity_ - idx);
+	memcpy(dest, buffer_ + idx, first);
+	memcpy(dest + first, buffer_, n - first);
+}
+
+//-------------------------------------------------------------------------------------
+uint32 LogRecordRing::drain(MemoryStream& out, uint32 maxBytes)
+{
+	uint32 tail = tail_.load(std::memory_order_relaxed);
+	uint32 head = head_.load(std::memory_order_acquire);
+
+	// ֻļ¼
+	uint32 pos = tail;
+	while (pos != head)
+	{
+		uint32 size = 0;
+		copyOut(pos, (uint8*)&size, sizeof(uint32));
+		EndianConvert(size);
+
+		uint32 total = sizeof(uint32) + size;
+		if (pos != tail && (pos - tail) + total > maxBytes)
+			break;
+
+		pos += total;
+	}
+
+	uint32 n = pos - tail;
+	if (n == 0)
+		return 0;
+
+	size_t wpos = out.wpos();
+	out.data_resize(wpos + n);
+	copyOut(tail, out.data() + wpos, n);
+	out.wpos((int)(wpos + n));
+
+	tail_.store(pos, std::memory_order_release);
+	return n;
+}
+
+//-------------------------------------------------------------------------------------
+LogRecordReader::LogRecordReader(MemoryStream& s):
+s_(s),
+end_(s.rpos()),
+formatID_(0),
+logType_(0),
+time_(0),
+ms_(0)
+{
+}
+
+//-------------------------------------------------------------------------------------
+bool LogRecordReader::next()
+{
+	// һ¼Ĳûбȡʱֱ
+	if (end_ > s_.rpos())
+		s_.rpos((int)end_);
+
+	const uint32 headerSize = sizeof(uint32) * 3 + sizeof(int64) + sizeof(uint8);
+
+	while (s_.length() >= sizeof(uint32))
+	{
+		uint32 size = 0;
+		s_ >> size;
+
+		if (size > s_.length())
+		{
+			s_.done();
+			end_ = s_.rpos();
+			return false;
+		}
+
+		end_ = s_.rpos() + size;
+
+		if (size < headerSize)
+		{
+			s_.rpos((int)end_);
+			continue;
+		}
+
+		s_ >> formatID_;
+		s_ >> logType_;
+		s_ >> time_;
+		s_ >> ms_;
+		return true;
+	}
+
+	return false;
+}
+
+//-------------------------------------------------------------------------------------
+std::string LogRecordReader::format(const char* format)
+{
+	if (format == NULL)
+	{
+		s_.rpos((int)end_);
+		return fmt::format("<unknown log format {}>\n", formatID_);
+	}
+
+	fmt::basic_format_arg<fmt::format_context> args[LOG_RECORD_MAX_ARGS];
+	std::string strings[LOG_RECORD_MAX_ARGS];
+	uint8 argc = 0;
+
+	try
+	{
+		s_ >> argc;
+
+		if (argc > LOG_RECORD_MAX_ARGS)
+			throw MemoryStreamException(false, s_.rpos(), argc, s_.length());
+
+		for (uint8 i = 0; i < argc; ++i)
+		{
+			uint8 argType = 0;
+			s_ >> argType;
+
+			switch (argType)
+			{
+			case LOG_RECORD_ARG_INT64:
+			{
+				int64 v = 0;
+				s_ >> v;
+				args[i] = fmt::internal::make_arg<fmt::format_context>(v);
+				break;
+			}
+			case LOG_RECORD_ARG_UINT64:
+			{
+				uint64 v = 0;
+				s_ >> v;
+				args[i] = fmt::internal::make_arg<fmt::format_context>(v);
+				break;
+			}
+			case LOG_RECORD_ARG_DOUBLE:
+			{
+				double v = 0.0;
+				s_ >> v;
+				args[i] = fmt::internal::make_arg<fmt::format_context>(v);
+				break;
+			}
+			case LOG_RECORD_ARG_BOOL:
+			{
+				uint8 v = 0;
+				s_ >> v;
+				args[i] = fmt::internal::make_arg<fmt::format_context>(v > 0);
+				break;
+			}
+			case LOG_RECORD_ARG_CHAR:
+			{
+				int8 v = 0;
+				s_ >> v;
+				args[i] = fmt::internal::make_arg<fmt::format_context>((char)v);
+				break;
+			}
+			case LOG_RECORD_ARG_STRING:
+			{
+				s_.readBlob(strings[i]);
+				args[i] = fmt::internal::make_arg<fmt::format_context>(strings[i]);
+				break;
+			}
+			case LOG_RECORD_ARG_POINTER:
+			{
+				uint64 v = 0;
+				s_ >> v;
+				args[i] = fmt::internal::make_arg<fmt::format_context>((const void*)(uintptr_t)v);
+				break;
+			}
+			default:
+				throw MemoryStreamException(false, s_.rpos(), argType, s_.length());
+			};
+		}
+	}
+	catch (MemoryStreamException&)
+	{
+		s_.rpos((int)end_);
+		return fmt::format("<corrupted log record, format={}> {}", formatID_, format);
+	}
+
+	s_.rpos((int)end_);
+
+	try
+	{
+		return fmt::vformat(format, fmt::basic_format_args<fmt::format_context>(args, argc));
+	}
+	catch (const fmt::format_error& err)
+	{
+		return fmt::format("<log format error: {}> {}", err.what(), format);
+	}
+}
+
+}
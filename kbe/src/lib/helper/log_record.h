@@ -0,0 +1,190 @@
+// Copyright 2008-2018 Yolo Technologies, Inc. All Rights Reserved. https://www.comblockengine.com
+
+#ifndef KBE_LOG_RECORD_H
+#define KBE_LOG_RECORD_H
+
+#include "common/common.h"
+#include "common/memorystream_converter.h"
+#include "thread/threadmutex.h"
+#include <atomic>
+#include <type_traits>
+
+namespace KBEngine{
+
+class MemoryStream;
+
+/*
+	־¼
+	־õֻдʽIDԭʼ ĸʽƳٵloggerн
+
+	һ¼Ĳ:
+		uint32 size() | uint32 formatID | uint32 logType | int64 sec | uint32 ms | uint8 argc | (uint8 tag | value) * argc
+*/
+#define LOG_RECORD_MAX_SIZE			4096				// ¼ޣ ַᱻض
+#define LOG_RECORD_MAX_ARGS			16
+#define LOG_RECORD_RING_SIZE		(256 * 1024)		// ÿ̵߳ĻλС 2
+#define LOG_RECORD_MAX_MESSAGE		(16 * 1024)			// һwriteLogRecordsϢЯļ¼ֽ
+
+enum LOG_RECORD_ARG_TYPE
+{
+	LOG_RECORD_ARG_INT64		= 1,
+	LOG_RECORD_ARG_UINT64		= 2,
+	LOG_RECORD_ARG_DOUBLE		= 3,
+	LOG_RECORD_ARG_BOOL			= 4,
+	LOG_RECORD_ARG_CHAR			= 5,
+	LOG_RECORD_ARG_STRING		= 6,
+	LOG_RECORD_ARG_POINTER		= 7
+};
+
+/*
+	ʽַע ÿ־õڵһִʱעһ(ھ̬)
+	ID1ʼ˳䣬 ַ
+*/
+class LogFormats
+{
+public:
+	static uint32 registerFormat(const char* format);
+
+	static uint32 size();
+
+	// NULLʾûиID
+	static const char* format(uint32 formatID);
+};
+
+/*
+	߳Լʱбһ¼
+*/
+class LogRecordWriter
+{
+public:
+	LogRecordWriter(uint8* buffer, uint32 capacity);
+
+	void begin(uint32 formatID, uint32 logType, uint8 argc);
+
+	void args()
+	{
+	}
+
+	template<typename T, typename... Rest>
+	void args(const T& value, const Rest&... rest)
+	{
+		arg(value);
+		args(rest...);
+	}
+
+	void arg(bool value);
+	void arg(char value);
+	void arg(double value);
+	void arg(const char* value);
+	void arg(const std::string& value);
+	void arg(const void* value);
+
+	template<typename T>
+	typename std::enable_if<(std::is_integral<T>::value && std::is_signed<T>::value) || std::is_enum<T>::value>::type
+		arg(T value)
+	{
+		tag(LOG_RECORD_ARG_INT64);
+		write<int64>((int64)value);
+	}
+
+	template<typename T>
+	typename std::enable_if<std::is_integral<T>::value && !std::is_signed<T>::value>::type
+		arg(T value)
+	{
+		tag(LOG_RECORD_ARG_UINT64);
+		write<uint64>((uint64)value);
+	}
+
+	const uint8* data() const { return buffer_; }
+	uint32 size() const { return size_; }
+
+	// 岻ʱ¼Ϊ д뻷λ
+	bool overflowed() const { return overflowed_; }
+
+protected:
+	template<typename T>
+	void write(T value)
+	{
+		EndianConvert(value);
+		put(&value, sizeof(T));
+	}
+
+	void tag(uint8 argType);
+	void put(const void* src, uint32 n);
+	void putString(const char* str, uint32 n);
+
+	uint8* buffer_;
+	uint32 capacity_;
+	uint32 size_;
+	bool overflowed_;
+};
+
+/*
+	ߵߵλ
+	ӵ̣߳ ߳ϵDebugHelper::sync
+*/
+class LogRecordRing
+{
+public:
+	LogRecordRing(uint32 capacity);
+	~LogRecordRing();
+
+	uint8* scratch() { return scratch_; }
+
+	// ߵã ռ䲻ʱ
+	bool push(const LogRecordWriter& writer);
+
+	// ߵã ļ¼ᵽoutУ maxBytesֽ(һ) ذ˵ֽ
+	uint32 drain(MemoryStream& out, uint32 maxBytes);
+
+	uint32 takeNumDropped() { return numDropped_.exchange(0); }
+
+	// ߳˳󱻱ǣ ȡպɾ
+	void orphan() { orphaned_.store(true, std::memory_order_release); }
+	bool orphaned() const { return orphaned_.load(std::memory_order_acquire); }
+
+protected:
+	void copyOut(uint32 pos, uint8* dest, uint32 n) const;
+
+	uint8* buffer_;
+	uint32 capacity_;
+	std::atomic<uint32> head_;
+	std::atomic<uint32> tail_;
+	std::atomic<uint32> numDropped_;
+	std::atomic<bool> orphaned_;
+
+	uint8 scratch_[LOG_RECORD_MAX_SIZE];
+};
+
+/*
+	ζ¼ʽ logger뱾ػ˴ӡ
+*/
+class LogRecordReader
+{
+public:
+	LogRecordReader(MemoryStream& s);
+
+	// һ¼ͷ ûи¼ʱfalse
+	bool next();
+
+	uint32 formatID() const { return formatID_; }
+	uint32 logType() const { return logType_; }
+	int64 time() const { return time_; }
+	uint32 ms() const { return ms_; }
+
+	// ʹformatʽ¼Ĳ formatΪNULLƥʱ˵
+	std::string format(const char* format);
+
+protected:
+	MemoryStream& s_;
+	size_t end_;
+
+	uint32 formatID_;
+	uint32 logType_;
+	int64 time_;
+	uint32 ms_;
+};
+
+}
+
+#endif // KBE_LOG_RECORD_H
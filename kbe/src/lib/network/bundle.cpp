@@ -139,10 +139,14 @@ void Bundle::_calcPacketMaxSize()
 {
 	// ʹopensslͨѶǱ֤һܱBlowfish::BLOCK_SIZE
 	// ڼһذʱҪֽ
-	if(g_channelExternalEncryptType == 1)
+	// AEADʱÿЯһ֤ǩ Эʧʱ˵Blowfish ߶Ҫ
+	if(g_channelExternalEncryptType > 0)
 	{
-		packetMaxSize_ = isTCPPacket_ ? (int)(TCPPacket::maxBufferSize() - ENCRYPTTION_WASTAGE_SIZE) :
-			(PACKET_MAX_SIZE_UDP - ENCRYPTTION_WASTAGE_SIZE);
+		int wastage = g_channelExternalEncryptType >= 3 ? 
+			KBE_MAX(ENCRYPTTION_WASTAGE_SIZE, AEAD_ENCRYPTTION_WASTAGE_SIZE) : ENCRYPTTION_WASTAGE_SIZE;
+
+		packetMaxSize_ = isTCPPacket_ ? (int)(TCPPacket::maxBufferSize() - wastage) :
+			(PACKET_MAX_SIZE_UDP - wastage);
 
 		packetMaxSize_ -= packetMaxSize_ % KBEngine::KBEBlowfish::BLOCK_SIZE;
 	}
@@ -177,8 +181,10 @@ int32 Bundle::onPacketAppend(int32 addsize, bool inseparable)
 		newPacket();
 	}
 
-	int32 totalsize = (int32)pCurrPacket_->length();
-	int32 fwpos = (int32)pCurrPacket_->wpos();
+	// Ƿ񻻰ʣռ䶼wpos㣬 appendPacketϵİrpos֮ǰмܰͷĿռ䣬
+	// length()Сwpos ʣռ䰴length()дpacketMaxSize_
+	int32 currwpos = (int32)pCurrPacket_->wpos();
+	int32 fwpos = currwpos;
 
 	if(inseparable)
 		fwpos += addsize;
@@ -189,10 +195,10 @@ int32 Bundle::onPacketAppend(int32 addsize, bool inseparable)
 		packets_.push_back(pCurrPacket_);
 		currMsgPacketCount_++;
 		newPacket();
-		totalsize = 0;
+		currwpos = 0;
 	}
 
-	int32 remainsize = packetMaxSize_ - totalsize;
+	int32 remainsize = packetMaxSize_ - currwpos;
 	int32 taddsize = addsize;
 
 	// ǰʣռСҪӵֽ򱾴˰
@@ -211,6 +217,25 @@ Packet* Bundle::newPacket()
 	return pCurrPacket_;
 }
 
+//-------------------------------------------------------------------------------------
+void Bundle::appendPacket(Packet* pPacket)
+{
+	// ǰϢѾ Ϣ޷ȷİ
+	KBE_ASSERT(currMsgID_ == 0);
+
+	if (pCurrPacket_ != NULL)
+	{
+		if (pCurrPacket_->length() > 0)
+			packets_.push_back(pCurrPacket_);
+		else
+			RECLAIM_PACKET(isTCPPacket_, pCurrPacket_);
+	}
+
+	pPacket->pBundle(this);
+	pCurrPacket_ = pPacket;
+	++numMessages_;
+}
+
 //-------------------------------------------------------------------------------------
 void Bundle::clear(bool isRecl)
 {
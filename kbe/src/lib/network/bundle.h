@@ -127,6 +127,12 @@ public:
 	INLINE void finiCurrPacket();
 
 	Packet* newPacket();
+
+	/**
+		һѾϢİֱӹҵbundleϣ ݣ bundleӹ
+		Чݴrposʼ ֮дbundleϢ׷
+	*/
+	void appendPacket(Packet* pPacket);
 	
 	INLINE void pChannel(Channel* p);
 	INLINE Channel* pChannel();
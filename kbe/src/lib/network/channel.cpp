@@ -18,6 +18,7 @@
 #include "network/kcp_packet_sender.h"
 #include "network/kcp_packet_receiver.h"
 #include "network/kcp_packet_reader.h"
+#include "network/kcp_scheduler.h"
 #include "network/tcp_packet.h"
 #include "network/udp_packet.h"
 #include "network/message_handler.h"
@@ -51,8 +52,8 @@ void Channel::reclaimPoolObject(Channel* obj)
 //-------------------------------------------------------------------------------------
 void Channel::destroyObjPool()
 {
-	DEBUG_MSG(fmt::format("Channel::destroyObjPool(): size {}.\n", 
-		_g_objPool.size()));
+	DEBUG_FMT("Channel::destroyObjPool(): size {}.\n", 
+		_g_objPool.size());
 
 	_g_objPool.destroy();
 }
@@ -66,7 +67,8 @@ size_t Channel::getPoolObjectBytes()
 		+ sizeof(flags_) + sizeof(numPacketsSent_) + sizeof(numPacketsReceived_) + sizeof(numBytesSent_) + sizeof(numBytesReceived_)
 		+ sizeof(lastTickBytesReceived_) + sizeof(lastTickBytesSent_) + sizeof(pFilter_) + sizeof(pEndPoint_) + sizeof(pPacketReceiver_) + sizeof(pPacketSender_)
 		+ sizeof(proxyID_) + strextra_.size() + sizeof(channelType_)
-		+ sizeof(componentID_) + sizeof(pMsgHandlers_) + condemnReason_.size() + sizeof(kcpUpdateTimerHandle_) + sizeof(pKCP_) + sizeof(hasSetNextKcpUpdate_);
+		+ sizeof(componentID_) + sizeof(pMsgHandlers_) + condemnReason_.size() + sizeof(kcpUpdateTimerHandle_) + sizeof(pKCP_) + sizeof(hasSetNextKcpUpdate_)
+		+ sizeof(kcpSlot_) + sizeof(kcpSlotIndex_) + sizeof(kcpDueTime_);
 
 	return bytes;
 }
@@ -123,6 +125,9 @@ Channel::Channel(NetworkInterface & networkInterface,
 	pKCP_(NULL),
 	kcpUpdateTimerHandle_(),
 	hasSetNextKcpUpdate_(false),
+	kcpSlot_(KCPScheduler::SLOT_NONE),
+	kcpSlotIndex_(0),
+	kcpDueTime_(0),
 	condemnReason_()
 {
 	this->clearBundle();
@@ -162,6 +167,9 @@ Channel::Channel():
 	pKCP_(NULL),
 	kcpUpdateTimerHandle_(),
 	hasSetNextKcpUpdate_(false),
+	kcpSlot_(KCPScheduler::SLOT_NONE),
+	kcpSlotIndex_(0),
+	kcpDueTime_(0),
 	condemnReason_()
 {
 	this->clearBundle();
@@ -392,12 +400,16 @@ bool Channel::fina_kcp()
 	if (!pKCP_)
 		return true;
 
+	KCPPacketSender::discardGather(this);
 	ikcp_release(pKCP_);
 	pKCP_ = NULL;
 
 	if (kcpUpdateTimerHandle_.isSet())
 		kcpUpdateTimerHandle_.cancel();
 
+	if (pNetworkInterface_ && kcpSlot_ != KCPScheduler::SLOT_NONE)
+		pNetworkInterface_->kcpScheduler().deregister(this);
+
 	hasSetNextKcpUpdate_ = false;
 	return true;
 }
@@ -406,7 +418,7 @@ bool Channel::fina_kcp()
 void Channel::kcp_writeLog(const char *log, struct IKCPCB *kcp, void *user)
 {
 	Channel* pChannel = (Channel*)user;
-	DEBUG_MSG(fmt::format("Channel::kcp_writeLog: {}, addr={}\n", log, pChannel->c_str()));
+	DEBUG_FMT("Channel::kcp_writeLog: {}, addr={}\n", log, pChannel->c_str());
 }
 
 //-------------------------------------------------------------------------------------
@@ -425,6 +437,13 @@ void Channel::addKcpUpdate(int64 microseconds)
 {
 	//AUTO_SCOPED_PROFILE("addKcpUpdate");
 
+	// ɵͳһ£ ΪÿͨӶʱ
+	if (g_rudp_sharedUpdate)
+	{
+		pNetworkInterface_->kcpScheduler().schedule(this, (uint32)(microseconds / 1000));
+		return;
+	}
+
 	if (microseconds <= 1)
 	{
 		// sendȲ¶Ӻȡtimer
@@ -452,7 +471,12 @@ void Channel::kcpUpdate()
 	//AUTO_SCOPED_PROFILE("kcpUpdate");
 
 	uint32 current = kbe_clock();
+
+	// updateݱϲ
+	KCPPacketSender::beginGather();
 	ikcp_update(pKCP_, current);
+	KCPPacketSender::endGather();
+	++g_kcpUpdates;
 
 	uint32 nextUpdateKcpTime = ikcp_check(pKCP_, current) - current;
 
@@ -785,6 +809,13 @@ void Channel::send(Bundle* pBundle)
 	if (bundleSize == 0)
 		return;
 
+	// ˲зͼʱⲿֻͨŶӣ DelayedChannelsڱֽʱͳһܲ
+	if (g_sendEncryptThreads > 0 && pFilter_ && isExternal() && !pNetworkInterface_->isFlushingDelayedChannels())
+	{
+		delayedSend();
+		return;
+	}
+
 	if (!sending())
 	{
 		if (pPacketSender_ == NULL)
@@ -824,8 +855,8 @@ void Channel::sendCheck(uint32 bundleSize)
 	{
 		if (Network::g_sendWindowMessagesOverflowCritical > 0 && bundleSize > Network::g_sendWindowMessagesOverflowCritical)
 		{
-			WARNING_MSG(fmt::format("Channel::sendCheck[{:p}]: external channel({}), send-window bufferedMessages has overflowed({} > {}).\n",
-				(void*)this, this->c_str(), bundleSize, Network::g_sendWindowMessagesOverflowCritical));
+			WARNING_FMT("Channel::sendCheck[{:p}]: external channel({}), send-window bufferedMessages has overflowed({} > {}).\n",
+				(void*)this, this->c_str(), bundleSize, Network::g_sendWindowMessagesOverflowCritical);
 
 			if (Network::g_extSendWindowMessagesOverflow > 0 &&
 				bundleSize >  Network::g_extSendWindowMessagesOverflow)
@@ -863,8 +894,8 @@ void Channel::sendCheck(uint32 bundleSize)
 			}
 			else
 			{
-				WARNING_MSG(fmt::format("Channel::sendCheck[{:p}]: internal channel({}), send-window bufferedMessages has overflowed({} > {}).\n",
-					(void*)this, this->c_str(), bundleSize, Network::g_sendWindowMessagesOverflowCritical));
+				WARNING_FMT("Channel::sendCheck[{:p}]: internal channel({}), send-window bufferedMessages has overflowed({} > {}).\n",
+					(void*)this, this->c_str(), bundleSize, Network::g_sendWindowMessagesOverflowCritical);
 			}
 		}
 
@@ -873,8 +904,8 @@ void Channel::sendCheck(uint32 bundleSize)
 			uint32 bundleBytes = bundlesLength();
 			if (bundleBytes >= g_intSendWindowBytesOverflow)
 			{
-				WARNING_MSG(fmt::format("Channel::sendCheck[{:p}]: internal channel({}), bufferedBytes has overflowed({} > {}).\n",
-					(void*)this, this->c_str(), bundleBytes, g_intSendWindowBytesOverflow));
+				WARNING_FMT("Channel::sendCheck[{:p}]: internal channel({}), bufferedBytes has overflowed({} > {}).\n",
+					(void*)this, this->c_str(), bundleBytes, g_intSendWindowBytesOverflow);
 			}
 		}
 	}
@@ -941,8 +972,8 @@ void Channel::onPacketSent(int bytes, bool sentCompleted)
 		if(g_intSentWindowBytesOverflow > 0 && 
 			lastTickBytesSent_ >= g_intSentWindowBytesOverflow)
 		{
-			WARNING_MSG(fmt::format("Channel::onPacketSent[{:p}]: internal channel({}), sentBytes has overflowed({} > {}).\n", 
-				(void*)this, this->c_str(), lastTickBytesSent_, g_intSentWindowBytesOverflow));
+			WARNING_FMT("Channel::onPacketSent[{:p}]: internal channel({}), sentBytes has overflowed({} > {}).\n", 
+				(void*)this, this->c_str(), lastTickBytesSent_, g_intSentWindowBytesOverflow);
 		}
 	}
 }
@@ -977,8 +1008,8 @@ void Channel::onPacketReceived(int bytes)
 		if(g_intReceiveWindowBytesOverflow > 0 && 
 			lastTickBytesReceived_ >= g_intReceiveWindowBytesOverflow)
 		{
-			WARNING_MSG(fmt::format("Channel::onPacketReceived[{:p}]: internal channel({}), bufferedBytes has overflowed({} > {}).\n", 
-				(void*)this, this->c_str(), lastTickBytesReceived_, g_intReceiveWindowBytesOverflow));
+			WARNING_FMT("Channel::onPacketReceived[{:p}]: internal channel({}), bufferedBytes has overflowed({} > {}).\n", 
+				(void*)this, this->c_str(), lastTickBytesReceived_, g_intReceiveWindowBytesOverflow);
 		}
 	}
 }
@@ -1002,8 +1033,8 @@ void Channel::addReceiveWindow(Packet* pPacket)
 			}
 			else
 			{
-				WARNING_MSG(fmt::format("Channel::addReceiveWindow[{:p}]: external channel({}), receive window has overflowed({} > {}).\n", 
-					(void*)this, this->c_str(), lastTickBufferedReceives_, Network::g_receiveWindowMessagesOverflowCritical));
+				WARNING_FMT("Channel::addReceiveWindow[{:p}]: external channel({}), receive window has overflowed({} > {}).\n", 
+					(void*)this, this->c_str(), lastTickBufferedReceives_, Network::g_receiveWindowMessagesOverflowCritical);
 			}
 		}
 		else
@@ -1011,8 +1042,8 @@ void Channel::addReceiveWindow(Packet* pPacket)
 			if(Network::g_intReceiveWindowMessagesOverflow > 0 && 
 				lastTickBufferedReceives_ > Network::g_intReceiveWindowMessagesOverflow)
 			{
-				WARNING_MSG(fmt::format("Channel::addReceiveWindow[{:p}]: internal channel({}), receive window has overflowed({} > {}).\n", 
-					(void*)this, this->c_str(), lastTickBufferedReceives_, Network::g_intReceiveWindowMessagesOverflow));
+				WARNING_FMT("Channel::addReceiveWindow[{:p}]: internal channel({}), receive window has overflowed({} > {}).\n", 
+					(void*)this, this->c_str(), lastTickBufferedReceives_, Network::g_intReceiveWindowMessagesOverflow);
 			}
 		}
 	}
@@ -1031,6 +1062,10 @@ void Channel::condemn(const std::string& reason, bool waitSendCompletedDestroy)
 	if (condemnReason_.size() == 0)
 		condemnReason_ = reason;
 
+	// ȴʱ Ȱѻӳٶеݷȥ ֮sendΪͨ
+	if (waitSendCompletedDestroy && condemn() == 0 && !isDestroyed() && pNetworkInterface_)
+		pNetworkInterface_->sendIfDelayed(*this);
+
 	flags_ |= (waitSendCompletedDestroy ? FLAG_CONDEMN_AND_WAIT_DESTROY : FLAG_CONDEMN);
 }
 
@@ -1077,14 +1112,14 @@ bool Channel::handshake(Packet* pPacket)
 				}
 
 				pFilter_ = new WebSocketPacketFilter(this);
-				DEBUG_MSG(fmt::format("Channel::handshake: websocket({}) successfully!\n", this->c_str()));
+				DEBUG_FMT("Channel::handshake: websocket({}) successfully!\n", this->c_str());
 
 				// ζtrueֱֳɹ
 				return true;
 			}
 			else
 			{
-				DEBUG_MSG(fmt::format("Channel::handshake: websocket({}) error!\n", this->c_str()));
+				DEBUG_FMT("Channel::handshake: websocket({}) error!\n", this->c_str());
 			}
 		}
 	}
@@ -1115,7 +1150,7 @@ bool Channel::handshake(Packet* pPacket)
 					pPacketReader_ = new KCPPacketReader(this);
 				}
 
-				DEBUG_MSG(fmt::format("Channel::handshake: kcp({}) successfully!\n", this->c_str()));
+				DEBUG_FMT("Channel::handshake: kcp({}) successfully!\n", this->c_str());
 				flags_ |= FLAG_HANDSHAKE;
 			}
 
@@ -1182,12 +1217,12 @@ void Channel::processPackets(KBEngine::Network::MessageHandlers* pMsgHandlers, P
 	catch(MemoryStreamException &)
 	{
 		Network::MessageHandler* pMsgHandler = pMsgHandlers->find(pPacketReader_->currMsgID());
-		WARNING_MSG(fmt::format("Channel::processPackets({}): packet invalid. currMsg=({}, id={}, len={}), currMsgLen={}\n",
+		WARNING_FMT("Channel::processPackets({}): packet invalid. currMsg=({}, id={}, len={}), currMsgLen={}\n",
 			this->c_str()
 			, (pMsgHandler == NULL ? "unknown" : pMsgHandler->name) 
 			, pPacketReader_->currMsgID() 
 			, (pMsgHandler == NULL ? -1 : pMsgHandler->msgLen) 
-			, pPacketReader_->currMsgLen()));
+			, pPacketReader_->currMsgLen());
 
 		pPacketReader_->currMsgID(0);
 		pPacketReader_->currMsgLen(0);
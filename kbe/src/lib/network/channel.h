@@ -31,6 +31,8 @@ class PacketSender;
 
 class Channel : public TimerHandler, public PoolObject
 {
+	friend class KCPScheduler;
+
 public:
 	typedef KBEShared_ptr< SmartPoolObject< Channel > > SmartPoolObjectPtr;
 	static SmartPoolObjectPtr createSmartPoolObj(const std::string& logPoint);
@@ -309,6 +311,11 @@ private:
 	TimerHandle					kcpUpdateTimerHandle_;
 	bool						hasSetNextKcpUpdate_;
 
+	// KCPSchedulerʱеλ뵽ʱ(kbe_clock)
+	int32						kcpSlot_;
+	uint32						kcpSlotIndex_;
+	uint32						kcpDueTime_;
+
 	std::string					condemnReason_;
 };
 
@@ -25,6 +25,18 @@ int8 g_channelExternalEncryptType = 0;
 
 uint32 g_SOMAXCONN = 5;
 
+uint32 g_pollerMaxEvents = 256;
+bool g_pollerEdgeTriggered = false;
+
+bool g_timingWheel = false;
+uint32 g_timingWheelResolution = 1000;
+
+bool g_vectoredSend = true;
+
+uint32 g_recvBatchSize = 0;
+
+uint32 g_sendEncryptThreads = 0;
+
 // UDP
 uint32						g_rudp_intWritePacketsQueueSize = 65535;
 uint32						g_rudp_intReadPacketsQueueSize = 65535;
@@ -36,6 +48,7 @@ uint32						g_rudp_missAcksResend = 1;
 uint32						g_rudp_mtu = 0;
 bool						g_rudp_congestionControl = false;
 bool						g_rudp_nodelay = true;
+bool						g_rudp_sharedUpdate = true;
 
 const char*					UDP_HELLO = "62a559f3fa7748bc22f8e0766019d498";
 const char*					UDP_HELLO_ACK = "1432ad7c829170a76dd31982c3501eca";
@@ -45,6 +58,31 @@ uint64						g_numPacketsSent = 0;
 uint64						g_numPacketsReceived = 0;
 uint64						g_numBytesSent = 0;
 uint64						g_numBytesReceived = 0;
+uint64						g_numSendSyscalls = 0;
+
+uint64						g_udpRecvSyscalls = 0;
+uint64						g_udpRecvDatagrams = 0;
+
+uint64						g_pollerWaits = 0;
+uint64						g_pollerEvents = 0;
+uint64						g_pollerFullWaits = 0;
+uint64						g_pollerWaitsLastTick = 0;
+uint64						g_pollerEventsLastTick = 0;
+
+uint64						g_sendEncryptFlushes = 0;
+uint64						g_sendEncryptPackets = 0;
+uint64						g_sendEncryptFlushTime = 0;
+uint64						g_sendEncryptWaitTime = 0;
+std::vector<uint32>			g_sendEncryptQueueDepths;
+
+uint64						g_kcpUpdates = 0;
+uint64						g_kcpSchedulerPasses = 0;
+uint32						g_kcpSchedulerPassUpdatesLast = 0;
+uint32						g_kcpSchedulerPassUpdatesMax = 0;
+uint64						g_kcpSchedulerPassTime = 0;
+uint64						g_kcpSchedulerPassTimeLast = 0;
+uint64						g_kcpSchedulerPassTimeMax = 0;
+uint64						g_kcpSchedulerDatagrams = 0;
 
 uint32						g_receiveWindowMessagesOverflowCritical = 32;
 uint32						g_intReceiveWindowMessagesOverflow = 65535;
@@ -70,12 +108,141 @@ uint32						g_extReSendRetries = 3;
 std::string					g_sslCertificate = "";
 std::string					g_sslPrivateKey = "";
 
+static uint64 sendBytesPerSyscall()
+{
+	return g_numSendSyscalls > 0 ? g_numBytesSent / g_numSendSyscalls : 0;
+}
+
+static uint64 sendSyscallsPerMB()
+{
+	return g_numBytesSent > 0 ? g_numSendSyscalls * 1024 * 1024 / g_numBytesSent : 0;
+}
+
+static uint64 udpDatagramsPerSyscall()
+{
+	return g_udpRecvSyscalls > 0 ? g_udpRecvDatagrams / g_udpRecvSyscalls : 0;
+}
+
+static uint64 udpDatagramsPerSecond()
+{
+	// βѯ֮ƽֵ ѹʱڲѯɵõÿհ
+	static uint64 lastStamp = timestamp();
+	static uint64 lastDatagrams = g_udpRecvDatagrams;
+
+	uint64 now = timestamp();
+	uint64 elapsed = now - lastStamp;
+	if (elapsed == 0)
+		return 0;
+
+	uint64 datagrams = g_udpRecvDatagrams - lastDatagrams;
+	lastStamp = now;
+	lastDatagrams = g_udpRecvDatagrams;
+
+	return (uint64)(datagrams * stampsPerSecondD() / elapsed);
+}
+
+static uint64 pollerEventsPerWait()
+{
+	return g_pollerWaits > 0 ? g_pollerEvents / g_pollerWaits : 0;
+}
+
+static uint64 kcpUpdatesPerPass()
+{
+	return g_kcpSchedulerPasses > 0 ? g_kcpUpdates / g_kcpSchedulerPasses : 0;
+}
+
+static uint64 kcpSchedulerPassTimeAvg()
+{
+	return g_kcpSchedulerPasses > 0 ? g_kcpSchedulerPassTime / g_kcpSchedulerPasses : 0;
+}
+
+static uint64 kcpUpdatesPerSecond()
+{
+	// βѯ֮ƽֵ
+	static uint64 lastStamp = timestamp();
+	static uint64 lastUpdates = g_kcpUpdates;
+
+	uint64 now = timestamp();
+	uint64 elapsed = now - lastStamp;
+	if (elapsed == 0)
+		return 0;
+
+	uint64 updates = g_kcpUpdates - lastUpdates;
+	lastStamp = now;
+	lastUpdates = g_kcpUpdates;
+
+	return (uint64)(updates * stampsPerSecondD() / elapsed);
+}
+
+static std::string sendEncryptQueueDepths()
+{
+	// һˢʱÿƬ(һ̴߳)ֵİ
+	std::string ret;
+
+	for (size_t i = 0; i < g_sendEncryptQueueDepths.size(); ++i)
+	{
+		if (i > 0)
+			ret += ", ";
+
+		ret += fmt::format("{}", g_sendEncryptQueueDepths[i]);
+	}
+
+	return ret;
+}
+
+void updatePollerTickStats()
+{
+	static uint64 lastWaits = 0;
+	static uint64 lastEvents = 0;
+
+	g_pollerWaitsLastTick = g_pollerWaits - lastWaits;
+	g_pollerEventsLastTick = g_pollerEvents - lastEvents;
+	lastWaits = g_pollerWaits;
+	lastEvents = g_pollerEvents;
+}
+
 bool initializeWatcher()
 {
 	WATCH_OBJECT("network/numPacketsSent", g_numPacketsSent);
 	WATCH_OBJECT("network/numPacketsReceived", g_numPacketsReceived);
 	WATCH_OBJECT("network/numBytesSent", g_numBytesSent);
 	WATCH_OBJECT("network/numBytesReceived", g_numBytesReceived);
+	WATCH_OBJECT("network/vectoredSend", g_vectoredSend);
+	WATCH_OBJECT("network/numSendSyscalls", g_numSendSyscalls);
+	WATCH_OBJECT("network/sendBytesPerSyscall", &sendBytesPerSyscall);
+	WATCH_OBJECT("network/sendSyscallsPerMB", &sendSyscallsPerMB);
+	WATCH_OBJECT("network/udp/recvBatchSize", g_recvBatchSize);
+	WATCH_OBJECT("network/udp/recvSyscalls", g_udpRecvSyscalls);
+	WATCH_OBJECT("network/udp/recvDatagrams", g_udpRecvDatagrams);
+	WATCH_OBJECT("network/udp/datagramsPerSyscall", &udpDatagramsPerSyscall);
+	WATCH_OBJECT("network/udp/datagramsPerSecond", &udpDatagramsPerSecond);
+	WATCH_OBJECT("network/poller/maxEvents", g_pollerMaxEvents);
+	WATCH_OBJECT("network/poller/edgeTriggered", g_pollerEdgeTriggered);
+	WATCH_OBJECT("network/poller/waits", g_pollerWaits);
+	WATCH_OBJECT("network/poller/events", g_pollerEvents);
+	WATCH_OBJECT("network/poller/fullWaits", g_pollerFullWaits);
+	WATCH_OBJECT("network/poller/eventsPerWait", &pollerEventsPerWait);
+	WATCH_OBJECT("network/poller/waitsLastTick", g_pollerWaitsLastTick);
+	WATCH_OBJECT("network/poller/eventsLastTick", g_pollerEventsLastTick);
+	WATCH_OBJECT("network/timers/timingWheel", g_timingWheel);
+	WATCH_OBJECT("network/timers/timingWheelResolution", g_timingWheelResolution);
+	WATCH_OBJECT("network/sendEncrypt/threads", g_sendEncryptThreads);
+	WATCH_OBJECT("network/sendEncrypt/flushes", g_sendEncryptFlushes);
+	WATCH_OBJECT("network/sendEncrypt/packets", g_sendEncryptPackets);
+	WATCH_OBJECT("network/sendEncrypt/flushTime", g_sendEncryptFlushTime);
+	WATCH_OBJECT("network/sendEncrypt/waitTime", g_sendEncryptWaitTime);
+	WATCH_OBJECT("network/sendEncrypt/queueDepths", &sendEncryptQueueDepths);
+	WATCH_OBJECT("network/kcp/sharedUpdate", g_rudp_sharedUpdate);
+	WATCH_OBJECT("network/kcp/updates", g_kcpUpdates);
+	WATCH_OBJECT("network/kcp/updatesPerSecond", &kcpUpdatesPerSecond);
+	WATCH_OBJECT("network/kcp/scheduler/passes", g_kcpSchedulerPasses);
+	WATCH_OBJECT("network/kcp/scheduler/updatesPerPass", &kcpUpdatesPerPass);
+	WATCH_OBJECT("network/kcp/scheduler/passUpdatesLast", g_kcpSchedulerPassUpdatesLast);
+	WATCH_OBJECT("network/kcp/scheduler/passUpdatesMax", g_kcpSchedulerPassUpdatesMax);
+	WATCH_OBJECT("network/kcp/scheduler/passTimeAvg", &kcpSchedulerPassTimeAvg);
+	WATCH_OBJECT("network/kcp/scheduler/passTimeLast", g_kcpSchedulerPassTimeLast);
+	WATCH_OBJECT("network/kcp/scheduler/passTimeMax", g_kcpSchedulerPassTimeMax);
+	WATCH_OBJECT("network/kcp/scheduler/datagrams", g_kcpSchedulerDatagrams);
 	
 	std::vector<MessageHandlers*>::iterator iter = MessageHandlers::messageHandlers().begin();
 	for(; iter != MessageHandlers::messageHandlers().end(); ++iter)
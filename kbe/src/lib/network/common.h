@@ -34,12 +34,29 @@ extern uint32 g_intReSendRetries;
 extern uint32 g_extReSendInterval;
 extern uint32 g_extReSendRetries;
 
-// ⲿͨ
+// ⲿͨ(0: ܣ 1: Blowfish 3: AES-256-GCM 4: ChaCha20-Poly1305)
 extern int8 g_channelExternalEncryptType;
 
 // listenֵ
 extern uint32 g_SOMAXCONN;
 
+// ¼ѯ һȡص¼ԼܹһζݵͨǷʹñԵ(ֻepollЧ)
+extern uint32 g_pollerMaxEvents;
+extern bool g_pollerEdgeTriggered;
+
+// EventDispatcherServerAppϷʱ䶨ʱǷʹ÷ֲʱ֣ ԼEventDispatcherʱֵľ(΢)
+extern bool g_timingWheel;
+extern uint32 g_timingWheelResolution;
+
+// ʱͨд͵İϲΪһϵͳ(tcp: writev kcp: sendmmsg ֻlinuxЧ)
+extern bool g_vectoredSend;
+
+// udpÿͨrecvmmsgյݱ Сڵ1recvfrom(ֻlinuxЧ)
+extern uint32 g_recvBatchSize;
+
+// ⲿͨĲзͼܹ߳ 0Ϊر(ڵǰ߳ܲ)
+extern uint32 g_sendEncryptThreads;
+
 // udpְ
 extern const char* UDP_HELLO;
 extern const char* UDP_HELLO_ACK;
@@ -56,6 +73,9 @@ extern uint32 g_rudp_missAcksResend;
 extern bool g_rudp_congestionControl;
 extern bool g_rudp_nodelay;
 
+// NetworkInterfaceϵKCPSchedulerͳһkcpͨ falseÿͨʹԼĶʱ
+extern bool g_rudp_sharedUpdate;
+
 // Certificate file required for HTTPS/WSS/SSL communication
 extern std::string g_sslCertificate;
 extern std::string g_sslPrivateKey;
@@ -76,6 +96,9 @@ namespace tcp{
 // ܶ洢Ϣռֽ(+)
 #define ENCRYPTTION_WASTAGE_SIZE			(1 + 7)
 
+// AEADܶ洢Ϣռֽ(֤ǩ)
+#define AEAD_ENCRYPTTION_WASTAGE_SIZE		16
+
 #define PACKET_MAX_SIZE						1500
 #ifndef PACKET_MAX_SIZE_TCP
 #define PACKET_MAX_SIZE_TCP					1460
@@ -404,6 +427,37 @@ extern uint64						g_numPacketsSent;
 extern uint64						g_numPacketsReceived;
 extern uint64						g_numBytesSent;
 extern uint64						g_numBytesReceived;
+extern uint64						g_numSendSyscalls;
+
+// udpͳ
+extern uint64						g_udpRecvSyscalls;
+extern uint64						g_udpRecvDatagrams;
+
+// ¼ѯͳ
+extern uint64						g_pollerWaits;
+extern uint64						g_pollerEvents;
+extern uint64						g_pollerFullWaits;
+extern uint64						g_pollerWaitsLastTick;
+extern uint64						g_pollerEventsLastTick;
+
+void updatePollerTickStats();
+
+// зͼͳ
+extern uint64						g_sendEncryptFlushes;
+extern uint64						g_sendEncryptPackets;
+extern uint64						g_sendEncryptFlushTime;
+extern uint64						g_sendEncryptWaitTime;
+extern std::vector<uint32>			g_sendEncryptQueueDepths;
+
+// kcpͳ(passΪKCPSchedulerһͳһ£ ʱ䵥λΪ΢)
+extern uint64						g_kcpUpdates;
+extern uint64						g_kcpSchedulerPasses;
+extern uint32						g_kcpSchedulerPassUpdatesLast;
+extern uint32						g_kcpSchedulerPassUpdatesMax;
+extern uint64						g_kcpSchedulerPassTime;
+extern uint64						g_kcpSchedulerPassTimeLast;
+extern uint64						g_kcpSchedulerPassTimeMax;
+extern uint64						g_kcpSchedulerDatagrams;
 
 // մ
 extern uint32						g_receiveWindowMessagesOverflowCritical;
@@ -6,11 +6,27 @@
 #include "network/address.h"
 #include "network/event_dispatcher.h"
 #include "network/network_interface.h"
+#include "network/send_encrypt_stage.h"
 
 namespace KBEngine{
 namespace Network
 {
 
+//-------------------------------------------------------------------------------------
+DelayedChannels::DelayedChannels():
+channeladdrs_(),
+pNetworkInterface_(NULL),
+pSendEncryptStage_(NULL),
+flushing_(false)
+{
+}
+
+//-------------------------------------------------------------------------------------
+DelayedChannels::~DelayedChannels()
+{
+	SAFE_RELEASE(pSendEncryptStage_);
+}
+
 //-------------------------------------------------------------------------------------
 void DelayedChannels::init(EventDispatcher & dispatcher, NetworkInterface* pNetworkInterface)
 {
@@ -35,7 +51,10 @@ void DelayedChannels::sendIfDelayed(Channel & channel)
 {
 	if (channeladdrs_.erase(channel.addr()) > 0)
 	{
+		bool flushing = flushing_;
+		flushing_ = true;
 		channel.send();
+		flushing_ = flushing;
 	}
 }
 
@@ -44,13 +63,56 @@ bool DelayedChannels::process()
 {
 	if (channeladdrs_.size() > 0)
 	{
-		ChannelAddrs::iterator iter = channeladdrs_.begin();
+		// ͹¼ͨһִ
+		ChannelAddrs channeladdrs;
+		channeladdrs.swap(channeladdrs_);
+
+		ChannelAddrs::iterator iter = channeladdrs.begin();
+
+		// ̼߳ܵͨ Ƭ֮ǰܷ
+		std::set<Channel*> encryptingChannels;
+		std::vector<Channel*> readyChannels;
+		bool encrypting = false;
+
+		// ˲зͼʱ ɹ̰߳ⲿͨϴ͵İܺ
+		if (g_sendEncryptThreads > 0)
+		{
+			std::vector<Channel*> encryptChannels;
+
+			for (; iter != channeladdrs.end(); ++iter)
+			{
+				Channel * pChannel = pNetworkInterface_->findChannel((*iter));
 
-		while (iter != channeladdrs_.end())
+				if (pChannel && (pChannel->condemn() != Channel::FLAG_CONDEMN_AND_DESTROY && !pChannel->isDestroyed()) &&
+					pChannel->isExternal() && pChannel->pFilter() && pChannel->bundles().size() > 0)
+				{
+					encryptChannels.push_back(pChannel);
+				}
+			}
+
+			// ֻһͨʱֱsendмܼ
+			if (encryptChannels.size() > 1)
+			{
+				if (pSendEncryptStage_ == NULL)
+					pSendEncryptStage_ = new SendEncryptStage();
+
+				encrypting = pSendEncryptStage_->start(encryptChannels, readyChannels);
+				if (encrypting)
+					encryptingChannels.insert(encryptChannels.begin(), encryptChannels.end());
+			}
+
+			iter = channeladdrs.begin();
+		}
+
+		flushing_ = true;
+
+		// ̼߳ڼȷͨ
+		while (iter != channeladdrs.end())
 		{
 			Channel * pChannel = pNetworkInterface_->findChannel((*iter));
 
-			if (pChannel && (pChannel->condemn() != Channel::FLAG_CONDEMN_AND_DESTROY && !pChannel->isDestroyed()))
+			if (pChannel && encryptingChannels.find(pChannel) == encryptingChannels.end() &&
+				(pChannel->condemn() != Channel::FLAG_CONDEMN_AND_DESTROY && !pChannel->isDestroyed()))
 			{
 				pChannel->send();
 			}
@@ -58,7 +120,23 @@ bool DelayedChannels::process()
 			++iter;
 		}
 
-		channeladdrs_.clear();
+		// ߳ԼķƬѾɣ ֮ÿһƬͷһƬ
+		if (encrypting)
+		{
+			do
+			{
+				std::vector<Channel*>::iterator readyIter = readyChannels.begin();
+				for (; readyIter != readyChannels.end(); ++readyIter)
+				{
+					Channel * pChannel = (*readyIter);
+
+					if (pChannel->condemn() != Channel::FLAG_CONDEMN_AND_DESTROY && !pChannel->isDestroyed())
+						pChannel->send();
+				}
+			} while (pSendEncryptStage_->waitShard(readyChannels));
+		}
+
+		flushing_ = false;
 	}
 
 	return true;
@@ -14,10 +14,14 @@ class Channel;
 class Address;
 class EventDispatcher;
 class NetworkInterface;
+class SendEncryptStage;
 
 class DelayedChannels : public Task
 {
 public:
+	DelayedChannels();
+	virtual ~DelayedChannels();
+
 	void init(EventDispatcher & dispatcher, NetworkInterface* pNetworkInterface);
 	void fini(EventDispatcher & dispatcher);
 
@@ -25,6 +29,9 @@ public:
 
 	void sendIfDelayed(Channel & channel);
 
+	// ͳһʱͨsendӳ
+	bool flushing() const { return flushing_; }
+
 private:
 	virtual bool process();
 
@@ -32,6 +39,9 @@ private:
 	ChannelAddrs channeladdrs_;
 
 	NetworkInterface* pNetworkInterface_;
+
+	SendEncryptStage* pSendEncryptStage_;
+	bool flushing_;
 };
 
 }
@@ -9,6 +9,8 @@
 #include "network/network_interface.h"
 #include "network/packet_receiver.h"
 #include "network/packet_sender.h"
+#include "openssl/evp.h"
+#include "openssl/rand.h"
 
 namespace KBEngine { 
 namespace Network
@@ -58,24 +60,9 @@ Reason BlowfishFilter::send(Channel * pChannel, PacketSender& sender, Packet * p
 			return REASON_GENERAL_NETWORK;
 		}
 
-		Packet * pOutPacket = NULL;
-		MALLOC_PACKET(pOutPacket, pPacket->isTCPPacket());
-
-		PacketLength oldlen = (PacketLength)pPacket->length();
-		pOutPacket->wpos(PACKET_LENGTH_SIZE + 1);
-		encrypt(pPacket, pOutPacket);
-
-		PacketLength packetLen = (PacketLength)(pPacket->length() + 1);
-		uint8 padSize = (uint8)(pPacket->length() - oldlen);
-		size_t oldwpos =  pOutPacket->wpos();
-		pOutPacket->wpos(0);
-
-		(*pOutPacket) << packetLen;
-		(*pOutPacket) << padSize;
-
-		pOutPacket->wpos((int)oldwpos);
-		pPacket->swap(*(static_cast<KBEngine::MemoryStream*>(pOutPacket)));
-		RECLAIM_PACKET(pPacket->isTCPPacket(), pOutPacket);
+		PacketLength packetLen = 0;
+		uint8 padSize = 0;
+		encryptPacket(pPacket, packetLen, padSize);
 
 		if (Network::g_trace_packet > 0 && Network::g_trace_encrypted_packet)
 		{
@@ -106,6 +93,50 @@ Reason BlowfishFilter::send(Channel * pChannel, PacketSender& sender, Packet * p
 	return sender.processFilterPacket(pChannel, pPacket, userarg);
 }
 
+//-------------------------------------------------------------------------------------
+bool BlowfishFilter::prepareSend(Packet * pPacket)
+{
+	if (pPacket->encrypted() || !isGood_)
+		return false;
+
+	PacketLength packetLen = 0;
+	uint8 padSize = 0;
+	encryptPacket(pPacket, packetLen, padSize);
+	return true;
+}
+
+//-------------------------------------------------------------------------------------
+void BlowfishFilter::encryptPacket(Packet * pPacket, PacketLength& packetLen, uint8& padSize)
+{
+	PacketLength oldlen = (PacketLength)pPacket->length();
+
+	// ǰûͷĿռʱǰ룬 ȻԭؼܲѰͷдǰ
+	// ﲻʹðĶأ Ҳڹ߳е
+	if (pPacket->rpos() < PACKET_LENGTH_SIZE + 1)
+	{
+		uint8 head[PACKET_LENGTH_SIZE + 1] = { 0 };
+		size_t headSize = PACKET_LENGTH_SIZE + 1 - pPacket->rpos();
+
+		pPacket->insert(pPacket->rpos(), head, headSize);
+		pPacket->rpos((int)(pPacket->rpos() + headSize));
+	}
+
+	encrypt(pPacket, pPacket);
+
+	packetLen = (PacketLength)(pPacket->length() + 1);
+	padSize = (uint8)(pPacket->length() - oldlen);
+
+	size_t oldwpos = pPacket->wpos();
+	size_t headpos = pPacket->rpos() - PACKET_LENGTH_SIZE - 1;
+	pPacket->wpos((int)headpos);
+
+	(*pPacket) << packetLen;
+	(*pPacket) << padSize;
+
+	pPacket->wpos((int)oldwpos);
+	pPacket->rpos((int)headpos);
+}
+
 //-------------------------------------------------------------------------------------
 Reason BlowfishFilter::recv(Channel * pChannel, PacketReceiver & receiver, Packet * pPacket)
 {
@@ -273,23 +304,13 @@ void BlowfishFilter::encrypt(Packet * pInPacket, Packet * pOutPacket)
 	if(pInPacket != pOutPacket)
 	{
 		pOutPacket->data_resize(pInPacket->size() + pOutPacket->wpos());
-		int size = KBEBlowfish::encrypt(pInPacket->data(), pOutPacket->data() + pOutPacket->wpos(), (int)pInPacket->wpos());
+		int size = KBEBlowfish::encrypt(pInPacket->data() + pInPacket->rpos(), pOutPacket->data() + pOutPacket->wpos(), (int)pInPacket->length());
 		pOutPacket->wpos((int)(size + pOutPacket->wpos()));
 	}
 	else
 	{
-		if(pInPacket->isTCPPacket())
-			pOutPacket = TCPPacket::createPoolObject(OBJECTPOOL_POINT);
-		else
-			pOutPacket = UDPPacket::createPoolObject(OBJECTPOOL_POINT);
-
-		pOutPacket->data_resize(pInPacket->size() + 1);
-
-		int size = KBEBlowfish::encrypt(pInPacket->data(), pOutPacket->data() + pOutPacket->wpos(), (int)pInPacket->wpos());
-		pOutPacket->wpos(size);
-
-		pInPacket->swap(*(static_cast<KBEngine::MemoryStream*>(pOutPacket)));
-		RECLAIM_PACKET(pInPacket->isTCPPacket(), pOutPacket);
+		// ԭؼܣ Ҫİ
+		KBEBlowfish::encrypt(pInPacket->data() + pInPacket->rpos(), pInPacket->data() + pInPacket->rpos(), (int)pInPacket->length());
 	}
 
 	pInPacket->encrypted(true);
@@ -318,6 +339,619 @@ void BlowfishFilter::decrypt(Packet * pInPacket, Packet * pOutPacket)
 	}
 }
 
+//-------------------------------------------------------------------------------------
+AEADFilter::AEADFilter(int8 type, const std::string& key, bool isClient):
+type_(type),
+isGood_(false),
+pEncryptCtx_(NULL),
+pDecryptCtx_(NULL),
+sendDirection_(isClient ? 0 : 1),
+recvDirection_(isClient ? 1 : 0),
+sendSeq_(0),
+recvSeq_(0),
+pPacket_(NULL),
+packetLen_(0)
+{
+	isGood_ = init(key);
+}
+
+//-------------------------------------------------------------------------------------
+AEADFilter::~AEADFilter()
+{
+	if(pPacket_)
+	{
+		RECLAIM_PACKET(pPacket_->isTCPPacket(), pPacket_);
+		pPacket_ = NULL;
+	}
+
+	if (pEncryptCtx_)
+		EVP_CIPHER_CTX_free((EVP_CIPHER_CTX*)pEncryptCtx_);
+
+	if (pDecryptCtx_)
+		EVP_CIPHER_CTX_free((EVP_CIPHER_CTX*)pDecryptCtx_);
+
+	pEncryptCtx_ = NULL;
+	pDecryptCtx_ = NULL;
+}
+
+//-------------------------------------------------------------------------------------
+static const EVP_CIPHER* aeadCipher(int8 type)
+{
+	switch (type)
+	{
+	case 3:
+		return EVP_aes_256_gcm();
+#if OPENSSL_VERSION_NUMBER >= 0x10100000L && !defined(OPENSSL_NO_CHACHA) && !defined(OPENSSL_NO_POLY1305)
+	case 4:
+		return EVP_chacha20_poly1305();
+#endif
+	default:
+		break;
+	};
+
+	return NULL;
+}
+
+//-------------------------------------------------------------------------------------
+bool AEADFilter::isSupported(int8 type)
+{
+	return aeadCipher(type) != NULL;
+}
+
+//-------------------------------------------------------------------------------------
+bool AEADFilter::init(const std::string& key)
+{
+	const EVP_CIPHER* pCipher = aeadCipher(type_);
+	if (pCipher == NULL)
+	{
+		ERROR_MSG(fmt::format("AEADFilter::init: unsupported type {}\n", (int)type_));
+		return false;
+	}
+
+	if (key.size() != KEY_SIZE)
+	{
+		ERROR_MSG(fmt::format("AEADFilter::init: invalid key length {}\n", key.size()));
+		return false;
+	}
+
+	EVP_CIPHER_CTX* pEncryptCtx = EVP_CIPHER_CTX_new();
+	EVP_CIPHER_CTX* pDecryptCtx = EVP_CIPHER_CTX_new();
+	pEncryptCtx_ = pEncryptCtx;
+	pDecryptCtx_ = pDecryptCtx;
+
+	if (pEncryptCtx == NULL || pDecryptCtx == NULL)
+	{
+		ERROR_MSG("AEADFilter::init: EVP_CIPHER_CTX_new failed\n");
+		return false;
+	}
+
+	const unsigned char* pKey = (const unsigned char*)key.data();
+
+	// ԿֻһΣ ֮ÿֻnonce
+	if (EVP_EncryptInit_ex(pEncryptCtx, pCipher, NULL, NULL, NULL) != 1 ||
+		EVP_CIPHER_CTX_ctrl(pEncryptCtx, EVP_CTRL_GCM_SET_IVLEN, NONCE_SIZE, NULL) != 1 ||
+		EVP_EncryptInit_ex(pEncryptCtx, NULL, NULL, pKey, NULL) != 1 ||
+		EVP_DecryptInit_ex(pDecryptCtx, pCipher, NULL, NULL, NULL) != 1 ||
+		EVP_CIPHER_CTX_ctrl(pDecryptCtx, EVP_CTRL_GCM_SET_IVLEN, NONCE_SIZE, NULL) != 1 ||
+		EVP_DecryptInit_ex(pDecryptCtx, NULL, NULL, pKey, NULL) != 1)
+	{
+		ERROR_MSG(fmt::format("AEADFilter::init: init cipher(type={}) failed\n", (int)type_));
+		return false;
+	}
+
+	return true;
+}
+
+//-------------------------------------------------------------------------------------
+static void makeAEADNonce(uint8* nonce, uint32 direction, uint64 seq)
+{
+	for (int i = 0; i < 4; ++i)
+		nonce[i] = (uint8)(direction >> (i * 8));
+
+	for (int i = 0; i < 8; ++i)
+		nonce[4 + i] = (uint8)(seq >> (i * 8));
+}
+
+//-------------------------------------------------------------------------------------
+bool AEADFilter::seal(uint8 * data, int length, uint8 * tag)
+{
+	EVP_CIPHER_CTX* pCtx = (EVP_CIPHER_CTX*)pEncryptCtx_;
+
+	uint8 nonce[NONCE_SIZE];
+	makeAEADNonce(nonce, sendDirection_, sendSeq_++);
+
+	int outlen = 0;
+	int finlen = 0;
+
+	return EVP_EncryptInit_ex(pCtx, NULL, NULL, NULL, nonce) == 1 &&
+		EVP_EncryptUpdate(pCtx, data, &outlen, data, length) == 1 &&
+		EVP_EncryptFinal_ex(pCtx, data + outlen, &finlen) == 1 &&
+		EVP_CIPHER_CTX_ctrl(pCtx, EVP_CTRL_GCM_GET_TAG, TAG_SIZE, tag) == 1;
+}
+
+//-------------------------------------------------------------------------------------
+bool AEADFilter::open(uint8 * data, int length, const uint8 * tag)
+{
+	EVP_CIPHER_CTX* pCtx = (EVP_CIPHER_CTX*)pDecryptCtx_;
+
+	uint8 nonce[NONCE_SIZE];
+	makeAEADNonce(nonce, recvDirection_, recvSeq_++);
+
+	int outlen = 0;
+	int finlen = 0;
+
+	return EVP_DecryptInit_ex(pCtx, NULL, NULL, NULL, nonce) == 1 &&
+		EVP_DecryptUpdate(pCtx, data, &outlen, data, length) == 1 &&
+		EVP_CIPHER_CTX_ctrl(pCtx, EVP_CTRL_GCM_SET_TAG, TAG_SIZE, (void*)tag) == 1 &&
+		EVP_DecryptFinal_ex(pCtx, data + outlen, &finlen) == 1;
+}
+
+//-------------------------------------------------------------------------------------
+bool AEADFilter::encryptPacket(Packet * pPacket)
+{
+	// BlowfishFilterһԭؼܣ ʹðĶأ ڹ߳е
+	if (pPacket->rpos() < PACKET_LENGTH_SIZE)
+	{
+		uint8 head[PACKET_LENGTH_SIZE] = { 0 };
+		size_t headSize = PACKET_LENGTH_SIZE - pPacket->rpos();
+
+		pPacket->insert(pPacket->rpos(), head, headSize);
+		pPacket->rpos((int)(pPacket->rpos() + headSize));
+	}
+
+	int length = (int)pPacket->length();
+
+	if (pPacket->size() < pPacket->wpos() + TAG_SIZE)
+		pPacket->data_resize(pPacket->wpos() + TAG_SIZE);
+
+	if (!seal(pPacket->data() + pPacket->rpos(), length, pPacket->data() + pPacket->wpos()))
+		return false;
+
+	pPacket->wpos((int)(pPacket->wpos() + TAG_SIZE));
+
+	PacketLength packetLen = (PacketLength)(length + TAG_SIZE);
+	size_t oldwpos = pPacket->wpos();
+	size_t headpos = pPacket->rpos() - PACKET_LENGTH_SIZE;
+	pPacket->wpos((int)headpos);
+
+	(*pPacket) << packetLen;
+
+	pPacket->wpos((int)oldwpos);
+	pPacket->rpos((int)headpos);
+	pPacket->encrypted(true);
+	return true;
+}
+
+//-------------------------------------------------------------------------------------
+bool AEADFilter::prepareSend(Packet * pPacket)
+{
+	if (pPacket->encrypted() || !isGood_)
+		return false;
+
+	return encryptPacket(pPacket);
+}
+
+//-------------------------------------------------------------------------------------
+Reason AEADFilter::send(Channel * pChannel, PacketSender& sender, Packet * pPacket, int userarg)
+{
+	if(!pPacket->encrypted())
+	{
+		AUTO_SCOPED_PROFILE("encryptSend")
+
+		if (!isGood_ || !encryptPacket(pPacket))
+		{
+			WARNING_MSG(fmt::format("AEADFilter::send: "
+				"Dropping packet to {} due to invalid filter\n",
+				pChannel->addr().c_str()));
+
+			return REASON_GENERAL_NETWORK;
+		}
+
+		if (Network::g_trace_packet > 0 && Network::g_trace_encrypted_packet)
+		{
+			if (Network::g_trace_packet_use_logfile)
+				DebugHelper::getSingleton().changeLogger("packetlogs");
+
+			DEBUG_MSG(fmt::format("<==== AEADFilter::send: encryptedLen={}\n",
+				pPacket->length() - PACKET_LENGTH_SIZE));
+
+			switch (Network::g_trace_packet)
+			{
+			case 1:
+				pPacket->hexlike();
+				break;
+			case 2:
+				pPacket->textlike();
+				break;
+			default:
+				pPacket->print_storage();
+				break;
+			};
+
+			if (Network::g_trace_packet_use_logfile)
+				DebugHelper::getSingleton().changeLogger(COMPONENT_NAME_EX(g_componentType));
+		}
+	}
+
+	return sender.processFilterPacket(pChannel, pPacket, userarg);
+}
+
+//-------------------------------------------------------------------------------------
+Reason AEADFilter::recv(Channel * pChannel, PacketReceiver & receiver, Packet * pPacket)
+{
+	while(pPacket || pPacket_)
+	{
+		AUTO_SCOPED_PROFILE("encryptRecv")
+
+		if (!isGood_)
+		{
+			WARNING_MSG(fmt::format("AEADFilter::recv: "
+				"Dropping packet to {} due to invalid filter\n",
+				pChannel->addr().c_str()));
+
+			return REASON_GENERAL_NETWORK;
+		}
+
+		if(pPacket_)
+		{
+			if(pPacket)
+			{
+				pPacket_->append(pPacket->data() + pPacket->rpos(), pPacket->length());
+				RECLAIM_PACKET(pPacket->isTCPPacket(), pPacket);
+			}
+
+			pPacket = pPacket_;
+		}
+
+		if(packetLen_ <= 0)
+		{
+			// һͷʱһϲ
+			if(pPacket->length() < PACKET_LENGTH_SIZE)
+			{
+				if(pPacket_ == NULL)
+					pPacket_ = pPacket;
+
+				return receiver.processFilteredPacket(pChannel, NULL);
+			}
+
+			(*pPacket) >> packetLen_;
+
+			if(packetLen_ <= TAG_SIZE)
+				return onRecvError(pChannel, pPacket, fmt::format("invalid packet length {}", packetLen_));
+		}
+
+		// ̻ܣ жҪóһϲ
+		if(pPacket->length() > packetLen_)
+		{
+			MALLOC_PACKET(pPacket_, pPacket->isTCPPacket());
+			int currLen = pPacket->rpos() + packetLen_;
+			pPacket_->append(pPacket->data() + currLen, pPacket->wpos() - currLen);
+			pPacket->wpos(currLen);
+		}
+		else if(pPacket->length() == packetLen_)
+		{
+			if(pPacket_ != NULL && pPacket_ == pPacket)
+				pPacket_ = NULL;
+		}
+		else
+		{
+			if(pPacket_ == NULL)
+				pPacket_ = pPacket;
+
+			return receiver.processFilteredPacket(pChannel, NULL);
+		}
+
+		if(Network::g_trace_packet > 0 && Network::g_trace_encrypted_packet)
+		{
+			if(Network::g_trace_packet_use_logfile)
+				DebugHelper::getSingleton().changeLogger("packetlogs");
+
+			DEBUG_MSG(fmt::format("====> AEADFilter::recv: encryptedLen={}\n", packetLen_));
+
+			switch(Network::g_trace_packet)
+			{
+			case 1:
+				pPacket->hexlike();
+				break;
+			case 2:
+				pPacket->textlike();
+				break;
+			default:
+				pPacket->print_storage();
+				break;
+			};
+
+			if(Network::g_trace_packet_use_logfile)
+				DebugHelper::getSingleton().changeLogger(COMPONENT_NAME_EX(g_componentType));
+		}
+
+		packetLen_ = 0;
+
+		decrypt(pPacket, pPacket);
+
+		if (!isGood_)
+			return onRecvError(pChannel, pPacket, "authentication failed");
+
+		Reason ret = receiver.processFilteredPacket(pChannel, pPacket);
+		if(ret != REASON_SUCCESS)
+		{
+			if(pPacket_)
+			{
+				RECLAIM_PACKET(pPacket_->isTCPPacket(), pPacket_);
+				pPacket_ = NULL;
+			}
+
+			return ret;
+		}
+
+		pPacket = NULL;
+	}
+
+	return REASON_SUCCESS;
+}
+
+//-------------------------------------------------------------------------------------
+Reason AEADFilter::onRecvError(Channel * pChannel, Packet * pPacket, const std::string& reason)
+{
+	// ݱ۸ĻԶ˵İŲһ£ İ޷ٽܣ 沢رͨ
+	ERROR_MSG(fmt::format("AEADFilter::recv: {}, from {}\n", reason, pChannel->c_str()));
+
+	isGood_ = false;
+	packetLen_ = 0;
+
+	if (pPacket_ && pPacket_ != pPacket)
+		RECLAIM_PACKET(pPacket_->isTCPPacket(), pPacket_);
+
+	pPacket_ = NULL;
+
+	if (pPacket)
+		RECLAIM_PACKET(pPacket->isTCPPacket(), pPacket);
+
+	pChannel->condemn(fmt::format("AEADFilter::recv: {}", reason));
+	return REASON_GENERAL_NETWORK;
+}
+
+//-------------------------------------------------------------------------------------
+void AEADFilter::encrypt(Packet * pInPacket, Packet * pOutPacket)
+{
+	// ֤ǩ׷ĺ棬 Ҫ
+	size_t pos = pInPacket->rpos();
+	Packet * pPacket = pInPacket;
+
+	if(pInPacket != pOutPacket)
+	{
+		pos = pOutPacket->wpos();
+		pOutPacket->append(pInPacket->data() + pInPacket->rpos(), pInPacket->length());
+		pPacket = pOutPacket;
+	}
+
+	int length = (int)(pPacket->wpos() - pos);
+
+	if (pPacket->size() < pPacket->wpos() + TAG_SIZE)
+		pPacket->data_resize(pPacket->wpos() + TAG_SIZE);
+
+	if (!seal(pPacket->data() + pos, length, pPacket->data() + pPacket->wpos()))
+	{
+		isGood_ = false;
+		return;
+	}
+
+	pPacket->wpos((int)(pPacket->wpos() + TAG_SIZE));
+	pInPacket->encrypted(true);
+}
+
+//-------------------------------------------------------------------------------------
+void AEADFilter::decrypt(Packet * pInPacket, Packet * pOutPacket)
+{
+	// ֤ǩ ֤ʧʱʧЧ isGood
+	if (pInPacket->length() < TAG_SIZE)
+	{
+		isGood_ = false;
+		return;
+	}
+
+	Packet * pPacket = pInPacket;
+	if(pInPacket != pOutPacket)
+	{
+		pOutPacket->append(pInPacket->data() + pInPacket->rpos(), pInPacket->length());
+		pOutPacket->rpos((int)(pOutPacket->wpos() - pInPacket->length()));
+		pPacket = pOutPacket;
+	}
+
+	int length = (int)(pPacket->length() - TAG_SIZE);
+	uint8* pTag = pPacket->data() + pPacket->wpos() - TAG_SIZE;
+
+	if (!open(pPacket->data() + pPacket->rpos(), length, pTag))
+	{
+		isGood_ = false;
+		return;
+	}
+
+	pPacket->wpos((int)(pPacket->wpos() - TAG_SIZE));
+}
+
+//-------------------------------------------------------------------------------------
+std::string makeEncryptionKey(int8 type)
+{
+	if (type >= 3)
+	{
+		if (!AEADFilter::isSupported(type))
+		{
+			WARNING_MSG(fmt::format("makeEncryptionKey: encrypt type {} is not supported, using Blowfish\n", (int)type));
+		}
+		else
+		{
+			std::string key(ENCRYPTION_KEY_MAGIC, ENCRYPTION_KEY_MAGIC_SIZE);
+			key.push_back((char)type);
+
+			std::string aeadKey(AEADFilter::KEY_SIZE, 0);
+			RAND_bytes((unsigned char*)const_cast<char *>(aeadKey.data()), (int)aeadKey.size());
+
+			key += aeadKey;
+			return key;
+		}
+	}
+
+	KBEBlowfish blowfish;
+	return blowfish.key();
+}
+
+//-------------------------------------------------------------------------------------
+bool isAEADEncryptionKey(const std::string& datas)
+{
+	return datas.size() == ENCRYPTION_KEY_MAGIC_SIZE + 1 + AEADFilter::KEY_SIZE &&
+		datas.compare(0, ENCRYPTION_KEY_MAGIC_SIZE, ENCRYPTION_KEY_MAGIC) == 0;
+}
+
+//-------------------------------------------------------------------------------------
+int8 negotiateEncryptType(int8 type, const std::string& datas)
+{
+	if (type <= 0)
+		return 0;
+
+	// ΪAEADʱܿͻAEADʽ keyBlowfishkey
+	if (type >= 3 && isAEADEncryptionKey(datas))
+	{
+		int8 requestType = (int8)datas[ENCRYPTION_KEY_MAGIC_SIZE];
+		if (AEADFilter::isSupported(requestType))
+			return requestType;
+	}
+
+	return 1;
+}
+
+//-------------------------------------------------------------------------------------
+EncryptionFilter* createEncryptionFilter(int8 type, const std::string& datas)
+{
+	EncryptionFilter* pEncryptionFilter = NULL;
+	switch(type)
+	{
+	case 1:
+		pEncryptionFilter = new BlowfishFilter(datas);
+		break;
+	case 3:
+	case 4:
+		if (isAEADEncryptionKey(datas))
+		{
+			pEncryptionFilter = new AEADFilter(type, datas.substr(ENCRYPTION_KEY_MAGIC_SIZE + 1), 
+				g_componentType == CLIENT_TYPE || g_componentType == BOTS_TYPE);
+		}
+		break;
+	default:
+		break;
+	}
+
+	return pEncryptionFilter;
+}
+
+//-------------------------------------------------------------------------------------
+static double benchmarkEncryptionFilter(EncryptionFilter* pSender, EncryptionFilter* pReceiver, 
+	int8 type, size_t packetSize, uint32 megabytes, double& decryptMBps, bool& ok)
+{
+	size_t count = (size_t)megabytes * 1024 * 1024 / packetSize + 1;
+
+	std::string plain(packetSize, 0);
+	RAND_bytes((unsigned char*)const_cast<char *>(plain.data()), (int)plain.size());
+
+	Packet * pPacket = NULL;
+	MALLOC_PACKET(pPacket, true);
+
+	uint64 encryptStamps = 0;
+	uint64 decryptStamps = 0;
+	ok = true;
+
+	for (size_t i = 0; i < count; ++i)
+	{
+		pPacket->clear(false);
+		pPacket->encrypted(false);
+		pPacket->append(plain.data(), plain.size());
+
+		uint64 startTime = timestamp();
+		pSender->prepareSend(pPacket);
+		encryptStamps += timestamp() - startTime;
+
+		// ͷ Blowfishһ䳤
+		uint8 padSize = 0;
+		PacketLength packetLen = 0;
+		(*pPacket) >> packetLen;
+
+		if (type == 1)
+			(*pPacket) >> padSize;
+
+		startTime = timestamp();
+		pReceiver->decrypt(pPacket, pPacket);
+		decryptStamps += timestamp() - startTime;
+
+		pPacket->wpos((int)(pPacket->wpos() - padSize));
+
+		if (pPacket->length() != plain.size() || memcmp(pPacket->data() + pPacket->rpos(), plain.data(), plain.size()) != 0)
+			ok = false;
+	}
+
+	RECLAIM_PACKET(true, pPacket);
+
+	double bytes = (double)(count * packetSize) / (1024 * 1024);
+	decryptMBps = decryptStamps > 0 ? bytes * stampsPerSecondD() / decryptStamps : 0;
+	return encryptStamps > 0 ? bytes * stampsPerSecondD() / encryptStamps : 0;
+}
+
+//-------------------------------------------------------------------------------------
+bool benchmarkEncryptionFilters(uint32 megabytes, std::string& result)
+{
+	static const size_t packetSizes[] = { 64, 256, 512, 1400 };
+	static const int8 types[] = { 1, 3, 4 };
+
+	if (megabytes == 0)
+		megabytes = 1;
+
+	bool ret = true;
+
+	for (size_t t = 0; t < sizeof(types) / sizeof(types[0]); ++t)
+	{
+		int8 type = types[t];
+		if (type >= 3 && !AEADFilter::isSupported(type))
+			continue;
+
+		for (size_t s = 0; s < sizeof(packetSizes) / sizeof(packetSizes[0]); ++s)
+		{
+			std::string key = makeEncryptionKey(type);
+			EncryptionFilter* pSender = NULL;
+			EncryptionFilter* pReceiver = NULL;
+
+			if (type == 1)
+			{
+				pSender = new BlowfishFilter(key);
+				pReceiver = new BlowfishFilter(key);
+			}
+			else
+			{
+				std::string aeadKey = key.substr(ENCRYPTION_KEY_MAGIC_SIZE + 1);
+				pSender = new AEADFilter(type, aeadKey, false);
+				pReceiver = new AEADFilter(type, aeadKey, true);
+			}
+
+			pSender->incRef();
+			pReceiver->incRef();
+
+			double decryptMBps = 0;
+			bool ok = true;
+			double encryptMBps = benchmarkEncryptionFilter(pSender, pReceiver, type, packetSizes[s], megabytes, decryptMBps, ok);
+
+			if (!ok)
+				ret = false;
+
+			result += fmt::format("{}({}B): encrypt={:.1f}MB/s, decrypt={:.1f}MB/s{}\n", 
+				(type == 1 ? "blowfish" : (type == 3 ? "aes-256-gcm" : "chacha20-poly1305")),
+				packetSizes[s], encryptMBps, decryptMBps, (ok ? "" : ", MISMATCH"));
+
+			pSender->decRef();
+			pReceiver->decRef();
+		}
+	}
+
+	return ret;
+}
+
 //-------------------------------------------------------------------------------------
 
 } 
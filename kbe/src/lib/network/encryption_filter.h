@@ -37,9 +37,14 @@ public:
 
 	virtual Reason recv(Channel * pChannel, PacketReceiver & receiver, Packet * pPacket);
 
+	virtual bool prepareSend(Packet * pPacket);
+
 	void encrypt(Packet * pInPacket, Packet * pOutPacket);
 	void decrypt(Packet * pInPacket, Packet * pOutPacket);
+
 private:
+	void encryptPacket(Packet * pPacket, PacketLength& packetLen, uint8& padSize);
+
 	Packet * pPacket_;
 	Network::PacketLength packetLen_;
 	uint8 padSize_;
@@ -47,20 +52,83 @@ private:
 
 typedef SmartPointer<BlowfishFilter> BlowfishFilterPtr;
 
-inline EncryptionFilter* createEncryptionFilter(int8 type, const std::string& datas)
+/*
+	AEADܹ(AES-256-GCMChaCha20-Poly1305) ʹopensslEVPӿڣ Ӳ
+	ʽ: [PacketLength][][16ֽ֤ǩ] ĵȳҪ
+	nonceɷ(ͻ˵Ϊ0 ֮Ϊ1)ÿϵİɣ ڿɿĴ(tcp/kcp)
+*/
+class AEADFilter : public EncryptionFilter
 {
-	EncryptionFilter* pEncryptionFilter = NULL;
-	switch(type)
-	{
-	case 1:
-		pEncryptionFilter = new BlowfishFilter(datas);
-		break;
-	default:
-		break;
-	}
-
-	return pEncryptionFilter;
-}
+public:
+	static const int KEY_SIZE = 32;
+	static const int TAG_SIZE = 16;
+	static const int NONCE_SIZE = 12;
+
+	virtual ~AEADFilter();
+	AEADFilter(int8 type, const std::string& key, bool isClient);
+
+	static bool isSupported(int8 type);
+
+	virtual Reason send(Channel * pChannel, PacketSender& sender, Packet * pPacket, int userarg);
+
+	virtual Reason recv(Channel * pChannel, PacketReceiver & receiver, Packet * pPacket);
+
+	virtual bool prepareSend(Packet * pPacket);
+
+	void encrypt(Packet * pInPacket, Packet * pOutPacket);
+	void decrypt(Packet * pInPacket, Packet * pOutPacket);
+
+	bool isGood() const { return isGood_; }
+
+private:
+	bool init(const std::string& key);
+
+	bool encryptPacket(Packet * pPacket);
+
+	Reason onRecvError(Channel * pChannel, Packet * pPacket, const std::string& reason);
+
+	bool seal(uint8 * data, int length, uint8 * tag);
+	bool open(uint8 * data, int length, const uint8 * tag);
+
+	int8 type_;
+	bool isGood_;
+
+	void * pEncryptCtx_;
+	void * pDecryptCtx_;
+
+	uint32 sendDirection_;
+	uint32 recvDirection_;
+	uint64 sendSeq_;
+	uint64 recvSeq_;
+
+	Packet * pPacket_;
+	Network::PacketLength packetLen_;
+};
+
+/**
+	ͻhelloз͵ļkey
+	AEADʱʽΪ: [ENCRYPTION_KEY_MAGIC][int8 ][32ֽkey] Blowfishkeyޣ
+	ɵķ˻keyBlowfishkey ʱͻҲ˵Blowfish
+*/
+#define ENCRYPTION_KEY_MAGIC "KBEA"
+#define ENCRYPTION_KEY_MAGIC_SIZE 4
+
+std::string makeEncryptionKey(int8 type);
+bool isAEADEncryptionKey(const std::string& datas);
+
+/**
+	˸Լõļͻ˵keyЭ̳ʵʹõļͣ ֧ʱ˵Blowfish
+*/
+int8 negotiateEncryptType(int8 type, const std::string& datas);
+
+EncryptionFilter* createEncryptionFilter(int8 type, const std::string& datas);
+
+/**
+	ּܷʽڵͰСµļӽ(ṩkbcmd --benchmark=encryptionʹ)
+	ÿּܷʽСmegabytes MBݣ ÿһϣ ܽԭĲһʱfalse
+	ܴ Ҫڷ߳е
+*/
+bool benchmarkEncryptionFilters(uint32 megabytes, std::string& result);
 
 }
 }
@@ -72,6 +72,10 @@ public:
 	INLINE int send(const void * gramData, int gramSize);
 	void send(Bundle * pBundle);
 
+#if KBE_PLATFORM == PLATFORM_UNIX
+	INLINE int sendv(const struct iovec * iov, int iovcnt);
+#endif
+
 	INLINE int recv(void * gramData, int gramSize);
 	bool recvAll(void * gramData, int gramSize);
 	
@@ -108,8 +112,19 @@ public:
 	INLINE int sendto(void * gramData, int gramSize, struct sockaddr_in & sin);
 	void sendto(Bundle * pBundle, u_int16_t networkPort, u_int32_t networkAddr = BROADCAST);
 
+#if KBE_PLATFORM == PLATFORM_UNIX
+	INLINE int sendmmsg(struct mmsghdr * msgs, unsigned int vlen);
+
+	// Ŀַ(msg_name)ɵд
+	INLINE int sendmmsgto(struct mmsghdr * msgs, unsigned int vlen);
+#endif
+
 	INLINE int recvfrom(void * gramData, int gramSize, u_int16_t * networkPort, u_int32_t * networkAddr);
 	INLINE int recvfrom(void * gramData, int gramSize, struct sockaddr_in & sin);
+
+#if KBE_PLATFORM == PLATFORM_UNIX
+	INLINE int recvmmsg(struct mmsghdr * msgs, unsigned int vlen);
+#endif
 	
 	INLINE const Address& addr() const;
 	INLINE void addr(const Address& newAddress);
@@ -332,6 +332,7 @@ INLINE int EndPoint::sendto(void * gramData, int gramSize)
 	sin.sin_port = address_.port;
 	sin.sin_addr.s_addr = address_.ip;
 
+	++g_numSendSyscalls;
 	return ::sendto(socket_, (char*)gramData, gramSize,
 		0, (sockaddr*)&sin, sizeof(sin));
 }
@@ -339,10 +340,35 @@ INLINE int EndPoint::sendto(void * gramData, int gramSize)
 INLINE int EndPoint::sendto(void * gramData, int gramSize,
 	struct sockaddr_in & sin)
 {
+	++g_numSendSyscalls;
 	return ::sendto(socket_, (char*)gramData, gramSize,
 		0, (sockaddr*)&sin, sizeof(sin));
 }
 
+#if KBE_PLATFORM == PLATFORM_UNIX
+INLINE int EndPoint::sendmmsg(struct mmsghdr * msgs, unsigned int vlen)
+{
+	sockaddr_in	sin;
+	sin.sin_family = AF_INET;
+	sin.sin_port = address_.port;
+	sin.sin_addr.s_addr = address_.ip;
+
+	for (unsigned int i = 0; i < vlen; ++i)
+	{
+		msgs[i].msg_hdr.msg_name = &sin;
+		msgs[i].msg_hdr.msg_namelen = sizeof(sin);
+	}
+
+	return sendmmsgto(msgs, vlen);
+}
+
+INLINE int EndPoint::sendmmsgto(struct mmsghdr * msgs, unsigned int vlen)
+{
+	++g_numSendSyscalls;
+	return ::sendmmsg(socket_, msgs, vlen, 0);
+}
+#endif
+
 INLINE int EndPoint::recvfrom(void * gramData, int gramSize,
 	u_int16_t * networkPort, u_int32_t * networkAddr)
 {
@@ -368,6 +394,13 @@ INLINE int EndPoint::recvfrom(void * gramData, int gramSize,
 	return ret;
 }
 
+#if KBE_PLATFORM == PLATFORM_UNIX
+INLINE int EndPoint::recvmmsg(struct mmsghdr * msgs, unsigned int vlen)
+{
+	return ::recvmmsg(socket_, msgs, vlen, 0, NULL);
+}
+#endif
+
 INLINE int EndPoint::listen(int backlog)
 {
 	return ::listen(socket_, backlog);
@@ -426,12 +459,25 @@ INLINE EndPoint * EndPoint::accept(u_int16_t * networkPort, u_int32_t * networkA
 
 INLINE int EndPoint::send(const void * gramData, int gramSize)
 {
+	++g_numSendSyscalls;
+
 	if (isSSL())
 		return SSL_write(sslHandle_, (char*)gramData, gramSize);
 
 	return ::send(socket_, (char*)gramData, gramSize, 0);
 }
 
+#if KBE_PLATFORM == PLATFORM_UNIX
+INLINE int EndPoint::sendv(const struct iovec * iov, int iovcnt)
+{
+	// sslҪܣ ֱӺϲдsocket
+	KBE_ASSERT(!isSSL());
+
+	++g_numSendSyscalls;
+	return ::writev(socket_, iov, iovcnt);
+}
+#endif
+
 INLINE int EndPoint::recv(void * gramData, int gramSize)
 {
 	if (isSSL())
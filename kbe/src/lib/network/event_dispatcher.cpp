@@ -2,6 +2,7 @@
 
 
 #include "event_dispatcher.h"
+#include "common/timing_wheel.h"
 #include "network/event_poller.h"
 #include "network/error_reporter.h"
 #include "helper/profile.h"
@@ -14,7 +15,7 @@ namespace KBEngine {
 namespace Network
 {
 
-EventDispatcher::EventDispatcher() :
+EventDispatcher::EventDispatcher(TIMERS_TYPE timersType) :
 	breakProcessing_(EVENT_DISPATCHER_STATUS_RUNNING),
 	maxWait_(0.1),
 	numTimerCalls_(0),
@@ -24,9 +25,22 @@ EventDispatcher::EventDispatcher() :
 	lastStatisticsGathered_(0),
 	pTasks_(new Tasks),
 	pErrorReporter_(NULL),
-	pTimers_(new Timers64)
+	pTimers_(NULL)
 	
 {
+	if (timersType == TIMERS_TYPE_DEFAULT)
+		timersType = g_timingWheel ? TIMERS_TYPE_WHEEL : TIMERS_TYPE_HEAP;
+
+	if (timersType == TIMERS_TYPE_WHEEL)
+	{
+		uint64 resolution = uint64((((double)g_timingWheelResolution) / 1000000.0) * stampsPerSecondD());
+		pTimers_ = new TimingWheel64(resolution, timestamp());
+	}
+	else
+	{
+		pTimers_ = new Timers64;
+	}
+
 	pPoller_ = EventPoller::create();
 	pErrorReporter_ = new ErrorReporter(*this);
 }
@@ -26,7 +26,15 @@ public:
 		EVENT_DISPATCHER_STATUS_BREAK_PROCESSING = 2
 	};
 
-	EventDispatcher();
+	enum TIMERS_TYPE
+	{
+		// g_timingWheel
+		TIMERS_TYPE_DEFAULT = 0,
+		TIMERS_TYPE_HEAP = 1,
+		TIMERS_TYPE_WHEEL = 2
+	};
+
+	EventDispatcher(TIMERS_TYPE timersType = TIMERS_TYPE_DEFAULT);
 	virtual ~EventDispatcher();
 	
 	int  processOnce(bool shouldIdle = false);
@@ -55,6 +63,8 @@ public:
 	uint64 getSpareTime() const;
 	void clearSpareTime();
 
+	uint32 numTimerCalls() const { return numTimerCalls_; }
+
 	ErrorReporter & errorReporter()	{ return *pErrorReporter_; }
 
 	INLINE EventPoller* createPoller();
@@ -87,7 +97,7 @@ protected:
 	
 	Tasks* pTasks_;
 	ErrorReporter * pErrorReporter_;
-	Timers64* pTimers_;
+	TimersBase64* pTimers_;
 	EventPoller* pPoller_;
 };
 
@@ -31,13 +31,20 @@ EventPoller::~EventPoller()
 bool EventPoller::registerForRead(int fd,
 		InputNotificationHandler * handler)
 {
+	// ȼ¼ doRegisterForReadпҪݴע᷽ʽ
+	InputNotificationHandler* pOldHandler = fdReadHandlers_.find(fd);
+	fdReadHandlers_.set(fd, handler);
+
 	if (!this->doRegisterForRead(fd))
 	{
+		if (pOldHandler)
+			fdReadHandlers_.set(fd, pOldHandler);
+		else
+			fdReadHandlers_.erase(fd);
+
 		return false;
 	}
 
-	fdReadHandlers_[ fd ] = handler;
-
 	return true;
 }
 
@@ -45,13 +52,19 @@ bool EventPoller::registerForRead(int fd,
 bool EventPoller::registerForWrite(int fd,
 		OutputNotificationHandler * handler)
 {
+	OutputNotificationHandler* pOldHandler = fdWriteHandlers_.find(fd);
+	fdWriteHandlers_.set(fd, handler);
+
 	if (!this->doRegisterForWrite(fd))
 	{
+		if (pOldHandler)
+			fdWriteHandlers_.set(fd, pOldHandler);
+		else
+			fdWriteHandlers_.erase(fd);
+
 		return false;
 	}
 
-	fdWriteHandlers_[ fd ] = handler;
-
 	return true;
 }
 
@@ -74,14 +87,14 @@ bool EventPoller::deregisterForWrite(int fd)
 //-------------------------------------------------------------------------------------
 bool EventPoller::triggerRead(int fd)	
 {
-	FDReadHandlers::iterator iter = fdReadHandlers_.find(fd);
+	InputNotificationHandler* pHandler = fdReadHandlers_.find(fd);
 
-	if (iter == fdReadHandlers_.end())
+	if (pHandler == NULL)
 	{
 		return false;
 	}
 
-	iter->second->handleInputNotification(fd);
+	pHandler->handleInputNotification(fd);
 
 	return true;
 }
@@ -89,14 +102,14 @@ bool EventPoller::triggerRead(int fd)
 //-------------------------------------------------------------------------------------
 bool EventPoller::triggerWrite(int fd)	
 {
-	FDWriteHandlers::iterator iter = fdWriteHandlers_.find(fd);
+	OutputNotificationHandler* pHandler = fdWriteHandlers_.find(fd);
 
-	if (iter == fdWriteHandlers_.end())
+	if (pHandler == NULL)
 	{
 		return false;
 	}
 
-	iter->second->handleOutputNotification(fd);
+	pHandler->handleOutputNotification(fd);
 
 	return true;
 }
@@ -115,30 +128,20 @@ bool EventPoller::triggerError(int fd)
 //-------------------------------------------------------------------------------------
 bool EventPoller::isRegistered(int fd, bool isForRead) const
 {
-	return isForRead ? (fdReadHandlers_.find(fd) != fdReadHandlers_.end()) : 
-		(fdWriteHandlers_.find(fd) != fdWriteHandlers_.end());
+	return isForRead ? (fdReadHandlers_.find(fd) != NULL) : 
+		(fdWriteHandlers_.find(fd) != NULL);
 }
 
 //-------------------------------------------------------------------------------------
 InputNotificationHandler* EventPoller::findForRead(int fd)
 {
-	FDReadHandlers::iterator iter = fdReadHandlers_.find(fd);
-	
-	if(iter == fdReadHandlers_.end())
-		return NULL;
-
-	return iter->second;
+	return fdReadHandlers_.find(fd);
 }
 
 //-------------------------------------------------------------------------------------
 OutputNotificationHandler* EventPoller::findForWrite(int fd)
 {
-	FDWriteHandlers::iterator iter = fdWriteHandlers_.find(fd);
-	
-	if(iter == fdWriteHandlers_.end())
-		return NULL;
-
-	return iter->second;
+	return fdWriteHandlers_.find(fd);
 }
 
 //-------------------------------------------------------------------------------------
@@ -150,33 +153,7 @@ int EventPoller::getFileDescriptor() const
 //-------------------------------------------------------------------------------------
 int EventPoller::maxFD() const
 {
-	int readMaxFD = -1;
-
-	FDReadHandlers::const_iterator iFDReadHandler = fdReadHandlers_.begin();
-	while (iFDReadHandler != fdReadHandlers_.end())
-	{
-		if (iFDReadHandler->first > readMaxFD)
-		{
-			readMaxFD = iFDReadHandler->first;
-		}
-
-		++iFDReadHandler;
-	}
-
-	int writeMaxFD = -1;
-
-	FDWriteHandlers::const_iterator iFDWriteHandler = fdWriteHandlers_.begin();
-	while (iFDWriteHandler != fdWriteHandlers_.end())
-	{
-		if (iFDWriteHandler->first > writeMaxFD)
-		{
-			writeMaxFD = iFDWriteHandler->first;
-		}
-
-		++iFDWriteHandler;
-	}
-
-	return std::max(readMaxFD, writeMaxFD);
+	return std::max(fdReadHandlers_.maxFD(), fdWriteHandlers_.maxFD());
 }
 
 //-------------------------------------------------------------------------------------
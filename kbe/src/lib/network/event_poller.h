@@ -15,8 +15,80 @@ namespace Network
 {
 	
 class InputNotificationHandler;
-typedef std::map<int, InputNotificationHandler *> FDReadHandlers;
-typedef std::map<int, OutputNotificationHandler *> FDWriteHandlers;
+
+/**
+	fdӳ
+	windowsƽ̨fdǴ0ʼС ֱfdΪ±У ΪO(1)
+	windowsƽ̨SOCKETǾ ֵûޱ֤ Ȼʹmap
+*/
+template <class HANDLER>
+class FDHandlers
+{
+public:
+	FDHandlers() : handlers_() {}
+
+	INLINE HANDLER* find(int fd) const
+	{
+#if KBE_PLATFORM == PLATFORM_WIN32
+		typename HANDLERS::const_iterator iter = handlers_.find(fd);
+		return iter == handlers_.end() ? NULL : iter->second;
+#else
+		return (fd >= 0 && (size_t)fd < handlers_.size()) ? handlers_[fd] : NULL;
+#endif
+	}
+
+	INLINE void set(int fd, HANDLER* pHandler)
+	{
+#if KBE_PLATFORM == PLATFORM_WIN32
+		handlers_[fd] = pHandler;
+#else
+		if (fd < 0)
+			return;
+
+		if ((size_t)fd >= handlers_.size())
+			handlers_.resize(fd + 1, NULL);
+
+		handlers_[fd] = pHandler;
+#endif
+	}
+
+	INLINE void erase(int fd)
+	{
+#if KBE_PLATFORM == PLATFORM_WIN32
+		handlers_.erase(fd);
+#else
+		if (fd < 0 || (size_t)fd >= handlers_.size())
+			return;
+
+		handlers_[fd] = NULL;
+
+		// ĩβЧĴ maxFDСһ
+		while (!handlers_.empty() && handlers_.back() == NULL)
+			handlers_.pop_back();
+#endif
+	}
+
+	INLINE int maxFD() const
+	{
+#if KBE_PLATFORM == PLATFORM_WIN32
+		return handlers_.empty() ? -1 : handlers_.rbegin()->first;
+#else
+		return (int)handlers_.size() - 1;
+#endif
+	}
+
+private:
+#if KBE_PLATFORM == PLATFORM_WIN32
+	typedef std::map<int, HANDLER*> HANDLERS;
+#else
+	typedef std::vector<HANDLER*> HANDLERS;
+#endif
+
+	HANDLERS handlers_;
+};
+
+typedef FDHandlers<InputNotificationHandler> FDReadHandlers;
+typedef FDHandlers<OutputNotificationHandler> FDWriteHandlers;
 
 class EventPoller
 {
@@ -16,6 +16,9 @@ class InputNotificationHandler
 public:
 	virtual ~InputNotificationHandler() {};
 	virtual int handleInputNotification(int fd) = 0;
+
+	/** handleInputNotificationǷǽݶEAGAINΪֹ ǵĻʹñԵ */
+	virtual bool drainsInput() const { return false; }
 };
 
 /** ӿڽͨNetworkϢ
@@ -88,53 +88,80 @@ bool KCPPacketReceiver::processRecv(UDPPacket* pReceiveWindow)
 	return true;
 }
 
+//-------------------------------------------------------------------------------------
+bool KCPPacketReceiver::processRecv(const char* data, int len)
+{
+	Channel* pChannel = getChannel();
+	if (pChannel && pChannel->condemn() > 0)
+	{
+		return false;
+	}
+
+	// ֮ǰݱ߳
+	if (pChannel == NULL || !pChannel->hasHandshake())
+		return UDPPacketReceiver::processRecv(data, len);
+
+	// kcpḴݣ ֱӴӽջ룬 ҪΪÿݱUDPPacket
+	Reason ret = processKcpInput(pChannel, data, len);
+
+	if (ret != REASON_SUCCESS)
+		this->dispatcher().errorReporter().reportException(ret, pEndpoint_->addr());
+
+	return true;
+}
+
 //-------------------------------------------------------------------------------------
 Reason KCPPacketReceiver::processPacket(Channel* pChannel, Packet * pPacket)
 {
 	if (pChannel != NULL && pChannel->hasHandshake())
 	{
-		pChannel->addKcpUpdate();
+		Reason ret = processKcpInput(pChannel, (const char*)pPacket->data(), (int)pPacket->length());
+		RECLAIM_PACKET(pPacket->isTCPPacket(), pPacket);
+		return ret;
+	}
+	else
+	{
+		return PacketReceiver::processPacket(pChannel, pPacket);
+	}
+}
 
-		if (ikcp_input(pChannel->pKCP(), (const char*)pPacket->data(), pPacket->length()) < 0)
-		{
-			RECLAIM_PACKET(pPacket->isTCPPacket(), pPacket);
-			return REASON_CHANNEL_LOST;
-		}
+//-------------------------------------------------------------------------------------
+Reason KCPPacketReceiver::processKcpInput(Channel* pChannel, const char* data, int len)
+{
+	pChannel->addKcpUpdate();
 
-		RECLAIM_PACKET(pPacket->isTCPPacket(), pPacket);
+	if (ikcp_input(pChannel->pKCP(), data, len) < 0)
+	{
+		return REASON_CHANNEL_LOST;
+	}
 
-		while (true)
+	while (true)
+	{
+		Packet* pRcvdUDPPacket = UDPPacket::createPoolObject(OBJECTPOOL_POINT);
+		int bytes_recvd = ikcp_recv(pChannel->pKCP(), (char*)pRcvdUDPPacket->data(), pRcvdUDPPacket->size());
+		if (bytes_recvd < 0)
 		{
-			Packet* pRcvdUDPPacket = UDPPacket::createPoolObject(OBJECTPOOL_POINT);
-			int bytes_recvd = ikcp_recv(pChannel->pKCP(), (char*)pRcvdUDPPacket->data(), pRcvdUDPPacket->size());
-			if (bytes_recvd < 0)
+			//WARNING_MSG(fmt::format("KCPPacketReceiver::processPacket(): recvd_bytes({}) <= 0! addr={}\n", bytes_recvd, pChannel->c_str()));
+			RECLAIM_PACKET(pRcvdUDPPacket->isTCPPacket(), pRcvdUDPPacket);
+			return REASON_SUCCESS;
+		}
+		else
+		{
+			if (bytes_recvd >= (int)pRcvdUDPPacket->size())
 			{
-				//WARNING_MSG(fmt::format("KCPPacketReceiver::processPacket(): recvd_bytes({}) <= 0! addr={}\n", bytes_recvd, pChannel->c_str()));
-				RECLAIM_PACKET(pRcvdUDPPacket->isTCPPacket(), pRcvdUDPPacket);
-				return REASON_SUCCESS;
+				ERROR_MSG(fmt::format("KCPPacketReceiver::processPacket(): recvd_bytes({}) >= maxBuf({})! addr={}\n", bytes_recvd, pRcvdUDPPacket->size(), pChannel->c_str()));
 			}
-			else
+
+			pRcvdUDPPacket->wpos(bytes_recvd);
+
+			Reason r = PacketReceiver::processPacket(pChannel, pRcvdUDPPacket);
+			if (r != REASON_SUCCESS)
 			{
-				if (bytes_recvd >= (int)pRcvdUDPPacket->size())
-				{
-					ERROR_MSG(fmt::format("KCPPacketReceiver::processPacket(): recvd_bytes({}) >= maxBuf({})! addr={}\n", bytes_recvd, pRcvdUDPPacket->size(), pChannel->c_str()));
-				}
-
-				pRcvdUDPPacket->wpos(bytes_recvd);
-
-				Reason r = PacketReceiver::processPacket(pChannel, pRcvdUDPPacket);
-				if (r != REASON_SUCCESS)
-				{
-					RECLAIM_PACKET(pRcvdUDPPacket->isTCPPacket(), pRcvdUDPPacket);
-					return r;
-				}
+				RECLAIM_PACKET(pRcvdUDPPacket->isTCPPacket(), pRcvdUDPPacket);
+				return r;
 			}
 		}
 	}
-	else
-	{
-		return PacketReceiver::processPacket(pChannel, pPacket);
-	}
 
 	return REASON_SUCCESS;
 }
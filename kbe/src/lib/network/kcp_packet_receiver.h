@@ -25,6 +25,7 @@ public:
 
 	bool processRecv(UDPPacket* pReceiveWindow);
 	virtual bool processRecv(bool expectingPacket);
+	virtual bool processRecv(const char* data, int len);
 
 	virtual Reason processPacket(Channel* pChannel, Packet * pPacket);
 
@@ -33,6 +34,10 @@ public:
 	}
 
 protected:
+	/**
+		ݱkcp ȡѾİ
+	*/
+	Reason processKcpInput(Channel* pChannel, const char* data, int len);
 
 };
 
@@ -21,6 +21,15 @@ namespace KBEngine {
 namespace Network
 {
 
+#if KBE_PLATFORM == PLATFORM_UNIX
+// 合并期间kcp输出的数据报， kcp会复用自己的输出缓冲区， 因此需要复制出来
+static bool _g_gathering = false;
+static std::vector<char> _g_gatherBuffer;
+static std::vector<int> _g_gatherLengths;
+static std::vector<Channel*> _g_gatherChannels;
+static size_t _g_gatherCount = 0;
+#endif
+
 //-------------------------------------------------------------------------------------
 static ObjectPool<KCPPacketSender> _g_objPool("KCPPacketSender");
 ObjectPool<KCPPacketSender>& KCPPacketSender::ObjPool()
@@ -90,7 +99,7 @@ Reason KCPPacketSender::processFilterPacket(Channel* pChannel, Packet * pPacket,
 
 
 		if (ikcp_waitsnd(pChannel->pKCP()) > (int)(pChannel->pKCP()->snd_wnd * 2)/* 发送队列超出发送窗口2倍则提示资源不足 */ || 
-			ikcp_send(pChannel->pKCP(), (const char*)pPacket->data(), pPacket->length()) < 0)
+			ikcp_send(pChannel->pKCP(), (const char*)(pPacket->data() + pPacket->rpos()), pPacket->length()) < 0)
 		{
 			ERROR_MSG(fmt::format("KCPPacketSender::ikcp_send: send error! currPacketSize={}, ikcp_waitsnd={}, snd_wndsize={}\n", 
 				pPacket->length(), ikcp_waitsnd(pChannel->pKCP()), pChannel->pKCP()->snd_wnd));
@@ -103,7 +112,7 @@ Reason KCPPacketSender::processFilterPacket(Channel* pChannel, Packet * pPacket,
 	else
 	{
 		EndPoint* pEndpoint = pChannel->pEndPoint();
-		int retlen = pEndpoint->sendto((void*)(pPacket->data()), pPacket->length());
+		int retlen = pEndpoint->sendto((void*)(pPacket->data() + pPacket->rpos()), pPacket->length());
 		bool sentCompleted = (retlen == (int)pPacket->length());
 
 		if (retlen > 0)
@@ -135,6 +144,20 @@ int KCPPacketSender::kcp_output(const char *buf, int len, ikcpcb *kcp, Channel*
 {
 	//KBE_ASSERT(kcp == pChannel->pKCP());
 
+#if KBE_PLATFORM == PLATFORM_UNIX
+	if (_g_gathering)
+	{
+		if (_g_gatherLengths.size() >= MAX_GATHER_DATAGRAMS)
+			flushGather();
+
+		_g_gatherBuffer.insert(_g_gatherBuffer.end(), buf, buf + len);
+		_g_gatherLengths.push_back(len);
+		_g_gatherChannels.push_back(pChannel);
+		++_g_gatherCount;
+		return 0;
+	}
+#endif
+
 	EndPoint* pEndpoint = pChannel->pEndPoint();
 	int retlen = pEndpoint->sendto((void*)buf, len);
 
@@ -145,6 +168,127 @@ int KCPPacketSender::kcp_output(const char *buf, int len, ikcpcb *kcp, Channel*
 	return sentCompleted ? 0 : -1;
 }
 
+//-------------------------------------------------------------------------------------
+void KCPPacketSender::beginGather()
+{
+#if KBE_PLATFORM == PLATFORM_UNIX
+	_g_gathering = g_vectoredSend;
+	_g_gatherCount = 0;
+#endif
+}
+
+//-------------------------------------------------------------------------------------
+size_t KCPPacketSender::endGather()
+{
+#if KBE_PLATFORM == PLATFORM_UNIX
+	if (!_g_gathering)
+		return 0;
+
+	flushGather();
+	_g_gathering = false;
+	return _g_gatherCount;
+#else
+	return 0;
+#endif
+}
+
+//-------------------------------------------------------------------------------------
+void KCPPacketSender::discardGather(Channel* pChannel)
+{
+#if KBE_PLATFORM == PLATFORM_UNIX
+	// 通道清理后会关闭并置空pEndPoint， 之后也可能被对象池复用， 只保留空位， flushGather时跳过
+	std::vector<Channel*>::iterator iter = _g_gatherChannels.begin();
+	for (; iter != _g_gatherChannels.end(); ++iter)
+	{
+		if ((*iter) == pChannel)
+			(*iter) = NULL;
+	}
+#endif
+}
+
+//-------------------------------------------------------------------------------------
+void KCPPacketSender::flushGather()
+{
+#if KBE_PLATFORM == PLATFORM_UNIX
+	size_t gathered = _g_gatherLengths.size();
+	if (gathered == 0)
+		return;
+
+	struct mmsghdr msgs[MAX_GATHER_DATAGRAMS];
+	struct iovec iov[MAX_GATHER_DATAGRAMS];
+	struct sockaddr_in addrs[MAX_GATHER_DATAGRAMS];
+	Channel* channels[MAX_GATHER_DATAGRAMS];
+	memset(msgs, 0, sizeof(struct mmsghdr) * gathered);
+
+	// 跳过合并期间已被清理的通道(discardGather)的数据报
+	size_t count = 0;
+	char* pData = &_g_gatherBuffer[0];
+	for (size_t i = 0; i < gathered; ++i)
+	{
+		Channel* pChannel = _g_gatherChannels[i];
+		int len = _g_gatherLengths[i];
+
+		if (pChannel)
+		{
+			const Address& addr = pChannel->pEndPoint()->addr();
+			addrs[count].sin_family = AF_INET;
+			addrs[count].sin_port = addr.port;
+			addrs[count].sin_addr.s_addr = addr.ip;
+
+			iov[count].iov_base = pData;
+			iov[count].iov_len = len;
+			msgs[count].msg_hdr.msg_iov = &iov[count];
+			msgs[count].msg_hdr.msg_iovlen = 1;
+			msgs[count].msg_hdr.msg_name = &addrs[count];
+			msgs[count].msg_hdr.msg_namelen = sizeof(addrs[count]);
+			channels[count] = pChannel;
+			++count;
+		}
+
+		pData += len;
+	}
+
+	// 服务端的kcp通道共用监听socket， 同一socket上连续的数据报一次sendmmsg发出
+	size_t start = 0;
+	while (start < count)
+	{
+		EndPoint* pEndpoint = channels[start]->pEndPoint();
+
+		size_t end = start + 1;
+		while (end < count && channels[end]->pEndPoint()->socket() == pEndpoint->socket())
+			++end;
+
+		size_t sent = start;
+		while (sent < end)
+		{
+			int ret = pEndpoint->sendmmsgto(msgs + sent, (unsigned int)(end - sent));
+			if (ret <= 0)
+				break;
+
+			sent += ret;
+		}
+
+		// 与逐个sendto一致， 没能发出的数据报视为丢失， 由kcp负责重传
+		for (size_t i = start; i < end; ++i)
+		{
+			Channel* pChannel = channels[i];
+			if (pChannel->condemn() == Channel::FLAG_CONDEMN_AND_DESTROY)
+				continue;
+
+			int len = (int)iov[i].iov_len;
+			bool sentCompleted = i < sent && (int)msgs[i].msg_len == len;
+			pChannel->onPacketSent(sentCompleted ? len : -1, sentCompleted);
+		}
+
+		start = end;
+	}
+
+	_g_gatherBuffer.clear();
+	_g_gatherLengths.clear();
+	_g_gatherChannels.clear();
+#endif
+}
+
 //-------------------------------------------------------------------------------------
 }
 }
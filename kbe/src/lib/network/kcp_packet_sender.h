@@ -35,7 +35,24 @@ public:
 
 	int kcp_output(const char *buf, int len, ikcpcb *kcp, Channel* pChannel);
 
+	// һsendmmsgϲݱ
+	enum { MAX_GATHER_DATAGRAMS = 64 };
+
+	/**
+		ϲkcpUpdateڼݱ KCPSchedulerһеĶͨ
+		endGatherʱͨsendmmsg(ͬһsocketݱһη) رκϲݱ
+	*/
+	static void beginGather();
+	static size_t endGather();
+
+	/**
+		ͨͷkcpʱã ͨδĺϲݱ flushGatherʱͨ
+	*/
+	static void discardGather(Channel* pChannel);
+
 protected:
+	static void flushGather();
+
 	virtual void onSent(Packet* pPacket);
 	virtual Reason processFilterPacket(Channel* pChannel, Packet * pPacket, int userarg);
 
@@ -0,0 +1,282 @@
+// Copyright 2008-2018 Yolo Technologies, Inc. All Rights Reserved. https://www.comblockengine.com
+
+
+#include "kcp_scheduler.h"
+#include "network/channel.h"
+#include "network/event_dispatcher.h"
+#include "network/kcp_packet_sender.h"
+
+namespace KBEngine{
+namespace Network
+{
+
+//-------------------------------------------------------------------------------------
+KCPScheduler::KCPScheduler():
+dueChannels_(),
+numScheduled_(0),
+lastTime_(kbe_clock()),
+pDispatcher_(NULL),
+timerHandle_(),
+timerDueTime_(0),
+updating_(false)
+{
+}
+
+//-------------------------------------------------------------------------------------
+KCPScheduler::~KCPScheduler()
+{
+	fini();
+}
+
+//-------------------------------------------------------------------------------------
+void KCPScheduler::init(EventDispatcher & dispatcher)
+{
+	pDispatcher_ = &dispatcher;
+	dispatcher.addTask(this);
+}
+
+//-------------------------------------------------------------------------------------
+void KCPScheduler::fini()
+{
+	if (pDispatcher_ == NULL)
+		return;
+
+	if (timerHandle_.isSet())
+		timerHandle_.cancel();
+
+	pDispatcher_->cancelTask(this);
+	pDispatcher_ = NULL;
+}
+
+//-------------------------------------------------------------------------------------
+void KCPScheduler::schedule(Channel* pChannel, uint32 delay)
+{
+	// ڵȴ£ ºᰴikcp_check°
+	if (pChannel->kcpSlot_ == SLOT_UPDATING)
+		return;
+
+	if (delay >= WHEEL_SLOTS)
+		delay = WHEEL_SLOTS - 1;
+
+	uint32 now = kbe_clock();
+	uint32 dueTime = now + delay;
+
+	if (pChannel->kcpSlot_ != SLOT_NONE)
+	{
+		if ((int32)(pChannel->kcpDueTime_ - dueTime) <= 0)
+			return;
+
+		remove(pChannel);
+	}
+
+	insert(pChannel, dueTime);
+
+	if (!updating_ && pDispatcher_ && 
+		(!timerHandle_.isSet() || (int32)(dueTime - timerDueTime_) < 0))
+	{
+		if (timerHandle_.isSet())
+			timerHandle_.cancel();
+
+		timerDueTime_ = dueTime;
+		timerHandle_ = pDispatcher_->addTimer(delay > 0 ? delay * 1000 : 1, this);
+	}
+}
+
+//-------------------------------------------------------------------------------------
+void KCPScheduler::deregister(Channel* pChannel)
+{
+	if (pChannel->kcpSlot_ == SLOT_UPDATING)
+	{
+		std::vector<Channel*>::iterator iter = std::find(dueChannels_.begin(), dueChannels_.end(), pChannel);
+		if (iter != dueChannels_.end())
+			(*iter) = NULL;
+
+		pChannel->kcpSlot_ = SLOT_NONE;
+	}
+	else if (pChannel->kcpSlot_ != SLOT_NONE)
+	{
+		remove(pChannel);
+	}
+}
+
+//-------------------------------------------------------------------------------------
+void KCPScheduler::insert(Channel* pChannel, uint32 dueTime)
+{
+	std::vector<Channel*>& slot = slots_[dueTime % WHEEL_SLOTS];
+
+	pChannel->kcpSlot_ = (int32)(dueTime % WHEEL_SLOTS);
+	pChannel->kcpSlotIndex_ = (uint32)slot.size();
+	pChannel->kcpDueTime_ = dueTime;
+	slot.push_back(pChannel);
+
+	++numScheduled_;
+}
+
+//-------------------------------------------------------------------------------------
+void KCPScheduler::remove(Channel* pChannel)
+{
+	std::vector<Channel*>& slot = slots_[pChannel->kcpSlot_];
+
+	// һͨλ O(1)ɾ
+	Channel* pLastChannel = slot.back();
+	slot[pChannel->kcpSlotIndex_] = pLastChannel;
+	pLastChannel->kcpSlotIndex_ = pChannel->kcpSlotIndex_;
+	slot.pop_back();
+
+	pChannel->kcpSlot_ = SLOT_NONE;
+	--numScheduled_;
+}
+
+//-------------------------------------------------------------------------------------
+bool KCPScheduler::process()
+{
+	update();
+	return true;
+}
+
+//-------------------------------------------------------------------------------------
+void KCPScheduler::handleTimeout(TimerHandle handle, void * arg)
+{
+	timerHandle_.cancel();
+	update();
+}
+
+//-------------------------------------------------------------------------------------
+void KCPScheduler::update()
+{
+	if (updating_ || numScheduled_ == 0)
+		return;
+
+	uint32 now = kbe_clock();
+
+	// ǰĲÿζҪ¼飬 ڿ°ŵͨ
+	uint32 elapsed = now - lastTime_;
+	uint32 numSlots = elapsed >= WHEEL_SLOTS ? WHEEL_SLOTS : elapsed + 1;
+
+	for (uint32 i = 0; i < numSlots; ++i)
+	{
+		std::vector<Channel*>& slot = slots_[(lastTime_ + i) % WHEEL_SLOTS];
+
+		size_t idx = 0;
+		while (idx < slot.size())
+		{
+			Channel* pChannel = slot[idx];
+
+			if ((int32)(pChannel->kcpDueTime_ - now) > 0)
+			{
+				++idx;
+				continue;
+			}
+
+			// removeidxλûԭһͨ Ҫǰ
+			remove(pChannel);
+			pChannel->kcpSlot_ = SLOT_UPDATING;
+			dueChannels_.push_back(pChannel);
+		}
+	}
+
+	lastTime_ = now;
+
+	if (dueChannels_.size() == 0)
+	{
+		rearmTimer(now);
+		return;
+	}
+
+	uint64 startTime = timestamp();
+	uint32 numUpdates = 0;
+
+	updating_ = true;
+
+	// ͨϲ
+	KCPPacketSender::beginGather();
+
+	for (size_t i = 0; i < dueChannels_.size(); ++i)
+	{
+		Channel* pChannel = dueChannels_[i];
+		if (pChannel == NULL)
+			continue;
+
+		pChannel->kcpSlot_ = SLOT_NONE;
+
+		ikcpcb* pKCP = pChannel->pKCP();
+		ikcp_update(pKCP, now);
+		++numUpdates;
+
+		uint32 nextUpdateKcpTime = ikcp_check(pKCP, now) - now;
+		if (nextUpdateKcpTime > 0)
+			insert(pChannel, now + std::min(nextUpdateKcpTime, (uint32)(WHEEL_SLOTS - 1)));
+	}
+
+	g_kcpSchedulerDatagrams += KCPPacketSender::endGather();
+
+	updating_ = false;
+	dueChannels_.clear();
+
+	uint64 passTime = (timestamp() - startTime) * 1000000 / stampsPerSecond();
+
+	++g_kcpSchedulerPasses;
+	g_kcpUpdates += numUpdates;
+	g_kcpSchedulerPassUpdatesLast = numUpdates;
+	g_kcpSchedulerPassTime += passTime;
+	g_kcpSchedulerPassTimeLast = passTime;
+
+	if (numUpdates > g_kcpSchedulerPassUpdatesMax)
+		g_kcpSchedulerPassUpdatesMax = numUpdates;
+
+	if (passTime > g_kcpSchedulerPassTimeMax)
+		g_kcpSchedulerPassTimeMax = passTime;
+
+	rearmTimer(now);
+}
+
+//-------------------------------------------------------------------------------------
+void KCPScheduler::rearmTimer(uint32 now)
+{
+	if (pDispatcher_ == NULL)
+		return;
+
+	if (numScheduled_ == 0)
+	{
+		if (timerHandle_.isSet())
+			timerHandle_.cancel();
+
+		return;
+	}
+
+	// ҵķǿղۣ ʱֻڰ¼ѭѯл
+	uint32 dueTime = now + WHEEL_SLOTS - 1;
+
+	for (uint32 i = 0; i < WHEEL_SLOTS; ++i)
+	{
+		std::vector<Channel*>& slot = slots_[(now + i) % WHEEL_SLOTS];
+		if (slot.size() == 0)
+			continue;
+
+		dueTime = slot[0]->kcpDueTime_;
+		for (size_t j = 1; j < slot.size(); ++j)
+		{
+			if ((int32)(slot[j]->kcpDueTime_ - dueTime) < 0)
+				dueTime = slot[j]->kcpDueTime_;
+		}
+
+		break;
+	}
+
+	if (timerHandle_.isSet())
+	{
+		if (timerDueTime_ == dueTime)
+			return;
+
+		timerHandle_.cancel();
+	}
+
+	int32 delay = (int32)(dueTime - now);
+
+	timerDueTime_ = dueTime;
+	timerHandle_ = pDispatcher_->addTimer(delay > 0 ? delay * 1000 : 1, this);
+}
+
+//-------------------------------------------------------------------------------------
+}
+}
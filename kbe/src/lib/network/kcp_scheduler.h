@@ -0,0 +1,81 @@
+// Copyright 2008-2018 Yolo Technologies, Inc. All Rights Reserved. https://www.comblockengine.com
+
+#ifndef KBE_KCP_SCHEDULER_H
+#define KBE_KCP_SCHEDULER_H
+
+#include "common/common.h"
+#include "common/task.h"
+#include "common/timer.h"
+#include "helper/debug_helper.h"
+
+namespace KBEngine{
+namespace Network
+{
+class Channel;
+class EventDispatcher;
+
+/*
+	ͳһһNetworkInterfaceϵkcpͨ
+	ͨ´Ҫikcp_updateʱ()ʱ֣ ÿ¼ѭ(Task)һԸеڵͨ
+	ͨϲͨsendmmsg ֻһʱڻѯ
+*/
+class KCPScheduler : public Task, public TimerHandler
+{
+public:
+	enum
+	{
+		// ÿ1룬 Χӳֵٰţ ǰupdatekcpӰ
+		WHEEL_SLOTS = 1024,
+
+		SLOT_NONE = -1,
+		SLOT_UPDATING = -2
+	};
+
+	KCPScheduler();
+	virtual ~KCPScheduler();
+
+	void init(EventDispatcher & dispatcher);
+	void fini();
+
+	/**
+		delayͨ ͨѾ˸ĸʱ
+	*/
+	void schedule(Channel* pChannel, uint32 delay);
+	void deregister(Channel* pChannel);
+
+	/**
+		еڵͨ
+	*/
+	void update();
+
+	uint32 numScheduled() const { return numScheduled_; }
+
+private:
+	virtual bool process();
+	virtual void handleTimeout(TimerHandle handle, void * arg);
+
+	void insert(Channel* pChannel, uint32 dueTime);
+	void remove(Channel* pChannel);
+
+	void rearmTimer(uint32 now);
+
+	std::vector<Channel*> slots_[WHEEL_SLOTS];
+
+	// ֵڵȴµͨ бעͨΪNULL
+	std::vector<Channel*> dueChannels_;
+
+	uint32 numScheduled_;
+
+	// ϴδʱ(kbe_clock)
+	uint32 lastTime_;
+
+	EventDispatcher* pDispatcher_;
+	TimerHandle timerHandle_;
+	uint32 timerDueTime_;
+
+	bool updating_;
+};
+
+}
+}
+#endif // KBE_KCP_SCHEDULER_H
@@ -14,6 +14,7 @@
 #include "network/channel.h"
 #include "network/packet.h"
 #include "network/delayed_channels.h"
+#include "network/kcp_scheduler.h"
 #include "network/interfaces.h"
 #include "network/message_handler.h"
 
@@ -36,6 +37,7 @@ NetworkInterface::NetworkInterface(Network::EventDispatcher * pDispatcher,
 	pExtUdpListenerReceiver_(NULL),
 	pIntListenerReceiver_(NULL),
 	pDelayedChannels_(new DelayedChannels()),
+	pKCPScheduler_(new KCPScheduler()),
 	pChannelTimeOutHandler_(NULL),
 	pChannelDeregisterHandler_(NULL),
 	numExtChannels_(0)
@@ -82,6 +84,7 @@ NetworkInterface::NetworkInterface(Network::EventDispatcher * pDispatcher,
 		"please check for kbengine[_defs].xml!\n");
 
 	pDelayedChannels_->init(this->dispatcher(), this);
+	pKCPScheduler_->init(this->dispatcher());
 }
 
 //-------------------------------------------------------------------------------------
@@ -103,10 +106,12 @@ NetworkInterface::~NetworkInterface()
 	if (pDispatcher_ != NULL)
 	{
 		pDelayedChannels_->fini(this->dispatcher());
+		pKCPScheduler_->fini();
 		pDispatcher_ = NULL;
 	}
 
 	SAFE_RELEASE(pDelayedChannels_);
+	SAFE_RELEASE(pKCPScheduler_);
 	SAFE_RELEASE(pExtListenerReceiver_);
 	SAFE_RELEASE(pIntListenerReceiver_);
 }
@@ -304,6 +309,12 @@ void NetworkInterface::delayedSend(Channel & channel)
 	pDelayedChannels_->add(channel);
 }
 
+//-------------------------------------------------------------------------------------
+bool NetworkInterface::isFlushingDelayedChannels() const
+{
+	return pDelayedChannels_->flushing();
+}
+
 //-------------------------------------------------------------------------------------
 void NetworkInterface::sendIfDelayed(Channel & channel)
 {
@@ -431,6 +442,8 @@ void NetworkInterface::onChannelTimeOut(Channel * pChannel)
 //-------------------------------------------------------------------------------------
 void NetworkInterface::processChannels(KBEngine::Network::MessageHandlers* pMsgHandlers)
 {
+	updatePollerTickStats();
+
 	ChannelMap::iterator iter = channelMap_.begin();
 	for(; iter != channelMap_.end(); )
 	{
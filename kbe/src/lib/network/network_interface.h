@@ -19,6 +19,7 @@ class Channel;
 class ChannelTimeOutHandler;
 class ChannelDeregisterHandler;
 class DelayedChannels;
+class KCPScheduler;
 class ListenerReceiver;
 class Packet;
 class EventDispatcher;
@@ -73,6 +74,10 @@ public:
 	/**  */
 	void sendIfDelayed(Channel & channel);
 	void delayedSend(Channel & channel);
+	bool isFlushingDelayedChannels() const;
+
+	/** ͳһ±ӿkcpͨĵ */
+	KCPScheduler& kcpScheduler() { return *pKCPScheduler_; }
 	
 	bool good() const{ return (!pExtListenerReceiver_ || extTcpEndpoint_.good()) && (intTcpEndpoint_.good()); }
 
@@ -102,6 +107,8 @@ private:
 	ListenerReceiver *						pIntListenerReceiver_;
 	
 	DelayedChannels * 						pDelayedChannels_;
+
+	KCPScheduler *							pKCPScheduler_;
 	
 	ChannelTimeOutHandler *					pChannelTimeOutHandler_;	// ʱͨɱ׽ ֪ϲclientϿ
 	ChannelDeregisterHandler *				pChannelDeregisterHandler_;
@@ -28,6 +28,13 @@ public:
 	virtual Reason send(Channel * pChannel, PacketSender& sender, Packet * pPacket, int userarg);
 
 	virtual Reason recv(Channel * pChannel, PacketReceiver & receiver, Packet * pPacket);
+
+	/**
+		send֮ǰԤȴһ͵İ(ԭؼ) İsendʱظ
+		ڹ߳еã ʵвʹöء ־ͨ״̬
+		falseʾûпԤȴ
+	*/
+	virtual bool prepareSend(Packet * pPacket) { return false; }
 };
 
 typedef SmartPointer<PacketFilter> PacketFilterPtr;
@@ -38,6 +38,12 @@ public:
 
 	virtual PacketReader::PACKET_READER_TYPE type()const { return PACKET_READER_TYPE_SOCKET; }
 
+	/**
+		ǰڴĿϢƴӳɵĶ ӿڿֱȡеݣ 
+		ᱻ
+	*/
+	MemoryStream* pFragmentStream() const { return pFragmentStream_; }
+
 
 protected:
 	enum FragmentDataTypes
@@ -3,11 +3,15 @@
 
 #include "poller_epoll.h"
 #include "helper/profile.h"
+#include "network/interfaces.h"
+
+#ifdef HAS_EPOLL
+#include <sys/epoll.h>
+#endif
 
 namespace KBEngine { 
 
 #ifdef HAS_EPOLL
-#include <sys/epoll.h>
 ProfileVal g_idleProfile("Idle");
 
 namespace Network
@@ -15,7 +19,9 @@ namespace Network
 	
 //-------------------------------------------------------------------------------------
 EpollPoller::EpollPoller(int expectedSize) :
-	epfd_(epoll_create(expectedSize))
+	epfd_(epoll_create(expectedSize)),
+	pEvents_(NULL),
+	maxEvents_(0)
 {
 	if (epfd_ == -1)
 	{
@@ -31,6 +37,8 @@ EpollPoller::~EpollPoller()
 	{
 		close(epfd_);
 	}
+
+	SAFE_RELEASE_ARRAY(pEvents_);
 }
 
 //-------------------------------------------------------------------------------------
@@ -53,11 +61,20 @@ bool EpollPoller::doRegister(int fd, bool isRead, bool isRegister)
 	}
 	else
 	{
-		// TODO: Could be good to use EPOLLET (leave like select for now).
 		ev.events = isRead ? EPOLLIN : EPOLLOUT;
 		op = isRegister ? EPOLL_CTL_ADD : EPOLL_CTL_DEL;
 	}
 
+	// ֻ¼ҴǽݶEAGAINΪֹʱʹñԵ
+	// д¼ĴΪʹڵûдͷأ ͬʱдʱ˻ˮƽ 
+	// EPOLL_CTL_MOD¼״̬ лᶪʧ¼
+	if (g_pollerEdgeTriggered && ev.events == EPOLLIN)
+	{
+		InputNotificationHandler* pHandler = this->findForRead(fd);
+		if (pHandler && pHandler->drainsInput())
+			ev.events |= EPOLLET;
+	}
+
 	if (epoll_ctl(epfd_, op, fd, &ev) < 0)
 	{
 		const char* MESSAGE = "EpollPoller::doRegister: Failed to {} {} file "
@@ -88,8 +105,15 @@ bool EpollPoller::doRegister(int fd, bool isRead, bool isRegister)
 //-------------------------------------------------------------------------------------
 int EpollPoller::processPendingEvents(double maxWait)
 {
-	const int MAX_EVENTS = 10;
-	struct epoll_event events[ MAX_EVENTS ];
+	int maxEvents = KBE_MAX(1, (int)g_pollerMaxEvents);
+	if (maxEvents != maxEvents_)
+	{
+		SAFE_RELEASE_ARRAY(pEvents_);
+		maxEvents_ = maxEvents;
+		pEvents_ = new struct epoll_event[maxEvents_];
+	}
+
+	struct epoll_event* events = pEvents_;
 	int maxWaitInMilliseconds = int(ceil(maxWait * 1000));
 
 #if ENABLE_WATCHERS
@@ -99,9 +123,20 @@ int EpollPoller::processPendingEvents(double maxWait)
 #endif
 
 	KBEConcurrency::onStartMainThreadIdling();
-	int nfds = epoll_wait(epfd_, events, MAX_EVENTS, maxWaitInMilliseconds);
+	int nfds = epoll_wait(epfd_, events, maxEvents_, maxWaitInMilliseconds);
 	KBEConcurrency::onEndMainThreadIdling();
 
+	++g_pollerWaits;
+
+	if (nfds > 0)
+	{
+		g_pollerEvents += nfds;
+
+		// ȡ˵¼ûȡأ ҪmaxEvents
+		if (nfds == maxEvents_)
+			++g_pollerFullWaits;
+	}
+
 
 #if ENABLE_WATCHERS
 	g_idleProfile.stop();
@@ -9,6 +9,10 @@
 #define HAS_EPOLL
 #endif
 
+#ifdef HAS_EPOLL
+struct epoll_event;
+#endif
+
 namespace KBEngine { 
 namespace Network
 {
@@ -42,6 +46,10 @@ protected:
 private:
 
 	int epfd_;
+
+	// epoll_waitȡ¼Ļ Сg_pollerMaxEvents
+	struct ::epoll_event* pEvents_;
+	int maxEvents_;
 };
 #endif // HAS_EPOLL
 
@@ -0,0 +1,247 @@
+// Copyright 2008-2018 Yolo Technologies, Inc. All Rights Reserved. https://www.comblockengine.com
+
+
+#include "send_encrypt_stage.h"
+#include "network/channel.h"
+#include "network/bundle.h"
+#include "network/packet.h"
+#include "network/packet_filter.h"
+#include "thread/threadpool.h"
+
+namespace KBEngine{
+namespace Network
+{
+
+/*
+	һƬļ ɺ̳߳߳ɾ
+	߳SendEncryptStage::waitShardȡͨͣ ֮Ż̳߳صonMainThreadTick
+*/
+class SendEncryptTask : public thread::TPTask
+{
+public:
+	SendEncryptTask(SendEncryptStage* pStage):
+	pStage_(pStage),
+	channels_()
+	{
+	}
+
+	virtual ~SendEncryptTask()
+	{
+	}
+
+	virtual bool process()
+	{
+		pStage_->onShardCompleted(this, SendEncryptStage::prepareChannels(channels_));
+		return false;
+	}
+
+	std::vector<Channel*>& channels() { return channels_; }
+
+private:
+	SendEncryptStage* pStage_;
+	std::vector<Channel*> channels_;
+};
+
+//-------------------------------------------------------------------------------------
+SendEncryptStage::SendEncryptStage():
+pThreadPool_(NULL),
+mutex_(),
+cond_(),
+numPendingShards_(0),
+completedShards_(),
+numPreparedPackets_(0),
+startTime_(0),
+waitTime_(0)
+{
+}
+
+//-------------------------------------------------------------------------------------
+SendEncryptStage::~SendEncryptStage()
+{
+	if (pThreadPool_)
+	{
+		pThreadPool_->finalise();
+		SAFE_RELEASE(pThreadPool_);
+	}
+}
+
+//-------------------------------------------------------------------------------------
+bool SendEncryptStage::initialize()
+{
+	pThreadPool_ = new thread::ThreadPool();
+
+	if (!pThreadPool_->createThreadPool(0, g_sendEncryptThreads, g_sendEncryptThreads))
+	{
+		ERROR_MSG(fmt::format("SendEncryptStage::initialize: create threads({}) failed, "
+			"send encryption falls back to the main thread!\n", g_sendEncryptThreads));
+
+		pThreadPool_->finalise();
+		SAFE_RELEASE(pThreadPool_);
+
+		g_sendEncryptThreads = 0;
+		return false;
+	}
+
+	return true;
+}
+
+//-------------------------------------------------------------------------------------
+uint32 SendEncryptStage::prepareChannels(const std::vector<Channel*>& channels)
+{
+	uint32 numPackets = 0;
+
+	std::vector<Channel*>::const_iterator iter = channels.begin();
+	for (; iter != channels.end(); ++iter)
+	{
+		Channel* pChannel = (*iter);
+		PacketFilter* pFilter = pChannel->pFilter().get();
+
+		Channel::Bundles& bundles = pChannel->bundles();
+		Channel::Bundles::iterator bundleIter = bundles.begin();
+		for (; bundleIter != bundles.end(); ++bundleIter)
+		{
+			Bundle::Packets& packets = (*bundleIter)->packets();
+			Bundle::Packets::iterator packetIter = packets.begin();
+			for (; packetIter != packets.end(); ++packetIter)
+			{
+				if (pFilter->prepareSend((*packetIter)))
+					++numPackets;
+			}
+		}
+	}
+
+	return numPackets;
+}
+
+//-------------------------------------------------------------------------------------
+void SendEncryptStage::onShardCompleted(SendEncryptTask* pTask, uint32 numPackets)
+{
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		numPreparedPackets_ += numPackets;
+		completedShards_.push_back(pTask);
+	}
+
+	cond_.notify_one();
+}
+
+//-------------------------------------------------------------------------------------
+bool SendEncryptStage::start(const std::vector<Channel*>& channels, std::vector<Channel*>& mainChannels)
+{
+	if (channels.size() == 0 || g_sendEncryptThreads == 0)
+		return false;
+
+	if (pThreadPool_ == NULL && !initialize())
+		return false;
+
+	KBE_ASSERT(numPendingShards_ == 0);
+	startTime_ = timestamp();
+	waitTime_ = 0;
+
+	// ƬΪ߳߳Լ
+	uint32 numShards = (uint32)std::min((size_t)g_sendEncryptThreads + 1, channels.size());
+
+	std::vector<SendEncryptTask*> tasks;
+	for (uint32 i = 0; i < numShards - 1; ++i)
+		tasks.push_back(new SendEncryptTask(this));
+
+	// ÿָͨǰСķƬ ͨҲһݸأ ֤ÿƬٷֵһͨ
+	std::vector<uint32> loads(numShards, 0);
+	g_sendEncryptQueueDepths.assign(numShards, 0);
+
+	std::vector<Channel*>::const_iterator iter = channels.begin();
+	for (; iter != channels.end(); ++iter)
+	{
+		Channel* pChannel = (*iter);
+
+		uint32 numPackets = 0;
+		Channel::Bundles::const_iterator bundleIter = pChannel->bundles().begin();
+		for (; bundleIter != pChannel->bundles().end(); ++bundleIter)
+			numPackets += (uint32)(*bundleIter)->packets().size();
+
+		uint32 shard = 0;
+		for (uint32 i = 1; i < numShards; ++i)
+		{
+			if (loads[i] < loads[shard])
+				shard = i;
+		}
+
+		loads[shard] += numPackets + 1;
+		g_sendEncryptQueueDepths[shard] += numPackets;
+
+		if (shard == numShards - 1)
+			mainChannels.push_back(pChannel);
+		else
+			tasks[shard]->channels().push_back(pChannel);
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		numPendingShards_ = (uint32)tasks.size();
+		numPreparedPackets_ = 0;
+		completedShards_.clear();
+	}
+
+	std::vector<SendEncryptTask*>::iterator taskIter = tasks.begin();
+	for (; taskIter != tasks.end(); ++taskIter)
+		pThreadPool_->addTask((*taskIter));
+
+	uint32 numPackets = prepareChannels(mainChannels);
+
+	{
+		std::lock_guard<std::mutex> lock(mutex_);
+		numPreparedPackets_ += numPackets;
+	}
+
+	if (numPendingShards_ == 0)
+		onFinished();
+
+	return true;
+}
+
+//-------------------------------------------------------------------------------------
+bool SendEncryptStage::waitShard(std::vector<Channel*>& channels)
+{
+	channels.clear();
+
+	if (numPendingShards_ == 0)
+		return false;
+
+	uint64 waitStartTime = timestamp();
+
+	{
+		std::unique_lock<std::mutex> lock(mutex_);
+		while (completedShards_.size() == 0)
+			cond_.wait(lock);
+
+		// ֻ̻߳ȡͨ onMainThreadTick֮ǰᱻɾ
+		channels.swap(completedShards_.back()->channels());
+		completedShards_.pop_back();
+		--numPendingShards_;
+	}
+
+	waitTime_ += timestamp() - waitStartTime;
+
+	if (numPendingShards_ == 0)
+		onFinished();
+
+	return true;
+}
+
+//-------------------------------------------------------------------------------------
+void SendEncryptStage::onFinished()
+{
+	uint64 endTime = timestamp();
+
+	++g_sendEncryptFlushes;
+	g_sendEncryptPackets += numPreparedPackets_;
+	g_sendEncryptWaitTime = waitTime_ * 1000000 / stampsPerSecond();
+	g_sendEncryptFlushTime = (endTime - startTime_) * 1000000 / stampsPerSecond();
+
+	// ɾѾɵ
+	pThreadPool_->onMainThreadTick();
+}
+
+//-------------------------------------------------------------------------------------
+}
+}
@@ -0,0 +1,68 @@
+// Copyright 2008-2018 Yolo Technologies, Inc. All Rights Reserved. https://www.comblockengine.com
+
+#ifndef KBE_SEND_ENCRYPT_STAGE_H
+#define KBE_SEND_ENCRYPT_STAGE_H
+
+#include "common/common.h"
+#include <mutex>
+#include <condition_variable>
+
+namespace KBEngine{
+namespace thread
+{
+class ThreadPool;
+}
+
+namespace Network
+{
+class Channel;
+class SendEncryptTask;
+
+/*
+	ⲿͨĲзͼܽ׶
+	DelayedChannelsˢʱͨ͵İƬ һֵֻͨһƬ ͬһͨİȻ˳
+	ֻ߳ͨPacketFilter::prepareSend԰ԭؼܣ ߳ÿȡһɵķƬͰԭдsocket
+	صȴķƬ
+*/
+class SendEncryptStage
+{
+public:
+	SendEncryptStage();
+	~SendEncryptStage();
+
+	/**
+		ͨƬ̼߳ܣ һƬ߳Լ ʱƬѾɲmainChannels
+		falseʾûụ̀߳ ͨҪsendм
+	*/
+	bool start(const std::vector<Channel*>& channels, std::vector<Channel*>& mainChannels);
+
+	/**
+		ȴһɵķƬȡͨ зƬȡʱfalse
+	*/
+	bool waitShard(std::vector<Channel*>& channels);
+
+	void onShardCompleted(SendEncryptTask* pTask, uint32 numPackets);
+
+	static uint32 prepareChannels(const std::vector<Channel*>& channels);
+
+private:
+	bool initialize();
+	void onFinished();
+
+	thread::ThreadPool* pThreadPool_;
+
+	std::mutex mutex_;
+	std::condition_variable cond_;
+
+	// ûб߳ȡĹ̷߳Ƭ
+	uint32 numPendingShards_;
+	std::vector<SendEncryptTask*> completedShards_;
+	uint32 numPreparedPackets_;
+
+	uint64 startTime_;
+	uint64 waitTime_;
+};
+
+}
+}
+#endif // KBE_SEND_ENCRYPT_STAGE_H
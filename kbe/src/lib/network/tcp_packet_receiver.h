@@ -38,6 +38,9 @@ public:
 
 	Reason processFilteredPacket(Channel* pChannel, Packet * pPacket);
 
+	/** ÿͨռsocket handleInputNotificationǶEAGAINΪֹ */
+	virtual bool drainsInput() const { return true; }
+
 protected:
 	virtual bool processRecv(bool expectingPacket);
 	PacketReceiver::RecvState checkSocketErrors(int len, bool expectingPacket);
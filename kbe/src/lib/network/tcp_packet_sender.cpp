@@ -44,6 +44,7 @@ void TCPPacketSender::reclaimPoolObject(TCPPacketSender* obj)
 void TCPPacketSender::onReclaimObject()
 {
 	sendfailCount_ = 0;
+	gathering_ = false;
 }
 
 //-------------------------------------------------------------------------------------
@@ -65,7 +66,8 @@ TCPPacketSender::SmartPoolObjectPtr TCPPacketSender::createSmartPoolObj(const st
 TCPPacketSender::TCPPacketSender(EndPoint & endpoint,
 	   NetworkInterface & networkInterface	) :
 	PacketSender(endpoint, networkInterface),
-	sendfailCount_(0)
+	sendfailCount_(0),
+	gathering_(false)
 {
 }
 
@@ -102,6 +104,78 @@ bool TCPPacketSender::processSend(Channel* pChannel, int userarg)
 		return false;
 	}
 	
+	Reason reason = REASON_SUCCESS;
+
+#if KBE_PLATFORM == PLATFORM_UNIX
+	// sslҪд룬 ֻ
+	if (g_vectoredSend && !pChannel->pEndPoint()->isSSL())
+		reason = processGatherSend(pChannel, userarg);
+	else
+#endif
+		reason = processPacketsSend(pChannel, userarg);
+
+	if (reason != REASON_SUCCESS)
+	{
+		if (reason == REASON_RESOURCE_UNAVAILABLE)
+		{
+			/* ˴ܻdebugHelper
+				WARNING_MSG(fmt::format("TCPPacketSender::processSend: "
+					"Transmit queue full, waiting for space(kbengine.xml->channelCommon->writeBufferSize->{})...\n",
+					(pChannel->isInternal() ? "internal" : "external")));
+			*/
+
+			// 10֪ͨ
+			if (++sendfailCount_ >= 10 && pChannel->isExternal())
+			{
+				onGetError(pChannel, "TCPPacketSender::processSend: sendfailCount >= 10");
+
+				this->dispatcher().errorReporter().reportException(reason, pEndpoint_->addr(), 
+					fmt::format("TCPPacketSender::processSend(external, sendfailCount({}) >= 10)", (int)sendfailCount_).c_str());
+			}
+			else
+			{
+				this->dispatcher().errorReporter().reportException(reason, pEndpoint_->addr(), 
+					fmt::format("TCPPacketSender::processSend({}, {})", (pChannel->isInternal() ? "internal" : "external"), (int)sendfailCount_).c_str());
+			}
+		}
+		else
+		{
+			if (pChannel->isExternal())
+			{
+#if KBE_PLATFORM == PLATFORM_UNIX
+				this->dispatcher().errorReporter().reportException(reason, pEndpoint_->addr(), "TCPPacketSender::processSend(external)",
+					fmt::format(", errno: {}", errno).c_str());
+#else
+				this->dispatcher().errorReporter().reportException(reason, pEndpoint_->addr(), "TCPPacketSender::processSend(external)",
+					fmt::format(", errno: {}", WSAGetLastError()).c_str());
+#endif
+			}
+			else
+			{
+#if KBE_PLATFORM == PLATFORM_UNIX
+				this->dispatcher().errorReporter().reportException(reason, pEndpoint_->addr(), "TCPPacketSender::processSend(internal)",
+					fmt::format(", errno: {}, {}", errno, pChannel->c_str()).c_str());
+#else
+				this->dispatcher().errorReporter().reportException(reason, pEndpoint_->addr(), "TCPPacketSender::processSend(internal)",
+					fmt::format(", errno: {}, {}", WSAGetLastError(), pChannel->c_str()).c_str());
+#endif
+			}
+
+			onGetError(pChannel, fmt::format("TCPPacketSender::processSend: errno={}", kbe_lasterror()));
+		}
+
+		return false;
+	}
+
+	if(noticed)
+		pChannel->onSendCompleted();
+
+	return true;
+}
+
+//-------------------------------------------------------------------------------------
+Reason TCPPacketSender::processPacketsSend(Channel* pChannel, int userarg)
+{
 	Channel::Bundles& bundles = pChannel->bundles();
 	Reason reason = REASON_SUCCESS;
 
@@ -129,66 +203,154 @@ bool TCPPacketSender::processSend(Channel* pChannel, int userarg)
 		{
 			pakcets.erase(pakcets.begin(), iter1);
 			bundles.erase(bundles.begin(), iter);
+			return reason;
+		}
+	}
+
+	bundles.clear();
+	return REASON_SUCCESS;
+}
+
+#if KBE_PLATFORM == PLATFORM_UNIX
+//-------------------------------------------------------------------------------------
+Reason TCPPacketSender::processGatherSend(Channel* pChannel, int userarg)
+{
+	Channel::Bundles& bundles = pChannel->bundles();
+	EndPoint* pEndpoint = pChannel->pEndPoint();
+	Reason reason = REASON_SUCCESS;
+
+	struct iovec iov[MAX_GATHER_PACKETS];
+
+	// Ѿbundle ԼһδbundleѾİ
+	size_t sentBundles = 0;
+	size_t sentPackets = 0;
+
+	while (true)
+	{
+		while (sentBundles < bundles.size() && sentPackets >= bundles[sentBundles]->packets().size())
+		{
+			++sentBundles;
+			sentPackets = 0;
+		}
+
+		if (sentBundles >= bundles.size())
+			break;
+
+		if (pChannel->condemn() == Channel::FLAG_CONDEMN_AND_DESTROY)
+		{
+			reason = REASON_CHANNEL_CONDEMN;
+			break;
+		}
+
+		// ռ͵İ ֱڰϴ(ܵ) Ѿһֵİֻռʣ
+		int iovcnt = 0;
+		size_t bundleIdx = sentBundles;
+		size_t packetIdx = sentPackets;
+		Reason filterReason = REASON_SUCCESS;
 
-			if (reason == REASON_RESOURCE_UNAVAILABLE)
+		while (bundleIdx < bundles.size() && iovcnt < MAX_GATHER_PACKETS)
+		{
+			Bundle::Packets& packets = bundles[bundleIdx]->packets();
+			if (packetIdx >= packets.size())
 			{
-				/* ˴ܻdebugHelper
-					WARNING_MSG(fmt::format("TCPPacketSender::processSend: "
-						"Transmit queue full, waiting for space(kbengine.xml->channelCommon->writeBufferSize->{})...\n",
-						(pChannel->isInternal() ? "internal" : "external")));
-				*/
-
-				// 10֪ͨ
-				if (++sendfailCount_ >= 10 && pChannel->isExternal())
-				{
-					onGetError(pChannel, "TCPPacketSender::processSend: sendfailCount >= 10");
-
-					this->dispatcher().errorReporter().reportException(reason, pEndpoint_->addr(), 
-						fmt::format("TCPPacketSender::processSend(external, sendfailCount({}) >= 10)", (int)sendfailCount_).c_str());
-				}
-				else
-				{
-					this->dispatcher().errorReporter().reportException(reason, pEndpoint_->addr(), 
-						fmt::format("TCPPacketSender::processSend({}, {})", (pChannel->isInternal() ? "internal" : "external"), (int)sendfailCount_).c_str());
-				}
+				++bundleIdx;
+				packetIdx = 0;
+				continue;
 			}
-			else
-			{
-				if (pChannel->isExternal())
-				{
-#if KBE_PLATFORM == PLATFORM_UNIX
-					this->dispatcher().errorReporter().reportException(reason, pEndpoint_->addr(), "TCPPacketSender::processSend(external)",
-						fmt::format(", errno: {}", errno).c_str());
-#else
-					this->dispatcher().errorReporter().reportException(reason, pEndpoint_->addr(), "TCPPacketSender::processSend(external)",
-						fmt::format(", errno: {}", WSAGetLastError()).c_str());
-#endif
-				}
-				else
-				{
-#if KBE_PLATFORM == PLATFORM_UNIX
-					this->dispatcher().errorReporter().reportException(reason, pEndpoint_->addr(), "TCPPacketSender::processSend(internal)",
-						fmt::format(", errno: {}, {}", errno, pChannel->c_str()).c_str());
-#else
-					this->dispatcher().errorReporter().reportException(reason, pEndpoint_->addr(), "TCPPacketSender::processSend(internal)",
-						fmt::format(", errno: {}, {}", WSAGetLastError(), pChannel->c_str()).c_str());
-#endif
-				}
 
-				onGetError(pChannel, fmt::format("TCPPacketSender::processSend: errno={}", kbe_lasterror()));
+			Packet* pPacket = packets[packetIdx];
+
+			gathering_ = true;
+			filterReason = processPacket(pChannel, pPacket, userarg);
+			gathering_ = false;
+
+			if (filterReason != REASON_SUCCESS)
+				break;
+
+			iov[iovcnt].iov_base = pPacket->data() + pPacket->rpos() + pPacket->sentSize;
+			iov[iovcnt].iov_len = pPacket->length() - pPacket->sentSize;
+			++iovcnt;
+			++packetIdx;
+		}
+
+		if (iovcnt == 0)
+		{
+			reason = filterReason;
+			break;
+		}
+
+		int len = pEndpoint->sendv(iov, iovcnt);
+		if (len <= 0)
+		{
+			reason = checkSocketErrors(pEndpoint);
+			break;
+		}
+
+		// дֽμ¼ϣ İ
+		size_t written = (size_t)len;
+		int i = 0;
+
+		for (; i < iovcnt; ++i)
+		{
+			while (sentPackets >= bundles[sentBundles]->packets().size())
+			{
+				++sentBundles;
+				sentPackets = 0;
 			}
 
-			return false;
+			Packet* pPacket = bundles[sentBundles]->packets()[sentPackets];
+			size_t size = KBE_MIN(written, iov[i].iov_len);
+			bool sentCompleted = size == iov[i].iov_len;
+
+			written -= size;
+			pPacket->sentSize += size;
+			pChannel->onPacketSent((int)size, sentCompleted);
+
+			if (!sentCompleted)
+				break;
+
+			RECLAIM_PACKET(bundles[sentBundles]->isTCPPacket(), pPacket);
+			++sentPackets;
+		}
+
+		// ֻһݣΪREASON_RESOURCE_UNAVAILABLE
+		if (i < iovcnt)
+		{
+			reason = REASON_RESOURCE_UNAVAILABLE;
+			break;
+		}
+
+		if (filterReason != REASON_SUCCESS)
+		{
+			reason = filterReason;
+			break;
 		}
 	}
 
-	bundles.clear();
+	for (size_t i = 0; i < sentBundles; ++i)
+	{
+		bundles[i]->packets().clear();
+		Network::Bundle::reclaimPoolObject(bundles[i]);
+	}
 
-	if(noticed)
-		pChannel->onSendCompleted();
+	if (sentBundles > 0)
+		sendfailCount_ = 0;
 
-	return true;
+	if (sentBundles >= bundles.size())
+	{
+		bundles.clear();
+	}
+	else
+	{
+		bundles.erase(bundles.begin(), bundles.begin() + sentBundles);
+
+		Bundle::Packets& packets = bundles.front()->packets();
+		packets.erase(packets.begin(), packets.begin() + sentPackets);
+	}
+
+	return reason;
 }
+#endif
 
 //-------------------------------------------------------------------------------------
 Reason TCPPacketSender::processFilterPacket(Channel* pChannel, Packet * pPacket, int userarg)
@@ -198,8 +360,12 @@ Reason TCPPacketSender::processFilterPacket(Channel* pChannel, Packet * pPacket,
 		return REASON_CHANNEL_CONDEMN;
 	}
 
+	// ϲʱprocessGatherSendͳһд
+	if (gathering_)
+		return REASON_SUCCESS;
+
 	EndPoint* pEndpoint = pChannel->pEndPoint();
-	int len = pEndpoint->send(pPacket->data() + pPacket->sentSize, pPacket->length() - pPacket->sentSize);
+	int len = pEndpoint->send(pPacket->data() + pPacket->rpos() + pPacket->sentSize, pPacket->length() - pPacket->sentSize);
 
 	if(len > 0)
 	{
@@ -33,7 +33,10 @@ public:
 	virtual void onReclaimObject();
 	static void destroyObjPool();
 	
-	TCPPacketSender():PacketSender(){}
+	// һwritevϲİ
+	enum { MAX_GATHER_PACKETS = 64 };
+
+	TCPPacketSender():PacketSender(), sendfailCount_(0), gathering_(false){}
 	TCPPacketSender(EndPoint & endpoint, NetworkInterface & networkInterface);
 	virtual ~TCPPacketSender();
 
@@ -48,7 +51,22 @@ public:
 protected:
 	virtual Reason processFilterPacket(Channel* pChannel, Packet * pPacket, int userarg);
 
+	/**
+		ͨϵbundles
+	*/
+	Reason processPacketsSend(Channel* pChannel, int userarg);
+
+#if KBE_PLATFORM == PLATFORM_UNIX
+	/**
+		ͨд͵İϲ ͨһwritev
+	*/
+	Reason processGatherSend(Channel* pChannel, int userarg);
+#endif
+
 	uint8 sendfailCount_;
+
+	// ϲʱֻù(ܵ) processGatherSendͳһдsocket
+	bool gathering_;
 };
 }
 }
@@ -74,9 +74,15 @@ Channel* UDPPacketReceiver::findChannel(const Address& addr)
 //-------------------------------------------------------------------------------------
 bool UDPPacketReceiver::processRecv(bool expectingPacket)
 {	
+#if KBE_PLATFORM == PLATFORM_UNIX
+	if (g_recvBatchSize > 1)
+		return processRecvBatch(expectingPacket);
+#endif
+
 	Address	srcAddr;
 	UDPPacket* pChannelReceiveWindow = UDPPacket::createPoolObject(OBJECTPOOL_POINT);
 	int len = pChannelReceiveWindow->recvFromEndPoint(*pEndpoint_, &srcAddr);
+	++g_udpRecvSyscalls;
 
 	if (len <= 0)
 	{
@@ -85,6 +91,90 @@ bool UDPPacketReceiver::processRecv(bool expectingPacket)
 		return rstate == PacketReceiver::RECV_STATE_CONTINUE;
 	}
 	
+	++g_udpRecvDatagrams;
+
+	Channel* pSrcChannel = findOrCreateChannel(srcAddr);
+	if (pSrcChannel == NULL || pSrcChannel->condemn() > 0)
+	{
+		UDPPacket::reclaimPoolObject(pChannelReceiveWindow);
+		return false;
+	}
+	
+	return ((UDPPacketReceiver*)pSrcChannel->pPacketReceiver())->processRecv(pChannelReceiveWindow);
+}
+
+#if KBE_PLATFORM == PLATFORM_UNIX
+//-------------------------------------------------------------------------------------
+bool UDPPacketReceiver::processRecvBatch(bool expectingPacket)
+{
+	// ԤȷĽջ ֻ߳нգ udp߹һ
+	static std::vector<char> buffers;
+	static std::vector<struct mmsghdr> msgs;
+	static std::vector<struct iovec> iovs;
+	static std::vector<sockaddr_in> addrs;
+
+	const size_t bufferSize = UDPPacket::maxBufferSize();
+	const size_t vlen = g_recvBatchSize;
+
+	if (msgs.size() != vlen)
+	{
+		buffers.resize(vlen * bufferSize);
+		msgs.resize(vlen);
+		iovs.resize(vlen);
+		addrs.resize(vlen);
+
+		for (size_t i = 0; i < vlen; ++i)
+		{
+			iovs[i].iov_base = &buffers[i * bufferSize];
+			iovs[i].iov_len = bufferSize;
+		}
+	}
+
+	memset(&msgs[0], 0, sizeof(struct mmsghdr) * vlen);
+
+	for (size_t i = 0; i < vlen; ++i)
+	{
+		msgs[i].msg_hdr.msg_name = &addrs[i];
+		msgs[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+		msgs[i].msg_hdr.msg_iov = &iovs[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	int count = pEndpoint_->recvmmsg(&msgs[0], (unsigned int)vlen);
+	++g_udpRecvSyscalls;
+
+	if (count <= 0)
+	{
+		PacketReceiver::RecvState rstate = this->checkSocketErrors(count, expectingPacket);
+		return rstate == PacketReceiver::RECV_STATE_CONTINUE;
+	}
+
+	g_udpRecvDatagrams += count;
+
+	for (int i = 0; i < count; ++i)
+	{
+		int len = (int)msgs[i].msg_len;
+		if (len <= 0)
+			continue;
+
+		Address srcAddr(addrs[i].sin_addr.s_addr, addrs[i].sin_port);
+		Channel* pSrcChannel = findOrCreateChannel(srcAddr);
+
+		// ĳͨӰͬһͨ
+		if (pSrcChannel == NULL || pSrcChannel->condemn() > 0)
+			continue;
+
+		((UDPPacketReceiver*)pSrcChannel->pPacketReceiver())->processRecv((const char*)iovs[i].iov_base, len);
+	}
+
+	// ûȡ˵socketѾûˣ ٳһ
+	return count == (int)vlen;
+}
+#endif
+
+//-------------------------------------------------------------------------------------
+Channel* UDPPacketReceiver::findOrCreateChannel(const Address& srcAddr)
+{
 	Channel* pSrcChannel = findChannel(srcAddr);
 
 	if(pSrcChannel == NULL) 
@@ -97,7 +187,7 @@ bool UDPPacketReceiver::processRecv(bool expectingPacket)
 		bool ret = pSrcChannel->initialize(*pNetworkInterface_, pNewEndPoint, Channel::EXTERNAL, PROTOCOL_UDP, protocolSubType());
 		if(!ret)
 		{
-			ERROR_MSG(fmt::format("UDPPacketReceiver::processRecv: initialize({}) is failed!\n",
+			ERROR_MSG(fmt::format("UDPPacketReceiver::findOrCreateChannel: initialize({}) is failed!\n",
 				pSrcChannel->c_str()));
 
 			if (pSrcChannel->pEndPoint() != pNewEndPoint)
@@ -105,31 +195,32 @@ bool UDPPacketReceiver::processRecv(bool expectingPacket)
 
 			pSrcChannel->destroy();
 			Network::Channel::reclaimPoolObject(pSrcChannel);
-			UDPPacket::reclaimPoolObject(pChannelReceiveWindow);
-			return false;
+			return NULL;
 		}
 
 		if(!pNetworkInterface_->registerChannel(pSrcChannel))
 		{
-			ERROR_MSG(fmt::format("UDPPacketReceiver::processRecv: registerChannel({}) is failed!\n",
+			ERROR_MSG(fmt::format("UDPPacketReceiver::findOrCreateChannel: registerChannel({}) is failed!\n",
 				pSrcChannel->c_str()));
 
-			UDPPacket::reclaimPoolObject(pChannelReceiveWindow);
 			pSrcChannel->destroy();
 			Network::Channel::reclaimPoolObject(pSrcChannel);
-			return false;
+			return NULL;
 		}
 	}
 	
 	KBE_ASSERT(pSrcChannel != NULL);
+	return pSrcChannel;
+}
 
-	if (pSrcChannel->condemn() > 0)
-	{
-		UDPPacket::reclaimPoolObject(pChannelReceiveWindow);
-		return false;
-	}
-	
-	return ((UDPPacketReceiver*)pSrcChannel->pPacketReceiver())->processRecv(pChannelReceiveWindow);
+//-------------------------------------------------------------------------------------
+bool UDPPacketReceiver::processRecv(const char* data, int len)
+{
+	UDPPacket* pReceiveWindow = UDPPacket::createPoolObject(OBJECTPOOL_POINT);
+	memcpy(pReceiveWindow->data(), data, len);
+	pReceiveWindow->wpos(len);
+
+	return processRecv(pReceiveWindow);
 }
 
 //-------------------------------------------------------------------------------------
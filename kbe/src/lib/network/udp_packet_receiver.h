@@ -49,11 +49,28 @@ public:
 	virtual bool processRecv(UDPPacket* pReceiveWindow);
 	virtual bool processRecv(bool expectingPacket);
 
+	/**
+		ջеһݱ ĬϸƵUDPPacketнprocessRecv(UDPPacket*)
+	*/
+	virtual bool processRecv(const char* data, int len);
+
 	virtual Channel* findChannel(const Address& addr);
 
 protected:
 	PacketReceiver::RecvState checkSocketErrors(int len, bool expectingPacket);
 
+	/**
+		ҵݱԴͨ 򴴽
+	*/
+	Channel* findOrCreateChannel(const Address& srcAddr);
+
+#if KBE_PLATFORM == PLATFORM_UNIX
+	/**
+		ͨrecvmmsgһνնݱ ηַԵͨ
+	*/
+	bool processRecvBatch(bool expectingPacket);
+#endif
+
 protected:
 
 };
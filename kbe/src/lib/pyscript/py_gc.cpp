@@ -5,11 +5,14 @@
 #include "scriptstdouterr.h"
 #include "py_macros.h"
 #include "helper/profile.h"
+#include "helper/watcher.h"
 
 namespace KBEngine{ namespace script {
 
 PyObject* PyGC::collectMethod_ = NULL;
 PyObject* PyGC::set_debugMethod_ = NULL;
+PyObject* PyGC::get_countMethod_ = NULL;
+PyObject* PyGC::freezeMethod_ = NULL;
 KBEUnordered_map<std::string, int> PyGC::tracingCountMap_;
 
 uint32 PyGC::DEBUG_STATS = 0;
@@ -20,6 +23,20 @@ uint32 PyGC::DEBUG_LEAK = 0;
 	
 bool PyGC::isInit = false;
 
+bool PyGC::schedulerEnabled_ = false;
+bool PyGC::needFreeze_ = false;
+uint64 PyGC::fullPeriod_ = 0;
+uint64 PyGC::lastFullTime_ = 0;
+int PyGC::thresholds_[PyGC::NUM_GENERATIONS] = {0, 0, 0};
+uint32 PyGC::numFrozen_ = 0;
+
+bool PyGC::inScheduledCollect_ = false;
+uint64 PyGC::collectStartTime_ = 0;
+PyGC::CollectStats PyGC::collectStats_[PyGC::NUM_GENERATIONS];
+
+// ͣʱֲĸ() һͰռ
+static const uint32 PAUSE_BUCKET_LIMITS[PyGC::NUM_PAUSE_BUCKETS - 1] = {1, 2, 5, 10, 20, 50, 100, 200, 500};
+
 
 //-------------------------------------------------------------------------------------
 bool PyGC::initialize(void)
@@ -112,6 +129,36 @@ bool PyGC::initialize(void)
 			flag = NULL;
 		}
 
+		get_countMethod_ = PyObject_GetAttrString(gcModule, "get_count");
+		if (!get_countMethod_)
+		{
+			ERROR_MSG("PyGC::initialize: get get_count error!\n");
+			PyErr_PrintEx(0);
+		}
+
+		// python3.7Ժ
+		freezeMethod_ = PyObject_GetAttrString(gcModule, "freeze");
+		if (!freezeMethod_)
+			PyErr_Clear();
+
+		memset(collectStats_, 0, sizeof(collectStats_));
+
+		PyObject* pyCallbacks = PyObject_GetAttrString(gcModule, "callbacks");
+		if (pyCallbacks && PyList_Check(pyCallbacks))
+		{
+			static PyMethodDef __pymethod_onCollect = {"onCollect", (PyCFunction)__py_onCollect, METH_VARARGS, NULL};
+			PyObject* pyOnCollect = PyCFunction_New(&__pymethod_onCollect, NULL);
+			PyList_Append(pyCallbacks, pyOnCollect);
+			Py_DECREF(pyOnCollect);
+		}
+		else
+		{
+			ERROR_MSG("PyGC::initialize: get callbacks error!\n");
+			PyErr_PrintEx(0);
+		}
+
+		Py_XDECREF(pyCallbacks);
+
 		APPEND_SCRIPT_MODULE_METHOD(gcModule, debugTracing,	__py_debugTracing,	METH_VARARGS, 0);
 
 		Py_DECREF(gcModule);
@@ -131,9 +178,14 @@ void PyGC::finalise(void)
 {
 	Py_XDECREF(collectMethod_);
 	Py_XDECREF(set_debugMethod_);
+	Py_XDECREF(get_countMethod_);
+	Py_XDECREF(freezeMethod_);
 	
 	collectMethod_ = NULL;
 	set_debugMethod_ = NULL;	
+	get_countMethod_ = NULL;
+	freezeMethod_ = NULL;
+	schedulerEnabled_ = false;
 }
 
 //-------------------------------------------------------------------------------------
@@ -227,6 +279,274 @@ PyObject* PyGC::__py_debugTracing(PyObject* self, PyObject* args)
 	S_Return;
 }
 
+//-------------------------------------------------------------------------------------
+bool PyGC::initializeScheduler(bool freeze, float fullPeriod)
+{
+	if (!isInit || !get_countMethod_)
+		return false;
+
+	PyObject* gcModule = PyImport_ImportModule("gc");
+	if (!gcModule)
+	{
+		SCRIPT_ERROR_CHECK();
+		return false;
+	}
+
+	PyObject* pyThresholds = PyObject_CallMethod(gcModule, const_cast<char*>("get_threshold"), const_cast<char*>(""));
+	if (!pyThresholds || !PyArg_ParseTuple(pyThresholds, "iii", &thresholds_[0], &thresholds_[1], &thresholds_[2]))
+	{
+		SCRIPT_ERROR_CHECK();
+		Py_XDECREF(pyThresholds);
+		Py_DECREF(gcModule);
+		return false;
+	}
+
+	Py_DECREF(pyThresholds);
+
+	// 01ȻֵԶԷtickڷ࣬ 2ļԶﲻֵ ֻɵ
+	PyObject* pyRet = PyObject_CallMethod(gcModule, const_cast<char*>("set_threshold"), 
+		const_cast<char*>("iii"), thresholds_[0], thresholds_[1], INT_MAX);
+
+	SCRIPT_ERROR_CHECK();
+	Py_XDECREF(pyRet);
+	Py_DECREF(gcModule);
+
+	if (!pyRet)
+		return false;
+
+	if (freeze && !freezeMethod_)
+		WARNING_MSG("PyGC::initializeScheduler: gc.freeze is not supported!\n");
+
+	schedulerEnabled_ = true;
+	needFreeze_ = freeze && freezeMethod_;
+	fullPeriod_ = uint64(fullPeriod * stampsPerSecond());
+	lastFullTime_ = timestamp();
+
+	INFO_MSG(fmt::format("PyGC::initializeScheduler: thresholds=({}, {}, {}), freeze={}, fullPeriod={}s\n",
+		thresholds_[0], thresholds_[1], thresholds_[2], needFreeze_, fullPeriod));
+
+	return true;
+}
+
+//-------------------------------------------------------------------------------------
+void PyGC::freeze()
+{
+	needFreeze_ = false;
+
+	// ڼ ʣµĶô Ժղɨ
+	scheduledCollect(NUM_GENERATIONS - 1);
+
+	PyObject* pyRet = PyObject_CallFunction(freezeMethod_, const_cast<char*>(""));
+	SCRIPT_ERROR_CHECK();
+	Py_XDECREF(pyRet);
+
+	PyObject* gcModule = PyImport_ImportModule("gc");
+	if (gcModule)
+	{
+		pyRet = PyObject_CallMethod(gcModule, const_cast<char*>("get_freeze_count"), const_cast<char*>(""));
+		if (pyRet)
+		{
+			numFrozen_ = (uint32)PyLong_AsUnsignedLong(pyRet);
+			Py_DECREF(pyRet);
+		}
+
+		Py_DECREF(gcModule);
+	}
+
+	SCRIPT_ERROR_CHECK();
+
+	INFO_MSG(fmt::format("PyGC::freeze: {} objects frozen.\n", numFrozen_));
+}
+
+//-------------------------------------------------------------------------------------
+void PyGC::scheduledCollect(int generation)
+{
+	inScheduledCollect_ = true;
+	collect((int8)generation);
+	inScheduledCollect_ = false;
+}
+
+//-------------------------------------------------------------------------------------
+void PyGC::onTickEnd(uint64 deadline)
+{
+	if (!schedulerEnabled_)
+		return;
+
+	AUTO_SCOPED_PROFILE("pyGC");
+
+	// һtickʱűѾȫ
+	if (needFreeze_)
+	{
+		freeze();
+		lastFullTime_ = timestamp();
+		return;
+	}
+
+	uint64 now = timestamp();
+	if (now >= deadline)
+		return;
+
+	// һtickʼ֮ǰĿʱ䣬 ֻйĻպʱ(һθôյͣ)ŵ²Ż
+	uint64 budget = deadline - now;
+
+	if (fullPeriod_ > 0 && now - lastFullTime_ >= fullPeriod_)
+	{
+		// ʱ䶼û㹻ĿʱҲգ ѭõһֱѻ
+		bool overdue = now - lastFullTime_ >= fullPeriod_ * 4;
+
+		if (budget > collectStats_[NUM_GENERATIONS - 1].lastPause || overdue)
+		{
+			if (overdue)
+			{
+				WARNING_MSG(fmt::format("PyGC::onTickEnd: full collection is overdue, last pause {:.2f}ms, budget {:.2f}ms!\n",
+					collectStats_[NUM_GENERATIONS - 1].lastPause * 1000.0 / stampsPerSecond(), budget * 1000.0 / stampsPerSecond()));
+			}
+
+			scheduledCollect(NUM_GENERATIONS - 1);
+			lastFullTime_ = timestamp();
+			return;
+		}
+	}
+
+	PyObject* pyCounts = PyObject_CallFunction(get_countMethod_, const_cast<char*>(""));
+	int counts[NUM_GENERATIONS] = {0, 0, 0};
+
+	if (!pyCounts || !PyArg_ParseTuple(pyCounts, "iii", &counts[0], &counts[1], &counts[2]))
+	{
+		SCRIPT_ERROR_CHECK();
+		Py_XDECREF(pyCounts);
+		return;
+	}
+
+	Py_DECREF(pyCounts);
+
+	// ڴﵽԶյֵ֮ǰǰգ Ļվڿʱ
+	if (counts[1] >= thresholds_[1] / 2 && budget > collectStats_[1].lastPause)
+		scheduledCollect(1);
+	else if (counts[0] >= thresholds_[0] / 4 && budget > collectStats_[0].lastPause)
+		scheduledCollect(0);
+}
+
+//-------------------------------------------------------------------------------------
+PyObject* PyGC::__py_onCollect(PyObject* self, PyObject* args)
+{
+	char* phase = NULL;
+	PyObject* pyInfo = NULL;
+
+	if (!PyArg_ParseTuple(args, "sO", &phase, &pyInfo))
+		return NULL;
+
+	if (strcmp(phase, "start") == 0)
+	{
+		collectStartTime_ = timestamp();
+		S_Return;
+	}
+
+	if (collectStartTime_ == 0)
+		S_Return;
+
+	uint64 pause = timestamp() - collectStartTime_;
+	collectStartTime_ = 0;
+
+	int generation = NUM_GENERATIONS - 1;
+
+	PyObject* pyGeneration = PyDict_Check(pyInfo) ? PyDict_GetItemString(pyInfo, "generation") : NULL;
+	if (pyGeneration)
+		generation = (int)PyLong_AsLong(pyGeneration);
+
+	if (generation < 0 || generation >= NUM_GENERATIONS)
+	{
+		PyErr_Clear();
+		S_Return;
+	}
+
+	CollectStats& stats = collectStats_[generation];
+	uint64 us = pause * 1000000 / stampsPerSecond();
+
+	++stats.collections;
+	stats.totalTime += us;
+	stats.lastPause = pause;
+
+	if (us > stats.maxPause)
+		stats.maxPause = us;
+
+	if (inScheduledCollect_)
+		++stats.scheduled;
+
+	int bucket = 0;
+	for (; bucket < NUM_PAUSE_BUCKETS - 1; ++bucket)
+	{
+		if (us < PAUSE_BUCKET_LIMITS[bucket] * 1000)
+			break;
+	}
+
+	++stats.pauses[bucket];
+	S_Return;
+}
+
+//-------------------------------------------------------------------------------------
+std::string PyGC::pauseHistogram(int generation)
+{
+	std::string ret;
+	const CollectStats& stats = collectStats_[generation];
+
+	for (int i = 0; i < NUM_PAUSE_BUCKETS; ++i)
+	{
+		if (i > 0)
+			ret += " ";
+
+		if (i < NUM_PAUSE_BUCKETS - 1)
+			ret += fmt::format("<{}ms:{}", PAUSE_BUCKET_LIMITS[i], stats.pauses[i]);
+		else
+			ret += fmt::format(">={}ms:{}", PAUSE_BUCKET_LIMITS[i - 1], stats.pauses[i]);
+	}
+
+	return ret;
+}
+
+//-------------------------------------------------------------------------------------
+static std::string gen0PauseHistogram()
+{
+	return PyGC::pauseHistogram(0);
+}
+
+//-------------------------------------------------------------------------------------
+static std::string gen1PauseHistogram()
+{
+	return PyGC::pauseHistogram(1);
+}
+
+//-------------------------------------------------------------------------------------
+static std::string gen2PauseHistogram()
+{
+	return PyGC::pauseHistogram(2);
+}
+
+//-------------------------------------------------------------------------------------
+void PyGC::initializeWatcher()
+{
+	WATCH_OBJECT("gc/scheduler", schedulerEnabled_);
+	WATCH_OBJECT("gc/frozen", numFrozen_);
+
+	WATCH_OBJECT("gc/gen0/collections", collectStats_[0].collections);
+	WATCH_OBJECT("gc/gen0/scheduled", collectStats_[0].scheduled);
+	WATCH_OBJECT("gc/gen0/totalTime", collectStats_[0].totalTime);
+	WATCH_OBJECT("gc/gen0/maxPause", collectStats_[0].maxPause);
+	WATCH_OBJECT("gc/gen0/pauses", &gen0PauseHistogram);
+
+	WATCH_OBJECT("gc/gen1/collections", collectStats_[1].collections);
+	WATCH_OBJECT("gc/gen1/scheduled", collectStats_[1].scheduled);
+	WATCH_OBJECT("gc/gen1/totalTime", collectStats_[1].totalTime);
+	WATCH_OBJECT("gc/gen1/maxPause", collectStats_[1].maxPause);
+	WATCH_OBJECT("gc/gen1/pauses", &gen1PauseHistogram);
+
+	WATCH_OBJECT("gc/gen2/collections", collectStats_[2].collections);
+	WATCH_OBJECT("gc/gen2/scheduled", collectStats_[2].scheduled);
+	WATCH_OBJECT("gc/gen2/totalTime", collectStats_[2].totalTime);
+	WATCH_OBJECT("gc/gen2/maxPause", collectStats_[2].maxPause);
+	WATCH_OBJECT("gc/gen2/pauses", &gen2PauseHistogram);
+}
+
 //-------------------------------------------------------------------------------------
 
 }
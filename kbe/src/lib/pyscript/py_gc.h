@@ -53,12 +53,69 @@ public:
 	*/
 	static PyObject* __py_debugTracing(PyObject* self, PyObject* args);
 
+	/**
+		յȣ رԶĵ2գ ֮onTickEndtickĿʱ
+		@fullPeriod: յС() 0ΪԶ
+	*/
+	static bool initializeScheduler(bool freeze, float fullPeriod);
+
+	/**
+		ÿtickã deadlineΪһtickʼʱ
+	*/
+	static void onTickEnd(uint64 deadline);
+
+	static void initializeWatcher();
+
+	/**
+		gc.callbacksص ͳÿλյͣʱ
+	*/
+	static PyObject* __py_onCollect(PyObject* self, PyObject* args);
+
+	enum
+	{
+		NUM_GENERATIONS = 3,
+		NUM_PAUSE_BUCKETS = 10
+	};
+
+	struct CollectStats
+	{
+		uint64 collections;
+		uint64 scheduled;										// ɵĴ
+		uint64 totalTime;										// ΢
+		uint64 maxPause;										// ΢
+		uint64 lastPause;										// ʱλ ڹһλյĺʱ
+		uint64 pauses[NUM_PAUSE_BUCKETS];
+	};
+
+	static const CollectStats& collectStats(int generation){ return collectStats_[generation]; }
+
+	/**
+		ĳһͣʱķֲ "<1ms:10 <2ms:3 ..."
+	*/
+	static std::string pauseHistogram(int generation);
+
 private:
+	static void scheduledCollect(int generation);
+	static void freeze();
+
 	static PyObject* collectMethod_;							// cPicket.dumpsָ
 	static PyObject* set_debugMethod_;							// cPicket.loadsָ
+	static PyObject* get_countMethod_;
+	static PyObject* freezeMethod_;
 
 	static bool	isInit;											// ǷѾʼ
 
+	static bool schedulerEnabled_;
+	static bool needFreeze_;
+	static uint64 fullPeriod_;
+	static uint64 lastFullTime_;
+	static int thresholds_[NUM_GENERATIONS];
+	static uint32 numFrozen_;
+
+	static bool inScheduledCollect_;
+	static uint64 collectStartTime_;
+	static CollectStats collectStats_[NUM_GENERATIONS];
+
 	static KBEUnordered_map<std::string, int> tracingCountMap_;	// ׷ضĶ
 } ;
 
@@ -295,6 +295,9 @@ bool EntityApp<E>::initialize()
 	{
 		gameTimer_ = this->dispatcher().addTimer(1000000 / g_kbeSrvConfig.gameUpdateHertz(), this,
 								reinterpret_cast<void *>(TIMEOUT_GAME_TICK));
+
+		if (g_kbeSrvConfig.gc_scheduler_)
+			script::PyGC::initializeScheduler(g_kbeSrvConfig.gc_freeze_, g_kbeSrvConfig.gc_fullPeriod_);
 	}
 
 	lastTimestamp_ = timestamp();
@@ -305,6 +308,7 @@ template<class E>
 bool EntityApp<E>::initializeWatcher()
 {
 	WATCH_OBJECT("entitiesSize", this, &EntityApp<E>::entitiesSize);
+	script::PyGC::initializeWatcher();
 	return ServerApp::initializeWatcher();
 }
 
@@ -685,8 +689,14 @@ void EntityApp<E>::handleTimeout(TimerHandle handle, void * arg)
 	switch (reinterpret_cast<uintptr>(arg))
 	{
 		case TIMEOUT_GAME_TICK:
+		{
+			uint64 tickStartTime = timestamp();
 			this->handleGameTick();
+
+			// þһtickĿʱpython
+			script::PyGC::onTickEnd(tickStartTime + stampsPerSecond() / g_kbeSrvConfig.gameUpdateHertz());
 			break;
+		}
 		default:
 			break;
 	}
@@ -70,6 +70,8 @@ public:
 
 	void removeNextTick(std::string& accountName);
 
+	size_t size() const { return pPLMap_.size(); }
+
 private:
 	Network::NetworkInterface & networkInterface_;
 
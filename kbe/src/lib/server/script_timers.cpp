@@ -7,6 +7,7 @@
 #include "pyscript/script.h"
 #include "pyscript/pyobject_pointer.h"
 #include "common/smartpointer.h"
+#include "common/memorystream.h"
 
 namespace KBEngine
 {
@@ -15,14 +16,17 @@ ServerApp * g_pApp = NULL;
 ScriptTimers * g_pTimers = NULL;
 
 //-------------------------------------------------------------------------------------
-ScriptTimers::ScriptTimers()
+ScriptTimers::ScriptTimers():
+handles_(),
+freeIDs_(),
+ids_()
 {
 }
 
 //-------------------------------------------------------------------------------------
 ScriptTimers::~ScriptTimers()
 {
-	// DEBUG_MSG("ScriptTimers::~ScriptTimers: timers_size(%d).\n", map_.size());
+	// DEBUG_MSG("ScriptTimers::~ScriptTimers: timers_size(%d).\n", ids_.size());
 	cancelAll();
 }
 
@@ -73,9 +77,10 @@ ScriptID ScriptTimers::addTimer( float initialOffset,
 
 	if (timerHandle.isSet())
 	{
-		int id = this->getNewID();
+		ScriptID id = this->getNewID();
 
-		map_[ id ] = timerHandle;
+		handles_[id - 1] = timerHandle;
+		ids_[timerHandle.time()] = id;
 
 		return id;
 	}
@@ -86,24 +91,45 @@ ScriptID ScriptTimers::addTimer( float initialOffset,
 //-------------------------------------------------------------------------------------
 ScriptID ScriptTimers::getNewID()
 {
-	ScriptID id = 1;
+	if (!freeIDs_.empty())
+	{
+		std::pop_heap(freeIDs_.begin(), freeIDs_.end(), std::greater<ScriptID>());
+		ScriptID id = freeIDs_.back();
+		freeIDs_.pop_back();
+		return id;
+	}
 
-	while (map_.find( id ) != map_.end())
+	handles_.push_back(TimerHandle());
+	return (ScriptID)handles_.size();
+}
+
+//-------------------------------------------------------------------------------------
+void ScriptTimers::freeID(ScriptID id)
+{
+	handles_[id - 1] = TimerHandle();
+
+	// жʱͷţ ֱã һid´1ʼ
+	if (ids_.empty())
 	{
-		++id;
+		handles_.clear();
+		freeIDs_.clear();
+		return;
 	}
 
-	return id;
+	freeIDs_.push_back(id);
+	std::push_heap(freeIDs_.begin(), freeIDs_.end(), std::greater<ScriptID>());
 }
 
 //-------------------------------------------------------------------------------------
 bool ScriptTimers::delTimer(ScriptID timerID)
 {
-	Map::iterator iter = map_.find( timerID );
+	if (timerID < 1 || (size_t)timerID > handles_.size())
+		return false;
+
+	TimerHandle handle = handles_[timerID - 1];
 
-	if (iter != map_.end())
+	if (handle.isSet())
 	{
-		TimerHandle handle = iter->second;
 		handle.cancel();
 		return true;
 	}
@@ -114,71 +140,125 @@ bool ScriptTimers::delTimer(ScriptID timerID)
 //-------------------------------------------------------------------------------------
 void ScriptTimers::releaseTimer( TimerHandle handle )
 {
-	int numErased = 0;
+	IDMap::iterator iter = ids_.find( handle.time() );
+	KBE_ASSERT( iter != ids_.end() );
 
-	Map::iterator iter = map_.begin();
+	ScriptID id = iter->second;
+	ids_.erase( iter );
+	freeID( id );
+}
 
-	while (iter != map_.end())
+//-------------------------------------------------------------------------------------
+void ScriptTimers::cancelAll()
+{
+	// ȡʱͨreleaseTimerͷid ܻᱻã ÿζ¼С
+	for (size_t i = 0; i < handles_.size(); ++i)
 	{
-		KBE_ASSERT( iter->second.isSet() );
+		TimerHandle handle = handles_[i];
 
-		if (handle == iter->second)
+		if (handle.isSet())
 		{
-			map_.erase( iter++ );
-			++numErased;
-		}
-		else
-		{
-			iter++;
+			handle.cancel();
 		}
 	}
 
-	KBE_ASSERT( numErased == 1 );
+	KBE_ASSERT( ids_.empty() );
 }
 
 //-------------------------------------------------------------------------------------
-void ScriptTimers::cancelAll()
+ScriptID ScriptTimers::getIDForHandle(TimerHandle handle) const
 {
-	Map::size_type size = map_.size();
+	IDMap::const_iterator iter = ids_.find( handle.time() );
 
-	for (Map::size_type i = 0; i < size; ++i)
-	{
-		KBE_ASSERT( i + map_.size() == size );
-		TimerHandle handle = map_.begin()->second;
-		handle.cancel();
-	}
+	return (iter != ids_.end()) ? iter->second : 0;
 }
 
 //-------------------------------------------------------------------------------------
-ScriptID ScriptTimers::getIDForHandle(TimerHandle handle) const
+void ScriptTimers::directAddTimer(ScriptID tid, TimerHandle handle)
 {
-	Map::const_iterator iter = this->findTimer( handle );
+	KBE_ASSERT( tid > 0 );
+
+	if ((size_t)tid > handles_.size())
+	{
+		for (ScriptID id = (ScriptID)handles_.size() + 1; id < tid; ++id)
+		{
+			freeIDs_.push_back(id);
+			std::push_heap(freeIDs_.begin(), freeIDs_.end(), std::greater<ScriptID>());
+		}
 
-	return (iter != map_.end()) ? iter->first : 0;
+		handles_.resize(tid);
+	}
+	else if (handles_[tid - 1].isSet())
+	{
+		ids_.erase( handles_[tid - 1].time() );
+	}
+	else
+	{
+		std::vector<ScriptID>::iterator iter = std::find(freeIDs_.begin(), freeIDs_.end(), tid);
+		if (iter != freeIDs_.end())
+		{
+			freeIDs_.erase(iter);
+			std::make_heap(freeIDs_.begin(), freeIDs_.end(), std::greater<ScriptID>());
+		}
+	}
+
+	handles_[tid - 1] = handle;
+	ids_[handle.time()] = tid;
 }
 
 //-------------------------------------------------------------------------------------
-ScriptTimers::Map::const_iterator ScriptTimers::findTimer(TimerHandle handle) const
+void ScriptTimers::addToStream(MemoryStream& s) const
 {
-	Map::const_iterator iter = map_.begin();
+	KBE_ASSERT( g_pApp );
+
+	GAME_TIME now = g_pApp->time();
+	TimersBaseT<GAME_TIME>& timers = g_pApp->timers();
 
-	while (iter != map_.end())
+	uint32 size = (uint32)ids_.size();
+	s.reserve(s.wpos() + sizeof(uint32) + size * (sizeof(ScriptID) + sizeof(GAME_TIME) * 2 + sizeof(int32)));
+	s << size;
+
+	for (size_t i = 0; i < handles_.size(); ++i)
 	{
-		if (iter->second == handle)
-		{
-			return iter;
-		}
+		if (!handles_[i].isSet())
+			continue;
 
-		++iter;
-	}
+		GAME_TIME time = 0;
+		GAME_TIME interval = 0;
+		void* pUser = NULL;
+
+		timers.getTimerInfo(handles_[i], time, interval, pUser);
 
-	return iter;
+		// timerID, ʣtick, , û
+		s << ScriptID(i + 1) << GAME_TIME(time > now ? time - now : 0) << interval << int32(uintptr(pUser));
+	}
 }
 
 //-------------------------------------------------------------------------------------
-void ScriptTimers::directAddTimer(ScriptID tid, TimerHandle handle)
+void ScriptTimers::createFromStream(MemoryStream& s, HandlerFactory& factory)
 {
-	map_[tid] = handle;
+	KBE_ASSERT( g_pApp );
+
+	GAME_TIME now = g_pApp->time();
+	TimersBaseT<GAME_TIME>& timers = g_pApp->timers();
+
+	uint32 size;
+	s >> size;
+
+	for (uint32 i = 0; i < size; ++i)
+	{
+		ScriptID tid;
+		GAME_TIME remaining;
+		GAME_TIME interval;
+		int32 userData = 0;
+
+		s >> tid >> remaining >> interval >> userData;
+
+		TimerHandle timerHandle = timers.add(now + remaining, interval,
+				factory.createHandler(), (void *)(intptr_t)userData);
+
+		directAddTimer(tid, timerHandle);
+	}
 }
 
 //-------------------------------------------------------------------------------------
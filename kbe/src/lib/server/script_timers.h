@@ -11,9 +11,24 @@ namespace KBEngine
 class MemoryStream;
 class ServerApp;
 
+/**
+	űʱ
+	ʱidƽ̴(±Ϊid-1) еidһСУ
+	ʱȡСĿid ֮ǰ̽Ľһ£ Ҫ
+*/
 class ScriptTimers
 {
 public:
+	/**
+		лָʱʱΪÿʱ
+	*/
+	class HandlerFactory
+	{
+	public:
+		virtual ~HandlerFactory() {}
+		virtual TimerHandler* createHandler() = 0;
+	};
+
 	ScriptTimers();
 	~ScriptTimers();
 
@@ -30,21 +45,32 @@ public:
 
 	ScriptID getIDForHandle(TimerHandle handle) const;
 
-	bool isEmpty() const	{ return map_.empty(); }
-
-	typedef std::map<ScriptID, TimerHandle> Map;
+	bool isEmpty() const	{ return ids_.empty(); }
+	uint32 size() const		{ return (uint32)ids_.size(); }
 
-	ScriptTimers::Map& map(){ return map_; }
+	/**
+		лжʱ ʱ¼Ϊʣtick
+		Ϸʱ䲻ͬ(cellapp)Ҳȷָ
+	*/
+	void addToStream(MemoryStream& s) const;
+	void createFromStream(MemoryStream& s, HandlerFactory& factory);
 
 	void directAddTimer(ScriptID tid, TimerHandle handle);
 
 private:
-	
+
 	ScriptID getNewID();
-	Map::const_iterator findTimer(TimerHandle handle) const;
-	Map::iterator findTimer(TimerHandle handle);
+	void freeID(ScriptID id);
+
+	typedef std::vector<TimerHandle> Handles;
+	Handles handles_;
+
+	// idС
+	std::vector<ScriptID> freeIDs_;
 
-	Map map_;
+	// handleidķ
+	typedef KBEUnordered_map<TimeBase*, ScriptID> IDMap;
+	IDMap ids_;
 };
 
 
@@ -63,4 +89,4 @@ namespace ScriptTimersUtil
 }
 
 }
-#endif 
+#endif
@@ -10,6 +10,7 @@
 #include "network/bundle.h"
 #include "network/common.h"
 #include "common/memorystream.h"
+#include "common/timing_wheel.h"
 #include "helper/console_helper.h"
 #include "helper/sys_info.h"
 #include "helper/watch_pools.h"
@@ -47,13 +48,18 @@ componentType_(componentType),
 componentID_(componentID),
 dispatcher_(dispatcher),
 networkInterface_(ninterface),
-timers_(),
+pTimers_(NULL),
 startGlobalOrder_(-1),
 startGroupOrder_(-1),
 pShutdowner_(NULL),
 pActiveTimerHandle_(NULL),
 threadPool_()
 {
+	if (Network::g_timingWheel)
+		pTimers_ = new TimingWheelT<GAME_TIME>(1, g_kbetime);
+	else
+		pTimers_ = new Timers;
+
 	networkInterface_.pChannelTimeOutHandler(this);
 	networkInterface_.pChannelDeregisterHandler(this);
 
@@ -74,6 +80,7 @@ ServerApp::~ServerApp()
 {
 	SAFE_RELEASE(pActiveTimerHandle_);
 	SAFE_RELEASE(pShutdowner_);
+	SAFE_RELEASE(pTimers_);
 }
 
 //-------------------------------------------------------------------------------------	
@@ -82,7 +82,7 @@ public:
 	virtual void handleTimeout(TimerHandle, void * pUser);
 
 	GAME_TIME time() const { return g_kbetime; }
-	Timers & timers() { return timers_; }
+	TimersBaseT<GAME_TIME> & timers() { return *pTimers_; }
 	double gameTimeInSeconds() const;
 	void handleTimers();
 
@@ -184,7 +184,8 @@ protected:
 	Network::EventDispatcher& 								dispatcher_;	
 	Network::NetworkInterface&								networkInterface_;
 	
-	Timers													timers_;
+	// űʱϷʱʱĶʱ g_timingWheelǷʹʱ(Ϊ1tick)
+	TimersBaseT<GAME_TIME>*									pTimers_;
 
 	// app˳ globalΪȫ(dbmgrcellapp˳)˳ 
 	// groupΪ˳(:baseappΪһ)
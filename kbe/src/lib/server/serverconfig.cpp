@@ -36,6 +36,9 @@ ServerConfig::ServerConfig():
 	thread_init_create_(1),
 	thread_pre_create_(2),
 	thread_max_create_(8),
+	gc_scheduler_(false),
+	gc_freeze_(true),
+	gc_fullPeriod_(600.f),
 	emailServerInfo_(),
 	emailAtivationInfo_(),
 	emailResetPasswordInfo_(),
@@ -158,6 +161,22 @@ bool ServerConfig::loadConfig(std::string fileName)
 			callback_timeout_ = 5.f;
 	}
 	
+	rootNode = xml->getRootNode("timers");
+	if(rootNode != NULL)
+	{
+		TiXmlNode* childnode = xml->enterNode(rootNode, "timingWheel");
+		if(childnode)
+		{
+			Network::g_timingWheel = (xml->getValStr(childnode) == "true");
+		}
+
+		childnode = xml->enterNode(rootNode, "resolution");
+		if(childnode)
+		{
+			Network::g_timingWheelResolution = KBE_MAX(1, xml->getValInt(childnode));
+		}
+	}
+
 	rootNode = xml->getRootNode("thread_pool");
 	if(rootNode != NULL)
 	{
@@ -186,6 +205,28 @@ bool ServerConfig::loadConfig(std::string fileName)
 		}
 	}
 
+	rootNode = xml->getRootNode("gc");
+	if(rootNode != NULL)
+	{
+		TiXmlNode* childnode = xml->enterNode(rootNode, "scheduler");
+		if(childnode)
+		{
+			gc_scheduler_ = (xml->getValStr(childnode) == "true");
+		}
+
+		childnode = xml->enterNode(rootNode, "freeze");
+		if(childnode)
+		{
+			gc_freeze_ = (xml->getValStr(childnode) == "true");
+		}
+
+		childnode = xml->enterNode(rootNode, "fullPeriod");
+		if(childnode)
+		{
+			gc_fullPeriod_ = float(KBE_MAX(0.0, xml->getValFloat(childnode)));
+		}
+	}
+
 	rootNode = xml->getRootNode("channelCommon");
 	if(rootNode != NULL)
 	{
@@ -427,6 +468,46 @@ bool ServerConfig::loadConfig(std::string fileName)
 			{
 				Network::g_rudp_nodelay = (xml->getValStr(childnode) == "true");
 			}
+
+			childnode = xml->enterNode(rudpChildnode, "sharedUpdate");
+			if (childnode)
+			{
+				Network::g_rudp_sharedUpdate = (xml->getValStr(childnode) == "true");
+			}
+		}
+
+		TiXmlNode* pollerChildnode = xml->enterNode(rootNode, "poller");
+		if (pollerChildnode)
+		{
+			childnode = xml->enterNode(pollerChildnode, "maxEvents");
+			if (childnode)
+			{
+				Network::g_pollerMaxEvents = KBE_MAX(1, xml->getValInt(childnode));
+			}
+
+			childnode = xml->enterNode(pollerChildnode, "edgeTriggered");
+			if (childnode)
+			{
+				Network::g_pollerEdgeTriggered = (xml->getValStr(childnode) == "true");
+			}
+		}
+
+		childnode = xml->enterNode(rootNode, "vectoredSend");
+		if (childnode)
+		{
+			Network::g_vectoredSend = (xml->getValStr(childnode) == "true");
+		}
+
+		childnode = xml->enterNode(rootNode, "recvBatchSize");
+		if (childnode)
+		{
+			Network::g_recvBatchSize = KBE_MAX(0, xml->getValInt(childnode));
+		}
+
+		childnode = xml->enterNode(rootNode, "sendEncryptThreads");
+		if (childnode)
+		{
+			Network::g_sendEncryptThreads = KBE_MAX(0, xml->getValInt(childnode));
 		}
 	}
 
@@ -634,6 +715,29 @@ bool ServerConfig::loadConfig(std::string fileName)
 				if (node)
 					_cellAppInfo.entity_posdir_updates_smart_threshold = xml->getValInt(node);
 			}
+
+			childnode = xml->enterNode(node, "aoi");
+			if (childnode)
+			{
+				TiXmlNode* node = xml->enterNode(childnode, "type");
+				if (node)
+					_cellAppInfo.coordinateSystem_type = xml->getValStr(node);
+
+				node = xml->enterNode(childnode, "grid_cell_size");
+				if (node)
+					_cellAppInfo.coordinateSystem_gridCellSize = float(xml->getValFloat(node));
+
+				node = xml->enterNode(childnode, "spaces");
+				if (node)
+				{
+					XML_FOR_BEGIN(node)
+					{
+						if (node->FirstChild())
+							_cellAppInfo.coordinateSystem_spaceTypes[xml->getKey(node)] = xml->getValStr(node->FirstChild());
+					}
+					XML_FOR_END(node);
+				}
+			}
 		}
 
 		node = xml->enterNode(rootNode, "telnet_service");
@@ -735,6 +839,10 @@ bool ServerConfig::loadConfig(std::string fileName)
 		node = xml->enterNode(rootNode, "backUpUndefinedProperties");
 		if(node != NULL)
 			_baseAppInfo.backUpUndefinedProperties = xml->getValInt(node) > 0;
+
+		node = xml->enterNode(rootNode, "deltaArchive");
+		if(node != NULL)
+			_baseAppInfo.deltaArchive = xml->getBool(node);
 			
 		node = xml->enterNode(rootNode, "loadSmoothingBias");
 		if(node != NULL)
@@ -1057,6 +1165,14 @@ bool ServerConfig::loadConfig(std::string fileName)
 						pDBInfo->db_numConnections = xml->getValInt(node);
 					else
 						missingFields.push_back("numConnections");
+
+					node = xml->enterNode(interfaceNode, "preparedStatementCacheSize");
+					if(node != NULL)
+						pDBInfo->db_preparedStatementCacheSize = KBE_MAX(0, xml->getValInt(node));
+
+					node = xml->enterNode(interfaceNode, "batchEntityLoad");
+					if(node != NULL)
+						pDBInfo->db_batchEntityLoad = (xml->getValStr(node) == "true");
 						
 					node = xml->enterNode(interfaceNode, "unicodeString");
 					if(node != NULL)
@@ -1138,6 +1254,72 @@ bool ServerConfig::loadConfig(std::string fileName)
 			_dbmgrInfo.debugDBMgr = (xml->getValStr(node) == "true");
 		}
 
+		node = xml->enterNode(rootNode, "writeBatch");
+		if(node != NULL)
+		{
+			TiXmlNode* childnode = xml->enterNode(node, "enable");
+			if(childnode)
+			{
+				_dbmgrInfo.writeBatch_enable = (xml->getValStr(childnode) == "true");
+			}
+
+			childnode = xml->enterNode(node, "window");
+			if(childnode)
+			{
+				_dbmgrInfo.writeBatch_window = KBE_MAX(0, xml->getValInt(childnode));
+			}
+
+			childnode = xml->enterNode(node, "maxSize");
+			if(childnode)
+			{
+				_dbmgrInfo.writeBatch_maxSize = KBE_MAX(1, xml->getValInt(childnode));
+			}
+		}
+
+		node = xml->enterNode(rootNode, "loginBatch");
+		if(node != NULL)
+		{
+			TiXmlNode* childnode = xml->enterNode(node, "enable");
+			if(childnode)
+			{
+				_dbmgrInfo.loginBatch_enable = (xml->getValStr(childnode) == "true");
+			}
+
+			childnode = xml->enterNode(node, "window");
+			if(childnode)
+			{
+				_dbmgrInfo.loginBatch_window = KBE_MAX(0, xml->getValInt(childnode));
+			}
+
+			childnode = xml->enterNode(node, "maxSize");
+			if(childnode)
+			{
+				_dbmgrInfo.loginBatch_maxSize = KBE_MAX(1, xml->getValInt(childnode));
+			}
+		}
+
+		node = xml->enterNode(rootNode, "entityCache");
+		if(node != NULL)
+		{
+			TiXmlNode* childnode = xml->enterNode(node, "enable");
+			if(childnode)
+			{
+				_dbmgrInfo.entityCache_enable = (xml->getValStr(childnode) == "true");
+			}
+
+			childnode = xml->enterNode(node, "maxMemory");
+			if(childnode)
+			{
+				_dbmgrInfo.entityCache_maxMemory = KBE_MAX(1, xml->getValInt(childnode));
+			}
+
+			childnode = xml->enterNode(node, "warmOnOffline");
+			if(childnode)
+			{
+				_dbmgrInfo.entityCache_warmOnOffline = (xml->getValStr(childnode) == "true");
+			}
+		}
+
 		node = xml->enterNode(rootNode, "allowEmptyDigest");
 		if(node != NULL){
 			_dbmgrInfo.allowEmptyDigest = (xml->getValStr(node) == "true");
@@ -1285,6 +1467,22 @@ bool ServerConfig::loadConfig(std::string fileName)
 		node = xml->enterNode(rootNode, "http_cbport");
 		if(node)
 			_loginAppInfo.http_cbport = xml->getValInt(node);
+
+		node = xml->enterNode(rootNode, "loginQueue");
+		if(node != NULL)
+		{
+			TiXmlNode* childnode = xml->enterNode(node, "maxPending");
+			if(childnode)
+			{
+				_loginAppInfo.loginQueue_maxPending = KBE_MAX(0, xml->getValInt(childnode));
+			}
+
+			childnode = xml->enterNode(node, "maxSize");
+			if(childnode)
+			{
+				_loginAppInfo.loginQueue_maxSize = KBE_MAX(0, xml->getValInt(childnode));
+			}
+		}
 	}
 	
 	rootNode = xml->getRootNode("cellappmgr");
@@ -1298,6 +1496,55 @@ bool ServerConfig::loadConfig(std::string fileName)
 		if(node != NULL){
 			_cellAppMgrInfo.tcp_SOMAXCONN = xml->getValInt(node);
 		}
+
+		node = xml->enterNode(rootNode, "spacePartition");
+		if(node != NULL)
+		{
+			TiXmlNode* childnode = xml->enterNode(node, "enable");
+			if(childnode)
+			{
+				_cellAppMgrInfo.spacePartition_enable = (xml->getValStr(childnode) == "true");
+			}
+
+			childnode = xml->enterNode(node, "spaceTypes");
+			if(childnode)
+			{
+				std::vector<std::string> spaceTypes;
+				strutil::kbe_splits(xml->getValStr(childnode), ",", spaceTypes);
+				_cellAppMgrInfo.spacePartition_spaceTypes.clear();
+
+				for(size_t i = 0; i < spaceTypes.size(); ++i)
+				{
+					std::string spaceType = strutil::kbe_trim(spaceTypes[i]);
+					if(spaceType.size() > 0)
+						_cellAppMgrInfo.spacePartition_spaceTypes.push_back(spaceType);
+				}
+			}
+
+			childnode = xml->enterNode(node, "splitLoad");
+			if(childnode)
+			{
+				_cellAppMgrInfo.spacePartition_splitLoad = float(xml->getValFloat(childnode));
+			}
+
+			childnode = xml->enterNode(node, "balancePeriod");
+			if(childnode)
+			{
+				_cellAppMgrInfo.spacePartition_balancePeriod = KBE_MAX(0.1f, float(xml->getValFloat(childnode)));
+			}
+
+			childnode = xml->enterNode(node, "balanceStep");
+			if(childnode)
+			{
+				_cellAppMgrInfo.spacePartition_balanceStep = KBE_MAX(0.f, float(xml->getValFloat(childnode)));
+			}
+
+			childnode = xml->enterNode(node, "minCellSize");
+			if(childnode)
+			{
+				_cellAppMgrInfo.spacePartition_minCellSize = KBE_MAX(0.f, float(xml->getValFloat(childnode)));
+			}
+		}
 	}
 	
 	rootNode = xml->getRootNode("baseappmgr");
@@ -1486,6 +1733,66 @@ bool ServerConfig::loadConfig(std::string fileName)
 				_botsInfo.telnet_deflayer = xml->getValStr(childnode);
 			}
 		}
+
+		node = xml->enterNode(rootNode, "headless");
+		if(node != NULL)
+		{
+			TiXmlNode* childnode = xml->enterNode(node, "enable");
+			if(childnode)
+			{
+				_botsInfo.bots_headless_enable = (xml->getValStr(childnode) == "true");
+			}
+
+			childnode = xml->enterNode(node, "move");
+			if(childnode)
+			{
+				TiXmlNode* movenode = xml->enterNode(childnode, "speed");
+				if(movenode)
+					_botsInfo.bots_headless_moveSpeed = KBE_MAX(0.f, float(xml->getValFloat(movenode)));
+
+				movenode = xml->enterNode(childnode, "radius");
+				if(movenode)
+					_botsInfo.bots_headless_moveRadius = KBE_MAX(0.1f, float(xml->getValFloat(movenode)));
+
+				movenode = xml->enterNode(childnode, "hertz");
+				if(movenode)
+					_botsInfo.bots_headless_moveHertz = KBE_MAX(1, xml->getValInt(movenode));
+			}
+
+			childnode = xml->enterNode(node, "rpcs");
+			if(childnode)
+			{
+				XML_FOR_BEGIN(childnode)
+				{
+					if(xml->getKey(childnode) != "rpc" || childnode->FirstChild() == NULL)
+						continue;
+
+					BotsHeadlessRPC rpc;
+
+					TiXmlNode* rpcnode = xml->enterNode(childnode->FirstChild(), "method");
+					if(rpcnode)
+						rpc.method = xml->getValStr(rpcnode);
+
+					rpcnode = xml->enterNode(childnode->FirstChild(), "reply");
+					if(rpcnode)
+						rpc.reply = xml->getValStr(rpcnode);
+
+					rpcnode = xml->enterNode(childnode->FirstChild(), "period");
+					if(rpcnode)
+						rpc.period = KBE_MAX(0.01f, float(xml->getValFloat(rpcnode)));
+
+					if(rpc.method.size() > 0)
+						_botsInfo.bots_headless_rpcs.push_back(rpc);
+				}
+				XML_FOR_END(childnode);
+			}
+
+			childnode = xml->enterNode(node, "reportPeriod");
+			if(childnode)
+			{
+				_botsInfo.bots_headless_reportPeriod = KBE_MAX(1.f, float(xml->getValFloat(childnode)));
+			}
+		}
 	}
 
 	rootNode = xml->getRootNode("logger");
@@ -87,6 +87,8 @@ struct DBInterfaceInfo
 		isPure = false;
 		db_numConnections = 5;
 		db_passwordEncrypt = true;
+		db_preparedStatementCacheSize = 0;
+		db_batchEntityLoad = false;
 
 		memset(name, 0, sizeof(name));
 		memset(db_type, 0, sizeof(db_type));
@@ -108,11 +110,25 @@ struct DBInterfaceInfo
 	bool db_passwordEncrypt;								// dbǷǼܵ
 	char db_name[MAX_NAME];									// ݿ
 	uint16 db_numConnections;								// ݿ
+	uint32 db_preparedStatementCacheSize;					// ÿӻԤ 0ΪʹԤ
+	bool db_batchEntityLoad;								// ȡʵʱӱĲѯϲΪһ(Ҫ֧)
 	char db_autoIncrementInit[MAX_BUF];							// ʼ
 	std::string db_unicodeString_characterSet;				// ݿַ
 	std::string db_unicodeString_collation;
 };
 
+struct BotsHeadlessRPC
+{
+	BotsHeadlessRPC():
+		period(1.f)
+	{
+	}
+
+	std::string method;										// base.  cell.
+	std::string reply;										// ΪӦĿͻ˷ Ϊͳʱ
+	float period;											// ()
+};
+
 // Ϣṹ
 typedef struct EngineComponentInfo
 {
@@ -123,13 +139,38 @@ typedef struct EngineComponentInfo
 		account_registration_enable = false;
 		account_reset_password_enable = false;
 		use_coordinate_system = true;
+		coordinateSystem_type = "list";
+		coordinateSystem_gridCellSize = 0.f;
 		account_type = 3;
 		debugDBMgr = false;
+		deltaArchive = false;
+		writeBatch_enable = false;
+		writeBatch_window = 50;
+		writeBatch_maxSize = 64;
+		loginBatch_enable = false;
+		loginBatch_window = 20;
+		loginBatch_maxSize = 128;
+		loginQueue_maxPending = 0;
+		loginQueue_maxSize = 10000;
+		entityCache_enable = false;
+		entityCache_maxMemory = 64;
+		entityCache_warmOnOffline = true;
+		spacePartition_enable = false;
+		spacePartition_splitLoad = 0.8f;
+		spacePartition_balancePeriod = 1.f;
+		spacePartition_balanceStep = 10.f;
+		spacePartition_minCellSize = 100.f;
 
 		externalAddress[0] = '\0';
 
 		isOnInitCallPropertysSetMethods = true;
 		forceInternalLogin = false;
+
+		bots_headless_enable = false;
+		bots_headless_moveSpeed = 5.f;
+		bots_headless_moveRadius = 10.f;
+		bots_headless_moveHertz = 10;
+		bots_headless_reportPeriod = 10.f;
 	}
 
 	~EngineComponentInfo()
@@ -160,6 +201,9 @@ typedef struct EngineComponentInfo
 	uint16 entity_posdir_additional_updates;				// ʵλֹͣıͻ˸tickελϢΪ0Ǹ¡
 	uint16 entity_posdir_updates_type;						// ʵλø·ʽ0Ż߾ͬ, 1:Żͬ, 2:ѡģʽ
 	uint16 entity_posdir_updates_smart_threshold;			// ʵλøģʽµֵͬ
+	std::string coordinateSystem_type;						// AOIʵַʽ list:ʮ grid:
+	float coordinateSystem_gridCellSize;					// ߳ Ϊ0ʹĬview뾶ͺΧ
+	std::map<std::string, std::string> coordinateSystem_spaceTypes;	// spaceʵ͵ָAOIʵַʽ
 
 	bool aliasEntityID;										// ŻEntityIDviewΧС255EntityID, 䵽clientʱʹ1ֽαID 
 	bool entitydefAliasID;									// ŻentityԺͷ㲥ʱռõĴentityͻԻ߿ͻ˲255ʱ uiduid䵽clientʱʹ1ֽڱID
@@ -184,6 +228,7 @@ typedef struct EngineComponentInfo
 	float archivePeriod;									// entity洢ݿ
 	float backupPeriod;										// entity
 	bool backUpUndefinedProperties;							// entityǷ񱸷δ
+	bool deltaArchive;										// entity浵ʱǷֻдб仯
 	uint16 entityRestoreSize;								// entity restoreÿtick 
 
 	float loadSmoothingBias;								// baseappƽֵ 
@@ -233,7 +278,33 @@ typedef struct EngineComponentInfo
 
 	bool debugDBMgr;										// debugģʽ¿дϢ
 
+	bool writeBatch_enable;									// ǷͬһentityĸºϲΪд
+	uint32 writeBatch_window;								// ϲдĵȴ()
+	uint32 writeBatch_maxSize;								// һκϲдentity
+	bool loginBatch_enable;									// Ƿһʱڵĵ¼ϲѯ˺
+	uint32 loginBatch_window;								// ϲ¼ѯĵȴ()
+	uint32 loginBatch_maxSize;								// һκϲѯ¼
+	uint32 loginQueue_maxPending;							// loginappͬʱdbmgr¼ 0Ϊ
+	uint32 loginQueue_maxSize;								// loginapp¼Ŷӵ󳤶ȣ ܾ¼
+	bool entityCache_enable;								// Ƿڴлȡentity
+	uint32 entityCache_maxMemory;							// entityռڴ(MB)
+	bool entityCache_warmOnOffline;							// entityʱ(һδ浵֮)Ƿ뻺
+
+	bool spacePartition_enable;								// Ƿһspaceָcellapp
+	std::vector<std::string> spacePartition_spaceTypes;		// ָspaceʵͣ Ϊ
+	float spacePartition_splitLoad;							// cellappسֵʱϵspaceзָһcell
+	float spacePartition_balancePeriod;						// cell߽()
+	float spacePartition_balanceStep;						// ÿεcell߽ƶ
+	float spacePartition_minCellSize;						// cellС
+
 	bool isOnInitCallPropertysSetMethods;					// (bots)רãEntityʼʱǷ񴥷Եset_*¼
+
+	bool bots_headless_enable;								// (bots)רãͷģʽ pythonʵ㣬 ط
+	float bots_headless_moveSpeed;							// ͷģʽʵƶٶ(/) Ϊ0ƶ
+	float bots_headless_moveRadius;							// ͷģʽʵȦƶİ뾶()
+	uint32 bots_headless_moveHertz;							// ͷģʽÿͬλõĴ
+	std::vector<BotsHeadlessRPC> bots_headless_rpcs;		// ͷģʽڵõʵ巽
+	float bots_headless_reportPeriod;						// ͷģʽͳ־()
 } ENGINE_COMPONENT_INFO;
 
 class ServerConfig : public Singleton<ServerConfig>
@@ -325,6 +396,10 @@ public:
 	float thread_timeout_;											// Ĭϳʱʱ()
 
 	uint32 thread_init_create_, thread_pre_create_, thread_max_create_;
+
+	bool gc_scheduler_;												// tickĿʱpython
+	bool gc_freeze_;												// ɺ󶳽Ѽصpython
+	float gc_fullPeriod_;											// εȵյС() 0ΪԶ
 	
 	EmailServerInfo	emailServerInfo_;
 	EmailSendInfo emailAtivationInfo_;
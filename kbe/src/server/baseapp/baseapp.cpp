@@ -22,6 +22,7 @@
 #include "network/udp_packet.h"
 #include "network/fixed_messages.h"
 #include "network/encryption_filter.h"
+#include "network/packet_reader.h"
 #include "server/components.h"
 #include "server/telnet_server.h"
 #include "server/py_file_descriptor.h"
@@ -390,6 +391,26 @@ void Baseapp::onShutdownEnd()
 		const_cast<char*>("i"), 2, false);
 }
 
+//-------------------------------------------------------------------------------------
+static uint64 archiveBytesSavedPerArchive()
+{
+	uint64 archives = g_numFullArchives + g_numDeltaArchives;
+	return archives > 0 ? g_archiveBytesSaved / archives : 0;
+}
+
+//-------------------------------------------------------------------------------------
+static uint64 archiveStatementsSavedPerArchive()
+{
+	uint64 archives = g_numFullArchives + g_numDeltaArchives;
+	return archives > 0 ? g_archiveStatementsSaved / archives : 0;
+}
+
+//-------------------------------------------------------------------------------------
+static uint64 relayBytesCopiedPerMille()
+{
+	return g_relayBytes > 0 ? g_relayBytesCopied * 1000 / g_relayBytes : 0;
+}
+
 //-------------------------------------------------------------------------------------		
 bool Baseapp::initializeWatcher()
 {
@@ -399,6 +420,18 @@ bool Baseapp::initializeWatcher()
 	WATCH_OBJECT("numClients", this, &Baseapp::numClients);
 	WATCH_OBJECT("load", this, &Baseapp::_getLoad);
 	WATCH_OBJECT("stats/runningTime", &runningTime);
+	WATCH_OBJECT("stats/archive/numFullArchives", g_numFullArchives);
+	WATCH_OBJECT("stats/archive/numDeltaArchives", g_numDeltaArchives);
+	WATCH_OBJECT("stats/archive/bytesWritten", g_archiveBytesWritten);
+	WATCH_OBJECT("stats/archive/bytesSaved", g_archiveBytesSaved);
+	WATCH_OBJECT("stats/archive/statementsSaved", g_archiveStatementsSaved);
+	WATCH_OBJECT("stats/archive/bytesSavedPerArchive", &archiveBytesSavedPerArchive);
+	WATCH_OBJECT("stats/archive/statementsSavedPerArchive", &archiveStatementsSavedPerArchive);
+	WATCH_OBJECT("stats/relay/numMessages", g_relayMessages);
+	WATCH_OBJECT("stats/relay/numZeroCopyMessages", g_relayZeroCopyMessages);
+	WATCH_OBJECT("stats/relay/bytes", g_relayBytes);
+	WATCH_OBJECT("stats/relay/bytesCopied", g_relayBytesCopied);
+	WATCH_OBJECT("stats/relay/bytesCopiedPerMille", &relayBytesCopiedPerMille);
 	return EntityApp<Entity>::initializeWatcher();
 }
 
@@ -4318,7 +4351,29 @@ void Baseapp::forwardMessageToClientFromCellapp(Network::Channel* pChannel,
 	else
 		pSendBundle = pClientChannel->createSendBundle();
 
-	(*pSendBundle).append(s);
+	size_t relayLength = s.length();
+
+	// ϢѾƴӵһУ ֱȡڴҵͰϣ ٿ
+	// ǰѶentityIDܰͷĿռ䣬 ʱԭؽ
+	// ܰͷĳֶΪPacketLength ϢȻͨʽ
+	Network::PacketReader* pPacketReader = pChannel->pPacketReader();
+	if (pPacketReader && pPacketReader->pFragmentStream() == &s && 
+		pClientChannel && pClientChannel->protocoltype() == Network::PROTOCOL_TCP &&
+		pSendBundle->isTCPPacket() && relayLength + 16 < (size_t)std::numeric_limits<Network::PacketLength>::max())
+	{
+		Network::TCPPacket* pPacket = Network::TCPPacket::createPoolObject(OBJECTPOOL_POINT);
+		pPacket->swap(s);
+		(*pSendBundle).appendPacket(pPacket);
+		++g_relayZeroCopyMessages;
+	}
+	else
+	{
+		(*pSendBundle).append(s);
+		g_relayBytesCopied += relayLength;
+	}
+
+	++g_relayMessages;
+	g_relayBytes += relayLength;
 	pSendBundle->pCurrMsgHandler(pMessageHandler);
 
 	if (!pBufferedSendToClientMessages)
@@ -4330,7 +4385,7 @@ void Baseapp::forwardMessageToClientFromCellapp(Network::Channel* pChannel,
 		pBufferedSendToClientMessages->pushMessages(pSendBundle);
 	}
 
-	if(Network::g_trace_packet > 0 && s.length() >= sizeof(Network::MessageID))
+	if(Network::g_trace_packet > 0 && relayLength >= sizeof(Network::MessageID))
 	{
 		bool isprint = true;
 
@@ -4804,6 +4859,11 @@ void Baseapp::onHello(Network::Channel* pChannel,
 	(*pBundle) << EntityDef::md5().getDigestStr();
 	(*pBundle) << g_componentType;
 
+	// ͻAEADʱ֪Э̳ļͣ ľɿͻյϢ
+	int8 encryptType = Network::negotiateEncryptType(Network::g_channelExternalEncryptType, encryptedKey);
+	if (Network::isAEADEncryptionKey(encryptedKey))
+		(*pBundle) << encryptType;
+
 	// Ϣܣ趨ѼܺٴμܣһsendϢǽepoll֪ͨʱһڲԣ滷֣
 	// webЭҪܣԲΪtrue
 	if (pChannel->type() != KBEngine::Network::Channel::CHANNEL_WEB)
@@ -4816,7 +4876,7 @@ void Baseapp::onHello(Network::Channel* pChannel,
 		if(encryptedKey.size() > 3)
 		{
 			// 滻ΪһܵĹ
-			pChannel->pFilter(Network::createEncryptionFilter(Network::g_channelExternalEncryptType, encryptedKey));
+			pChannel->pFilter(Network::createEncryptionFilter(encryptType, encryptedKey));
 		}
 		else
 		{
@@ -395,7 +395,7 @@ void Entity::addCellDataToStream(COMPONENT_TYPE sendTo, uint32 flags, MemoryStre
 }
 
 //-------------------------------------------------------------------------------------
-void Entity::addPersistentsDataToStream(uint32 flags, MemoryStream* s)
+void Entity::addPersistentsDataToStream(uint32 flags, MemoryStream* s, PERSISTENT_RANGES* pRanges)
 {
 	std::vector<ENTITY_PROPERTY_UID> log;
 
@@ -408,7 +408,18 @@ void Entity::addPersistentsDataToStream(uint32 flags, MemoryStream* s)
 
 	if(pScriptModule_->hasCell())
 	{
+		uint32 begin = (uint32)s->wpos();
 		addPositionAndDirectionToStream(*s);
+
+		if(pRanges)
+		{
+			PersistentRange range;
+			range.uid = ENTITY_BASE_PROPERTY_UTYPE_POSITION_XYZ;
+			range.pPropertyDescription = NULL;
+			range.begin = begin;
+			range.end = (uint32)s->wpos();
+			pRanges->push_back(range);
+		}
 	}
 
 	for(; iter != propertyDescrs.end(); ++iter)
@@ -438,9 +449,8 @@ void Entity::addPersistentsDataToStream(uint32 flags, MemoryStream* s)
 				}
 				else
 				{
-					(*s) << (ENTITY_PROPERTY_UID)0 << propertyDescription->getUType();
 					log.push_back(propertyDescription->getUType());
-					propertyDescription->addPersistentToStream(s, pyVal);
+					addPersistentToStream(propertyDescription, s, pyVal, pRanges);
 					DEBUG_PERSISTENT_PROPERTY("addCellPersistentsDataToStream", attrname);
 				}
 			}
@@ -454,9 +464,8 @@ void Entity::addPersistentsDataToStream(uint32 flags, MemoryStream* s)
 				}
 				else
 				{
-	    			(*s) << (ENTITY_PROPERTY_UID)0 << propertyDescription->getUType();
 					log.push_back(propertyDescription->getUType());
-	    			propertyDescription->addPersistentToStream(s, pyVal);
+					addPersistentToStream(propertyDescription, s, pyVal, pRanges);
 					DEBUG_PERSISTENT_PROPERTY("addBasePersistentsDataToStream", attrname);
 				}
 			}
@@ -467,9 +476,8 @@ void Entity::addPersistentsDataToStream(uint32 flags, MemoryStream* s)
 					WARNING_MSG(fmt::format("{}::addPersistentsDataToStream: {} not found Persistent({}), use default values!\n",
 						this->scriptName(), this->id(), attrname));
 
-					(*s) << (ENTITY_PROPERTY_UID)0 << propertyDescription->getUType();
 					log.push_back(propertyDescription->getUType());
-					propertyDescription->addPersistentToStream(s, NULL);
+					addPersistentToStream(propertyDescription, s, NULL, pRanges);
 				}
 				else
 				{
@@ -489,9 +497,8 @@ void Entity::addPersistentsDataToStream(uint32 flags, MemoryStream* s)
 						}
 						else
 						{
-							(*s) << (ENTITY_PROPERTY_UID)0 << propertyDescription->getUType();
 							log.push_back(propertyDescription->getUType());
-							propertyDescription->addPersistentToStream(s, pyVal);
+							addPersistentToStream(propertyDescription, s, pyVal, pRanges);
 							DEBUG_PERSISTENT_PROPERTY("addCellPersistentsDataToStream", attrname);
 						}
 					}
@@ -508,6 +515,165 @@ void Entity::addPersistentsDataToStream(uint32 flags, MemoryStream* s)
 	SCRIPT_ERROR_CHECK();
 }
 
+//-------------------------------------------------------------------------------------
+void Entity::addPersistentToStream(PropertyDescription* propertyDescription, MemoryStream* s, 
+	PyObject* pyVal, PERSISTENT_RANGES* pRanges)
+{
+	if(pRanges == NULL)
+	{
+		(*s) << (ENTITY_PROPERTY_UID)0 << propertyDescription->getUType();
+		propertyDescription->addPersistentToStream(s, pyVal);
+		return;
+	}
+
+	pRanges->push_back(PersistentRange());
+
+	PersistentRange& range = pRanges->back();
+	range.uid = propertyDescription->getUType();
+	range.pPropertyDescription = propertyDescription;
+	range.begin = (uint32)s->wpos();
+
+	(*s) << (ENTITY_PROPERTY_UID)0 << propertyDescription->getUType();
+
+	// ¼ÿԪصλã 浵ʱֻӱб仯Ŀ
+	if(pyVal && propertyDescription->getDataType()->type() == DATA_TYPE_FIXEDARRAY)
+		static_cast<FixedArrayType*>(propertyDescription->getDataType())->addToStreamEx(s, pyVal, true, &range.elements);
+	else
+		propertyDescription->addPersistentToStream(s, pyVal);
+
+	range.end = (uint32)s->wpos();
+}
+
+//-------------------------------------------------------------------------------------
+static uint64 persistentDataHash(const uint8* data, uint32 size)
+{
+	// FNV-1a ֻжϴ浵Ƿб仯
+	uint64 hash = 14695981039346656037ULL;
+
+	for(uint32 i = 0; i < size; ++i)
+	{
+		hash ^= data[i];
+		hash *= 1099511628211ULL;
+	}
+
+	return hash;
+}
+
+//-------------------------------------------------------------------------------------
+static void persistentElementsHash(MemoryStream* s, const Entity::PersistentRange& range, 
+	std::vector<uint64>& digests)
+{
+	digests.resize(range.elements.size());
+
+	for(size_t i = 0; i < range.elements.size(); ++i)
+	{
+		uint32 end = (i + 1 < range.elements.size()) ? range.elements[i + 1] : range.end;
+		digests[i] = persistentDataHash(s->data() + range.elements[i], end - range.elements[i]);
+	}
+}
+
+//-------------------------------------------------------------------------------------
+static uint64 persistentStatementCount(const Entity::PersistentRange& range, size_t numElements)
+{
+	// һдʱ֮ ҪѯӱĿ£ Ҫѯ
+	if(range.pPropertyDescription == NULL)
+		return 0;
+
+	uint8 type = range.pPropertyDescription->getDataType()->type();
+	if(type == DATA_TYPE_FIXEDARRAY)
+		return 1 + numElements;
+	else if(type == DATA_TYPE_ENTITY_COMPONENT)
+		return 2;
+
+	return 0;
+}
+
+//-------------------------------------------------------------------------------------
+bool Entity::makeDeltaArchive(MemoryStream* s, const PERSISTENT_RANGES& ranges, MemoryStream* pDeltaStream,
+	PERSISTENT_PROPERTY_DIGESTS& outDigests)
+{
+	if(persistentPropertyDigests_.size() == 0)
+		return false;
+
+	outDigests.clear();
+
+	// ϵֶζûб仯ʱupdateҲʡ
+	bool hasColumns = false;
+	uint64 statementsSaved = 0;
+
+	PERSISTENT_RANGES::const_iterator iter = ranges.begin();
+	for(; iter != ranges.end(); ++iter)
+	{
+		const PersistentRange& range = (*iter);
+		const uint8* data = s->data() + range.begin;
+
+		PersistentPropertyDigest& digest = outDigests[range.uid];
+		digest.digest = persistentDataHash(data, range.end - range.begin);
+
+		PERSISTENT_PROPERTY_DIGESTS::iterator olditer = persistentPropertyDigests_.find(range.uid);
+		if(olditer != persistentPropertyDigests_.end() && olditer->second.digest == digest.digest)
+		{
+			digest.elements = olditer->second.elements;
+			statementsSaved += persistentStatementCount(range, digest.elements.size());
+			continue;
+		}
+
+		if(persistentStatementCount(range, 0) == 0)
+			hasColumns = true;
+
+		persistentElementsHash(s, range, digest.elements);
+
+		if(range.elements.size() == 0 || olditer == persistentPropertyDigests_.end() || 
+			olditer->second.elements.size() == 0)
+		{
+			pDeltaStream->append(data, range.end - range.begin);
+			continue;
+		}
+
+		// ֻдб仯Ԫأ δ仯Ԫӱа˳ӦĿֲ
+		const std::vector<uint64>& oldElements = olditer->second.elements;
+		ArraySize size = (ArraySize)range.elements.size();
+		(*pDeltaStream) << (ENTITY_PROPERTY_UID)ENTITY_PERSISTENT_ARRAY_DELTA << range.uid << size;
+
+		for(ArraySize i = 0; i < size; ++i)
+		{
+			if(i < oldElements.size() && oldElements[i] == digest.elements[i])
+			{
+				(*pDeltaStream) << (uint8)0;
+				++statementsSaved;
+				continue;
+			}
+
+			uint32 end = (i + 1 < size) ? range.elements[i + 1] : range.end;
+			(*pDeltaStream) << (uint8)1;
+			pDeltaStream->append(s->data() + range.elements[i], end - range.elements[i]);
+		}
+	}
+
+	if(!hasColumns)
+		++statementsSaved;
+
+	g_archiveStatementsSaved += statementsSaved;
+	return true;
+}
+
+//-------------------------------------------------------------------------------------
+void Entity::makePersistentPropertyDigests(MemoryStream* s, const PERSISTENT_RANGES& ranges, 
+	PERSISTENT_PROPERTY_DIGESTS& outDigests)
+{
+	outDigests.clear();
+
+	PERSISTENT_RANGES::const_iterator iter = ranges.begin();
+	for(; iter != ranges.end(); ++iter)
+	{
+		const PersistentRange& range = (*iter);
+
+		PersistentPropertyDigest& digest = outDigests[range.uid];
+		digest.digest = persistentDataHash(s->data() + range.begin, range.end - range.begin);
+		persistentElementsHash(s, range, digest.elements);
+	}
+}
+
 //-------------------------------------------------------------------------------------
 PyObject* Entity::createCellDataDict(uint32 flags)
 {
@@ -1255,6 +1421,25 @@ void Entity::onWriteToDBCallback(ENTITY_ID eid,
 		hasDB(false);
 	}
 
+	// ֻdbmgrȷдɹĴ浵Ϊ浵Ļ׼
+	// дʧʱݿе¼hashѾԲˣ һδ浵д
+	if (pendingPropertyDigests_.size() > 0)
+	{
+		if (success)
+			persistentPropertyDigests_.swap(pendingPropertyDigests_.front());
+		else
+			persistentPropertyDigests_.clear();
+
+		pendingPropertyDigests_.pop_front();
+	}
+	else if (!success)
+	{
+		persistentPropertyDigests_.clear();
+	}
+
+	if (!success)
+		setDirty();
+
 	if(callbackID > 0)
 	{
 		PyObject* pyargs = PyTuple_New(2);
@@ -1292,7 +1477,13 @@ void Entity::onCellWriteToDBCompleted(CALLBACK_ID callbackID, int8 shouldAutoLoa
 	CALL_ENTITY_AND_COMPONENTS_METHOD(this, SCRIPT_OBJECT_CALL_ARGS0(pyTempObj, const_cast<char*>("onPreArchive"), GETERR));
 
 	if (dbInterfaceIndex >= 0)
+	{
+		// ݿӿڣ ֮ǰ¼hashЧ
+		if (dbInterfaceIndex_ != dbInterfaceIndex)
+			persistentPropertyDigests_.clear();
+
 		dbInterfaceIndex_ = dbInterfaceIndex;
+	}
 
 	hasDB(true);
 	
@@ -1317,10 +1508,12 @@ void Entity::onCellWriteToDBCompleted(CALLBACK_ID callbackID, int8 shouldAutoLoa
 	}
 	
 	MemoryStream* s = MemoryStream::createPoolObject(OBJECTPOOL_POINT);
+	bool deltaArchive = g_kbeSrvConfig.getBaseApp().deltaArchive;
+	PERSISTENT_RANGES ranges;
 
 	try
 	{
-		addPersistentsDataToStream(ED_FLAG_ALL, s);
+		addPersistentsDataToStream(ED_FLAG_ALL, s, deltaArchive ? &ranges : NULL);
 	}
 	catch (MemoryStreamWriteOverflow & err)
 	{
@@ -1354,6 +1547,37 @@ void Entity::onCellWriteToDBCompleted(CALLBACK_ID callbackID, int8 shouldAutoLoa
 		setDirty((uint32*)&digest[0]);
 	}
 
+	// Ѿݿеʵֻдб仯ԣ ʵԼûhash¼ʱд
+	// ǰһд⻹ûлظʱʧܣ ʱΪ׼ᶪʧЯ޸ģ Ҳд
+	MemoryStream* pDeltaStream = NULL;
+	PERSISTENT_PROPERTY_DIGESTS digests;
+
+	if (deltaArchive)
+	{
+		pDeltaStream = MemoryStream::createPoolObject(OBJECTPOOL_POINT);
+
+		if (this->dbid() == 0 || pendingPropertyDigests_.size() > 0 || 
+			!makeDeltaArchive(s, ranges, pDeltaStream, digests))
+		{
+			MemoryStream::reclaimPoolObject(pDeltaStream);
+			pDeltaStream = NULL;
+
+			makePersistentPropertyDigests(s, ranges, digests);
+		}
+	}
+
+	if (pDeltaStream)
+	{
+		++g_numDeltaArchives;
+		g_archiveBytesWritten += pDeltaStream->length();
+		g_archiveBytesSaved += s->length() - pDeltaStream->length();
+	}
+	else
+	{
+		++g_numFullArchives;
+		g_archiveBytesWritten += s->length();
+	}
+
 	Network::Bundle* pBundle = Network::Bundle::createPoolObject(OBJECTPOOL_POINT);
 	(*pBundle).newMessage(DbmgrInterface::writeEntity);
 
@@ -1381,7 +1605,19 @@ void Entity::onCellWriteToDBCompleted(CALLBACK_ID callbackID, int8 shouldAutoLoa
 		(*pBundle) << port;
 	}
 
-	(*pBundle).append(*s);
+	if (pDeltaStream)
+	{
+		(*pBundle).append(*pDeltaStream);
+		MemoryStream::reclaimPoolObject(pDeltaStream);
+	}
+	else
+	{
+		(*pBundle).append(*s);
+	}
+
+	// dbmgrظдɹųΪ浵Ļ׼
+	pendingPropertyDigests_.push_back(PERSISTENT_PROPERTY_DIGESTS());
+	pendingPropertyDigests_.back().swap(digests);
 
 	dbmgrinfos->pChannel->send(pBundle);
 	MemoryStream::reclaimPoolObject(s);
@@ -98,7 +98,33 @@ public:
 
 	void destroyCellData(void);
 
-	void addPersistentsDataToStream(uint32 flags, MemoryStream* s);
+	/**
+		洢ڴ浵еλã 浵ʱݴ˼ÿ(ԼԵÿԪ)hash
+		λ볯Ϊһ¼ENTITY_BASE_PROPERTY_UTYPE_POSITION_XYZ
+	*/
+	struct PersistentRange
+	{
+		ENTITY_PROPERTY_UID uid;
+		PropertyDescription* pPropertyDescription;
+		uint32 begin;
+		uint32 end;
+		std::vector<uint32> elements;
+	};
+
+	typedef std::vector<PersistentRange> PERSISTENT_RANGES;
+
+	/**
+		дʱÿ洢Եhash Ի¼ÿԪصhash 浵
+	*/
+	struct PersistentPropertyDigest
+	{
+		uint64 digest;
+		std::vector<uint64> elements;
+	};
+
+	typedef std::map<ENTITY_PROPERTY_UID, PersistentPropertyDigest> PERSISTENT_PROPERTY_DIGESTS;
+
+	void addPersistentsDataToStream(uint32 flags, MemoryStream* s, PERSISTENT_RANGES* pRanges = NULL);
 
 	PyObject* createCellDataDict(uint32 flags);
 
@@ -267,6 +293,21 @@ protected:
 	*/
 	void eraseEntityLog();
 
+	/**
+		дһ洢ԣ pRangesΪNULLʱ¼еλ
+	*/
+	void addPersistentToStream(PropertyDescription* propertyDescription, MemoryStream* s, 
+		PyObject* pyVal, PERSISTENT_RANGES* pRanges);
+
+	/**
+		ϴдɹʱ¼hashĴ浵б仯ĲдpDeltaStream
+		δ浵hashдoutDigests falseʾ޷浵(ûм¼) ʱӦд
+	*/
+	bool makeDeltaArchive(MemoryStream* s, const PERSISTENT_RANGES& ranges, MemoryStream* pDeltaStream,
+		PERSISTENT_PROPERTY_DIGESTS& outDigests);
+	void makePersistentPropertyDigests(MemoryStream* s, const PERSISTENT_RANGES& ranges, 
+		PERSISTENT_PROPERTY_DIGESTS& outDigests);
+
 protected:
 	// entityĿͻentityCall cellapp entityCall
 	EntityCall*								clientEntityCall_;
@@ -309,6 +350,14 @@ protected:
 	// Ҫ־ûǷࣨڴsha1ûб಻Ҫ־û
 	uint32									persistentDigest_[5];
 
+	// ϴdbmgrȷдɹĴ浵hash 浵Ϊ׼
+	// дʧܻݿӿڸıʱգ һδ浵д
+	PERSISTENT_PROPERTY_DIGESTS				persistentPropertyDigests_;
+
+	// ѷdbmgrûлظĴ浵hash ˳(ͬһʵдⰴ˳ִвظ)
+	// Ϊʱݿеδ֪ 浵д
+	std::deque<PERSISTENT_PROPERTY_DIGESTS>	pendingPropertyDigests_;
+
 	// ʵѾдݿ⣬ôԾǶӦݿӿڵ
 	uint16									dbInterfaceIndex_;
 };
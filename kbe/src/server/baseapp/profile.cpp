@@ -9,4 +9,15 @@ ProfileVal ONTIMER_PROFILE("onTimer");
 EventHistoryStats g_privateClientEventHistoryStats("PrivateClientEvents");
 EventHistoryStats g_publicClientEventHistoryStats("PublicClientEvents");
 
+uint64 g_numFullArchives = 0;
+uint64 g_numDeltaArchives = 0;
+uint64 g_archiveBytesWritten = 0;
+uint64 g_archiveBytesSaved = 0;
+uint64 g_archiveStatementsSaved = 0;
+
+uint64 g_relayMessages = 0;
+uint64 g_relayZeroCopyMessages = 0;
+uint64 g_relayBytes = 0;
+uint64 g_relayBytesCopied = 0;
+
 }
@@ -16,5 +16,18 @@ extern ProfileVal ONTIMER_PROFILE;
 extern EventHistoryStats g_privateClientEventHistoryStats;
 extern EventHistoryStats g_publicClientEventHistoryStats;
 
+// 浵ͳƣ 浵ֻдб仯Լб仯Ԫ
+extern uint64 g_numFullArchives;
+extern uint64 g_numDeltaArchives;
+extern uint64 g_archiveBytesWritten;
+extern uint64 g_archiveBytesSaved;
+extern uint64 g_archiveStatementsSaved;
+
+// cellappתͻ˵Ϣͳƣ Ϣֱȡڴ治ٿ
+extern uint64 g_relayMessages;
+extern uint64 g_relayZeroCopyMessages;
+extern uint64 g_relayBytes;
+extern uint64 g_relayBytesCopied;
+
 }
 #endif
@@ -7,8 +7,11 @@ namespace KBEngine{
 
 
 //-------------------------------------------------------------------------------------
-Cell::Cell(CELL_ID id):
-id_(id)
+Cell::Cell(CELL_ID id, COMPONENT_ID cellappID, float minX, float maxX):
+id_(id),
+cellappID_(cellappID),
+minX_(minX),
+maxX_(maxX)
 {
 }
 
@@ -10,16 +10,28 @@
 
 namespace KBEngine{
 
+/**
+	spaceָһcell x[minX, maxX)Χڵrealʵ
+*/
 class Cell
 {
 public:
-	Cell(CELL_ID id);
+	Cell(CELL_ID id = 0, COMPONENT_ID cellappID = 0, float minX = -FLT_MAX, float maxX = FLT_MAX);
 	~Cell();
 
 	CELL_ID id() const{ return id_; }
+	COMPONENT_ID cellappID() const{ return cellappID_; }
+
+	float minX() const{ return minX_; }
+	float maxX() const{ return maxX_; }
+
+	bool contains(float x) const{ return x >= minX_ && x < maxX_; }
 
 private:
 	CELL_ID id_;
+	COMPONENT_ID cellappID_;
+	float minX_;
+	float maxX_;
 };
 
 }
@@ -7,6 +7,8 @@
 #include "profile.h"
 #include "witness.h"
 #include "coordinate_node.h"
+#include "coordinate_system.h"
+#include "entity_coordinate_node.h"
 #include "view_trigger.h"
 #include "watch_obj_pools.h"
 #include "cellapp_interface.h"
@@ -143,6 +145,16 @@ bool Cellapp::initializeWatcher()
 	WATCH_OBJECT("load", this, &Cellapp::_getLoad);
 	WATCH_OBJECT("spaceSize", &KBEngine::getUsername);
 	WATCH_OBJECT("stats/runningTime", &runningTime);
+	WATCH_OBJECT("stats/witness/volatileDataCacheHits", g_volatileDataCacheHits);
+	WATCH_OBJECT("stats/witness/volatileDataCacheMisses", g_volatileDataCacheMisses);
+	WATCH_OBJECT("stats/witness/volatileDataEncodedBytes", g_volatileDataEncodedBytes);
+	WATCH_OBJECT("stats/witness/volatileDataCopiedBytes", g_volatileDataCopiedBytes);
+	WATCH_OBJECT("stats/coordinateSystem/nodePasses", g_coordinateNodePasses);
+	WATCH_OBJECT("stats/coordinateSystem/gridChecks", g_coordinateGridChecks);
+	WATCH_OBJECT("stats/witness/propertyUpdateMessagesSaved", g_propertyUpdateMessagesSaved);
+	WATCH_OBJECT("stats/witness/propertyUpdateBytesSaved", g_propertyUpdateBytesSaved);
+	WATCH_OBJECT("stats/coordinateSystem/entitiesInRangeQueries", g_entitiesInRangeQueries);
+	WATCH_OBJECT("stats/coordinateSystem/entitiesInRangeCandidates", g_entitiesInRangeCandidates);
 	return EntityApp<Entity>::initializeWatcher() && WatchObjectPool::initWatchPools();
 }
 
@@ -184,6 +196,8 @@ bool Cellapp::installPyModules()
 	APPEND_SCRIPT_MODULE_METHOD(getScript().getModule(),		delSpaceData,					SpaceMemory::__py_DelSpaceData,							METH_VARARGS,			0);
 	APPEND_SCRIPT_MODULE_METHOD(getScript().getModule(),		isShuttingDown,					__py_isShuttingDown,									METH_VARARGS,			0);
 	APPEND_SCRIPT_MODULE_METHOD(getScript().getModule(),		address,						__py_address,											METH_VARARGS,			0);
+	APPEND_SCRIPT_MODULE_METHOD(getScript().getModule(),		benchmarkEntitiesInRange,		__py_benchmarkEntitiesInRange,							METH_VARARGS,			0);
+	APPEND_SCRIPT_MODULE_METHOD(getScript().getModule(),		benchmarkAOI,					__py_benchmarkAOI,										METH_VARARGS,			0);
 	APPEND_SCRIPT_MODULE_METHOD(getScript().getModule(),		raycast,						__py_raycast,											METH_VARARGS,			0);
 	APPEND_SCRIPT_MODULE_METHOD(getScript().getModule(), 		setAppFlags,					__py_setFlags,											METH_VARARGS,			0);
 	APPEND_SCRIPT_MODULE_METHOD(getScript().getModule(), 		getAppFlags,					__py_getFlags,											METH_VARARGS,			0);
@@ -259,6 +273,9 @@ void Cellapp::handleGameTick()
 
 	updatables_.update();
 	SpaceMemorys::update();
+
+	// tickںϲԸı㲥ͻ
+	Entity::flushAllDefDataChanges();
 }
 
 //-------------------------------------------------------------------------------------
@@ -892,6 +909,8 @@ void Cellapp::onCreateCellEntityInNewSpaceFromBaseapp(Network::Channel* pChannel
 	SpaceMemory* space = SpaceMemorys::createNewSpace(spaceID, entityType);
 	if(space != NULL)
 	{
+		space->creatorID(entitycallEntityID);
+
 		// entity
 		Entity* e = createEntity(entityType.c_str(), NULL, false, entitycallEntityID, false);
 		
@@ -1005,6 +1024,8 @@ void Cellapp::onRestoreSpaceInCellFromBaseapp(Network::Channel* pChannel, KBEngi
 	SpaceMemory* space = SpaceMemorys::createNewSpace(spaceID, entityType);
 	if(space != NULL)
 	{
+		space->creatorID(entitycallEntityID);
+
 		// entity
 		Entity* e = createEntity(entityType.c_str(), NULL, false, entitycallEntityID, false);
 		
@@ -1875,6 +1896,260 @@ PyObject* Cellapp::__py_address(PyObject* self, PyObject* args)
 	return pyobj;
 }
 
+//-------------------------------------------------------------------------------------
+PyObject* Cellapp::__py_benchmarkEntitiesInRange(PyObject* self, PyObject* args)
+{
+	ENTITY_ID entityID = 0;
+	float radius = 0.f;
+	uint32 iterations = 1000;
+
+	if (!PyArg_ParseTuple(args, "if|I", &entityID, &radius, &iterations))
+	{
+		PyErr_Format(PyExc_TypeError, "KBEngine::benchmarkEntitiesInRange: args error! (entityID, range[, iterations])");
+		PyErr_PrintEx(0);
+		return 0;
+	}
+
+	Entity* pEntity = Cellapp::getSingleton().findEntity(entityID);
+	if (pEntity == NULL || pEntity->isDestroyed() || pEntity->pEntityCoordinateNode() == NULL)
+	{
+		PyErr_Format(PyExc_AssertionError, "KBEngine::benchmarkEntitiesInRange: entity(%d) not found or not in a space!", entityID);
+		PyErr_PrintEx(0);
+		return 0;
+	}
+
+	CoordinateNode* pRootNode = pEntity->pEntityCoordinateNode();
+	CoordinateSystem* pCoordinateSystem = pRootNode->pCoordinateSystem();
+	if (pCoordinateSystem && pCoordinateSystem->pCoordinateGrid())
+	{
+		PyErr_Format(PyExc_AssertionError, "KBEngine::benchmarkEntitiesInRange: entity(%d) space uses the grid backend, "
+			"the std::set implementation only works on coordinate lists!", entityID);
+		PyErr_PrintEx(0);
+		return 0;
+	}
+
+	if (iterations == 0)
+		iterations = 1;
+
+	Position3D originpos = pEntity->position();
+	std::vector<Entity*> found;
+	std::vector<Entity*> foundBySets;
+
+	uint64 startTime = timestamp();
+	for (uint32 i = 0; i < iterations; ++i)
+	{
+		found.clear();
+		EntityCoordinateNode::entitiesInRange(found, pRootNode, originpos, radius);
+	}
+
+	uint64 walkerTime = timestamp() - startTime;
+
+	startTime = timestamp();
+	for (uint32 i = 0; i < iterations; ++i)
+	{
+		foundBySets.clear();
+		EntityCoordinateNode::entitiesInRangeBySets(foundBySets, pRootNode, originpos, radius);
+	}
+
+	uint64 setsTime = timestamp() - startTime;
+
+	// ʵֵĽ˳ͬ Ƚ
+	std::sort(found.begin(), found.end());
+	std::sort(foundBySets.begin(), foundBySets.end());
+
+	if (found != foundBySets)
+	{
+		PyErr_Format(PyExc_AssertionError, "KBEngine::benchmarkEntitiesInRange: results differ! found=%d, foundBySets=%d",
+			(int)found.size(), (int)foundBySets.size());
+		PyErr_PrintEx(0);
+		return 0;
+	}
+
+	double walkerQPS = walkerTime > 0 ? iterations * stampsPerSecondD() / walkerTime : 0.0;
+	double setsQPS = setsTime > 0 ? iterations * stampsPerSecondD() / setsTime : 0.0;
+
+	INFO_MSG(fmt::format("Cellapp::benchmarkEntitiesInRange: entity={}, range={}, found={}, iterations={}, "
+		"walker={:.0f} queries/s, sets={:.0f} queries/s\n", 
+		entityID, radius, found.size(), iterations, walkerQPS, setsQPS));
+
+	return Py_BuildValue("{s:I,s:d,s:d}", "found", (unsigned int)found.size(), "walker", walkerQPS, "sets", setsQPS);
+}
+
+//-------------------------------------------------------------------------------------
+/*
+	̶ӵ ͬһڲͬspaceϵõͬƶ
+*/
+class AOIBenchmarkRandom
+{
+public:
+	AOIBenchmarkRandom() : state_(0x2545F4914F6CDD1DULL) {}
+
+	// [0, 1)
+	float next()
+	{
+		state_ ^= state_ << 13;
+		state_ ^= state_ >> 7;
+		state_ ^= state_ << 17;
+		return (float)(state_ >> 40) / (float)(1 << 24);
+	}
+
+private:
+	uint64 state_;
+};
+
+//-------------------------------------------------------------------------------------
+PyObject* Cellapp::__py_benchmarkAOI(PyObject* self, PyObject* args)
+{
+	SPACE_ID spaceID = 0;
+	char* scenario = NULL;
+	uint32 iterations = 100;
+	float size = 1000.f;
+
+	if (!PyArg_ParseTuple(args, "Is|If", &spaceID, &scenario, &iterations, &size))
+	{
+		PyErr_Format(PyExc_TypeError, "KBEngine::benchmarkAOI: args error! (spaceID, scenario[, iterations, size])");
+		PyErr_PrintEx(0);
+		return 0;
+	}
+
+	enum { SCENARIO_UNIFORM, SCENARIO_CLUSTERED, SCENARIO_TELEPORT };
+
+	int scenarioType = SCENARIO_UNIFORM;
+	if (strcmp(scenario, "uniform") == 0)
+		scenarioType = SCENARIO_UNIFORM;
+	else if (strcmp(scenario, "clustered") == 0)
+		scenarioType = SCENARIO_CLUSTERED;
+	else if (strcmp(scenario, "teleport") == 0)
+		scenarioType = SCENARIO_TELEPORT;
+	else
+	{
+		PyErr_Format(PyExc_TypeError, "KBEngine::benchmarkAOI: scenario(%s) must be uniform, clustered or teleport!", scenario);
+		PyErr_PrintEx(0);
+		return 0;
+	}
+
+	SpaceMemory* space = SpaceMemorys::findSpace(spaceID);
+	if (space == NULL || !space->isGood())
+	{
+		PyErr_Format(PyExc_AssertionError, "KBEngine::benchmarkAOI: space(%u) not found!", spaceID);
+		PyErr_PrintEx(0);
+		return 0;
+	}
+
+	// ƶʱĻص(onEnterTrap)entity뿪space٣ һݲ
+	SPACE_ENTITIES entities = space->entities();
+	if (entities.size() == 0)
+	{
+		PyErr_Format(PyExc_AssertionError, "KBEngine::benchmarkAOI: space(%u) has no entities!", spaceID);
+		PyErr_PrintEx(0);
+		return 0;
+	}
+
+	if (iterations == 0)
+		iterations = 1;
+
+	if (size < 10.f)
+		size = 10.f;
+
+	const float half = size * 0.5f;
+	const float hubRadius = size * 0.02f;				// clusteredǵİ뾶
+	const float step = 5.f;								// ÿ֡ƶ
+	const float teleportRate = 0.1f;					// teleportÿ֡˲Ƶentity
+	const float viewRadius = g_kbeSrvConfig.getCellApp().defaultViewRadius;
+
+	AOIBenchmarkRandom random;
+
+	// clustered֮ĵentityۼԭ㸽 ֲ
+	std::vector<bool> inHub(entities.size(), false);
+	std::vector<Position3D> positions(entities.size());
+
+	// ʼڷŲʱ
+	for (size_t i = 0; i < entities.size(); ++i)
+	{
+		Entity* pEntity = entities[i].get();
+		Position3D pos = pEntity->position();
+
+		inHub[i] = scenarioType == SCENARIO_CLUSTERED && (i % 5) != 0;
+
+		float range = inHub[i] ? hubRadius : half;
+		pos.x = (random.next() * 2.f - 1.f) * range;
+		pos.z = (random.next() * 2.f - 1.f) * range;
+
+		if (!pEntity->isDestroyed())
+			pEntity->position(pos);
+	}
+
+	uint64 moveTime = 0;
+	uint64 queryTime = 0;
+	uint64 numQueries = 0;
+	uint64 numFound = 0;
+	std::vector<Entity*> found;
+
+	for (uint32 tick = 0; tick < iterations; ++tick)
+	{
+		// Ŀλã ֻλ(AOI)ʱ
+		for (size_t i = 0; i < entities.size(); ++i)
+		{
+			Position3D pos = entities[i]->position();
+
+			if (scenarioType == SCENARIO_TELEPORT && random.next() < teleportRate)
+			{
+				pos.x = (random.next() * 2.f - 1.f) * half;
+				pos.z = (random.next() * 2.f - 1.f) * half;
+			}
+			else
+			{
+				float range = inHub[i] ? hubRadius : half;
+				pos.x = std::min(std::max(pos.x + (random.next() * 2.f - 1.f) * step, -range), range);
+				pos.z = std::min(std::max(pos.z + (random.next() * 2.f - 1.f) * step, -range), range);
+			}
+
+			positions[i] = pos;
+		}
+
+		uint64 startTime = timestamp();
+
+		for (size_t i = 0; i < entities.size(); ++i)
+		{
+			Entity* pEntity = entities[i].get();
+			if (!pEntity->isDestroyed())
+				pEntity->position(positions[i]);
+		}
+
+		moveTime += timestamp() - startTime;
+
+		// ÿʮentityһҰΧڲѯһ
+		startTime = timestamp();
+
+		for (size_t i = tick % 10; i < entities.size(); i += 10)
+		{
+			Entity* pEntity = entities[i].get();
+			if (pEntity->isDestroyed() || pEntity->pEntityCoordinateNode() == NULL)
+				continue;
+
+			found.clear();
+			EntityCoordinateNode::entitiesInRange(found, pEntity->pEntityCoordinateNode(), pEntity->position(), viewRadius);
+
+			numFound += found.size();
+			++numQueries;
+		}
+
+		queryTime += timestamp() - startTime;
+	}
+
+	const char* backend = space->pCoordinateSystem()->pCoordinateGrid() ? "grid" : "list";
+	double moveMs = moveTime * 1000.0 / stampsPerSecondD() / iterations;
+	double queryMs = queryTime * 1000.0 / stampsPerSecondD() / iterations;
+	double avgFound = numQueries > 0 ? (double)numFound / numQueries : 0.0;
+
+	INFO_MSG(fmt::format("Cellapp::benchmarkAOI: space={}({}), scenario={}, entities={}, size={}, iterations={}, "
+		"move={:.3f}ms/tick, query={:.3f}ms/tick({:.1f} found per query)\n", 
+		spaceID, backend, scenario, entities.size(), size, iterations, moveMs, queryMs, avgFound));
+
+	return Py_BuildValue("{s:s,s:I,s:d,s:d,s:d}", "backend", backend, "entities", (unsigned int)entities.size(), 
+		"move", moveMs, "query", queryMs, "found", avgFound);
+}
+
 //-------------------------------------------------------------------------------------
 void Cellapp::reqTeleportToCellApp(Network::Channel* pChannel, MemoryStream& s)
 {
@@ -1895,6 +2170,13 @@ void Cellapp::reqTeleportToCellApp(Network::Channel* pChannel, MemoryStream& s)
 	COMPONENT_ID ghostCell;
 	s >> ghostCell;
 
+	// nearbyMBRefIDΪ0ʾͬһspaceڿcellǨ
+	if (nearbyMBRefID == 0)
+	{
+		onEntityOffloaded(pChannel, s, rpos, teleportEntityID, spaceID, entityType, pos, dir, ghostCell);
+		return;
+	}
+
 	bool success = false;
 
 	Entity* refEntity = Cellapp::getSingleton().findEntity(nearbyMBRefID);
@@ -2035,6 +2317,14 @@ void Cellapp::reqTeleportToCellAppCB(Network::Channel* pChannel, MemoryStream& s
 	// ͳɹentity
 	if(success)
 	{
+		// ͬһspaceڿcellǨƳɹ ԭʵΪrealghost
+		Entity* entity = Cellapp::getSingleton().findEntity(teleportEntityID);
+		if (entity && entity->hasFlags(ENTITY_FLAGS_OFFLOADING))
+		{
+			entity->removeFlags(ENTITY_FLAGS_OFFLOADING);
+			return;
+		}
+
 		destroyEntity(teleportEntityID, false);
 		return;
 	}
@@ -2085,7 +2375,12 @@ void Cellapp::reqTeleportToCellAppCB(Network::Channel* pChannel, MemoryStream& s
 
 	Py_INCREF(entity);
 	entity->changeToReal(0, s);
-	entity->onTeleportFailure();
+
+	if (entity->hasFlags(ENTITY_FLAGS_OFFLOADING))
+		entity->removeFlags(ENTITY_FLAGS_OFFLOADING);
+	else
+		entity->onTeleportFailure();
+
 	Py_DECREF(entity);
 	
 	s.done();
@@ -2112,6 +2407,332 @@ void Cellapp::reqTeleportToCellAppOver(Network::Channel* pChannel, MemoryStream&
 	entity->removeFlags(ENTITY_FLAGS_TELEPORT_START);
 }
 
+//-------------------------------------------------------------------------------------
+void Cellapp::onEntityOffloaded(Network::Channel* pChannel, MemoryStream& s, size_t rpos, ENTITY_ID entityID, 
+	SPACE_ID spaceID, ENTITY_SCRIPT_UID entityType, const Position3D& pos, const Direction3D& dir, COMPONENT_ID sourceCell)
+{
+	bool success = false;
+	COMPONENT_ID entityBaseappID = 0;
+
+	SpaceMemory* space = SpaceMemorys::findSpace(spaceID);
+	Entity* e = findEntity(entityID);
+
+	if (space == NULL || !space->isGood() || (e && (e->isReal() || e->spaceID() != spaceID)))
+	{
+		s.rpos((int)rpos);
+
+		Network::Bundle* pBundle = Network::Bundle::createPoolObject(OBJECTPOOL_POINT);
+		(*pBundle).newMessage(CellappInterface::reqTeleportToCellAppCB);
+		(*pBundle) << sourceCell << g_componentID << entityBaseappID;
+		(*pBundle) << entityID;
+		(*pBundle) << success;
+		(*pBundle).append(&s);
+		pChannel->send(pBundle);
+
+		ERROR_MSG(fmt::format("Cellapp::onEntityOffloaded: space({}) not ready or entity({}) state error!\n", spaceID, entityID));
+		s.done();
+		return;
+	}
+
+	// cellѾghostʱֱӽghostתΪreal 򴴽һµreal
+	bool hasGhostEntity = (e != NULL);
+
+	if (!hasGhostEntity)
+	{
+		e = createEntity(EntityDef::findScriptModule(entityType)->getName(), NULL, false, entityID, false);
+		if (e == NULL)
+		{
+			s.rpos((int)rpos);
+
+			Network::Bundle* pBundle = Network::Bundle::createPoolObject(OBJECTPOOL_POINT);
+			(*pBundle).newMessage(CellappInterface::reqTeleportToCellAppCB);
+			(*pBundle) << sourceCell << g_componentID << entityBaseappID;
+			(*pBundle) << entityID;
+			(*pBundle) << success;
+			(*pBundle).append(&s);
+			pChannel->send(pBundle);
+
+			ERROR_MSG(fmt::format("Cellapp::onEntityOffloaded: create entity({}) error!\n", entityID));
+			s.done();
+			return;
+		}
+	}
+
+	Py_INCREF(e);
+
+	// ǨƹвonEnterSpaceȽűص
+	e->addFlags(ENTITY_FLAGS_OFFLOADING);
+
+	if (hasGhostEntity)
+	{
+		e->changeToReal(sourceCell, s);
+	}
+	else
+	{
+		e->createFromStream(s);
+		e->ghostCell(sourceCell);
+	}
+
+	e->spaceID(space->id());
+	e->setPositionAndDirection(pos, dir);
+
+	if (e->baseEntityCall())
+	{
+		e->addFlags(ENTITY_FLAGS_TELEPORT_START);
+		entityBaseappID = e->baseEntityCall()->componentID();
+
+		Network::Bundle* pBundle = Network::Bundle::createPoolObject(OBJECTPOOL_POINT);
+		(*pBundle).newMessage(BaseappInterface::onMigrationCellappEnd);
+		(*pBundle) << e->id();
+		(*pBundle) << sourceCell << g_componentID;
+		e->baseEntityCall()->sendCall(pBundle);
+	}
+
+	if (!hasGhostEntity)
+	{
+		space->addEntity(e);
+		space->addEntityToNode(e);
+
+		if (e->pWitness())
+			e->pWitness()->installViewTrigger();
+	}
+
+	e->removeFlags(ENTITY_FLAGS_OFFLOADING);
+
+	// ԭrealΪghost Ҫͬλõױ
+	if (e->hasGhost() && pGhostManager_)
+		pGhostManager_->addRealEntity(e);
+
+	e->onEnteredCell();
+
+	success = true;
+
+	{
+		Network::Bundle* pBundle = Network::Bundle::createPoolObject(OBJECTPOOL_POINT);
+		(*pBundle).newMessage(CellappInterface::reqTeleportToCellAppCB);
+		(*pBundle) << sourceCell << g_componentID << entityBaseappID;
+		(*pBundle) << entityID;
+		(*pBundle) << success;
+		pChannel->send(pBundle);
+	}
+
+	Py_DECREF(e);
+}
+
+//-------------------------------------------------------------------------------------
+void Cellapp::onCreateGhost(Network::Channel* pChannel, MemoryStream& s)
+{
+	ENTITY_ID entityID = 0;
+	SPACE_ID spaceID = 0;
+	COMPONENT_ID realCell = 0;
+	ENTITY_SCRIPT_UID entityType;
+	Position3D pos;
+	Direction3D dir;
+
+	s >> entityID >> spaceID >> realCell >> entityType;
+	s >> pos.x >> pos.y >> pos.z;
+	s >> dir.dir.x >> dir.dir.y >> dir.dir.z;
+
+	SpaceMemory* space = SpaceMemorys::findSpace(spaceID);
+	if (space == NULL || !space->isGood() || findEntity(entityID) != NULL)
+	{
+		WARNING_MSG(fmt::format("Cellapp::onCreateGhost: space({}) not ready or entity({}) already exists!\n", 
+			spaceID, entityID));
+
+		s.done();
+		return;
+	}
+
+	ScriptDefModule* pScriptModule = EntityDef::findScriptModule(entityType);
+	if (pScriptModule == NULL)
+	{
+		ERROR_MSG(fmt::format("Cellapp::onCreateGhost: not found entityType({}), entity({})!\n", 
+			entityType, entityID));
+
+		s.done();
+		return;
+	}
+
+	Entity* e = createEntity(pScriptModule->getName(), NULL, false, entityID, false);
+	if (e == NULL)
+	{
+		s.done();
+		return;
+	}
+
+	e->realCell(realCell);
+	e->spaceID(space->id());
+	e->createGhostFromStream(s);
+	e->setPositionAndDirection(pos, dir);
+
+	space->addEntity(e);
+	space->addEntityToNode(e);
+}
+
+//-------------------------------------------------------------------------------------
+void Cellapp::onDestroyGhost(Network::Channel* pChannel, MemoryStream& s)
+{
+	ENTITY_ID entityID = 0;
+	s >> entityID;
+
+	Entity* e = findEntity(entityID);
+	if (e == NULL || e->isReal())
+		return;
+
+	destroyEntity(entityID, false);
+}
+
+//-------------------------------------------------------------------------------------
+void Cellapp::reqSplitSpaceCell(Network::Channel* pChannel, MemoryStream& s)
+{
+	CELL_ID newCellID = 0;
+	COMPONENT_ID newCellappID = 0;
+	s >> newCellID >> newCellappID;
+
+	const std::vector<std::string>& spaceTypes = g_kbeSrvConfig.getCellAppMgr().spacePartition_spaceTypes;
+
+	SpaceMemory* pBestSpace = NULL;
+	std::vector<float> bestXs;
+	std::vector<float> xs;
+
+	// ѡcellapprealspaceָ
+	SpaceMemorys::SPACEMEMORYS& spaces = SpaceMemorys::spaces();
+	SpaceMemorys::SPACEMEMORYS::iterator iter = spaces.begin();
+	for (; iter != spaces.end(); ++iter)
+	{
+		SpaceMemory* pSpace = iter->second.get();
+		if (pSpace == NULL || !pSpace->isGood())
+			continue;
+
+		if (spaceTypes.size() > 0 && 
+			std::find(spaceTypes.begin(), spaceTypes.end(), pSpace->getScriptModuleName()) == spaceTypes.end())
+			continue;
+
+		Cell* pMyCell = pSpace->pCell();
+		if (pSpace->isPartitioned() && (pMyCell == NULL || pSpace->cells().findCellByCellapp(newCellappID) != NULL))
+			continue;
+
+		xs.clear();
+
+		const SPACE_ENTITIES& entities = pSpace->entities();
+		SPACE_ENTITIES::const_iterator eiter = entities.begin();
+		for (; eiter != entities.end(); ++eiter)
+		{
+			Entity* pEntity = (*eiter).get();
+			if (pEntity == NULL || pEntity->isDestroyed() || !pEntity->isReal())
+				continue;
+
+			xs.push_back(pEntity->position().x);
+		}
+
+		if (xs.size() > bestXs.size())
+		{
+			pBestSpace = pSpace;
+			bestXs.swap(xs);
+		}
+	}
+
+	SPACE_ID spaceID = 0;
+	CELL_ID srcCellID = 0;
+	float pos = 0.f;
+
+	if (pBestSpace && bestXs.size() >= 2)
+	{
+		// realxλΪָ㣬 ʹcellϵʵ൱
+		std::vector<float>::iterator mid = bestXs.begin() + bestXs.size() / 2;
+		std::nth_element(bestXs.begin(), mid, bestXs.end());
+		pos = *mid;
+
+		Cell* pMyCell = pBestSpace->pCell();
+		if (pMyCell)
+			srcCellID = pMyCell->id();
+
+		if (pMyCell == NULL || pMyCell->contains(pos))
+			spaceID = pBestSpace->id();
+	}
+
+	Network::Bundle* pBundle = Network::Bundle::createPoolObject(OBJECTPOOL_POINT);
+	(*pBundle).newMessage(CellappmgrInterface::onSpaceCellSplit);
+	(*pBundle) << spaceID << g_componentID << srcCellID << newCellID << newCellappID << pos;
+	pChannel->send(pBundle);
+}
+
+//-------------------------------------------------------------------------------------
+void Cellapp::onUpdateSpaceCells(Network::Channel* pChannel, MemoryStream& s)
+{
+	SPACE_ID spaceID = 0;
+	std::string scriptModuleName, geomappingPath;
+	s >> spaceID >> scriptModuleName >> geomappingPath;
+
+	// cellappmgrspaceData ֻڱcellapp½spaceʱʹã ֮޸onSyncSpaceDataͬ
+	uint32 numSpaceDatas = 0;
+	s >> numSpaceDatas;
+
+	std::vector< std::pair<std::string, std::string> > spaceDatas(numSpaceDatas);
+	for (uint32 i = 0; i < numSpaceDatas; ++i)
+		s >> spaceDatas[i].first >> spaceDatas[i].second;
+
+	Cells cells;
+	cells.createFromStream(s);
+
+	SpaceMemory* pSpace = SpaceMemorys::findSpace(spaceID);
+
+	// ֱձʾspaceڴcellappѾ
+	if (cells.size() == 0)
+	{
+		if (pSpace)
+		{
+			pSpace->cells().clear();
+			SpaceMemorys::destroySpace(spaceID, 0);
+		}
+
+		return;
+	}
+
+	if (pSpace == NULL)
+	{
+		if (cells.findCellByCellapp(g_componentID) == NULL)
+			return;
+
+		pSpace = SpaceMemorys::createNewSpace(spaceID, scriptModuleName);
+		if (pSpace == NULL)
+		{
+			ERROR_MSG(fmt::format("Cellapp::onUpdateSpaceCells: create space({}) error!\n", spaceID));
+			return;
+		}
+
+		if (geomappingPath.size() > 0)
+			pSpace->addSpaceGeometryMapping(geomappingPath, true, std::map< int, std::string >());
+
+		for (uint32 i = 0; i < numSpaceDatas; ++i)
+			pSpace->setSpaceData(spaceDatas[i].first, spaceDatas[i].second, false);
+	}
+
+	if (pSpace->isDestroyed())
+		return;
+
+	pSpace->cells() = cells;
+}
+
+//-------------------------------------------------------------------------------------
+void Cellapp::onSyncSpaceData(Network::Channel* pChannel, MemoryStream& s)
+{
+	SPACE_ID spaceID = 0;
+	std::string key, value;
+	bool isdel = false;
+	s >> spaceID >> key >> value >> isdel;
+
+	SpaceMemory* pSpace = SpaceMemorys::findSpace(spaceID);
+	if (pSpace == NULL || pSpace->isDestroyed())
+		return;
+
+	// ϱcellappmgr cell֮ת
+	if (isdel)
+		pSpace->delSpaceData(key, false);
+	else
+		pSpace->setSpaceData(key, value, false);
+}
+
 //-------------------------------------------------------------------------------------
 int Cellapp::raycast(SPACE_ID spaceID, int layer, const Position3D& start, const Position3D& end, std::vector<Position3D>& hitPos)
 {
@@ -229,6 +229,18 @@ public:
 	*/
 	static PyObject* __py_address(PyObject* self, PyObject* args);
 
+	/**
+		ĳentityΪķִentitiesInRange Աȵǰʵɵstd::setʵֵÿѯУһ
+		ֻʮϵͳ¿ã άڿ̨
+	*/
+	static PyObject* __py_benchmarkEntitiesInRange(PyObject* self, PyObject* args);
+
+	/**
+		(uniformȷֲclusteredۼǡteleportƵ˲)ƶĳspaceеentity
+		ÿ֡ƶ(AOI)entitiesInRangeѯĺʱ ֱʹlistgridspaceϵԱʵ
+	*/
+	static PyObject* __py_benchmarkAOI(PyObject* self, PyObject* args);
+
 	WitnessedTimeoutHandler	* pWitnessedTimeoutHandler(){ return pWitnessedTimeoutHandler_; }
 
 	/**
@@ -239,6 +251,37 @@ public:
 	void reqTeleportToCellAppCB(Network::Channel* pChannel, MemoryStream& s);
 	void reqTeleportToCellAppOver(Network::Channel* pChannel, MemoryStream& s);
 
+	/**
+		ͬһspaceһcellϵrealԽ˱߽ǨƵcell reqTeleportToCellAppת
+	*/
+	void onEntityOffloaded(Network::Channel* pChannel, MemoryStream& s, size_t rpos, ENTITY_ID entityID, 
+		SPACE_ID spaceID, ENTITY_SCRIPT_UID entityType, const Position3D& pos, const Direction3D& dir, COMPONENT_ID sourceCell);
+
+	/**
+		ӿ
+		cellϵrealڱcellϴghost
+	*/
+	void onCreateGhost(Network::Channel* pChannel, MemoryStream& s);
+	void onDestroyGhost(Network::Channel* pChannel, MemoryStream& s);
+
+	/**
+		ӿ
+		cellappmgr󽫱cellappϸߵһspaceָһcellnewCellappID
+	*/
+	void reqSplitSpaceCell(Network::Channel* pChannel, MemoryStream& s);
+
+	/**
+		ӿ
+		cellappmgrͬspacecell֣ cellappûиspaceʱᴴ
+	*/
+	void onUpdateSpaceCells(Network::Channel* pChannel, MemoryStream& s);
+
+	/**
+		ӿ
+		cellappmgrתͬһspacecell޸ĵspaceData
+	*/
+	void onSyncSpaceData(Network::Channel* pChannel, MemoryStream& s);
+
 	/**
 		ȡghost
 	*/
@@ -164,6 +164,21 @@ NETWORK_INTERFACE_DECLARE_BEGIN(CellappInterface)
 	// ıspace鿴Ӻɾܣ
 	CELLAPP_MESSAGE_DECLARE_STREAM(setSpaceViewer,									NETWORK_VARIABLE_MESSAGE)
 
+	// cellϵreal󴴽ghost
+	CELLAPP_MESSAGE_DECLARE_STREAM(onCreateGhost,									NETWORK_VARIABLE_MESSAGE)
+
+	// cellϵrealghost
+	CELLAPP_MESSAGE_DECLARE_STREAM(onDestroyGhost,									NETWORK_VARIABLE_MESSAGE)
+
+	// cellappmgrָһspace
+	CELLAPP_MESSAGE_DECLARE_STREAM(reqSplitSpaceCell,								NETWORK_VARIABLE_MESSAGE)
+
+	// cellappmgrͬspacecell
+	CELLAPP_MESSAGE_DECLARE_STREAM(onUpdateSpaceCells,								NETWORK_VARIABLE_MESSAGE)
+
+	// cellappmgrתcell޸ĵspaceData
+	CELLAPP_MESSAGE_DECLARE_STREAM(onSyncSpaceData,									NETWORK_VARIABLE_MESSAGE)
+
 	//--------------------------------------------Entity----------------------------------------------------------
 	//Զ̺entity
 	ENTITY_MESSAGE_DECLARE_STREAM(onRemoteMethodCall,								NETWORK_VARIABLE_MESSAGE)
@@ -2,6 +2,7 @@
 
 #include "cells.h"	
 #include "helper/profile.h"	
+#include "common/memorystream.h"
 
 namespace KBEngine{	
 
@@ -18,5 +19,50 @@ Cells::~Cells()
 	cells_.clear();
 }
 
+//-------------------------------------------------------------------------------------
+void Cells::createFromStream(MemoryStream& s)
+{
+	cells_.clear();
+
+	uint32 size = 0;
+	s >> size;
+
+	for (uint32 i = 0; i < size; ++i)
+	{
+		CELL_ID id;
+		COMPONENT_ID cellappID;
+		float minX, maxX;
+
+		s >> id >> cellappID >> minX >> maxX;
+		cells_[id] = Cell(id, cellappID, minX, maxX);
+	}
+}
+
+//-------------------------------------------------------------------------------------
+Cell* Cells::findCell(float x)
+{
+	std::map<CELL_ID, Cell>::iterator iter = cells_.begin();
+	for (; iter != cells_.end(); ++iter)
+	{
+		if (iter->second.contains(x))
+			return &iter->second;
+	}
+
+	return NULL;
+}
+
+//-------------------------------------------------------------------------------------
+Cell* Cells::findCellByCellapp(COMPONENT_ID cellappID)
+{
+	std::map<CELL_ID, Cell>::iterator iter = cells_.begin();
+	for (; iter != cells_.end(); ++iter)
+	{
+		if (iter->second.cellappID() == cellappID)
+			return &iter->second;
+	}
+
+	return NULL;
+}
+
 //-------------------------------------------------------------------------------------
 }
@@ -11,6 +11,11 @@
 
 namespace KBEngine{
 
+class MemoryStream;
+
+/**
+	һspacecell֣ cellappmgr䲢ͬصcellapp
+*/
 class Cells
 {
 public:
@@ -19,6 +24,20 @@ public:
 
 	ArraySize size() const{ return (ArraySize)cells_.size(); }
 
+	void clear(){ cells_.clear(); }
+
+	/**
+		cellappmgr::onUpdateSpaceCellsĲ
+	*/
+	void createFromStream(MemoryStream& s);
+
+	Cell* findCell(float x);
+	Cell* findCellByCellapp(COMPONENT_ID cellappID);
+
+	std::map<CELL_ID, Cell>& cells() {
+		return cells_;
+	}
+
 private:
 	std::map<CELL_ID, Cell> cells_;
 };
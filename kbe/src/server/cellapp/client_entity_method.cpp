@@ -109,6 +109,9 @@ PyObject* ClientEntityMethod::callmethod(PyObject* args, PyObject* kwds)
 		return 0;
 	}
 
+	// ϲеԸıȷ ֤ͻյ뷽˳űһ
+	e->flushDefDataChanges();
+
 	MethodDescription* methodDescription = getDescription();
 	if(methodDescription->checkArgs(args))
 	{
@@ -68,6 +68,9 @@ PyObject* ClientsRemoteEntityMethod::callmethod(PyObject* args, PyObject* kwds)
 		S_Return;
 	}
 	
+	// ϲеԸıȷ ֤ͻյ뷽˳űһ
+	pEntity->flushDefDataChanges();
+
 	const std::list<ENTITY_ID>& entities = pEntity->witnesses();
 
 	if(otherClients_)
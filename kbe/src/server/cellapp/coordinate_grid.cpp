@@ -0,0 +1,565 @@
+// Copyright 2008-2018 Yolo Technologies, Inc. All Rights Reserved. https://www.comblockengine.com
+
+#include "coordinate_grid.h"
+#include "coordinate_system.h"
+#include "entity_coordinate_node.h"
+#include "range_trigger.h"
+#include "entity.h"
+#include "profile.h"
+
+#ifndef CODE_INLINE
+#include "coordinate_grid.inl"
+#endif
+
+namespace KBEngine{
+
+//-------------------------------------------------------------------------------------
+template <class T>
+static bool eraseFromVector(std::vector<T*>& vec, T* p)
+{
+	typename std::vector<T*>::iterator iter = std::find(vec.begin(), vec.end(), p);
+	if (iter == vec.end())
+		return false;
+
+	(*iter) = vec.back();
+	vec.pop_back();
+	return true;
+}
+
+//-------------------------------------------------------------------------------------
+CoordinateGrid::CoordinateGrid(float cellSize):
+cellSize_(cellSize),
+cells_(),
+nodes_(),
+triggers_(),
+largeTriggers_(),
+dels_(),
+scratchNodes_(),
+updating_(0)
+{
+	if (cellSize_ < 1.f)
+		cellSize_ = 1.f;
+}
+
+//-------------------------------------------------------------------------------------
+CoordinateGrid::~CoordinateGrid()
+{
+	RANGE_TRIGGERS::iterator iter = triggers_.begin();
+	for (; iter != triggers_.end(); ++iter)
+		delete iter->second;
+
+	triggers_.clear();
+	largeTriggers_.clear();
+
+	updating_ = 0;
+	releaseTriggers();
+
+	cells_.clear();
+	nodes_.clear();
+}
+
+//-------------------------------------------------------------------------------------
+bool CoordinateGrid::isInRange(const Trigger* pTrigger, CoordinateNode* pNode) const
+{
+	if (pNode->hasFlags(COORDINATE_NODE_FLAG_HIDE_OR_REMOVED | COORDINATE_NODE_FLAG_REMOVING))
+		return false;
+
+	CoordinateNode* pOrigin = pTrigger->pOrigin;
+	if (pOrigin->hasFlags(COORDINATE_NODE_FLAG_REMOVED | COORDINATE_NODE_FLAG_REMOVING))
+		return false;
+
+	// RangeTriggerNode::isInXRangeȱһ£ ߽ϵĽڵΪڷΧ
+	float range_xz = pTrigger->pRangeTrigger->range_xz();
+
+	float originX = pOrigin->xx();
+	if (pNode->xx() < originX - range_xz || pNode->xx() > originX + range_xz)
+		return false;
+
+	float originZ = pOrigin->zz();
+	if (pNode->zz() < originZ - range_xz || pNode->zz() > originZ + range_xz)
+		return false;
+
+	if (CoordinateSystem::hasY)
+	{
+		float range_y = pTrigger->pRangeTrigger->range_y();
+		float originY = pOrigin->yy();
+		if (pNode->yy() < originY - range_y || pNode->yy() > originY + range_y)
+			return false;
+	}
+
+	return true;
+}
+
+//-------------------------------------------------------------------------------------
+void CoordinateGrid::checkNode(Trigger* pTrigger, CoordinateNode* pNode)
+{
+	if (pTrigger->removed || pNode == pTrigger->pOrigin)
+		return;
+
+	++g_coordinateGridChecks;
+
+	// صпܵ½ڵѾ뿪
+	NODE_INFOS::iterator iter = nodes_.find(pNode);
+	bool isIn = iter != nodes_.end() && isInRange(pTrigger, pNode);
+	bool wasIn = pTrigger->insiders.find(pNode) != pTrigger->insiders.end();
+
+	if (isIn == wasIn)
+		return;
+
+	// ȸ״̬ٻص صпٴupdate
+	if (isIn)
+	{
+		pTrigger->insiders.insert(pNode);
+		iter->second.insideOf.push_back(pTrigger);
+		pTrigger->pRangeTrigger->onEnter(pNode);
+	}
+	else
+	{
+		pTrigger->insiders.erase(pNode);
+
+		if (iter != nodes_.end())
+			eraseFromVector(iter->second.insideOf, pTrigger);
+
+		pTrigger->pRangeTrigger->onLeave(pNode);
+	}
+}
+
+//-------------------------------------------------------------------------------------
+void CoordinateGrid::checkTrigger(Trigger* pTrigger)
+{
+	if (pTrigger->removed)
+		return;
+
+	// صп޸ ȸƳҪĽڵ
+	NODES nodes;
+	nodes.swap(scratchNodes_);
+	nodes.assign(pTrigger->insiders.begin(), pTrigger->insiders.end());
+
+	if (pTrigger->isLarge)
+	{
+		nodes.reserve(nodes.size() + nodes_.size());
+
+		NODE_INFOS::iterator iter = nodes_.begin();
+		for (; iter != nodes_.end(); ++iter)
+			nodes.push_back(iter->first);
+	}
+	else
+	{
+		for (int32 x = pTrigger->minCellX; x <= pTrigger->maxCellX; ++x)
+		{
+			for (int32 z = pTrigger->minCellZ; z <= pTrigger->maxCellZ; ++z)
+			{
+				CELLS::iterator iter = cells_.find(cellKey(x, z));
+				if (iter == cells_.end())
+					continue;
+
+				nodes.insert(nodes.end(), iter->second.nodes.begin(), iter->second.nodes.end());
+			}
+		}
+	}
+
+	NODES::iterator iter = nodes.begin();
+	for (; iter != nodes.end(); ++iter)
+	{
+		if (pTrigger->removed)
+			break;
+
+		checkNode(pTrigger, (*iter));
+	}
+
+	scratchNodes_.swap(nodes);
+}
+
+//-------------------------------------------------------------------------------------
+void CoordinateGrid::removeNodeFromCell(CELL_KEY key, CoordinateNode* pNode)
+{
+	CELLS::iterator iter = cells_.find(key);
+	if (iter == cells_.end())
+		return;
+
+	eraseFromVector(iter->second.nodes, pNode);
+
+	if (iter->second.nodes.empty() && iter->second.triggers.empty())
+		cells_.erase(iter);
+}
+
+//-------------------------------------------------------------------------------------
+bool CoordinateGrid::updateTriggerCells(Trigger* pTrigger)
+{
+	CoordinateNode* pOrigin = pTrigger->pOrigin;
+	float range_xz = pTrigger->pRangeTrigger->range_xz();
+
+	int32 minCellX = cellIndex(pOrigin->xx() - range_xz);
+	int32 maxCellX = cellIndex(pOrigin->xx() + range_xz);
+	int32 minCellZ = cellIndex(pOrigin->zz() - range_xz);
+	int32 maxCellZ = cellIndex(pOrigin->zz() + range_xz);
+
+	if (minCellX == pTrigger->minCellX && maxCellX == pTrigger->maxCellX &&
+		minCellZ == pTrigger->minCellZ && maxCellZ == pTrigger->maxCellZ)
+		return false;
+
+	unregisterTrigger(pTrigger);
+
+	pTrigger->minCellX = minCellX;
+	pTrigger->maxCellX = maxCellX;
+	pTrigger->minCellZ = minCellZ;
+	pTrigger->maxCellZ = maxCellZ;
+
+	registerTrigger(pTrigger);
+	return true;
+}
+
+//-------------------------------------------------------------------------------------
+void CoordinateGrid::registerTrigger(Trigger* pTrigger)
+{
+	int64 numCells = (int64(pTrigger->maxCellX) - pTrigger->minCellX + 1) *
+		(int64(pTrigger->maxCellZ) - pTrigger->minCellZ + 1);
+
+	pTrigger->isLarge = numCells > MAX_TRIGGER_CELLS;
+
+	if (pTrigger->isLarge)
+	{
+		largeTriggers_.push_back(pTrigger);
+		return;
+	}
+
+	for (int32 x = pTrigger->minCellX; x <= pTrigger->maxCellX; ++x)
+	{
+		for (int32 z = pTrigger->minCellZ; z <= pTrigger->maxCellZ; ++z)
+		{
+			cells_[cellKey(x, z)].triggers.push_back(pTrigger);
+		}
+	}
+}
+
+//-------------------------------------------------------------------------------------
+void CoordinateGrid::unregisterTrigger(Trigger* pTrigger)
+{
+	if (pTrigger->isLarge)
+	{
+		eraseFromVector(largeTriggers_, pTrigger);
+		pTrigger->isLarge = false;
+		return;
+	}
+
+	if (pTrigger->minCellX > pTrigger->maxCellX)
+		return;
+
+	for (int32 x = pTrigger->minCellX; x <= pTrigger->maxCellX; ++x)
+	{
+		for (int32 z = pTrigger->minCellZ; z <= pTrigger->maxCellZ; ++z)
+		{
+			CELLS::iterator iter = cells_.find(cellKey(x, z));
+			if (iter == cells_.end())
+				continue;
+
+			eraseFromVector(iter->second.triggers, pTrigger);
+
+			if (iter->second.nodes.empty() && iter->second.triggers.empty())
+				cells_.erase(iter);
+		}
+	}
+}
+
+//-------------------------------------------------------------------------------------
+bool CoordinateGrid::insert(CoordinateNode* pNode)
+{
+	if (nodes_.find(pNode) != nodes_.end())
+		return false;
+
+	++updating_;
+
+	CELL_KEY key = nodeCellKey(pNode);
+
+	NodeInfo& info = nodes_[pNode];
+	info.cellKey = key;
+
+	Cell& cell = cells_[key];
+	cell.nodes.push_back(pNode);
+
+	// ½ڵЩ
+	TRIGGERS triggers(cell.triggers);
+	triggers.insert(triggers.end(), largeTriggers_.begin(), largeTriggers_.end());
+
+	TRIGGERS::iterator iter = triggers.begin();
+	for (; iter != triggers.end(); ++iter)
+		checkNode((*iter), pNode);
+
+	--updating_;
+	return true;
+}
+
+//-------------------------------------------------------------------------------------
+bool CoordinateGrid::remove(CoordinateNode* pNode)
+{
+	NODE_INFOS::iterator iter = nodes_.find(pNode);
+	if (iter == nodes_.end())
+		return false;
+
+	++updating_;
+
+	// ڵ㶼Ҫɾˣ ΪԭĴҲҪжأ RangeTriggerNode::onParentRemoveһ
+	TRIGGERS triggers(iter->second.triggers);
+
+	TRIGGERS::iterator titer = triggers.begin();
+	for (; titer != triggers.end(); ++titer)
+	{
+		if (!(*titer)->removed)
+			(*titer)->pRangeTrigger->uninstall();
+	}
+
+	// ڵѾɾǣ ¼鼴뿪д
+	iter = nodes_.find(pNode);
+	if (iter != nodes_.end())
+	{
+		triggers = iter->second.insideOf;
+
+		titer = triggers.begin();
+		for (; titer != triggers.end(); ++titer)
+			checkNode((*titer), pNode);
+	}
+
+	iter = nodes_.find(pNode);
+	if (iter != nodes_.end())
+	{
+		titer = iter->second.insideOf.begin();
+		for (; titer != iter->second.insideOf.end(); ++titer)
+			(*titer)->insiders.erase(pNode);
+
+		removeNodeFromCell(iter->second.cellKey, pNode);
+		nodes_.erase(iter);
+	}
+
+	--updating_;
+	return true;
+}
+
+//-------------------------------------------------------------------------------------
+void CoordinateGrid::update(CoordinateNode* pNode)
+{
+	NODE_INFOS::iterator iter = nodes_.find(pNode);
+	if (iter == nodes_.end())
+		return;
+
+	++updating_;
+
+	CELL_KEY key = nodeCellKey(pNode);
+	if (key != iter->second.cellKey)
+	{
+		removeNodeFromCell(iter->second.cellKey, pNode);
+		cells_[key].nodes.push_back(pNode);
+		iter->second.cellKey = key;
+	}
+
+	// Ϊ۲ߣ ֻܽڸϵǼǵĴ 뿪ǰڵĴ
+	TRIGGERS triggers(iter->second.insideOf);
+
+	Cell& cell = cells_[key];
+	triggers.insert(triggers.end(), cell.triggers.begin(), cell.triggers.end());
+	triggers.insert(triggers.end(), largeTriggers_.begin(), largeTriggers_.end());
+
+	TRIGGERS::iterator titer = triggers.begin();
+	for (; titer != triggers.end(); ++titer)
+		checkNode((*titer), pNode);
+
+	// Ϊԭ㣺 ΪԭĴƶ
+	iter = nodes_.find(pNode);
+	if (iter != nodes_.end())
+	{
+		triggers = iter->second.triggers;
+
+		titer = triggers.begin();
+		for (; titer != triggers.end(); ++titer)
+		{
+			if ((*titer)->removed)
+				continue;
+
+			updateTriggerCells((*titer));
+			checkTrigger((*titer));
+		}
+	}
+
+	--updating_;
+}
+
+//-------------------------------------------------------------------------------------
+void CoordinateGrid::clear(NODES& nodes)
+{
+	nodes.reserve(nodes.size() + nodes_.size());
+
+	NODE_INFOS::iterator iter = nodes_.begin();
+	for (; iter != nodes_.end(); ++iter)
+		nodes.push_back(iter->first);
+
+	RANGE_TRIGGERS::iterator titer = triggers_.begin();
+	for (; titer != triggers_.end(); ++titer)
+	{
+		titer->second->removed = true;
+		dels_.push_back(titer->second);
+	}
+
+	triggers_.clear();
+	largeTriggers_.clear();
+	nodes_.clear();
+	cells_.clear();
+}
+
+//-------------------------------------------------------------------------------------
+bool CoordinateGrid::addTrigger(RangeTrigger* pRangeTrigger)
+{
+	removeTrigger(pRangeTrigger);
+
+	NODE_INFOS::iterator iter = nodes_.find(pRangeTrigger->origin());
+	if (iter == nodes_.end())
+		return false;
+
+	++updating_;
+
+	Trigger* pTrigger = new Trigger();
+	pTrigger->pRangeTrigger = pRangeTrigger;
+	pTrigger->pOrigin = pRangeTrigger->origin();
+	pTrigger->minCellX = 1;
+	pTrigger->maxCellX = 0;
+	pTrigger->minCellZ = 1;
+	pTrigger->maxCellZ = 0;
+	pTrigger->isLarge = false;
+	pTrigger->removed = false;
+
+	triggers_[pRangeTrigger] = pTrigger;
+	iter->second.triggers.push_back(pTrigger);
+
+	updateTriggerCells(pTrigger);
+
+	// װʱΧڵĽڵ㶼Ҫ
+	checkTrigger(pTrigger);
+
+	--updating_;
+	return true;
+}
+
+//-------------------------------------------------------------------------------------
+void CoordinateGrid::removeTrigger(RangeTrigger* pRangeTrigger)
+{
+	RANGE_TRIGGERS::iterator iter = triggers_.find(pRangeTrigger);
+	if (iter == triggers_.end())
+		return;
+
+	Trigger* pTrigger = iter->second;
+	triggers_.erase(iter);
+
+	// ʮһ£ жشʱ뿪¼
+	pTrigger->removed = true;
+	unregisterTrigger(pTrigger);
+
+	NODE_INFOS::iterator niter = nodes_.find(pTrigger->pOrigin);
+	if (niter != nodes_.end())
+		eraseFromVector(niter->second.triggers, pTrigger);
+
+	std::set<CoordinateNode*>::iterator siter = pTrigger->insiders.begin();
+	for (; siter != pTrigger->insiders.end(); ++siter)
+	{
+		niter = nodes_.find((*siter));
+		if (niter != nodes_.end())
+			eraseFromVector(niter->second.insideOf, pTrigger);
+	}
+
+	pTrigger->insiders.clear();
+	dels_.push_back(pTrigger);
+}
+
+//-------------------------------------------------------------------------------------
+void CoordinateGrid::updateTrigger(RangeTrigger* pRangeTrigger)
+{
+	RANGE_TRIGGERS::iterator iter = triggers_.find(pRangeTrigger);
+	if (iter == triggers_.end())
+		return;
+
+	++updating_;
+
+	Trigger* pTrigger = iter->second;
+	updateTriggerCells(pTrigger);
+	checkTrigger(pTrigger);
+
+	--updating_;
+}
+
+//-------------------------------------------------------------------------------------
+void CoordinateGrid::releaseTriggers()
+{
+	if (updating_ > 0 || dels_.empty())
+		return;
+
+	TRIGGERS::iterator iter = dels_.begin();
+	for (; iter != dels_.end(); ++iter)
+		delete (*iter);
+
+	dels_.clear();
+}
+
+//-------------------------------------------------------------------------------------
+void CoordinateGrid::entitiesInRange(std::vector<Entity*>& foundEntities, const Position3D& originPos,
+	float radius, int entityUType)
+{
+	radius = fabs(radius);
+
+	int32 minCellX = cellIndex(originPos.x - radius);
+	int32 maxCellX = cellIndex(originPos.x + radius);
+	int32 minCellZ = cellIndex(originPos.z - radius);
+	int32 maxCellZ = cellIndex(originPos.z + radius);
+
+	NODES nodes;
+	nodes.swap(scratchNodes_);
+	nodes.clear();
+
+	int64 numCells = (int64(maxCellX) - minCellX + 1) * (int64(maxCellZ) - minCellZ + 1);
+
+	// ΧڵĸӱȽڵ㻹ʱֱӱнڵ
+	if (numCells > (int64)nodes_.size())
+	{
+		nodes.reserve(nodes_.size());
+
+		NODE_INFOS::iterator iter = nodes_.begin();
+		for (; iter != nodes_.end(); ++iter)
+			nodes.push_back(iter->first);
+	}
+	else
+	{
+		for (int32 x = minCellX; x <= maxCellX; ++x)
+		{
+			for (int32 z = minCellZ; z <= maxCellZ; ++z)
+			{
+				CELLS::iterator iter = cells_.find(cellKey(x, z));
+				if (iter == cells_.end())
+					continue;
+
+				nodes.insert(nodes.end(), iter->second.nodes.begin(), iter->second.nodes.end());
+			}
+		}
+	}
+
+	NODES::iterator iter = nodes.begin();
+	for (; iter != nodes.end(); ++iter)
+	{
+		CoordinateNode* pNode = (*iter);
+		if (!pNode->hasFlags(COORDINATE_NODE_FLAG_ENTITY) || pNode->hasFlags(COORDINATE_NODE_FLAG_HIDE_OR_REMOVED))
+			continue;
+
+		Entity* pEntity = static_cast<EntityCoordinateNode*>(pNode)->pEntity();
+		if (entityUType != -1 && pEntity->pScriptModule()->getUType() != (ENTITY_SCRIPT_UID)entityUType)
+			continue;
+
+		const Position3D& pos = pEntity->position();
+		if (fabs(pos.x - originPos.x) > radius || fabs(pos.z - originPos.z) > radius)
+			continue;
+
+		if (CoordinateSystem::hasY && fabs(pos.y - originPos.y) > radius)
+			continue;
+
+		foundEntities.push_back(pEntity);
+	}
+
+	scratchNodes_.swap(nodes);
+}
+
+//-------------------------------------------------------------------------------------
+}
@@ -0,0 +1,143 @@
+// Copyright 2008-2018 Yolo Technologies, Inc. All Rights Reserved. https://www.comblockengine.com
+
+#ifndef KBE_COORDINATE_GRID_H
+#define KBE_COORDINATE_GRID_H
+
+#include "helper/debug_helper.h"
+#include "common/common.h"
+#include "math/math.h"
+#include "coordinate_node.h"
+
+namespace KBEngine{
+
+class Entity;
+class RangeTrigger;
+
+/**
+	ʵֵAOI CoordinateSystemʮ
+
+	ʮнڵÿƶҪԽ;Ľڵ㣬 ʵۼһ()˲ʱƶΪO(n)
+	xzƽ滮Ϊ߳ͬĸӣ ʵڵֻ¼Լڵĸӣ Ǽ䷶Χǵĸϣ
+	ڵƶʱֻڸϵĴ (ԭ)ƶʱֻ鸲ǸеĽڵ㡣
+	Ľ뿪жʮһ£ ͬͨRangeTrigger::onEnter/onLeave֪ͨ
+*/
+class CoordinateGrid
+{
+public:
+	typedef uint64 CELL_KEY;
+
+	struct Trigger;
+	typedef std::vector<Trigger*> TRIGGERS;
+	typedef std::vector<CoordinateNode*> NODES;
+
+	struct Cell
+	{
+		NODES nodes;										// λеĽڵ
+		TRIGGERS triggers;									// ΧӵĴ
+	};
+
+	struct NodeInfo
+	{
+		CELL_KEY cellKey;									// ڵڵĸ
+		TRIGGERS triggers;									// ڵΪԭĴ
+		TRIGGERS insideOf;									// ڵ㵱ǰЩΧ
+	};
+
+	struct Trigger
+	{
+		RangeTrigger* pRangeTrigger;
+		CoordinateNode* pOrigin;
+		int32 minCellX, maxCellX, minCellZ, maxCellZ;		// Χǵĸ
+		bool isLarge;										// Ǹӹ࣬ Ǽǵ϶Ǽнڵ
+		bool removed;										// Ѿжأ ȴreleaseTriggersͷ
+		std::set<CoordinateNode*> insiders;					// ǰڷΧڵĽڵ
+	};
+
+	// Ǽǵĸ ΪΧ
+	enum { MAX_TRIGGER_CELLS = 256 };
+
+	CoordinateGrid(float cellSize);
+	~CoordinateGrid();
+
+	/**
+		ڵ롢뿪Լڵλб䶯
+	*/
+	bool insert(CoordinateNode* pNode);
+	bool remove(CoordinateNode* pNode);
+	void update(CoordinateNode* pNode);
+
+	/**
+		ȡеĽڵ㲢 CoordinateSystemʱͷŽڵ
+	*/
+	void clear(NODES& nodes);
+
+	/**
+		װжشԼΧб䶯
+	*/
+	bool addTrigger(RangeTrigger* pRangeTrigger);
+	void removeTrigger(RangeTrigger* pRangeTrigger);
+	void updateTrigger(RangeTrigger* pRangeTrigger);
+
+	/**
+		ͷжصĴ
+	*/
+	void releaseTriggers();
+
+	/**
+		ҷΧڵentity EntityCoordinateNode::entitiesInRangeһ
+	*/
+	void entitiesInRange(std::vector<Entity*>& foundEntities, const Position3D& originPos,
+		float radius, int entityUType);
+
+	INLINE float cellSize() const;
+	INLINE size_t numNodes() const;
+	INLINE size_t numCells() const;
+	INLINE size_t numTriggers() const;
+
+private:
+	INLINE int32 cellIndex(float v) const;
+	INLINE static CELL_KEY cellKey(int32 x, int32 z);
+	INLINE CELL_KEY nodeCellKey(CoordinateNode* pNode) const;
+
+	bool isInRange(const Trigger* pTrigger, CoordinateNode* pNode) const;
+
+	void checkNode(Trigger* pTrigger, CoordinateNode* pNode);
+	void checkTrigger(Trigger* pTrigger);
+
+	void removeNodeFromCell(CELL_KEY key, CoordinateNode* pNode);
+
+	void registerTrigger(Trigger* pTrigger);
+	void unregisterTrigger(Trigger* pTrigger);
+	bool updateTriggerCells(Trigger* pTrigger);
+
+private:
+	float cellSize_;
+
+	typedef KBEUnordered_map<CELL_KEY, Cell> CELLS;
+	CELLS cells_;
+
+	typedef KBEUnordered_map<CoordinateNode*, NodeInfo> NODE_INFOS;
+	NODE_INFOS nodes_;
+
+	typedef KBEUnordered_map<RangeTrigger*, Trigger*> RANGE_TRIGGERS;
+	RANGE_TRIGGERS triggers_;
+
+	// Χ нڵƶʱҪ
+	TRIGGERS largeTriggers_;
+
+	// жصĴ updateжصĴܻã ͳһreleaseTriggersͷ
+	TRIGGERS dels_;
+
+	// entitiesInRangecheckTriggerռڵõĻ ʹʱٹ黹 
+	// صǶ׵ʱõǿջ ƻڱĽڵ
+	NODES scratchNodes_;
+
+	int updating_;
+};
+
+}
+
+#ifdef CODE_INLINE
+#include "coordinate_grid.inl"
+#endif
+#endif
@@ -0,0 +1,57 @@
+// Copyright 2008-2018 Yolo Technologies, Inc. All Rights Reserved. https://www.comblockengine.com
+
+
+namespace KBEngine{
+
+//-------------------------------------------------------------------------------------
+INLINE float CoordinateGrid::cellSize() const
+{
+	return cellSize_;
+}
+
+//-------------------------------------------------------------------------------------
+INLINE size_t CoordinateGrid::numNodes() const
+{
+	return nodes_.size();
+}
+
+//-------------------------------------------------------------------------------------
+INLINE size_t CoordinateGrid::numCells() const
+{
+	return cells_.size();
+}
+
+//-------------------------------------------------------------------------------------
+INLINE size_t CoordinateGrid::numTriggers() const
+{
+	return triggers_.size();
+}
+
+//-------------------------------------------------------------------------------------
+INLINE int32 CoordinateGrid::cellIndex(float v) const
+{
+	// ɾеĽڵΪ-FLT_MAX Ҫint32Χ
+	float idx = floorf(v / cellSize_);
+
+	if (idx < -1000000000.f)
+		return -1000000000;
+	else if (idx > 1000000000.f)
+		return 1000000000;
+
+	return (int32)idx;
+}
+
+//-------------------------------------------------------------------------------------
+INLINE CoordinateGrid::CELL_KEY CoordinateGrid::cellKey(int32 x, int32 z)
+{
+	return (((CELL_KEY)(uint32)x) << 32) | (CELL_KEY)(uint32)z;
+}
+
+//-------------------------------------------------------------------------------------
+INLINE CoordinateGrid::CELL_KEY CoordinateGrid::nodeCellKey(CoordinateNode* pNode) const
+{
+	return cellKey(cellIndex(pNode->xx()), cellIndex(pNode->zz()));
+}
+
+//-------------------------------------------------------------------------------------
+}
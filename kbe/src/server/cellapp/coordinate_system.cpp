@@ -1,6 +1,7 @@
 // Copyright 2008-2018 Yolo Technologies, Inc. All Rights Reserved. https://www.comblockengine.com
 #include "coordinate_node.h"
 #include "coordinate_system.h"
+#include "coordinate_grid.h"
 #include "profile.h"
 
 #ifndef CODE_INLINE
@@ -20,13 +21,30 @@ first_z_coordinateNode_(NULL),
 dels_(),
 dels_count_(0),
 updating_(0),
-releases_()
+releases_(),
+pCoordinateGrid_(NULL)
 {
 }
 
 //-------------------------------------------------------------------------------------
 CoordinateSystem::~CoordinateSystem()
 {
+	if(pCoordinateGrid_)
+	{
+		// ģʽɾδͷŵĽڵ㲻У Ҫͷ
+		std::vector<CoordinateNode*> nodes(dels_.begin(), dels_.end());
+		pCoordinateGrid_->clear(nodes);
+
+		std::vector<CoordinateNode*>::iterator iter = nodes.begin();
+		for(; iter != nodes.end(); ++iter)
+		{
+			(*iter)->pCoordinateSystem(NULL);
+			delete (*iter);
+		}
+
+		SAFE_RELEASE(pCoordinateGrid_);
+	}
+
 	dels_.clear();
 	dels_count_ = 0;
 
@@ -62,9 +80,32 @@ CoordinateSystem::~CoordinateSystem()
 	releaseNodes();
 }
 
+//-------------------------------------------------------------------------------------
+bool CoordinateSystem::useGrid(float cellSize)
+{
+	if(pCoordinateGrid_ || !isEmpty() || size_ > 0)
+		return false;
+
+	pCoordinateGrid_ = new CoordinateGrid(cellSize);
+	return true;
+}
+
 //-------------------------------------------------------------------------------------
 bool CoordinateSystem::insert(CoordinateNode* pNode)
 {
+	if(pCoordinateGrid_)
+	{
+		pNode->x(pNode->xx());
+		pNode->y(pNode->yy());
+		pNode->z(pNode->zz());
+		pNode->pCoordinateSystem(this);
+		++size_;
+
+		pCoordinateGrid_->insert(pNode);
+		pNode->resetOld();
+		return true;
+	}
+
 	// ǿյ, ʼһһxzڵΪýڵ
 	if(isEmpty())
 	{
@@ -128,7 +169,11 @@ bool CoordinateSystem::remove(CoordinateNode* pNode)
 {
 	pNode->addFlags(COORDINATE_NODE_FLAG_REMOVING);
 	pNode->onRemove();
-	update(pNode);
+
+	if(pCoordinateGrid_)
+		pCoordinateGrid_->remove(pNode);
+	else
+		update(pNode);
 	
 	pNode->addFlags(COORDINATE_NODE_FLAG_REMOVED);
 
@@ -179,6 +224,9 @@ void CoordinateSystem::releaseNodes()
 	}
 
 	releases_.clear();
+
+	if(pCoordinateGrid_)
+		pCoordinateGrid_->releaseTriggers();
 }
 
 //-------------------------------------------------------------------------------------
@@ -189,6 +237,15 @@ bool CoordinateSystem::removeReal(CoordinateNode* pNode)
 		return true;
 	}
 
+	if(pCoordinateGrid_)
+	{
+		pNode->pCoordinateSystem(NULL);
+		releases_.push_back(pNode);
+
+		--size_;
+		return true;
+	}
+
 	// ǵһڵ
 	if(first_x_coordinateNode_ == pNode)
 	{
@@ -265,11 +322,13 @@ void CoordinateSystem::moveNodeX(CoordinateNode* pNode, float px, CoordinateNode
 {
 	if (pCurrNode != NULL)
 	{
+		++g_coordinateNodePasses;
+
 		pNode->x(pCurrNode->x());
 
 #ifdef DEBUG_COORDINATE_SYSTEM
-		DEBUG_MSG(fmt::format("CoordinateSystem::update start: [{}X] ({}), pCurrNode=>({})\n",
-			(pNode->pPrevX() == pCurrNode ? "-" : "+"), pNode->c_str(), pCurrNode->c_str()));
+		DEBUG_FMT("CoordinateSystem::update start: [{}X] ({}), pCurrNode=>({})\n",
+			(pNode->pPrevX() == pCurrNode ? "-" : "+"), pNode->c_str(), pCurrNode->c_str());
 #endif
 
 		if (pNode->pPrevX() == pCurrNode)
@@ -328,8 +387,8 @@ void CoordinateSystem::moveNodeX(CoordinateNode* pNode, float px, CoordinateNode
 		if (!pNode->hasFlags(COORDINATE_NODE_FLAG_HIDE_OR_REMOVED))
 		{
 #ifdef DEBUG_COORDINATE_SYSTEM
-			DEBUG_MSG(fmt::format("CoordinateSystem::update1: [{}X] ({}), passNode=>({})\n",
-				(pNode->pPrevX() == pCurrNode ? "-" : "+"), pNode->c_str(), pCurrNode->c_str()));
+			DEBUG_FMT("CoordinateSystem::update1: [{}X] ({}), passNode=>({})\n",
+				(pNode->pPrevX() == pCurrNode ? "-" : "+"), pNode->c_str(), pCurrNode->c_str());
 #endif
 
 			pCurrNode->onNodePassX(pNode, true);
@@ -338,16 +397,16 @@ void CoordinateSystem::moveNodeX(CoordinateNode* pNode, float px, CoordinateNode
 		if (!pCurrNode->hasFlags(COORDINATE_NODE_FLAG_HIDE_OR_REMOVED))
 		{
 #ifdef DEBUG_COORDINATE_SYSTEM
-			DEBUG_MSG(fmt::format("CoordinateSystem::update2: [{}X] ({}), passNode=>({})\n",
-				(pNode->pPrevX() == pCurrNode ? "-" : "+"), pNode->c_str(), pCurrNode->c_str()));
+			DEBUG_FMT("CoordinateSystem::update2: [{}X] ({}), passNode=>({})\n",
+				(pNode->pPrevX() == pCurrNode ? "-" : "+"), pNode->c_str(), pCurrNode->c_str());
 #endif
 
 			pNode->onNodePassX(pCurrNode, false);
 		}
 
 #ifdef DEBUG_COORDINATE_SYSTEM
-		DEBUG_MSG(fmt::format("CoordinateSystem::update end: [{}X] ({}), pCurrNode=>({})\n",
-			(pNode->pPrevX() == pCurrNode ? "-" : "+"), pNode->c_str(), pCurrNode->c_str()));
+		DEBUG_FMT("CoordinateSystem::update end: [{}X] ({}), pCurrNode=>({})\n",
+			(pNode->pPrevX() == pCurrNode ? "-" : "+"), pNode->c_str(), pCurrNode->c_str());
 #endif
 	}
 }
@@ -357,11 +416,13 @@ void CoordinateSystem::moveNodeY(CoordinateNode* pNode, float py, CoordinateNode
 {
 	if (pCurrNode != NULL)
 	{
+		++g_coordinateNodePasses;
+
 		pNode->y(pCurrNode->y());
 
 #ifdef DEBUG_COORDINATE_SYSTEM
-		DEBUG_MSG(fmt::format("CoordinateSystem::update start: [{}Y] ({}), pCurrNode=>({})\n",
-			(pNode->pPrevY() == pCurrNode ? "-" : "+"), pNode->c_str(), pCurrNode->c_str()));
+		DEBUG_FMT("CoordinateSystem::update start: [{}Y] ({}), pCurrNode=>({})\n",
+			(pNode->pPrevY() == pCurrNode ? "-" : "+"), pNode->c_str(), pCurrNode->c_str());
 #endif
 
 		if (pNode->pPrevY() == pCurrNode)
@@ -420,8 +481,8 @@ void CoordinateSystem::moveNodeY(CoordinateNode* pNode, float py, CoordinateNode
 		if (!pNode->hasFlags(COORDINATE_NODE_FLAG_HIDE_OR_REMOVED))
 		{
 #ifdef DEBUG_COORDINATE_SYSTEM
-			DEBUG_MSG(fmt::format("CoordinateSystem::update1: [{}Y] ({}), passNode=>({})\n",
-				(pNode->pPrevY() == pCurrNode ? "-" : "+"), pNode->c_str(), pCurrNode->c_str()));
+			DEBUG_FMT("CoordinateSystem::update1: [{}Y] ({}), passNode=>({})\n",
+				(pNode->pPrevY() == pCurrNode ? "-" : "+"), pNode->c_str(), pCurrNode->c_str());
 #endif
 
 			pCurrNode->onNodePassY(pNode, true);
@@ -430,16 +491,16 @@ void CoordinateSystem::moveNodeY(CoordinateNode* pNode, float py, CoordinateNode
 		if (!pCurrNode->hasFlags(COORDINATE_NODE_FLAG_HIDE_OR_REMOVED))
 		{
 #ifdef DEBUG_COORDINATE_SYSTEM
-			DEBUG_MSG(fmt::format("CoordinateSystem::update2: [{}Y] ({}), passNode=>({})\n",
-				(pNode->pPrevY() == pCurrNode ? "-" : "+"), pNode->c_str(), pCurrNode->c_str()));
+			DEBUG_FMT("CoordinateSystem::update2: [{}Y] ({}), passNode=>({})\n",
+				(pNode->pPrevY() == pCurrNode ? "-" : "+"), pNode->c_str(), pCurrNode->c_str());
 #endif
 
 			pNode->onNodePassY(pCurrNode, false);
 		}
 
 #ifdef DEBUG_COORDINATE_SYSTEM
-		DEBUG_MSG(fmt::format("CoordinateSystem::update end: [{}Y] ({}), pCurrNode=>({})\n",
-			(pNode->pPrevY() == pCurrNode ? "-" : "+"), pNode->c_str(), pCurrNode->c_str()));
+		DEBUG_FMT("CoordinateSystem::update end: [{}Y] ({}), pCurrNode=>({})\n",
+			(pNode->pPrevY() == pCurrNode ? "-" : "+"), pNode->c_str(), pCurrNode->c_str());
 #endif
 	}
 }
@@ -449,11 +510,13 @@ void CoordinateSystem::moveNodeZ(CoordinateNode* pNode, float pz, CoordinateNode
 {
 	if (pCurrNode != NULL)
 	{
+		++g_coordinateNodePasses;
+
 		pNode->z(pCurrNode->z());
 
 #ifdef DEBUG_COORDINATE_SYSTEM
-		DEBUG_MSG(fmt::format("CoordinateSystem::update start: [{}Z] ({}), pCurrNode=>({})\n",
-			(pNode->pPrevZ() == pCurrNode ? "-" : "+"), pNode->c_str(), pCurrNode->c_str()));
+		DEBUG_FMT("CoordinateSystem::update start: [{}Z] ({}), pCurrNode=>({})\n",
+			(pNode->pPrevZ() == pCurrNode ? "-" : "+"), pNode->c_str(), pCurrNode->c_str());
 #endif
 
 		if (pNode->pPrevZ() == pCurrNode)
@@ -512,8 +575,8 @@ void CoordinateSystem::moveNodeZ(CoordinateNode* pNode, float pz, CoordinateNode
 		if (!pNode->hasFlags(COORDINATE_NODE_FLAG_HIDE_OR_REMOVED))
 		{
 #ifdef DEBUG_COORDINATE_SYSTEM
-			DEBUG_MSG(fmt::format("CoordinateSystem::update1: [{}Z] ({}), passNode=>({})\n",
-				(pNode->pPrevZ() == pCurrNode ? "-" : "+"), pNode->c_str(), pCurrNode->c_str()));
+			DEBUG_FMT("CoordinateSystem::update1: [{}Z] ({}), passNode=>({})\n",
+				(pNode->pPrevZ() == pCurrNode ? "-" : "+"), pNode->c_str(), pCurrNode->c_str());
 #endif
 
 			pCurrNode->onNodePassZ(pNode, true);
@@ -522,16 +585,16 @@ void CoordinateSystem::moveNodeZ(CoordinateNode* pNode, float pz, CoordinateNode
 		if (!pCurrNode->hasFlags(COORDINATE_NODE_FLAG_HIDE_OR_REMOVED))
 		{
 #ifdef DEBUG_COORDINATE_SYSTEM
-			DEBUG_MSG(fmt::format("CoordinateSystem::update2: [{}Z] ({}), passNode=>({})\n",
-				(pNode->pPrevZ() == pCurrNode ? "-" : "+"), pNode->c_str(), pCurrNode->c_str()));
+			DEBUG_FMT("CoordinateSystem::update2: [{}Z] ({}), passNode=>({})\n",
+				(pNode->pPrevZ() == pCurrNode ? "-" : "+"), pNode->c_str(), pCurrNode->c_str());
 #endif
 
 			pNode->onNodePassZ(pCurrNode, false);
 }
 
 #ifdef DEBUG_COORDINATE_SYSTEM
-		DEBUG_MSG(fmt::format("CoordinateSystem::update end: [{}Z] ({}), pCurrNode=>({})\n",
-			(pNode->pPrevZ() == pCurrNode ? "-" : "+"), pNode->c_str(), pCurrNode->c_str()));
+		DEBUG_FMT("CoordinateSystem::update end: [{}Z] ({}), pCurrNode=>({})\n",
+			(pNode->pPrevZ() == pCurrNode ? "-" : "+"), pNode->c_str(), pCurrNode->c_str());
 #endif
 	}
 }
@@ -542,7 +605,7 @@ void CoordinateSystem::update(CoordinateNode* pNode)
 	AUTO_SCOPED_PROFILE("coordinateSystemUpdates");
 
 #ifdef DEBUG_COORDINATE_SYSTEM
-	DEBUG_MSG(fmt::format("CoordinateSystem::update enter:[{:p}]:  ({}  {}  {})\n", (void*)pNode, pNode->xx(), pNode->yy(), pNode->zz()));
+	DEBUG_FMT("CoordinateSystem::update enter:[{:p}]:  ({}  {}  {})\n", (void*)pNode, pNode->xx(), pNode->yy(), pNode->zz());
 #endif
 
 	// ûм֧֣Ǻܿ;updateӷ֧ȡû
@@ -550,6 +613,18 @@ void CoordinateSystem::update(CoordinateNode* pNode)
 
 	++updating_;
 
+	if (pCoordinateGrid_)
+	{
+		pCoordinateGrid_->update(pNode);
+
+		pNode->x(pNode->xx());
+		pNode->y(pNode->yy());
+		pNode->z(pNode->zz());
+		pNode->resetOld();
+		--updating_;
+		return;
+	}
+
 	if (pNode->xx() != pNode->old_xx())
 	{
 		CoordinateNode* pCurrNode = pNode->pPrevX();
@@ -627,11 +702,11 @@ void CoordinateSystem::update(CoordinateNode* pNode)
 	//	releaseNodes();
 
 #ifdef DEBUG_COORDINATE_SYSTEM
-	DEBUG_MSG(fmt::format("CoordinateSystem::debugX[ x ]:[{:p}]\n", (void*)pNode));
+	DEBUG_FMT("CoordinateSystem::debugX[ x ]:[{:p}]\n", (void*)pNode);
 	first_x_coordinateNode_->debugX();
-	DEBUG_MSG(fmt::format("CoordinateSystem::debugY[ y ]:[{:p}]\n", (void*)pNode));
+	DEBUG_FMT("CoordinateSystem::debugY[ y ]:[{:p}]\n", (void*)pNode);
 	if (first_y_coordinateNode_)first_y_coordinateNode_->debugY();
-	DEBUG_MSG(fmt::format("CoordinateSystem::debugZ[ z ]:[{:p}]\n", (void*)pNode));
+	DEBUG_FMT("CoordinateSystem::debugZ[ z ]:[{:p}]\n", (void*)pNode);
 	first_z_coordinateNode_->debugZ();
 #endif
 }
@@ -11,6 +11,7 @@
 namespace KBEngine{
 
 class CoordinateNode;
+class CoordinateGrid;
 
 class CoordinateSystem
 {
@@ -57,6 +58,12 @@ public:
 	INLINE void incUpdating();
 	INLINE void decUpdating();
 
+	/**
+		ʹ(CoordinateGrid)ʮڵ㣬 ڲκνڵ֮ǰ
+	*/
+	bool useGrid(float cellSize);
+	INLINE CoordinateGrid* pCoordinateGrid() const;
+
 private:
 	uint32 size_;
 
@@ -71,6 +78,9 @@ private:
 	int updating_;
 
 	std::list<CoordinateNode*> releases_;
+
+	// ΪNULLʹʵ֣ ʱڵ㲻ʮ
+	CoordinateGrid* pCoordinateGrid_;
 };
 
 }
@@ -34,6 +34,12 @@ INLINE void CoordinateSystem::decUpdating()
 	--updating_;
 }
 
+//-------------------------------------------------------------------------------------
+INLINE CoordinateGrid* CoordinateSystem::pCoordinateGrid() const
+{
+	return pCoordinateGrid_;
+}
+
 //-------------------------------------------------------------------------------------
 
 }
@@ -60,6 +60,7 @@ SCRIPT_METHOD_DECLARE("moveToPoint",				pyMoveToPoint,					METH_VARARGS,				0)
 SCRIPT_METHOD_DECLARE("moveToEntity",				pyMoveToEntity,					METH_VARARGS,				0)
 SCRIPT_METHOD_DECLARE("accelerate",					pyAccelerate,					METH_VARARGS,				0)
 SCRIPT_METHOD_DECLARE("entitiesInRange",			pyEntitiesInRange,				METH_VARARGS,				0)
+SCRIPT_METHOD_DECLARE("entitiesInRangeBatch",		pyEntitiesInRangeBatch,			METH_VARARGS,				0)
 SCRIPT_METHOD_DECLARE("entitiesInView",				pyEntitiesInView,				METH_VARARGS,				0)
 SCRIPT_METHOD_DECLARE("teleport",					pyTeleport,						METH_VARARGS,				0)
 SCRIPT_METHOD_DECLARE("destroySpace",				pyDestroySpace,					METH_VARARGS,				0)
@@ -92,6 +93,7 @@ BASE_SCRIPT_INIT(Entity, 0, 0, 0, 0, 0)
 Entity::BufferedScriptCallArray Entity::_scriptCallbacksBuffer;
 int32 Entity::_scriptCallbacksBufferCount = 0;
 int32 Entity::_scriptCallbacksBufferNum = 0;
+std::vector<ENTITY_ID> Entity::_defDataChangedEntities;
 
 //-------------------------------------------------------------------------------------
 Entity::Entity(ENTITY_ID id, const ScriptDefModule* pScriptModule,
@@ -122,7 +124,9 @@ pControllers_(new Controllers(id)),
 pyPositionChangedCallback_(),
 pyDirectionChangedCallback_(),
 layer_(0),
-pCustomVolatileinfo_(NULL)
+pCustomVolatileinfo_(NULL),
+volatileDataCache_(),
+defDataChanges_()
 {
 	setDirty();
 
@@ -148,6 +152,8 @@ Entity::~Entity()
 
 	S_RELEASE(pCustomVolatileinfo_);
 
+	clearDefDataChanges();
+
 	S_RELEASE(clientEntityCall_);
 	S_RELEASE(baseEntityCall_);
 	S_RELEASE(allClients_);
@@ -203,6 +209,10 @@ void Entity::onCoordinateNodesDestroy(EntityCoordinateNode* pEntityCoordinateNod
 //-------------------------------------------------------------------------------------
 void Entity::onDestroy(bool callScript)
 {
+	// realʱҪͬʱcellϵghost
+	if(isReal() && hasGhost())
+		destroyGhost();
+
 	if(callScript && isReal())
 	{
 		SCOPED_PROFILE(SCRIPTCALL_PROFILE);
@@ -221,6 +231,9 @@ void Entity::onDestroy(bool callScript)
 		}
 	}
 
+	// űonDestroyиıҲҪ뿪۲Ұǰ
+	flushDefDataChanges();
+
 	stopMove();
 
 	// ߵ
@@ -717,79 +730,11 @@ void Entity::onDefDataChanged(EntityComponent* pEntityComponent, const PropertyD
 		}
 	}
 	
-	const Position3D& basePos = this->position(); 
-	if((flags & ENTITY_BROADCAST_OTHER_CLIENT_FLAGS) > 0)
+	// 㲥ͻ˵Ըıȼ¼ tickĩβflushDefDataChangesϲ
+	// ͬһtickڸıʱÿ۲ֻյһϢ ͬһԶθıҲֵֻ
+	if((flags & ENTITY_BROADCAST_OTHER_CLIENT_FLAGS) > 0 && witnesses_count_ > 0)
 	{
-		DETAIL_TYPE propertyDetailLevel = propertyDescription->getDetailLevel();
-
-		std::list<ENTITY_ID>::iterator witer = witnesses_.begin();
-		for(; witer != witnesses_.end(); ++witer)
-		{
-			Entity* pEntity = Cellapp::getSingleton().findEntity((*witer));
-			if(pEntity == NULL || pEntity->pWitness() == NULL)
-				continue;
-
-			EntityCall* clientEntityCall = pEntity->clientEntityCall();
-			if(clientEntityCall == NULL)
-				continue;
-
-			Network::Channel* pChannel = clientEntityCall->getChannel();
-			if(pChannel == NULL)
-				continue;
-
-			// ǴڵģԴcreateWitnessFromStream()
-			// ԼentityδĿͻϴ
-			if(!pEntity->pWitness()->entityInView(id()))
-				continue;
-
-			const Position3D& targetPos = pEntity->position();
-			Position3D lengthPos = targetPos - basePos;
-
-			if(pScriptModule_->getDetailLevel().level[propertyDetailLevel].inLevel(lengthPos.length()))
-			{
-				Network::Bundle* pSendBundle = pChannel->createSendBundle();
-				NETWORK_ENTITY_MESSAGE_FORWARD_CLIENT_BEGIN(pEntity->id(), (*pSendBundle));
-				
-				int ialiasID = -1;
-				const Network::MessageHandler& msgHandler = pEntity->pWitness()->getViewEntityMessageHandler(ClientInterface::onUpdatePropertys, 
-					ClientInterface::onUpdatePropertysOptimized, id(), ialiasID);
-				
-				ENTITY_MESSAGE_FORWARD_CLIENT_BEGIN(pSendBundle, msgHandler, viewEntityMessage);
-				
-				if(ialiasID != -1)
-				{
-					KBE_ASSERT(msgHandler.msgID == ClientInterface::onUpdatePropertysOptimized.msgID);
-					(*pSendBundle)  << (uint8)ialiasID;
-				}
-				else
-				{
-					KBE_ASSERT(msgHandler.msgID == ClientInterface::onUpdatePropertys.msgID);
-					(*pSendBundle)  << id();
-				}
-				
-				if (pScriptModule_->usePropertyDescrAlias())
-				{
-					(*pSendBundle) << componentPropertyAliasID;
-					(*pSendBundle) << propertyDescription->aliasIDAsUint8();
-				}
-				else
-				{
-					(*pSendBundle) << componentPropertyUID;
-					(*pSendBundle) << propertyDescription->getUType();
-				}
-
-				pSendBundle->append(*mstream);
-				
-				// ¼¼С
-				g_publicClientEventHistoryStats.trackEvent(scriptName(), 
-					propertyDescription->getName(), 
-					pSendBundle->currMsgLength());
-
-				ENTITY_MESSAGE_FORWARD_CLIENT_END(pSendBundle, msgHandler, viewEntityMessage);
-
-				pEntity->pWitness()->sendToClient(ClientInterface::onUpdatePropertysOptimized, pSendBundle);
-			}
-		}
+		addDefDataChange(propertyDescription, componentPropertyUID, (uint8)componentPropertyAliasID, mstream);
 	}
 
 	/*
@@ -892,6 +837,229 @@ void Entity::onDefDataChanged(EntityComponent* pEntityComponent, const PropertyD
 	MemoryStream::reclaimPoolObject(mstream);
 }
 
+//-------------------------------------------------------------------------------------
+void Entity::addDefDataChange(const PropertyDescription* propertyDescription, ENTITY_PROPERTY_UID componentPropertyUID,
+	uint8 componentPropertyAliasID, MemoryStream* mstream)
+{
+	uint32 headerSize = pScriptModule_->usePropertyDescrAlias() ? 
+		(sizeof(uint8) * 2) : (sizeof(ENTITY_PROPERTY_UID) * 2);
+
+	DEF_DATA_CHANGES::iterator iter = defDataChanges_.begin();
+	for(; iter != defDataChanges_.end(); ++iter)
+	{
+		if(iter->pPropertyDescription != propertyDescription || iter->componentPropertyUID != componentPropertyUID)
+			continue;
+
+		// ͬһڱtickٴθı䣬 ֵֻ
+		iter->pData->clear(false);
+		iter->pData->append(*mstream);
+		++iter->writes;
+		iter->writtenBytes += headerSize + (uint32)mstream->length();
+		return;
+	}
+
+	if(defDataChanges_.empty())
+		_defDataChangedEntities.push_back(id());
+
+	DefDataChange change;
+	change.pPropertyDescription = propertyDescription;
+	change.componentPropertyUID = componentPropertyUID;
+	change.componentPropertyAliasID = componentPropertyAliasID;
+	change.writes = 1;
+	change.writtenBytes = headerSize + (uint32)mstream->length();
+	change.pData = MemoryStream::createPoolObject(OBJECTPOOL_POINT);
+	change.pData->append(*mstream);
+	defDataChanges_.push_back(change);
+}
+
+//-------------------------------------------------------------------------------------
+void Entity::clearDefDataChanges()
+{
+	DEF_DATA_CHANGES::iterator iter = defDataChanges_.begin();
+	for(; iter != defDataChanges_.end(); ++iter)
+		MemoryStream::reclaimPoolObject(iter->pData);
+
+	defDataChanges_.clear();
+}
+
+//-------------------------------------------------------------------------------------
+void Entity::flushDefDataChanges()
+{
+	if(defDataChanges_.empty())
+		return;
+
+	// isDestroyed() onDestroyеʱѾΪ٣ ǰĸıȻҪ۲
+	if(!isReal() || witnesses_count_ == 0)
+	{
+		clearDefDataChanges();
+		return;
+	}
+
+	// 鼶ԸıлһΣ й۲߹
+	MemoryStream* levelStreams[3] = { NULL, NULL, NULL };
+	uint32 levelWrites[3] = { 0, 0, 0 };
+	uint32 levelWrittenBytes[3] = { 0, 0, 0 };
+
+	bool usePropertyDescrAlias = pScriptModule_->usePropertyDescrAlias();
+	uint32 headerSize = usePropertyDescrAlias ? (sizeof(uint8) * 2) : (sizeof(ENTITY_PROPERTY_UID) * 2);
+
+	DEF_DATA_CHANGES::iterator iter = defDataChanges_.begin();
+	for(; iter != defDataChanges_.end(); ++iter)
+	{
+		DETAIL_TYPE lv = (DETAIL_TYPE)iter->pPropertyDescription->getDetailLevel();
+		if(lv > DETAIL_LEVEL_FAR)
+			lv = DETAIL_LEVEL_FAR;
+
+		MemoryStream*& s = levelStreams[lv];
+		if(s == NULL)
+			s = MemoryStream::createPoolObject(OBJECTPOOL_POINT);
+
+		if (usePropertyDescrAlias)
+		{
+			(*s) << iter->componentPropertyAliasID;
+			(*s) << iter->pPropertyDescription->aliasIDAsUint8();
+		}
+		else
+		{
+			(*s) << iter->componentPropertyUID;
+			(*s) << iter->pPropertyDescription->getUType();
+		}
+
+		s->append(*iter->pData);
+
+		levelWrites[lv] += iter->writes;
+		levelWrittenBytes[lv] += iter->writtenBytes;
+	}
+
+	DetailLevel& detailLevel = pScriptModule_->getDetailLevel();
+	const Position3D& basePos = this->position();
+
+	std::list<ENTITY_ID>::iterator witer = witnesses_.begin();
+	for(; witer != witnesses_.end(); ++witer)
+	{
+		Entity* pEntity = Cellapp::getSingleton().findEntity((*witer));
+		if(pEntity == NULL || pEntity->pWitness() == NULL)
+			continue;
+
+		EntityCall* clientEntityCall = pEntity->clientEntityCall();
+		if(clientEntityCall == NULL)
+			continue;
+
+		Network::Channel* pChannel = clientEntityCall->getChannel();
+		if(pChannel == NULL)
+			continue;
+
+		// ǴڵģԴcreateWitnessFromStream()
+		// ԼentityδĿͻϴ
+		if(!pEntity->pWitness()->entityInView(id()))
+			continue;
+
+		Position3D lengthPos = pEntity->position() - basePos;
+		float dist = lengthPos.length();
+
+		bool inLevels[3] = { false, false, false };
+		uint32 writes = 0;
+		uint32 writtenBytes = 0;
+		uint32 payloadBytes = 0;
+
+		for(int lv = 0; lv < 3; ++lv)
+		{
+			if(levelStreams[lv] == NULL || !detailLevel.level[lv].inLevel(dist))
+				continue;
+
+			inLevels[lv] = true;
+			writes += levelWrites[lv];
+			writtenBytes += levelWrittenBytes[lv];
+			payloadBytes += (uint32)levelStreams[lv]->length();
+		}
+
+		if(writes == 0)
+			continue;
+
+		Network::Bundle* pSendBundle = pChannel->createSendBundle();
+		NETWORK_ENTITY_MESSAGE_FORWARD_CLIENT_BEGIN(pEntity->id(), (*pSendBundle));
+		
+		int ialiasID = -1;
+		const Network::MessageHandler& msgHandler = pEntity->pWitness()->getViewEntityMessageHandler(ClientInterface::onUpdatePropertys, 
+			ClientInterface::onUpdatePropertysOptimized, id(), ialiasID);
+		
+		ENTITY_MESSAGE_FORWARD_CLIENT_BEGIN(pSendBundle, msgHandler, viewEntityMessage);
+		
+		if(ialiasID != -1)
+		{
+			KBE_ASSERT(msgHandler.msgID == ClientInterface::onUpdatePropertysOptimized.msgID);
+			(*pSendBundle)  << (uint8)ialiasID;
+		}
+		else
+		{
+			KBE_ASSERT(msgHandler.msgID == ClientInterface::onUpdatePropertys.msgID);
+			(*pSendBundle)  << id();
+		}
+		
+		for(int lv = 0; lv < 3; ++lv)
+		{
+			if(inLevels[lv])
+				pSendBundle->append(*levelStreams[lv]);
+		}
+
+		// ÿϢ֮Ŀ ÿθı䶼ÿζҪⲿֿ
+		uint32 msgOverhead = (uint32)pSendBundle->currMsgLength() - payloadBytes;
+
+		// ¼¼С
+		for(iter = defDataChanges_.begin(); iter != defDataChanges_.end(); ++iter)
+		{
+			DETAIL_TYPE lv = (DETAIL_TYPE)iter->pPropertyDescription->getDetailLevel();
+			if(!inLevels[lv > DETAIL_LEVEL_FAR ? DETAIL_LEVEL_FAR : lv])
+				continue;
+
+			g_publicClientEventHistoryStats.trackEvent(scriptName(), 
+				iter->pPropertyDescription->getName(), 
+				msgOverhead + headerSize + (uint32)iter->pData->length());
+		}
+
+		ENTITY_MESSAGE_FORWARD_CLIENT_END(pSendBundle, msgHandler, viewEntityMessage);
+
+		pEntity->pWitness()->sendToClient(ClientInterface::onUpdatePropertysOptimized, pSendBundle);
+
+		g_propertyUpdateMessagesSaved += writes - 1;
+		g_propertyUpdateBytesSaved += (uint64)(writes - 1) * msgOverhead + (writtenBytes - payloadBytes);
+	}
+
+	for(int lv = 0; lv < 3; ++lv)
+	{
+		if(levelStreams[lv])
+			MemoryStream::reclaimPoolObject(levelStreams[lv]);
+	}
+
+	clearDefDataChanges();
+}
+
+//-------------------------------------------------------------------------------------
+void Entity::flushAllDefDataChanges()
+{
+	if(_defDataChangedEntities.empty())
+		return;
+
+	// ͹пܻµentity룬 Ƚ
+	std::vector<ENTITY_ID> entities;
+	entities.swap(_defDataChangedEntities);
+
+	std::vector<ENTITY_ID>::iterator iter = entities.begin();
+	for(; iter != entities.end(); ++iter)
+	{
+		Entity* pEntity = Cellapp::getSingleton().findEntity((*iter));
+		if(pEntity)
+			pEntity->flushDefDataChanges();
+	}
+
+	//  ÿtick·
+	if(_defDataChangedEntities.empty())
+	{
+		entities.clear();
+		_defDataChangedEntities.swap(entities);
+	}
+}
+
 //-------------------------------------------------------------------------------------
 void Entity::onRemoteMethodCall(Network::Channel* pChannel, MemoryStream& s)
 {
@@ -3236,56 +3404,39 @@ PyObject* Entity::entitiesInView(bool pending)
 }
 
 //-------------------------------------------------------------------------------------
-PyObject* Entity::__py_pyEntitiesInRange(PyObject* self, PyObject* args)
+bool Entity::parseEntitiesInRangeArgs(Entity* pobj, PyObject* args, const char* funcName,
+	float& radius, int& entityUType, Position3D& originpos)
 {
 	uint16 currargsSize = PyTuple_Size(args);
-	Entity* pobj = static_cast<Entity*>(self);
-
-	if (!pobj->isReal())
-	{
-		PyErr_Format(PyExc_AssertionError, "%s::entitiesInRange: not is real entity(%d).",
-			pobj->scriptName(), pobj->id());
-		PyErr_PrintEx(0);
-		return 0;
-	}
-
 	PyObject* pyPosition = NULL, *pyEntityType = NULL;
-	float radius = 0.f;
-
-	if (pobj->isDestroyed() && !pobj->hasFlags(ENTITY_FLAGS_DESTROYING) /* ڼ */)
-	{
-		PyErr_Format(PyExc_TypeError, "%s::entitiesInRange: entity(%d) is destroyed!",
-			pobj->scriptName(), pobj->id());
-		PyErr_PrintEx(0);
-		return 0;
-	}
+	radius = 0.f;
 
 	if (currargsSize == 1)
 	{
 		if (!PyArg_ParseTuple(args, "f", &radius))
 		{
-			PyErr_Format(PyExc_TypeError, "%s::entitiesInRange: args error! entity(%d)",
-				pobj->scriptName(), pobj->id());
+			PyErr_Format(PyExc_TypeError, "%s::%s: args error! entity(%d)",
+				pobj->scriptName(), funcName, pobj->id());
 			PyErr_PrintEx(0);
-			return 0;
+			return false;
 		}
 	}
 	else if (currargsSize == 2)
 	{
 		if (!PyArg_ParseTuple(args, "fO", &radius, &pyEntityType))
 		{
-			PyErr_Format(PyExc_TypeError, "%s::entitiesInRange: args error! entity(%d)",
-				pobj->scriptName(), pobj->id());
+			PyErr_Format(PyExc_TypeError, "%s::%s: args error! entity(%d)",
+				pobj->scriptName(), funcName, pobj->id());
 			PyErr_PrintEx(0);
-			return 0;
+			return false;
 		}
 
 		if (pyEntityType && pyEntityType != Py_None && !PyUnicode_Check(pyEntityType))
 		{
-			PyErr_Format(PyExc_TypeError, "%s::entitiesInRange: args(entityType) error! entity(%d)",
-				pobj->scriptName(), pobj->id());
+			PyErr_Format(PyExc_TypeError, "%s::%s: args(entityType) error! entity(%d)",
+				pobj->scriptName(), funcName, pobj->id());
 			PyErr_PrintEx(0);
-			return 0;
+			return false;
 		}
 
 	}
@@ -3293,38 +3444,37 @@ PyObject* Entity::__py_pyEntitiesInRange(PyObject* self, PyObject* args)
 	{
 		if (!PyArg_ParseTuple(args, "fOO", &radius, &pyEntityType, &pyPosition))
 		{
-			PyErr_Format(PyExc_TypeError, "%s::entitiesInRange: args error! entity(%d)",
-				pobj->scriptName(), pobj->id());
+			PyErr_Format(PyExc_TypeError, "%s::%s: args error! entity(%d)",
+				pobj->scriptName(), funcName, pobj->id());
 			PyErr_PrintEx(0);
-			return 0;
+			return false;
 		}
 
 		if (pyEntityType && pyEntityType != Py_None && !PyUnicode_Check(pyEntityType))
 		{
-			PyErr_Format(PyExc_TypeError, "%s::entitiesInRange: args(entityType) error! entity(%d)",
-				pobj->scriptName(), pobj->id());
+			PyErr_Format(PyExc_TypeError, "%s::%s: args(entityType) error! entity(%d)",
+				pobj->scriptName(), funcName, pobj->id());
 			PyErr_PrintEx(0);
-			return 0;
+			return false;
 		}
 
 		if (pyPosition != Py_None && (!PySequence_Check(pyPosition) || PySequence_Size(pyPosition) < 3))
 		{
-			PyErr_Format(PyExc_TypeError, "%s::entitiesInRange: args(position) error! entity(%d)",
-				pobj->scriptName(), pobj->id());
+			PyErr_Format(PyExc_TypeError, "%s::%s: args(position) error! entity(%d)",
+				pobj->scriptName(), funcName, pobj->id());
 			PyErr_PrintEx(0);
-			return 0;
+			return false;
 		}
 	}
 	else
 	{
-		PyErr_Format(PyExc_TypeError, "%s::entitiesInRange: args error! entity(%d)",
-			pobj->scriptName(), pobj->id());
+		PyErr_Format(PyExc_TypeError, "%s::%s: args error! entity(%d)",
+			pobj->scriptName(), funcName, pobj->id());
 		PyErr_PrintEx(0);
-		return 0;
+		return false;
 	}
 
 	const char* pEntityType = NULL;
-	Position3D originpos;
 
 	// Ϣȡ
 	if (pyPosition && pyPosition != Py_None)
@@ -3341,23 +3491,34 @@ PyObject* Entity::__py_pyEntitiesInRange(PyObject* self, PyObject* args)
 		pEntityType = PyUnicode_AsUTF8AndSize(pyEntityType, NULL);
 	}
 
-	int entityUType = -1;
+	entityUType = -1;
 
 	if (pEntityType)
 	{
 		ScriptDefModule* sm = EntityDef::findScriptModule(pEntityType);
-		if (sm == NULL)
-		{
-			return PyList_New(0);
-		}
 
-		entityUType = sm->getUType();
+		// ڵͲѯΪ
+		entityUType = (sm == NULL) ? -2 : sm->getUType();
 	}
 
+	return true;
+}
+
+//-------------------------------------------------------------------------------------
+PyObject* Entity::entitiesInRangeToList(const Position3D& originpos, float radius, int entityUType)
+{
+	if (entityUType == -2)
+		return PyList_New(0);
+
+	// ѯתΪpythonб֮ͲҪ ûÿβѯڴ
+	// PyList_Newܴgc صٴεentitiesInRangeʱõյĻƻν
+	static std::vector<Entity*> s_findentities;
 	std::vector<Entity*> findentities;
+	findentities.swap(s_findentities);
+	findentities.clear();
 
 	// ûentityѰ Ǵ
-	EntityCoordinateNode::entitiesInRange(findentities, pobj->pEntityCoordinateNode(), originpos, radius, entityUType);
+	EntityCoordinateNode::entitiesInRange(findentities, pEntityCoordinateNode(), originpos, radius, entityUType);
 
 	PyObject* pyList = PyList_New(findentities.size());
 
@@ -3371,9 +3532,128 @@ PyObject* Entity::__py_pyEntitiesInRange(PyObject* self, PyObject* args)
 		PyList_SET_ITEM(pyList, i++, pEntity);
 	}
 
+	// 黹 Ƕ׵ù黹Ǹ()֮ͷ
+	s_findentities.swap(findentities);
 	return pyList;
 }
 
+//-------------------------------------------------------------------------------------
+PyObject* Entity::__py_pyEntitiesInRange(PyObject* self, PyObject* args)
+{
+	Entity* pobj = static_cast<Entity*>(self);
+
+	if (!pobj->isReal())
+	{
+		PyErr_Format(PyExc_AssertionError, "%s::entitiesInRange: not is real entity(%d).",
+			pobj->scriptName(), pobj->id());
+		PyErr_PrintEx(0);
+		return 0;
+	}
+
+	if (pobj->isDestroyed() && !pobj->hasFlags(ENTITY_FLAGS_DESTROYING) /* ڼ */)
+	{
+		PyErr_Format(PyExc_TypeError, "%s::entitiesInRange: entity(%d) is destroyed!",
+			pobj->scriptName(), pobj->id());
+		PyErr_PrintEx(0);
+		return 0;
+	}
+
+	float radius = 0.f;
+	int entityUType = -1;
+	Position3D originpos;
+
+	if (!parseEntitiesInRangeArgs(pobj, args, "entitiesInRange", radius, entityUType, originpos))
+		return 0;
+
+	SCOPED_PROFILE(ENTITIES_IN_RANGE_PROFILE);
+	return pobj->entitiesInRangeToList(originpos, radius, entityUType);
+}
+
+//-------------------------------------------------------------------------------------
+PyObject* Entity::__py_pyEntitiesInRangeBatch(PyObject* self, PyObject* args)
+{
+	Entity* pobj = static_cast<Entity*>(self);
+
+	if (!pobj->isReal())
+	{
+		PyErr_Format(PyExc_AssertionError, "%s::entitiesInRangeBatch: not is real entity(%d).",
+			pobj->scriptName(), pobj->id());
+		PyErr_PrintEx(0);
+		return 0;
+	}
+
+	if (pobj->isDestroyed() && !pobj->hasFlags(ENTITY_FLAGS_DESTROYING) /* ڼ */)
+	{
+		PyErr_Format(PyExc_TypeError, "%s::entitiesInRangeBatch: entity(%d) is destroyed!",
+			pobj->scriptName(), pobj->id());
+		PyErr_PrintEx(0);
+		return 0;
+	}
+
+	PyObject* pyQueries = NULL;
+	if (!PyArg_ParseTuple(args, "O", &pyQueries) || !PySequence_Check(pyQueries))
+	{
+		PyErr_Format(PyExc_TypeError, "%s::entitiesInRangeBatch: args error! entity(%d)",
+			pobj->scriptName(), pobj->id());
+		PyErr_PrintEx(0);
+		return 0;
+	}
+
+	// ÿѯĲentitiesInRangeͬ: (range[, entityType[, position]]) ֻѯΧʱҲֱӸֵ
+	Py_ssize_t size = PySequence_Size(pyQueries);
+	PyObject* pyResults = PyList_New(size);
+
+	SCOPED_PROFILE(ENTITIES_IN_RANGE_PROFILE);
+
+	for (Py_ssize_t i = 0; i < size; ++i)
+	{
+		PyObject* pyQuery = PySequence_GetItem(pyQueries, i);
+		if (!pyQuery)
+		{
+			Py_DECREF(pyResults);
+			PyErr_PrintEx(0);
+			return 0;
+		}
+
+		float radius = 0.f;
+		int entityUType = -1;
+		Position3D originpos;
+
+		if (PyTuple_Check(pyQuery))
+		{
+			if (!parseEntitiesInRangeArgs(pobj, pyQuery, "entitiesInRangeBatch", radius, entityUType, originpos))
+			{
+				Py_DECREF(pyQuery);
+				Py_DECREF(pyResults);
+				return 0;
+			}
+		}
+		else if (PyNumber_Check(pyQuery))
+		{
+			radius = (float)PyFloat_AsDouble(pyQuery);
+			originpos = pobj->position();
+		}
+		else
+		{
+			PyErr_Format(PyExc_TypeError, "%s::entitiesInRangeBatch: args[%d] error! entity(%d)",
+				pobj->scriptName(), (int)i, pobj->id());
+		}
+
+		Py_DECREF(pyQuery);
+
+		if (PyErr_Occurred())
+		{
+			PyErr_PrintEx(0);
+			Py_DECREF(pyResults);
+			return 0;
+		}
+
+		PyList_SET_ITEM(pyResults, i, pobj->entitiesInRangeToList(originpos, radius, entityUType));
+	}
+
+	return pyResults;
+}
+
 //-------------------------------------------------------------------------------------
 void Entity::_sendBaseTeleportResult(ENTITY_ID sourceEntityID, COMPONENT_ID sourceBaseAppID, SPACE_ID spaceID, SPACE_ID lastSpaceID, bool fromCellTeleport)
 {
@@ -3599,6 +3879,10 @@ void Entity::teleportRefEntityCall(EntityCall* nearbyMBRef, Position3D& pos, Dir
 //-------------------------------------------------------------------------------------
 void Entity::onTeleportRefEntityCall(EntityCall* nearbyMBRef, Position3D& pos, Direction3D& dir)
 {
+	// 뿪˵ǰspace ghostҲҪ
+	if(hasGhost())
+		destroyGhost();
+
 	// ҪentityĿcellapp
 	Network::Bundle* pBundle = Network::Bundle::createPoolObject(OBJECTPOOL_POINT);
 	(*pBundle).newMessage(CellappInterface::reqTeleportToCellApp);
@@ -3815,6 +4099,10 @@ void Entity::onTeleportSuccess(PyObject* nearbyEntity, SPACE_ID lastSpaceID)
 //-------------------------------------------------------------------------------------
 void Entity::onEnterSpace(SpaceMemory* pSpace)
 {
+	// ghostԼͬһspaceڿcellǨƲspace
+	if(!isReal() || hasFlags(ENTITY_FLAGS_OFFLOADING))
+		return;
+
 	SCOPED_PROFILE(SCRIPTCALL_PROFILE);
 
 	bufferOrExeCallback(const_cast<char*>("onEnterSpace"), NULL);
@@ -3823,6 +4111,9 @@ void Entity::onEnterSpace(SpaceMemory* pSpace)
 //-------------------------------------------------------------------------------------
 void Entity::onLeaveSpace(SpaceMemory* pSpace)
 {
+	if(!isReal() || hasFlags(ENTITY_FLAGS_OFFLOADING))
+		return;
+
 	SCOPED_PROFILE(SCRIPTCALL_PROFILE);
 
 	bufferOrExeCallback(const_cast<char*>("onLeaveSpace"), NULL);
@@ -3879,10 +4170,36 @@ bool Entity::_reload(bool fullReload)
 //-------------------------------------------------------------------------------------
 void Entity::onUpdateGhostPropertys(KBEngine::MemoryStream& s)
 {
+	// Ǩƹrealܻյԭghostԣ real
+	if(isReal())
+	{
+		s.done();
+		return;
+	}
+
+	ENTITY_PROPERTY_UID componentPropertyUID = 0;
+	s >> componentPropertyUID;
+
 	ENTITY_PROPERTY_UID utype;
 	s >> utype;
 
-	PropertyDescription* pPropertyDescription = pScriptModule()->findCellPropertyDescription(utype);
+	ScriptDefModule* pCurrScriptModule = pScriptModule();
+
+	PropertyDescription* pComponentPropertyDescription = NULL;
+	if (componentPropertyUID > 0)
+	{
+		pComponentPropertyDescription = pCurrScriptModule->findCellPropertyDescription(componentPropertyUID);
+	}
+
+	if (pComponentPropertyDescription)
+	{
+		DataType* pDataType = pComponentPropertyDescription->getDataType();
+		KBE_ASSERT(pDataType->type() == DATA_TYPE_ENTITY_COMPONENT);
+
+		pCurrScriptModule = static_cast<EntityComponentType*>(pDataType)->pScriptDefModule();
+	}
+
+	PropertyDescription* pPropertyDescription = pCurrScriptModule->findCellPropertyDescription(utype);
 	if(pPropertyDescription == NULL)
 	{
 		ERROR_MSG(fmt::format("{}::onUpdateGhostPropertys: not found propertyID({}), entityID({})\n", 
@@ -3895,6 +4212,10 @@ void Entity::onUpdateGhostPropertys(KBEngine::MemoryStream& s)
 	DEBUG_MSG(fmt::format("{}::onUpdateGhostPropertys: property({}), entityID({})\n", 
 		scriptName(), pPropertyDescription->getName(), id()));
 
+	// ǰĸʽ
+	if (pPropertyDescription->getDataType()->type() == DATA_TYPE_ENTITY_COMPONENT)
+		EntityDef::context().currComponentType = g_componentType;
+
 	PyObject* pyVal = pPropertyDescription->createFromStream(&s);
 	if(pyVal == NULL)
 	{
@@ -3905,9 +4226,25 @@ void Entity::onUpdateGhostPropertys(KBEngine::MemoryStream& s)
 		return;
 	}
 
-	PyObject_SetAttrString(static_cast<PyObject*>(this),
-				pPropertyDescription->getName(), pyVal);
+	PyObject* pyOwner = static_cast<PyObject*>(this);
+	if (pComponentPropertyDescription)
+	{
+		pyOwner = PyObject_GetAttrString(static_cast<PyObject*>(this), pComponentPropertyDescription->getName());
+		if (pyOwner == NULL)
+		{
+			SCRIPT_ERROR_CHECK();
+			Py_DECREF(pyVal);
+			return;
+		}
+	}
+	else
+	{
+		Py_INCREF(pyOwner);
+	}
+
+	PyObject_SetAttrString(pyOwner, pPropertyDescription->getName(), pyVal);
 
+	Py_DECREF(pyOwner);
 	Py_DECREF(pyVal);
 }
 
@@ -3953,8 +4290,17 @@ void Entity::onRemoteRealMethodCall(KBEngine::MemoryStream& s)
 //-------------------------------------------------------------------------------------
 void Entity::onUpdateGhostVolatileData(KBEngine::MemoryStream& s)
 {
-	DEBUG_MSG(fmt::format("{}::onUpdateGhostVolatileData: entityID({})\n", 
-		scriptName(), id()));
+	Position3D pos;
+	Direction3D dir;
+
+	s >> pos.x >> pos.y >> pos.z;
+	s >> dir.dir.x >> dir.dir.y >> dir.dir.z;
+
+	// Ǩƹrealܻյԭghostͬ
+	if(isReal())
+		return;
+
+	setPositionAndDirection(pos, dir);
 }
 
 //-------------------------------------------------------------------------------------
@@ -3968,6 +4314,9 @@ void Entity::changeToGhost(COMPONENT_ID realCell, KBEngine::MemoryStream& s)
 	KBE_ASSERT(isReal() == true && "Entity::changeToGhost(): not is real.\n");
 	KBE_ASSERT(realCell_ != g_componentID);
 
+	// תΪghost֮ɱcell㲥ԣ ȽϲеԸı䷢
+	flushDefDataChanges();
+
 	realCell_ = realCell;
 	ghostCell_ = 0;
 	
@@ -4022,6 +4371,164 @@ void Entity::changeToReal(COMPONENT_ID ghostCell, KBEngine::MemoryStream& s)
 	createFromStream(s);
 }
 
+//-------------------------------------------------------------------------------------
+void Entity::createGhost(COMPONENT_ID ghostCell)
+{
+	KBE_ASSERT(isReal() == true && "Entity::createGhost(): not is real.\n");
+
+	GhostManager* gm = Cellapp::getSingleton().pGhostManager();
+	if(gm == NULL || hasGhost())
+		return;
+
+	Network::Bundle* pBundle = gm->createSendBundle(ghostCell);
+	(*pBundle).newMessage(CellappInterface::onCreateGhost);
+	(*pBundle) << id();
+	(*pBundle) << spaceID();
+	(*pBundle) << g_componentID;
+	(*pBundle) << pScriptModule()->getUType();
+	(*pBundle) << position().x << position().y << position().z;
+	(*pBundle) << direction().roll() << direction().pitch() << direction().yaw();
+
+	MemoryStream* s = MemoryStream::createPoolObject(OBJECTPOOL_POINT);
+	addGhostDataToStream(*s);
+	(*pBundle).append(s);
+	MemoryStream::reclaimPoolObject(s);
+
+	gm->pushMessage(ghostCell, pBundle);
+
+	ghostCell_ = ghostCell;
+	gm->addRealEntity(this);
+
+	//DEBUG_MSG(fmt::format("{}::createGhost(): {}, ghostCell={}, spaceID={}.\n", 
+	//	scriptName(), id(), ghostCell_, spaceID_));
+}
+
+//-------------------------------------------------------------------------------------
+void Entity::destroyGhost()
+{
+	if(!hasGhost())
+		return;
+
+	GhostManager* gm = Cellapp::getSingleton().pGhostManager();
+	if(gm)
+	{
+		Network::Bundle* pBundle = gm->createSendBundle(ghostCell_);
+		(*pBundle).newMessage(CellappInterface::onDestroyGhost);
+		(*pBundle) << id();
+		gm->pushMessage(ghostCell_, pBundle);
+	}
+
+	ghostCell_ = 0;
+}
+
+//-------------------------------------------------------------------------------------
+void Entity::addGhostDataToStream(KBEngine::MemoryStream& s)
+{
+	COMPONENT_ID baseEntityCallComponentID = 0;
+	if(baseEntityCall_)
+	{
+		baseEntityCallComponentID = baseEntityCall_->componentID();
+	}
+
+	s << baseEntityCallComponentID << layer_ << topSpeed_ << topSpeedY_ << isOnGround_;
+
+	addCellDataToStream(CELLAPP_TYPE, ENTITY_CELL_DATA_FLAGS, &s);
+}
+
+//-------------------------------------------------------------------------------------
+void Entity::createGhostFromStream(KBEngine::MemoryStream& s)
+{
+	COMPONENT_ID baseEntityCallComponentID;
+
+	s >> baseEntityCallComponentID >> layer_ >> topSpeed_ >> topSpeedY_ >> isOnGround_;
+
+	if(baseEntityCallComponentID > 0)
+		baseEntityCall(new EntityCall(pScriptModule(), NULL, baseEntityCallComponentID, id_, ENTITYCALL_TYPE_BASE));
+
+	PyObject* cellData = createCellDataFromStream(&s);
+	createNamespace(cellData);
+	Py_XDECREF(cellData);
+
+	removeFlags(ENTITY_FLAGS_INITING);
+}
+
+//-------------------------------------------------------------------------------------
+void Entity::offloadToCell(COMPONENT_ID targetCell)
+{
+	KBE_ASSERT(isReal() == true && "Entity::offloadToCell(): not is real.\n");
+
+	GhostManager* gm = Cellapp::getSingleton().pGhostManager();
+	if(gm == NULL)
+		return;
+
+	// Ŀcell֮ghostѾûˣ ĿcellϵghostֱתΪreal
+	if(hasGhost() && ghostCell() != targetCell)
+		destroyGhost();
+
+	onLeavingCell();
+
+	// űڻصʵߴ
+	if(isDestroyed() || !isReal() || hasFlags(ENTITY_FLAGS_TELEPORT_START))
+		return;
+
+	// cellappһ Ҫ֪ͨbaseݴ淢cellϢֱǨ
+	if(this->baseEntityCall() != NULL)
+	{
+		Network::Channel* pBaseChannel = baseEntityCall()->getChannel();
+		if(pBaseChannel == NULL)
+		{
+			ERROR_MSG(fmt::format("{}::offloadToCell({}): not found baseapp!\n",
+				scriptName(), id()));
+
+			return;
+		}
+
+		Network::Bundle* pBundle = Network::Bundle::createPoolObject(OBJECTPOOL_POINT);
+		(*pBundle).newMessage(BaseappInterface::onMigrationCellappStart);
+		(*pBundle) << id();
+		(*pBundle) << g_componentID;
+		(*pBundle) << targetCell;
+		pBaseChannel->send(pBundle);
+	}
+
+	// Ǩƽ֮ǰǣ лwitnessʱҲViewб
+	addFlags(ENTITY_FLAGS_OFFLOADING);
+
+	// nearbyMBRefIDΪ0ʾͬһspaceڵǨƣ ĿcellappֱʹspaceIDҵspace
+	Network::Bundle* pBundle = gm->createSendBundle(targetCell);
+	(*pBundle).newMessage(CellappInterface::reqTeleportToCellApp);
+	(*pBundle) << id();
+	(*pBundle) << (ENTITY_ID)0;
+	(*pBundle) << spaceID();
+	(*pBundle) << pScriptModule()->getUType();
+	(*pBundle) << position().x << position().y << position().z;
+	(*pBundle) << direction().roll() << direction().pitch() << direction().yaw();
+	(*pBundle) << g_componentID;
+
+	MemoryStream* s = MemoryStream::createPoolObject(OBJECTPOOL_POINT);
+
+	try
+	{ 
+		changeToGhost(targetCell, *s);
+	}
+	catch (MemoryStreamWriteOverflow & err)
+	{
+		ERROR_MSG(fmt::format("{}::offloadToCell({}): {}\n",
+			scriptName(), id(), err.what()));
+
+		removeFlags(ENTITY_FLAGS_OFFLOADING);
+		MemoryStream::reclaimPoolObject(s);
+		Network::Bundle::reclaimPoolObject(pBundle);
+		return;
+	}
+
+	(*pBundle).append(s);
+	MemoryStream::reclaimPoolObject(s);
+
+	// GhostManagerͣ ֤֮ǰcellghostϢȵ
+	gm->pushMessage(targetCell, pBundle);
+}
+
 //-------------------------------------------------------------------------------------
 void Entity::addToStream(KBEngine::MemoryStream& s)
 {
@@ -4083,9 +4590,12 @@ void Entity::createFromStream(KBEngine::MemoryStream& s)
 
 	KBE_ASSERT(this->pScriptModule_);
 
-	// entitybaseEntityCall
+	// entitybaseEntityCall ghostתΪrealʱѾһ
 	if(baseEntityCallComponentID > 0)
+	{
+		S_RELEASE(baseEntityCall_);
 		baseEntityCall(new EntityCall(pScriptModule(), NULL, baseEntityCallComponentID, id_, ENTITYCALL_TYPE_BASE));
+	}
 
 	// ǰĿϵͳԼĿͻˣ
 	// ͻڿƣԻָƹϵ޷ָ
@@ -4182,8 +4692,12 @@ void Entity::createWitnessFromStream(KBEngine::MemoryStream& s)
 
 	if (witnesses_count_ > 0)
 	{
-		WARNING_MSG(fmt::format("{}::createWitnessFromStream: witnesses_count({}/{}) != 0! entityID={}, isReal={}\n",
-			scriptName(), witnesses_.size(), witnesses_count_, id(), isReal()));
+		// ͬһspaceڿcellǨʱ ghostѾ¼˱cellеĹ۲ߣ ԴcellϵĹ۲
+		if (!hasFlags(ENTITY_FLAGS_OFFLOADING))
+		{
+			WARNING_MSG(fmt::format("{}::createWitnessFromStream: witnesses_count({}/{}) != 0! entityID={}, isReal={}\n",
+				scriptName(), witnesses_.size(), witnesses_count_, id(), isReal()));
+		}
 
 		/*
 		std::list<ENTITY_ID>::iterator it = witnesses_.begin();
@@ -4326,50 +4840,31 @@ void Entity::onTimer(ScriptID timerID, int useraAgs)
 //-------------------------------------------------------------------------------------
 void Entity::addTimersToStream(KBEngine::MemoryStream& s)
 {
-	ScriptTimers::Map& map = scriptTimers_.map();
-	uint32 size = map.size();
-	s << size;
-
-	ScriptTimers::Map::const_iterator iter = map.begin();
-	while (iter != map.end())
-	{
-		// timerID
-		s << iter->first;
-
-		uint32 time;
-		uint32 interval;
-		void* pUser;
-
-		Cellapp::getSingleton().timers().getTimerInfo(iter->second, time, interval, pUser);
-		int32 userData = int32(uintptr(pUser));
-		s << time << interval << userData;
-		++iter;
-	}
+	scriptTimers_.addToStream(s);
 }
 
 //-------------------------------------------------------------------------------------
-void Entity::createTimersFromStream(KBEngine::MemoryStream& s)
+class EntityScriptTimerHandlerFactory : public ScriptTimers::HandlerFactory
 {
-	uint32 size;
-	s >> size;
-
-	for(uint32 i=0; i<size; ++i)
+public:
+	EntityScriptTimerHandlerFactory(Entity* pEntity) : pEntity_(pEntity)
 	{
-		ScriptID tid;
-		uint32 time;
-		uint32 interval;
-		int32 userData = 0;
+	}
 
-		s >> tid >> time >> interval >> userData;
+	virtual TimerHandler* createHandler()
+	{
+		return new EntityScriptTimerHandler(pEntity_);
+	}
 
-		EntityScriptTimerHandler* pEntityScriptTimerHandler = new EntityScriptTimerHandler(this);
+private:
+	Entity* pEntity_;
+};
 
-		TimerHandle timerHandle = Cellapp::getSingleton().timers().add(
-				time, interval,
-				pEntityScriptTimerHandler, (void *)(intptr_t)userData);
-		
-		scriptTimers_.directAddTimer(tid, timerHandle);
-	}
+//-------------------------------------------------------------------------------------
+void Entity::createTimersFromStream(KBEngine::MemoryStream& s)
+{
+	EntityScriptTimerHandlerFactory factory(this);
+	scriptTimers_.createFromStream(s, factory);
 }
 
 //-------------------------------------------------------------------------------------
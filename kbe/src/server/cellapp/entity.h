@@ -17,6 +17,7 @@
 #include "entitydef/scriptdef_module.h"
 #include "entitydef/entity_macro.h"	
 #include "server/script_timers.h"	
+#include "volatile_data_cache.h"
 	
 namespace KBEngine{
 
@@ -97,6 +98,13 @@ public:
 	*/
 	void onDefDataChanged(EntityComponent* pEntityComponent, const PropertyDescription* propertyDescription,
 			PyObject* pyData);
+
+	/** 
+		tickںϲԸı㲥ͻ
+		RPCҪ֤Ⱥ˳Ϣ֮ǰҲҪ
+	*/
+	void flushDefDataChanges();
+	static void flushAllDefDataChanges();
 	
 	/** 
 		entityͨͨ
@@ -338,6 +346,11 @@ public:
 	*/
 	static PyObject* __py_pyEntitiesInRange(PyObject* self, PyObject* args);
 
+	/** 
+		űһύΧѯ ÿѯб 
+	*/
+	static PyObject* __py_pyEntitiesInRangeBatch(PyObject* self, PyObject* args);
+
 	/** 
 		űViewΧڵentities 
 	*/
@@ -520,6 +533,11 @@ public:
 	INLINE GAME_TIME posChangedTime() const;
 	INLINE GAME_TIME dirChangedTime() const;
 
+	/**
+		ȡentityλóı뻺棬 ۲߹
+	*/
+	INLINE VolatileDataCache& volatileDataCache();
+
 	/** 
 		realԵghost
 	*/
@@ -545,6 +563,20 @@ public:
 	*/
 	void changeToReal(COMPONENT_ID ghostCell, KBEngine::MemoryStream& s);
 
+	/** 
+		cellϴghost, Ϊreal
+	*/
+	void createGhost(COMPONENT_ID ghostCell);
+	void destroyGhost();
+
+	void addGhostDataToStream(KBEngine::MemoryStream& s);
+	void createGhostFromStream(KBEngine::MemoryStream& s);
+
+	/** 
+		ʵƳ˵ǰcellķΧ realǨƵͬһspaceĿcell
+	*/
+	void offloadToCell(COMPONENT_ID targetCell);
+
 	void addToStream(KBEngine::MemoryStream& s);
 	void createFromStream(KBEngine::MemoryStream& s);
 
@@ -608,6 +640,32 @@ private:
 	static int32											_scriptCallbacksBufferNum;
 	static int32											_scriptCallbacksBufferCount;
 
+	// ȴ㲥ͻ˵Ըı䣬 ͬһһtickڶθıֻһ
+	struct DefDataChange
+	{
+		const PropertyDescription*	pPropertyDescription;
+		ENTITY_PROPERTY_UID			componentPropertyUID;
+		uint8						componentPropertyAliasID;
+		uint32						writes;					// tickڱıĴ
+		uint32						writtenBytes;			// ÿθı䶼㲥Ҫ
+		MemoryStream*				pData;
+	};
+
+	typedef std::vector<DefDataChange>						DEF_DATA_CHANGES;
+
+	static bool parseEntitiesInRangeArgs(Entity* pobj, PyObject* args, const char* funcName,
+		float& radius, int& entityUType, Position3D& originpos);
+
+	PyObject* entitiesInRangeToList(const Position3D& originpos, float radius, int entityUType);
+
+	void addDefDataChange(const PropertyDescription* propertyDescription, ENTITY_PROPERTY_UID componentPropertyUID,
+		uint8 componentPropertyAliasID, MemoryStream* mstream);
+
+	void clearDefDataChanges();
+
+	// Ըıȴ㲥entity
+	static std::vector<ENTITY_ID>							_defDataChangedEntities;
+
 protected:
 	// entityĿͻ˲ֵentityCall
 	EntityCall*												clientEntityCall_;
@@ -684,6 +742,12 @@ protected:
 
 	// ûùVolatileinfo˴VolatileinfoΪNULLʹScriptDefModuleVolatileinfo
 	VolatileInfo*											pCustomVolatileinfo_;
+
+	// λóı뻺棬 ÿ۲߶±һ
+	VolatileDataCache										volatileDataCache_;
+
+	// ȴtickĩβ㲥ͻ˵Ըı
+	DEF_DATA_CHANGES										defDataChanges_;
 };
 
 }
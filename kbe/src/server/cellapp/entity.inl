@@ -229,6 +229,12 @@ INLINE GAME_TIME Entity::dirChangedTime() const
 	return dirChangedTime_;
 }
 
+//-------------------------------------------------------------------------------------
+INLINE VolatileDataCache& Entity::volatileDataCache()
+{
+	return volatileDataCache_;
+}
+
 //-------------------------------------------------------------------------------------
 INLINE int8 Entity::layer() const
 {
@@ -1,10 +1,13 @@
 // Copyright 2008-2018 Yolo Technologies, Inc. All Rights Reserved. https://www.comblockengine.com
 
-#include <iterator>
 #include "entity_coordinate_node.h"
 #include "entity.h"
 #include "coordinate_system.h"
+#include "coordinate_grid.h"
 #include "range_trigger_node.h"
+#include "profile.h"
+
+#include <iterator>
 
 namespace KBEngine{	
 
@@ -213,78 +216,103 @@ CoordinateNode* findNearestNode(CoordinateNode* rootNode, const Position3D& orig
 
 //-------------------------------------------------------------------------------------
 /**
- һϷϷΧentity
+ ڵһϷϷΧentity ÿstepǰһڵ
+ ύstep ǷΧڽڵٵ
  ģ NODEWRAP ȡֵΪ֮һ
    - CoordinateNodeWrapX
    - CoordinateNodeWrapZ
    - CoordinateNodeWrapY
 */
 template <class NODEWRAP>
-void entitiesInAxisRange(std::set<Entity*>& foundEntities, CoordinateNode* rootNode,
-	const Position3D& originPos, float radius, int entityUType)
+class AxisRangeWalker
 {
-	CoordinateNode* pCoordinateNode = findNearestNode<NODEWRAP>(rootNode, originPos);
-	if (!pCoordinateNode)
-		return;
-
-	NODEWRAP wrap(pCoordinateNode, originPos);
-
-	// ڵԼҲԼӽȥ
-	if (wrap.isEntityNode() && wrap.valid())
+public:
+	enum State
 	{
-		Entity* pEntity = wrap.currentNodeEntity();
+		STATE_ORIGIN,
+		STATE_PREV,
+		STATE_NEXT,
+		STATE_DONE
+	};
 
-		if (entityUType == -1 || pEntity->pScriptModule()->getUType() == (ENTITY_SCRIPT_UID)entityUType)
-		{
-			if (wrap.length() <= radius)
-			{
-				foundEntities.insert(pEntity);
-			}
-		}
+	AxisRangeWalker(CoordinateNode* rootNode, const Position3D& originPos, float radius, int entityUType,
+		std::vector<Entity*>& foundEntities) :
+		wrap_(findNearestNode<NODEWRAP>(rootNode, originPos), originPos),
+		radius_(radius),
+		entityUType_(entityUType),
+		state_(STATE_ORIGIN),
+		foundEntities_(foundEntities)
+	{
+		if (!wrap_.currentNode())
+			state_ = STATE_DONE;
 	}
 
-	while (wrap.prev())
+	INLINE bool done() const { return state_ == STATE_DONE; }
+
+	/**
+		ǰһڵ㣬 falseʾѾ
+	*/
+	bool step()
 	{
-		if (wrap.isEntityNode() && wrap.valid())
+		switch (state_)
 		{
-			Entity* pEntity = wrap.currentNodeEntity();
+		case STATE_ORIGIN:
+			// ڵԼҲԼӽȥ
+			check();
+			state_ = STATE_PREV;
+			return true;
+
+		case STATE_PREV:
+			if (!wrap_.prev() || !check())
+			{
+				wrap_.reset();
+				state_ = STATE_NEXT;
+			}
+			return true;
 
-			if (entityUType == -1 || pEntity->pScriptModule()->getUType() == (ENTITY_SCRIPT_UID)entityUType)
+		case STATE_NEXT:
+			if (!wrap_.next() || !check())
 			{
-				if (wrap.length() <= radius)
-				{
-					foundEntities.insert(pEntity);
-				}
-				else
-				{
-					break;
-				}
+				state_ = STATE_DONE;
+				return false;
 			}
-		}
-	};
+			return true;
 
-	wrap.reset();
+		default:
+			break;
+		};
 
-	while (wrap.next())
+		return false;
+	}
+
+private:
+	/**
+		鵱ǰڵ㣬 falseʾѾΧ
+	*/
+	bool check()
 	{
-		if (wrap.isEntityNode() && wrap.valid())
-		{
-			Entity* pEntity = wrap.currentNodeEntity();
+		if (!wrap_.isEntityNode() || !wrap_.valid())
+			return true;
 
-			if (entityUType == -1 || pEntity->pScriptModule()->getUType() == (ENTITY_SCRIPT_UID)entityUType)
-			{
-				if (wrap.length() <= radius)
-				{
-					foundEntities.insert(pEntity);
-				}
-				else
-				{
-					break;
-				}
-			}
-		}
-	};
-}
+		Entity* pEntity = wrap_.currentNodeEntity();
+
+		if (entityUType_ != -1 && pEntity->pScriptModule()->getUType() != (ENTITY_SCRIPT_UID)entityUType_)
+			return true;
+
+		if (wrap_.length() > radius_)
+			return state_ == STATE_ORIGIN;
+
+		foundEntities_.push_back(pEntity);
+		return true;
+	}
+
+private:
+	NODEWRAP wrap_;
+	float radius_;
+	int entityUType_;
+	State state_;
+	std::vector<Entity*>& foundEntities_;
+};
 
 //-------------------------------------------------------------------------------------
 EntityCoordinateNode::EntityCoordinateNode(Entity* pEntity):
@@ -466,6 +494,121 @@ bool EntityCoordinateNode::delWatcherNode(CoordinateNode* pNode)
 //-------------------------------------------------------------------------------------
 void EntityCoordinateNode::entitiesInRange(std::vector<Entity*>& foundEntities, CoordinateNode* rootNode,
 									  const Position3D& originPos, float radius, int entityUType)
+{
+	++g_entitiesInRangeQueries;
+
+	// ģʽ½ڵûʮ ֱӲѯ
+	CoordinateSystem* pCoordinateSystem = rootNode->pCoordinateSystem();
+	if (pCoordinateSystem && pCoordinateSystem->pCoordinateGrid())
+	{
+		pCoordinateSystem->pCoordinateGrid()->entitiesInRange(foundEntities, originPos, radius, entityUType);
+		return;
+	}
+
+	// cellappֻ߳вѯ ѡԱÿβѯڴ
+	static std::vector<Entity*> s_candidatesX;
+	static std::vector<Entity*> s_candidatesZ;
+
+	s_candidatesX.clear();
+	s_candidatesZ.clear();
+
+	// xzύǰ ֻȡǸĺѡ ֱӱȽ
+	AxisRangeWalker<CoordinateNodeWrapX> walkerX(rootNode, originPos, radius, entityUType, s_candidatesX);
+	AxisRangeWalker<CoordinateNodeWrapZ> walkerZ(rootNode, originPos, radius, entityUType, s_candidatesZ);
+
+	while (walkerX.step() && walkerZ.step())
+	{
+	}
+
+	std::vector<Entity*>& candidates = walkerX.done() ? s_candidatesX : s_candidatesZ;
+	g_entitiesInRangeCandidates += candidates.size();
+
+	std::vector<Entity*>::iterator iter = candidates.begin();
+	for (; iter != candidates.end(); ++iter)
+	{
+		const Position3D& pos = (*iter)->position();
+
+		if (fabs(pos.x - originPos.x) > radius || fabs(pos.z - originPos.z) > radius)
+			continue;
+
+		if (CoordinateSystem::hasY && fabs(pos.y - originPos.y) > radius)
+			continue;
+
+		foundEntities.push_back((*iter));
+	}
+}
+
+//-------------------------------------------------------------------------------------
+/**
+	һϷϷΧentity
+*/
+template<class NODEWRAP>
+void entitiesInAxisRange(std::set<Entity*>& foundEntities, CoordinateNode* rootNode,
+	const Position3D& originPos, float radius, int entityUType)
+{
+	CoordinateNode* pCoordinateNode = findNearestNode<NODEWRAP>(rootNode, originPos);
+	if (!pCoordinateNode)
+		return;
+
+	NODEWRAP wrap(pCoordinateNode, originPos);
+
+	// ڵԼҲԼӽȥ
+	if (wrap.isEntityNode() && wrap.valid())
+	{
+		Entity* pEntity = wrap.currentNodeEntity();
+		if (entityUType == -1 || pEntity->pScriptModule()->getUType() == (ENTITY_SCRIPT_UID)entityUType)
+		{
+			if (wrap.length() <= radius)
+			{
+				foundEntities.insert(pEntity);
+			}
+		}
+	}
+
+	while (wrap.prev())
+	{
+		if (wrap.isEntityNode() && wrap.valid())
+		{
+			Entity* pEntity = wrap.currentNodeEntity();
+			if (entityUType == -1 || pEntity->pScriptModule()->getUType() == (ENTITY_SCRIPT_UID)entityUType)
+			{
+				if (wrap.length() <= radius)
+				{
+					foundEntities.insert(pEntity);
+				}
+				else
+				{
+					break;
+				}
+			}
+		}
+	};
+
+	wrap.reset();
+
+	while (wrap.next())
+	{
+		if (wrap.isEntityNode() && wrap.valid())
+		{
+			Entity* pEntity = wrap.currentNodeEntity();
+			if (entityUType == -1 || pEntity->pScriptModule()->getUType() == (ENTITY_SCRIPT_UID)entityUType)
+			{
+				if (wrap.length() <= radius)
+				{
+					foundEntities.insert(pEntity);
+				}
+				else
+				{
+					break;
+				}
+			}
+		}
+	};
+}
+
+//-------------------------------------------------------------------------------------
+void EntityCoordinateNode::entitiesInRangeBySets(std::vector<Entity*>& foundEntities, CoordinateNode* rootNode,
+	const Position3D& originPos, float radius, int entityUType)
 {
 	std::set<Entity*> entities_X;
 	std::set<Entity*> entities_Z;
@@ -479,7 +622,6 @@ void EntityCoordinateNode::entitiesInRange(std::vector<Entity*>& foundEntities,
 		std::set<Entity*> entities_Y;
 		entitiesInAxisRange<CoordinateNodeWrapY>(entities_Y, rootNode, originPos, radius, entityUType);
 
-
 		std::set<Entity*> res_set;
 		set_intersection(entities_X.begin(), entities_X.end(), entities_Z.begin(), entities_Z.end(), std::inserter(res_set, res_set.end()));
 		set_intersection(res_set.begin(), res_set.end(), entities_Y.begin(), entities_Y.end(), std::back_inserter(foundEntities));
@@ -37,6 +37,13 @@ public:
 	static void entitiesInRange(std::vector<Entity*>& foundEntities, CoordinateNode* rootNode, 
 		const Position3D& orginPos, float radius, int entityUType = -1);
 
+	/**
+		ɵʵ: ÿռһstd::set󽻼
+		ֻKBEngine.benchmarkEntitiesInRangeԱУ
+	*/
+	static void entitiesInRangeBySets(std::vector<Entity*>& foundEntities, CoordinateNode* rootNode, 
+		const Position3D& orginPos, float radius, int entityUType = -1);
+
 	virtual void onRemove();
 
 protected:
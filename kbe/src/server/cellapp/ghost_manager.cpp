@@ -1,11 +1,14 @@
 // Copyright 2008-2018 Yolo Technologies, Inc. All Rights Reserved. https://www.comblockengine.com
 
 #include "cellapp.h"
+#include "entity.h"
 #include "ghost_manager.h"
 #include "entitydef/scriptdef_module.h"
 #include "network/bundle.h"
 #include "network/channel.h"
 
+#include "../../server/cellapp/cellapp_interface.h"
+
 namespace KBEngine{	
 
 //-------------------------------------------------------------------------------------
@@ -14,7 +17,8 @@ realEntities_(),
 ghost_route_(),
 messages_(),
 pTimerHandle_(NULL),
-checkTime_(0)
+checkTime_(0),
+lastGhostSyncTime_(0)
 {
 }
 
@@ -108,6 +112,13 @@ void GhostManager::addRoute(ENTITY_ID entityID, COMPONENT_ID componentID)
 	start();
 }
 
+//-------------------------------------------------------------------------------------
+void GhostManager::addRealEntity(Entity* pEntity)
+{
+	realEntities_[pEntity->id()] = pEntity;
+	start();
+}
+
 //-------------------------------------------------------------------------------------
 COMPONENT_ID GhostManager::getRoute(ENTITY_ID entityID)
 {
@@ -173,25 +184,42 @@ void GhostManager::syncGhosts()
 	std::map<ENTITY_ID, Entity*>::iterator iter = realEntities_.begin();
 	for(; iter != realEntities_.end(); )
 	{
-		COMPONENT_ID ghostCell = iter->second->ghostCell();
-		if(ghostCell > 0)
+		// ʵѾٻǨˣ ֱʹü¼ָ
+		Entity* pEntity = Cellapp::getSingleton().findEntity(iter->first);
+		if(pEntity != iter->second || pEntity->isDestroyed() || !pEntity->isReal() || !pEntity->hasGhost())
 		{
-			// λõϢͬghost
-			Components::ComponentInfos* cinfos = Components::getSingleton().findComponent(ghostCell);
-			if(cinfos == NULL || cinfos->pChannel == NULL)
-			{
-				ERROR_MSG(fmt::format("GhostManager::syncGhosts: not found cellapp({})!\n", iter->first));
-				++iter;
-				continue;
-			}
+			realEntities_.erase(iter++);
+			continue;
+		}
 
+		COMPONENT_ID ghostCell = pEntity->ghostCell();
+
+		// λõϢͬghost
+		Components::ComponentInfos* cinfos = Components::getSingleton().findComponent(ghostCell);
+		if(cinfos == NULL || cinfos->pChannel == NULL)
+		{
+			ERROR_MSG(fmt::format("GhostManager::syncGhosts: not found cellapp({})!\n", iter->first));
 			++iter;
+			continue;
 		}
-		else
+
+		if(pEntity->posChangedTime() >= lastGhostSyncTime_ || pEntity->dirChangedTime() >= lastGhostSyncTime_)
 		{
-			realEntities_.erase(iter++);
+			const Position3D& pos = pEntity->position();
+			const Direction3D& dir = pEntity->direction();
+
+			Network::Bundle* pBundle = createSendBundle(ghostCell);
+			(*pBundle).newMessage(CellappInterface::onUpdateGhostVolatileData);
+			(*pBundle) << pEntity->id();
+			(*pBundle) << pos.x << pos.y << pos.z;
+			(*pBundle) << dir.roll() << dir.pitch() << dir.yaw();
+			pushMessage(ghostCell, pBundle);
 		}
+
+		++iter;
 	}
+
+	lastGhostSyncTime_ = g_kbetime;
 }
 
 //-------------------------------------------------------------------------------------
@@ -211,8 +239,9 @@ void GhostManager::handleTimeout(TimerHandle, void * arg)
 		checkTime_ = timestamp();
 	}
 
-	syncMessages();
+	// ȲλͬϢ ghostϢһͬ
 	syncGhosts();
+	syncMessages();
 }
 
 //-------------------------------------------------------------------------------------
@@ -37,6 +37,11 @@ public:
 	COMPONENT_ID getRoute(ENTITY_ID entityID);
 	void addRoute(ENTITY_ID entityID, COMPONENT_ID componentID);
 
+	/**
+		һrealʵcellӵghost ˺λóı仯ghostUpdateHertzͬghost
+	*/
+	void addRealEntity(Entity* pEntity);
+
 	/**
 	bundlebundleǴsend뷢ͶлȡģΪ
 	򴴽һµ
@@ -85,6 +90,9 @@ private:
 	TimerHandle* pTimerHandle_;
 
 	uint64 checkTime_;
+
+	// һghostͬױʱϷʱ
+	GAME_TIME lastGhostSyncTime_;
 };
 
 
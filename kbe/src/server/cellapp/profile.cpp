@@ -8,9 +8,24 @@ ProfileVal ONMOVE_PROFILE("onMove");
 ProfileVal ON_NAVIGATE_PROFILE("onNavigate");
 ProfileVal CLIENT_UPDATE_PROFILE("clientUpdate");
 ProfileVal ONTIMER_PROFILE("onTimer");
+ProfileVal ENTITIES_IN_RANGE_PROFILE("entitiesInRange");
 
 EventHistoryStats g_privateClientEventHistoryStats("PrivateClientEvents");
 EventHistoryStats g_publicClientEventHistoryStats("PublicClientEvents");
 EventHistoryStats g_publicCellEventHistoryStats("PublicCellEvents");
 
+uint64 g_volatileDataCacheHits = 0;
+uint64 g_volatileDataCacheMisses = 0;
+uint64 g_volatileDataEncodedBytes = 0;
+uint64 g_volatileDataCopiedBytes = 0;
+
+uint64 g_coordinateNodePasses = 0;
+uint64 g_coordinateGridChecks = 0;
+
+uint64 g_propertyUpdateMessagesSaved = 0;
+uint64 g_propertyUpdateBytesSaved = 0;
+
+uint64 g_entitiesInRangeQueries = 0;
+uint64 g_entitiesInRangeCandidates = 0;
+
 }
@@ -15,10 +15,29 @@ extern ProfileVal ONMOVE_PROFILE;
 extern ProfileVal ONNAVIGATE_PROFILE;
 extern ProfileVal CLIENT_UPDATE_PROFILE;
 extern ProfileVal ONTIMER_PROFILE;
+extern ProfileVal ENTITIES_IN_RANGE_PROFILE;
 
 extern EventHistoryStats g_privateClientEventHistoryStats;
 extern EventHistoryStats g_publicClientEventHistoryStats;
 extern EventHistoryStats g_publicCellEventHistoryStats;
 
+// Witness::updateλó뻺ͳ
+extern uint64 g_volatileDataCacheHits;
+extern uint64 g_volatileDataCacheMisses;
+extern uint64 g_volatileDataEncodedBytes;
+extern uint64 g_volatileDataCopiedBytes;
+
+// AOIͳƣ ʮнڵԽڵĴԼдΧĴ
+extern uint64 g_coordinateNodePasses;
+extern uint64 g_coordinateGridChecks;
+
+// ͻԸºϲtickĩβͺʡϢֽ
+extern uint64 g_propertyUpdateMessagesSaved;
+extern uint64 g_propertyUpdateBytesSaved;
+
+// entitiesInRangeѯԼϱõĺѡentity
+extern uint64 g_entitiesInRangeQueries;
+extern uint64 g_entitiesInRangeCandidates;
+
 }
 #endif
@@ -2,6 +2,7 @@
 
 #include "range_trigger.h"
 #include "coordinate_system.h"
+#include "coordinate_grid.h"
 #include "entity_coordinate_node.h"
 #include "range_trigger_node.h"
 
@@ -18,6 +19,7 @@ range_y_(fabs(y)),
 origin_(origin),
 positiveBoundary_(NULL),
 negativeBoundary_(NULL),
+pCoordinateGrid_(NULL),
 removing_(false)
 {
 }
@@ -39,6 +41,21 @@ bool RangeTrigger::reinstall(CoordinateNode* pCoordinateNode)
 //-------------------------------------------------------------------------------------
 bool RangeTrigger::install()
 {
+	CoordinateGrid* pCoordinateGrid = origin_->pCoordinateSystem()->pCoordinateGrid();
+	if (pCoordinateGrid)
+	{
+		// ģʽûб߽ڵ㣬 뿪ֱӼ
+		pCoordinateGrid_ = pCoordinateGrid;
+		if (!pCoordinateGrid->addTrigger(this))
+		{
+			pCoordinateGrid_ = NULL;
+			return false;
+		}
+
+		// װеĻصܵԼж
+		return pCoordinateGrid_ != NULL;
+	}
+
 	if(positiveBoundary_ == NULL)
 		positiveBoundary_ = new RangeTriggerNode(this, 0, 0, true);
 	else
@@ -100,6 +117,14 @@ bool RangeTrigger::uninstall()
 		return false;
 
 	removing_ = true;
+
+	if (pCoordinateGrid_)
+	{
+		CoordinateGrid* pCoordinateGrid = pCoordinateGrid_;
+		pCoordinateGrid_ = NULL;
+		pCoordinateGrid->removeTrigger(this);
+	}
+
 	if(positiveBoundary_ && positiveBoundary_->pCoordinateSystem())
 	{
 		positiveBoundary_->pCoordinateSystem()->remove(positiveBoundary_);
@@ -270,6 +295,12 @@ void RangeTrigger::update(float xz, float y)
 
 	range(xz, y);
 
+	if (pCoordinateGrid_)
+	{
+		pCoordinateGrid_->updateTrigger(this);
+		return;
+	}
+
 	if (positiveBoundary_)
 	{
 		positiveBoundary_->range(range_xz_, range_y_);
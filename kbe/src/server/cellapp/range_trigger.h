@@ -10,6 +10,7 @@
 namespace KBEngine{
 
 class RangeTriggerNode;
+class CoordinateGrid;
 class RangeTrigger
 {
 public:
@@ -55,6 +56,9 @@ protected:
 	RangeTriggerNode* positiveBoundary_;
 	RangeTriggerNode* negativeBoundary_;
 
+	// װ(CoordinateGrid)ʱʹñ߽ڵ
+	CoordinateGrid* pCoordinateGrid_;
+
 	bool removing_;
 };
 
@@ -37,7 +37,7 @@ INLINE void RangeTrigger::origin(CoordinateNode* pCoordinateNode)
 //-------------------------------------------------------------------------------------
 INLINE bool RangeTrigger::isInstalled() const
 {
-	return positiveBoundary_ && negativeBoundary_;
+	return (positiveBoundary_ && negativeBoundary_) || pCoordinateGrid_ != NULL;
 }
 
 //-------------------------------------------------------------------------------------
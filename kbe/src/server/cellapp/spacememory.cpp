@@ -4,6 +4,7 @@
 #include "spacememory.h"	
 #include "entity.h"
 #include "witness.h"	
+#include "coordinate_grid.h"
 #include "navigation/navigation.h"
 #include "loadnavmesh_threadtasks.h"
 #include "entitydef/entities.h"
@@ -24,12 +25,38 @@ id_(spaceID),
 scriptModuleName_(scriptModuleName),
 entities_(),
 hasGeometry_(false),
-pCell_(NULL),
+cells_(),
+creatorID_(0),
 coordinateSystem_(),
 pNavHandle_(),
 state_(STATE_NORMAL),
 destroyTime_(0)
 {
+	// ѡspaceAOIʵ֣ ԰spaceʵ͵ָ
+	const ENGINE_COMPONENT_INFO& cellappInfo = g_kbeSrvConfig.getCellApp();
+	std::string coordinateSystemType = cellappInfo.coordinateSystem_type;
+
+	std::map<std::string, std::string>::const_iterator iter = cellappInfo.coordinateSystem_spaceTypes.find(scriptModuleName_);
+	if (iter != cellappInfo.coordinateSystem_spaceTypes.end())
+		coordinateSystemType = iter->second;
+
+	if (coordinateSystemType == "grid")
+	{
+		float cellSize = cellappInfo.coordinateSystem_gridCellSize;
+		if (cellSize <= 0.f)
+			cellSize = cellappInfo.defaultViewRadius + cellappInfo.defaultViewHysteresisArea;
+
+		coordinateSystem_.useGrid(cellSize);
+
+		DEBUG_MSG(fmt::format("SpaceMemory::SpaceMemory: space({}) {} use grid, cellSize={}.\n", 
+			scriptModuleName_, id_, coordinateSystem_.pCoordinateGrid()->cellSize()));
+	}
+	else if (coordinateSystemType != "list")
+	{
+		WARNING_MSG(fmt::format("SpaceMemory::SpaceMemory: space({}) {} not support coordinate_system->aoi->type({}), use list!\n", 
+			scriptModuleName_, id_, coordinateSystemType));
+	}
+
 	Network::Channel* pChannel = Components::getSingleton().getCellappmgrChannel();
 	if (pChannel != NULL)
 	{
@@ -56,8 +83,6 @@ SpaceMemory::~SpaceMemory()
 	
 	pNavHandle_.clear();
 
-	SAFE_RELEASE(pCell_);	
-
 	Network::Channel* pChannel = Components::getSingleton().getCellappmgrChannel();
 	if (pChannel != NULL)
 	{
@@ -354,10 +379,95 @@ bool SpaceMemory::update()
 		KBE_ASSERT(entities_.size() == 0);
 		this->coordinateSystem_.releaseNodes();
 	}
+
+	if(isGood() && isPartitioned())
+		checkCellBoundaries();
 		
 	return true;
 }
 
+//-------------------------------------------------------------------------------------
+Cell* SpaceMemory::pCell()
+{
+	return cells_.findCellByCellapp(g_componentID);
+}
+
+//-------------------------------------------------------------------------------------
+void SpaceMemory::checkCellBoundaries()
+{
+	Cell* pMyCell = pCell();
+	if(pMyCell == NULL)
+		return;
+
+	const ENGINE_COMPONENT_INFO& cellappInfo = g_kbeSrvConfig.getCellApp();
+	float ghostDistance = cellappInfo.ghostDistance;
+	int maxOperations = cellappInfo.ghostingMaxPerCheck;
+	int operations = 0;
+
+	// ʵԽ߽һСξǨƣ ڱ߽Ǩ
+	float offloadHysteresis = ghostDistance * 0.1f;
+
+	// ǨƺghostὫʵƳentities_ űصܻᣬ ÿζ±
+	for(SPACE_ENTITIES::size_type i = 0; i < entities_.size() && operations < maxOperations; ++i)
+	{
+		EntityPtr pEntity = entities_[i];
+
+		if(!pEntity->isReal() || pEntity->isDestroyed() || pEntity->id() == creatorID_ ||
+			pEntity->hasFlags(ENTITY_FLAGS_TELEPORT_START | ENTITY_FLAGS_OFFLOADING | ENTITY_FLAGS_INITING))
+			continue;
+
+		float x = pEntity->position().x;
+
+		// Ѿ뿪˵ǰcell ǨƵλڵcell
+		if(x < pMyCell->minX() - offloadHysteresis || x >= pMyCell->maxX() + offloadHysteresis)
+		{
+			Cell* pDestCell = cells_.findCell(x);
+			if(pDestCell && pDestCell->cellappID() != g_componentID)
+			{
+				pEntity->offloadToCell(pDestCell->cellappID());
+				++operations;
+				continue;
+			}
+		}
+
+		// еghostڳghostDistanceһΧ
+		if(pEntity->hasGhost())
+		{
+			Cell* pGhostCell = cells_.findCellByCellapp(pEntity->ghostCell());
+			float distance = 0.f;
+
+			if(pGhostCell)
+			{
+				if(x < pGhostCell->minX())
+					distance = pGhostCell->minX() - x;
+				else if(x >= pGhostCell->maxX())
+					distance = x - pGhostCell->maxX();
+			}
+
+			if(pGhostCell && distance <= ghostDistance * 1.2f)
+				continue;
+
+			pEntity->destroyGhost();
+			++operations;
+		}
+
+		// ߽粻ghostDistanceʱcellϴghost
+		Cell* pNeighbourCell = NULL;
+
+		if(x - pMyCell->minX() < ghostDistance)
+			pNeighbourCell = cells_.findCell(x - ghostDistance);
+
+		if((pNeighbourCell == NULL || pNeighbourCell == pMyCell) && pMyCell->maxX() - x < ghostDistance)
+			pNeighbourCell = cells_.findCell(x + ghostDistance);
+
+		if(pNeighbourCell && pNeighbourCell != pMyCell && pNeighbourCell->cellappID() != g_componentID)
+		{
+			pEntity->createGhost(pNeighbourCell->cellappID());
+			++operations;
+		}
+	}
+}
+
 //-------------------------------------------------------------------------------------
 void SpaceMemory::addEntityAndEnterWorld(Entity* pEntity, bool isRestore)
 {
@@ -408,7 +518,8 @@ void SpaceMemory::removeEntity(Entity* pEntity)
 	pEntity->onLeaveSpace(this);
 
 	// ûentityҪspace, Ϊspaceٴһentity
-	if(entities_.empty() && state_ == STATE_NORMAL)
+	// ָspaceɴcellʱ٣ cellʱûʵ
+	if(entities_.empty() && state_ == STATE_NORMAL && !isPartitioned())
 	{
 		SpaceMemorys::destroySpace(this->id(), 0);
 	}
@@ -550,7 +661,7 @@ const std::string& SpaceMemory::getGeometryPath()
 }
 
 //-------------------------------------------------------------------------------------
-void SpaceMemory::setSpaceData(const std::string& key, const std::string& value)
+void SpaceMemory::setSpaceData(const std::string& key, const std::string& value, bool syncToCells)
 {
 	SPACE_DATA::iterator iter = datas_.find(key);
 	if(iter == datas_.end())
@@ -561,6 +672,9 @@ void SpaceMemory::setSpaceData(const std::string& key, const std::string& value)
 		else
 			datas_[key] = value;
 
+	if(syncToCells)
+		_syncSpaceDataToCells(key, value, false);
+
 	onSpaceDataChanged(key, value, false);
 }
 
@@ -588,7 +702,7 @@ const std::string& SpaceMemory::getSpaceData(const std::string& key)
 }
 
 //-------------------------------------------------------------------------------------
-void SpaceMemory::delSpaceData(const std::string& key)
+void SpaceMemory::delSpaceData(const std::string& key, bool syncToCells)
 {
 	SPACE_DATA::iterator iter = datas_.find(key);
 	if(iter == datas_.end())
@@ -596,9 +710,38 @@ void SpaceMemory::delSpaceData(const std::string& key)
 
 	datas_.erase(iter);
 
+	if(syncToCells)
+		_syncSpaceDataToCells(key, "", true);
+
 	onSpaceDataChanged(key, "", true);
 }
 
+//-------------------------------------------------------------------------------------
+void SpaceMemory::_syncSpaceDataToCells(const std::string& key, const std::string& value, bool isdel)
+{
+	// ӳcellһͬ µcellԼ
+	if(key == "_mapping")
+		return;
+
+	ENGINE_COMPONENT_INFO& info = g_kbeSrvConfig.getCellAppMgr();
+	if(!info.spacePartition_enable)
+		return;
+
+	// δָspaceҲҪϱ ָʱcellappmgrspaceDataƸµcell
+	if(info.spacePartition_spaceTypes.size() > 0 && std::find(info.spacePartition_spaceTypes.begin(), 
+		info.spacePartition_spaceTypes.end(), scriptModuleName_) == info.spacePartition_spaceTypes.end())
+		return;
+
+	Network::Channel* pChannel = Components::getSingleton().getCellappmgrChannel();
+	if(pChannel == NULL)
+		return;
+
+	Network::Bundle* pBundle = Network::Bundle::createPoolObject(OBJECTPOOL_POINT);
+	(*pBundle).newMessage(CellappmgrInterface::syncSpaceData);
+	(*pBundle) << g_componentID << id_ << key << value << isdel;
+	pChannel->send(pBundle);
+}
+
 //-------------------------------------------------------------------------------------
 void SpaceMemory::onSpaceDataChanged(const std::string& key, const std::string& value, bool isdel)
 {
@@ -4,7 +4,7 @@
 #define KBE_SPACEMEMORY_H
 
 #include "coordinate_system.h"
-#include "cell.h"
+#include "cells.h"
 #include "helper/debug_helper.h"
 #include "common/common.h"
 #include "common/smartpointer.h"
@@ -47,6 +47,7 @@ public:
 	void onEntityAttachWitness(Entity* pEntity);
 
 	SPACE_ID id() const{ return id_; }
+	const std::string& getScriptModuleName() const{ return scriptModuleName_; }
 
 	const SPACE_ENTITIES& entities() const{ return entities_; }
 	Entity* findEntity(ENTITY_ID entityID);
@@ -57,10 +58,26 @@ public:
 	bool destroy(ENTITY_ID entityID, bool ignoreGhost = true);
 
 	/**
-		spacecell
+		spacecell֣ spaceδָʱΪ
 	*/
-	Cell * pCell() const	{ return pCell_; }
-	void pCell( Cell * pCell );
+	Cells& cells()	{ return cells_; }
+	bool isPartitioned() const { return cells_.size() > 1; }
+
+	/**
+		ǰcellappcell
+	*/
+	Cell* pCell();
+
+	/**
+		ʵcell߽Ĺϵ ghostԽrealǨƵcell
+	*/
+	void checkCellBoundaries();
+
+	/**
+		spaceʵ壬 ᱻǨƵcell
+	*/
+	ENTITY_ID creatorID() const { return creatorID_; }
+	void creatorID(ENTITY_ID id) { creatorID_ = id; }
 
 	/**
 		spaceļӳ
@@ -78,8 +95,8 @@ public:
 	/**
 		spaceDataزӿ
 	*/
-	void setSpaceData(const std::string& key, const std::string& value);
-	void delSpaceData(const std::string& key);
+	void setSpaceData(const std::string& key, const std::string& value, bool syncToCells = true);
+	void delSpaceData(const std::string& key, bool syncToCells = true);
 	bool hasSpaceData(const std::string& key);
 	const std::string& getSpaceData(const std::string& key);
 	void onSpaceDataChanged(const std::string& key, const std::string& value, bool isdel);
@@ -95,6 +112,9 @@ public:
 protected:
 	void _addSpaceDatasToEntityClient(const Entity* pEntity);
 
+	// ɷָspacespaceDatacellappmgr沢תcell
+	void _syncSpaceDataToCells(const std::string& key, const std::string& value, bool isdel);
+
 	void _clearGhosts();
 	
 	enum STATE
@@ -117,8 +137,10 @@ protected:
 	// Ƿع
 	bool						hasGeometry_;
 
-	// ÿspaceֻһcell
-	Cell*						pCell_;
+	// spaceָcellappmgrͬcell
+	Cells						cells_;
+
+	ENTITY_ID					creatorID_;
 
 	CoordinateSystem			coordinateSystem_;
 
@@ -42,6 +42,7 @@ public:
 	static void update();
 
 	static size_t size(){ return spaces_.size(); }
+	static SPACEMEMORYS& spaces(){ return spaces_; }
 
 protected:
 	static SPACEMEMORYS spaces_;
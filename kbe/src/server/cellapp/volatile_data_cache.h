@@ -0,0 +1,137 @@
+// Copyright 2008-2018 Yolo Technologies, Inc. All Rights Reserved. https://www.comblockengine.com
+
+#ifndef KBE_VOLATILE_DATA_CACHE_H
+#define KBE_VOLATILE_DATA_CACHE_H
+
+#include "common/common.h"
+#include "common/memorystream.h"
+#include "math/math.h"
+
+#define UPDATE_FLAG_NULL				0x00000000
+#define UPDATE_FLAG_XZ					0x00000001
+#define UPDATE_FLAG_XYZ					0x00000002
+#define UPDATE_FLAG_YAW					0x00000004
+#define UPDATE_FLAG_ROLL				0x00000008
+#define UPDATE_FLAG_PITCH				0x00000010
+#define UPDATE_FLAG_YAW_PITCH_ROLL		0x00000020
+#define UPDATE_FLAG_YAW_PITCH			0x00000040
+#define UPDATE_FLAG_YAW_ROLL			0x00000080
+#define UPDATE_FLAG_PITCH_ROLL			0x00000100
+#define UPDATE_FLAG_ONGOUND				0x00000200
+
+namespace KBEngine{
+
+/**
+	entityVolatile(λá)뻺
+	һentityͨͬʱܶ۲߿ Witness::updateÿ۲߶λóһα룬
+	ѱentityϣ λóԼ±Ƕûиıʱ۲ֱӿѾõݡ
+	ע⣺optimizedЭλڹ۲ߵģ ޷ optimizedֻ泯򲿷֡
+*/
+struct VolatileDataCache
+{
+	// 3float + 3floatĳ
+	enum { MAX_DATA_SIZE = 24 };
+
+	struct Slot
+	{
+		Slot():
+		flags(0xFFFFFFFF),
+		position(),
+		direction(),
+		length(0)
+		{
+		}
+
+		bool isValid(uint32 updateFlags, const Position3D& pos, const Direction3D& dir) const
+		{
+			return flags == updateFlags && position == pos && direction.dir == dir.dir;
+		}
+
+		void invalidate()
+		{
+			flags = 0xFFFFFFFF;
+		}
+
+		/**
+			±Ǳλó optimizedЭеڹ۲ߵģ ɵԼд
+		*/
+		void encode(uint32 updateFlags, bool isOptimized, const Position3D& pos, const Direction3D& dir)
+		{
+			// ֻ߳ʹã ͬһÿη
+			static MemoryStream s(MAX_DATA_SIZE);
+			s.clear(false);
+
+			if (!isOptimized)
+			{
+				if ((updateFlags & UPDATE_FLAG_XYZ) > 0)
+					s << pos.x << pos.y << pos.z;
+				else if ((updateFlags & UPDATE_FLAG_XZ) > 0)
+					s << pos.x << pos.z;
+			}
+
+			uint32 dirFlags = updateFlags & ~(UPDATE_FLAG_XZ | UPDATE_FLAG_XYZ);
+
+			bool hasYaw = dirFlags == UPDATE_FLAG_YAW || dirFlags == UPDATE_FLAG_YAW_PITCH_ROLL || 
+				dirFlags == UPDATE_FLAG_YAW_PITCH || dirFlags == UPDATE_FLAG_YAW_ROLL;
+
+			bool hasPitch = dirFlags == UPDATE_FLAG_PITCH || dirFlags == UPDATE_FLAG_YAW_PITCH_ROLL || 
+				dirFlags == UPDATE_FLAG_YAW_PITCH || dirFlags == UPDATE_FLAG_PITCH_ROLL;
+
+			bool hasRoll = dirFlags == UPDATE_FLAG_ROLL || dirFlags == UPDATE_FLAG_YAW_PITCH_ROLL || 
+				dirFlags == UPDATE_FLAG_YAW_ROLL || dirFlags == UPDATE_FLAG_PITCH_ROLL;
+
+			// д˳ͻ˽һ: yaw, pitch, roll
+			if (isOptimized)
+			{
+				if (hasYaw)
+					s << angle2int8(dir.yaw());
+
+				if (hasPitch)
+					s << angle2int8(dir.pitch());
+
+				if (hasRoll)
+					s << angle2int8(dir.roll());
+			}
+			else
+			{
+				if (hasYaw)
+					s << dir.yaw();
+
+				if (hasPitch)
+					s << dir.pitch();
+
+				if (hasRoll)
+					s << dir.roll();
+			}
+
+			KBE_ASSERT(s.length() <= MAX_DATA_SIZE);
+
+			flags = updateFlags;
+			position = pos;
+			direction = dir;
+			length = (uint8)s.length();
+
+			if (length > 0)
+				memcpy(data, s.data() + s.rpos(), length);
+		}
+
+		uint32 flags;								// ʱĸ±
+		Position3D position;						// ʱλ
+		Direction3D direction;						// ʱĳ
+		uint8 length;								// ѱݳ
+		uint8 data[MAX_DATA_SIZE];					// ѱ
+	};
+
+	void invalidate()
+	{
+		normal.invalidate();
+		optimized.invalidate();
+	}
+
+	Slot normal;									// Э(onUpdateData_xxx)
+	Slot optimized;									// Э(onUpdateData_xxx_optimized) ֻ
+};
+
+}
+
+#endif // KBE_VOLATILE_DATA_CACHE_H
@@ -17,18 +17,6 @@
 #include "witness.inl"
 #endif
 
-#define UPDATE_FLAG_NULL				0x00000000
-#define UPDATE_FLAG_XZ					0x00000001
-#define UPDATE_FLAG_XYZ					0x00000002
-#define UPDATE_FLAG_YAW					0x00000004
-#define UPDATE_FLAG_ROLL				0x00000008
-#define UPDATE_FLAG_PITCH				0x00000010
-#define UPDATE_FLAG_YAW_PITCH_ROLL		0x00000020
-#define UPDATE_FLAG_YAW_PITCH			0x00000040
-#define UPDATE_FLAG_YAW_ROLL			0x00000080
-#define UPDATE_FLAG_PITCH_ROLL			0x00000100
-#define UPDATE_FLAG_ONGOUND				0x00000200
-
 namespace KBEngine{	
 
 
@@ -79,6 +67,22 @@ void Witness::addToStream(KBEngine::MemoryStream& s)
 	}
 	*/
 
+	// ͬһspaceڿcellǨʱ ͻû뿪space ҪViewб
+	// cellϴЩʵghost Ŀcellappܹԭùϵ
+	if (pEntity_ && pEntity_->hasFlags(ENTITY_FLAGS_OFFLOADING))
+	{
+		s << viewRadius_ << viewHysteresisArea_ << clientViewSize_;
+		s << (uint32)viewEntities_.size();
+
+		VIEW_ENTITIES::iterator iter = viewEntities_.begin();
+		for (; iter != viewEntities_.end(); ++iter)
+		{
+			(*iter)->addToStream(s);
+		}
+
+		return;
+	}
+
 	// ǰôܽ⣬spacecellָ½
 	s << viewRadius_ << viewHysteresisArea_ << (uint16)0;	
 	s << (uint32)0; // viewEntities_map_.size();
@@ -99,6 +103,18 @@ void Witness::createFromStream(KBEngine::MemoryStream& s)
 		viewEntities_.push_back(pEntityRef);
 		viewEntities_map_[pEntityRef->id()] = pEntityRef;
 		pEntityRef->aliasID(i);
+
+		// ֻпcellǨƲŻViewб ڱcellҲʵҪ֪ͨͻ뿪
+		Entity* pEntity = pEntityRef->pEntity();
+		if (pEntity == NULL || pEntity->spaceID() != pEntity_->spaceID())
+		{
+			pEntityRef->pEntity(NULL);
+			pEntityRef->flags(((pEntityRef->flags() | ENTITYREF_FLAG_LEAVE_CLIENT_PENDING) & ~(ENTITYREF_FLAG_ENTER_CLIENT_PENDING)));
+		}
+		else if ((pEntityRef->flags() & ENTITYREF_FLAG_LEAVE_CLIENT_PENDING) == 0)
+		{
+			pEntity->addWitnessed(pEntity_);
+		}
 	}
 
 	setViewRadius(viewRadius_, viewHysteresisArea_);
@@ -953,625 +969,141 @@ void Witness::addBaseDataToStream(Network::Bundle* pSendBundle)
 }
 
 //-------------------------------------------------------------------------------------
-void Witness::addUpdateToStream(Network::Bundle* pForwardBundle, uint32 flags, EntityRef* pEntityRef)
+static const Network::MessageHandler* getVolatileDataMessageHandler(uint32 flags, bool isOptimized)
 {
-	Entity* otherEntity = pEntityRef->pEntity();
-
-	static uint8 type = g_kbeSrvConfig.getCellApp().entity_posdir_updates_type;
-	static uint16 threshold = g_kbeSrvConfig.getCellApp().entity_posdir_updates_smart_threshold;
-	
-	bool isOptimized = true;
-	if ((type == 2 && clientViewSize_ <= threshold) || type == 0)
-	{
-		isOptimized = false;
-	} 
-	
 	if (isOptimized)
 	{
 		switch (flags)
 		{
-		case UPDATE_FLAG_NULL:
-		{
-			// (*pForwardBundle).newMessage(ClientInterface::onUpdateData);
-		}
-		break;
-		case UPDATE_FLAG_XZ:
-		{
-			Position3D relativePos = otherEntity->position() - this->pEntity()->position();
-
-			ENTITY_MESSAGE_FORWARD_CLIENT_BEGIN(pForwardBundle, ClientInterface::onUpdateData_xz_optimized, update);
-			_addViewEntityIDToBundle(pForwardBundle, pEntityRef);
-			pForwardBundle->appendPackXZ(relativePos.x, relativePos.z);
-			ENTITY_MESSAGE_FORWARD_CLIENT_END(pForwardBundle, ClientInterface::onUpdateData_xz_optimized, update);
-		}
-		break;
-		case UPDATE_FLAG_XYZ:
+		case UPDATE_FLAG_XZ:											return &ClientInterface::onUpdateData_xz_optimized;
+		case UPDATE_FLAG_XYZ:											return &ClientInterface::onUpdateData_xyz_optimized;
+		case UPDATE_FLAG_YAW:											return &ClientInterface::onUpdateData_y_optimized;
+		case UPDATE_FLAG_ROLL:											return &ClientInterface::onUpdateData_r_optimized;
+		case UPDATE_FLAG_PITCH:											return &ClientInterface::onUpdateData_p_optimized;
+		case UPDATE_FLAG_YAW_PITCH_ROLL:								return &ClientInterface::onUpdateData_ypr_optimized;
+		case UPDATE_FLAG_YAW_PITCH:										return &ClientInterface::onUpdateData_yp_optimized;
+		case UPDATE_FLAG_YAW_ROLL:										return &ClientInterface::onUpdateData_yr_optimized;
+		case UPDATE_FLAG_PITCH_ROLL:									return &ClientInterface::onUpdateData_pr_optimized;
+		case (UPDATE_FLAG_XZ | UPDATE_FLAG_YAW):						return &ClientInterface::onUpdateData_xz_y_optimized;
+		case (UPDATE_FLAG_XZ | UPDATE_FLAG_PITCH):						return &ClientInterface::onUpdateData_xz_p_optimized;
+		case (UPDATE_FLAG_XZ | UPDATE_FLAG_ROLL):						return &ClientInterface::onUpdateData_xz_r_optimized;
+		case (UPDATE_FLAG_XZ | UPDATE_FLAG_YAW_ROLL):					return &ClientInterface::onUpdateData_xz_yr_optimized;
+		case (UPDATE_FLAG_XZ | UPDATE_FLAG_YAW_PITCH):					return &ClientInterface::onUpdateData_xz_yp_optimized;
+		case (UPDATE_FLAG_XZ | UPDATE_FLAG_PITCH_ROLL):					return &ClientInterface::onUpdateData_xz_pr_optimized;
+		case (UPDATE_FLAG_XZ | UPDATE_FLAG_YAW_PITCH_ROLL):				return &ClientInterface::onUpdateData_xz_ypr_optimized;
+		case (UPDATE_FLAG_XYZ | UPDATE_FLAG_YAW):						return &ClientInterface::onUpdateData_xyz_y_optimized;
+		case (UPDATE_FLAG_XYZ | UPDATE_FLAG_PITCH):						return &ClientInterface::onUpdateData_xyz_p_optimized;
+		case (UPDATE_FLAG_XYZ | UPDATE_FLAG_ROLL):						return &ClientInterface::onUpdateData_xyz_r_optimized;
+		case (UPDATE_FLAG_XYZ | UPDATE_FLAG_YAW_ROLL):					return &ClientInterface::onUpdateData_xyz_yr_optimized;
+		case (UPDATE_FLAG_XYZ | UPDATE_FLAG_YAW_PITCH):					return &ClientInterface::onUpdateData_xyz_yp_optimized;
+		case (UPDATE_FLAG_XYZ | UPDATE_FLAG_PITCH_ROLL):				return &ClientInterface::onUpdateData_xyz_pr_optimized;
+		case (UPDATE_FLAG_XYZ | UPDATE_FLAG_YAW_PITCH_ROLL):			return &ClientInterface::onUpdateData_xyz_ypr_optimized;
+		default:
+			break;
+		};
+	}
+	else
+	{
+		switch (flags)
 		{
-			Position3D relativePos = otherEntity->position() - this->pEntity()->position();
+		case UPDATE_FLAG_XZ:											return &ClientInterface::onUpdateData_xz;
+		case UPDATE_FLAG_XYZ:											return &ClientInterface::onUpdateData_xyz;
+		case UPDATE_FLAG_YAW:											return &ClientInterface::onUpdateData_y;
+		case UPDATE_FLAG_ROLL:											return &ClientInterface::onUpdateData_r;
+		case UPDATE_FLAG_PITCH:											return &ClientInterface::onUpdateData_p;
+		case UPDATE_FLAG_YAW_PITCH_ROLL:								return &ClientInterface::onUpdateData_ypr;
+		case UPDATE_FLAG_YAW_PITCH:										return &ClientInterface::onUpdateData_yp;
+		case UPDATE_FLAG_YAW_ROLL:										return &ClientInterface::onUpdateData_yr;
+		case UPDATE_FLAG_PITCH_ROLL:									return &ClientInterface::onUpdateData_pr;
+		case (UPDATE_FLAG_XZ | UPDATE_FLAG_YAW):						return &ClientInterface::onUpdateData_xz_y;
+		case (UPDATE_FLAG_XZ | UPDATE_FLAG_PITCH):						return &ClientInterface::onUpdateData_xz_p;
+		case (UPDATE_FLAG_XZ | UPDATE_FLAG_ROLL):						return &ClientInterface::onUpdateData_xz_r;
+		case (UPDATE_FLAG_XZ | UPDATE_FLAG_YAW_ROLL):					return &ClientInterface::onUpdateData_xz_yr;
+		case (UPDATE_FLAG_XZ | UPDATE_FLAG_YAW_PITCH):					return &ClientInterface::onUpdateData_xz_yp;
+		case (UPDATE_FLAG_XZ | UPDATE_FLAG_PITCH_ROLL):					return &ClientInterface::onUpdateData_xz_pr;
+		case (UPDATE_FLAG_XZ | UPDATE_FLAG_YAW_PITCH_ROLL):				return &ClientInterface::onUpdateData_xz_ypr;
+		case (UPDATE_FLAG_XYZ | UPDATE_FLAG_YAW):						return &ClientInterface::onUpdateData_xyz_y;
+		case (UPDATE_FLAG_XYZ | UPDATE_FLAG_PITCH):						return &ClientInterface::onUpdateData_xyz_p;
+		case (UPDATE_FLAG_XYZ | UPDATE_FLAG_ROLL):						return &ClientInterface::onUpdateData_xyz_r;
+		case (UPDATE_FLAG_XYZ | UPDATE_FLAG_YAW_ROLL):					return &ClientInterface::onUpdateData_xyz_yr;
+		case (UPDATE_FLAG_XYZ | UPDATE_FLAG_YAW_PITCH):					return &ClientInterface::onUpdateData_xyz_yp;
+		case (UPDATE_FLAG_XYZ | UPDATE_FLAG_PITCH_ROLL):				return &ClientInterface::onUpdateData_xyz_pr;
+		case (UPDATE_FLAG_XYZ | UPDATE_FLAG_YAW_PITCH_ROLL):			return &ClientInterface::onUpdateData_xyz_ypr;
+		default:
+			break;
+		};
+	}
 
-			ENTITY_MESSAGE_FORWARD_CLIENT_BEGIN(pForwardBundle, ClientInterface::onUpdateData_xyz_optimized, update);
-			_addViewEntityIDToBundle(pForwardBundle, pEntityRef);
-			pForwardBundle->appendPackXZ(relativePos.x, relativePos.z);
-			pForwardBundle->appendPackY(relativePos.y);
-			ENTITY_MESSAGE_FORWARD_CLIENT_END(pForwardBundle, ClientInterface::onUpdateData_xyz_optimized, update);
-		}
-		break;
-		case UPDATE_FLAG_YAW:
-		{
-			const Direction3D& dir = otherEntity->direction();
+	return NULL;
+}
 
-			ENTITY_MESSAGE_FORWARD_CLIENT_BEGIN(pForwardBundle, ClientInterface::onUpdateData_y_optimized, update);
-			_addViewEntityIDToBundle(pForwardBundle, pEntityRef);
-			(*pForwardBundle) << angle2int8(dir.yaw());
-			ENTITY_MESSAGE_FORWARD_CLIENT_END(pForwardBundle, ClientInterface::onUpdateData_y_optimized, update);
-		}
-		break;
-		case UPDATE_FLAG_ROLL:
-		{
-			const Direction3D& dir = otherEntity->direction();
+//-------------------------------------------------------------------------------------
+const VolatileDataCache::Slot& Witness::getEncodedVolatileData(Entity* otherEntity, uint32 flags, bool isOptimized)
+{
+	VolatileDataCache& cache = otherEntity->volatileDataCache();
+	VolatileDataCache::Slot& slot = isOptimized ? cache.optimized : cache.normal;
 
-			ENTITY_MESSAGE_FORWARD_CLIENT_BEGIN(pForwardBundle, ClientInterface::onUpdateData_r_optimized, update);
-			_addViewEntityIDToBundle(pForwardBundle, pEntityRef);
-			(*pForwardBundle) << angle2int8(dir.roll());
-			ENTITY_MESSAGE_FORWARD_CLIENT_END(pForwardBundle, ClientInterface::onUpdateData_r_optimized, update);
-		}
-		break;
-		case UPDATE_FLAG_PITCH:
-		{
-			const Direction3D& dir = otherEntity->direction();
+	const Position3D& pos = otherEntity->position();
+	const Direction3D& dir = otherEntity->direction();
 
-			ENTITY_MESSAGE_FORWARD_CLIENT_BEGIN(pForwardBundle, ClientInterface::onUpdateData_p_optimized, update);
-			_addViewEntityIDToBundle(pForwardBundle, pEntityRef);
-			(*pForwardBundle) << angle2int8(dir.pitch());
-			ENTITY_MESSAGE_FORWARD_CLIENT_END(pForwardBundle, ClientInterface::onUpdateData_p_optimized, update);
-		}
-		break;
-		case UPDATE_FLAG_YAW_PITCH_ROLL:
-		{
-			const Direction3D& dir = otherEntity->direction();
-
-			ENTITY_MESSAGE_FORWARD_CLIENT_BEGIN(pForwardBundle, ClientInterface::onUpdateData_ypr_optimized, update);
-			_addViewEntityIDToBundle(pForwardBundle, pEntityRef);
-			(*pForwardBundle) << angle2int8(dir.yaw());
-			(*pForwardBundle) << angle2int8(dir.pitch());
-			(*pForwardBundle) << angle2int8(dir.roll());
-			ENTITY_MESSAGE_FORWARD_CLIENT_END(pForwardBundle, ClientInterface::onUpdateData_ypr_optimized, update);
-		}
-		break;
-		case UPDATE_FLAG_YAW_PITCH:
-		{
-			const Direction3D& dir = otherEntity->direction();
+	// ͬһtickڸentityᱻпĹ۲߸£ ֻҪλóûͿֱӸ
+	if (slot.isValid(flags, pos, dir))
+	{
+		++g_volatileDataCacheHits;
+		g_volatileDataCopiedBytes += slot.length;
+		return slot;
+	}
 
-			ENTITY_MESSAGE_FORWARD_CLIENT_BEGIN(pForwardBundle, ClientInterface::onUpdateData_yp_optimized, update);
-			_addViewEntityIDToBundle(pForwardBundle, pEntityRef);
-			(*pForwardBundle) << angle2int8(dir.yaw());
-			(*pForwardBundle) << angle2int8(dir.pitch());
-			ENTITY_MESSAGE_FORWARD_CLIENT_END(pForwardBundle, ClientInterface::onUpdateData_yp_optimized, update);
-		}
-		break;
-		case UPDATE_FLAG_YAW_ROLL:
-		{
-			const Direction3D& dir = otherEntity->direction();
+	slot.encode(flags, isOptimized, pos, dir);
 
-			ENTITY_MESSAGE_FORWARD_CLIENT_BEGIN(pForwardBundle, ClientInterface::onUpdateData_yr_optimized, update);
-			_addViewEntityIDToBundle(pForwardBundle, pEntityRef);
-			(*pForwardBundle) << angle2int8(dir.yaw());
-			(*pForwardBundle) << angle2int8(dir.roll());
-			ENTITY_MESSAGE_FORWARD_CLIENT_END(pForwardBundle, ClientInterface::onUpdateData_yr_optimized, update);
-		}
-		break;
-		case UPDATE_FLAG_PITCH_ROLL:
-		{
-			const Direction3D& dir = otherEntity->direction();
+	++g_volatileDataCacheMisses;
+	g_volatileDataEncodedBytes += slot.length;
+	return slot;
+}
 
-			ENTITY_MESSAGE_FORWARD_CLIENT_BEGIN(pForwardBundle, ClientInterface::onUpdateData_pr_optimized, update);
-			_addViewEntityIDToBundle(pForwardBundle, pEntityRef);
-			(*pForwardBundle) << angle2int8(dir.pitch());
-			(*pForwardBundle) << angle2int8(dir.roll());
-			ENTITY_MESSAGE_FORWARD_CLIENT_END(pForwardBundle, ClientInterface::onUpdateData_pr_optimized, update);
-		}
-		break;
-		case (UPDATE_FLAG_XZ | UPDATE_FLAG_YAW):
-		{
-			Position3D relativePos = otherEntity->position() - this->pEntity()->position();
-			const Direction3D& dir = otherEntity->direction();
-
-			ENTITY_MESSAGE_FORWARD_CLIENT_BEGIN(pForwardBundle, ClientInterface::onUpdateData_xz_y_optimized, update);
-			_addViewEntityIDToBundle(pForwardBundle, pEntityRef);
-			pForwardBundle->appendPackXZ(relativePos.x, relativePos.z);
-			(*pForwardBundle) << angle2int8(dir.yaw());
-			ENTITY_MESSAGE_FORWARD_CLIENT_END(pForwardBundle, ClientInterface::onUpdateData_xz_y_optimized, update);
-		}
-		break;
-		case (UPDATE_FLAG_XZ | UPDATE_FLAG_PITCH):
-		{
-			Position3D relativePos = otherEntity->position() - this->pEntity()->position();
-			const Direction3D& dir = otherEntity->direction();
-
-			ENTITY_MESSAGE_FORWARD_CLIENT_BEGIN(pForwardBundle, ClientInterface::onUpdateData_xz_p_optimized, update);
-			_addViewEntityIDToBundle(pForwardBundle, pEntityRef);
-			pForwardBundle->appendPackXZ(relativePos.x, relativePos.z);
-			(*pForwardBundle) << angle2int8(dir.pitch());
-			ENTITY_MESSAGE_FORWARD_CLIENT_END(pForwardBundle, ClientInterface::onUpdateData_xz_p_optimized, update);
-		}
-		break;
-		case (UPDATE_FLAG_XZ | UPDATE_FLAG_ROLL):
-		{
-			Position3D relativePos = otherEntity->position() - this->pEntity()->position();
-			const Direction3D& dir = otherEntity->direction();
-
-			ENTITY_MESSAGE_FORWARD_CLIENT_BEGIN(pForwardBundle, ClientInterface::onUpdateData_xz_r_optimized, update);
-			_addViewEntityIDToBundle(pForwardBundle, pEntityRef);
-			pForwardBundle->appendPackXZ(relativePos.x, relativePos.z);
-			(*pForwardBundle) << angle2int8(dir.roll());
-			ENTITY_MESSAGE_FORWARD_CLIENT_END(pForwardBundle, ClientInterface::onUpdateData_xz_r_optimized, update);
-		}
-		break;
-		case (UPDATE_FLAG_XZ | UPDATE_FLAG_YAW_ROLL):
-		{
-			Position3D relativePos = otherEntity->position() - this->pEntity()->position();
-			const Direction3D& dir = otherEntity->direction();
-
-			ENTITY_MESSAGE_FORWARD_CLIENT_BEGIN(pForwardBundle, ClientInterface::onUpdateData_xz_yr_optimized, update);
-			_addViewEntityIDToBundle(pForwardBundle, pEntityRef);
-			pForwardBundle->appendPackXZ(relativePos.x, relativePos.z);
-			(*pForwardBundle) << angle2int8(dir.yaw());
-			(*pForwardBundle) << angle2int8(dir.roll());
-			ENTITY_MESSAGE_FORWARD_CLIENT_END(pForwardBundle, ClientInterface::onUpdateData_xz_yr_optimized, update);
-		}
-		break;
-		case (UPDATE_FLAG_XZ | UPDATE_FLAG_YAW_PITCH):
-		{
-			Position3D relativePos = otherEntity->position() - this->pEntity()->position();
-			const Direction3D& dir = otherEntity->direction();
-
-			ENTITY_MESSAGE_FORWARD_CLIENT_BEGIN(pForwardBundle, ClientInterface::onUpdateData_xz_yp_optimized, update);
-			_addViewEntityIDToBundle(pForwardBundle, pEntityRef);
-			pForwardBundle->appendPackXZ(relativePos.x, relativePos.z);
-			(*pForwardBundle) << angle2int8(dir.yaw());
-			(*pForwardBundle) << angle2int8(dir.pitch());
-			ENTITY_MESSAGE_FORWARD_CLIENT_END(pForwardBundle, ClientInterface::onUpdateData_xz_yp_optimized, update);
-		}
-		break;
-		case (UPDATE_FLAG_XZ | UPDATE_FLAG_PITCH_ROLL):
-		{
-			Position3D relativePos = otherEntity->position() - this->pEntity()->position();
-			const Direction3D& dir = otherEntity->direction();
-
-			ENTITY_MESSAGE_FORWARD_CLIENT_BEGIN(pForwardBundle, ClientInterface::onUpdateData_xz_pr_optimized, update);
-			_addViewEntityIDToBundle(pForwardBundle, pEntityRef);
-			pForwardBundle->appendPackXZ(relativePos.x, relativePos.z);
-			(*pForwardBundle) << angle2int8(dir.pitch());
-			(*pForwardBundle) << angle2int8(dir.roll());
-			ENTITY_MESSAGE_FORWARD_CLIENT_END(pForwardBundle, ClientInterface::onUpdateData_xz_pr_optimized, update);
-		}
-		break;
-		case (UPDATE_FLAG_XZ | UPDATE_FLAG_YAW_PITCH_ROLL):
-		{
-			Position3D relativePos = otherEntity->position() - this->pEntity()->position();
-			const Direction3D& dir = otherEntity->direction();
-
-			ENTITY_MESSAGE_FORWARD_CLIENT_BEGIN(pForwardBundle, ClientInterface::onUpdateData_xz_ypr_optimized, update);
-			_addViewEntityIDToBundle(pForwardBundle, pEntityRef);
-			pForwardBundle->appendPackXZ(relativePos.x, relativePos.z);
-			(*pForwardBundle) << angle2int8(dir.yaw());
-			(*pForwardBundle) << angle2int8(dir.pitch());
-			(*pForwardBundle) << angle2int8(dir.roll());
-			ENTITY_MESSAGE_FORWARD_CLIENT_END(pForwardBundle, ClientInterface::onUpdateData_xz_ypr_optimized, update);
-		}
-		break;
-		case (UPDATE_FLAG_XYZ | UPDATE_FLAG_YAW):
-		{
-			Position3D relativePos = otherEntity->position() - this->pEntity()->position();
-			const Direction3D& dir = otherEntity->direction();
+//-------------------------------------------------------------------------------------
+void Witness::addUpdateToStream(Network::Bundle* pForwardBundle, uint32 flags, EntityRef* pEntityRef)
+{
+	if (flags == UPDATE_FLAG_NULL)
+		return;
 
-			ENTITY_MESSAGE_FORWARD_CLIENT_BEGIN(pForwardBundle, ClientInterface::onUpdateData_xyz_y_optimized, update);
-			_addViewEntityIDToBundle(pForwardBundle, pEntityRef);
-			pForwardBundle->appendPackXZ(relativePos.x, relativePos.z);
-			pForwardBundle->appendPackY(relativePos.y);
-			(*pForwardBundle) << angle2int8(dir.yaw());
-			ENTITY_MESSAGE_FORWARD_CLIENT_END(pForwardBundle, ClientInterface::onUpdateData_xyz_y_optimized, update);
-		}
-		break;
-		case (UPDATE_FLAG_XYZ | UPDATE_FLAG_PITCH):
-		{
-			Position3D relativePos = otherEntity->position() - this->pEntity()->position();
-			const Direction3D& dir = otherEntity->direction();
+	Entity* otherEntity = pEntityRef->pEntity();
 
-			ENTITY_MESSAGE_FORWARD_CLIENT_BEGIN(pForwardBundle, ClientInterface::onUpdateData_xyz_p_optimized, update);
-			_addViewEntityIDToBundle(pForwardBundle, pEntityRef);
-			pForwardBundle->appendPackXZ(relativePos.x, relativePos.z);
-			pForwardBundle->appendPackY(relativePos.y);
-			(*pForwardBundle) << angle2int8(dir.pitch());
-			ENTITY_MESSAGE_FORWARD_CLIENT_END(pForwardBundle, ClientInterface::onUpdateData_xyz_p_optimized, update);
-		}
-		break;
-		case (UPDATE_FLAG_XYZ | UPDATE_FLAG_ROLL):
-		{
-			Position3D relativePos = otherEntity->position() - this->pEntity()->position();
-			const Direction3D& dir = otherEntity->direction();
+	static uint8 type = g_kbeSrvConfig.getCellApp().entity_posdir_updates_type;
+	static uint16 threshold = g_kbeSrvConfig.getCellApp().entity_posdir_updates_smart_threshold;
+	
+	bool isOptimized = true;
+	if ((type == 2 && clientViewSize_ <= threshold) || type == 0)
+	{
+		isOptimized = false;
+	} 
 
-			ENTITY_MESSAGE_FORWARD_CLIENT_BEGIN(pForwardBundle, ClientInterface::onUpdateData_xyz_r_optimized, update);
-			_addViewEntityIDToBundle(pForwardBundle, pEntityRef);
-			pForwardBundle->appendPackXZ(relativePos.x, relativePos.z);
-			pForwardBundle->appendPackY(relativePos.y);
-			(*pForwardBundle) << angle2int8(dir.roll());
-			ENTITY_MESSAGE_FORWARD_CLIENT_END(pForwardBundle, ClientInterface::onUpdateData_xyz_r_optimized, update);
-		}
-		break;
-		case (UPDATE_FLAG_XYZ | UPDATE_FLAG_YAW_ROLL):
-		{
-			Position3D relativePos = otherEntity->position() - this->pEntity()->position();
-			const Direction3D& dir = otherEntity->direction();
+	const Network::MessageHandler* pMsgHandler = getVolatileDataMessageHandler(flags, isOptimized);
+	if (pMsgHandler == NULL)
+	{
+		KBE_ASSERT(false);
+		return;
+	}
 
-			ENTITY_MESSAGE_FORWARD_CLIENT_BEGIN(pForwardBundle, ClientInterface::onUpdateData_xyz_yr_optimized, update);
-			_addViewEntityIDToBundle(pForwardBundle, pEntityRef);
-			pForwardBundle->appendPackXZ(relativePos.x, relativePos.z);
-			pForwardBundle->appendPackY(relativePos.y);
-			(*pForwardBundle) << angle2int8(dir.yaw());
-			(*pForwardBundle) << angle2int8(dir.roll());
-			ENTITY_MESSAGE_FORWARD_CLIENT_END(pForwardBundle, ClientInterface::onUpdateData_xyz_yr_optimized, update);
-		}
-		break;
-		case (UPDATE_FLAG_XYZ | UPDATE_FLAG_YAW_PITCH):
-		{
-			Position3D relativePos = otherEntity->position() - this->pEntity()->position();
-			const Direction3D& dir = otherEntity->direction();
+	const VolatileDataCache::Slot& slot = getEncodedVolatileData(otherEntity, flags, isOptimized);
 
-			ENTITY_MESSAGE_FORWARD_CLIENT_BEGIN(pForwardBundle, ClientInterface::onUpdateData_xyz_yp_optimized, update);
-			_addViewEntityIDToBundle(pForwardBundle, pEntityRef);
-			pForwardBundle->appendPackXZ(relativePos.x, relativePos.z);
-			pForwardBundle->appendPackY(relativePos.y);
-			(*pForwardBundle) << angle2int8(dir.yaw());
-			(*pForwardBundle) << angle2int8(dir.pitch());
-			ENTITY_MESSAGE_FORWARD_CLIENT_END(pForwardBundle, ClientInterface::onUpdateData_xyz_yp_optimized, update);
-		}
-		break;
-		case (UPDATE_FLAG_XYZ | UPDATE_FLAG_PITCH_ROLL):
-		{
-			Position3D relativePos = otherEntity->position() - this->pEntity()->position();
-			const Direction3D& dir = otherEntity->direction();
+	ENTITY_MESSAGE_FORWARD_CLIENT_BEGIN(pForwardBundle, (*pMsgHandler), update);
+	_addViewEntityIDToBundle(pForwardBundle, pEntityRef);
 
-			ENTITY_MESSAGE_FORWARD_CLIENT_BEGIN(pForwardBundle, ClientInterface::onUpdateData_xyz_pr_optimized, update);
-			_addViewEntityIDToBundle(pForwardBundle, pEntityRef);
-			pForwardBundle->appendPackXZ(relativePos.x, relativePos.z);
-			pForwardBundle->appendPackY(relativePos.y);
-			(*pForwardBundle) << angle2int8(dir.pitch());
-			(*pForwardBundle) << angle2int8(dir.roll());
-			ENTITY_MESSAGE_FORWARD_CLIENT_END(pForwardBundle, ClientInterface::onUpdateData_xyz_pr_optimized, update);
-		}
-		break;
-		case (UPDATE_FLAG_XYZ | UPDATE_FLAG_YAW_PITCH_ROLL):
-		{
-			Position3D relativePos = otherEntity->position() - this->pEntity()->position();
-			const Direction3D& dir = otherEntity->direction();
+	if (isOptimized && (flags & (UPDATE_FLAG_XZ | UPDATE_FLAG_XYZ)) > 0)
+	{
+		// ۲λã ޷ڹ۲֮乲
+		Position3D relativePos = otherEntity->position() - this->pEntity()->position();
+		pForwardBundle->appendPackXZ(relativePos.x, relativePos.z);
 
-			ENTITY_MESSAGE_FORWARD_CLIENT_BEGIN(pForwardBundle, ClientInterface::onUpdateData_xyz_ypr_optimized, update);
-			_addViewEntityIDToBundle(pForwardBundle, pEntityRef);
-			pForwardBundle->appendPackXZ(relativePos.x, relativePos.z);
+		if ((flags & UPDATE_FLAG_XYZ) > 0)
 			pForwardBundle->appendPackY(relativePos.y);
-			(*pForwardBundle) << angle2int8(dir.yaw());
-			(*pForwardBundle) << angle2int8(dir.pitch());
-			(*pForwardBundle) << angle2int8(dir.roll());
-			ENTITY_MESSAGE_FORWARD_CLIENT_END(pForwardBundle, ClientInterface::onUpdateData_xyz_ypr_optimized, update);
-		}
-		break;
-		default:
-			KBE_ASSERT(false);
-			break;
-		};
 	}
-	else
-	{
-		switch (flags)
-		{
-		case UPDATE_FLAG_NULL:
-		{
-			// (*pForwardBundle).newMessage(ClientInterface::onUpdateData);
-		}
-		break;
-		case UPDATE_FLAG_XZ:
-		{
-			const Position3D& pos = otherEntity->position();
-
-			ENTITY_MESSAGE_FORWARD_CLIENT_BEGIN(pForwardBundle, ClientInterface::onUpdateData_xz, update);
-			_addViewEntityIDToBundle(pForwardBundle, pEntityRef);
-			(*pForwardBundle) << pos.x;
-			(*pForwardBundle) << pos.z;
-			ENTITY_MESSAGE_FORWARD_CLIENT_END(pForwardBundle, ClientInterface::onUpdateData_xz, update);
-		}
-		break;
-		case UPDATE_FLAG_XYZ:
-		{
-			const Position3D& pos = otherEntity->position();
-
-			ENTITY_MESSAGE_FORWARD_CLIENT_BEGIN(pForwardBundle, ClientInterface::onUpdateData_xyz, update);
-			_addViewEntityIDToBundle(pForwardBundle, pEntityRef);
-			(*pForwardBundle) << pos.x;
-			(*pForwardBundle) << pos.y;
-			(*pForwardBundle) << pos.z;
-			ENTITY_MESSAGE_FORWARD_CLIENT_END(pForwardBundle, ClientInterface::onUpdateData_xyz, update);
-		}
-		break;
-		case UPDATE_FLAG_YAW:
-		{
-			const Direction3D& dir = otherEntity->direction();
-
-			ENTITY_MESSAGE_FORWARD_CLIENT_BEGIN(pForwardBundle, ClientInterface::onUpdateData_y, update);
-			_addViewEntityIDToBundle(pForwardBundle, pEntityRef);
-			(*pForwardBundle) << dir.yaw();
-			ENTITY_MESSAGE_FORWARD_CLIENT_END(pForwardBundle, ClientInterface::onUpdateData_y, update);
-		}
-		break;
-		case UPDATE_FLAG_ROLL:
-		{
-			const Direction3D& dir = otherEntity->direction();
-
-			ENTITY_MESSAGE_FORWARD_CLIENT_BEGIN(pForwardBundle, ClientInterface::onUpdateData_r, update);
-			_addViewEntityIDToBundle(pForwardBundle, pEntityRef);
-			(*pForwardBundle) << dir.roll();
-			ENTITY_MESSAGE_FORWARD_CLIENT_END(pForwardBundle, ClientInterface::onUpdateData_r, update);
-		}
-		break;
-		case UPDATE_FLAG_PITCH:
-		{
-			const Direction3D& dir = otherEntity->direction();
-
-			ENTITY_MESSAGE_FORWARD_CLIENT_BEGIN(pForwardBundle, ClientInterface::onUpdateData_p, update);
-			_addViewEntityIDToBundle(pForwardBundle, pEntityRef);
-			(*pForwardBundle) << dir.pitch();
-			ENTITY_MESSAGE_FORWARD_CLIENT_END(pForwardBundle, ClientInterface::onUpdateData_p, update);
-		}
-		break;
-		case UPDATE_FLAG_YAW_PITCH_ROLL:
-		{
-			const Direction3D& dir = otherEntity->direction();
-
-			ENTITY_MESSAGE_FORWARD_CLIENT_BEGIN(pForwardBundle, ClientInterface::onUpdateData_ypr, update);
-			_addViewEntityIDToBundle(pForwardBundle, pEntityRef);
-			(*pForwardBundle) << dir.yaw();
-			(*pForwardBundle) << dir.pitch();
-			(*pForwardBundle) << dir.roll();
-			ENTITY_MESSAGE_FORWARD_CLIENT_END(pForwardBundle, ClientInterface::onUpdateData_ypr, update);
-		}
-		break;
-		case UPDATE_FLAG_YAW_PITCH:
-		{
-			const Direction3D& dir = otherEntity->direction();
-
-			ENTITY_MESSAGE_FORWARD_CLIENT_BEGIN(pForwardBundle, ClientInterface::onUpdateData_yp, update);
-			_addViewEntityIDToBundle(pForwardBundle, pEntityRef);
-			(*pForwardBundle) << dir.yaw();
-			(*pForwardBundle) << dir.pitch();
-			ENTITY_MESSAGE_FORWARD_CLIENT_END(pForwardBundle, ClientInterface::onUpdateData_yp, update);
-		}
-		break;
-		case UPDATE_FLAG_YAW_ROLL:
-		{
-			const Direction3D& dir = otherEntity->direction();
 
-			ENTITY_MESSAGE_FORWARD_CLIENT_BEGIN(pForwardBundle, ClientInterface::onUpdateData_yr, update);
-			_addViewEntityIDToBundle(pForwardBundle, pEntityRef);
-			(*pForwardBundle) << dir.yaw();
-			(*pForwardBundle) << dir.roll();
-			ENTITY_MESSAGE_FORWARD_CLIENT_END(pForwardBundle, ClientInterface::onUpdateData_yr, update);
-		}
-		break;
-		case UPDATE_FLAG_PITCH_ROLL:
-		{
-			const Direction3D& dir = otherEntity->direction();
+	if (slot.length > 0)
+		pForwardBundle->append(slot.data, (int)slot.length);
 
-			ENTITY_MESSAGE_FORWARD_CLIENT_BEGIN(pForwardBundle, ClientInterface::onUpdateData_pr, update);
-			_addViewEntityIDToBundle(pForwardBundle, pEntityRef);
-			(*pForwardBundle) << dir.pitch();
-			(*pForwardBundle) << dir.roll();
-			ENTITY_MESSAGE_FORWARD_CLIENT_END(pForwardBundle, ClientInterface::onUpdateData_pr, update);
-		}
-		break;
-		case (UPDATE_FLAG_XZ | UPDATE_FLAG_YAW):
-		{
-			const Position3D& pos = otherEntity->position();
-			const Direction3D& dir = otherEntity->direction();
-
-			ENTITY_MESSAGE_FORWARD_CLIENT_BEGIN(pForwardBundle, ClientInterface::onUpdateData_xz_y, update);
-			_addViewEntityIDToBundle(pForwardBundle, pEntityRef);
-			(*pForwardBundle) << pos.x;
-			(*pForwardBundle) << pos.z;
-			(*pForwardBundle) << dir.yaw();
-			ENTITY_MESSAGE_FORWARD_CLIENT_END(pForwardBundle, ClientInterface::onUpdateData_xz_y, update);
-		}
-		break;
-		case (UPDATE_FLAG_XZ | UPDATE_FLAG_PITCH):
-		{
-			const Position3D& pos = otherEntity->position();
-			const Direction3D& dir = otherEntity->direction();
-
-			ENTITY_MESSAGE_FORWARD_CLIENT_BEGIN(pForwardBundle, ClientInterface::onUpdateData_xz_p, update);
-			_addViewEntityIDToBundle(pForwardBundle, pEntityRef);
-			(*pForwardBundle) << pos.x;
-			(*pForwardBundle) << pos.z;
-			(*pForwardBundle) << dir.pitch();
-			ENTITY_MESSAGE_FORWARD_CLIENT_END(pForwardBundle, ClientInterface::onUpdateData_xz_p, update);
-		}
-		break;
-		case (UPDATE_FLAG_XZ | UPDATE_FLAG_ROLL):
-		{
-			const Position3D& pos = otherEntity->position();
-			const Direction3D& dir = otherEntity->direction();
-
-			ENTITY_MESSAGE_FORWARD_CLIENT_BEGIN(pForwardBundle, ClientInterface::onUpdateData_xz_r, update);
-			_addViewEntityIDToBundle(pForwardBundle, pEntityRef);
-			(*pForwardBundle) << pos.x;
-			(*pForwardBundle) << pos.z;
-			(*pForwardBundle) << dir.roll();
-			ENTITY_MESSAGE_FORWARD_CLIENT_END(pForwardBundle, ClientInterface::onUpdateData_xz_r, update);
-		}
-		break;
-		case (UPDATE_FLAG_XZ | UPDATE_FLAG_YAW_ROLL):
-		{
-			const Position3D& pos = otherEntity->position();
-			const Direction3D& dir = otherEntity->direction();
-
-			ENTITY_MESSAGE_FORWARD_CLIENT_BEGIN(pForwardBundle, ClientInterface::onUpdateData_xz_yr, update);
-			_addViewEntityIDToBundle(pForwardBundle, pEntityRef);
-			(*pForwardBundle) << pos.x;
-			(*pForwardBundle) << pos.z;
-			(*pForwardBundle) << dir.yaw();
-			(*pForwardBundle) << dir.roll();
-			ENTITY_MESSAGE_FORWARD_CLIENT_END(pForwardBundle, ClientInterface::onUpdateData_xz_yr, update);
-		}
-		break;
-		case (UPDATE_FLAG_XZ | UPDATE_FLAG_YAW_PITCH):
-		{
-			const Position3D& pos = otherEntity->position();
-			const Direction3D& dir = otherEntity->direction();
-
-			ENTITY_MESSAGE_FORWARD_CLIENT_BEGIN(pForwardBundle, ClientInterface::onUpdateData_xz_yp, update);
-			_addViewEntityIDToBundle(pForwardBundle, pEntityRef);
-			(*pForwardBundle) << pos.x;
-			(*pForwardBundle) << pos.z;
-			(*pForwardBundle) << dir.yaw();
-			(*pForwardBundle) << dir.pitch();
-			ENTITY_MESSAGE_FORWARD_CLIENT_END(pForwardBundle, ClientInterface::onUpdateData_xz_yp, update);
-		}
-		break;
-		case (UPDATE_FLAG_XZ | UPDATE_FLAG_PITCH_ROLL):
-		{
-			const Position3D& pos = otherEntity->position();
-			const Direction3D& dir = otherEntity->direction();
-
-			ENTITY_MESSAGE_FORWARD_CLIENT_BEGIN(pForwardBundle, ClientInterface::onUpdateData_xz_pr, update);
-			_addViewEntityIDToBundle(pForwardBundle, pEntityRef);
-			(*pForwardBundle) << pos.x;
-			(*pForwardBundle) << pos.z;
-			(*pForwardBundle) << dir.pitch();
-			(*pForwardBundle) << dir.roll();
-			ENTITY_MESSAGE_FORWARD_CLIENT_END(pForwardBundle, ClientInterface::onUpdateData_xz_pr, update);
-		}
-		break;
-		case (UPDATE_FLAG_XZ | UPDATE_FLAG_YAW_PITCH_ROLL):
-		{
-			const Position3D& pos = otherEntity->position();
-			const Direction3D& dir = otherEntity->direction();
-
-			ENTITY_MESSAGE_FORWARD_CLIENT_BEGIN(pForwardBundle, ClientInterface::onUpdateData_xz_ypr, update);
-			_addViewEntityIDToBundle(pForwardBundle, pEntityRef);
-			(*pForwardBundle) << pos.x;
-			(*pForwardBundle) << pos.z;
-			(*pForwardBundle) << dir.yaw();
-			(*pForwardBundle) << dir.pitch();
-			(*pForwardBundle) << dir.roll();
-			ENTITY_MESSAGE_FORWARD_CLIENT_END(pForwardBundle, ClientInterface::onUpdateData_xz_ypr, update);
-		}
-		break;
-		case (UPDATE_FLAG_XYZ | UPDATE_FLAG_YAW):
-		{
-			const Position3D& pos = otherEntity->position();
-			const Direction3D& dir = otherEntity->direction();
-
-			ENTITY_MESSAGE_FORWARD_CLIENT_BEGIN(pForwardBundle, ClientInterface::onUpdateData_xyz_y, update);
-			_addViewEntityIDToBundle(pForwardBundle, pEntityRef);
-			(*pForwardBundle) << pos.x;
-			(*pForwardBundle) << pos.y;
-			(*pForwardBundle) << pos.z;
-			(*pForwardBundle) << dir.yaw();
-			ENTITY_MESSAGE_FORWARD_CLIENT_END(pForwardBundle, ClientInterface::onUpdateData_xyz_y, update);
-		}
-		break;
-		case (UPDATE_FLAG_XYZ | UPDATE_FLAG_PITCH):
-		{
-			const Position3D& pos = otherEntity->position();
-			const Direction3D& dir = otherEntity->direction();
-
-			ENTITY_MESSAGE_FORWARD_CLIENT_BEGIN(pForwardBundle, ClientInterface::onUpdateData_xyz_p, update);
-			_addViewEntityIDToBundle(pForwardBundle, pEntityRef);
-			(*pForwardBundle) << pos.x;
-			(*pForwardBundle) << pos.y;
-			(*pForwardBundle) << pos.z;
-			(*pForwardBundle) << dir.pitch();
-			ENTITY_MESSAGE_FORWARD_CLIENT_END(pForwardBundle, ClientInterface::onUpdateData_xyz, update);
-		}
-		break;
-		case (UPDATE_FLAG_XYZ | UPDATE_FLAG_ROLL):
-		{
-			const Position3D& pos = otherEntity->position();
-			const Direction3D& dir = otherEntity->direction();
-
-			ENTITY_MESSAGE_FORWARD_CLIENT_BEGIN(pForwardBundle, ClientInterface::onUpdateData_xyz_r, update);
-			_addViewEntityIDToBundle(pForwardBundle, pEntityRef);
-			(*pForwardBundle) << pos.x;
-			(*pForwardBundle) << pos.y;
-			(*pForwardBundle) << pos.z;
-			(*pForwardBundle) << dir.roll();
-			ENTITY_MESSAGE_FORWARD_CLIENT_END(pForwardBundle, ClientInterface::onUpdateData_xyz_r, update);
-		}
-		break;
-		case (UPDATE_FLAG_XYZ | UPDATE_FLAG_YAW_ROLL):
-		{
-			const Position3D& pos = otherEntity->position();
-			const Direction3D& dir = otherEntity->direction();
-
-			ENTITY_MESSAGE_FORWARD_CLIENT_BEGIN(pForwardBundle, ClientInterface::onUpdateData_xyz_yr, update);
-			_addViewEntityIDToBundle(pForwardBundle, pEntityRef);
-			(*pForwardBundle) << pos.x;
-			(*pForwardBundle) << pos.y;
-			(*pForwardBundle) << pos.z;
-			(*pForwardBundle) << dir.yaw();
-			(*pForwardBundle) << dir.roll();
-			ENTITY_MESSAGE_FORWARD_CLIENT_END(pForwardBundle, ClientInterface::onUpdateData_xyz_yr, update);
-		}
-		break;
-		case (UPDATE_FLAG_XYZ | UPDATE_FLAG_YAW_PITCH):
-		{
-			const Position3D& pos = otherEntity->position();
-			const Direction3D& dir = otherEntity->direction();
-
-			ENTITY_MESSAGE_FORWARD_CLIENT_BEGIN(pForwardBundle, ClientInterface::onUpdateData_xyz_yp, update);
-			_addViewEntityIDToBundle(pForwardBundle, pEntityRef);
-			(*pForwardBundle) << pos.x;
-			(*pForwardBundle) << pos.y;
-			(*pForwardBundle) << pos.z;
-			(*pForwardBundle) << dir.yaw();
-			(*pForwardBundle) << dir.pitch();
-			ENTITY_MESSAGE_FORWARD_CLIENT_END(pForwardBundle, ClientInterface::onUpdateData_xyz_yp, update);
-		}
-		break;
-		case (UPDATE_FLAG_XYZ | UPDATE_FLAG_PITCH_ROLL):
-		{
-			const Position3D& pos = otherEntity->position();
-			const Direction3D& dir = otherEntity->direction();
-
-			ENTITY_MESSAGE_FORWARD_CLIENT_BEGIN(pForwardBundle, ClientInterface::onUpdateData_xyz_pr, update);
-			_addViewEntityIDToBundle(pForwardBundle, pEntityRef);
-			(*pForwardBundle) << pos.x;
-			(*pForwardBundle) << pos.y;
-			(*pForwardBundle) << pos.z;
-			(*pForwardBundle) << dir.pitch();
-			(*pForwardBundle) << dir.roll();
-			ENTITY_MESSAGE_FORWARD_CLIENT_END(pForwardBundle, ClientInterface::onUpdateData_xyz_pr, update);
-		}
-		break;
-		case (UPDATE_FLAG_XYZ | UPDATE_FLAG_YAW_PITCH_ROLL):
-		{
-			const Position3D& pos = otherEntity->position();
-			const Direction3D& dir = otherEntity->direction();
-
-			ENTITY_MESSAGE_FORWARD_CLIENT_BEGIN(pForwardBundle, ClientInterface::onUpdateData_xyz_ypr, update);
-			_addViewEntityIDToBundle(pForwardBundle, pEntityRef);
-			(*pForwardBundle) << pos.x;
-			(*pForwardBundle) << pos.y;
-			(*pForwardBundle) << pos.z;
-			(*pForwardBundle) << dir.yaw();
-			(*pForwardBundle) << dir.pitch();
-			(*pForwardBundle) << dir.roll();
-			ENTITY_MESSAGE_FORWARD_CLIENT_END(pForwardBundle, ClientInterface::onUpdateData_xyz_ypr, update);
-		}
-		break;
-		default:
-			KBE_ASSERT(false);
-			break;
-		};
-	}
+	ENTITY_MESSAGE_FORWARD_CLIENT_END(pForwardBundle, (*pMsgHandler), update);
 }
 
 //-------------------------------------------------------------------------------------
@@ -6,6 +6,7 @@
 // common include
 #include "updatable.h"
 #include "entityref.h"
+#include "volatile_data_cache.h"
 #include "helper/debug_helper.h"
 #include "common/common.h"
 #include "common/objectpool.h"
@@ -144,6 +145,11 @@ public:
 	*/
 	void addUpdateToStream(Network::Bundle* pForwardBundle, uint32 flags, EntityRef* pEntityRef);
 
+	/**
+		ĳentityѱλóݣ ʧЧ±
+	*/
+	static const VolatileDataCache::Slot& getEncodedVolatileData(Entity* otherEntity, uint32 flags, bool isOptimized);
+
 	/**
 		ӻλõ°
 	*/
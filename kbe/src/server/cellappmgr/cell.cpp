@@ -1,14 +1,17 @@
 // Copyright 2008-2018 Yolo Technologies, Inc. All Rights Reserved. https://www.comblockengine.com
 
-#include "cell.h"	
-#include "helper/profile.h"	
+#include "cell.h"
+#include "helper/profile.h"
 
-namespace KBEngine{	
+namespace KBEngine{
 
 
 //-------------------------------------------------------------------------------------
-Cell::Cell(CELL_ID id):
-id_(id)
+Cell::Cell(CELL_ID id, COMPONENT_ID cellappID, float minX, float maxX):
+id_(id),
+cellappID_(cellappID),
+minX_(minX),
+maxX_(maxX)
 {
 }
 
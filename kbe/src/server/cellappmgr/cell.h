@@ -10,15 +10,31 @@
 
 namespace KBEngine{
 
+/**
+	spaceָһcell x[minX, maxX)Χڵrealʵ
+*/
 class Cell
 {
 public:
-	Cell(CELL_ID id);
+	Cell(CELL_ID id = 0, COMPONENT_ID cellappID = 0, float minX = -FLT_MAX, float maxX = FLT_MAX);
 	~Cell();
 
 	CELL_ID id() const{ return id_; }
+	COMPONENT_ID cellappID() const{ return cellappID_; }
+
+	float minX() const{ return minX_; }
+	void minX(float v){ minX_ = v; }
+
+	float maxX() const{ return maxX_; }
+	void maxX(float v){ maxX_ = v; }
+
+	float width() const{ return maxX_ - minX_; }
+
 private:
 	CELL_ID id_;
+	COMPONENT_ID cellappID_;
+	float minX_;
+	float maxX_;
 };
 
 }
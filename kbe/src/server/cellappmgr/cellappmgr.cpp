@@ -64,7 +64,12 @@ Cellappmgr::Cellappmgr(Network::EventDispatcher& dispatcher,
 	forward_anywhere_cellapp_messagebuffer_(ninterface, CELLAPP_TYPE),
 	forward_cellapp_messagebuffer_(ninterface),
 	cellapps_(),
-	cellapp_cids_()
+	cellapp_cids_(),
+	spaceCells_(),
+	lastCellID_(0),
+	lastPartitionTime_(0),
+	pendingSplitCellappID_(0),
+	pendingSplitTime_(0)
 {
 	KBEngine::Network::MessageHandlers::pMainMessageHandlers = &CellappmgrInterface::messageHandlers;
 }
@@ -111,6 +116,32 @@ void Cellappmgr::removeCellapp(COMPONENT_ID cid)
 
 		updateBestCellapp();
 	}
+
+	// cellappcellϲڵcell
+	std::map< SPACE_ID, Cells >::iterator citer = spaceCells_.begin();
+	while (citer != spaceCells_.end())
+	{
+		Cells& cells = citer->second;
+		if (!cells.removeCellapp(cid))
+		{
+			++citer;
+			continue;
+		}
+
+		if (cells.size() == 0)
+		{
+			spaceCells_.erase(citer++);
+			continue;
+		}
+
+		if (cells.originCellappID() == cid)
+			cells.originCellappID(cells.cells().begin()->second.cellappID());
+
+		broadcastSpaceCells((citer++)->first);
+	}
+
+	if (pendingSplitCellappID_ == cid)
+		pendingSplitCellappID_ = 0;
 }
 
 //-------------------------------------------------------------------------------------
@@ -178,6 +209,7 @@ void Cellappmgr::handleGameTick()
 	++g_kbetime;
 	threadPool_.onMainThreadTick();
 	networkInterface().processChannels(&CellappmgrInterface::messageHandlers);
+	updateSpacePartitions();
 }
 
 //-------------------------------------------------------------------------------------
@@ -585,17 +617,26 @@ void Cellappmgr::querySpaces(Network::Channel* pChannel, MemoryStream& s)
 			(*pBundle) << space.getGeomappingPath();
 			(*pBundle) << space.getScriptModuleName();
 
-			Cells& cells = space.cells();
-			std::map<CELL_ID, Cell>& allCells = cells.cells();
-			(*pBundle) << (uint32)allCells.size(); 
+			// spaceָʱֻгcellappcell
+			std::vector<CELL_ID> cellIDs;
+			std::map< SPACE_ID, Cells >::iterator citer = spaceCells_.find(space.id());
+			std::map<CELL_ID, Cell>& allCells = citer != spaceCells_.end() ? citer->second.cells() : space.cells().cells();
 
 			std::map<CELL_ID, Cell>::iterator iter3 = allCells.begin();
 			for (; iter3 != allCells.end(); ++iter3)
 			{
-				(*pBundle) << iter3->first;
+				if (citer != spaceCells_.end() && iter3->second.cellappID() != iter1->first)
+					continue;
 
-				// Ϣָʵֺ
-				// cellС״Ϣ
+				cellIDs.push_back(iter3->first);
+			}
+
+			(*pBundle) << (uint32)cellIDs.size(); 
+
+			std::vector<CELL_ID>::iterator iter4 = cellIDs.begin();
+			for (; iter4 != cellIDs.end(); ++iter4)
+			{
+				(*pBundle) << (*iter4);
 			}
 		}
 	}
@@ -625,6 +666,79 @@ void Cellappmgr::updateSpaceData(Network::Channel* pChannel, MemoryStream& s)
 	Cellapp& cellappref = iter->second;
 
 	cellappref.spaces().updateSpaceData(spaceID, scriptModuleName, geomappingPath, delspace);
+
+	if (!delspace)
+		return;
+
+	std::map< SPACE_ID, Cells >::iterator citer = spaceCells_.find(spaceID);
+	if (citer == spaceCells_.end())
+		return;
+
+	Cells& cells = citer->second;
+
+	// spacecellappspace cellappϵĲҲҪһ
+	if (cells.originCellappID() == componentID)
+	{
+		Cells emptyCells;
+
+		std::map<CELL_ID, Cell>::iterator iter1 = cells.cells().begin();
+		for (; iter1 != cells.cells().end(); ++iter1)
+		{
+			if (iter1->second.cellappID() != componentID)
+				sendSpaceCells(iter1->second.cellappID(), spaceID, emptyCells);
+		}
+
+		spaceCells_.erase(citer);
+		return;
+	}
+
+	if (cells.removeCellapp(componentID))
+		broadcastSpaceCells(spaceID);
+}
+
+//-------------------------------------------------------------------------------------
+void Cellappmgr::syncSpaceData(Network::Channel* pChannel, MemoryStream& s)
+{
+	COMPONENT_ID componentID;
+	SPACE_ID spaceID;
+	std::string key, value;
+	bool isdel = false;
+
+	s >> componentID >> spaceID >> key >> value >> isdel;
+
+	// spaceDataڴspacecellappļ¼ϣ űģͼӳһ𷢸µcell
+	std::map< SPACE_ID, Cells >::iterator citer = spaceCells_.find(spaceID);
+	COMPONENT_ID originCellappID = citer != spaceCells_.end() ? citer->second.originCellappID() : componentID;
+
+	std::map< COMPONENT_ID, Cellapp >::iterator iter = cellapps_.find(originCellappID);
+	Space* pSpace = iter != cellapps_.end() ? iter->second.spaces().getSpace(spaceID) : NULL;
+	if (pSpace)
+	{
+		if (isdel)
+			pSpace->spaceDatas().erase(key);
+		else
+			pSpace->spaceDatas()[key] = value;
+	}
+
+	if (citer == spaceCells_.end())
+		return;
+
+	// ͬһkeyڲͬcellͬʱ޸ʱ cellյ˳򸲸ǣ cellappmgrյֵ
+	std::map<CELL_ID, Cell>::iterator iter1 = citer->second.cells().begin();
+	for (; iter1 != citer->second.cells().end(); ++iter1)
+	{
+		if (iter1->second.cellappID() == componentID)
+			continue;
+
+		Components::ComponentInfos* cinfos = Components::getSingleton().findComponent(CELLAPP_TYPE, iter1->second.cellappID());
+		if (cinfos == NULL || cinfos->pChannel == NULL)
+			continue;
+
+		Network::Bundle* pBundle = Network::Bundle::createPoolObject(OBJECTPOOL_POINT);
+		(*pBundle).newMessage(CellappInterface::onSyncSpaceData);
+		(*pBundle) << spaceID << key << value << isdel;
+		cinfos->pChannel->send(pBundle);
+	}
 }
 
 //-------------------------------------------------------------------------------------
@@ -639,6 +753,200 @@ void Cellappmgr::setSpaceViewer(Network::Channel* pChannel, MemoryStream& s)
 	spaceViewers_.updateSpaceViewer(pChannel->addr(), spaceID, del);
 }
 
+//-------------------------------------------------------------------------------------
+void Cellappmgr::updateSpacePartitions()
+{
+	const ENGINE_COMPONENT_INFO& info = g_kbeSrvConfig.getCellAppMgr();
+	if (!info.spacePartition_enable)
+		return;
+
+	GAME_TIME period = (GAME_TIME)(info.spacePartition_balancePeriod * 50);
+	if (period == 0)
+		period = 1;
+
+	if (g_kbetime - lastPartitionTime_ < period)
+		return;
+
+	lastPartitionTime_ = g_kbetime;
+
+	std::map<COMPONENT_ID, float> loads;
+	std::map< COMPONENT_ID, Cellapp >::iterator iter = cellapps_.begin();
+	for (; iter != cellapps_.end(); ++iter)
+	{
+		if (iter->second.isDestroyed() || iter->second.initProgress() <= 1.f)
+			continue;
+
+		loads[iter->first] = iter->second.load();
+	}
+
+	// ѷָspaceı߽
+	std::map< SPACE_ID, Cells >::iterator citer = spaceCells_.begin();
+	for (; citer != spaceCells_.end(); ++citer)
+	{
+		if (citer->second.balance(loads, info.spacePartition_balanceStep, info.spacePartition_minCellSize))
+			broadcastSpaceCells(citer->first);
+	}
+
+	// һָδʱµ ʱΪʧ
+	if (pendingSplitCellappID_ > 0 && g_kbetime - pendingSplitTime_ < period * 10)
+		return;
+
+	pendingSplitCellappID_ = 0;
+
+	std::map<COMPONENT_ID, float>::iterator liter = loads.begin();
+	for (; liter != loads.end(); ++liter)
+	{
+		if (liter->second <= info.spacePartition_splitLoad)
+			continue;
+
+		if ((getCellapp(liter->first).flags() & APP_FLAGS_NOT_PARTCIPATING_LOAD_BALANCING) > 0)
+			continue;
+
+		COMPONENT_ID freeCellappID = findFreeCellapp();
+		if (freeCellappID == 0 || freeCellappID == liter->first)
+			continue;
+
+		if (getCellapp(freeCellappID).load() >= liter->second)
+			continue;
+
+		Components::ComponentInfos* cinfos = Components::getSingleton().findComponent(CELLAPP_TYPE, liter->first);
+		if (cinfos == NULL || cinfos->pChannel == NULL)
+			continue;
+
+		Network::Bundle* pBundle = Network::Bundle::createPoolObject(OBJECTPOOL_POINT);
+		(*pBundle).newMessage(CellappInterface::reqSplitSpaceCell);
+		(*pBundle) << ++lastCellID_ << freeCellappID;
+		cinfos->pChannel->send(pBundle);
+
+		INFO_MSG(fmt::format("Cellappmgr::updateSpacePartitions: cellapp({}) load={}, request split to cellapp({}).\n",
+			liter->first, liter->second, freeCellappID));
+
+		pendingSplitCellappID_ = liter->first;
+		pendingSplitTime_ = g_kbetime;
+		break;
+	}
+}
+
+//-------------------------------------------------------------------------------------
+void Cellappmgr::onSpaceCellSplit(Network::Channel* pChannel, MemoryStream& s)
+{
+	SPACE_ID spaceID;
+	COMPONENT_ID cellappID, newCellappID;
+	CELL_ID srcCellID, newCellID;
+	float pos;
+
+	s >> spaceID >> cellappID >> srcCellID >> newCellID >> newCellappID >> pos;
+
+	if (pendingSplitCellappID_ == cellappID)
+		pendingSplitCellappID_ = 0;
+
+	if (spaceID == 0)
+		return;
+
+	if (cellapps_.find(newCellappID) == cellapps_.end())
+	{
+		ERROR_MSG(fmt::format("Cellappmgr::onSpaceCellSplit: not found cellapp({}), space({})!\n",
+			newCellappID, spaceID));
+
+		return;
+	}
+
+	bool isNewLayout = false;
+	std::map< SPACE_ID, Cells >::iterator citer = spaceCells_.find(spaceID);
+	if (citer == spaceCells_.end())
+	{
+		// һηָ spaceɴcellapp
+		Cells& cells = spaceCells_[spaceID];
+		cells.originCellappID(cellappID);
+		cells.addCell(Cell(++lastCellID_, cellappID));
+
+		srcCellID = lastCellID_;
+		citer = spaceCells_.find(spaceID);
+		isNewLayout = true;
+	}
+	else if (srcCellID == 0)
+	{
+		Cell* pCell = citer->second.findCellByCellapp(cellappID);
+		if (pCell)
+			srcCellID = pCell->id();
+	}
+
+	if (!citer->second.split(srcCellID, newCellID, newCellappID, pos))
+	{
+		ERROR_MSG(fmt::format("Cellappmgr::onSpaceCellSplit: split space({}) cell({}) at {} error!\n",
+			spaceID, srcCellID, pos));
+
+		if (isNewLayout)
+			spaceCells_.erase(citer);
+
+		return;
+	}
+
+	INFO_MSG(fmt::format("Cellappmgr::onSpaceCellSplit: space({}) cell({}) split at x={}, new cell({}) on cellapp({}).\n",
+		spaceID, srcCellID, pos, newCellID, newCellappID));
+
+	broadcastSpaceCells(spaceID);
+}
+
+//-------------------------------------------------------------------------------------
+void Cellappmgr::broadcastSpaceCells(SPACE_ID spaceID)
+{
+	std::map< SPACE_ID, Cells >::iterator citer = spaceCells_.find(spaceID);
+	if (citer == spaceCells_.end())
+		return;
+
+	Cells& cells = citer->second;
+
+	std::map<CELL_ID, Cell>::iterator iter = cells.cells().begin();
+	for (; iter != cells.cells().end(); ++iter)
+		sendSpaceCells(iter->second.cellappID(), spaceID, cells);
+}
+
+//-------------------------------------------------------------------------------------
+void Cellappmgr::sendSpaceCells(COMPONENT_ID cellappID, SPACE_ID spaceID, Cells& cells)
+{
+	Components::ComponentInfos* cinfos = Components::getSingleton().findComponent(CELLAPP_TYPE, cellappID);
+	if (cinfos == NULL || cinfos->pChannel == NULL)
+		return;
+
+	// cellappҪôspaceʱĽűģͼӳԼĲ
+	std::string scriptModuleName, geomappingPath;
+
+	std::map< COMPONENT_ID, Cellapp >::iterator iter = cellapps_.find(cells.originCellappID());
+	Space* pSpace = iter != cellapps_.end() ? iter->second.spaces().getSpace(spaceID) : NULL;
+	if (pSpace)
+	{
+		scriptModuleName = pSpace->getScriptModuleName();
+		geomappingPath = pSpace->getGeomappingPath();
+	}
+
+	Network::Bundle* pBundle = Network::Bundle::createPoolObject(OBJECTPOOL_POINT);
+	(*pBundle).newMessage(CellappInterface::onUpdateSpaceCells);
+	(*pBundle) << spaceID << scriptModuleName << geomappingPath;
+
+	// ¼cellappʼspaceData ֮޸syncSpaceDataͬһͨ˳ת
+	if (pSpace && cells.size() > 0)
+	{
+		std::map<std::string, std::string>& spaceDatas = pSpace->spaceDatas();
+		(*pBundle) << (uint32)spaceDatas.size();
+
+		std::map<std::string, std::string>::iterator diter = spaceDatas.begin();
+		for (; diter != spaceDatas.end(); ++diter)
+			(*pBundle) << diter->first << diter->second;
+	}
+	else
+	{
+		(*pBundle) << (uint32)0;
+	}
+
+	MemoryStream* s = MemoryStream::createPoolObject(OBJECTPOOL_POINT);
+	cells.addToStream(*s);
+	(*pBundle).append(s);
+	MemoryStream::reclaimPoolObject(s);
+
+	cinfos->pChannel->send(pBundle);
+}
+
 //-------------------------------------------------------------------------------------
 
 }
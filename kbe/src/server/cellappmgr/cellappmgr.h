@@ -108,12 +108,33 @@ public:
 	*/
 	void updateSpaceData(Network::Channel* pChannel, MemoryStream& s);
 
+	/** ӿ
+	cellappϵspace޸spaceData µcellʱʹã תspacecell
+	*/
+	void syncSpaceData(Network::Channel* pChannel, MemoryStream& s);
+
 	/** ӿ
 	ıspace鿴Ӻɾܣ
 	²ҷϲڸõַĲ鿴ԶɾȷɾҪ
 	*/
 	void setSpaceViewer(Network::Channel* pChannel, MemoryStream& s);
 
+	/** ӿ
+	cellappreqSplitSpaceCell spaceIDΪ0ʾûпɷָspace
+	*/
+	void onSpaceCellSplit(Network::Channel* pChannel, MemoryStream& s);
+
+	/**
+	Եĵָspacecell߽磬 Ϊصcellappָspace
+	*/
+	void updateSpacePartitions();
+
+	/**
+	spacecellͬеcellapp
+	*/
+	void broadcastSpaceCells(SPACE_ID spaceID);
+	void sendSpaceCells(COMPONENT_ID cellappID, SPACE_ID spaceID, Cells& cells);
+
 protected:
 	TimerHandle							gameTimer_;
 	ForwardAnywhere_MessageBuffer		forward_anywhere_cellapp_messagebuffer_;
@@ -126,6 +147,16 @@ protected:
 
 	// ߲ͨ鿴space
 	SpaceViewers						spaceViewers_;
+
+	// ָcellappϵspacecell
+	std::map< SPACE_ID, Cells >			spaceCells_;
+	CELL_ID								lastCellID_;
+
+	GAME_TIME							lastPartitionTime_;
+
+	// ͬһʱֻһָ cellappͬʱѸתƵͬһн
+	COMPONENT_ID						pendingSplitCellappID_;
+	GAME_TIME							pendingSplitTime_;
 };
 
 } 
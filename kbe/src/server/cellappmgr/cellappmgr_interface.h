@@ -97,9 +97,15 @@ NETWORK_INTERFACE_DECLARE_BEGIN(CellappmgrInterface)
 	// ָspaceһЩϢ
 	CELLAPPMGR_MESSAGE_DECLARE_STREAM(updateSpaceData,						NETWORK_VARIABLE_MESSAGE)
 
+	// cellappϵspace޸spaceData(APIĵеspaceData) cellappmgr沢תspacecell
+	CELLAPPMGR_MESSAGE_DECLARE_STREAM(syncSpaceData,						NETWORK_VARIABLE_MESSAGE)
+
 	// ıspace鿴Ӻɾܣ
 	CELLAPPMGR_MESSAGE_DECLARE_STREAM(setSpaceViewer,						NETWORK_VARIABLE_MESSAGE)
 
+	// cellappһspaceָ
+	CELLAPPMGR_MESSAGE_DECLARE_STREAM(onSpaceCellSplit,						NETWORK_VARIABLE_MESSAGE)
+
 NETWORK_INTERFACE_DECLARE_END()
 
 #ifdef DEFINE_IN_INTERFACE
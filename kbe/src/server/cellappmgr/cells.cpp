@@ -1,14 +1,20 @@
 // Copyright 2008-2018 Yolo Technologies, Inc. All Rights Reserved. https://www.comblockengine.com
 
-#include "cells.h"	
-#include "helper/profile.h"	
+#include "cells.h"
+#include "helper/profile.h"
+#include "common/memorystream.h"
 
-namespace KBEngine{	
+namespace KBEngine{
 
+static bool cellMinXLess(const Cell* a, const Cell* b)
+{
+	return a->minX() < b->minX();
+}
 
 //-------------------------------------------------------------------------------------
 Cells::Cells():
-cells_()
+cells_(),
+originCellappID_(0)
 {
 }
 
@@ -18,5 +24,159 @@ Cells::~Cells()
 	cells_.clear();
 }
 
+//-------------------------------------------------------------------------------------
+Cell* Cells::findCell(CELL_ID id)
+{
+	std::map<CELL_ID, Cell>::iterator iter = cells_.find(id);
+	if (iter == cells_.end())
+		return NULL;
+
+	return &iter->second;
+}
+
+//-------------------------------------------------------------------------------------
+Cell* Cells::findCellByCellapp(COMPONENT_ID cellappID)
+{
+	std::map<CELL_ID, Cell>::iterator iter = cells_.begin();
+	for (; iter != cells_.end(); ++iter)
+	{
+		if (iter->second.cellappID() == cellappID)
+			return &iter->second;
+	}
+
+	return NULL;
+}
+
+//-------------------------------------------------------------------------------------
+void Cells::addCell(const Cell& cell)
+{
+	cells_[cell.id()] = cell;
+}
+
+//-------------------------------------------------------------------------------------
+void Cells::getSortedCells(std::vector<Cell*>& sortedCells)
+{
+	sortedCells.clear();
+
+	std::map<CELL_ID, Cell>::iterator iter = cells_.begin();
+	for (; iter != cells_.end(); ++iter)
+		sortedCells.push_back(&iter->second);
+
+	std::sort(sortedCells.begin(), sortedCells.end(), cellMinXLess);
+}
+
+//-------------------------------------------------------------------------------------
+bool Cells::split(CELL_ID srcID, CELL_ID newID, COMPONENT_ID newCellappID, float pos)
+{
+	Cell* pSrcCell = findCell(srcID);
+	if (pSrcCell == NULL || findCell(newID) != NULL)
+		return false;
+
+	if (pos <= pSrcCell->minX() || pos >= pSrcCell->maxX())
+		return false;
+
+	Cell newCell(newID, newCellappID, pos, pSrcCell->maxX());
+	pSrcCell->maxX(pos);
+	addCell(newCell);
+	return true;
+}
+
+//-------------------------------------------------------------------------------------
+bool Cells::removeCellapp(COMPONENT_ID cellappID)
+{
+	Cell* pCell = findCellByCellapp(cellappID);
+	if (pCell == NULL)
+		return false;
+
+	std::vector<Cell*> sortedCells;
+	getSortedCells(sortedCells);
+
+	for (size_t i = 0; i < sortedCells.size(); ++i)
+	{
+		if (sortedCells[i] != pCell)
+			continue;
+
+		if (i > 0)
+			sortedCells[i - 1]->maxX(pCell->maxX());
+		else if (i + 1 < sortedCells.size())
+			sortedCells[i + 1]->minX(pCell->minX());
+
+		break;
+	}
+
+	cells_.erase(pCell->id());
+	return true;
+}
+
+//-------------------------------------------------------------------------------------
+bool Cells::balance(const std::map<COMPONENT_ID, float>& loads, float step, float minCellSize)
+{
+	if (cells_.size() < 2 || step <= 0.f)
+		return false;
+
+	std::vector<Cell*> sortedCells;
+	getSortedCells(sortedCells);
+
+	bool changed = false;
+
+	for (size_t i = 0; i + 1 < sortedCells.size(); ++i)
+	{
+		Cell* pLeft = sortedCells[i];
+		Cell* pRight = sortedCells[i + 1];
+
+		std::map<COMPONENT_ID, float>::const_iterator liter = loads.find(pLeft->cellappID());
+		std::map<COMPONENT_ID, float>::const_iterator riter = loads.find(pRight->cellappID());
+		if (liter == loads.end() || riter == loads.end())
+			continue;
+
+		// ز̫Сʱƶ߽磬 ߽ض
+		float diff = liter->second - riter->second;
+		if (fabs(diff) < 0.05f)
+			continue;
+
+		float offset = step * std::min(fabs(diff), 1.f);
+		float boundary = pLeft->maxX();
+
+		if (diff > 0.f)
+		{
+			boundary -= offset;
+
+			if (pLeft->minX() > -FLT_MAX && boundary < pLeft->minX() + minCellSize)
+				boundary = pLeft->minX() + minCellSize;
+		}
+		else
+		{
+			boundary += offset;
+
+			if (pRight->maxX() < FLT_MAX && boundary > pRight->maxX() - minCellSize)
+				boundary = pRight->maxX() - minCellSize;
+		}
+
+		if (boundary == pLeft->maxX() || boundary <= pLeft->minX() || boundary >= pRight->maxX())
+			continue;
+
+		pLeft->maxX(boundary);
+		pRight->minX(boundary);
+		changed = true;
+	}
+
+	return changed;
+}
+
+//-------------------------------------------------------------------------------------
+void Cells::addToStream(MemoryStream& s)
+{
+	std::vector<Cell*> sortedCells;
+	getSortedCells(sortedCells);
+
+	s << (uint32)sortedCells.size();
+
+	std::vector<Cell*>::iterator iter = sortedCells.begin();
+	for (; iter != sortedCells.end(); ++iter)
+	{
+		s << (*iter)->id() << (*iter)->cellappID() << (*iter)->minX() << (*iter)->maxX();
+	}
+}
+
 //-------------------------------------------------------------------------------------
 }
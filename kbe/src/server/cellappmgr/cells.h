@@ -11,6 +11,11 @@
 
 namespace KBEngine{
 
+class MemoryStream;
+
+/**
+	һspacecell֣ cellxгɻص
+*/
 class Cells
 {
 public:
@@ -21,8 +26,40 @@ public:
 		return cells_;
 	}
 
+	size_t size() const{ return cells_.size(); }
+
+	// spacecellapp ֻspaceʱֲŻᱻ
+	COMPONENT_ID originCellappID() const{ return originCellappID_; }
+	void originCellappID(COMPONENT_ID cid){ originCellappID_ = cid; }
+
+	Cell* findCell(CELL_ID id);
+	Cell* findCellByCellapp(COMPONENT_ID cellappID);
+
+	void addCell(const Cell& cell);
+
+	/**
+		srcIDcellposһΪ Ұ벿ֽnewCellappIDϵcell
+	*/
+	bool split(CELL_ID srcID, CELL_ID newID, COMPONENT_ID newCellappID, float pos);
+
+	/**
+		Ƴĳcellappϵcell ䷶Χڵcell
+	*/
+	bool removeCellapp(COMPONENT_ID cellappID);
+
+	/**
+		ݸcellappĸƶcellı߽磬
+		ظߵһС ÿƶstep ޿ȵcellСminCellSize
+	*/
+	bool balance(const std::map<COMPONENT_ID, float>& loads, float step, float minCellSize);
+
+	void addToStream(MemoryStream& s);
+
 private:
+	void getSortedCells(std::vector<Cell*>& sortedCells);
+
 	std::map<CELL_ID, Cell> cells_;
+	COMPONENT_ID originCellappID_;
 };
 
 }
@@ -11,7 +11,8 @@ Space::Space() :
 spaceID_(0),
 cells_(),
 geomappingPath_(),
-scriptModuleName_()
+scriptModuleName_(),
+spaceDatas_()
 {
 }
 
@@ -27,12 +27,17 @@ public:
 
 	Cells& cells() { return cells_; }
 
+	std::map<std::string, std::string>& spaceDatas() { return spaceDatas_; }
+
 private:
 	SPACE_ID spaceID_;
 	Cells cells_;
 
 	std::string geomappingPath_;
 	std::string scriptModuleName_;
+
+	// űõspaceData(_mapping) spaceָʱƸµcell
+	std::map<std::string, std::string> spaceDatas_;
 };
 
 }
@@ -12,14 +12,24 @@ namespace KBEngine{
 Buffered_DBTasks::Buffered_DBTasks():
 dbid_tasks_(),
 entityid_tasks_(),
+writeBatches_(),
+pLoginBatch_(NULL),
 mutex_(),
-dbInterfaceName_()
+dbInterfaceName_(),
+entityCache_()
 {
 }
 
 //-------------------------------------------------------------------------------------
 Buffered_DBTasks::~Buffered_DBTasks()
 {
+	WRITE_BATCHES::iterator iter = writeBatches_.begin();
+	for(; iter != writeBatches_.end(); ++iter)
+		delete iter->second;
+
+	writeBatches_.clear();
+
+	SAFE_RELEASE(pLoginBatch_);
 }
 
 //-------------------------------------------------------------------------------------
@@ -85,6 +95,102 @@ void Buffered_DBTasks::addTask(EntityDBTask* pTask)
 	DBUtil::pThreadPool(dbInterfaceName_)->addTask(pTask);
 }
 
+//-------------------------------------------------------------------------------------
+void Buffered_DBTasks::addWriteTask(DBTaskWriteEntity* pTask)
+{
+	// ½entityҪȲdbid ϲ
+	if(!g_kbeSrvConfig.getDBMgr().writeBatch_enable || pTask->EntityDBTask_entityDBID() <= 0)
+	{
+		addTask(pTask);
+		return;
+	}
+
+	mutex_.lockMutex();
+	pTask->pBuffered_DBTasks(this);
+
+	// ͬһdbidϻδɵ ŶӵȴԱ֤д˳
+	if(hasTask_(pTask->EntityDBTask_entityDBID()))
+	{
+		dbid_tasks_.insert(std::make_pair(pTask->EntityDBTask_entityDBID(), static_cast<EntityDBTask *>(pTask)));
+		mutex_.unlockMutex();
+		return;
+	}
+
+	dbid_tasks_.insert(std::make_pair(pTask->EntityDBTask_entityDBID(), 
+		static_cast<EntityDBTask *>(NULL)));
+
+	mutex_.unlockMutex();
+
+	DBTaskWriteEntities*& pBatch = writeBatches_[pTask->sid()];
+	if(pBatch == NULL)
+		pBatch = new DBTaskWriteEntities(this, pTask->sid());
+
+	pBatch->addTask(pTask);
+
+	if(pBatch->size() >= g_kbeSrvConfig.getDBMgr().writeBatch_maxSize)
+	{
+		DBTaskWriteEntities* pFullBatch = pBatch;
+		writeBatches_.erase(pTask->sid());
+		DBUtil::pThreadPool(dbInterfaceName_)->addTask(pFullBatch);
+	}
+}
+
+//-------------------------------------------------------------------------------------
+void Buffered_DBTasks::flushWriteBatches(bool force)
+{
+	if(writeBatches_.size() == 0)
+		return;
+
+	uint64 window = (uint64)g_kbeSrvConfig.getDBMgr().writeBatch_window * stampsPerSecond() / 1000;
+	uint64 now = timestamp();
+
+	WRITE_BATCHES::iterator iter = writeBatches_.begin();
+	while(iter != writeBatches_.end())
+	{
+		if(force || now - iter->second->initTime() >= window)
+		{
+			DBUtil::pThreadPool(dbInterfaceName_)->addTask(iter->second);
+			writeBatches_.erase(iter++);
+		}
+		else
+		{
+			++iter;
+		}
+	}
+}
+
+//-------------------------------------------------------------------------------------
+void Buffered_DBTasks::addLoginTask(DBTaskAccountLogin* pTask)
+{
+	if(!g_kbeSrvConfig.getDBMgr().loginBatch_enable)
+	{
+		DBUtil::pThreadPool(dbInterfaceName_)->addTask(pTask);
+		return;
+	}
+
+	if(pLoginBatch_ == NULL)
+		pLoginBatch_ = new DBTaskAccountLogins();
+
+	pLoginBatch_->addTask(pTask);
+
+	if(pLoginBatch_->size() >= g_kbeSrvConfig.getDBMgr().loginBatch_maxSize)
+		flushLoginBatch(true);
+}
+
+//-------------------------------------------------------------------------------------
+void Buffered_DBTasks::flushLoginBatch(bool force)
+{
+	if(pLoginBatch_ == NULL)
+		return;
+
+	uint64 window = (uint64)g_kbeSrvConfig.getDBMgr().loginBatch_window * stampsPerSecond() / 1000;
+	if(!force && timestamp() - pLoginBatch_->initTime() < window)
+		return;
+
+	DBUtil::pThreadPool(dbInterfaceName_)->addTask(pLoginBatch_);
+	pLoginBatch_ = NULL;
+}
+
 //-------------------------------------------------------------------------------------
 EntityDBTask* Buffered_DBTasks::tryGetNextTask(EntityDBTask* pTask)
 {
@@ -6,6 +6,7 @@
 // common include	
 // #define NDEBUG
 #include "dbtasks.h"
+#include "entity_cache.h"
 #include "common/common.h"
 #include "common/memorystream.h"
 #include "thread/threadtask.h"
@@ -28,6 +29,26 @@ public:
 	
 	void addTask(EntityDBTask* pTask);
 
+	/**
+		дentity ϲдʱͬһentityĸڴںϲһDBTaskWriteEntities
+	*/
+	void addWriteTask(DBTaskWriteEntity* pTask);
+
+	/**
+		Ͷݵȴʱ䳬ڵĺϲд forceΪtrueʱȫͶ
+	*/
+	void flushWriteBatches(bool force);
+
+	/**
+		˺ŵ¼ ϲ¼ѯʱһʱڵĵ¼ϲһDBTaskAccountLogins
+	*/
+	void addLoginTask(DBTaskAccountLogin* pTask);
+
+	/**
+		Ͷݵȴʱ䳬ڵĺϲ¼ѯ forceΪtrueʱͶ
+	*/
+	void flushLoginBatch(bool force);
+
 	EntityDBTask* tryGetNextTask(EntityDBTask* pTask);
 
 	size_t size() { return dbid_tasks_.size() + entityid_tasks_.size(); }
@@ -88,6 +109,8 @@ public:
 	void dbInterfaceName(const std::string& dbInterfaceName) { dbInterfaceName_ = dbInterfaceName; }
 	const std::string& dbInterfaceName() { return dbInterfaceName_; }
 
+	EntityCache& entityCache() { return entityCache_; }
+
 	/**
 		ṩwatcherʹ
 	*/
@@ -125,9 +148,19 @@ protected:
 	DBID_TASKS_MAP dbid_tasks_;
 	ENTITYID_TASKS_MAP entityid_tasks_;
 
+	// ռеĺϲд ֻ߳з
+	typedef std::map<ENTITY_SCRIPT_UID, DBTaskWriteEntities*> WRITE_BATCHES;
+	WRITE_BATCHES writeBatches_;
+
+	// ռеĺϲ¼ѯ ֻ߳з
+	DBTaskAccountLogins* pLoginBatch_;
+
 	KBEngine::thread::ThreadMutex mutex_;
 
 	std::string dbInterfaceName_;
+
+	// ݿӿȡentity
+	EntityCache entityCache_;
 };
 
 }
@@ -151,6 +151,8 @@ void Dbmgr::onShutdownBegin()
 {
 	PythonApp::onShutdownBegin();
 
+	flushWriteBatches(true);
+
 	// ֪ͨű
 	SCOPED_PROFILE(SCRIPTCALL_PROFILE);
 	SCRIPT_OBJECT_CALL_ARGS0(getEntryScript().get(), const_cast<char*>("onDBMgrShutDown"), false);
@@ -162,6 +164,18 @@ void Dbmgr::onShutdownEnd()
 	PythonApp::onShutdownEnd();
 }
 
+//-------------------------------------------------------------------------------------
+static float writeBatchRowsPerStatement()
+{
+	return g_numBatchStatements > 0 ? (float)g_numBatchedWrites / (float)g_numBatchStatements : 0.f;
+}
+
+//-------------------------------------------------------------------------------------
+static float loginBatchLoginsPerBatch()
+{
+	return g_numLoginBatches > 0 ? (float)g_numBatchedLogins / (float)g_numLoginBatches : 0.f;
+}
+
 //-------------------------------------------------------------------------------------
 bool Dbmgr::initializeWatcher()
 {
@@ -178,8 +192,28 @@ bool Dbmgr::initializeWatcher()
 		WATCH_OBJECT(fmt::format("DBThreadPool/{}/entityid_tasksSize", bditer->first).c_str(), &bditer->second, &Buffered_DBTasks::entityid_tasksSize);
 		WATCH_OBJECT(fmt::format("DBThreadPool/{}/printBuffered_dbid", bditer->first).c_str(), &bditer->second, &Buffered_DBTasks::printBuffered_dbid);
 		WATCH_OBJECT(fmt::format("DBThreadPool/{}/printBuffered_entityID", bditer->first).c_str(), &bditer->second, &Buffered_DBTasks::printBuffered_entityID);
+
+		EntityCache* pEntityCache = &bditer->second.entityCache();
+		WATCH_OBJECT(fmt::format("entityCache/{}/hits", bditer->first).c_str(), pEntityCache, &EntityCache::hits);
+		WATCH_OBJECT(fmt::format("entityCache/{}/misses", bditer->first).c_str(), pEntityCache, &EntityCache::misses);
+		WATCH_OBJECT(fmt::format("entityCache/{}/hitRate", bditer->first).c_str(), pEntityCache, &EntityCache::hitRate);
+		WATCH_OBJECT(fmt::format("entityCache/{}/entities", bditer->first).c_str(), pEntityCache, &EntityCache::numEntities);
+		WATCH_OBJECT(fmt::format("entityCache/{}/memory", bditer->first).c_str(), pEntityCache, &EntityCache::memory);
+		WATCH_OBJECT(fmt::format("entityCache/{}/evictions", bditer->first).c_str(), pEntityCache, &EntityCache::evictions);
+		WATCH_OBJECT(fmt::format("entityCache/{}/invalidations", bditer->first).c_str(), pEntityCache, &EntityCache::invalidations);
+		WATCH_OBJECT(fmt::format("entityCache/{}/stalePuts", bditer->first).c_str(), pEntityCache, &EntityCache::stalePuts);
 	}
 
+	WATCH_OBJECT("writeBatch/batches", g_numWriteBatches);
+	WATCH_OBJECT("writeBatch/rows", g_numBatchedWrites);
+	WATCH_OBJECT("writeBatch/statements", g_numBatchStatements);
+	WATCH_OBJECT("writeBatch/rowsPerStatement", &writeBatchRowsPerStatement);
+
+	WATCH_OBJECT("loginBatch/batches", g_numLoginBatches);
+	WATCH_OBJECT("loginBatch/logins", g_numBatchedLogins);
+	WATCH_OBJECT("loginBatch/accountHits", g_numBatchedAccountHits);
+	WATCH_OBJECT("loginBatch/loginsPerBatch", &loginBatchLoginsPerBatch);
+
 	return ServerApp::initializeWatcher() && DBUtil::initializeWatcher();
 }
 
@@ -219,6 +253,18 @@ void Dbmgr::handleMainTick()
 	threadPool_.onMainThreadTick();
 	DBUtil::handleMainTick();
 	networkInterface().processChannels(&DbmgrInterface::messageHandlers);
+	flushWriteBatches(false);
+}
+
+//-------------------------------------------------------------------------------------
+void Dbmgr::flushWriteBatches(bool force)
+{
+	KBEUnordered_map<std::string, Buffered_DBTasks>::iterator bditer = bufferedDBTasksMaps_.begin();
+	for (; bditer != bufferedDBTasksMaps_.end(); ++bditer)
+	{
+		bditer->second.flushWriteBatches(force);
+		bditer->second.flushLoginBatch(force);
+	}
 }
 
 //-------------------------------------------------------------------------------------
@@ -435,6 +481,19 @@ bool Dbmgr::initDB()
 		bufferedDBTasksMaps_.insert(std::make_pair((*dbinfo_iter).name, buffered_DBTasks));
 		BUFFERED_DBTASKS_MAP::iterator buffered_DBTasks_iter = bufferedDBTasksMaps_.find((*dbinfo_iter).name);
 		buffered_DBTasks_iter->second.dbInterfaceName((*dbinfo_iter).name);
+
+		if (g_kbeSrvConfig.getDBMgr().entityCache_enable)
+		{
+			// ݿʱĴ浵ʹʧЧ
+			if (g_kbeSrvConfig.getDBMgr().isShareDB)
+			{
+				WARNING_MSG(fmt::format("Dbmgr::initDB(): entityCache is disabled on shared database({})!\n", (*dbinfo_iter).name));
+			}
+			else
+			{
+				buffered_DBTasks_iter->second.entityCache().maxMemory((size_t)g_kbeSrvConfig.getDBMgr().entityCache_maxMemory * 1024 * 1024);
+			}
+		}
 	}
 
 	for (dbinfo_iter = dbcfg.dbInterfaceInfos.begin(); dbinfo_iter != dbcfg.dbInterfaceInfos.end(); ++dbinfo_iter)
@@ -1059,9 +1118,15 @@ void Dbmgr::writeEntity(Network::Channel* pChannel,
 		return;
 	}
 
-	pBuffered_DBTasks->addTask(new DBTaskWriteEntity(pChannel->addr(), componentID, eid, entityDBID, s));
+	DBTaskWriteEntity* pTask = new DBTaskWriteEntity(pChannel->addr(), componentID, eid, entityDBID, s);
 	s.done();
 
+	// ͶʱʹʧЧ дǰ񲻻
+	if(entityDBID > 0 && pBuffered_DBTasks->entityCache().enabled())
+		pBuffered_DBTasks->entityCache().beginWrite(pTask->sid(), entityDBID);
+
+	pBuffered_DBTasks->addWriteTask(pTask);
+
 	++numWrittenEntity_;
 }
 
@@ -1084,11 +1149,16 @@ void Dbmgr::removeEntity(Network::Channel* pChannel, KBEngine::MemoryStream& s)
 		return;
 	}
 
-	pBuffered_DBTasks->addTask(new DBTaskRemoveEntity(pChannel->addr(),
-		componentID, eid, entityDBID, s));
+	DBTaskRemoveEntity* pTask = new DBTaskRemoveEntity(pChannel->addr(),
+		componentID, eid, entityDBID, s);
 
 	s.done();
 
+	if(pBuffered_DBTasks->entityCache().enabled())
+		pBuffered_DBTasks->entityCache().beginWrite(pTask->sid(), entityDBID);
+
+	pBuffered_DBTasks->addTask(pTask);
+
 	++numRemovedEntity_;
 }
 
@@ -1119,7 +1189,12 @@ void Dbmgr::deleteEntityByDBID(Network::Channel* pChannel, KBEngine::MemoryStrea
 	s >> dbInterfaceIndex >> componentID >> entityDBID >> callbackID >> sid;
 	KBE_ASSERT(entityDBID > 0);
 
-	DBUtil::pThreadPool(g_kbeSrvConfig.dbInterfaceIndex2dbInterfaceName(dbInterfaceIndex))->
+	const std::string& dbInterfaceName = g_kbeSrvConfig.dbInterfaceIndex2dbInterfaceName(dbInterfaceIndex);
+	Buffered_DBTasks* pBuffered_DBTasks = findBufferedDBTask(dbInterfaceName);
+	if(pBuffered_DBTasks && pBuffered_DBTasks->entityCache().enabled())
+		pBuffered_DBTasks->entityCache().beginWrite(sid, entityDBID);
+
+	DBUtil::pThreadPool(dbInterfaceName)->
 		addTask(new DBTaskDeleteEntityByDBID(pChannel->addr(), componentID, entityDBID, callbackID, sid));
 }
 
@@ -52,6 +52,9 @@ public:
 	void handleMainTick();
 	void handleCheckStatusTick();
 
+	/* Ͷݵȴеĺϲд */
+	void flushWriteBatches(bool force);
+
 	/* ʼؽӿ */
 	bool initializeBegin();
 	bool inInitialize();
@@ -3,6 +3,7 @@
 #include "dbtasks.h"
 #include "dbmgr.h"
 #include "buffered_dbtasks.h"
+#include "profile.h"
 #include "network/common.h"
 #include "network/message_handler.h"
 #include "thread/threadpool.h"
@@ -35,6 +36,79 @@
 
 namespace KBEngine{
 
+//-------------------------------------------------------------------------------------
+static EntityCache* findEntityCache(DBInterface* pdbi)
+{
+	Buffered_DBTasks* pBuffered_DBTasks = Dbmgr::getSingleton().findBufferedDBTask(pdbi->name());
+	if(pBuffered_DBTasks == NULL || !pBuffered_DBTasks->entityCache().enabled())
+		return NULL;
+
+	return &pBuffered_DBTasks->entityCache();
+}
+
+//-------------------------------------------------------------------------------------
+static bool queryEntityCached(DBInterface* pdbi, DBID dbid, MemoryStream* s, ScriptDefModule* pModule)
+{
+	EntityTables& entityTables = EntityTables::findByInterfaceName(pdbi->name());
+
+	EntityCache* pEntityCache = findEntityCache(pdbi);
+	if(pEntityCache == NULL)
+		return entityTables.queryEntity(pdbi, dbid, s, pModule);
+
+	if(pEntityCache->find(pModule->getUType(), dbid, *s))
+		return true;
+
+	uint64 readSerial = pEntityCache->serial();
+	size_t wpos = s->wpos();
+
+	if(!entityTables.queryEntity(pdbi, dbid, s, pModule))
+		return false;
+
+	pEntityCache->put(pModule->getUType(), dbid, s->data() + wpos, s->wpos() - wpos, readSerial);
+	return true;
+}
+
+//-------------------------------------------------------------------------------------
+static void endEntityCacheWrite(DBInterface* pdbi, ENTITY_SCRIPT_UID sid, DBID dbid)
+{
+	// DbmgrͶʱbeginWriteӦ ½entityûл
+	if(dbid <= 0)
+		return;
+
+	EntityCache* pEntityCache = findEntityCache(pdbi);
+	if(pEntityCache)
+		pEntityCache->endWrite(sid, dbid);
+}
+
+//-------------------------------------------------------------------------------------
+static bool isReadOnlySql(const std::string& sql)
+{
+	size_t start = sql.find_first_not_of(" \t\r\n(");
+	if(start == std::string::npos)
+		return true;
+
+	// ʱж
+	size_t end = sql.find_last_not_of(" \t\r\n;");
+	size_t pos = sql.find(';', start);
+	if(pos != std::string::npos && pos < end)
+		return false;
+
+	size_t opend = sql.find_first_of(" \t\r\n(", start);
+	std::string op = sql.substr(start, opend == std::string::npos ? std::string::npos : opend - start);
+	std::transform(op.begin(), op.end(), op.begin(), tolower);
+
+	return op == "select" || op == "show" || op == "desc" || op == "describe" || op == "explain";
+}
+
+//-------------------------------------------------------------------------------------
+static void onExecuteRawDatabaseCommand(DBInterface* pdbi, const std::string& sql)
+{
+	// ޷ȷ޸Щentity ջ
+	EntityCache* pEntityCache = findEntityCache(pdbi);
+	if(pEntityCache && !isReadOnlySql(sql))
+		pEntityCache->clear();
+}
+
 //-------------------------------------------------------------------------------------
 DBTask::DBTask(const Network::Address& addr, MemoryStream& datas):
 DBTaskBase(),
@@ -125,6 +199,7 @@ bool DBTaskExecuteRawDatabaseCommand::db_thread_process()
 		error_ = e.what();
 	}
 
+	onExecuteRawDatabaseCommand(pdbi_, sdatas_);
 	return false;
 }
 
@@ -173,6 +248,7 @@ bool DBTaskExecuteRawDatabaseCommandByEntity::db_thread_process()
 		error_ = e.what();
 	}
 
+	onExecuteRawDatabaseCommand(pdbi_, sdatas_);
 	return false;
 }
 
@@ -317,6 +393,8 @@ callbackID_(0),
 shouldAutoLoad_(-1),
 success_(false)
 {
+	// ߳нʵͣ ԱBuffered_DBTasksͺϲд
+	(*pDatas_) >> sid_ >> callbackID_ >> shouldAutoLoad_;
 }
 
 //-------------------------------------------------------------------------------------
@@ -327,8 +405,6 @@ DBTaskWriteEntity::~DBTaskWriteEntity()
 //-------------------------------------------------------------------------------------
 bool DBTaskWriteEntity::db_thread_process()
 {
-	(*pDatas_) >> sid_ >> callbackID_ >> shouldAutoLoad_;
-
 	ScriptDefModule* pModule = EntityDef::findScriptModule(sid_);
 	bool writeEntityLog = (entityDBID_ == 0);
 
@@ -351,9 +427,12 @@ bool DBTaskWriteEntity::db_thread_process()
 
 	EntityTables& entityTables = EntityTables::findByInterfaceName(pdbi_->name());
 
+	DBID dbid = entityDBID_;
 	entityDBID_ = entityTables.writeEntity(pdbi_, entityDBID_, shouldAutoLoad_, pDatas_, pModule);
 	success_ = entityDBID_ > 0;
 
+	endEntityCacheWrite(pdbi_, sid_, dbid);
+
 	if(writeEntityLog && success_)
 	{
 		success_ = false;
@@ -396,6 +475,93 @@ thread::TPTask::TPTaskState DBTaskWriteEntity::presentMainThread()
 	return EntityDBTask::presentMainThread();
 }
 
+//-------------------------------------------------------------------------------------
+DBTaskWriteEntities::DBTaskWriteEntities(Buffered_DBTasks* pBuffered_DBTasks, ENTITY_SCRIPT_UID sid):
+DBTask(),
+pBuffered_DBTasks_(pBuffered_DBTasks),
+sid_(sid),
+tasks_(),
+numStatements_(0)
+{
+}
+
+//-------------------------------------------------------------------------------------
+DBTaskWriteEntities::~DBTaskWriteEntities()
+{
+	std::vector<DBTaskWriteEntity*>::iterator iter = tasks_.begin();
+	for(; iter != tasks_.end(); ++iter)
+		delete (*iter);
+
+	tasks_.clear();
+}
+
+//-------------------------------------------------------------------------------------
+void DBTaskWriteEntities::addTask(DBTaskWriteEntity* pTask)
+{
+	KBE_ASSERT(pTask->sid() == sid_);
+	tasks_.push_back(pTask);
+}
+
+//-------------------------------------------------------------------------------------
+bool DBTaskWriteEntities::db_thread_process()
+{
+	ScriptDefModule* pModule = EntityDef::findScriptModule(sid_);
+
+	ENTITY_WRITE_INFOS infos;
+	infos.reserve(tasks_.size());
+
+	std::vector<DBTaskWriteEntity*>::iterator iter = tasks_.begin();
+	for(; iter != tasks_.end(); ++iter)
+	{
+		DBTaskWriteEntity* pTask = (*iter);
+		pTask->pdbi(pdbi_);
+
+		EntityWriteInfo info;
+		info.dbid = pTask->entityDBID_;
+		info.shouldAutoLoad = pTask->shouldAutoLoad_;
+		info.s = pTask->pDatas_;
+		infos.push_back(info);
+	}
+
+	EntityTables& entityTables = EntityTables::findByInterfaceName(pdbi_->name());
+	numStatements_ = entityTables.writeEntities(pdbi_, infos, pModule);
+
+	for(size_t i = 0; i < tasks_.size(); ++i)
+	{
+		endEntityCacheWrite(pdbi_, sid_, tasks_[i]->entityDBID_);
+
+		tasks_[i]->entityDBID_ = infos[i].dbid;
+		tasks_[i]->success_ = infos[i].dbid > 0;
+	}
+
+	return false;
+}
+
+//-------------------------------------------------------------------------------------
+thread::TPTask::TPTaskState DBTaskWriteEntities::presentMainThread()
+{
+	++g_numWriteBatches;
+	g_numBatchedWrites += tasks_.size();
+	g_numBatchStatements += numStatements_;
+
+	std::vector<DBTaskWriteEntity*>::iterator iter = tasks_.begin();
+	for(; iter != tasks_.end(); ++iter)
+	{
+		DBTaskWriteEntity* pTask = (*iter);
+		pTask->presentMainThread();
+
+		// еûоDBThread::tryGetTask ҪͷռõdbidͶŶӵĺ
+		EntityDBTask* pNextTask = pBuffered_DBTasks_->tryGetNextTask(pTask);
+		if(pNextTask)
+			DBUtil::pThreadPool(pBuffered_DBTasks_->dbInterfaceName())->addTask(pNextTask);
+
+		delete pTask;
+	}
+
+	tasks_.clear();
+	return thread::TPTask::TPTASK_STATE_COMPLETED;
+}
+
 //-------------------------------------------------------------------------------------
 DBTaskRemoveEntity::DBTaskRemoveEntity(const Network::Address& addr, 
 									 COMPONENT_ID componentID, ENTITY_ID eid, 
@@ -406,6 +572,8 @@ eid_(eid),
 entityDBID_(entityDBID),
 sid_(0)
 {
+	// ߳нʵͣ ԱͶʱǻд
+	(*pDatas_) >> sid_;
 }
 
 //-------------------------------------------------------------------------------------
@@ -416,8 +584,6 @@ DBTaskRemoveEntity::~DBTaskRemoveEntity()
 //-------------------------------------------------------------------------------------
 bool DBTaskRemoveEntity::db_thread_process()
 {
-	(*pDatas_) >> sid_;
-
 	EntityTables& entityTables = EntityTables::findByInterfaceName(pdbi_->name());
 	KBEEntityLogTable* pELTable = static_cast<KBEEntityLogTable*>(entityTables.findKBETable(KBE_TABLE_PERFIX "_entitylog"));
 
@@ -425,6 +591,7 @@ bool DBTaskRemoveEntity::db_thread_process()
 	pELTable->eraseEntityLog(pdbi_, entityDBID_, sid_);
 
 	entityTables.removeEntity(pdbi_, entityDBID_, EntityDef::findScriptModule(sid_));
+	endEntityCacheWrite(pdbi_, sid_, entityDBID_);
 	return false;
 }
 
@@ -474,6 +641,7 @@ bool DBTaskDeleteEntityByDBID::db_thread_process()
 	// ߼¼
 	if(haslog)
 	{
+		endEntityCacheWrite(pdbi_, sid_, entityDBID_);
 		success_ = false;
 		entityInAppID_ = entitylog.componentID;
 		entityID_ = entitylog.entityID;
@@ -482,6 +650,7 @@ bool DBTaskDeleteEntityByDBID::db_thread_process()
 	}
 
 	entityTables.removeEntity(pdbi_, entityDBID_, pModule);
+	endEntityCacheWrite(pdbi_, sid_, entityDBID_);
 	success_ = true;
 	return false;
 }
@@ -618,7 +787,7 @@ bool DBTaskLookUpEntityByDBID::db_thread_process()
 	}
 
 	MemoryStream s;
-	success_ = entityTables.queryEntity(pdbi_, entityDBID_, &s, pModule);
+	success_ = queryEntityCached(pdbi_, entityDBID_, &s, pModule);
 	return false;
 }
 
@@ -1365,7 +1534,7 @@ bool DBTaskQueryAccount::db_thread_process()
 	}
 
 	ScriptDefModule* pModule = EntityDef::findScriptModule(DBUtil::accountScriptName());
-	success_ = entityTables.queryEntity(pdbi_, info.dbid, s_, pModule);
+	success_ = queryEntityCached(pdbi_, info.dbid, s_, pModule);
 
 	if(!success_ && pdbi_->getlasterror() > 0)
 	{
@@ -1505,6 +1674,20 @@ bool DBTaskEntityOffline::db_thread_process()
 	KBE_ASSERT(pELTable);
 
 	pELTable->eraseEntityLog(pdbi_, EntityDBTask_entityDBID(), sid_);
+
+	// ǰһδ浵Ѿdbidǰɣ ʱ뻺棬 лbaseappʱֱ
+	if(g_kbeSrvConfig.getDBMgr().entityCache_warmOnOffline && findEntityCache(pdbi_))
+	{
+		ScriptDefModule* pModule = EntityDef::findScriptModule(sid_);
+
+		if(pModule)
+		{
+			MemoryStream* s = MemoryStream::createPoolObject(OBJECTPOOL_POINT);
+			queryEntityCached(pdbi_, EntityDBTask_entityDBID(), s, pModule);
+			MemoryStream::reclaimPoolObject(s);
+		}
+	}
+
 	return false;
 }
 
@@ -1548,12 +1731,22 @@ DBTaskAccountLogin::~DBTaskAccountLogin()
 
 //-------------------------------------------------------------------------------------
 bool DBTaskAccountLogin::db_thread_process()
+{
+	DBID dbid = checkAccount(NULL);
+	if(dbid > 0)
+		queryEntityLog(dbid);
+
+	return false;
+}
+
+//-------------------------------------------------------------------------------------
+DBID DBTaskAccountLogin::checkAccount(const ACCOUNT_INFOS* pInfo)
 {
 	// InterfacesѾжϲɹûҪȥ
 	if(retcode_ != SERVER_SUCCESS)
 	{
 		ERROR_MSG(fmt::format("DBTaskAccountLogin::db_thread_process(): interfaces report failed(errcode={})!\n", retcode_));
-		return false;
+		return 0;
 	}
 
 	retcode_ = SERVER_ERR_OP_FAILED;
@@ -1562,7 +1755,7 @@ bool DBTaskAccountLogin::db_thread_process()
 	{
 		ERROR_MSG(fmt::format("DBTaskAccountLogin::db_thread_process(): accountName is NULL!\n"));
 		retcode_ = SERVER_ERR_NAME;
-		return false;
+		return 0;
 	}
 
 	ScriptDefModule* pModule = EntityDef::findScriptModule(DBUtil::accountScriptName());
@@ -1573,15 +1766,10 @@ bool DBTaskAccountLogin::db_thread_process()
 			DBUtil::accountScriptName(), accountName_));
 
 		retcode_ = SERVER_ERR_SRV_NO_READY;
-		return false;
+		return 0;
 	}
 
 	EntityTables& entityTables = EntityTables::findByInterfaceName(pdbi_->name());
-	KBEEntityLogTable* pELTable = static_cast<KBEEntityLogTable*>
-		(entityTables.findKBETable(KBE_TABLE_PERFIX "_entitylog"));
-
-	KBE_ASSERT(pELTable);
-
 	KBEAccountTable* pTable = static_cast<KBEAccountTable*>(entityTables.findKBETable(KBE_TABLE_PERFIX "_accountinfos"));
 	KBE_ASSERT(pTable);
 
@@ -1590,7 +1778,14 @@ bool DBTaskAccountLogin::db_thread_process()
 	info.flags = 0;
 	info.deadline = 0;
 
-	if(!pTable->queryAccount(pdbi_, accountName_, info))
+	// ϲѯѾҵ˺Ųٵѯ
+	bool found = true;
+	if(pInfo)
+		info = *pInfo;
+	else
+		found = pTable->queryAccount(pdbi_, accountName_, info);
+
+	if(!found)
 	{
 		flags_ = info.flags;
 		deadline_ = info.deadline;
@@ -1603,7 +1798,7 @@ bool DBTaskAccountLogin::db_thread_process()
 					accountName_));
 
 				retcode_ = SERVER_ERR_CANNOT_USE_MAIL;
-				return false;
+				return 0;
 			}
 		}
 
@@ -1616,7 +1811,7 @@ bool DBTaskAccountLogin::db_thread_process()
 					accountName_));
 
 				retcode_ = SERVER_ERR_DB;
-				return false;
+				return 0;
 			}
 
 			INFO_MSG(fmt::format("DBTaskAccountLogin::db_thread_process(): not found account[{}], autocreate successfully!\n", 
@@ -1630,17 +1825,17 @@ bool DBTaskAccountLogin::db_thread_process()
 				accountName_));
 
 			retcode_ = SERVER_ERR_NOT_FOUND_ACCOUNT;
-			return false;
+			return 0;
 		}
 	}
 
 	if(info.dbid == 0)
-		return false;
+		return 0;
 
 	if(info.flags != ACCOUNT_FLAG_NORMAL)
 	{
 		flags_ = info.flags;
-		return false;
+		return 0;
 	}
 
 	if (needCheckPassword_ || g_kbeSrvConfig.interfacesAddrs().size() == 0)
@@ -1648,25 +1843,51 @@ bool DBTaskAccountLogin::db_thread_process()
 		if (kbe_stricmp(info.password.c_str(), KBE_MD5::getDigest(password_.data(), (int)password_.length()).c_str()) != 0)
 		{
 			retcode_ = SERVER_ERR_PASSWORD;
-			return false;
+			return 0;
 		}
 	}
 
 	pTable->updateCount(pdbi_, accountName_, info.dbid);
 
 	retcode_ = SERVER_ERR_ACCOUNT_IS_ONLINE;
+	flags_ = info.flags;
+	deadline_ = info.deadline;
+	return info.dbid;
+}
+
+//-------------------------------------------------------------------------------------
+void DBTaskAccountLogin::queryEntityLog(DBID dbid)
+{
+	ScriptDefModule* pModule = EntityDef::findScriptModule(DBUtil::accountScriptName());
+
+	EntityTables& entityTables = EntityTables::findByInterfaceName(pdbi_->name());
+	KBEEntityLogTable* pELTable = static_cast<KBEEntityLogTable*>
+		(entityTables.findKBETable(KBE_TABLE_PERFIX "_entitylog"));
+
+	KBE_ASSERT(pELTable);
+
 	KBEEntityLogTable::EntityLog entitylog;
-	bool success = !pELTable->queryEntity(pdbi_, info.dbid, entitylog, pModule->getUType());
+	entitylog.componentID = 0;
+	entitylog.entityID = 0;
+	entitylog.serverGroupID = 0;
+
+	bool online = pELTable->queryEntity(pdbi_, dbid, entitylog, pModule->getUType());
+	onQueryEntityLog(dbid, online, entitylog.componentID, entitylog.entityID, entitylog.serverGroupID);
+}
 
+//-------------------------------------------------------------------------------------
+void DBTaskAccountLogin::onQueryEntityLog(DBID dbid, bool online, COMPONENT_ID componentID, 
+	ENTITY_ID entityID, COMPONENT_ID serverGroupID)
+{
 	// ߼¼
-	if(!success)
+	if(online)
 	{
-		componentID_ = entitylog.componentID;
-		entityID_ = entitylog.entityID;
+		componentID_ = componentID;
+		entityID_ = entityID;
 		
-		if(entitylog.serverGroupID != (uint64)getUserUID())
+		if(serverGroupID != (uint64)getUserUID())
 		{
-			serverGroupID_ = entitylog.serverGroupID;
+			serverGroupID_ = serverGroupID;
 			retcode_ = SERVER_ERR_ACCOUNT_LOGIN_ANOTHER_SERVER;
 		}
 	}
@@ -1675,10 +1896,7 @@ bool DBTaskAccountLogin::db_thread_process()
 		retcode_ = SERVER_SUCCESS;
 	}
 
-	dbid_ = info.dbid;
-	flags_ = info.flags;
-	deadline_ = info.deadline;
-	return false;
+	dbid_ = dbid;
 }
 
 //-------------------------------------------------------------------------------------
@@ -1729,6 +1947,135 @@ thread::TPTask::TPTaskState DBTaskAccountLogin::presentMainThread()
 	return DBTask::presentMainThread();
 }
 
+//-------------------------------------------------------------------------------------
+DBTaskAccountLogins::DBTaskAccountLogins():
+DBTask(),
+tasks_(),
+numAccountHits_(0)
+{
+}
+
+//-------------------------------------------------------------------------------------
+DBTaskAccountLogins::~DBTaskAccountLogins()
+{
+	std::vector<DBTaskAccountLogin*>::iterator iter = tasks_.begin();
+	for(; iter != tasks_.end(); ++iter)
+		delete (*iter);
+
+	tasks_.clear();
+}
+
+//-------------------------------------------------------------------------------------
+void DBTaskAccountLogins::addTask(DBTaskAccountLogin* pTask)
+{
+	tasks_.push_back(pTask);
+}
+
+//-------------------------------------------------------------------------------------
+bool DBTaskAccountLogins::db_thread_process()
+{
+	ScriptDefModule* pModule = EntityDef::findScriptModule(DBUtil::accountScriptName());
+
+	EntityTables& entityTables = EntityTables::findByInterfaceName(pdbi_->name());
+	KBEEntityLogTable* pELTable = static_cast<KBEEntityLogTable*>
+		(entityTables.findKBETable(KBE_TABLE_PERFIX "_entitylog"));
+
+	KBE_ASSERT(pELTable);
+
+	KBEAccountTable* pTable = static_cast<KBEAccountTable*>(entityTables.findKBETable(KBE_TABLE_PERFIX "_accountinfos"));
+	KBE_ASSERT(pTable);
+
+	std::vector<std::string> names;
+	names.reserve(tasks_.size());
+
+	std::vector<DBTaskAccountLogin*>::iterator iter = tasks_.begin();
+	for(; iter != tasks_.end(); ++iter)
+	{
+		DBTaskAccountLogin* pTask = (*iter);
+		pTask->pdbi(pdbi_);
+
+		if(pTask->retcode() == SERVER_SUCCESS && pTask->accountName().size() > 0)
+			names.push_back(pTask->accountName());
+	}
+
+	// ϲѯ˺(ִСдͬҪԶ)ɸ񵥶ѯ
+	std::map<std::string, ACCOUNT_INFOS> infos;
+	if(pModule == NULL || !pTable->queryAccounts(pdbi_, names, infos))
+		infos.clear();
+
+	std::vector<DBID> dbids(tasks_.size(), 0);
+	std::vector<DBID> onlineDBIDs;
+
+	for(size_t i = 0; i < tasks_.size(); ++i)
+	{
+		const ACCOUNT_INFOS* pInfo = NULL;
+
+		std::map<std::string, ACCOUNT_INFOS>::iterator info_iter = infos.find(tasks_[i]->accountName());
+		if(info_iter != infos.end())
+		{
+			pInfo = &info_iter->second;
+			++numAccountHits_;
+		}
+
+		dbids[i] = tasks_[i]->checkAccount(pInfo);
+		if(dbids[i] > 0)
+			onlineDBIDs.push_back(dbids[i]);
+	}
+
+	if(onlineDBIDs.size() == 0)
+		return false;
+
+	std::map<DBID, KBEEntityLogTable::EntityLog> entitylogs;
+	if(!pELTable->queryEntities(pdbi_, onlineDBIDs, entitylogs, pModule->getUType()))
+	{
+		for(size_t i = 0; i < tasks_.size(); ++i)
+		{
+			if(dbids[i] > 0)
+				tasks_[i]->queryEntityLog(dbids[i]);
+		}
+
+		return false;
+	}
+
+	for(size_t i = 0; i < tasks_.size(); ++i)
+	{
+		if(dbids[i] == 0)
+			continue;
+
+		std::map<DBID, KBEEntityLogTable::EntityLog>::iterator log_iter = entitylogs.find(dbids[i]);
+		if(log_iter != entitylogs.end())
+		{
+			KBEEntityLogTable::EntityLog& entitylog = log_iter->second;
+			tasks_[i]->onQueryEntityLog(dbids[i], true, entitylog.componentID, entitylog.entityID, entitylog.serverGroupID);
+		}
+		else
+		{
+			tasks_[i]->onQueryEntityLog(dbids[i], false, 0, 0, 0);
+		}
+	}
+
+	return false;
+}
+
+//-------------------------------------------------------------------------------------
+thread::TPTask::TPTaskState DBTaskAccountLogins::presentMainThread()
+{
+	++g_numLoginBatches;
+	g_numBatchedLogins += tasks_.size();
+	g_numBatchedAccountHits += numAccountHits_;
+
+	std::vector<DBTaskAccountLogin*>::iterator iter = tasks_.begin();
+	for(; iter != tasks_.end(); ++iter)
+	{
+		DBTaskAccountLogin* pTask = (*iter);
+		pTask->presentMainThread();
+		delete pTask;
+	}
+
+	tasks_.clear();
+	return thread::TPTask::TPTASK_STATE_COMPLETED;
+}
+
 //-------------------------------------------------------------------------------------
 DBTaskQueryEntity::DBTaskQueryEntity(const Network::Address& addr, int8 queryMode, std::string& entityType, DBID dbid, 
 		COMPONENT_ID componentID, CALLBACK_ID callbackID, ENTITY_ID entityID):
@@ -1760,7 +2107,7 @@ bool DBTaskQueryEntity::db_thread_process()
 {
 	EntityTables& entityTables = EntityTables::findByInterfaceName(pdbi_->name());
 	ScriptDefModule* pModule = EntityDef::findScriptModule(entityType_.c_str());
-	success_ = entityTables.queryEntity(pdbi_, dbid_, s_, pModule);
+	success_ = queryEntityCached(pdbi_, dbid_, s_, pModule);
 
 	if(success_)
 	{
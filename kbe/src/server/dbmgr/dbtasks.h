@@ -163,7 +163,11 @@ public:
 		return "DBTaskWriteEntity";
 	}
 
+	ENTITY_SCRIPT_UID sid() const { return sid_; }
+
 protected:
+	friend class DBTaskWriteEntities;
+
 	COMPONENT_ID componentID_;
 	ENTITY_ID eid_;
 	DBID entityDBID_;
@@ -173,6 +177,33 @@ protected:
 	bool success_;
 };
 
+/**
+	ͬһentityĶºϲΪһд
+	ÿentityBuffered_DBTasksжռdbid ɺͷţ ͬһdbidд˳򲻱
+*/
+class DBTaskWriteEntities : public DBTask
+{
+public:
+	DBTaskWriteEntities(Buffered_DBTasks* pBuffered_DBTasks, ENTITY_SCRIPT_UID sid);
+
+	virtual ~DBTaskWriteEntities();
+	virtual bool db_thread_process();
+	virtual thread::TPTask::TPTaskState presentMainThread();
+
+	virtual std::string name() const {
+		return "DBTaskWriteEntities";
+	}
+
+	void addTask(DBTaskWriteEntity* pTask);
+	size_t size() const { return tasks_.size(); }
+
+protected:
+	Buffered_DBTasks* pBuffered_DBTasks_;
+	ENTITY_SCRIPT_UID sid_;
+	std::vector<DBTaskWriteEntity*> tasks_;
+	uint32 numStatements_;
+};
+
 /**
 	ݿɾentity
 */
@@ -190,6 +221,8 @@ public:
 		return "DBTaskRemoveEntity";
 	}
 
+	ENTITY_SCRIPT_UID sid() const { return sid_; }
+
 protected:
 	COMPONENT_ID componentID_;
 	ENTITY_ID eid_;
@@ -564,6 +597,21 @@ public:
 		return "DBTaskAccountLogin";
 	}
 
+	/**
+		˺ţ pInfoΪϲѯõ˺ţ ΪNULLʱѯ
+		Ҫѯ߼¼dbid Ϊ0ʾѾó
+	*/
+	DBID checkAccount(const ACCOUNT_INFOS* pInfo);
+
+	/**
+		ѯ߼¼ó¼
+	*/
+	void queryEntityLog(DBID dbid);
+	void onQueryEntityLog(DBID dbid, bool online, COMPONENT_ID componentID, ENTITY_ID entityID, COMPONENT_ID serverGroupID);
+
+	const std::string& accountName() const { return accountName_; }
+	SERVER_ERROR_CODE retcode() const { return retcode_; }
+
 protected:
 	std::string loginName_;
 	std::string accountName_;
@@ -579,6 +627,30 @@ protected:
 	COMPONENT_ID serverGroupID_;
 };
 
+/**
+	ϲѯһʱڵĵ¼
+*/
+class DBTaskAccountLogins : public DBTask
+{
+public:
+	DBTaskAccountLogins();
+
+	virtual ~DBTaskAccountLogins();
+	virtual bool db_thread_process();
+	virtual thread::TPTask::TPTaskState presentMainThread();
+
+	virtual std::string name() const {
+		return "DBTaskAccountLogins";
+	}
+
+	void addTask(DBTaskAccountLogin* pTask);
+	size_t size() const { return tasks_.size(); }
+
+protected:
+	std::vector<DBTaskAccountLogin*> tasks_;
+	uint32 numAccountHits_;
+};
+
 /**
 	baseappѯentityϢ
 */
@@ -0,0 +1,314 @@
+// Copyright 2008-2018 Yolo Technologies, Inc. All Rights Reserved. https://www.comblockengine.com
+
+#include "entity_cache.h"
+#include "thread/threadguard.h"
+
+namespace KBEngine{
+
+//-------------------------------------------------------------------------------------
+EntityCache::EntityCache():
+entries_(),
+entryMap_(),
+writing_(),
+maxMemory_(0),
+memory_(0),
+numEntities_(0),
+serial_(0),
+minSerial_(0),
+hits_(0),
+misses_(0),
+evictions_(0),
+invalidations_(0),
+stalePuts_(0),
+mutex_()
+{
+}
+
+//-------------------------------------------------------------------------------------
+EntityCache::~EntityCache()
+{
+}
+
+//-------------------------------------------------------------------------------------
+void EntityCache::maxMemory(size_t v)
+{
+	KBEngine::thread::ThreadGuard tg(&mutex_);
+	maxMemory_ = v;
+	evict_();
+}
+
+//-------------------------------------------------------------------------------------
+size_t EntityCache::entryMemory_(const Entry& entry) const
+{
+	// ԼڵĴ¿
+	return entry.datas.size() + sizeof(Entry) + sizeof(ENTRY_MAP::value_type) + 64;
+}
+
+//-------------------------------------------------------------------------------------
+void EntityCache::touch_(ENTRIES::iterator iter)
+{
+	if(iter != entries_.begin())
+		entries_.splice(entries_.begin(), entries_, iter);
+}
+
+//-------------------------------------------------------------------------------------
+void EntityCache::evict_()
+{
+	while(memory_ > maxMemory_ && entries_.size() > 0)
+	{
+		Entry& entry = entries_.back();
+
+		if(entry.invalidSerial > minSerial_)
+			minSerial_ = entry.invalidSerial;
+
+		if(entry.valid)
+		{
+			--numEntities_;
+			++evictions_;
+		}
+
+		memory_ -= entryMemory_(entry);
+		entryMap_.erase(entry.key);
+		entries_.pop_back();
+	}
+}
+
+//-------------------------------------------------------------------------------------
+bool EntityCache::find(ENTITY_SCRIPT_UID sid, DBID dbid, MemoryStream& s)
+{
+	KBEngine::thread::ThreadGuard tg(&mutex_);
+
+	ENTITY_KEY key(sid, dbid);
+	ENTRY_MAP::iterator iter = entryMap_.find(key);
+	if(iter == entryMap_.end() || !iter->second->valid || writing_.find(key) != writing_.end())
+	{
+		++misses_;
+		return false;
+	}
+
+	++hits_;
+	touch_(iter->second);
+
+	const std::string& datas = iter->second->datas;
+	if(datas.size() > 0)
+		s.append(datas.data(), datas.size());
+
+	return true;
+}
+
+//-------------------------------------------------------------------------------------
+uint64 EntityCache::serial()
+{
+	KBEngine::thread::ThreadGuard tg(&mutex_);
+	return serial_;
+}
+
+//-------------------------------------------------------------------------------------
+void EntityCache::put(ENTITY_SCRIPT_UID sid, DBID dbid, const uint8* datas, size_t size, uint64 readSerial)
+{
+	KBEngine::thread::ThreadGuard tg(&mutex_);
+
+	if(maxMemory_ == 0)
+		return;
+
+	// ȡڼ仺汻ջʧЧ¼ѱ̭ ޷ȷǷ
+	if(readSerial < minSerial_)
+	{
+		++stalePuts_;
+		return;
+	}
+
+	ENTITY_KEY key(sid, dbid);
+
+	// 浵δɣ Ŀд֮ǰ
+	if(writing_.find(key) != writing_.end())
+	{
+		++stalePuts_;
+		return;
+	}
+
+	ENTRY_MAP::iterator iter = entryMap_.find(key);
+
+	if(iter != entryMap_.end())
+	{
+		Entry& entry = *iter->second;
+
+		// ȡʼ֮entity浵
+		if(entry.invalidSerial > readSerial)
+		{
+			++stalePuts_;
+			return;
+		}
+
+		memory_ -= entryMemory_(entry);
+
+		if(!entry.valid)
+			++numEntities_;
+
+		entry.datas.assign((const char*)datas, size);
+		entry.valid = true;
+		memory_ += entryMemory_(entry);
+		touch_(iter->second);
+	}
+	else
+	{
+		entries_.push_front(Entry());
+		Entry& entry = entries_.front();
+		entry.key = key;
+		entry.datas.assign((const char*)datas, size);
+		entry.valid = true;
+		entry.invalidSerial = 0;
+
+		entryMap_[key] = entries_.begin();
+		memory_ += entryMemory_(entry);
+		++numEntities_;
+	}
+
+	evict_();
+}
+
+//-------------------------------------------------------------------------------------
+void EntityCache::beginWrite(ENTITY_SCRIPT_UID sid, DBID dbid)
+{
+	KBEngine::thread::ThreadGuard tg(&mutex_);
+
+	if(maxMemory_ == 0)
+		return;
+
+	ENTITY_KEY key(sid, dbid);
+	++writing_[key];
+	invalidate_(key);
+}
+
+//-------------------------------------------------------------------------------------
+void EntityCache::endWrite(ENTITY_SCRIPT_UID sid, DBID dbid)
+{
+	KBEngine::thread::ThreadGuard tg(&mutex_);
+
+	if(maxMemory_ == 0)
+		return;
+
+	ENTITY_KEY key(sid, dbid);
+	WRITING_MAP::iterator witer = writing_.find(key);
+	if(witer != writing_.end() && --witer->second == 0)
+		writing_.erase(witer);
+
+	// дɺһţ дڼ俪ʼĶȡ뻺
+	invalidate_(key);
+}
+
+//-------------------------------------------------------------------------------------
+void EntityCache::invalidate_(const ENTITY_KEY& key)
+{
+	++serial_;
+
+	ENTRY_MAP::iterator iter = entryMap_.find(key);
+
+	if(iter != entryMap_.end())
+	{
+		Entry& entry = *iter->second;
+		memory_ -= entryMemory_(entry);
+
+		if(entry.valid)
+		{
+			--numEntities_;
+			++invalidations_;
+		}
+
+		std::string().swap(entry.datas);
+		entry.valid = false;
+		entry.invalidSerial = serial_;
+		memory_ += entryMemory_(entry);
+		touch_(iter->second);
+	}
+	else
+	{
+		// ʹûлҲҪ¼ʧЧţ ֹڽеĶȡ
+		entries_.push_front(Entry());
+		Entry& entry = entries_.front();
+		entry.key = key;
+		entry.valid = false;
+		entry.invalidSerial = serial_;
+
+		entryMap_[key] = entries_.begin();
+		memory_ += entryMemory_(entry);
+	}
+
+	evict_();
+}
+
+//-------------------------------------------------------------------------------------
+void EntityCache::clear()
+{
+	KBEngine::thread::ThreadGuard tg(&mutex_);
+
+	invalidations_ += numEntities_;
+
+	entries_.clear();
+	entryMap_.clear();
+	memory_ = 0;
+	numEntities_ = 0;
+	minSerial_ = ++serial_;
+}
+
+//-------------------------------------------------------------------------------------
+uint64 EntityCache::hits()
+{
+	KBEngine::thread::ThreadGuard tg(&mutex_);
+	return hits_;
+}
+
+//-------------------------------------------------------------------------------------
+uint64 EntityCache::misses()
+{
+	KBEngine::thread::ThreadGuard tg(&mutex_);
+	return misses_;
+}
+
+//-------------------------------------------------------------------------------------
+float EntityCache::hitRate()
+{
+	KBEngine::thread::ThreadGuard tg(&mutex_);
+	if(hits_ + misses_ == 0)
+		return 0.f;
+
+	return (float)hits_ / (float)(hits_ + misses_);
+}
+
+//-------------------------------------------------------------------------------------
+uint32 EntityCache::numEntities()
+{
+	KBEngine::thread::ThreadGuard tg(&mutex_);
+	return numEntities_;
+}
+
+//-------------------------------------------------------------------------------------
+uint64 EntityCache::memory()
+{
+	KBEngine::thread::ThreadGuard tg(&mutex_);
+	return memory_;
+}
+
+//-------------------------------------------------------------------------------------
+uint64 EntityCache::evictions()
+{
+	KBEngine::thread::ThreadGuard tg(&mutex_);
+	return evictions_;
+}
+
+//-------------------------------------------------------------------------------------
+uint64 EntityCache::invalidations()
+{
+	KBEngine::thread::ThreadGuard tg(&mutex_);
+	return invalidations_;
+}
+
+//-------------------------------------------------------------------------------------
+uint64 EntityCache::stalePuts()
+{
+	KBEngine::thread::ThreadGuard tg(&mutex_);
+	return stalePuts_;
+}
+
+//-------------------------------------------------------------------------------------
+}
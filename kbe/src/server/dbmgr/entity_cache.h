@@ -0,0 +1,120 @@
+// Copyright 2008-2018 Yolo Technologies, Inc. All Rights Reserved. https://www.comblockengine.com
+
+#ifndef KBE_DBMGR_ENTITY_CACHE_H
+#define KBE_DBMGR_ENTITY_CACHE_H
+
+#include "common/common.h"
+#include "common/memorystream.h"
+#include "entitydef/common.h"
+#include "thread/threadmutex.h"
+
+namespace KBEngine { 
+
+/*
+	ȡentityݻ棬 (entity, dbid)ΪqueryEntity
+	ڴʱ̭δʹõentity ݿ߳зʣ нӿ̰߳ȫ
+
+	ͬһdbidϵĴ浵ȡһBuffered_DBTasksŶ(entityIDŶӵĲѯ˺)
+	߳Ͷݴ浵ʱʹʧЧΪд룬 дڼĶȡҲ뻺棻
+	浵ɺٴμ¼ʧЧţ ȡʼǰȡõʧЧʱݲ뻺档
+*/
+class EntityCache
+{
+public:
+	EntityCache();
+	virtual ~EntityCache();
+
+	/**
+		ڴ(ֽ) 0Ϊʹû
+	*/
+	void maxMemory(size_t v);
+	bool enabled() const { return maxMemory_ > 0; }
+
+	/**
+		ʱ׷ӵs
+	*/
+	bool find(ENTITY_SCRIPT_UID sid, DBID dbid, MemoryStream& s);
+
+	/**
+		ݿȡ֮ǰȡõǰţ 뻺ʱ
+	*/
+	uint64 serial();
+
+	void put(ENTITY_SCRIPT_UID sid, DBID dbid, const uint8* datas, size_t size, uint64 readSerial);
+
+	/**
+		Ͷentity浵ɾʱ(߳) ÿbeginWriteӦһendWrite
+	*/
+	void beginWrite(ENTITY_SCRIPT_UID sid, DBID dbid);
+
+	/**
+		entity浵ɾɺ(ݿ߳)
+	*/
+	void endWrite(ENTITY_SCRIPT_UID sid, DBID dbid);
+
+	/**
+		޷ȷЩentity޸ʱ(ִԭʼsql)ջ
+	*/
+	void clear();
+
+	/**
+		ṩwatcherʹ
+	*/
+	uint64 hits();
+	uint64 misses();
+	float hitRate();
+	uint32 numEntities();
+	uint64 memory();
+	uint64 evictions();
+	uint64 invalidations();
+	uint64 stalePuts();
+
+protected:
+	typedef std::pair<ENTITY_SCRIPT_UID, DBID> ENTITY_KEY;
+
+	struct Entry
+	{
+		ENTITY_KEY key;
+		std::string datas;
+		bool valid;					// ʧЧֻʧЧ
+		uint64 invalidSerial;
+	};
+
+	typedef std::list<Entry> ENTRIES;
+	typedef std::map<ENTITY_KEY, ENTRIES::iterator> ENTRY_MAP;
+
+	typedef std::map<ENTITY_KEY, uint32> WRITING_MAP;
+
+	size_t entryMemory_(const Entry& entry) const;
+	void touch_(ENTRIES::iterator iter);
+	void evict_();
+	void invalidate_(const ENTITY_KEY& key);
+
+	// ʹ ʹõǰ
+	ENTRIES entries_;
+	ENTRY_MAP entryMap_;
+
+	// ͶݵδɵĴ浵 ̭Ӱ
+	WRITING_MAP writing_;
+
+	size_t maxMemory_;
+	size_t memory_;
+	uint32 numEntities_;
+
+	uint64 serial_;
+
+	// ڴŵĶȡ뻺棬 ̭ʧЧ¼ջʱ
+	uint64 minSerial_;
+
+	uint64 hits_;
+	uint64 misses_;
+	uint64 evictions_;
+	uint64 invalidations_;
+	uint64 stalePuts_;
+
+	KBEngine::thread::ThreadMutex mutex_;
+};
+
+}
+
+#endif // KBE_DBMGR_ENTITY_CACHE_H
@@ -102,7 +102,7 @@ bool InterfacesHandler_Dbmgr::loginAccount(Network::Channel* pChannel, std::stri
 		return false;
 	}
 
-	pThreadPool->addTask(new DBTaskAccountLogin(pChannel->addr(),
+	Dbmgr::getSingleton().findBufferedDBTask(dbInterfaceName)->addLoginTask(new DBTaskAccountLogin(pChannel->addr(),
 		loginName, loginName, password, SERVER_SUCCESS, datas, datas, true));
 
 	return true;
@@ -421,7 +421,7 @@ void InterfacesHandler_Interfaces::onLoginAccountCB(KBEngine::MemoryStream& s)
 		return;
 	}
 
-	pThreadPool->addTask(new DBTaskAccountLogin(cinfos->pChannel->addr(),
+	Dbmgr::getSingleton().findBufferedDBTask(dbInterfaceName)->addLoginTask(new DBTaskAccountLogin(cinfos->pChannel->addr(),
 		loginName, accountName, password, success, postdatas, getdatas, needCheckPassword));
 }
 
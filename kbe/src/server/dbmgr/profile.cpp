@@ -8,4 +8,12 @@ ProfileVal SCRIPTCALL_PROFILE("scriptCall");
 EventHistoryStats g_privateClientEventHistoryStats("PrivateClientEvents");
 EventHistoryStats g_publicClientEventHistoryStats("PublicClientEvents");
 
+uint64 g_numWriteBatches = 0;
+uint64 g_numBatchedWrites = 0;
+uint64 g_numBatchStatements = 0;
+
+uint64 g_numLoginBatches = 0;
+uint64 g_numBatchedLogins = 0;
+uint64 g_numBatchedAccountHits = 0;
+
 }
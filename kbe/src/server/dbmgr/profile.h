@@ -15,5 +15,15 @@ extern ProfileVal SCRIPTCALL_PROFILE;
 extern EventHistoryStats g_privateClientEventHistoryStats;
 extern EventHistoryStats g_publicClientEventHistoryStats;
 
+// ϲдͳ
+extern uint64 g_numWriteBatches;
+extern uint64 g_numBatchedWrites;
+extern uint64 g_numBatchStatements;
+
+// ϲ¼ѯͳ
+extern uint64 g_numLoginBatches;
+extern uint64 g_numBatchedLogins;
+extern uint64 g_numBatchedAccountHits;
+
 }
 #endif
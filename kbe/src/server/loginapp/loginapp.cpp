@@ -38,6 +38,12 @@ Loginapp::Loginapp(Network::EventDispatcher& dispatcher,
 	mainProcessTimer_(),
 	pendingCreateMgr_(ninterface),
 	pendingLoginMgr_(ninterface),
+	loginQueue_(),
+	loginQueueTickets_(),
+	loginQueueHead_(0),
+	loginQueueNotifiedHead_(0),
+	lastLoginQueueNotifyTime_(0),
+	numQueuedLogins_(0),
 	digest_(),
 	pHttpCBHandler(NULL),
 	initProgress_(0.f),
@@ -50,6 +56,13 @@ Loginapp::Loginapp(Network::EventDispatcher& dispatcher,
 Loginapp::~Loginapp()
 {
 	SAFE_RELEASE(pHttpCBHandler);
+
+	std::deque<PendingLoginMgr::PLInfos*>::iterator iter = loginQueue_.begin();
+	for(; iter != loginQueue_.end(); ++iter)
+		delete (*iter);
+
+	loginQueue_.clear();
+	loginQueueTickets_.clear();
 }
 
 //-------------------------------------------------------------------------------------	
@@ -96,6 +109,7 @@ void Loginapp::handleMainTick()
 	networkInterface().processChannels(&LoginappInterface::messageHandlers);
 	pendingLoginMgr_.process();
 	pendingCreateMgr_.process();
+	processLoginQueue();
 }
 
 //-------------------------------------------------------------------------------------
@@ -147,6 +161,16 @@ void Loginapp::onChannelDeregister(Network::Channel * pChannel)
 	PythonApp::onChannelDeregister(pChannel);
 }
 
+//-------------------------------------------------------------------------------------
+bool Loginapp::initializeWatcher()
+{
+	WATCH_OBJECT("loginQueue/size", this, &Loginapp::loginQueueSize);
+	WATCH_OBJECT("loginQueue/pending", this, &Loginapp::numPendingLogins);
+	WATCH_OBJECT("loginQueue/queued", numQueuedLogins_);
+
+	return PythonApp::initializeWatcher();
+}
+
 //-------------------------------------------------------------------------------------
 bool Loginapp::initializeBegin()
 {
@@ -1091,6 +1115,45 @@ void Loginapp::login(Network::Channel* pChannel, MemoryStream& s)
 		return;
 	}
 
+	// ѾŶУ ͬһͻظ¼ʱµ¼Ϣԭλ
+	KBEUnordered_map<std::string, uint64>::iterator ticket_iter = loginQueueTickets_.find(loginName);
+	if(ticket_iter != loginQueueTickets_.end())
+	{
+		ptinfos = loginQueue_[(size_t)(ticket_iter->second - loginQueueHead_)];
+
+		// ͻΪ˺Ŷӣ 滻¼Ϣ ֻŶӵĿͻѾϿʱ
+		if(!(ptinfos->addr == pChannel->addr()))
+		{
+			Network::Channel* pQueuedChannel = networkInterface().findChannel(ptinfos->addr);
+			if(pQueuedChannel && !pQueuedChannel->isDestroyed() && pQueuedChannel->extra() == loginName)
+			{
+				datas = "";
+				_loginFailed(pChannel, loginName, SERVER_ERR_BUSY, datas, true);
+				return;
+			}
+		}
+
+		ptinfos->ctype = ctype;
+		ptinfos->datas = datas;
+		ptinfos->password = password;
+		ptinfos->addr = pChannel->addr();
+		ptinfos->forceInternalLogin = forceInternalLogin;
+
+		pChannel->extra(loginName);
+		_loginQueued(pChannel, loginName, ticket_iter->second - loginQueueHead_ + 1);
+		return;
+	}
+
+	uint32 maxPending = g_kbeSrvConfig.getLoginApp().loginQueue_maxPending;
+	bool needQueue = maxPending > 0 && (loginQueue_.size() > 0 || pendingLoginMgr_.size() >= maxPending);
+
+	if(needQueue && loginQueue_.size() >= g_kbeSrvConfig.getLoginApp().loginQueue_maxSize)
+	{
+		datas = "";
+		_loginFailed(pChannel, loginName, SERVER_ERR_BUSY, datas, true);
+		return;
+	}
+
 	ptinfos = new PendingLoginMgr::PLInfos;
 	ptinfos->ctype = ctype;
 	ptinfos->datas = datas;
@@ -1098,7 +1161,6 @@ void Loginapp::login(Network::Channel* pChannel, MemoryStream& s)
 	ptinfos->password = password;
 	ptinfos->addr = pChannel->addr();
 	ptinfos->forceInternalLogin = forceInternalLogin;
-	pendingLoginMgr_.add(ptinfos);
 
 	if(ctype < UNKNOWN_CLIENT_COMPONENT_TYPE || ctype >= CLIENT_TYPE_END)
 		ctype = UNKNOWN_CLIENT_COMPONENT_TYPE;
@@ -1108,14 +1170,111 @@ void Loginapp::login(Network::Channel* pChannel, MemoryStream& s)
 
 	pChannel->extra(loginName);
 
+	if(needQueue)
+	{
+		loginQueueTickets_[loginName] = loginQueueHead_ + loginQueue_.size();
+		loginQueue_.push_back(ptinfos);
+		++numQueuedLogins_;
+
+		_loginQueued(pChannel, loginName, loginQueue_.size());
+		return;
+	}
+
+	_sendLoginToDbmgr(dbmgrinfos, ptinfos);
+}
+
+//-------------------------------------------------------------------------------------
+void Loginapp::_sendLoginToDbmgr(Components::ComponentInfos* dbmgrinfos, PendingLoginMgr::PLInfos* ptinfos)
+{
+	pendingLoginMgr_.add(ptinfos);
+
 	// dbmgrѯûϷ
 	Network::Bundle* pBundle = Network::Bundle::createPoolObject(OBJECTPOOL_POINT);
 	(*pBundle).newMessage(DbmgrInterface::onAccountLogin);
-	(*pBundle) << loginName << password;
-	(*pBundle).appendBlob(datas);
+	(*pBundle) << ptinfos->accountName << ptinfos->password;
+	(*pBundle).appendBlob(ptinfos->datas);
 	dbmgrinfos->pChannel->send(pBundle);
 }
 
+//-------------------------------------------------------------------------------------
+void Loginapp::_loginQueued(Network::Channel* pChannel, std::string& loginName, uint64 position)
+{
+	std::string datas = fmt::format("loginQueue: {}", position);
+
+	Network::Bundle* pBundle = Network::Bundle::createPoolObject(OBJECTPOOL_POINT);
+	(*pBundle).newMessage(ClientInterface::onLoginFailed);
+	(*pBundle) << (SERVER_ERROR_CODE)SERVER_ERR_BUSY;
+	(*pBundle).appendBlob(datas);
+	pChannel->send(pBundle);
+}
+
+//-------------------------------------------------------------------------------------
+void Loginapp::notifyLoginQueuePositions()
+{
+	// ûƶʱλö䣬 ŶӺܳʱÿ֪ͨһ
+	if(loginQueueNotifiedHead_ == loginQueueHead_)
+		return;
+
+	uint64 now = timestamp();
+	if(now - lastLoginQueueNotifyTime_ < stampsPerSecond())
+		return;
+
+	loginQueueNotifiedHead_ = loginQueueHead_;
+	lastLoginQueueNotifyTime_ = now;
+
+	for(size_t i = 0; i < loginQueue_.size(); ++i)
+	{
+		PendingLoginMgr::PLInfos* ptinfos = loginQueue_[i];
+
+		Network::Channel* pChannel = networkInterface().findChannel(ptinfos->addr);
+		if(pChannel == NULL || pChannel->isDestroyed() || pChannel->extra() != ptinfos->accountName)
+			continue;
+
+		_loginQueued(pChannel, ptinfos->accountName, i + 1);
+	}
+}
+
+//-------------------------------------------------------------------------------------
+void Loginapp::processLoginQueue()
+{
+	if(loginQueue_.size() == 0)
+		return;
+
+	Components::ComponentInfos* dbmgrinfos = Components::getSingleton().getDbmgr();
+	if(dbmgrinfos == NULL || dbmgrinfos->pChannel == NULL || dbmgrinfos->cid == 0)
+		return;
+
+	uint32 maxPending = g_kbeSrvConfig.getLoginApp().loginQueue_maxPending;
+
+	while(loginQueue_.size() > 0 && (maxPending == 0 || pendingLoginMgr_.size() < maxPending))
+	{
+		PendingLoginMgr::PLInfos* ptinfos = loginQueue_.front();
+		loginQueue_.pop_front();
+		loginQueueTickets_.erase(ptinfos->accountName);
+		++loginQueueHead_;
+
+		// ŶڼͻѾϿ
+		Network::Channel* pChannel = networkInterface().findChannel(ptinfos->addr);
+		if(pChannel == NULL || pChannel->isDestroyed() || pChannel->extra() != ptinfos->accountName)
+		{
+			delete ptinfos;
+			continue;
+		}
+
+		if(pendingLoginMgr_.find(ptinfos->accountName) != NULL)
+		{
+			std::string datas = "";
+			_loginFailed(pChannel, ptinfos->accountName, SERVER_ERR_BUSY, datas, true);
+			delete ptinfos;
+			continue;
+		}
+
+		_sendLoginToDbmgr(dbmgrinfos, ptinfos);
+	}
+
+	notifyLoginQueuePositions();
+}
+
 //-------------------------------------------------------------------------------------
 void Loginapp::_loginFailed(Network::Channel* pChannel, std::string& loginName, SERVER_ERROR_CODE failedcode, std::string& datas, bool force)
 {
@@ -1370,6 +1529,11 @@ void Loginapp::onHello(Network::Channel* pChannel,
 	(*pBundle) << digest_;
 	(*pBundle) << g_componentType;
 
+	// ͻAEADʱ֪Э̳ļͣ ľɿͻյϢ
+	int8 encryptType = Network::negotiateEncryptType(Network::g_channelExternalEncryptType, encryptedKey);
+	if (Network::isAEADEncryptionKey(encryptedKey))
+		(*pBundle) << encryptType;
+
 	// Ϣܣ趨ѼܺٴμܣһsendϢǽepoll֪ͨʱһڲԣ滷֣
 	// webЭҪܣԲΪtrue
 	if (pChannel->type() != KBEngine::Network::Channel::CHANNEL_WEB)
@@ -1382,7 +1546,7 @@ void Loginapp::onHello(Network::Channel* pChannel,
 		if(encryptedKey.size() > 3)
 		{
 			// 滻ΪһܵĹ
-			pChannel->pFilter(Network::createEncryptionFilter(Network::g_channelExternalEncryptType, encryptedKey));
+			pChannel->pFilter(Network::createEncryptionFilter(encryptType, encryptedKey));
 		}
 		else
 		{
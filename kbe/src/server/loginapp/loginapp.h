@@ -43,6 +43,7 @@ public:
 	void handleMainTick();
 
 	/* ʼؽӿ */
+	virtual bool initializeWatcher();
 	bool initializeBegin();
 	bool inInitialize();
 	bool initializeEnd();
@@ -130,6 +131,20 @@ public:
 	*/
 	void _loginFailed(Network::Channel* pChannel, std::string& loginName, 
 		SERVER_ERROR_CODE failedcode, std::string& datas, bool force = false);
+
+	/*
+		¼Ŷ
+		ڴеĵ¼loginQueue/maxPendingʱµĵ¼˳Ŷӣ ͨonLoginFailed(SERVER_ERR_BUSY)
+		"loginQueue: λ"֪ͻˣ ǰʱ(ÿһ)ٴθ֪µλã
+		ŶеĿͻظ¼ʱԭλã ͻʹͬһ˺ŵ¼򷵻SERVER_ERR_BUSY
+	*/
+	void _loginQueued(Network::Channel* pChannel, std::string& loginName, uint64 position);
+	void processLoginQueue();
+	void notifyLoginQueuePositions();
+	void _sendLoginToDbmgr(Components::ComponentInfos* dbmgrinfos, PendingLoginMgr::PLInfos* ptinfos);
+
+	uint32 loginQueueSize() const { return (uint32)loginQueue_.size(); }
+	uint32 numPendingLogins() const { return (uint32)pendingLoginMgr_.size(); }
 	
 	/** ӿ
 		dbmgrصĵ¼˺ż
@@ -188,6 +203,14 @@ protected:
 	// ¼¼δϵ˺
 	PendingLoginMgr						pendingLoginMgr_;
 
+	// Ŷӵȴdbmgrĵ¼ Լ˺ӦŶ(ΪloginQueueHead_)
+	std::deque<PendingLoginMgr::PLInfos*>	loginQueue_;
+	KBEUnordered_map<std::string, uint64>	loginQueueTickets_;
+	uint64								loginQueueHead_;
+	uint64								loginQueueNotifiedHead_;
+	uint64								lastLoginQueueNotifyTime_;
+	uint64								numQueuedLogins_;
+
 	std::string							digest_;
 
 	HTTPCBHandler*						pHttpCBHandler;
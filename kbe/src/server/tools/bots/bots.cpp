@@ -3,6 +3,7 @@
 #include "pybots.h"
 #include "bots.h"
 #include "clientobject.h"
+#include "headless_stats.h"
 #include "server/telnet_server.h"
 #include "server/components.h"
 #include "client_lib/entity.h"
@@ -98,6 +99,9 @@ bool Bots::initializeEnd()
 		return false;
 	}
 
+	if(g_kbeSrvConfig.getBots().bots_headless_enable)
+		HeadlessStats::initializeWatcher();
+
 	// нű
 	PyObject* pyResult = PyObject_CallMethod(getEntryScript().get(), 
 										const_cast<char*>("onInit"), 
@@ -292,6 +296,9 @@ void Bots::handleGameTick()
 			pClientObject->gameTick();
 		}
 	}
+
+	if(g_kbeSrvConfig.getBots().bots_headless_enable)
+		HeadlessStats::update();
 }
 
 //-------------------------------------------------------------------------------------
@@ -586,12 +593,12 @@ void Bots::onAppActiveTick(Network::Channel* pChannel, COMPONENT_TYPE componentT
 //-------------------------------------------------------------------------------------
 void Bots::onHelloCB_(Network::Channel* pChannel, const std::string& verInfo, 
 		const std::string& scriptVerInfo, const std::string& protocolMD5, const std::string& entityDefMD5, 
-		COMPONENT_TYPE componentType)
+		COMPONENT_TYPE componentType, int8 encryptType)
 {
 	ClientObject* pClient = findClient(pChannel);
 	if(pClient)
 	{
-		pClient->onHelloCB_(pChannel, verInfo, scriptVerInfo, protocolMD5, entityDefMD5, componentType);
+		pClient->onHelloCB_(pChannel, verInfo, scriptVerInfo, protocolMD5, entityDefMD5, componentType, encryptType);
 	}
 }
 
@@ -136,7 +136,7 @@ public:
 
 	virtual void onHelloCB_(Network::Channel* pChannel, const std::string& verInfo,
 		const std::string& scriptVerInfo, const std::string& protocolMD5, 
-		const std::string& entityDefMD5, COMPONENT_TYPE componentType);
+		const std::string& entityDefMD5, COMPONENT_TYPE componentType, int8 encryptType);
 
 	/** ӿ
 		ͷ˵İ汾ƥ
@@ -38,7 +38,7 @@ ClientObject::ClientObject(std::string name, Network::NetworkInterface& ninterfa
 ClientObjectBase(ninterface, getScriptType()),
 error_(C_ERROR_NONE),
 state_(C_STATE_INIT),
-pBlowfishFilter_(0),
+encryptionKey_(),
 pTCPPacketSenderEx_(NULL),
 pTCPPacketReceiverEx_(NULL),
 pKCPPacketSenderEx_(NULL),
@@ -53,7 +53,6 @@ pKCPPacketReceiverEx_(NULL)
 //-------------------------------------------------------------------------------------
 ClientObject::~ClientObject()
 {
-	SAFE_RELEASE(pBlowfishFilter_);
 }
 
 //-------------------------------------------------------------------------------------		
@@ -189,10 +188,10 @@ bool ClientObject::initCreate()
 	(*pBundle).newMessage(LoginappInterface::hello);
 	(*pBundle) << KBEVersion::versionString() << KBEVersion::scriptVersionString();
 
-	if(Network::g_channelExternalEncryptType == 1)
+	if(Network::g_channelExternalEncryptType > 0)
 	{
-		pBlowfishFilter_ = new Network::BlowfishFilter();
-		(*pBundle).appendBlob(pBlowfishFilter_->key());
+		encryptionKey_ = Network::makeEncryptionKey(Network::g_channelExternalEncryptType);
+		(*pBundle).appendBlob(encryptionKey_);
 	}
 	else
 	{
@@ -289,46 +288,8 @@ bool ClientObject::initLoginBaseapp()
 						return false;
 					}
 
-					pKCPPacketSenderEx_ = new Network::KCPPacketSenderEx(*pUdpEndpoint, this->networkInterface_, this);
-					pKCPPacketReceiverEx_ = new Network::KCPPacketReceiverEx(*pUdpEndpoint, this->networkInterface_, this);
-					connectedBaseapp_ = true;
-					pServerChannel_->id(channelID);
-
-					pServerChannel_->protocoltype(Network::PROTOCOL_UDP);
-					pServerChannel_->protocolSubtype(Network::SUB_PROTOCOL_KCP);
-					pServerChannel_->pPacketSender(pKCPPacketSenderEx_);
-					pServerChannel_->pPacketReceiver(pKCPPacketReceiverEx_);
-					pServerChannel_->setFlags(true, Network::Channel::FLAG_HANDSHAKE);
-
-					if (!pServerChannel_->init_kcp())
-					{
-						ERROR_MSG(fmt::format("ClientObject::initLogin: KCP error! channelID={}\n",
-							pServerChannel_->id()));
-
-						error_ = C_ERROR_INIT_NETWORK_FAILED;
+					if (!initKCPChannel(channelID))
 						return false;
-					}
-
-					Bots::getSingleton().networkInterface().dispatcher().registerReadFileDescriptor((*pUdpEndpoint), pKCPPacketReceiverEx_);
-
-					Network::Bundle* pBundle = Network::Bundle::createPoolObject(OBJECTPOOL_POINT);
-					(*pBundle).newMessage(BaseappInterface::hello);
-					(*pBundle) << KBEVersion::versionString() << KBEVersion::scriptVersionString();
-
-					if (Network::g_channelExternalEncryptType == 1)
-					{
-						pBlowfishFilter_ = new Network::BlowfishFilter();
-						(*pBundle).appendBlob(pBlowfishFilter_->key());
-						pServerChannel_->pFilter(NULL);
-					}
-					else
-					{
-						std::string key = "";
-						(*pBundle).appendBlob(key);
-					}
-
-					pServerChannel_->sendto(true, pBundle);
-					//Network::Bundle::reclaimPoolObject(pBundle);
 				}
 			}
 			else
@@ -389,10 +350,10 @@ bool ClientObject::initLoginBaseapp()
 		(*pBundle).newMessage(BaseappInterface::hello);
 		(*pBundle) << KBEVersion::versionString() << KBEVersion::scriptVersionString();
 
-		if (Network::g_channelExternalEncryptType == 1)
+		if (Network::g_channelExternalEncryptType > 0)
 		{
-			pBlowfishFilter_ = new Network::BlowfishFilter();
-			(*pBundle).appendBlob(pBlowfishFilter_->key());
+			encryptionKey_ = Network::makeEncryptionKey(Network::g_channelExternalEncryptType);
+			(*pBundle).appendBlob(encryptionKey_);
 			pServerChannel_->pFilter(NULL);
 		}
 		else
@@ -410,6 +371,54 @@ bool ClientObject::initLoginBaseapp()
 	return true;
 }
 
+//-------------------------------------------------------------------------------------
+bool ClientObject::initKCPChannel(uint32 channelID)
+{
+	Network::EndPoint* pUdpEndpoint = pServerChannel_->pEndPoint();
+
+	pKCPPacketSenderEx_ = new Network::KCPPacketSenderEx(*pUdpEndpoint, this->networkInterface_, this);
+	pKCPPacketReceiverEx_ = new Network::KCPPacketReceiverEx(*pUdpEndpoint, this->networkInterface_, this);
+	connectedBaseapp_ = true;
+	pServerChannel_->id(channelID);
+
+	pServerChannel_->protocoltype(Network::PROTOCOL_UDP);
+	pServerChannel_->protocolSubtype(Network::SUB_PROTOCOL_KCP);
+	pServerChannel_->pPacketSender(pKCPPacketSenderEx_);
+	pServerChannel_->pPacketReceiver(pKCPPacketReceiverEx_);
+	pServerChannel_->setFlags(true, Network::Channel::FLAG_HANDSHAKE);
+
+	if (!pServerChannel_->init_kcp())
+	{
+		ERROR_MSG(fmt::format("ClientObject::initLogin: KCP error! channelID={}\n",
+			pServerChannel_->id()));
+
+		error_ = C_ERROR_INIT_NETWORK_FAILED;
+		return false;
+	}
+
+	Bots::getSingleton().networkInterface().dispatcher().registerReadFileDescriptor((*pUdpEndpoint), pKCPPacketReceiverEx_);
+
+	Network::Bundle* pBundle = Network::Bundle::createPoolObject(OBJECTPOOL_POINT);
+	(*pBundle).newMessage(BaseappInterface::hello);
+	(*pBundle) << KBEVersion::versionString() << KBEVersion::scriptVersionString();
+
+	if (Network::g_channelExternalEncryptType > 0)
+	{
+		encryptionKey_ = Network::makeEncryptionKey(Network::g_channelExternalEncryptType);
+		(*pBundle).appendBlob(encryptionKey_);
+		pServerChannel_->pFilter(NULL);
+	}
+	else
+	{
+		std::string key = "";
+		(*pBundle).appendBlob(key);
+	}
+
+	pServerChannel_->sendto(true, pBundle);
+	//Network::Bundle::reclaimPoolObject(pBundle);
+	return true;
+}
+
 //-------------------------------------------------------------------------------------
 void ClientObject::gameTick()
 {
@@ -500,12 +509,12 @@ void ClientObject::gameTick()
 //-------------------------------------------------------------------------------------	
 void ClientObject::onHelloCB_(Network::Channel* pChannel, const std::string& verInfo, 
 		const std::string& scriptVerInfo, const std::string& protocolMD5, const std::string& entityDefMD5, 
-		COMPONENT_TYPE componentType)
+		COMPONENT_TYPE componentType, int8 encryptType)
 {
-	if(Network::g_channelExternalEncryptType == 1)
+	if(encryptType > 0 && encryptionKey_.size() > 0)
 	{
-		pServerChannel_->pFilter(pBlowfishFilter_);
-		pBlowfishFilter_ = NULL;
+		pServerChannel_->pFilter(Network::createEncryptionFilter(encryptType, encryptionKey_));
+		encryptionKey_ = "";
 	}
 
 	if(componentType == LOGINAPP_TYPE)
@@ -573,6 +582,13 @@ void ClientObject::onLoginFailed(Network::Channel * pChannel, MemoryStream& s)
 
 	// error_ = C_ERROR_LOGIN_FAILED;
 
+	// ѾloginappŶӣ ȴ¼µ¼
+	if(failedcode == SERVER_ERR_BUSY && serverDatas_.compare(0, 11, "loginQueue:") == 0)
+	{
+		state_ = C_STATE_PLAY;
+		return;
+	}
+
 	// Ե¼
 	state_ = C_STATE_LOGIN;
 }
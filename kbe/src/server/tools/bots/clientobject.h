@@ -54,9 +54,14 @@ public:
 	void clearStates(void);
 
 	bool initCreate();
-	bool initLoginBaseapp();
+	virtual bool initLoginBaseapp();
 
-	void gameTick();
+	/**
+		յbaseappUDPֻӦ˵ϽKCPͨhello
+	*/
+	bool initKCPChannel(uint32 channelID);
+
+	virtual void gameTick();
 
 	ClientObject::C_ERROR lasterror() { return error_; }
 
@@ -65,7 +70,7 @@ public:
 
 	virtual void onHelloCB_(Network::Channel* pChannel, const std::string& verInfo,
 		const std::string& scriptVerInfo, const std::string& protocolMD5, 
-		const std::string& entityDefMD5, COMPONENT_TYPE componentType);
+		const std::string& entityDefMD5, COMPONENT_TYPE componentType, int8 encryptType);
 
 	/** ӿ
 		˺ųɹʧܻص
@@ -100,7 +105,7 @@ public:
 protected:
 	C_ERROR error_;
 	C_STATE state_;
-	Network::BlowfishFilter* pBlowfishFilter_;
+	std::string encryptionKey_;
 
 	Network::TCPPacketSenderEx* pTCPPacketSenderEx_;
 	Network::TCPPacketReceiverEx* pTCPPacketReceiverEx_;
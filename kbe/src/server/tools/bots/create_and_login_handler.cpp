@@ -2,6 +2,7 @@
 
 #include "bots.h"
 #include "clientobject.h"
+#include "headless_client.h"
 #include "create_and_login_handler.h"
 #include "network/network_interface.h"
 #include "network/event_dispatcher.h"
@@ -53,9 +54,15 @@ void CreateAndLoginHandler::handleTimeout(TimerHandle handle, void * arg)
 
 	while(bots.reqCreateAndLoginTotalCount() - bots.clients().size() > 0 && count-- > 0)
 	{
-		ClientObject* pClient = new ClientObject(g_kbeSrvConfig.getBots().bots_account_name_prefix + 
-			KBEngine::StringConv::val2str(g_componentID) + "_" + KBEngine::StringConv::val2str(g_accountID++), 
-			Bots::getSingleton().networkInterface());
+		std::string name = g_kbeSrvConfig.getBots().bots_account_name_prefix + 
+			KBEngine::StringConv::val2str(g_componentID) + "_" + KBEngine::StringConv::val2str(g_accountID++);
+
+		ClientObject* pClient = NULL;
+
+		if(g_kbeSrvConfig.getBots().bots_headless_enable)
+			pClient = new HeadlessClient(name, Bots::getSingleton().networkInterface());
+		else
+			pClient = new ClientObject(name, Bots::getSingleton().networkInterface());
 
 		Bots::getSingleton().addClient(pClient);
 	}
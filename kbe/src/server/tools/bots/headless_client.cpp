@@ -0,0 +1,752 @@
+// Copyright 2008-2018 Yolo Technologies, Inc. All Rights Reserved. https://www.comblockengine.com
+
+#include "bots.h"
+#include "headless_client.h"
+#include "headless_stats.h"
+#include "network/common.h"
+#include "network/bundle.h"
+#include "network/udp_packet.h"
+#include "network/event_dispatcher.h"
+#include "server/serverconfig.h"
+#include "entitydef/method.h"
+#include "entitydef/datatype.h"
+#include "entitydef/scriptdef_module.h"
+#include "entitydef/entitydef.h"
+#include "common/kbeversion.h"
+
+#include "baseapp/baseapp_interface.h"
+
+namespace KBEngine{
+
+// ʱûյӦΪRPCʱ
+#define HEADLESS_RPC_TIMEOUT 10
+
+std::map<ScriptDefModule*, HeadlessClient::RPC_PLANS> HeadlessClient::rpcPlans_;
+
+//-------------------------------------------------------------------------------------
+static uint64 stampsToMicroseconds(uint64 stamps)
+{
+	return stamps * 1000000 / stampsPerSecond();
+}
+
+//-------------------------------------------------------------------------------------
+HeadlessClient::HeadlessClient(std::string name, Network::NetworkInterface& ninterface):
+ClientObject(name, ninterface),
+pScriptModule_(NULL),
+pRPCPlans_(NULL),
+rpcStates_(),
+inWorld_(false),
+hasPosition_(false),
+isOnGround_(true),
+position_(),
+moveCenter_(),
+moveAngle_(0.f),
+lastMoveTime_(0),
+loginStartTime_(timestamp()),
+loginTimeRecorded_(false),
+enterWorldTimeRecorded_(false),
+lastDeliveryTime_(0),
+deliveryBurstTime_(0),
+udpHelloTime_(0)
+{
+}
+
+//-------------------------------------------------------------------------------------
+HeadlessClient::~HeadlessClient()
+{
+}
+
+//-------------------------------------------------------------------------------------
+void HeadlessClient::reset(void)
+{
+	stopWaitingUDPAck();
+	inWorld(false);
+
+	pScriptModule_ = NULL;
+	pRPCPlans_ = NULL;
+	rpcStates_.clear();
+	hasPosition_ = false;
+	moveAngle_ = 0.f;
+	lastMoveTime_ = 0;
+	loginStartTime_ = timestamp();
+	loginTimeRecorded_ = false;
+	enterWorldTimeRecorded_ = false;
+	lastDeliveryTime_ = 0;
+	deliveryBurstTime_ = 0;
+
+	ClientObject::reset();
+}
+
+//-------------------------------------------------------------------------------------
+void HeadlessClient::inWorld(bool v)
+{
+	if (inWorld_ == v)
+		return;
+
+	inWorld_ = v;
+
+	if (v)
+		++HeadlessStats::numInWorld;
+	else
+		--HeadlessStats::numInWorld;
+}
+
+//-------------------------------------------------------------------------------------
+bool HeadlessClient::initLoginBaseapp()
+{
+	if (udp_port_ == 0)
+		return ClientObject::initLoginBaseapp();
+
+	clearStates();
+
+	connectedBaseapp_ = false;
+	pServerChannel_->id(0);
+
+	// ClientObjectͬ ﲻȴUDPֻӦ ǧͬʱ¼ʱ
+	Network::EndPoint* pUdpEndpoint = Network::EndPoint::createPoolObject(OBJECTPOOL_POINT);
+
+	pUdpEndpoint->socket(SOCK_DGRAM);
+	if (!pUdpEndpoint->good())
+	{
+		ERROR_MSG("HeadlessClient::initLoginBaseapp: couldn't create a udp-socket\n");
+		Network::EndPoint::reclaimPoolObject(pUdpEndpoint);
+		error_ = C_ERROR_INIT_NETWORK_FAILED;
+		return false;
+	}
+
+	Network::Address udp_addr(ip_.c_str(), udp_port_);
+	pUdpEndpoint->addr(udp_addr);
+	pServerChannel_->pEndPoint(pUdpEndpoint);
+	pUdpEndpoint->setnonblocking(true);
+	pUdpEndpoint->setnodelay(true);
+
+	if (pUdpEndpoint->sendto((void*)Network::UDP_HELLO, strlen(Network::UDP_HELLO)) == -1)
+	{
+		ERROR_MSG(fmt::format("HeadlessClient::initLoginBaseapp: sendto error({})\n", kbe_lasterror()));
+		fallbackToTCP();
+		return false;
+	}
+
+	Bots::getSingleton().networkInterface().dispatcher().registerReadFileDescriptor((*pUdpEndpoint), this);
+	udpHelloTime_ = timestamp();
+
+	// δɣ falseʹtickٷ
+	return false;
+}
+
+//-------------------------------------------------------------------------------------
+void HeadlessClient::stopWaitingUDPAck()
+{
+	if (udpHelloTime_ == 0)
+		return;
+
+	udpHelloTime_ = 0;
+
+	if (pServerChannel_ && pServerChannel_->pEndPoint())
+		Bots::getSingleton().networkInterface().dispatcher().deregisterReadFileDescriptor(*pServerChannel_->pEndPoint());
+}
+
+//-------------------------------------------------------------------------------------
+void HeadlessClient::fallbackToTCP()
+{
+	stopWaitingUDPAck();
+
+	// һticktcp¼baseapp
+	udp_port_ = 0;
+	state_ = C_STATE_LOGIN_BASEAPP_CREATE;
+}
+
+//-------------------------------------------------------------------------------------
+int HeadlessClient::handleInputNotification(int fd)
+{
+	Network::EndPoint* pUdpEndpoint = pServerChannel_->pEndPoint();
+	stopWaitingUDPAck();
+
+	if (pUdpEndpoint == NULL)
+		return 0;
+
+	Network::UDPPacket* pHelloAckUDPPacket = Network::UDPPacket::createPoolObject(OBJECTPOOL_POINT);
+
+	sockaddr_in remoteAddr;
+	int bytes_rcvd = pUdpEndpoint->recvfrom(pHelloAckUDPPacket->data(), pHelloAckUDPPacket->size(), remoteAddr);
+	if (bytes_rcvd <= 0)
+	{
+		Network::UDPPacket::reclaimPoolObject(pHelloAckUDPPacket);
+		ERROR_MSG(fmt::format("HeadlessClient::handleInputNotification: recvfrom error({})\n", kbe_lasterror()));
+		fallbackToTCP();
+		return 0;
+	}
+
+	std::string helloAck, versionString;
+	uint32 channelID = 0;
+
+	pHelloAckUDPPacket->wpos(bytes_rcvd);
+	(*pHelloAckUDPPacket) >> helloAck >> versionString >> channelID;
+	Network::UDPPacket::reclaimPoolObject(pHelloAckUDPPacket);
+
+	if (Network::UDP_HELLO_ACK != helloAck)
+	{
+		fallbackToTCP();
+		return 0;
+	}
+
+	if (versionString != KBEVersion::versionString())
+	{
+		ERROR_MSG(fmt::format("HeadlessClient::handleInputNotification: Version mismatch! {} != serverVersionString({})\n",
+			KBEVersion::versionString(), versionString));
+
+		error_ = C_ERROR_INIT_NETWORK_FAILED;
+		return 0;
+	}
+
+	initKCPChannel(channelID);
+	return 0;
+}
+
+//-------------------------------------------------------------------------------------
+void HeadlessClient::gameTick()
+{
+	if (udpHelloTime_ > 0)
+	{
+		if (timestamp() - udpHelloTime_ < stampsPerSecond())
+			return;
+
+		ERROR_MSG(fmt::format("HeadlessClient::gameTick({}): wait udp-hello-ack timeout, fallback to tcp!\n", name_));
+		fallbackToTCP();
+	}
+
+	if (state_ == C_STATE_INIT)
+	{
+		loginStartTime_ = timestamp();
+		loginTimeRecorded_ = false;
+		enterWorldTimeRecorded_ = false;
+		inWorld(false);
+	}
+
+	ClientObject::gameTick();
+}
+
+//-------------------------------------------------------------------------------------
+const HeadlessClient::RPC_PLANS& HeadlessClient::getRPCPlans(ScriptDefModule* pScriptModule)
+{
+	std::map<ScriptDefModule*, RPC_PLANS>::iterator iter = rpcPlans_.find(pScriptModule);
+	if (iter != rpcPlans_.end())
+		return iter->second;
+
+	RPC_PLANS& plans = rpcPlans_[pScriptModule];
+
+	const std::vector<BotsHeadlessRPC>& rpcs = g_kbeSrvConfig.getBots().bots_headless_rpcs;
+	std::vector<BotsHeadlessRPC>::const_iterator rpcIter = rpcs.begin();
+	for (; rpcIter != rpcs.end(); ++rpcIter)
+	{
+		const BotsHeadlessRPC& rpc = (*rpcIter);
+
+		std::string::size_type pos = rpc.method.find('.');
+		std::string component = rpc.method.substr(0, pos);
+		std::string name = (pos == std::string::npos) ? "" : rpc.method.substr(pos + 1);
+
+		if (name.size() == 0 || (component != "base" && component != "cell"))
+		{
+			ERROR_MSG(fmt::format("HeadlessClient::getRPCPlans: invalid method({}), must be base.name or cell.name!\n",
+				rpc.method));
+
+			continue;
+		}
+
+		RPCPlan plan;
+		plan.isCell = (component == "cell");
+		plan.hasReply = false;
+		plan.replyID = 0;
+		plan.period = uint64(rpc.period * stampsPerSecond());
+
+		MethodDescription* pMethodDescription = plan.isCell ?
+			pScriptModule->findCellMethodDescription(name.c_str()) :
+			pScriptModule->findBaseMethodDescription(name.c_str());
+
+		// ʵͿû ʱ
+		if (pMethodDescription == NULL || !pMethodDescription->isExposed())
+			continue;
+
+		// ͻEntityCallı뱣һ
+		MemoryStream s;
+		s << (ENTITY_PROPERTY_UID)0;
+
+		if (pMethodDescription->aliasID() > 0)
+			s << (uint8)pMethodDescription->aliasID();
+		else
+			s << pMethodDescription->getUType();
+
+		bool ok = true;
+
+		std::vector<DataType*>& argTypes = pMethodDescription->getArgTypes();
+		std::vector<DataType*>::iterator argIter = argTypes.begin();
+		for (; argIter != argTypes.end(); ++argIter)
+		{
+			PyObject* pyVal = (*argIter)->parseDefaultStr("");
+			if (pyVal == NULL)
+			{
+				SCRIPT_ERROR_CHECK();
+				ok = false;
+				break;
+			}
+
+			(*argIter)->addToStream(&s, pyVal);
+			Py_DECREF(pyVal);
+		}
+
+		if (!ok)
+		{
+			ERROR_MSG(fmt::format("HeadlessClient::getRPCPlans: {}.{} encode default args failed!\n",
+				pScriptModule->getName(), rpc.method));
+
+			continue;
+		}
+
+		plan.payload.assign((const char*)s.data() + s.rpos(), s.length());
+
+		if (rpc.reply.size() > 0)
+		{
+			MethodDescription* pReplyDescription = pScriptModule->findClientMethodDescription(rpc.reply.c_str());
+			if (pReplyDescription == NULL)
+			{
+				ERROR_MSG(fmt::format("HeadlessClient::getRPCPlans: {} not found client method({})!\n",
+					pScriptModule->getName(), rpc.reply));
+			}
+			else
+			{
+				plan.hasReply = true;
+				plan.replyID = pScriptModule->useMethodDescrAlias() ?
+					(uint16)pReplyDescription->aliasID() : (uint16)pReplyDescription->getUType();
+			}
+		}
+
+		plans.push_back(plan);
+	}
+
+	return plans;
+}
+
+//-------------------------------------------------------------------------------------
+void HeadlessClient::onCreatedProxies(Network::Channel * pChannel, uint64 rndUUID,
+	ENTITY_ID eid, std::string& entityType)
+{
+	entityID_ = eid;
+	rndUUID_ = rndUUID;
+	connectedBaseapp_ = true;
+
+	if (!loginTimeRecorded_)
+	{
+		loginTimeRecorded_ = true;
+		HeadlessStats::loginTime.add(stampsToMicroseconds(timestamp() - loginStartTime_));
+	}
+
+	pScriptModule_ = EntityDef::findScriptModule(entityType.c_str());
+	if (pScriptModule_ == NULL)
+	{
+		pRPCPlans_ = NULL;
+		rpcStates_.clear();
+		return;
+	}
+
+	pRPCPlans_ = &getRPCPlans(pScriptModule_);
+
+	// ˵״εã еüͬһtick
+	uint64 now = timestamp();
+	rpcStates_.resize(pRPCPlans_->size());
+
+	for (size_t i = 0; i < pRPCPlans_->size(); ++i)
+	{
+		uint64 period = (*pRPCPlans_)[i].period;
+		rpcStates_[i].nextSendTime = now + (period > 0 ? (uint64)rand() % period : 0);
+		rpcStates_[i].sentTime = 0;
+	}
+}
+
+//-------------------------------------------------------------------------------------
+void HeadlessClient::onEntityEnterWorld(Network::Channel * pChannel, MemoryStream& s)
+{
+	ENTITY_ID eid = 0;
+	ENTITY_SCRIPT_UID scriptType;
+	int8 isOnGround = 1;
+
+	s >> eid;
+
+	if (EntityDef::scriptModuleAliasID())
+	{
+		ENTITY_DEF_ALIASID aliasID;
+		s >> aliasID;
+		scriptType = aliasID;
+	}
+	else
+	{
+		s >> scriptType;
+	}
+
+	if (s.length() > 0)
+		s >> isOnGround;
+
+	if (eid != entityID_)
+	{
+		if (entityID_ > 0)
+			pEntityIDAliasIDList_.push_back(eid);
+
+		++HeadlessStats::entityEnters;
+		return;
+	}
+
+	// ClientObjectBase::onEntityEnterWorld Ȩлǰʵ
+	pEntityIDAliasIDList_.clear();
+
+	isOnGround_ = isOnGround > 0;
+	inWorld(true);
+
+	if (!enterWorldTimeRecorded_)
+	{
+		enterWorldTimeRecorded_ = true;
+		HeadlessStats::enterWorldTime.add(stampsToMicroseconds(timestamp() - loginStartTime_));
+	}
+}
+
+//-------------------------------------------------------------------------------------
+void HeadlessClient::onEntityLeaveWorld(Network::Channel * pChannel, ENTITY_ID eid)
+{
+	if (eid != entityID_)
+	{
+		pEntityIDAliasIDList_.erase(std::remove(pEntityIDAliasIDList_.begin(),
+			pEntityIDAliasIDList_.end(), eid), pEntityIDAliasIDList_.end());
+
+		return;
+	}
+
+	inWorld(false);
+	pEntityIDAliasIDList_.clear();
+	hasPosition_ = false;
+	spaceID_ = 0;
+}
+
+//-------------------------------------------------------------------------------------
+void HeadlessClient::onEntityDestroyed(Network::Channel * pChannel, ENTITY_ID eid)
+{
+}
+
+//-------------------------------------------------------------------------------------
+void HeadlessClient::onEntityEnterSpace(Network::Channel * pChannel, MemoryStream& s)
+{
+	ENTITY_ID eid = 0;
+	SPACE_ID spaceID = 0;
+
+	s >> eid;
+	s >> spaceID;
+	s.done();
+
+	if (eid != entityID_)
+		return;
+
+	// лspace ȴͬµλúȷƶԲ
+	spaceID_ = spaceID;
+	hasPosition_ = false;
+}
+
+//-------------------------------------------------------------------------------------
+void HeadlessClient::onEntityLeaveSpace(Network::Channel * pChannel, ENTITY_ID eid)
+{
+	if (eid != entityID_)
+		return;
+
+	pEntityIDAliasIDList_.clear();
+	hasPosition_ = false;
+	spaceID_ = 0;
+}
+
+//-------------------------------------------------------------------------------------
+void HeadlessClient::onRemoteMethodCall(Network::Channel* pChannel, MemoryStream& s)
+{
+	ENTITY_ID eid = 0;
+	s >> eid;
+	onRemoteMethodCall_(eid, s);
+}
+
+//-------------------------------------------------------------------------------------
+void HeadlessClient::onRemoteMethodCallOptimized(Network::Channel* pChannel, MemoryStream& s)
+{
+	ENTITY_ID eid = getViewEntityIDFromStream(s);
+	onRemoteMethodCall_(eid, s);
+}
+
+//-------------------------------------------------------------------------------------
+void HeadlessClient::onRemoteMethodCall_(ENTITY_ID eid, MemoryStream& s)
+{
+	if (eid != entityID_ || pScriptModule_ == NULL || pRPCPlans_ == NULL)
+	{
+		s.done();
+		return;
+	}
+
+	// ʽclient::Entity::onRemoteMethodCall
+	bool isComponentCall = false;
+
+	if (pScriptModule_->usePropertyDescrAlias())
+	{
+		uint8 componentPropertyAliasID = 0;
+		s >> componentPropertyAliasID;
+		isComponentCall = componentPropertyAliasID > 0;
+	}
+	else
+	{
+		ENTITY_PROPERTY_UID componentPropertyUID = 0;
+		s >> componentPropertyUID;
+		isComponentCall = componentPropertyUID > 0;
+	}
+
+	uint16 methodID = 0;
+
+	if (pScriptModule_->useMethodDescrAlias())
+	{
+		ENTITY_DEF_ALIASID aliasID = 0;
+		s >> aliasID;
+		methodID = aliasID;
+	}
+	else
+	{
+		ENTITY_METHOD_UID utype = 0;
+		s >> utype;
+		methodID = utype;
+	}
+
+	s.done();
+
+	if (isComponentCall)
+		return;
+
+	uint64 now = timestamp();
+
+	for (size_t i = 0; i < pRPCPlans_->size(); ++i)
+	{
+		const RPCPlan& plan = (*pRPCPlans_)[i];
+		RPCState& state = rpcStates_[i];
+
+		if (!plan.hasReply || plan.replyID != methodID || state.sentTime == 0)
+			continue;
+
+		HeadlessStats::rpcRoundTrip.add(stampsToMicroseconds(now - state.sentTime));
+		state.sentTime = 0;
+	}
+}
+
+//-------------------------------------------------------------------------------------
+void HeadlessClient::onUpdatePropertys(Network::Channel* pChannel, MemoryStream& s)
+{
+	s.done();
+}
+
+//-------------------------------------------------------------------------------------
+void HeadlessClient::onUpdatePropertysOptimized(Network::Channel* pChannel, MemoryStream& s)
+{
+	s.done();
+}
+
+//-------------------------------------------------------------------------------------
+void HeadlessClient::anchor(const Position3D& pos)
+{
+	float radius = g_kbeSrvConfig.getBots().bots_headless_moveRadius;
+
+	position_ = pos;
+	moveCenter_ = pos;
+	moveCenter_.x -= radius * cos(moveAngle_);
+	moveCenter_.z -= radius * sin(moveAngle_);
+	hasPosition_ = true;
+}
+
+//-------------------------------------------------------------------------------------
+void HeadlessClient::onSetEntityPosAndDir(Network::Channel* pChannel, MemoryStream& s)
+{
+	ENTITY_ID eid = 0;
+	s >> eid;
+
+	if (eid != entityID_)
+	{
+		s.done();
+		return;
+	}
+
+	Position3D pos;
+	float yaw, pitch, roll;
+	s >> pos.x >> pos.y >> pos.z >> roll >> pitch >> yaw;
+
+	// ǿλã λüȦ
+	anchor(pos);
+}
+
+//-------------------------------------------------------------------------------------
+void HeadlessClient::onUpdateBasePos(Network::Channel* pChannel, float x, float y, float z)
+{
+	// ֮յǷ˶ԱƶĻԣ ֻڵһʱȷԲ
+	if (!hasPosition_)
+		anchor(Position3D(x, y, z));
+
+	onDelivery();
+}
+
+//-------------------------------------------------------------------------------------
+void HeadlessClient::onUpdateBasePosXZ(Network::Channel* pChannel, float x, float z)
+{
+	if (!hasPosition_)
+		anchor(Position3D(x, position_.y, z));
+
+	onDelivery();
+}
+
+//-------------------------------------------------------------------------------------
+void HeadlessClient::onUpdateData(Network::Channel* pChannel, MemoryStream& s)
+{
+	s.done();
+	onDelivery();
+}
+
+//-------------------------------------------------------------------------------------
+void HeadlessClient::_updateVolatileData(ENTITY_ID entityID, float x, float y, float z, float roll,
+	float pitch, float yaw, int8 isOnGround, bool isOptimized)
+{
+	onDelivery();
+}
+
+//-------------------------------------------------------------------------------------
+void HeadlessClient::onDelivery()
+{
+	// ÿtickͬһԷͻˣ tickϢΪµһ
+	// ͳĵ
+	uint64 now = timestamp();
+	uint64 burstGap = stampsPerSecond() / (g_kbeSrvConfig.gameUpdateHertz() * 2);
+
+	if (deliveryBurstTime_ == 0)
+	{
+		deliveryBurstTime_ = now;
+	}
+	else if (now - lastDeliveryTime_ > burstGap)
+	{
+		HeadlessStats::delivery.add(stampsToMicroseconds(now - deliveryBurstTime_));
+		deliveryBurstTime_ = now;
+	}
+
+	lastDeliveryTime_ = now;
+}
+
+//-------------------------------------------------------------------------------------
+void HeadlessClient::onControlEntity(Network::Channel* pChannel, int32 eid, int8 p_isControlled)
+{
+}
+
+//-------------------------------------------------------------------------------------
+void HeadlessClient::updatePlayerToServer()
+{
+	if (!pServerChannel_ || !pServerChannel_->pEndPoint() || !connectedBaseapp_ || entityID_ == 0)
+		return;
+
+	uint64 now = timestamp();
+
+	updateMove(now);
+	updateRPCs(now);
+}
+
+//-------------------------------------------------------------------------------------
+void HeadlessClient::updateMove(uint64 now)
+{
+	ENGINE_COMPONENT_INFO& infos = g_kbeSrvConfig.getBots();
+
+	if (!inWorld_ || !hasPosition_ || spaceID_ == 0 || infos.bots_headless_moveSpeed <= 0.f)
+		return;
+
+	if (lastMoveTime_ == 0)
+	{
+		lastMoveTime_ = now;
+		return;
+	}
+
+	if (now - lastMoveTime_ < stampsPerSecond() / infos.bots_headless_moveHertz)
+		return;
+
+	float elapsed = float(now - lastMoveTime_) / stampsPerSecond();
+	lastMoveTime_ = now;
+
+	moveAngle_ += infos.bots_headless_moveSpeed * elapsed / infos.bots_headless_moveRadius;
+	if (moveAngle_ > KBE_2PI)
+		moveAngle_ -= float(KBE_2PI);
+
+	position_.x = moveCenter_.x + infos.bots_headless_moveRadius * cos(moveAngle_);
+	position_.z = moveCenter_.z + infos.bots_headless_moveRadius * sin(moveAngle_);
+
+	// Բܵ߷
+	float yaw = moveAngle_ + float(KBE_PI) / 2.f;
+	if (yaw > KBE_PI)
+		yaw -= float(KBE_2PI);
+
+	Network::Bundle* pBundle = Network::Bundle::createPoolObject(OBJECTPOOL_POINT);
+	(*pBundle).newMessage(BaseappInterface::onUpdateDataFromClient);
+
+	(*pBundle) << position_.x;
+	(*pBundle) << position_.y;
+	(*pBundle) << position_.z;
+
+	(*pBundle) << 0.f;
+	(*pBundle) << 0.f;
+	(*pBundle) << yaw;
+
+	(*pBundle) << isOnGround_;
+	(*pBundle) << spaceID_;
+	pServerChannel_->send(pBundle);
+
+	++HeadlessStats::movesSent;
+}
+
+//-------------------------------------------------------------------------------------
+void HeadlessClient::updateRPCs(uint64 now)
+{
+	if (pRPCPlans_ == NULL)
+		return;
+
+	uint64 timeout = HEADLESS_RPC_TIMEOUT * stampsPerSecond();
+
+	for (size_t i = 0; i < pRPCPlans_->size(); ++i)
+	{
+		const RPCPlan& plan = (*pRPCPlans_)[i];
+		RPCState& state = rpcStates_[i];
+
+		// cellϵķҽ
+		if (plan.isCell && !inWorld_)
+			continue;
+
+		// ÿͬʱֻһڵȴӦ
+		if (state.sentTime > 0)
+		{
+			if (now - state.sentTime < timeout)
+				continue;
+
+			++HeadlessStats::rpcTimeouts;
+			state.sentTime = 0;
+		}
+
+		if (now < state.nextSendTime)
+			continue;
+
+		state.nextSendTime = now + plan.period;
+
+		if (plan.hasReply)
+			state.sentTime = now;
+
+		Network::Bundle* pBundle = Network::Bundle::createPoolObject(OBJECTPOOL_POINT);
+
+		if (plan.isCell)
+			(*pBundle).newMessage(BaseappInterface::onRemoteCallCellMethodFromClient);
+		else
+			(*pBundle).newMessage(BaseappInterface::onRemoteMethodCall);
+
+		(*pBundle) << entityID_;
+		(*pBundle).append(plan.payload.data(), (int)plan.payload.size());
+		pServerChannel_->send(pBundle);
+
+		++HeadlessStats::rpcSent;
+	}
+}
+
+//-------------------------------------------------------------------------------------
+}
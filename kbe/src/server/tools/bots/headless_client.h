@@ -0,0 +1,130 @@
+// Copyright 2008-2018 Yolo Technologies, Inc. All Rights Reserved. https://www.comblockengine.com
+
+#ifndef KBE_HEADLESS_CLIENT_H
+#define KBE_HEADLESS_CLIENT_H
+
+#include "clientobject.h"
+#include "network/interfaces.h"
+#include "math/math.h"
+
+namespace KBEngine {
+
+class ScriptDefModule;
+
+/*
+	ͷ
+	ClientObjectĵ¼KCPͨ pythonʵ壬 ֻõĳطƶRPC¼ӳ٣
+	ڵǧӶԼȺѹ
+*/
+class HeadlessClient : public ClientObject, public Network::InputNotificationHandler
+{
+public:
+	/*
+		ʵԤȱõһRPC
+	*/
+	struct RPCPlan
+	{
+		bool isCell;
+		std::string payload;				// ʵID֮ȫݣ ʹĬֵ
+		bool hasReply;
+		uint16 replyID;						// ΪӦĿͻ˷aliasIDutype
+		uint64 period;
+	};
+
+	struct RPCState
+	{
+		uint64 nextSendTime;
+		uint64 sentTime;					// ȴӦеĵ÷ʱ䣬 0Ϊû
+	};
+
+	typedef std::vector<RPCPlan> RPC_PLANS;
+
+	HeadlessClient(std::string name, Network::NetworkInterface& ninterface);
+	virtual ~HeadlessClient();
+
+	virtual void reset(void);
+
+	virtual bool initLoginBaseapp();
+	virtual void gameTick();
+
+	virtual int handleInputNotification(int fd);
+
+	virtual void onCreatedProxies(Network::Channel * pChannel, uint64 rndUUID,
+		ENTITY_ID eid, std::string& entityType);
+
+	virtual void onEntityEnterWorld(Network::Channel * pChannel, MemoryStream& s);
+	virtual void onEntityLeaveWorld(Network::Channel * pChannel, ENTITY_ID eid);
+	virtual void onEntityDestroyed(Network::Channel * pChannel, ENTITY_ID eid);
+	virtual void onEntityEnterSpace(Network::Channel * pChannel, MemoryStream& s);
+	virtual void onEntityLeaveSpace(Network::Channel * pChannel, ENTITY_ID eid);
+
+	virtual void onRemoteMethodCall(Network::Channel* pChannel, MemoryStream& s);
+	virtual void onRemoteMethodCallOptimized(Network::Channel* pChannel, MemoryStream& s);
+
+	virtual void onUpdatePropertys(Network::Channel* pChannel, MemoryStream& s);
+	virtual void onUpdatePropertysOptimized(Network::Channel* pChannel, MemoryStream& s);
+
+	virtual void onSetEntityPosAndDir(Network::Channel* pChannel, MemoryStream& s);
+	virtual void onUpdateBasePos(Network::Channel* pChannel, float x, float y, float z);
+	virtual void onUpdateBasePosXZ(Network::Channel* pChannel, float x, float z);
+	virtual void onUpdateData(Network::Channel* pChannel, MemoryStream& s);
+
+	virtual void _updateVolatileData(ENTITY_ID entityID, float x, float y, float z, float roll,
+		float pitch, float yaw, int8 isOnGround, bool isOptimized);
+
+	virtual void updatePlayerToServer();
+
+	virtual void onControlEntity(Network::Channel* pChannel, int32 eid, int8 p_isControlled);
+
+	/**
+		ĳʵ͵RPC ÿʵֻһ
+	*/
+	static const RPC_PLANS& getRPCPlans(ScriptDefModule* pScriptModule);
+
+protected:
+	void onRemoteMethodCall_(ENTITY_ID eid, MemoryStream& s);
+
+	void inWorld(bool v);
+
+	/**
+		posΪԲϵǰǶȵĵȷƶԲ
+	*/
+	void anchor(const Position3D& pos);
+
+	void onDelivery();
+
+	void updateMove(uint64 now);
+	void updateRPCs(uint64 now);
+
+	void stopWaitingUDPAck();
+	void fallbackToTCP();
+
+	ScriptDefModule* pScriptModule_;
+	const RPC_PLANS* pRPCPlans_;
+	std::vector<RPCState> rpcStates_;
+
+	bool inWorld_;
+	bool hasPosition_;
+	bool isOnGround_;
+
+	Position3D position_;
+	Position3D moveCenter_;
+	float moveAngle_;
+	uint64 lastMoveTime_;
+
+	uint64 loginStartTime_;
+	bool loginTimeRecorded_;
+	bool enterWorldTimeRecorded_;
+
+	uint64 lastDeliveryTime_;
+	uint64 deliveryBurstTime_;
+
+	uint64 udpHelloTime_;
+
+	static std::map<ScriptDefModule*, RPC_PLANS> rpcPlans_;
+};
+
+
+}
+
+#endif // KBE_HEADLESS_CLIENT_H
@@ -0,0 +1,287 @@
+// Copyright 2008-2018 Yolo Technologies, Inc. All Rights Reserved. https://www.comblockengine.com
+
+#include "bots.h"
+#include "headless_stats.h"
+#include "network/common.h"
+#include "server/serverconfig.h"
+#include "helper/watcher.h"
+
+namespace KBEngine {
+
+LatencyHistogram HeadlessStats::loginTime;
+LatencyHistogram HeadlessStats::enterWorldTime;
+LatencyHistogram HeadlessStats::rpcRoundTrip;
+LatencyHistogram HeadlessStats::delivery;
+
+uint64 HeadlessStats::rpcSent = 0;
+uint64 HeadlessStats::rpcTimeouts = 0;
+uint64 HeadlessStats::movesSent = 0;
+uint64 HeadlessStats::entityEnters = 0;
+uint32 HeadlessStats::numInWorld = 0;
+
+uint64 HeadlessStats::bytesSentPerSecond = 0;
+uint64 HeadlessStats::bytesReceivedPerSecond = 0;
+
+uint64 HeadlessStats::kcpUpdatesPerSecond = 0;
+uint64 HeadlessStats::kcpPassesPerSecond = 0;
+uint64 HeadlessStats::timerCallsPerSecond = 0;
+uint64 HeadlessStats::sendSyscallsPerSecond = 0;
+
+uint64 HeadlessStats::packetsSentPerSecond = 0;
+uint64 HeadlessStats::packetsReceivedPerSecond = 0;
+uint64 HeadlessStats::udpRecvSyscallsPerSecond = 0;
+uint64 HeadlessStats::udpRecvDatagramsPerSecond = 0;
+
+uint64 HeadlessStats::allInWorldTime = 0;
+
+uint64 HeadlessStats::startTime_ = 0;
+uint64 HeadlessStats::lastRateTime_ = 0;
+uint64 HeadlessStats::lastBytesSent_ = 0;
+uint64 HeadlessStats::lastBytesReceived_ = 0;
+uint64 HeadlessStats::lastKcpUpdates_ = 0;
+uint64 HeadlessStats::lastKcpPasses_ = 0;
+uint32 HeadlessStats::lastTimerCalls_ = 0;
+uint64 HeadlessStats::lastSendSyscalls_ = 0;
+uint64 HeadlessStats::lastPacketsSent_ = 0;
+uint64 HeadlessStats::lastPacketsReceived_ = 0;
+uint64 HeadlessStats::lastUdpRecvSyscalls_ = 0;
+uint64 HeadlessStats::lastUdpRecvDatagrams_ = 0;
+uint64 HeadlessStats::lastReportTime_ = 0;
+
+//-------------------------------------------------------------------------------------
+LatencyHistogram::LatencyHistogram():
+count_(0),
+sum_(0),
+max_(0)
+{
+	memset(buckets_, 0, sizeof(buckets_));
+}
+
+//-------------------------------------------------------------------------------------
+uint32 LatencyHistogram::bucketIndex(uint64 us)
+{
+	if (us < 4)
+		return (uint32)us;
+
+	uint32 msb = 0;
+	uint64 v = us;
+	while (v >>= 1)
+		++msb;
+
+	// λ֮λڵͰ
+	return (msb - 1) * 4 + (uint32)((us >> (msb - 2)) & 3);
+}
+
+//-------------------------------------------------------------------------------------
+uint64 LatencyHistogram::bucketLowerBound(uint32 idx)
+{
+	if (idx < 4)
+		return idx;
+
+	uint32 msb = idx / 4 + 1;
+	return (uint64)(4 + (idx % 4)) << (msb - 2);
+}
+
+//-------------------------------------------------------------------------------------
+void LatencyHistogram::add(uint64 us)
+{
+	++buckets_[bucketIndex(us)];
+	++count_;
+	sum_ += us;
+
+	if (us > max_)
+		max_ = us;
+}
+
+//-------------------------------------------------------------------------------------
+void LatencyHistogram::reset()
+{
+	memset(buckets_, 0, sizeof(buckets_));
+	count_ = 0;
+	sum_ = 0;
+	max_ = 0;
+}
+
+//-------------------------------------------------------------------------------------
+uint64 LatencyHistogram::percentile(float p) const
+{
+	if (count_ == 0)
+		return 0;
+
+	uint64 rank = (uint64)(count_ * p / 100.f);
+	if (rank >= count_)
+		rank = count_ - 1;
+
+	uint64 seen = 0;
+	for (uint32 i = 0; i < NUM_BUCKETS; ++i)
+	{
+		seen += buckets_[i];
+		if (seen > rank)
+		{
+			uint64 lower = bucketLowerBound(i);
+			uint64 upper = (i + 1 < NUM_BUCKETS) ? bucketLowerBound(i + 1) : lower;
+			uint64 mid = lower + (upper - lower) / 2;
+			return mid > max_ ? max_ : mid;
+		}
+	}
+
+	return max_;
+}
+
+//-------------------------------------------------------------------------------------
+std::string LatencyHistogram::summary() const
+{
+	return fmt::format("count={}, avg={:.2f}ms, p50={:.2f}ms, p90={:.2f}ms, p99={:.2f}ms, max={:.2f}ms",
+		count_, avg() / 1000.0, percentile(50.f) / 1000.0, percentile(90.f) / 1000.0,
+		percentile(99.f) / 1000.0, max_ / 1000.0);
+}
+
+//-------------------------------------------------------------------------------------
+static std::string loginTimeSummary()
+{
+	return HeadlessStats::loginTime.summary();
+}
+
+//-------------------------------------------------------------------------------------
+static std::string enterWorldTimeSummary()
+{
+	return HeadlessStats::enterWorldTime.summary();
+}
+
+//-------------------------------------------------------------------------------------
+static std::string rpcRoundTripSummary()
+{
+	return HeadlessStats::rpcRoundTrip.summary();
+}
+
+//-------------------------------------------------------------------------------------
+static std::string deliverySummary()
+{
+	return HeadlessStats::delivery.summary();
+}
+
+//-------------------------------------------------------------------------------------
+static uint32 numClients()
+{
+	return (uint32)Bots::getSingleton().clients().size();
+}
+
+//-------------------------------------------------------------------------------------
+void HeadlessStats::initializeWatcher()
+{
+	WATCH_OBJECT("bots/headless/clients", &numClients);
+	WATCH_OBJECT("bots/headless/inWorld", numInWorld);
+	WATCH_OBJECT("bots/headless/loginTime", &loginTimeSummary);
+	WATCH_OBJECT("bots/headless/enterWorldTime", &enterWorldTimeSummary);
+	WATCH_OBJECT("bots/headless/rpcRoundTrip", &rpcRoundTripSummary);
+	WATCH_OBJECT("bots/headless/delivery", &deliverySummary);
+	WATCH_OBJECT("bots/headless/rpcSent", rpcSent);
+	WATCH_OBJECT("bots/headless/rpcTimeouts", rpcTimeouts);
+	WATCH_OBJECT("bots/headless/movesSent", movesSent);
+	WATCH_OBJECT("bots/headless/entityEnters", entityEnters);
+	WATCH_OBJECT("bots/headless/bytesSentPerSecond", bytesSentPerSecond);
+	WATCH_OBJECT("bots/headless/bytesReceivedPerSecond", bytesReceivedPerSecond);
+	WATCH_OBJECT("bots/headless/kcpUpdatesPerSecond", kcpUpdatesPerSecond);
+	WATCH_OBJECT("bots/headless/kcpPassesPerSecond", kcpPassesPerSecond);
+	WATCH_OBJECT("bots/headless/timerCallsPerSecond", timerCallsPerSecond);
+	WATCH_OBJECT("bots/headless/sendSyscallsPerSecond", sendSyscallsPerSecond);
+	WATCH_OBJECT("bots/headless/packetsSentPerSecond", packetsSentPerSecond);
+	WATCH_OBJECT("bots/headless/packetsReceivedPerSecond", packetsReceivedPerSecond);
+	WATCH_OBJECT("bots/headless/udpRecvSyscallsPerSecond", udpRecvSyscallsPerSecond);
+	WATCH_OBJECT("bots/headless/udpRecvDatagramsPerSecond", udpRecvDatagramsPerSecond);
+	WATCH_OBJECT("bots/headless/allInWorldTime", allInWorldTime);
+
+	startTime_ = lastRateTime_ = lastReportTime_ = timestamp();
+	lastBytesSent_ = Network::g_numBytesSent;
+	lastBytesReceived_ = Network::g_numBytesReceived;
+	lastKcpUpdates_ = Network::g_kcpUpdates;
+	lastKcpPasses_ = Network::g_kcpSchedulerPasses;
+	lastTimerCalls_ = Bots::getSingleton().dispatcher().numTimerCalls();
+	lastSendSyscalls_ = Network::g_numSendSyscalls;
+	lastPacketsSent_ = Network::g_numPacketsSent;
+	lastPacketsReceived_ = Network::g_numPacketsReceived;
+	lastUdpRecvSyscalls_ = Network::g_udpRecvSyscalls;
+	lastUdpRecvDatagrams_ = Network::g_udpRecvDatagrams;
+}
+
+//-------------------------------------------------------------------------------------
+void HeadlessStats::update()
+{
+	uint64 now = timestamp();
+
+	if (now - lastRateTime_ >= stampsPerSecond())
+	{
+		double elapsed = double(now - lastRateTime_) / stampsPerSecond();
+
+		uint32 timerCalls = Bots::getSingleton().dispatcher().numTimerCalls();
+
+		bytesSentPerSecond = (uint64)((Network::g_numBytesSent - lastBytesSent_) / elapsed);
+		bytesReceivedPerSecond = (uint64)((Network::g_numBytesReceived - lastBytesReceived_) / elapsed);
+		kcpUpdatesPerSecond = (uint64)((Network::g_kcpUpdates - lastKcpUpdates_) / elapsed);
+		kcpPassesPerSecond = (uint64)((Network::g_kcpSchedulerPasses - lastKcpPasses_) / elapsed);
+		timerCallsPerSecond = (uint64)((uint32)(timerCalls - lastTimerCalls_) / elapsed);
+		sendSyscallsPerSecond = (uint64)((Network::g_numSendSyscalls - lastSendSyscalls_) / elapsed);
+		packetsSentPerSecond = (uint64)((Network::g_numPacketsSent - lastPacketsSent_) / elapsed);
+		packetsReceivedPerSecond = (uint64)((Network::g_numPacketsReceived - lastPacketsReceived_) / elapsed);
+		udpRecvSyscallsPerSecond = (uint64)((Network::g_udpRecvSyscalls - lastUdpRecvSyscalls_) / elapsed);
+		udpRecvDatagramsPerSecond = (uint64)((Network::g_udpRecvDatagrams - lastUdpRecvDatagrams_) / elapsed);
+
+		lastRateTime_ = now;
+		lastBytesSent_ = Network::g_numBytesSent;
+		lastBytesReceived_ = Network::g_numBytesReceived;
+		lastKcpUpdates_ = Network::g_kcpUpdates;
+		lastKcpPasses_ = Network::g_kcpSchedulerPasses;
+		lastTimerCalls_ = timerCalls;
+		lastSendSyscalls_ = Network::g_numSendSyscalls;
+		lastPacketsSent_ = Network::g_numPacketsSent;
+		lastPacketsReceived_ = Network::g_numPacketsReceived;
+		lastUdpRecvSyscalls_ = Network::g_udpRecvSyscalls;
+		lastUdpRecvDatagrams_ = Network::g_udpRecvDatagrams;
+	}
+
+	// ¼籩: õĻ˵һȫʱһνʱķֲ
+	uint32 totalCount = g_kbeSrvConfig.getBots().defaultAddBots_totalCount;
+	if (allInWorldTime == 0 && totalCount > 0 && numInWorld >= totalCount)
+	{
+		allInWorldTime = KBE_MAX((now - startTime_) * 1000 / stampsPerSecond(), (uint64)1);
+
+		INFO_MSG(fmt::format("HeadlessStats::update: all {} bots are in world after {:.2f}s, "
+			"timeToWorld(p50={:.2f}ms, p99={:.2f}ms), loginTime(p50={:.2f}ms, p99={:.2f}ms)\n",
+			totalCount, allInWorldTime / 1000.0,
+			enterWorldTime.percentile(50.f) / 1000.0, enterWorldTime.percentile(99.f) / 1000.0,
+			loginTime.percentile(50.f) / 1000.0, loginTime.percentile(99.f) / 1000.0));
+	}
+
+	if (now - lastReportTime_ >= uint64(g_kbeSrvConfig.getBots().bots_headless_reportPeriod * stampsPerSecond()))
+	{
+		lastReportTime_ = now;
+		report();
+	}
+}
+
+//-------------------------------------------------------------------------------------
+void HeadlessStats::report()
+{
+	INFO_MSG(fmt::format("HeadlessStats::report: clients={}, inWorld={}, entityEnters={}, movesSent={}, "
+		"rpcSent={}, rpcTimeouts={}, sent={}B/s, received={}B/s\n",
+		numClients(), numInWorld, entityEnters, movesSent, rpcSent, rpcTimeouts,
+		bytesSentPerSecond, bytesReceivedPerSecond));
+
+	INFO_MSG(fmt::format("HeadlessStats::report: kcp(sharedUpdate={}, updates={}/s, passes={}/s, passTimeLast={}us, passTimeMax={}us), "
+		"timerCalls={}/s, sendSyscalls={}/s\n",
+		Network::g_rudp_sharedUpdate, kcpUpdatesPerSecond, kcpPassesPerSecond, Network::g_kcpSchedulerPassTimeLast,
+		Network::g_kcpSchedulerPassTimeMax, timerCallsPerSecond, sendSyscallsPerSecond));
+
+	INFO_MSG(fmt::format("HeadlessStats::report: packets(sent={}/s, received={}/s), udp(recvBatchSize={}, recvSyscalls={}/s, "
+		"recvDatagrams={}/s, datagramsPerSyscall={:.2f})\n",
+		packetsSentPerSecond, packetsReceivedPerSecond, Network::g_recvBatchSize, udpRecvSyscallsPerSecond,
+		udpRecvDatagramsPerSecond, udpRecvSyscallsPerSecond > 0 ? double(udpRecvDatagramsPerSecond) / udpRecvSyscallsPerSecond : 0.0));
+
+	INFO_MSG(fmt::format("HeadlessStats::report: loginTime({})\n", loginTime.summary()));
+	INFO_MSG(fmt::format("HeadlessStats::report: enterWorldTime({})\n", enterWorldTime.summary()));
+	INFO_MSG(fmt::format("HeadlessStats::report: rpcRoundTrip({})\n", rpcRoundTrip.summary()));
+	INFO_MSG(fmt::format("HeadlessStats::report: delivery({})\n", delivery.summary()));
+}
+
+//-------------------------------------------------------------------------------------
+}
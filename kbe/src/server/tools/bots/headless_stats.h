@@ -0,0 +1,120 @@
+// Copyright 2008-2018 Yolo Technologies, Inc. All Rights Reserved. https://www.comblockengine.com
+
+#ifndef KBE_BOTS_HEADLESS_STATS_H
+#define KBE_BOTS_HEADLESS_STATS_H
+
+#include "common/common.h"
+
+namespace KBEngine {
+
+/*
+	ӳֱͼ λ΢
+	2ݷֶΣ ÿپΪ4Ͱ 25% ̶256ͰԸuint64Χ
+*/
+class LatencyHistogram
+{
+public:
+	enum
+	{
+		NUM_BUCKETS = 256
+	};
+
+	LatencyHistogram();
+
+	void add(uint64 us);
+	void reset();
+
+	uint64 count() const{ return count_; }
+	uint64 maxValue() const{ return max_; }
+	uint64 avg() const{ return count_ > 0 ? sum_ / count_ : 0; }
+
+	/**
+		ذٷλ(0~100)Ͱֵ
+	*/
+	uint64 percentile(float p) const;
+
+	/**
+		count/avg/p50/p90/p99/max λ
+	*/
+	std::string summary() const;
+
+	static uint32 bucketIndex(uint64 us);
+	static uint64 bucketLowerBound(uint32 idx);
+
+private:
+	uint64 buckets_[NUM_BUCKETS];
+	uint64 count_;
+	uint64 sum_;
+	uint64 max_;
+};
+
+/*
+	ͷ˵ѹͳƣ л˹ͬһ
+*/
+class HeadlessStats
+{
+public:
+	static void initializeWatcher();
+
+	/**
+		ÿϷtickã Լ
+	*/
+	static void update();
+
+	static void report();
+
+	// loginappbaseappôʱ
+	static LatencyHistogram loginTime;
+
+	// loginappʵʱ
+	static LatencyHistogram enterWorldTime;
+
+	// replyRPCʱ
+	static LatencyHistogram rpcRoundTrip;
+
+	// ʵͬεĵ
+	static LatencyHistogram delivery;
+
+	static uint64 rpcSent;
+	static uint64 rpcTimeouts;
+	static uint64 movesSent;
+	static uint64 entityEnters;
+	static uint32 numInWorld;
+
+	static uint64 bytesSentPerSecond;
+	static uint64 bytesReceivedPerSecond;
+
+	// ڶԱkcpÿͨʱ(channelCommon/reliableUDP/sharedUpdate)
+	static uint64 kcpUpdatesPerSecond;
+	static uint64 kcpPassesPerSecond;
+	static uint64 timerCallsPerSecond;
+	static uint64 sendSyscallsPerSecond;
+
+	// ڶԱudp/kcprecvmmsg(channelCommon/recvBatchSize)
+	static uint64 packetsSentPerSecond;
+	static uint64 packetsReceivedPerSecond;
+	static uint64 udpRecvSyscallsPerSecond;
+	static uint64 udpRecvDatagramsPerSecond;
+
+	// defaultAddBots/totalCountȫõʱ() ڵ¼籩ԣ δȫʱΪ0
+	static uint64 allInWorldTime;
+
+private:
+	static uint64 startTime_;
+	static uint64 lastRateTime_;
+	static uint64 lastBytesSent_;
+	static uint64 lastBytesReceived_;
+	static uint64 lastKcpUpdates_;
+	static uint64 lastKcpPasses_;
+	static uint32 lastTimerCalls_;
+	static uint64 lastSendSyscalls_;
+	static uint64 lastPacketsSent_;
+	static uint64 lastPacketsReceived_;
+	static uint64 lastUdpRecvSyscalls_;
+	static uint64 lastUdpRecvDatagrams_;
+	static uint64 lastReportTime_;
+};
+
+}
+
+#endif // KBE_BOTS_HEADLESS_STATS_H
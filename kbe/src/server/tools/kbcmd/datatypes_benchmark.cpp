@@ -0,0 +1,135 @@
+// Copyright 2008-2018 Yolo Technologies, Inc. All Rights Reserved. https://www.comblockengine.com
+
+#include "datatypes_benchmark.h"
+#include "common/memorystream.h"
+#include "common/timestamp.h"
+#include "entitydef/datatypes.h"
+
+namespace KBEngine{
+
+//-------------------------------------------------------------------------------------
+DataTypesBenchmark::DataTypesBenchmark(uint32 iterations, uint32 elements):
+iterations_(iterations),
+elements_(elements),
+totalEncodes_(0),
+totalDecodes_(0),
+totalEncodeTime_(0),
+totalDecodeTime_(0)
+{
+	if (iterations_ == 0)
+		iterations_ = 1;
+}
+
+//-------------------------------------------------------------------------------------
+DataTypesBenchmark::~DataTypesBenchmark()
+{
+}
+
+//-------------------------------------------------------------------------------------
+static double opsPerSecond(uint64 ops, uint64 stamps)
+{
+	if (stamps == 0)
+		return 0.0;
+
+	return ops * stampsPerSecondD() / stamps;
+}
+
+//-------------------------------------------------------------------------------------
+PyObject* DataTypesBenchmark::createValue(DataType* pDataType)
+{
+	if (pDataType->type() != DATA_TYPE_FIXEDARRAY || elements_ == 0)
+		return pDataType->parseDefaultStr("");
+
+	DataType* pItemType = static_cast<FixedArrayType*>(pDataType)->getDataType();
+
+	PyObject* pyList = PyList_New(elements_);
+	for (uint32 i = 0; i < elements_; ++i)
+		PyList_SET_ITEM(pyList, i, createValue(pItemType));
+
+	PyObject* pyValue = static_cast<FixedArrayType*>(pDataType)->createNewFromObj(pyList);
+	Py_DECREF(pyList);
+	return pyValue;
+}
+
+//-------------------------------------------------------------------------------------
+bool DataTypesBenchmark::benchmark(const std::string& name, DataType* pDataType)
+{
+	PyObject* pyValue = createValue(pDataType);
+	if (pyValue == NULL || !pDataType->isSameType(pyValue))
+	{
+		SCRIPT_ERROR_CHECK();
+		ERROR_MSG(fmt::format("DataTypesBenchmark::benchmark: {} create value error!\n", name));
+		Py_XDECREF(pyValue);
+		return false;
+	}
+
+	MemoryStream stream;
+
+	uint64 startTime = timestamp();
+	for (uint32 i = 0; i < iterations_; ++i)
+	{
+		stream.clear(false);
+		pDataType->addToStream(&stream, pyValue);
+	}
+
+	uint64 encodeTime = timestamp() - startTime;
+
+	startTime = timestamp();
+	for (uint32 i = 0; i < iterations_; ++i)
+	{
+		stream.rpos(0);
+		PyObject* pyDecoded = pDataType->createFromStream(&stream);
+		Py_XDECREF(pyDecoded);
+	}
+
+	uint64 decodeTime = timestamp() - startTime;
+
+	Py_DECREF(pyValue);
+	SCRIPT_ERROR_CHECK();
+
+	totalEncodes_ += iterations_;
+	totalDecodes_ += iterations_;
+	totalEncodeTime_ += encodeTime;
+	totalDecodeTime_ += decodeTime;
+
+	INFO_MSG(fmt::format("DataTypesBenchmark: {}({}), size={}B, encode={:.0f} ops/s, decode={:.0f} ops/s\n",
+		name, pDataType->getName(), stream.wpos(), opsPerSecond(iterations_, encodeTime), 
+		opsPerSecond(iterations_, decodeTime)));
+
+	return true;
+}
+
+//-------------------------------------------------------------------------------------
+bool DataTypesBenchmark::run()
+{
+	INFO_MSG(fmt::format("DataTypesBenchmark::run: iterations={}, elements={}\n", 
+		iterations_, elements_));
+
+	uint32 numTypes = 0;
+	bool ret = true;
+
+	const DataTypes::DATATYPE_ORDERS& orders = DataTypes::dataTypesOrders();
+	DataTypes::DATATYPE_ORDERS::const_iterator iter = orders.begin();
+	for (; iter != orders.end(); ++iter)
+	{
+		DataType* pDataType = DataTypes::getDataType(*iter, false);
+		if (pDataType == NULL)
+			continue;
+
+		if (pDataType->type() != DATA_TYPE_FIXEDDICT && pDataType->type() != DATA_TYPE_FIXEDARRAY)
+			continue;
+
+		++numTypes;
+
+		if (!benchmark(*iter, pDataType))
+			ret = false;
+	}
+
+	INFO_MSG(fmt::format("DataTypesBenchmark::run: types={}, encode={:.0f} ops/s, decode={:.0f} ops/s\n",
+		numTypes, opsPerSecond(totalEncodes_, totalEncodeTime_), opsPerSecond(totalDecodes_, totalDecodeTime_)));
+
+	return ret;
+}
+
+//-------------------------------------------------------------------------------------
+}
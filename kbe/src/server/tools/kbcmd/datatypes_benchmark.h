@@ -0,0 +1,39 @@
+// Copyright 2008-2018 Yolo Technologies, Inc. All Rights Reserved. https://www.comblockengine.com
+
+#ifndef KBE_DATATYPES_BENCHMARK_H
+#define KBE_DATATYPES_BENCHMARK_H
+
+#include "common/common.h"
+#include "helper/debug_helper.h"
+#include "entitydef/datatype.h"
+
+namespace KBEngine{
+
+/*
+	entity_defsFIXED_DICTARRAY͵л/л
+	ֵʹ͵Ĭֵ ARRAYelementsԪصĬֵ
+*/
+class DataTypesBenchmark
+{
+public:
+	DataTypesBenchmark(uint32 iterations, uint32 elements);
+	virtual ~DataTypesBenchmark();
+
+	bool run();
+
+protected:
+	PyObject* createValue(DataType* pDataType);
+
+	bool benchmark(const std::string& name, DataType* pDataType);
+
+	uint32 iterations_;
+	uint32 elements_;
+
+	uint64 totalEncodes_;
+	uint64 totalDecodes_;
+	uint64 totalEncodeTime_;
+	uint64 totalDecodeTime_;
+};
+
+}
+#endif
@@ -0,0 +1,300 @@
+// Copyright 2008-2018 Yolo Technologies, Inc. All Rights Reserved. https://www.comblockengine.com
+
+#include "entityload_benchmark.h"
+#include "common/memorystream.h"
+#include "common/timestamp.h"
+#include "entitydef/entitydef.h"
+#include "entitydef/scriptdef_module.h"
+#include "server/serverconfig.h"
+#include "db_interface/db_interface.h"
+#include "db_interface/entity_table.h"
+#include "db_mysql/db_interface_mysql.h"
+
+namespace KBEngine{
+
+//-------------------------------------------------------------------------------------
+EntityLoadBenchmark::EntityLoadBenchmark(const std::string& dbInterfaceName, uint32 iterations, 
+	uint32 entities, const std::string& entityType):
+dbInterfaceName_(dbInterfaceName),
+iterations_(iterations),
+entities_(entities),
+entityType_(entityType),
+pTableInterface_(NULL),
+pBatchInterface_(NULL),
+totalLoads_(0),
+totalTableTime_(0),
+totalBatchTime_(0),
+totalTableRoundTrips_(0),
+totalBatchRoundTrips_(0)
+{
+	if (iterations_ == 0)
+		iterations_ = 1;
+
+	if (entities_ == 0)
+		entities_ = 1;
+}
+
+//-------------------------------------------------------------------------------------
+EntityLoadBenchmark::~EntityLoadBenchmark()
+{
+	if (pTableInterface_)
+	{
+		pTableInterface_->detach();
+		SAFE_RELEASE(pTableInterface_);
+	}
+
+	if (pBatchInterface_)
+	{
+		pBatchInterface_->detach();
+		SAFE_RELEASE(pBatchInterface_);
+	}
+}
+
+//-------------------------------------------------------------------------------------
+static double opsPerSecond(uint64 ops, uint64 stamps)
+{
+	if (stamps == 0)
+		return 0.0;
+
+	return ops * stampsPerSecondD() / stamps;
+}
+
+//-------------------------------------------------------------------------------------
+static double perLoad(uint64 value, uint64 loads)
+{
+	if (loads == 0)
+		return 0.0;
+
+	return (double)value / loads;
+}
+
+//-------------------------------------------------------------------------------------
+bool EntityLoadBenchmark::queryDBIDs(DBInterface* pdbi, const std::string& tableName, std::vector<DBID>& outs)
+{
+	std::string sql = fmt::format("select id from " ENTITY_TABLE_PERFIX "_{} order by id limit {};", 
+		tableName, entities_);
+
+	if (!pdbi->query(sql, false))
+	{
+		ERROR_MSG(fmt::format("EntityLoadBenchmark::queryDBIDs: {} query error({})!\n", 
+			tableName, pdbi->getstrerror()));
+
+		return false;
+	}
+
+	MYSQL_RES * pResult = mysql_store_result(static_cast<DBInterfaceMysql*>(pdbi)->mysql());
+
+	if(pResult)
+	{
+		MYSQL_ROW arow;
+
+		while((arow = mysql_fetch_row(pResult)) != NULL)
+		{
+			DBID dbid;
+			StringConv::str2value(dbid, arow[0]);
+			outs.push_back(dbid);
+		}
+
+		mysql_free_result(pResult);
+	}
+
+	return true;
+}
+
+//-------------------------------------------------------------------------------------
+bool EntityLoadBenchmark::load(DBInterface* pdbi, EntityTables& entityTables, ScriptDefModule* pModule, 
+	const std::vector<DBID>& dbids, uint64& outTime, uint64& outRoundTrips)
+{
+	MemoryStream stream;
+
+	uint64 startRoundTrips = DBInterfaceMysql::numEntityLoadRoundTrips();
+	uint64 startTime = timestamp();
+
+	for (uint32 i = 0; i < iterations_; ++i)
+	{
+		std::vector<DBID>::const_iterator iter = dbids.begin();
+		for (; iter != dbids.end(); ++iter)
+		{
+			stream.clear(false);
+
+			if (!entityTables.queryEntity(pdbi, (*iter), &stream, pModule))
+			{
+				ERROR_MSG(fmt::format("EntityLoadBenchmark::load: {}({}) query error({})!\n",
+					pModule->getName(), (*iter), pdbi->getstrerror()));
+
+				return false;
+			}
+		}
+	}
+
+	outTime = timestamp() - startTime;
+	outRoundTrips = DBInterfaceMysql::numEntityLoadRoundTrips() - startRoundTrips;
+	return true;
+}
+
+//-------------------------------------------------------------------------------------
+bool EntityLoadBenchmark::benchmark(EntityTables& entityTables, ScriptDefModule* pModule)
+{
+	std::vector<DBID> dbids;
+	if (!queryDBIDs(pTableInterface_, pModule->getName(), dbids))
+		return false;
+
+	if (dbids.size() == 0)
+	{
+		INFO_MSG(fmt::format("EntityLoadBenchmark: {} has no entities in the database, skipped.\n", 
+			pModule->getName()));
+
+		return true;
+	}
+
+	// ֶȡʽõȫͬݣ û
+	MemoryStream tableStream;
+	MemoryStream batchStream;
+
+	if (!entityTables.queryEntity(pTableInterface_, dbids[0], &tableStream, pModule) ||
+		!entityTables.queryEntity(pBatchInterface_, dbids[0], &batchStream, pModule))
+	{
+		ERROR_MSG(fmt::format("EntityLoadBenchmark::benchmark: {}({}) query error!\n",
+			pModule->getName(), dbids[0]));
+
+		return false;
+	}
+
+	if (tableStream.length() != batchStream.length() ||
+		memcmp(tableStream.data(), batchStream.data(), tableStream.length()) != 0)
+	{
+		ERROR_MSG(fmt::format("EntityLoadBenchmark::benchmark: {}({}) batched load differs from per-table load! size={}/{}\n",
+			pModule->getName(), dbids[0], batchStream.length(), tableStream.length()));
+
+		return false;
+	}
+
+	uint64 tableTime = 0, tableRoundTrips = 0;
+	if (!load(pTableInterface_, entityTables, pModule, dbids, tableTime, tableRoundTrips))
+		return false;
+
+	uint64 batchTime = 0, batchRoundTrips = 0;
+	if (!load(pBatchInterface_, entityTables, pModule, dbids, batchTime, batchRoundTrips))
+		return false;
+
+	uint64 loads = (uint64)iterations_ * dbids.size();
+
+	totalLoads_ += loads;
+	totalTableTime_ += tableTime;
+	totalBatchTime_ += batchTime;
+	totalTableRoundTrips_ += tableRoundTrips;
+	totalBatchRoundTrips_ += batchRoundTrips;
+
+	INFO_MSG(fmt::format("EntityLoadBenchmark: {}, entities={}, size={}B, per-table={:.0f} loads/s({:.2f} round trips/load), "
+		"batched={:.0f} loads/s({:.2f} round trips/load)\n",
+		pModule->getName(), dbids.size(), tableStream.length(), 
+		opsPerSecond(loads, tableTime), perLoad(tableRoundTrips, loads),
+		opsPerSecond(loads, batchTime), perLoad(batchRoundTrips, loads)));
+
+	return true;
+}
+
+//-------------------------------------------------------------------------------------
+bool EntityLoadBenchmark::run()
+{
+	INFO_MSG(fmt::format("EntityLoadBenchmark::run: dbInterface={}, iterations={}, entities={}, entity={}\n", 
+		dbInterfaceName_, iterations_, entities_, entityType_.size() > 0 ? entityType_ : "*"));
+
+	DBInterfaceInfo* pDBInfo = g_kbeSrvConfig.dbInterface(dbInterfaceName_);
+	if (!pDBInfo)
+	{
+		ERROR_MSG(fmt::format("EntityLoadBenchmark::run: not found dbInterface({})\n", dbInterfaceName_));
+		return false;
+	}
+
+	if (strcmp(pDBInfo->db_type, "mysql") != 0)
+	{
+		ERROR_MSG(fmt::format("EntityLoadBenchmark::run: dbInterface({}) type is {}, only supports mysql!\n", 
+			dbInterfaceName_, pDBInfo->db_type));
+
+		return false;
+	}
+
+	if (!DBUtil::initialize())
+		return false;
+
+	// Ƿattachʱ ַʽʹһ
+	bool batchEntityLoad = pDBInfo->db_batchEntityLoad;
+
+	pDBInfo->db_batchEntityLoad = false;
+	pTableInterface_ = DBUtil::createInterface(dbInterfaceName_, false);
+
+	pDBInfo->db_batchEntityLoad = true;
+	pBatchInterface_ = DBUtil::createInterface(dbInterfaceName_, false);
+
+	pDBInfo->db_batchEntityLoad = batchEntityLoad;
+
+	if (pTableInterface_ == NULL || pBatchInterface_ == NULL)
+	{
+		DBUtil::finalise();
+		return false;
+	}
+
+	// ֻرṹ ݿͬ
+	EntityTables& entityTables = EntityTables::findByInterfaceName(dbInterfaceName_);
+	if (!entityTables.load(pTableInterface_))
+	{
+		DBUtil::finalise();
+		return false;
+	}
+
+	uint32 numTypes = 0;
+	bool ret = true;
+
+	try
+	{
+		const EntityDef::SCRIPT_MODULES& modules = EntityDef::getScriptModules();
+		EntityDef::SCRIPT_MODULES::const_iterator iter = modules.begin();
+		for (; iter != modules.end(); ++iter)
+		{
+			ScriptDefModule* pModule = (*iter).get();
+
+			if (entityType_.size() > 0 && entityType_ != pModule->getName())
+				continue;
+
+			if (entityTables.findTable(pModule->getName()) == NULL)
+				continue;
+
+			++numTypes;
+
+			if (!benchmark(entityTables, pModule))
+				ret = false;
+		}
+	}
+	catch (std::exception& e)
+	{
+		ERROR_MSG(fmt::format("EntityLoadBenchmark::run: {}\n", e.what()));
+		ret = false;
+	}
+
+	if (numTypes == 0)
+	{
+		ERROR_MSG(fmt::format("EntityLoadBenchmark::run: not found persistent entity({})!\n", 
+			entityType_.size() > 0 ? entityType_ : "*"));
+
+		ret = false;
+	}
+
+	INFO_MSG(fmt::format("EntityLoadBenchmark::run: types={}, loads={}, per-table={:.0f} loads/s({:.2f} round trips/load), "
+		"batched={:.0f} loads/s({:.2f} round trips/load)\n",
+		numTypes, totalLoads_, 
+		opsPerSecond(totalLoads_, totalTableTime_), perLoad(totalTableRoundTrips_, totalLoads_),
+		opsPerSecond(totalLoads_, totalBatchTime_), perLoad(totalBatchRoundTrips_, totalLoads_)));
+
+	pTableInterface_->detach();
+	SAFE_RELEASE(pTableInterface_);
+
+	pBatchInterface_->detach();
+	SAFE_RELEASE(pBatchInterface_);
+
+	DBUtil::finalise();
+	return ret;
+}
+
+//-------------------------------------------------------------------------------------
+}
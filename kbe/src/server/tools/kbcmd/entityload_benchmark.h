@@ -0,0 +1,54 @@
+// Copyright 2008-2018 Yolo Technologies, Inc. All Rights Reserved. https://www.comblockengine.com
+
+#ifndef KBE_ENTITYLOAD_BENCHMARK_H
+#define KBE_ENTITYLOAD_BENCHMARK_H
+
+#include "common/common.h"
+#include "helper/debug_helper.h"
+
+namespace KBEngine{
+
+class DBInterface;
+class EntityTables;
+class ScriptDefModule;
+
+/*
+	õmysqlݿӿڲʵȡٶ
+	ͬһʵֱѯϲѯ(batchEntityLoad)ȡ Ƚÿȡÿζȡ
+	Ҫdbmgrѽʵͬݿ⣬ ֻд
+*/
+class EntityLoadBenchmark
+{
+public:
+	EntityLoadBenchmark(const std::string& dbInterfaceName, uint32 iterations, 
+		uint32 entities, const std::string& entityType);
+
+	virtual ~EntityLoadBenchmark();
+
+	bool run();
+
+protected:
+	bool queryDBIDs(DBInterface* pdbi, const std::string& tableName, std::vector<DBID>& outs);
+
+	bool load(DBInterface* pdbi, EntityTables& entityTables, ScriptDefModule* pModule, 
+		const std::vector<DBID>& dbids, uint64& outTime, uint64& outRoundTrips);
+
+	bool benchmark(EntityTables& entityTables, ScriptDefModule* pModule);
+
+	std::string dbInterfaceName_;
+	uint32 iterations_;
+	uint32 entities_;
+	std::string entityType_;
+
+	DBInterface* pTableInterface_;
+	DBInterface* pBatchInterface_;
+
+	uint64 totalLoads_;
+	uint64 totalTableTime_;
+	uint64 totalBatchTime_;
+	uint64 totalTableRoundTrips_;
+	uint64 totalBatchRoundTrips_;
+};
+
+}
+#endif
@@ -0,0 +1,348 @@
+// Copyright 2008-2018 Yolo Technologies, Inc. All Rights Reserved. https://www.comblockengine.com
+
+#include "log_benchmark.h"
+#include "common/memorystream.h"
+#include "common/timestamp.h"
+#include "thread/threadpool.h"
+#include "thread/threadguard.h"
+
+namespace KBEngine{
+
+// ȡChannel::sendCheckһ澯 Ϊָ롢ַ
+#define LOG_BENCHMARK_FORMAT "Channel::sendCheck[{:p}]: internal channel({}), bufferedBytes has overflowed({} > {}).\n"
+#define LOG_BENCHMARK_CHANNEL "127.0.0.1:20015/1/0/0/0/0"
+#define LOG_BENCHMARK_STREAM_SIZE (1024 * 1024)
+
+//-------------------------------------------------------------------------------------
+static double opsPerSecond(uint64 ops, uint64 stamps)
+{
+	if (stamps == 0)
+		return 0.0;
+
+	return ops * stampsPerSecondD() / stamps;
+}
+
+//-------------------------------------------------------------------------------------
+static void writeTextLog(MemoryStream& s, const std::string& channelName, uint32 i)
+{
+	std::string str = fmt::format(LOG_BENCHMARK_FORMAT, (const void*)&s, channelName, i, 10485760u);
+
+	s << getUserUID();
+	s << (uint32)KBELOG_WARNING;
+	s << g_componentType;
+	s << g_componentID;
+	s << g_componentGlobalOrder;
+	s << g_componentGroupOrder;
+
+	uint64 t = getTimeMs();
+	s << (int64)(t / 1000);
+	s << (uint32)(t % 1000);
+	s.appendBlob(str);
+}
+
+//-------------------------------------------------------------------------------------
+static bool writeLogRecord(LogRecordRing& ring, uint32 formatID, const std::string& channelName, uint32 i)
+{
+	LogRecordWriter writer(ring.scratch(), LOG_RECORD_MAX_SIZE);
+	writer.begin(formatID, KBELOG_WARNING, 4);
+	writer.args((const void*)&ring, channelName, i, 10485760u);
+	return ring.push(writer);
+}
+
+//-------------------------------------------------------------------------------------
+/*
+	̲߳еһ߳
+*/
+class LogBenchmarkTask : public thread::TPTask
+{
+public:
+	LogBenchmarkTask(LogRecordRing* pRing, thread::ThreadMutex* pMutex, MemoryStream* pStream,
+		uint32 formatID, uint32 records, std::atomic<uint32>* pFinished):
+	pRing_(pRing),
+	pMutex_(pMutex),
+	pStream_(pStream),
+	formatID_(formatID),
+	records_(records),
+	pFinished_(pFinished)
+	{
+	}
+
+	virtual ~LogBenchmarkTask()
+	{
+	}
+
+	virtual bool process()
+	{
+		std::string channelName = LOG_BENCHMARK_CHANNEL;
+
+		for (uint32 i = 0; i < records_; ++i)
+		{
+			if (pRing_)
+			{
+				// ʱȴ߳ȡ
+				while (!writeLogRecord(*pRing_, formatID_, channelName, i))
+					KBEngine::sleep(0);
+			}
+			else
+			{
+				thread::ThreadGuard tg(pMutex_);
+				writeTextLog(*pStream_, channelName, i);
+
+				if (pStream_->wpos() > LOG_BENCHMARK_STREAM_SIZE)
+					pStream_->clear(false);
+			}
+		}
+
+		pFinished_->fetch_add(1, std::memory_order_release);
+		return false;
+	}
+
+protected:
+	LogRecordRing* pRing_;
+	thread::ThreadMutex* pMutex_;
+	MemoryStream* pStream_;
+	uint32 formatID_;
+	uint32 records_;
+	std::atomic<uint32>* pFinished_;
+};
+
+//-------------------------------------------------------------------------------------
+LogBenchmark::LogBenchmark(uint32 iterations, uint32 threads):
+iterations_(iterations),
+threads_(threads),
+formatID_(0)
+{
+	if (iterations_ == 0)
+		iterations_ = 1;
+
+	if (threads_ == 0)
+		threads_ = 1;
+}
+
+//-------------------------------------------------------------------------------------
+LogBenchmark::~LogBenchmark()
+{
+}
+
+//-------------------------------------------------------------------------------------
+void LogBenchmark::textSingleThread(uint64& outTime, uint64& outBytes)
+{
+	thread::ThreadMutex mutex;
+	MemoryStream s;
+	std::string channelName = LOG_BENCHMARK_CHANNEL;
+
+	outBytes = 0;
+	uint64 startTime = timestamp();
+
+	for (uint32 i = 0; i < iterations_; ++i)
+	{
+		thread::ThreadGuard tg(&mutex);
+		writeTextLog(s, channelName, i);
+
+		// ģⷢ͸logger
+		if (s.wpos() > LOG_BENCHMARK_STREAM_SIZE)
+		{
+			outBytes += s.wpos();
+			s.clear(false);
+		}
+	}
+
+	outTime = timestamp() - startTime;
+	outBytes += s.wpos();
+}
+
+//-------------------------------------------------------------------------------------
+void LogBenchmark::recordSingleThread(uint64& outTime, uint64& outBytes, uint32& outStalls)
+{
+	LogRecordRing ring(LOG_RECORD_RING_SIZE);
+	MemoryStream s;
+	std::string channelName = LOG_BENCHMARK_CHANNEL;
+
+	outBytes = 0;
+	outStalls = 0;
+	uint64 startTime = timestamp();
+
+	for (uint32 i = 0; i < iterations_; ++i)
+	{
+		// ʱ൱DebugHelper::syncȡ
+		while (!writeLogRecord(ring, formatID_, channelName, i))
+		{
+			++outStalls;
+			outBytes += ring.drain(s, LOG_RECORD_RING_SIZE);
+			s.clear(false);
+		}
+	}
+
+	outBytes += ring.drain(s, LOG_RECORD_RING_SIZE);
+	outTime = timestamp() - startTime;
+	ring.takeNumDropped();
+}
+
+//-------------------------------------------------------------------------------------
+bool LogBenchmark::loggerFormat(uint64& outTime, uint32& outRecords)
+{
+	LogRecordRing ring(LOG_RECORD_RING_SIZE);
+	MemoryStream s;
+	std::string channelName = LOG_BENCHMARK_CHANNEL;
+
+	outRecords = std::min(iterations_, (uint32)100000);
+
+	for (uint32 i = 0; i < outRecords; ++i)
+	{
+		while (!writeLogRecord(ring, formatID_, channelName, i))
+			ring.drain(s, LOG_RECORD_RING_SIZE);
+	}
+
+	ring.drain(s, LOG_RECORD_RING_SIZE);
+
+	// õֱӸʽĽȽϣ ȷӳٸʽı
+	std::string expected = fmt::format(LOG_BENCHMARK_FORMAT, (const void*)&ring, channelName, 0, 10485760u);
+
+	uint32 numFormatted = 0;
+	size_t formattedBytes = 0;
+	uint64 startTime = timestamp();
+
+	LogRecordReader reader(s);
+	while (reader.next())
+	{
+		std::string str = reader.format(LogFormats::format(reader.formatID()));
+
+		if (numFormatted++ == 0 && str != expected)
+		{
+			ERROR_MSG(fmt::format("LogBenchmark::loggerFormat: mismatch! \"{}\" != \"{}\"\n", str, expected));
+			return false;
+		}
+
+		formattedBytes += str.size();
+	}
+
+	outTime = timestamp() - startTime;
+
+	if (numFormatted != outRecords)
+	{
+		ERROR_MSG(fmt::format("LogBenchmark::loggerFormat: {} records written, {} formatted!\n", 
+			outRecords, numFormatted));
+
+		return false;
+	}
+
+	return formattedBytes > 0;
+}
+
+//-------------------------------------------------------------------------------------
+void LogBenchmark::textMultiThread(uint64& outTime)
+{
+	thread::ThreadMutex mutex;
+	MemoryStream s;
+	std::atomic<uint32> finished(0);
+
+	thread::ThreadPool threadPool;
+	threadPool.createThreadPool(threads_, threads_, threads_);
+
+	uint64 startTime = timestamp();
+
+	for (uint32 i = 0; i < threads_; ++i)
+		threadPool.addTask(new LogBenchmarkTask(NULL, &mutex, &s, formatID_, iterations_, &finished));
+
+	while (finished.load(std::memory_order_acquire) < threads_)
+		KBEngine::sleep(1);
+
+	outTime = timestamp() - startTime;
+
+	threadPool.onMainThreadTick();
+	threadPool.finalise();
+}
+
+//-------------------------------------------------------------------------------------
+void LogBenchmark::recordMultiThread(uint64& outTime, uint32& outStalls)
+{
+	std::vector<LogRecordRing*> rings;
+	for (uint32 i = 0; i < threads_; ++i)
+		rings.push_back(new LogRecordRing(LOG_RECORD_RING_SIZE));
+
+	MemoryStream s;
+	std::atomic<uint32> finished(0);
+
+	thread::ThreadPool threadPool;
+	threadPool.createThreadPool(threads_, threads_, threads_);
+
+	uint64 startTime = timestamp();
+
+	for (uint32 i = 0; i < threads_; ++i)
+		threadPool.addTask(new LogBenchmarkTask(rings[i], NULL, NULL, formatID_, iterations_, &finished));
+
+	// ̲߳ͣȡ߸̵߳ļ¼ ൱DebugHelper::sync
+	while (true)
+	{
+		bool done = finished.load(std::memory_order_acquire) == threads_;
+		uint32 drained = 0;
+
+		for (uint32 i = 0; i < threads_; ++i)
+		{
+			drained += rings[i]->drain(s, LOG_RECORD_RING_SIZE);
+			s.clear(false);
+		}
+
+		if (done && drained == 0)
+			break;
+	}
+
+	outTime = timestamp() - startTime;
+
+	threadPool.onMainThreadTick();
+	threadPool.finalise();
+
+	outStalls = 0;
+	for (uint32 i = 0; i < threads_; ++i)
+	{
+		outStalls += rings[i]->takeNumDropped();
+		delete rings[i];
+	}
+}
+
+//-------------------------------------------------------------------------------------
+bool LogBenchmark::run()
+{
+	formatID_ = LogFormats::registerFormat(LOG_BENCHMARK_FORMAT);
+
+	uint64 textTime = 0, textBytes = 0;
+	textSingleThread(textTime, textBytes);
+
+	uint64 recordTime = 0, recordBytes = 0;
+	uint32 recordStalls = 0;
+	recordSingleThread(recordTime, recordBytes, recordStalls);
+
+	uint64 formatTime = 0;
+	uint32 formatRecords = 0;
+	if (!loggerFormat(formatTime, formatRecords))
+		return false;
+
+	INFO_MSG(fmt::format("LogBenchmark: iterations={}, 1 thread\n"
+		"\ttext(format at call site):   {:.0f} logs/s, {:.1f} bytes/log\n"
+		"\trecord(format id + args):    {:.0f} logs/s, {:.1f} bytes/log, ring full {} times\n"
+		"\tlogger formatting records:   {:.0f} logs/s\n",
+		iterations_,
+		opsPerSecond(iterations_, textTime), (double)textBytes / iterations_,
+		opsPerSecond(iterations_, recordTime), (double)recordBytes / iterations_, recordStalls,
+		opsPerSecond(formatRecords, formatTime)));
+
+	uint64 textMultiTime = 0;
+	textMultiThread(textMultiTime);
+
+	uint64 recordMultiTime = 0;
+	uint32 recordMultiStalls = 0;
+	recordMultiThread(recordMultiTime, recordMultiStalls);
+
+	uint64 totalLogs = (uint64)iterations_ * threads_;
+
+	INFO_MSG(fmt::format("LogBenchmark: iterations={}, {} threads\n"
+		"\ttext(shared logMutex):       {:.0f} logs/s\n"
+		"\trecord(per-thread rings):    {:.0f} logs/s, ring full {} times\n",
+		iterations_, threads_,
+		opsPerSecond(totalLogs, textMultiTime),
+		opsPerSecond(totalLogs, recordMultiTime), recordMultiStalls));
+
+	return true;
+}
+
+}
@@ -0,0 +1,38 @@
+// Copyright 2008-2018 Yolo Technologies, Inc. All Rights Reserved. https://www.comblockengine.com
+
+#ifndef KBE_LOG_BENCHMARK_H
+#define KBE_LOG_BENCHMARK_H
+
+#include "common/common.h"
+#include "helper/debug_helper.h"
+
+namespace KBEngine{
+
+/*
+	Ƚ־ʽ
+	ı: õfmt::formatlogMutexд(DEBUG_MSGloggerĿ)
+	¼: õֻѸʽIDԭʼд߳Լλ(DEBUG_FMT) ߳ȡ
+	ⵥͳlogger˸ʽ¼ٶȣ Լ߳ͬʱʱַʽ
+*/
+class LogBenchmark
+{
+public:
+	LogBenchmark(uint32 iterations, uint32 threads);
+	virtual ~LogBenchmark();
+
+	bool run();
+
+protected:
+	void textSingleThread(uint64& outTime, uint64& outBytes);
+	void recordSingleThread(uint64& outTime, uint64& outBytes, uint32& outStalls);
+	bool loggerFormat(uint64& outTime, uint32& outRecords);
+	void textMultiThread(uint64& outTime);
+	void recordMultiThread(uint64& outTime, uint32& outStalls);
+
+	uint32 iterations_;
+	uint32 threads_;
+	uint32 formatID_;
+};
+
+}
+#endif
@@ -4,7 +4,15 @@
 #include "kbcmd.h"
 #include "client_sdk.h"
 #include "server_assets.h"
+#include "datatypes_benchmark.h"
+#include "entityload_benchmark.h"
+#include "redis_benchmark.h"
+#include "mysql_benchmark.h"
+#include "log_benchmark.h"
+#include "timer_benchmark.h"
+#include "volatile_benchmark.h"
 #include "entitydef/entitydef.h"
+#include "network/encryption_filter.h"
 #include "entitydef/py_entitydef.h"
 #include "pyscript/py_compression.h"
 #include "pyscript/py_platform.h"
@@ -424,6 +432,202 @@ int process_newassets(int argc, char* argv[], const std::string assetsType)
 	return ret;
 }
 
+int process_benchmark(int argc, char* argv[], const std::string benchmarkType)
+{
+	Resmgr::getSingleton().initialize();
+	setEvns();
+	loadConfig();
+
+	DebugHelper::initialize(g_componentType);
+
+	INFO_MSG("-----------------------------------------------------------------------------------------\n\n\n");
+
+	Resmgr::getSingleton().print();
+
+	Network::EventDispatcher dispatcher;
+	DebugHelper::getSingleton().pDispatcher(&dispatcher);
+
+	Network::g_SOMAXCONN = g_kbeSrvConfig.tcp_SOMAXCONN(g_componentType);
+
+	Network::NetworkInterface networkInterface(&dispatcher);
+
+	DebugHelper::getSingleton().pNetworkInterface(&networkInterface);
+
+	KBCMD app(dispatcher, networkInterface, g_componentType, g_componentID);
+
+	START_MSG(COMPONENT_NAME_EX(g_componentType), g_componentID);
+
+	if (!app.initialize())
+	{
+		ERROR_MSG("app::initialize(): initialization failed!\n");
+
+		app.finalise();
+
+		// ־δͬɣ ͬɲŽ
+		DebugHelper::getSingleton().finalise();
+		return -1;
+	}
+
+	if (!script::entitydef::installModule("EntityDef"))
+	{
+		ERROR_MSG("app::initialize(): EntityDef initialization failed!\n");
+
+		app.finalise();
+
+		// ־δͬɣ ͬɲŽ
+		DebugHelper::getSingleton().finalise();
+		return -1;
+	}
+
+	std::vector<PyTypeObject*> scriptBaseTypes;
+	if (!EntityDef::initialize(scriptBaseTypes, g_componentType))
+	{
+		ERROR_MSG("app::initialize(): EntityDef initialization failed!\n");
+
+		script::entitydef::uninstallModule();
+		app.finalise();
+
+		// ־δͬɣ ͬɲŽ
+		DebugHelper::getSingleton().finalise();
+		return -1;
+	}
+
+	std::string iterations = "";
+	std::string elements = "8";
+	std::string dbinterface = "default";
+	std::string entities = "100";
+	std::string entity = "";
+	std::string commands = "64";
+	std::string megabytes = "16";
+	std::string threads = "4";
+	std::string timers = "1000000";
+
+	PARSE_COMMAND_ARG_BEGIN();
+	PARSE_COMMAND_ARG_GET_VALUE("--iterations=", iterations);
+	PARSE_COMMAND_ARG_GET_VALUE("--elements=", elements);
+	PARSE_COMMAND_ARG_GET_VALUE("--dbinterface=", dbinterface);
+	PARSE_COMMAND_ARG_GET_VALUE("--entities=", entities);
+	PARSE_COMMAND_ARG_GET_VALUE("--entity=", entity);
+	PARSE_COMMAND_ARG_GET_VALUE("--commands=", commands);
+	PARSE_COMMAND_ARG_GET_VALUE("--megabytes=", megabytes);
+	PARSE_COMMAND_ARG_GET_VALUE("--threads=", threads);
+	PARSE_COMMAND_ARG_GET_VALUE("--timers=", timers);
+	PARSE_COMMAND_ARG_END();
+
+	int ret = 0;
+
+	if (benchmarkType == "datatypes")
+	{
+		if (iterations.size() == 0)
+			iterations = "100000";
+
+		DataTypesBenchmark benchmark((uint32)atoi(iterations.c_str()), (uint32)atoi(elements.c_str()));
+		if (!benchmark.run())
+			ret = -1;
+	}
+	else if (benchmarkType == "entityload" || benchmarkType == "redis" || benchmarkType == "mysql")
+	{
+		// ݿΪʱDBUtil::initializeҪԿ
+		std::string publicKeyPath = Resmgr::getSingleton().getPyUserResPath() + "key/" + "kbengine_public.key";
+		std::string privateKeyPath = Resmgr::getSingleton().getPyUserResPath() + "key/" + "kbengine_private.key";
+
+		bool isExsit = access(publicKeyPath.c_str(), 0) == 0 && access(privateKeyPath.c_str(), 0) == 0;
+		if (!isExsit)
+		{
+			publicKeyPath = Resmgr::getSingleton().matchPath("key/") + "kbengine_public.key";
+			privateKeyPath = Resmgr::getSingleton().matchPath("key/") + "kbengine_private.key";
+		}
+
+		KBEKey kbekey(publicKeyPath, privateKeyPath);
+
+		if (benchmarkType == "entityload")
+		{
+			// ÿζȡҪݿ⣬ ĬϴԶСdatatypes
+			if (iterations.size() == 0)
+				iterations = "10";
+
+			EntityLoadBenchmark benchmark(dbinterface, (uint32)atoi(iterations.c_str()), 
+				(uint32)atoi(entities.c_str()), entity);
+
+			if (!benchmark.run())
+				ret = -1;
+		}
+		else if (benchmarkType == "mysql")
+		{
+			if (iterations.size() == 0)
+				iterations = "100";
+
+			MysqlBenchmark benchmark(dbinterface, (uint32)atoi(iterations.c_str()), 
+				(uint32)atoi(entities.c_str()));
+
+			if (!benchmark.run())
+				ret = -1;
+		}
+		else
+		{
+			if (iterations.size() == 0)
+				iterations = "1000";
+
+			RedisBenchmark benchmark(dbinterface, (uint32)atoi(iterations.c_str()), 
+				(uint32)atoi(commands.c_str()));
+
+			if (!benchmark.run())
+				ret = -1;
+		}
+	}
+	else if (benchmarkType == "encryption")
+	{
+		std::string result;
+		if (!Network::benchmarkEncryptionFilters((uint32)atoi(megabytes.c_str()), result))
+		{
+			ERROR_MSG("EncryptionBenchmark: decrypted data does not match the plaintext!\n");
+			ret = -1;
+		}
+
+		INFO_MSG(fmt::format("EncryptionBenchmark: megabytes={}\n{}", megabytes, result));
+	}
+	else if (benchmarkType == "log")
+	{
+		if (iterations.size() == 0)
+			iterations = "1000000";
+
+		LogBenchmark benchmark((uint32)atoi(iterations.c_str()), (uint32)atoi(threads.c_str()));
+		if (!benchmark.run())
+			ret = -1;
+	}
+	else if (benchmarkType == "timers")
+	{
+		if (iterations.size() == 0)
+			iterations = "1000";
+
+		TimerBenchmark benchmark((uint32)atoi(iterations.c_str()), (uint32)atoi(timers.c_str()));
+		if (!benchmark.run())
+			ret = -1;
+	}
+	else if (benchmarkType == "volatile")
+	{
+		if (iterations.size() == 0)
+			iterations = "100";
+
+		VolatileBenchmark benchmark((uint32)atoi(iterations.c_str()));
+		if (!benchmark.run())
+			ret = -1;
+	}
+	else
+	{
+		ERROR_MSG(fmt::format("app::initialize(): benchmark error! nonsupport type={}\n", benchmarkType));
+		ret = -1;
+	}
+
+	script::entitydef::uninstallModule();
+	app.finalise();
+	INFO_MSG(fmt::format("{}({}) has shut down. Benchmark={}\n", COMPONENT_NAME_EX(g_componentType), g_componentID, ret == 0));
+
+	// ־δͬɣ ͬɲŽ
+	DebugHelper::getSingleton().finalise();
+	return ret;
+}
+
 int process_getuid(int argc, char* argv[])
 {
 	if (getUserUID() == 0)
@@ -453,6 +657,26 @@ int process_help(int argc, char* argv[])
 	printf("\tCreate a new server game asset library, contains the necessary files.\n");
 	printf("\tkbcmd.exe --newassets=python --outpath=c:/xserver_assets\n");
 
+	printf("\n--benchmark\n");
+	printf("\tMeasure encode/decode ops per second of all FIXED_DICT and ARRAY types in entity_defs.\n");
+	printf("\tkbcmd.exe --benchmark=datatypes --iterations=100000 --elements=8\n");
+	printf("\tMeasure entity loads per second from mysql, per-table queries versus one multi-statement round trip(batchEntityLoad).\n");
+	printf("\tReads the first N rows of each persistent entity table, the tables must have been synced by dbmgr.\n");
+	printf("\tkbcmd.exe --benchmark=entityload --dbinterface=default --iterations=10 --entities=100 --entity=Avatar\n");
+	printf("\tMeasure redis commands per second, waiting for each reply versus sending a batch of commands through one pipeline.\n");
+	printf("\tkbcmd.exe --benchmark=redis --dbinterface=default --iterations=1000 --commands=64\n");
+	printf("\tMeasure mysql logins(account query + login count update) and entity archives per second, text statements versus prepared statements.\n");
+	printf("\tUses temporary tables with N accounts/entity rows, nothing is left in the database.\n");
+	printf("\tkbcmd.exe --benchmark=mysql --dbinterface=default --iterations=100 --entities=100\n");
+	printf("\tMeasure encrypt/decrypt MB per second of blowfish and the AEAD ciphers(encrypt_type 1, 3, 4) at typical packet sizes.\n");
+	printf("\tkbcmd.exe --benchmark=encryption --megabytes=16\n");
+	printf("\tMeasure logs per second, formatting at the call site(DEBUG_MSG) versus binary records in per-thread rings(DEBUG_FMT).\n");
+	printf("\tkbcmd.exe --benchmark=log --iterations=1000000 --threads=4\n");
+	printf("\tMeasure add/process/cancel cost of the heap timers versus the timing wheel(network/timingWheel) with 1M churning timers.\n");
+	printf("\tkbcmd.exe --benchmark=timers --iterations=1000 --timers=1000000\n");
+	printf("\tMeasure bytes encoded and CPU per tick of the witness position/direction updates at 100/500/1000 entities, per-observer encoding versus the shared VolatileDataCache.\n");
+	printf("\tkbcmd.exe --benchmark=volatile --iterations=100\n");
+
 	printf("\n--help:\n");
 	printf("\tDisplay help information.\n");
 	return 0;
@@ -474,6 +698,7 @@ int main(int argc, char* argv[])
 	PARSE_COMMAND_ARG_DO_FUNC("--clientsdk=", process_make_client_sdk(argc, argv, cmd));
 	PARSE_COMMAND_ARG_DO_FUNC_RETURN("--getuid", process_getuid(argc, argv));
 	PARSE_COMMAND_ARG_DO_FUNC("--newassets=", process_newassets(argc, argv, cmd));
+	PARSE_COMMAND_ARG_DO_FUNC("--benchmark=", process_benchmark(argc, argv, cmd));
 	PARSE_COMMAND_ARG_DO_FUNC("--help", process_help(argc, argv));
 	PARSE_COMMAND_ARG_END();
 
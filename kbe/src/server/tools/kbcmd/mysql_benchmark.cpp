@@ -0,0 +1,279 @@
+// Copyright 2008-2018 Yolo Technologies, Inc. All Rights Reserved. https://www.comblockengine.com
+
+#include "mysql_benchmark.h"
+#include "common/timestamp.h"
+#include "server/common.h"
+#include "server/serverconfig.h"
+#include "db_interface/db_interface.h"
+#include "db_mysql/db_interface_mysql.h"
+
+namespace KBEngine{
+
+#define BENCHMARK_ACCOUNT_TABLE "kbcmd_benchmark_accountinfos"
+#define BENCHMARK_ENTITY_TABLE "kbcmd_benchmark_avatar"
+
+// δpreparedStatementCacheSizeʱԤ׶ʹõĻС
+#define BENCHMARK_STATEMENT_CACHE_SIZE 32
+
+//-------------------------------------------------------------------------------------
+MysqlBenchmark::MysqlBenchmark(const std::string& dbInterfaceName, uint32 iterations, uint32 rows):
+dbInterfaceName_(dbInterfaceName),
+iterations_(iterations),
+rows_(rows)
+{
+	if (iterations_ == 0)
+		iterations_ = 1;
+
+	if (rows_ == 0)
+		rows_ = 1;
+}
+
+//-------------------------------------------------------------------------------------
+MysqlBenchmark::~MysqlBenchmark()
+{
+}
+
+//-------------------------------------------------------------------------------------
+static double opsPerSecond(uint64 ops, uint64 stamps)
+{
+	if (stamps == 0)
+		return 0.0;
+
+	return ops * stampsPerSecondD() / stamps;
+}
+
+//-------------------------------------------------------------------------------------
+bool MysqlBenchmark::createTables(DBInterfaceMysql* pdbi)
+{
+	std::string sqlstr = fmt::format("CREATE TEMPORARY TABLE " BENCHMARK_ACCOUNT_TABLE " "
+		"(`accountName` varchar({}) not null, PRIMARY KEY idKey (`accountName`),"
+		"`password` varchar({}) not null,"
+		"`bindata` blob,"
+		"`email` varchar(191) not null, UNIQUE KEY `email` (`email`),"
+		"`entityDBID` bigint(20) unsigned not null DEFAULT 0, UNIQUE KEY `entityDBID` (`entityDBID`),"
+		"`flags` int unsigned not null DEFAULT 0,"
+		"`deadline` bigint(20) not null DEFAULT 0,"
+		"`regtime` bigint(20) not null DEFAULT 0,"
+		"`lasttime` bigint(20) not null DEFAULT 0,"
+		"`numlogin` int unsigned not null DEFAULT 0)", ACCOUNT_NAME_MAX_LENGTH, ACCOUNT_PASSWD_MAX_LENGTH);
+
+	if (!pdbi->query(sqlstr.c_str(), sqlstr.size(), false))
+		return false;
+
+	sqlstr = "CREATE TEMPORARY TABLE " BENCHMARK_ENTITY_TABLE " "
+		"(`id` bigint(20) unsigned not null, PRIMARY KEY idKey (`id`),"
+		"`sm_level` int unsigned not null DEFAULT 0,"
+		"`sm_exp` bigint(20) unsigned not null DEFAULT 0,"
+		"`sm_name` varchar(255) not null DEFAULT '',"
+		"`sm_position_0` float not null DEFAULT 0,"
+		"`sm_position_1` float not null DEFAULT 0,"
+		"`sm_position_2` float not null DEFAULT 0,"
+		"`sm_datas` blob)";
+
+	if (!pdbi->query(sqlstr.c_str(), sqlstr.size(), false))
+		return false;
+
+	static const std::string insertAccount = "insert into " BENCHMARK_ACCOUNT_TABLE
+		" (accountName, password, bindata, email, entityDBID, regtime, lasttime) values(?,md5(?),?,?,?,?,?)";
+
+	static const std::string insertEntity = "insert into " BENCHMARK_ENTITY_TABLE " (id) values(?)";
+
+	uint64 now = (uint64)time(NULL);
+	std::string bindata;
+
+	for (uint32 i = 1; i <= rows_; ++i)
+	{
+		std::string name = fmt::format("kbcmd_benchmark_{}", i);
+		std::string email = name + "@0.0";
+
+		mysql::SQL_PARAMS params;
+		params.push_back(mysql::SqlParam(name));
+		params.push_back(mysql::SqlParam(name));
+		params.push_back(mysql::SqlParam(bindata, mysql::SqlParam::TYPE_BLOB));
+		params.push_back(mysql::SqlParam(email));
+		params.push_back(mysql::SqlParam((uint64)i));
+		params.push_back(mysql::SqlParam(now));
+		params.push_back(mysql::SqlParam(now));
+
+		if (!pdbi->execute(insertAccount, params, false))
+			return false;
+
+		params.clear();
+		params.push_back(mysql::SqlParam((uint64)i));
+
+		if (!pdbi->execute(insertEntity, params, false))
+			return false;
+	}
+
+	return true;
+}
+
+//-------------------------------------------------------------------------------------
+bool MysqlBenchmark::login(DBInterfaceMysql* pdbi, uint64& outTime)
+{
+	static const std::string querySql = "select entityDBID, password, flags, deadline, bindata from "
+		BENCHMARK_ACCOUNT_TABLE " where accountName=? or email=? LIMIT 1";
+
+	static const std::string updateSql = "update " BENCHMARK_ACCOUNT_TABLE
+		" set lasttime=?, numlogin=numlogin+1 where entityDBID=?";
+
+	uint64 startTime = timestamp();
+
+	for (uint32 i = 0; i < iterations_; ++i)
+	{
+		for (uint32 j = 1; j <= rows_; ++j)
+		{
+			std::string name = fmt::format("kbcmd_benchmark_{}", j);
+
+			mysql::SQL_PARAMS params;
+			params.push_back(mysql::SqlParam(name));
+			params.push_back(mysql::SqlParam(name));
+
+			mysql::SQL_ROWS rows;
+			if (!pdbi->execute(querySql, params, false, &rows))
+				return false;
+
+			if (rows.size() != 1)
+			{
+				ERROR_MSG(fmt::format("MysqlBenchmark::login: not found account({})!\n", name));
+				return false;
+			}
+
+			params.clear();
+			params.push_back(mysql::SqlParam((uint64)time(NULL)));
+			params.push_back(mysql::SqlParam((uint64)j));
+
+			if (!pdbi->execute(updateSql, params, false))
+				return false;
+		}
+	}
+
+	outTime = timestamp() - startTime;
+	return true;
+}
+
+//-------------------------------------------------------------------------------------
+bool MysqlBenchmark::archive(DBInterfaceMysql* pdbi, uint64& outTime)
+{
+	static const std::string updateSql = "update " BENCHMARK_ENTITY_TABLE
+		" set sm_level=?,sm_exp=?,sm_name=?,sm_position_0=?,sm_position_1=?,sm_position_2=?,sm_datas=? where id=?";
+
+	std::string datas(256, '\0');
+
+	uint64 startTime = timestamp();
+
+	for (uint32 i = 0; i < iterations_; ++i)
+	{
+		for (uint32 j = 1; j <= rows_; ++j)
+		{
+			// ֵֶʵдһѸʽı(SqlParam::TYPE_LITERAL)
+			std::string level = fmt::format("{}", i);
+			std::string exp = fmt::format("{}", (uint64)i * rows_ + j);
+			std::string name = fmt::format("avatar_{}_{}", j, i);
+			std::string x = fmt::format("{}", j * 0.5f);
+			std::string y = fmt::format("{}", i * 0.25f);
+			std::string z = fmt::format("{}", (i + j) * 0.125f);
+
+			datas[0] = (char)i;
+			datas[1] = (char)j;
+
+			mysql::SQL_PARAMS params;
+			params.push_back(mysql::SqlParam(level, mysql::SqlParam::TYPE_LITERAL));
+			params.push_back(mysql::SqlParam(exp, mysql::SqlParam::TYPE_LITERAL));
+			params.push_back(mysql::SqlParam(name));
+			params.push_back(mysql::SqlParam(x, mysql::SqlParam::TYPE_LITERAL));
+			params.push_back(mysql::SqlParam(y, mysql::SqlParam::TYPE_LITERAL));
+			params.push_back(mysql::SqlParam(z, mysql::SqlParam::TYPE_LITERAL));
+			params.push_back(mysql::SqlParam(datas, mysql::SqlParam::TYPE_BLOB));
+			params.push_back(mysql::SqlParam((uint64)j));
+
+			if (!pdbi->execute(updateSql, params, false))
+				return false;
+		}
+	}
+
+	outTime = timestamp() - startTime;
+	return true;
+}
+
+//-------------------------------------------------------------------------------------
+bool MysqlBenchmark::run()
+{
+	INFO_MSG(fmt::format("MysqlBenchmark::run: dbInterface={}, iterations={}, rows={}\n",
+		dbInterfaceName_, iterations_, rows_));
+
+	DBInterfaceInfo* pDBInfo = g_kbeSrvConfig.dbInterface(dbInterfaceName_);
+	if (!pDBInfo)
+	{
+		ERROR_MSG(fmt::format("MysqlBenchmark::run: not found dbInterface({})\n", dbInterfaceName_));
+		return false;
+	}
+
+	if (strcmp(pDBInfo->db_type, "mysql") != 0)
+	{
+		ERROR_MSG(fmt::format("MysqlBenchmark::run: dbInterface({}) type is {}, only supports mysql!\n",
+			dbInterfaceName_, pDBInfo->db_type));
+
+		return false;
+	}
+
+	if (!DBUtil::initialize())
+		return false;
+
+	DBInterfaceMysql* pdbi = static_cast<DBInterfaceMysql*>(DBUtil::createInterface(dbInterfaceName_, false));
+	if (pdbi == NULL)
+	{
+		DBUtil::finalise();
+		return false;
+	}
+
+	uint32 cacheSize = pdbi->preparedStatementCacheSize();
+	if (cacheSize == 0)
+		cacheSize = BENCHMARK_STATEMENT_CACHE_SIZE;
+
+	bool ret = false;
+	uint64 textLoginTime = 0, textArchiveTime = 0;
+	uint64 preparedLoginTime = 0, preparedArchiveTime = 0;
+
+	try
+	{
+		pdbi->preparedStatementCacheSize(0);
+
+		ret = createTables(pdbi) &&
+			login(pdbi, textLoginTime) &&
+			archive(pdbi, textArchiveTime);
+
+		if (ret)
+		{
+			pdbi->preparedStatementCacheSize(cacheSize);
+
+			ret = login(pdbi, preparedLoginTime) &&
+				archive(pdbi, preparedArchiveTime);
+		}
+	}
+	catch (std::exception& e)
+	{
+		ERROR_MSG(fmt::format("MysqlBenchmark::run: {}\n", e.what()));
+		ret = false;
+	}
+
+	if (ret)
+	{
+		uint64 numOps = (uint64)iterations_ * rows_;
+
+		INFO_MSG(fmt::format("MysqlBenchmark::run: logins={}, text={:.0f}/s, prepared={:.0f}/s\n",
+			numOps, opsPerSecond(numOps, textLoginTime), opsPerSecond(numOps, preparedLoginTime)));
+
+		INFO_MSG(fmt::format("MysqlBenchmark::run: archives={}, text={:.0f}/s, prepared={:.0f}/s(preparedStatementCacheSize={})\n",
+			numOps, opsPerSecond(numOps, textArchiveTime), opsPerSecond(numOps, preparedArchiveTime), cacheSize));
+	}
+
+	pdbi->detach();
+	SAFE_RELEASE(pdbi);
+
+	DBUtil::finalise();
+	return ret;
+}
+
+//-------------------------------------------------------------------------------------
+}
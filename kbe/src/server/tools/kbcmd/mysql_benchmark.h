@@ -0,0 +1,38 @@
+// Copyright 2008-2018 Yolo Technologies, Inc. All Rights Reserved. https://www.comblockengine.com
+
+#ifndef KBE_MYSQL_BENCHMARK_H
+#define KBE_MYSQL_BENCHMARK_H
+
+#include "common/common.h"
+#include "helper/debug_helper.h"
+
+namespace KBEngine{
+
+class DBInterfaceMysql;
+
+/*
+	õmysqlݿӿڲԤ仺(preparedStatementCacheSize)
+	¼: ˺ѯ˺(KBEAccountTableMysql::queryAccountͬ)µ¼
+	浵: ?ռλʵеһ(ֵֶַΣ ʵдͬʽ)
+	ֱıԤִУ Ƚÿ ֻʹʱ ϿʱԶɾ
+*/
+class MysqlBenchmark
+{
+public:
+	MysqlBenchmark(const std::string& dbInterfaceName, uint32 iterations, uint32 rows);
+	virtual ~MysqlBenchmark();
+
+	bool run();
+
+protected:
+	bool createTables(DBInterfaceMysql* pdbi);
+	bool login(DBInterfaceMysql* pdbi, uint64& outTime);
+	bool archive(DBInterfaceMysql* pdbi, uint64& outTime);
+
+	std::string dbInterfaceName_;
+	uint32 iterations_;
+	uint32 rows_;
+};
+
+}
+#endif
@@ -0,0 +1,185 @@
+// Copyright 2008-2018 Yolo Technologies, Inc. All Rights Reserved. https://www.comblockengine.com
+
+#include "redis_benchmark.h"
+#include "common/timestamp.h"
+#include "server/serverconfig.h"
+#include "db_interface/db_interface.h"
+#include "db_redis/db_interface_redis.h"
+
+namespace KBEngine{
+
+//-------------------------------------------------------------------------------------
+RedisBenchmark::RedisBenchmark(const std::string& dbInterfaceName, uint32 iterations, uint32 commands):
+dbInterfaceName_(dbInterfaceName),
+iterations_(iterations),
+commands_(commands),
+key_()
+{
+	if (iterations_ == 0)
+		iterations_ = 1;
+
+	if (commands_ == 0)
+		commands_ = 1;
+
+	key_ = fmt::format("kbcmd_benchmark:{}", getUserUID());
+}
+
+//-------------------------------------------------------------------------------------
+RedisBenchmark::~RedisBenchmark()
+{
+}
+
+//-------------------------------------------------------------------------------------
+static double opsPerSecond(uint64 ops, uint64 stamps)
+{
+	if (stamps == 0)
+		return 0.0;
+
+	return ops * stampsPerSecondD() / stamps;
+}
+
+//-------------------------------------------------------------------------------------
+bool RedisBenchmark::clear(DBInterfaceRedis* pdbi)
+{
+	redisReply* pRedisReply = NULL;
+
+	if (!pdbi->query(fmt::format("DEL {}", key_), &pRedisReply, false))
+		return false;
+
+	if (pRedisReply)
+		freeReplyObject(pRedisReply);
+
+	return true;
+}
+
+//-------------------------------------------------------------------------------------
+bool RedisBenchmark::sequential(DBInterfaceRedis* pdbi, uint64& outTime, uint64& outRoundTrips)
+{
+	outRoundTrips = 0;
+	uint64 startTime = timestamp();
+
+	for (uint32 i = 0; i < iterations_; ++i)
+	{
+		for (uint32 j = 0; j < commands_; ++j)
+		{
+			redisReply* pRedisReply = NULL;
+
+			if (!pdbi->query(fmt::format("HSET {} field_{} {}", key_, j, i), &pRedisReply, false))
+				return false;
+
+			++outRoundTrips;
+
+			if (pRedisReply)
+			{
+				bool isError = pRedisReply->type == REDIS_REPLY_ERROR;
+				freeReplyObject(pRedisReply);
+
+				if (isError)
+				{
+					ERROR_MSG(fmt::format("RedisBenchmark::sequential: HSET {} error!\n", key_));
+					return false;
+				}
+			}
+		}
+	}
+
+	outTime = timestamp() - startTime;
+	return true;
+}
+
+//-------------------------------------------------------------------------------------
+bool RedisBenchmark::pipelined(DBInterfaceRedis* pdbi, uint64& outTime, uint64& outRoundTrips)
+{
+	outRoundTrips = 0;
+	uint64 startTime = timestamp();
+
+	for (uint32 i = 0; i < iterations_; ++i)
+	{
+		pdbi->beginPipeline();
+
+		for (uint32 j = 0; j < commands_; ++j)
+		{
+			redisReply* pRedisReply = NULL;
+
+			if (!pdbi->query(fmt::format("HSET {} field_{} {}", key_, j, i), &pRedisReply, false))
+				return false;
+		}
+
+		if (!pdbi->drainPipeline(NULL, false))
+			return false;
+
+		++outRoundTrips;
+	}
+
+	outTime = timestamp() - startTime;
+	return true;
+}
+
+//-------------------------------------------------------------------------------------
+bool RedisBenchmark::run()
+{
+	INFO_MSG(fmt::format("RedisBenchmark::run: dbInterface={}, iterations={}, commands={}, key={}\n", 
+		dbInterfaceName_, iterations_, commands_, key_));
+
+	DBInterfaceInfo* pDBInfo = g_kbeSrvConfig.dbInterface(dbInterfaceName_);
+	if (!pDBInfo)
+	{
+		ERROR_MSG(fmt::format("RedisBenchmark::run: not found dbInterface({})\n", dbInterfaceName_));
+		return false;
+	}
+
+	if (strcmp(pDBInfo->db_type, "redis") != 0)
+	{
+		ERROR_MSG(fmt::format("RedisBenchmark::run: dbInterface({}) type is {}, only supports redis!\n", 
+			dbInterfaceName_, pDBInfo->db_type));
+
+		return false;
+	}
+
+	if (!DBUtil::initialize())
+		return false;
+
+	DBInterfaceRedis* pdbi = static_cast<DBInterfaceRedis*>(DBUtil::createInterface(dbInterfaceName_, false));
+	if (pdbi == NULL)
+	{
+		DBUtil::finalise();
+		return false;
+	}
+
+	bool ret = false;
+	uint64 sequentialTime = 0, sequentialRoundTrips = 0;
+	uint64 pipelinedTime = 0, pipelinedRoundTrips = 0;
+
+	try
+	{
+		ret = clear(pdbi) &&
+			sequential(pdbi, sequentialTime, sequentialRoundTrips) &&
+			pipelined(pdbi, pipelinedTime, pipelinedRoundTrips);
+
+		clear(pdbi);
+	}
+	catch (std::exception& e)
+	{
+		ERROR_MSG(fmt::format("RedisBenchmark::run: {}\n", e.what()));
+		ret = false;
+	}
+
+	if (ret)
+	{
+		uint64 numCommands = (uint64)iterations_ * commands_;
+
+		INFO_MSG(fmt::format("RedisBenchmark::run: commands={}, sequential={:.0f} cmds/s({} round trips), "
+			"pipelined={:.0f} cmds/s({} round trips)\n",
+			numCommands, opsPerSecond(numCommands, sequentialTime), sequentialRoundTrips,
+			opsPerSecond(numCommands, pipelinedTime), pipelinedRoundTrips));
+	}
+
+	pdbi->detach();
+	SAFE_RELEASE(pdbi);
+
+	DBUtil::finalise();
+	return ret;
+}
+
+//-------------------------------------------------------------------------------------
+}
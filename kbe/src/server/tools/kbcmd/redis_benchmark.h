@@ -0,0 +1,38 @@
+// Copyright 2008-2018 Yolo Technologies, Inc. All Rights Reserved. https://www.comblockengine.com
+
+#ifndef KBE_REDIS_BENCHMARK_H
+#define KBE_REDIS_BENCHMARK_H
+
+#include "common/common.h"
+#include "helper/debug_helper.h"
+
+namespace KBEngine{
+
+class DBInterfaceRedis;
+
+/*
+	õredisݿӿڲԹܵģʽ
+	ÿcommandsHSETֱȴظͨܵһη Ƚÿ
+	ֻдһʱkey ʱɾ
+*/
+class RedisBenchmark
+{
+public:
+	RedisBenchmark(const std::string& dbInterfaceName, uint32 iterations, uint32 commands);
+	virtual ~RedisBenchmark();
+
+	bool run();
+
+protected:
+	bool clear(DBInterfaceRedis* pdbi);
+	bool sequential(DBInterfaceRedis* pdbi, uint64& outTime, uint64& outRoundTrips);
+	bool pipelined(DBInterfaceRedis* pdbi, uint64& outTime, uint64& outRoundTrips);
+
+	std::string dbInterfaceName_;
+	uint32 iterations_;
+	uint32 commands_;
+	std::string key_;
+};
+
+}
+#endif
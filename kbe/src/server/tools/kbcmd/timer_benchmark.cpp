@@ -0,0 +1,184 @@
+// Copyright 2008-2018 Yolo Technologies, Inc. All Rights Reserved. https://www.comblockengine.com
+
+#include "timer_benchmark.h"
+#include "common/timing_wheel.h"
+#include "common/timestamp.h"
+
+namespace KBEngine{
+
+// ģ֡ʱ־()
+#define TIMER_BENCHMARK_TICK_MS 10
+#define TIMER_BENCHMARK_RESOLUTION_MS 1
+
+// ʱΧ() ʵĶ߼ϳĴ浵ʱ
+#define TIMER_BENCHMARK_MIN_INTERVAL_MS 100
+#define TIMER_BENCHMARK_MAX_INTERVAL_MS 60000
+
+//-------------------------------------------------------------------------------------
+static double opsPerSecond(uint64 ops, uint64 stamps)
+{
+	if (stamps == 0)
+		return 0.0;
+
+	return ops * stampsPerSecondD() / stamps;
+}
+
+//-------------------------------------------------------------------------------------
+static double stampsToMs(uint64 stamps)
+{
+	return stamps * 1000.0 / stampsPerSecondD();
+}
+
+//-------------------------------------------------------------------------------------
+/*
+	̶ӵ ֤ʵֵõͬĶʱ
+*/
+class TimerBenchmarkRandom
+{
+public:
+	TimerBenchmarkRandom() : state_(0x2545F4914F6CDD1DULL) {}
+
+	uint32 next()
+	{
+		state_ ^= state_ << 13;
+		state_ ^= state_ >> 7;
+		state_ ^= state_ << 17;
+		return (uint32)(state_ >> 32);
+	}
+
+	uint32 next(uint32 range)
+	{
+		return range > 0 ? next() % range : 0;
+	}
+
+private:
+	uint64 state_;
+};
+
+//-------------------------------------------------------------------------------------
+class TimerBenchmarkHandler : public TimerHandler
+{
+public:
+	TimerBenchmarkHandler() : numFired_(0) {}
+
+	virtual void handleTimeout(TimerHandle handle, void * pUser)
+	{
+		++numFired_;
+	}
+
+	uint64 numFired_;
+};
+
+//-------------------------------------------------------------------------------------
+TimerBenchmark::TimerBenchmark(uint32 iterations, uint32 timers):
+iterations_(iterations),
+timers_(timers)
+{
+	if (iterations_ == 0)
+		iterations_ = 1;
+
+	if (timers_ == 0)
+		timers_ = 1;
+}
+
+//-------------------------------------------------------------------------------------
+TimerBenchmark::~TimerBenchmark()
+{
+}
+
+//-------------------------------------------------------------------------------------
+void TimerBenchmark::runTimers(TimersBase64& timers, Result& result)
+{
+	TimerBenchmarkRandom random;
+	TimerBenchmarkHandler handler;
+
+	uint64 msStamps = stampsPerSecond() / 1000;
+	uint64 now = 0;
+
+	std::vector<TimerHandle> handles;
+	handles.reserve(timers_);
+
+	uint64 startTime = timestamp();
+
+	for (uint32 i = 0; i < timers_; ++i)
+	{
+		uint64 interval = (TIMER_BENCHMARK_MIN_INTERVAL_MS + random.next(TIMER_BENCHMARK_MAX_INTERVAL_MS - 
+			TIMER_BENCHMARK_MIN_INTERVAL_MS)) * msStamps;
+
+		handles.push_back(timers.add(now + random.next((uint32)(interval / msStamps)) * msStamps, interval, &handler, NULL));
+	}
+
+	result.addTime = timestamp() - startTime;
+
+	// ÿ֡滻ٷ֮һĶʱ ģʵĴaddTimer/delTimer
+	uint32 churnPerTick = std::max(timers_ / 100, (uint32)1);
+	result.numChurned = 0;
+
+	startTime = timestamp();
+
+	for (uint32 i = 0; i < iterations_; ++i)
+	{
+		now += TIMER_BENCHMARK_TICK_MS * msStamps;
+		timers.process(now);
+
+		for (uint32 j = 0; j < churnPerTick; ++j)
+		{
+			TimerHandle& handle = handles[random.next(timers_)];
+			handle.cancel();
+
+			uint64 interval = (TIMER_BENCHMARK_MIN_INTERVAL_MS + random.next(TIMER_BENCHMARK_MAX_INTERVAL_MS - 
+				TIMER_BENCHMARK_MIN_INTERVAL_MS)) * msStamps;
+
+			handle = timers.add(now + interval, interval, &handler, NULL);
+		}
+
+		result.numChurned += churnPerTick;
+	}
+
+	result.churnTime = timestamp() - startTime;
+	result.numFired = handler.numFired_;
+
+	startTime = timestamp();
+	timers.clear();
+	result.clearTime = timestamp() - startTime;
+}
+
+//-------------------------------------------------------------------------------------
+bool TimerBenchmark::run()
+{
+	Result heap;
+	{
+		Timers64 timers;
+		runTimers(timers, heap);
+	}
+
+	Result wheel;
+	{
+		TimingWheel64 timers(TIMER_BENCHMARK_RESOLUTION_MS * stampsPerSecond() / 1000, 0);
+		runTimers(timers, wheel);
+	}
+
+	INFO_MSG(fmt::format("TimerBenchmark: timers={}, iterations={}(tick={}ms, {} replaced per tick)\n"
+		"\theap:  add {:.0f}/s, churn {:.3f}ms/tick({:.0f} fired, {:.0f} ops/s), clear {:.1f}ms\n"
+		"\twheel: add {:.0f}/s, churn {:.3f}ms/tick({:.0f} fired, {:.0f} ops/s), clear {:.1f}ms\n",
+		timers_, iterations_, TIMER_BENCHMARK_TICK_MS, heap.numChurned / iterations_,
+		opsPerSecond(timers_, heap.addTime), stampsToMs(heap.churnTime) / iterations_, (double)heap.numFired,
+		opsPerSecond(heap.numFired + heap.numChurned * 2, heap.churnTime), stampsToMs(heap.clearTime),
+		opsPerSecond(timers_, wheel.addTime), stampsToMs(wheel.churnTime) / iterations_, (double)wheel.numFired,
+		opsPerSecond(wheel.numFired + wheel.numChurned * 2, wheel.churnTime), stampsToMs(wheel.clearTime)));
+
+	// ʱְresolutionȡʱ䣬 ģǰһ֡ٴһЩ
+	uint64 diff = heap.numFired > wheel.numFired ? heap.numFired - wheel.numFired : wheel.numFired - heap.numFired;
+	if (diff > timers_ / 100 + 1)
+	{
+		ERROR_MSG(fmt::format("TimerBenchmark: fired counts differ too much(heap={}, wheel={})!\n",
+			heap.numFired, wheel.numFired));
+
+		return false;
+	}
+
+	return true;
+}
+
+//-------------------------------------------------------------------------------------
+}
@@ -0,0 +1,43 @@
+// Copyright 2008-2018 Yolo Technologies, Inc. All Rights Reserved. https://www.comblockengine.com
+
+#ifndef KBE_TIMER_BENCHMARK_H
+#define KBE_TIMER_BENCHMARK_H
+
+#include "common/common.h"
+#include "common/timer.h"
+#include "helper/debug_helper.h"
+
+namespace KBEngine{
+
+/*
+	ȽֶʱʵڴʱƵɾʱĿ
+	: TimersT(std::priority_queue) ʱ: TimingWheelT(network/timingWheelΪtrueʱʹ)
+	timersظʱ Ȼģʱƽiterations֡ ÿ֡processһβȡӰٷ֮һĶʱ
+	clearȫʱ ʵʹͬУ Ӧһ(ʱӺһresolution)
+*/
+class TimerBenchmark
+{
+public:
+	TimerBenchmark(uint32 iterations, uint32 timers);
+	virtual ~TimerBenchmark();
+
+	bool run();
+
+protected:
+	struct Result
+	{
+		uint64 addTime;
+		uint64 churnTime;
+		uint64 clearTime;
+		uint64 numFired;
+		uint64 numChurned;
+	};
+
+	void runTimers(TimersBase64& timers, Result& result);
+
+	uint32 iterations_;
+	uint32 timers_;
+};
+
+}
+#endif
@@ -0,0 +1,196 @@
+// Copyright 2008-2018 Yolo Technologies, Inc. All Rights Reserved. https://www.comblockengine.com
+
+#include "volatile_benchmark.h"
+#include "common/timestamp.h"
+#include "network/bundle.h"
+
+#include "../../../server/cellapp/volatile_data_cache.h"
+
+namespace KBEngine{
+
+// Witness::updateһ: 뿪entityͬxyzԼ optimizedЭڵֻͬxzyaw
+#define VOLATILE_BENCHMARK_FLAGS (UPDATE_FLAG_XYZ | UPDATE_FLAG_YAW_PITCH_ROLL)
+#define VOLATILE_BENCHMARK_OPTIMIZED_FLAGS (UPDATE_FLAG_XZ | UPDATE_FLAG_YAW)
+
+//-------------------------------------------------------------------------------------
+static double stampsToMs(uint64 stamps)
+{
+	return stamps * 1000.0 / stampsPerSecondD();
+}
+
+//-------------------------------------------------------------------------------------
+/*
+	̶ӵ ֤ÿַʽõͬƶ
+*/
+class VolatileBenchmarkRandom
+{
+public:
+	VolatileBenchmarkRandom() : state_(0x2545F4914F6CDD1DULL) {}
+
+	float next()
+	{
+		state_ ^= state_ << 13;
+		state_ ^= state_ >> 7;
+		state_ ^= state_ << 17;
+		return (float)(state_ >> 40) / (float)(1 << 24);
+	}
+
+private:
+	uint64 state_;
+};
+
+//-------------------------------------------------------------------------------------
+struct VolatileBenchmarkEntity
+{
+	ENTITY_ID id;
+	Position3D position;
+	Direction3D direction;
+	VolatileDataCache cache;
+};
+
+//-------------------------------------------------------------------------------------
+VolatileBenchmark::VolatileBenchmark(uint32 iterations):
+iterations_(iterations)
+{
+	if (iterations_ == 0)
+		iterations_ = 1;
+}
+
+//-------------------------------------------------------------------------------------
+VolatileBenchmark::~VolatileBenchmark()
+{
+}
+
+//-------------------------------------------------------------------------------------
+void VolatileBenchmark::runTicks(uint32 numEntities, bool isOptimized, bool useCache, Result& result)
+{
+	VolatileBenchmarkRandom random;
+	std::vector<VolatileBenchmarkEntity> entities(numEntities);
+
+	// entityͬһ50x50ڣ ඼Ұ
+	for (uint32 i = 0; i < numEntities; ++i)
+	{
+		entities[i].id = (ENTITY_ID)(i + 1);
+		entities[i].position = Position3D(random.next() * 50.f, 0.f, random.next() * 50.f);
+	}
+
+	uint32 flags = isOptimized ? VOLATILE_BENCHMARK_OPTIMIZED_FLAGS : VOLATILE_BENCHMARK_FLAGS;
+	VolatileDataCache::Slot uncachedSlot;
+
+	result.time = 0;
+	result.encodedBytes = 0;
+	result.sentBytes = 0;
+
+	for (uint32 tick = 0; tick < iterations_; ++tick)
+	{
+		// ƶת򲻼ʱ䣬 Ӧentityƶ
+		for (uint32 i = 0; i < numEntities; ++i)
+		{
+			VolatileBenchmarkEntity& entity = entities[i];
+			entity.position.x += random.next() - 0.5f;
+			entity.position.y = random.next() * 0.1f;
+			entity.position.z += random.next() - 0.5f;
+			entity.direction.yaw(random.next() * 6.28f - 3.14f);
+			entity.direction.pitch(random.next() * 0.2f);
+		}
+
+		uint64 startTime = timestamp();
+
+		for (uint32 i = 0; i < numEntities; ++i)
+		{
+			const Position3D& observerPos = entities[i].position;
+			Network::Bundle* pBundle = Network::Bundle::createPoolObject(OBJECTPOOL_POINT);
+
+			for (uint32 j = 0; j < numEntities; ++j)
+			{
+				if (i == j)
+					continue;
+
+				VolatileBenchmarkEntity& other = entities[j];
+
+				// ENTITY_MESSAGE_FORWARD_CLIENT_BEGINԼ_addViewEntityIDToBundleдϢͷСһ
+				(*pBundle) << (Network::MessageID)0 << other.id;
+
+				if (isOptimized)
+				{
+					Position3D relativePos = other.position - observerPos;
+					pBundle->appendPackXZ(relativePos.x, relativePos.z);
+				}
+
+				const VolatileDataCache::Slot* pSlot = &uncachedSlot;
+
+				if (!useCache)
+				{
+					// ޸ǰķʽ ÿ۲߸Աһ
+					uncachedSlot.encode(flags, isOptimized, other.position, other.direction);
+					result.encodedBytes += uncachedSlot.length;
+				}
+				else
+				{
+					VolatileDataCache::Slot& slot = isOptimized ? other.cache.optimized : other.cache.normal;
+					if (!slot.isValid(flags, other.position, other.direction))
+					{
+						slot.encode(flags, isOptimized, other.position, other.direction);
+						result.encodedBytes += slot.length;
+					}
+
+					pSlot = &slot;
+				}
+
+				if (pSlot->length > 0)
+					pBundle->append(pSlot->data, (int)pSlot->length);
+			}
+
+			result.sentBytes += pBundle->packetsLength();
+			Network::Bundle::reclaimPoolObject(pBundle);
+		}
+
+		result.time += timestamp() - startTime;
+	}
+}
+
+//-------------------------------------------------------------------------------------
+bool VolatileBenchmark::run()
+{
+	static const uint32 entityCounts[] = { 100, 500, 1000 };
+
+	std::string report;
+
+	// һBundlePacketĶأ һ俪
+	Result warmup;
+	runTicks(entityCounts[0], false, true, warmup);
+
+	for (uint32 i = 0; i < sizeof(entityCounts) / sizeof(entityCounts[0]); ++i)
+	{
+		uint32 numEntities = entityCounts[i];
+
+		for (int optimized = 0; optimized < 2; ++optimized)
+		{
+			Result uncached, cached;
+			runTicks(numEntities, optimized == 1, false, uncached);
+			runTicks(numEntities, optimized == 1, true, cached);
+
+			// ֻǱظ룬 дͻ˵ݱȫһ
+			if (uncached.sentBytes != cached.sentBytes)
+			{
+				ERROR_MSG(fmt::format("VolatileBenchmark: entities={}, optimized={}, sent bytes differ(uncached={}, cached={})!\n",
+					numEntities, optimized == 1, uncached.sentBytes, cached.sentBytes));
+
+				return false;
+			}
+
+			report += fmt::format("\tentities={:<5} {:<9}: uncached {:.3f}ms/tick({} bytes encoded/tick), "
+				"cached {:.3f}ms/tick({} bytes encoded/tick), sent {} bytes/tick\n",
+				numEntities, optimized == 1 ? "optimized" : "normal",
+				stampsToMs(uncached.time) / iterations_, uncached.encodedBytes / iterations_,
+				stampsToMs(cached.time) / iterations_, cached.encodedBytes / iterations_,
+				cached.sentBytes / iterations_);
+		}
+	}
+
+	INFO_MSG(fmt::format("VolatileBenchmark: iterations={}\n{}", iterations_, report));
+	return true;
+}
+
+//-------------------------------------------------------------------------------------
+}
@@ -0,0 +1,39 @@
+// Copyright 2008-2018 Yolo Technologies, Inc. All Rights Reserved. https://www.comblockengine.com
+
+#ifndef KBE_VOLATILE_BENCHMARK_H
+#define KBE_VOLATILE_BENCHMARK_H
+
+#include "common/common.h"
+#include "helper/debug_helper.h"
+
+namespace KBEngine{
+
+/*
+	Witness::addUpdateToStreamλó뻺(VolatileDataCache)
+	ֱ1005001000ɼÿ֡ƶתentityģiterations֡
+	ÿ۲߰entityλóдԼBundle Ƚÿ۲߸Ա빲뻺
+	ÿֽ֡CPUʱ䣬 ͨЭoptimizedЭ(꣬ ֻ泯)һΡ
+*/
+class VolatileBenchmark
+{
+public:
+	VolatileBenchmark(uint32 iterations);
+	virtual ~VolatileBenchmark();
+
+	bool run();
+
+protected:
+	struct Result
+	{
+		uint64 time;
+		uint64 encodedBytes;
+		uint64 sentBytes;
+	};
+
+	void runTicks(uint32 numEntities, bool isOptimized, bool useCache, Result& result);
+
+	uint32 iterations_;
+};
+
+}
+#endif
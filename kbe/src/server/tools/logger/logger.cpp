@@ -228,9 +228,6 @@ void Logger::onShutdownEnd()
 //-------------------------------------------------------------------------------------
 void Logger::writeLog(Network::Channel* pChannel, KBEngine::MemoryStream& s)
 {
-	++g_secsNumlogs;
-	++g_totalNumlogs;
-
 	LOG_ITEM* pLogItem = new LOG_ITEM();
 	std::string str;
 
@@ -244,6 +241,91 @@ void Logger::writeLog(Network::Channel* pChannel, KBEngine::MemoryStream& s)
 	s >> pLogItem->kbetime;
 	s.readBlob(str);
 
+	onLogItem(pLogItem, str);
+}
+
+//-------------------------------------------------------------------------------------
+void Logger::writeLogRecords(Network::Channel* pChannel, KBEngine::MemoryStream& s)
+{
+	int32 uid;
+	COMPONENT_TYPE componentType;
+	COMPONENT_ID componentID;
+	COMPONENT_ORDER componentGlobalOrder;
+	COMPONENT_ORDER componentGroupOrder;
+	uint32 numFormats;
+
+	s >> uid;
+	s >> componentType;
+	s >> componentID;
+	s >> componentGlobalOrder;
+	s >> componentGroupOrder;
+	s >> numFormats;
+
+	// ֻעĸʽ logger1ʼط
+	std::vector<std::string>& formats = logFormats_[componentID];
+
+	for (uint32 i = 0; i < numFormats; ++i)
+	{
+		uint32 formatID;
+		s >> formatID;
+
+		if (formatID == 0)
+		{
+			std::string format;
+			s >> format;
+			continue;
+		}
+
+		if (formats.size() < formatID)
+			formats.resize(formatID);
+
+		s >> formats[formatID - 1];
+	}
+
+	ArraySize recordsSize = 0;
+	s >> recordsSize;
+
+	if (recordsSize > s.length())
+	{
+		ERROR_MSG(fmt::format("Logger::writeLogRecords: invalid records size({}), componentID={}!\n",
+			recordsSize, componentID));
+
+		s.done();
+		return;
+	}
+
+	// ֻϢΧڶȡ¼
+	MemoryStream records;
+	records.append(s.data() + s.rpos(), recordsSize);
+	s.read_skip(recordsSize);
+
+	LogRecordReader reader(records);
+	while (reader.next())
+	{
+		LOG_ITEM* pLogItem = new LOG_ITEM();
+		pLogItem->uid = uid;
+		pLogItem->logtype = reader.logType();
+		pLogItem->componentType = componentType;
+		pLogItem->componentID = componentID;
+		pLogItem->componentGlobalOrder = componentGlobalOrder;
+		pLogItem->componentGroupOrder = componentGroupOrder;
+		pLogItem->t = reader.time();
+		pLogItem->kbetime = reader.ms();
+
+		uint32 formatID = reader.formatID();
+		const char* format = (formatID > 0 && formatID <= formats.size() && formats[formatID - 1].size() > 0) ? 
+			formats[formatID - 1].c_str() : NULL;
+
+		onLogItem(pLogItem, reader.format(format));
+	}
+}
+
+//-------------------------------------------------------------------------------------
+void Logger::onLogItem(LOG_ITEM* pLogItem, const std::string& str)
+{
+	++g_secsNumlogs;
+	++g_totalNumlogs;
+
 	time_t tt = static_cast<time_t>(pLogItem->t);	
     tm* aTm = localtime(&tt);
     //       YYYY   year
@@ -255,34 +337,19 @@ void Logger::writeLog(Network::Channel* pChannel, KBEngine::MemoryStream& s)
 
 	if(aTm == NULL)
 	{
-		ERROR_MSG("Logger::writeLog: log error!\n");
+		ERROR_MSG("Logger::onLogItem: log error!\n");
 		delete pLogItem;
 		return;
 	}
 
-	char timebuf[MAX_BUF];
-
-	pLogItem->logstream << KBELOG_TYPE_NAME_EX(pLogItem->logtype);
-	pLogItem->logstream << " ";
-	pLogItem->logstream << COMPONENT_NAME_EX_2(pLogItem->componentType);
-
-    kbe_snprintf(timebuf, MAX_BUF, "%02d", (int)pLogItem->componentGroupOrder);
-	pLogItem->logstream << timebuf;
-	pLogItem->logstream << " ";
-	pLogItem->logstream << pLogItem->uid;
-	pLogItem->logstream << " ";
-	pLogItem->logstream << pLogItem->componentID;
-	pLogItem->logstream << " ";
-
-    kbe_snprintf(timebuf, MAX_BUF, " [%-4d-%02d-%02d %02d:%02d:%02d %03d] ", aTm->tm_year+1900, aTm->tm_mon+1, 
-		aTm->tm_mday, aTm->tm_hour, aTm->tm_min, aTm->tm_sec, pLogItem->kbetime);
-	pLogItem->logstream << timebuf;
-
-	pLogItem->logstream << "- ";
-	pLogItem->logstream << str;
+	pLogItem->logstr = fmt::format("{} {}{:02d} {} {}  [{:<4d}-{:02d}-{:02d} {:02d}:{:02d}:{:02d} {:03d}] - {}", 
+		KBELOG_TYPE_NAME_EX(pLogItem->logtype), COMPONENT_NAME_EX_2(pLogItem->componentType), 
+		(int)pLogItem->componentGroupOrder, pLogItem->uid, pLogItem->componentID, 
+		aTm->tm_year + 1900, aTm->tm_mon + 1, aTm->tm_mday, aTm->tm_hour, aTm->tm_min, aTm->tm_sec, 
+		(int)pLogItem->kbetime, str);
 
 	// ¼־ڽűصʱʹ
-	std::string sLog = pLogItem->logstream.str();
+	std::string sLog = pLogItem->logstr;
 
 	static bool notificationScript = getEntryScript().get() && PyObject_HasAttrString(getEntryScript().get(), "onLogWrote") > 0;
 	if (notificationScript)
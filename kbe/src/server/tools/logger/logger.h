@@ -42,7 +42,9 @@ struct LOG_ITEM
 	COMPONENT_ORDER componentGroupOrder;
 	int64 t;
 	GAME_TIME kbetime;
-	std::stringstream logstream;
+
+	// дʱֻʽһΣ ־ļLogWatcherһ
+	std::string logstr;
 	bool persistent;
 };
 
@@ -91,6 +93,11 @@ public:
 	*/
 	void writeLog(Network::Channel* pChannel, KBEngine::MemoryStream& s);
 
+	/** ӿ
+		д־¼ ʹøĸʽɸʽ
+	*/
+	void writeLogRecords(Network::Channel* pChannel, KBEngine::MemoryStream& s);
+
 	/** ӿ
 		עlog
 	*/
@@ -111,8 +118,15 @@ public:
 	void sendInitLogs(LogWatcher& logWatcher);
 
 protected:
+	// ʽһ־дļűLogWatcher pLogItemȨ˺
+	void onLogItem(LOG_ITEM* pLogItem, const std::string& str);
+
 	LOG_WATCHERS logWatchers_;
 	std::deque<LOG_ITEM*> buffered_logs_;
+
+	// Ķ־ʽ ±ΪʽID - 1
+	typedef std::map<COMPONENT_ID, std::vector<std::string> > LOG_FORMATS;
+	LOG_FORMATS logFormats_;
 	TimerHandle	timer_;
 
 	TelnetServer* pTelnetServer_;
@@ -77,6 +77,9 @@ NETWORK_INTERFACE_DECLARE_BEGIN(LoggerInterface)
 	// ǿɱǰapp
 	LOGGER_MESSAGE_DECLARE_STREAM(reqKillServer,							NETWORK_VARIABLE_MESSAGE)
 
+	// Զд־¼(ʽID + ԭʼ) loggerʽ
+	LOGGER_MESSAGE_DECLARE_STREAM(writeLogRecords,							NETWORK_VARIABLE_MESSAGE)
+
 NETWORK_INTERFACE_DECLARE_END()
 
 #ifdef DEFINE_IN_INTERFACE
@@ -103,13 +103,13 @@ void LogWatcher::onMessage(LOG_ITEM* pLogItem)
 	if(pChannel == NULL)
 		return;
 
-	if(!validDate_(pLogItem->logstream.str()) || !containKeyworlds_(pLogItem->logstream.str()))
+	if(!validDate_(pLogItem->logstr) || !containKeyworlds_(pLogItem->logstr))
 		return;
 
 	Network::Bundle* pBundle = Network::Bundle::createPoolObject(OBJECTPOOL_POINT);
 	ConsoleInterface::ConsoleLogMessageHandler msgHandler;
 	(*pBundle).newMessage(msgHandler);
-	(*pBundle).appendBlob(pLogItem->logstream.str());
+	(*pBundle).appendBlob(pLogItem->logstr);
 	pChannel->send(pBundle);
 }
 